@@ -0,0 +1,48 @@
+-- This file is part of Hercules.
+-- http://herc.ws - http://github.com/HerculesWS/Hercules
+--
+-- Copyright (C) 2024 Hercules Dev Team
+--
+-- Hercules is free software: you can redistribute it and/or modify
+-- it under the terms of the GNU General Public License as published by
+-- the Free Software Foundation, either version 3 of the License, or
+-- (at your option) any later version.
+--
+-- This program is distributed in the hope that it will be useful,
+-- but WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+-- GNU General Public License for more details.
+--
+-- You should have received a copy of the GNU General Public License
+-- along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+-- Creates the accounts and characters used by the map-server load generator
+-- (src/test/bench_map.c): accounts bench0000 to bench0999, password 'bench'
+-- (use MD5('bench') instead if use_MD5_passwords is enabled), in group 99 so
+-- that the bots can use the atcommands of the scenarios.
+-- Every account has a character named after it, in slot 0, in Prontera.
+-- DO NOT run this on a live server.
+
+DROP PROCEDURE IF EXISTS `bench_accounts`;
+
+DELIMITER //
+CREATE PROCEDURE `bench_accounts`(IN `bench_count` INT)
+BEGIN
+	DECLARE `i` INT DEFAULT 0;
+	DECLARE `bench_userid` VARCHAR(23);
+	WHILE `i` < `bench_count` DO
+		SET `bench_userid` = CONCAT('bench', LPAD(`i`, 4, '0'));
+		INSERT IGNORE INTO `login` (`userid`, `user_pass`, `sex`, `email`, `group_id`)
+			VALUES (`bench_userid`, 'bench', 'M', 'a@a.com', 99);
+		INSERT IGNORE INTO `char` (`account_id`, `char_num`, `name`, `str`, `agi`, `vit`, `int`, `dex`, `luk`,
+		                           `max_hp`, `hp`, `max_sp`, `sp`, `last_map`, `last_x`, `last_y`, `save_map`, `save_x`, `save_y`)
+			SELECT `account_id`, 0, `bench_userid`, 5, 5, 5, 5, 5, 5, 40, 40, 11, 11, 'prontera', 156, 191, 'prontera', 156, 191
+			FROM `login` WHERE `login`.`userid` = `bench_userid`
+			AND NOT EXISTS (SELECT 1 FROM `char` WHERE `char`.`account_id` = `login`.`account_id` AND `char`.`char_num` = 0);
+		SET `i` = `i` + 1;
+	END WHILE;
+END //
+DELIMITER ;
+
+CALL `bench_accounts`(1000);
+DROP PROCEDURE `bench_accounts`;
@@ -43,6 +43,7 @@
 #include "common/nullpo.h"
 #include "common/packets_struct.h"
 #include "common/packets.h"
+#include "common/profiler.h"
 #include "common/random.h"
 #include "common/showmsg.h"
 #include "common/socket.h"
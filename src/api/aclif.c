@@ -136,12 +136,11 @@ static int aclif_parse(int fd)
 #endif
 	struct api_session_data *sd = sockt->session[fd]->session_data;
 	nullpo_ret(sd);
-	if (sd->flag.handled == 1) {
-		if (sockt->session[fd] == NULL || sockt->session[fd]->flag.eof != 0) {
-			aclif->terminate_connection(fd);
-		}
+	if (sockt->session[fd]->flag.eof != 0) {
+		aclif->terminate_connection(fd);
 		return 0;
 	}
+	// while request handled but response not yet sent, data only buffered by parser
 	if (!httpparser->parse(fd))
 	{
 		httpparser->show_error(fd, sd);
@@ -159,7 +158,7 @@ static int aclif_parse(int fd)
 		aclif->terminate_connection(fd);
 		return 0;
 	}
-	if (sd->flag.message_complete == 1) {
+	if (sd->flag.handled == 0 && sd->flag.message_complete == 1) {
 		aclif->parse_request(fd, sd);
 		return 0;
 	}
@@ -183,6 +182,9 @@ static int aclif_parse_request(int fd, struct api_session_data *sd)
 		aclif->terminate_connection(fd);
 		return 0;
 	}
+	// mark before call, because handler can send response and complete request by itself
+	sd->flag.handled = 1;
+	sd->requests_count ++;
 	if (!sd->handler->func(fd, sd)) {
 		aclif->reportError(fd, sd);
 		aclif->terminate_connection(fd);
@@ -192,12 +194,101 @@ static int aclif_parse_request(int fd, struct api_session_data *sd)
 		aclif->terminate_connection(fd);
 		return 0;
 	}
-	sd->flag.handled = 1;
-	if ((sd->handler->flags & REQ_AUTO_CLOSE) != 0)
+	// handlers what not reply at all
+	if ((sd->handler->flags & REQ_AUTO_CLOSE) != 0) {
 		aclif->terminate_connection(fd);
+		return 0;
+	}
+	// synchronous handlers what sent response without completing request
+	if (sd->flag.handled == 1 && sd->flag.response_sent == 1)
+		aclif->complete_request(fd);
 	return 0;
 }
 
+/**
+ * Finishes current request after its response was sent.
+ * If client and handler allow keep-alive, session is reset for next request,
+ * otherwise connection is closed.
+ * @param fd client connection
+ */
+static void aclif_complete_request(int fd)
+{
+	if (!sockt->session_is_active(fd))
+		return;
+	struct api_session_data *sd = sockt->session[fd]->session_data;
+	nullpo_retv(sd);
+
+	if (!aclif->is_keep_alive(sd)) {
+		aclif->terminate_connection(fd);
+		return;
+	}
+	aclif->reset_request(fd, sd);
+}
+
+/**
+ * Drops all per request data from session, but keeps buffered not parsed data (pipelined requests).
+ * @param fd client connection
+ * @param sd session data
+ */
+static void aclif_reset_request(int fd, struct api_session_data *sd)
+{
+	nullpo_retv(sd);
+
+	aFree(sd->url);
+	sd->url = NULL;
+	aFree(sd->temp_header);
+	sd->temp_header = NULL;
+	db_clear(sd->headers_db);
+	sd->post_headers_db->clear(sd->post_headers_db, aclif->post_headers_destroy_sub);
+	aFree(sd->body);
+	sd->body = NULL;
+	sd->body_size = 0;
+	aFree(sd->multi_parser);
+	sd->multi_parser = NULL;
+	aFree(sd->temp_mime_header);
+	sd->temp_mime_header = NULL;
+	fifo_chunk_buf_clear(sd->data);
+	aFree(sd->custom);
+	sd->custom = NULL;
+	if (sd->json != NULL) {
+		jsonwriter->delete(sd->json);
+		sd->json = NULL;
+	}
+
+	sd->handler = NULL;
+	sd->world_name = NULL;
+	sd->account_id = 0;
+	sd->char_id = 0;
+	sd->mime_flag = MIME_FLAG_NONE;
+	sd->headers_count = 0;
+	sd->post_headers_count = 0;
+	sd->has_errors = false;
+	sd->request_size = 0;
+	memset(&sd->flag, 0, sizeof(sd->flag));
+	memset(sd->valid_post_headers, 0, sizeof(sd->valid_post_headers));
+	// new id for ignore late inter server replies for previous request
+	sd->id = aclif->id_counter++;
+	httpparser->init_parser(fd, sd);
+}
+
+/**
+ * Checks is connection can be reused after response for current request.
+ * @param sd session data
+ * @return true if connection should be kept open
+ */
+static bool aclif_is_keep_alive(struct api_session_data *sd)
+{
+	nullpo_retr(false, sd);
+
+	if (sd->flag.keep_alive == 0)
+		return false;
+	if (sd->requests_count >= MAX_KEEP_ALIVE_REQUESTS)
+		return false;
+	if (sd->handler != NULL && (sd->handler->flags & REQ_AUTO_CLOSE) != 0)
+		return false;
+	return true;
+}
+
 static void aclif_terminate_connection(int fd)
 {
 	sockt->close(fd);
@@ -1205,6 +1296,9 @@ void aclif_defaults(void)
 	aclif->setport = aclif_setport;
 	aclif->parse = aclif_parse;
 	aclif->parse_request = aclif_parse_request;
+	aclif->complete_request = aclif_complete_request;
+	aclif->reset_request = aclif_reset_request;
+	aclif->is_keep_alive = aclif_is_keep_alive;
 	aclif->terminate_connection = aclif_terminate_connection;
 	aclif->connected = aclif_connected;
 	aclif->socket_secure_check = aclif_socket_secure_check;
@@ -70,6 +70,12 @@
 #ifndef MAX_TEMP_HEADER_SIZE
 #define MAX_TEMP_HEADER_SIZE 5000
 #endif
+#ifndef MAX_PIPELINE_SIZE
+#define MAX_PIPELINE_SIZE 200000
+#endif
+#ifndef MAX_KEEP_ALIVE_REQUESTS
+#define MAX_KEEP_ALIVE_REQUESTS 100
+#endif
 
 #ifndef HTTP_MAX_PROTOCOL
 #define HTTP_MAX_PROTOCOL (HTTP_SOURCE + 1)
@@ -155,6 +161,9 @@ struct aclif_interface {
 	uint32 (*refresh_ip) (void);
 	int (*parse) (int fd);
 	int (*parse_request) (int fd, struct api_session_data *sd);
+	void (*complete_request) (int fd);
+	void (*reset_request) (int fd, struct api_session_data *sd);
+	bool (*is_keep_alive) (struct api_session_data *sd);
 	void (*terminate_connection) (int fd);
 	int (*connected) (int fd);
 	bool (*socket_secure_check) (int fd);
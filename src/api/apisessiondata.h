@@ -54,6 +54,7 @@ struct api_session_data {
 	size_t request_temp_alloc_size;
 	struct multipartparser *multi_parser;
 	size_t request_size;
+	int requests_count;  // requests handled over this connection
 	struct api_flag {
 		uint32 message_begin : 1;        // message parsing started
 		uint32 headers_complete : 1;     // headers parsing complete
@@ -64,6 +65,8 @@ struct api_session_data {
 		uint32 multi_part_begin : 1;     // multi part parsing started
 		uint32 multi_part_complete : 1;  // multi part parsing complete
 		uint32 handled : 1;              // http request already handled
+		uint32 keep_alive : 1;           // client asked to keep connection open after response
+		uint32 response_sent : 1;        // response for current request already sent
 	} flag;
 	char *url;
 	struct HttpHandler *handler;
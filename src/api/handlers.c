@@ -28,6 +28,7 @@
 //#include "common/chunked.h"
 #include "common/memmgr.h"
 #include "common/nullpo.h"
+#include "common/profiler.h"
 #include "common/showmsg.h"
 #include "common/socket.h"
 #include "common/strlib.h"
@@ -107,7 +108,7 @@ HTTP_DATA(userconfig_load)
 		}
 
 		httpsender->send_json_text(fd, "{\"Type\":4}", HTTP_STATUS_OK);
-		aclif->terminate_connection(fd);
+		aclif->complete_request(fd);
 		return;
 	}
 
@@ -122,7 +123,7 @@ HTTP_DATA(userconfig_load)
 	jsonwriter->delete(json);
 	sd->json = NULL;
 
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 HTTP_DATA(userconfig_load_emotes)
@@ -290,7 +291,7 @@ HTTP_DATA(charconfig_load)
 	// send hardcoded settings
 	httpsender->send_plain(fd, "{\"Type\":1,\"data\":{\"HomunSkillInfo\":null,\"UseSkillInfo\":null}}");
 
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 HTTP_URL(charconfig_load)
@@ -319,7 +320,7 @@ HTTP_DATA(emblem_upload)
 	else // Not sure if intentional, but kRO sends status 500
 		httpsender->send_json_text(fd, "{\"Type\":4}", HTTP_STATUS_INTERNAL_SERVER_ERROR);
 
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 HTTP_URL(emblem_upload)
@@ -396,7 +397,7 @@ HTTP_DATA(emblem_download)
 
 	RFIFO_CHUNKED_COMPLETE(p) {
 		httpsender->send_binary(fd, sd->data.data, sd->data.data_size);
-		aclif->terminate_connection(fd);
+		aclif->complete_request(fd);
 	}
 }
 
@@ -452,7 +453,7 @@ HTTP_DATA(party_list)
 
 	httpsender->send_json(fd, json);
 	jsonwriter->delete(json);
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 HTTP_URL(party_list)
@@ -498,7 +499,7 @@ HTTP_DATA(party_get)
 
 	httpsender->send_json(fd, json);
 	jsonwriter->delete(json);
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 HTTP_URL(party_get)
@@ -528,7 +529,7 @@ HTTP_DATA(party_add)
 
 	httpsender->send_json(fd, json);
 	jsonwriter->delete(json);
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 HTTP_URL(party_add)
@@ -575,7 +576,7 @@ HTTP_DATA(party_del)
 
 	httpsender->send_json(fd, json);
 	jsonwriter->delete(json);
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 HTTP_URL(party_del)
@@ -606,7 +607,7 @@ HTTP_DATA(party_info)
 
 	httpsender->send_json(fd, json);
 	jsonwriter->delete(json);
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 HTTP_URL(party_info)
@@ -638,7 +639,25 @@ HTTP_URL(test_url)
 
 	httpsender->send_html(fd, buf);
 
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
+
+	return true;
+}
+
+HTTP_URL(metrics)
+{
+#ifdef DEBUG_LOG
+	ShowInfo("metrics called %d: %s\n", fd, httpparser->get_method_str(sd));
+#endif
+
+	StringBuf buf;
+	StrBuf->Init(&buf);
+	profiler->prometheus(&buf);
+
+	httpsender->send_response(fd, HTTP_STATUS_OK, "text/plain; version=0.0.4", StrBuf->Value(&buf), StrBuf->Length(&buf));
+	StrBuf->Destroy(&buf);
+
+	aclif->complete_request(fd);
 
 	return true;
 }
@@ -88,6 +88,11 @@ static int handler_on_headers_complete(HTTP_PARSER *parser)
 		return 0;
 
 	sd->flag.headers_complete = 1;
+#ifdef USE_HTTP_PARSER
+	sd->flag.keep_alive = http_should_keep_alive(parser) != 0 ? 1 : 0;
+#else  // USE_HTTP_PARSER
+	sd->flag.keep_alive = llhttp_should_keep_alive(parser) != 0 ? 1 : 0;
+#endif  // USE_HTTP_PARSER
 	aclif->check_headers(fd, sd);
 
 #ifdef DEBUG_LOG
@@ -118,7 +123,13 @@ static int handler_on_message_complete(HTTP_PARSER *parser)
 #ifdef DEBUG_LOG
 	ShowInfo("***MESSAGE COMPLETE***\n");
 #endif
+	// stop after one message, pipelined requests parsed only after this one handled
+#ifdef USE_HTTP_PARSER
+	http_parser_pause(parser, 1);
 	return 0;
+#else  // USE_HTTP_PARSER
+	return HPE_PAUSED;
+#endif  // USE_HTTP_PARSER
 }
 
 static int handler_on_chunk_header(HTTP_PARSER *parser)
@@ -359,22 +370,32 @@ static http_method httpparser_get_method(struct api_session_data *sd)
 	return sd->parser.method;
 }
 
-static bool httpparser_parse_real(int fd, struct api_session_data *sd, const char *data, size_t data_size)
+static bool httpparser_parse_real(int fd, struct api_session_data *sd, const char *data, size_t data_size, size_t *parsed_size)
 {
 	nullpo_ret(sd);
+	nullpo_ret(parsed_size);
+	*parsed_size = 0;
 	if (data_size == 0)
 		return true;
 
 #ifdef USE_HTTP_PARSER
-	size_t parsed_size = http_parser_execute(&sd->parser, httpparser->settings, data, data_size);
-	if (data_size == parsed_size) {
-		sd->request_size += parsed_size;
+	const size_t size = http_parser_execute(&sd->parser, httpparser->settings, data, data_size);
+	if (data_size == size || HTTP_PARSER_ERRNO(&sd->parser) == HPE_PAUSED) {
+		sd->request_size += size;
+		*parsed_size = size;
 		return true;
 	}
 #else  // USE_HTTP_PARSER
 	enum llhttp_errno err = llhttp_execute(&sd->parser, data, data_size);
 	if (err == HPE_OK) {
 		sd->request_size += data_size;
+		*parsed_size = data_size;
+		return true;
+	}
+	if (err == HPE_PAUSED) {
+		const size_t size = llhttp_get_error_pos(&sd->parser) - data;
+		sd->request_size += size;
+		*parsed_size = size;
 		return true;
 	}
 #endif  // USE_HTTP_PARSER
@@ -394,8 +415,9 @@ static void httpparser_add_to_temp_request(int fd, struct api_session_data *sd,
 		const size_t old_size = sd->request_temp_size;
 		sd->request_temp_size += data_size;
 		if (sd->request_temp_alloc_size < sd->request_temp_size) {
-			sd->request_temp = aRealloc(sd->request_temp, sd->request_temp_size);
-			sd->request_temp_alloc_size = sd->request_temp_size;
+			// buffer reused between keep-alive requests, so grow it with reserve
+			sd->request_temp_alloc_size = max(sd->request_temp_size, sd->request_temp_alloc_size * 2);
+			sd->request_temp = aRealloc(sd->request_temp, sd->request_temp_alloc_size);
 		}
 		memcpy(sd->request_temp + old_size, data, data_size);
 	}
@@ -422,48 +444,42 @@ static bool httpparser_parse(int fd)
 	nullpo_ret(sockt->session[fd]);
 
 	struct api_session_data *sd = sockt->session[fd]->session_data;
-	size_t data_size = RFIFOREST(fd);
-	if (data_size == 0)
-		return true;
+	nullpo_ret(sd);
+
+	// all received data cached first, because parser cant handle part of header
+	// and pipelined requests must wait until previous request handled
+	const size_t data_size = RFIFOREST(fd);
+	if (data_size != 0) {
+		httpparser->add_to_temp_request(fd, sd, RFIFOP(fd, 0), data_size);
+		RFIFOSKIP(fd, data_size);
+	}
 
-	const char *data = RFIFOP(fd, 0);
+	if (sd->flag.message_complete != 0) {
+		// waiting for response to previous request
+		return sd->request_temp_size <= MAX_PIPELINE_SIZE;
+	}
+	if (sd->request_temp_size == 0)
+		return true;
 
+	size_t size = sd->request_temp_size;
 	if (sd->flag.headers_complete == 0) {
-		// because parser cant handle part of header, need cache incomplete headers
-		httpparser->add_to_temp_request(fd, sd, data, data_size);
-		RFIFOSKIP(fd, data_size);
-		if (sd->request_temp_size > MAX_TEMP_HEADER_SIZE) {
-			return false;
-		}
 		int idx = httpparser->search_request_line_end(sd);
-		if (idx >= 0) {
-			// in headers found separator and need parse them
-			Assert_retr(false, sd->request_temp_size >= idx + 2);
-			const bool res = httpparser->parse_real(fd, sd, sd->request_temp, idx + 2);
-			if (!res)
-				return false;
-			sd->request_temp_size -= idx + 2;
-			memmove(sd->request_temp, sd->request_temp + idx + 2, sd->request_temp_size);
-			return true;
-		} else {
+		if (idx < 0) {
 			// data cached, but no yet separator
-			return true;
+			return sd->request_temp_size <= MAX_TEMP_HEADER_SIZE;
 		}
-		if (sd->flag.headers_complete != 0) {
-			// header was complete in previous parse. try to parse additional data
-			const bool res = httpparser->parse_real(fd, sd, sd->request_temp, sd->request_temp_size);
-			aFree(sd->request_temp);
-			sd->request_temp = NULL;
-			sd->request_temp_size = 0;
-			sd->request_temp_alloc_size = 0;
-			return res;
-		}
-	} else {
-		// parse received non headers data
-		const bool res = httpparser->parse_real(fd, sd, data, data_size);
-		RFIFOSKIP(fd, data_size);
-		return res;
+		// in headers found separator and need parse them
+		size = idx + 2;
 	}
+
+	size_t parsed_size = 0;
+	if (!httpparser->parse_real(fd, sd, sd->request_temp, size, &parsed_size))
+		return false;
+	Assert_retr(false, parsed_size <= sd->request_temp_size);
+	sd->request_temp_size -= parsed_size;
+	if (sd->request_temp_size != 0)
+		memmove(sd->request_temp, sd->request_temp + parsed_size, sd->request_temp_size);
+	return true;
 }
 
 static void httpparser_show_error(int fd, struct api_session_data *sd)
@@ -52,10 +52,6 @@
     memcpy(WFIFOP(fd, 0), str, strlen(str)); \
     WFIFOSET(fd, strlen(str));
 
-#define WFIFOADDBUF(fd, buf, buf_size) \
-    memcpy(WFIFOP(fd, 0), buf, buf_size); \
-    WFIFOSET(fd, buf_size);
-
 static struct httpsender_interface httpsender_s;
 struct httpsender_interface *httpsender;
 static char tmp_buffer[MAX_RESPONSE_SIZE];
@@ -101,12 +97,61 @@ static void httpsender_send_continue(int fd)
 	ShowInfo("httpsender_send_continue\n");
 #endif  // DEBUG_LOG
 
-	safestrncpy(tmp_buffer, "HTTP/1.1 100 Continue\n\n", sizeof(tmp_buffer));
+	safestrncpy(tmp_buffer, "HTTP/1.1 100 Continue\r\n\r\n", sizeof(tmp_buffer));
 	WFIFOHEAD(fd, strlen(tmp_buffer));
 	WFIFOADDSTR(fd, tmp_buffer);
 	sockt->flush(fd);
 }
 
+/**
+ * Sends full http response to fd.
+ *
+ * Headers and body written directly into session write buffer, without any intermediate buffer,
+ * so big bodies (like emblems) copied only once from their cache.
+ * Marks current request as answered and sets Connection header depend on keep-alive state.
+ *
+ * @param fd connection
+ * @param status response HTTP status
+ * @param content_type value for Content-Type header
+ * @param data body
+ * @param data_len body size
+ * @return true in case of success, false if something goes wrong
+ */
+static bool httpsender_send_response(int fd, enum http_status status, const char *content_type, const char *data, size_t data_len)
+{
+	nullpo_retr(false, content_type);
+	nullpo_retr(false, data);
+	if (!sockt->session_is_active(fd))
+		return false;
+
+	struct api_session_data *sd = sockt->session[fd]->session_data;
+	nullpo_retr(false, sd);
+
+	char header[300];
+	const int header_len = snprintf(header, sizeof(header),
+		"HTTP/1.1 %u %s\r\n"
+		"Server: %s\r\n"
+		"Content-Type: %s\r\n"
+		"Content-Length: %lu\r\n"
+		"Connection: %s\r\n"
+		"\r\n",
+		status, httpsender->http_status_name(status),
+		httpsender->server_name, content_type, (unsigned long)data_len,
+		aclif->is_keep_alive(sd) ? "keep-alive" : "close");
+	Assert_retr(false, header_len > 0 && header_len < (int)sizeof(header));
+
+	const size_t len = header_len + data_len;
+	WFIFOHEAD(fd, len);
+	memcpy(WFIFOP(fd, 0), header, header_len);
+	if (data_len != 0)
+		memcpy(WFIFOP(fd, header_len), data, data_len);
+	WFIFOSET(fd, len);
+	sockt->flush(fd);
+
+	sd->flag.response_sent = 1;
+	return true;
+}
+
 static bool httpsender_send_html(int fd, const char *data)
 {
 #ifdef DEBUG_LOG
@@ -115,19 +160,7 @@ static bool httpsender_send_html(int fd, const char *data)
 
 	nullpo_retr(false, data);
 
-	const size_t sz = strlen(data);
-	size_t buf_sz = snprintf(tmp_buffer, sizeof(tmp_buffer),
-		"HTTP/1.1 200 OK\n"
-		"Server: %s\n"
-		"Content-Type: text/html\n"
-		"Content-Length: %lu\n"
-		"\n"
-		"%s",
-		httpsender->server_name, sz, data);
-	WFIFOHEAD(fd, buf_sz);
-	WFIFOADDSTR(fd, tmp_buffer);
-	sockt->flush(fd);
-	return true;
+	return httpsender->send_response(fd, HTTP_STATUS_OK, "text/html", data, strlen(data));
 }
 
 static bool httpsender_send_json(int fd, const JsonW *json)
@@ -137,20 +170,10 @@ static bool httpsender_send_json(int fd, const JsonW *json)
 #endif  // DEBUG_LOG
 
 	char *data = jsonwriter->get_string(json);
-	const size_t sz = strlen(data);
-	size_t buf_sz = snprintf(tmp_buffer, sizeof(tmp_buffer),
-		"HTTP/1.1 200 OK\n"
-		"Server: %s\n"
-		"Content-Type: application/json; charset=utf-8\n"
-		"Content-Length: %lu\n"
-		"\n"
-		"%s",
-		httpsender->server_name, sz, data);
+	nullpo_retr(false, data);
+	const bool res = httpsender->send_response(fd, HTTP_STATUS_OK, "application/json; charset=utf-8", data, strlen(data));
 	jsonwriter->free(data);
-	WFIFOHEAD(fd, buf_sz);
-	WFIFOADDSTR(fd, tmp_buffer);
-	sockt->flush(fd);
-	return true;
+	return res;
 }
 
 /**
@@ -172,21 +195,7 @@ static bool httpsender_send_json_text(int fd, const char *json, enum http_status
 
 	nullpo_retr(false, json);
 
-	const size_t sz = strlen(json);
-	size_t buf_sz = snprintf(tmp_buffer, sizeof(tmp_buffer),
-		"HTTP/1.1 %u %s\n"
-		"Server: %s\n"
-		"Content-Type: application/json; charset=utf-8\n"
-		"Content-Length: %lu\n"
-		"\n"
-		"%s",
-		status, httpsender->http_status_name(status),
-		httpsender->server_name, sz, json);
-	WFIFOHEAD(fd, buf_sz);
-	WFIFOADDSTR(fd, tmp_buffer);
-	sockt->flush(fd);
-
-	return true;
+	return httpsender->send_response(fd, status, "application/json; charset=utf-8", json, strlen(json));
 }
 
 static bool httpsender_send_plain(int fd, const char *data)
@@ -197,19 +206,7 @@ static bool httpsender_send_plain(int fd, const char *data)
 
 	nullpo_retr(false, data);
 
-	const size_t sz = strlen(data);
-	size_t buf_sz = snprintf(tmp_buffer, sizeof(tmp_buffer),
-		"HTTP/1.1 200 OK\n"
-		"Server: %s\n"
-		"Content-Type: text/plain; charset=utf-8\n"
-		"Content-Length: %lu\n"
-		"\n"
-		"%s",
-		httpsender->server_name, sz, data);
-	WFIFOHEAD(fd, buf_sz);
-	WFIFOADDSTR(fd, tmp_buffer);
-	sockt->flush(fd);
-	return true;
+	return httpsender->send_response(fd, HTTP_STATUS_OK, "text/plain; charset=utf-8", data, strlen(data));
 }
 
 static bool httpsender_send_binary(int fd, const char *data, const size_t data_len)
@@ -220,20 +217,7 @@ static bool httpsender_send_binary(int fd, const char *data, const size_t data_l
 
 	nullpo_retr(false, data);
 
-	size_t buf_sz = snprintf(tmp_buffer, sizeof(tmp_buffer),
-		"HTTP/1.1 200 OK\n"
-		"Server: %s\n"
-		"Content-Type: octet-stream\n"
-		"Content-Length: %lu\n"
-		"\n",
-		httpsender->server_name, data_len);
-	WFIFOHEAD(fd, buf_sz);
-	WFIFOADDSTR(fd, tmp_buffer);
-	sockt->flush(fd);
-	WFIFOHEAD(fd, data_len);
-	WFIFOADDBUF(fd, data, data_len);
-	sockt->flush(fd);
-	return true;
+	return httpsender->send_response(fd, HTTP_STATUS_OK, "octet-stream", data, data_len);
 }
 
 void httpsender_defaults(void)
@@ -250,6 +234,8 @@ void httpsender_defaults(void)
 
 	httpsender->send_continue = httpsender_send_continue;
 
+	httpsender->send_response = httpsender_send_response;
+
 	httpsender->send_plain = httpsender_send_plain;
 	httpsender->send_html = httpsender_send_html;
 	httpsender->send_json = httpsender_send_json;
@@ -51,6 +51,8 @@ struct httpsender_interface {
 
 	void (*send_continue) (int fd);
 
+	bool (*send_response) (int fd, enum http_status status, const char *content_type, const char *data, size_t data_len);
+
 	bool (*send_plain) (int fd, const char *data);
 	bool (*send_html) (int fd, const char *data);
 	bool (*send_json) (int fd, const JsonW *json);
@@ -63,6 +63,7 @@
 #include "common/mmo.h"
 #include "common/nullpo.h"
 #include "common/packets.h"
+#include "common/profiler.h"
 #include "common/random.h"
 #include "common/showmsg.h"
 #include "common/socket.h"
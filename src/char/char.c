@@ -300,8 +300,13 @@ static void char_set_char_offline(int char_id, int account_id)
 
 		inter_guild->CharOffline(char_id, cp?cp->guild_id:-1);
 
-		if (cp != NULL)
+		if (cp != NULL) {
+			// Keep the last saved data in memory, in case the character comes back soon
+			if (!idb_exists(chr->cache.unsynced_db, char_id))
+				chr->cache_add(cp);
 			idb_remove(chr->char_db_,char_id);
+		}
+		idb_remove(chr->cache.unsynced_db, char_id);
 		if (c_ach != NULL) {
 			VECTOR_CLEAR(*c_ach);
 			idb_remove(inter_achievement->char_achievements, char_id);
@@ -423,6 +428,8 @@ static int char_mmo_char_tosql(int char_id, struct mmo_charstatus *p)
 	nullpo_ret(p);
 	if (char_id != p->char_id) return 0;
 
+	if (idb_exists(chr->cache.db, char_id))
+		chr->cache_invalidate(char_id); // Saved while offline, the cached copy is outdated
 	cp = idb_ensure(chr->char_db_, char_id, chr->create_charstatus);
 
 	StrBuf->Init(&buf);
@@ -712,8 +719,12 @@ static int char_mmo_char_tosql(int char_id, struct mmo_charstatus *p)
 	StrBuf->Destroy(&buf);
 	if (chr->show_save_log && save_status[0] != '\0')
 		ShowInfo("Saved char %d - %s:%s.\n", char_id, p->name, save_status);
-	if (!errors)
+	if (!errors) {
 		memcpy(cp, p, sizeof(struct mmo_charstatus));
+		idb_remove(chr->cache.unsynced_db, char_id);
+	} else {
+		idb_iput(chr->cache.unsynced_db, char_id, 1);
+	}
 	return 0;
 }
 
@@ -1061,6 +1072,402 @@ static int char_mmo_gender(const struct char_session_data *sd, const struct mmo_
 #endif
 }
 
+//=====================================================================================================
+/**
+ * Writes the query text of a cached statement.
+ *
+ * Statements take the character/account ID as their only parameter,
+ * bound to every `?` marker of the query.
+ *
+ * @param id  The statement.
+ * @param buf The buffer to append the query to.
+ */
+static void char_stmt_query(enum char_stmt_id id, struct StringBuf *buf)
+{
+	nullpo_retv(buf);
+
+	switch (id) {
+	case CHAR_STMT_LIST:
+		StrBuf->Printf(buf, "SELECT "
+			"`char_id`,`char_num`,`name`,`class`,`base_level`,`job_level`,`base_exp`,`job_exp`,`zeny`,"
+			"`str`,`agi`,`vit`,`int`,`dex`,`luk`,`max_hp`,`hp`,`max_sp`,`sp`,"
+			"`status_point`,`skill_point`,`option`,`karma`,`manner`,`hair`,`hair_color`,"
+			"`clothes_color`,`body`,`weapon`,`shield`,`head_top`,`head_mid`,`head_bottom`,`last_map`,`rename`,`delete_date`,"
+			"`robe`,`slotchange`,`unban_time`,`sex`,`title_id`,`inventory_size`"
+			" FROM `%s` WHERE `account_id`=? AND `char_num` < '%d'", char_db, MAX_CHARS);
+		break;
+	case CHAR_STMT_LOAD:
+		StrBuf->Printf(buf, "SELECT "
+			"c.`char_id`,c.`account_id`,c.`char_num`,c.`name`,c.`class`,c.`base_level`,c.`job_level`,c.`base_exp`,"
+			"c.`job_exp`,c.`zeny`,c.`str`,c.`agi`,c.`vit`,c.`int`,c.`dex`,c.`luk`,"
+			"c.`max_hp`,c.`hp`,c.`max_sp`,c.`sp`,c.`status_point`,c.`skill_point`,c.`option`,c.`karma`,"
+			"c.`manner`,c.`party_id`,c.`guild_id`,c.`pet_id`,c.`homun_id`,c.`elemental_id`,c.`hair`,c.`hair_color`,"
+			"c.`clothes_color`,c.`body`,c.`weapon`,c.`shield`,c.`head_top`,c.`head_mid`,c.`head_bottom`,c.`last_map`,"
+			"c.`last_x`,c.`last_y`,c.`save_map`,c.`save_x`,c.`save_y`,c.`partner_id`,c.`father`,c.`mother`,"
+			"c.`child`,c.`fame`,c.`rename`,c.`delete_date`,c.`robe`,c.`slotchange`,c.`char_opt`,c.`font`,"
+			"c.`uniqueitem_counter`,c.`sex`,c.`hotkey_rowshift`,c.`hotkey_rowshift2`,c.`clan_id`,c.`last_login`,c.`title_id`,c.`inventory_size`,"
+			"a.`bank_vault`,a.`base_exp`,a.`base_drop`,a.`base_death`,a.`attendance_count`,a.`attendance_timer`"
+			" FROM `%s` c LEFT JOIN `%s` a ON a.`account_id` = c.`account_id`"
+			" WHERE c.`char_id`=? LIMIT 1", char_db, account_data_db);
+		break;
+	case CHAR_STMT_DETAILS:
+		// Single result set ordered by type; `idx` is the memo ID for memo points and the slot for hotkeys.
+		StrBuf->Printf(buf, "(SELECT %d AS `type`, `memo_id` AS `idx`, `x` AS `a`, `y` AS `b`, 0 AS `c`, `map` AS `text`"
+			" FROM `%s` WHERE `char_id`=? ORDER BY `memo_id` LIMIT %d)", CHAR_DETAILS_MEMO, memo_db, MAX_MEMOPOINTS);
+		StrBuf->Printf(buf, " UNION ALL (SELECT %d, 0, `id`, `lv`, `flag`, ''"
+			" FROM `%s` WHERE `char_id`=? LIMIT %d)", CHAR_DETAILS_SKILL, skill_db, MAX_SKILL_DB);
+		StrBuf->Printf(buf, " UNION ALL (SELECT %d, 0, c.`account_id`, c.`char_id`, 0, c.`name`"
+			" FROM `%s` c JOIN `%s` f ON f.`friend_account` = c.`account_id` AND f.`friend_id` = c.`char_id`"
+			" WHERE f.`char_id`=? LIMIT %d)", CHAR_DETAILS_FRIEND, char_db, friend_db, MAX_FRIENDS);
+#ifdef HOTKEY_SAVING
+		StrBuf->Printf(buf, " UNION ALL (SELECT %d, `hotkey`, `type`, `itemskill_id`, `skill_lvl`, ''"
+			" FROM `%s` WHERE `char_id`=?)", CHAR_DETAILS_HOTKEY, hotkey_db);
+#endif
+		StrBuf->AppendStr(buf, " ORDER BY `type`, `idx`");
+		break;
+	case CHAR_STMT_MAX:
+		break;
+	}
+}
+
+/**
+ * Executes a cached statement, preparing it on first use.
+ *
+ * The statement stays prepared for the next calls: the caller binds the
+ * result columns and releases the result with SQL->StmtFreeResult.
+ * A statement that fails to execute (e.g. dropped by the server after a
+ * reconnection) is prepared again and retried once.
+ *
+ * @param id    The statement.
+ * @param param The value bound to every parameter of the statement.
+ * @return the executed statement, or NULL on error.
+ */
+static struct SqlStmt *char_stmt_execute(enum char_stmt_id id, const int *param)
+{
+	int attempt;
+
+	Assert_retr(NULL, id >= 0 && id < CHAR_STMT_MAX);
+	nullpo_retr(NULL, param);
+
+	for (attempt = 0; attempt < 2; attempt++) {
+		struct SqlStmt *stmt = chr->stmt_cache[id];
+		size_t i, count;
+
+		if (stmt == NULL) {
+			struct StringBuf buf;
+
+			if ((stmt = SQL->StmtMalloc(inter->sql_handle)) == NULL) {
+				SqlStmt_ShowDebug(stmt);
+				return NULL;
+			}
+			StrBuf->Init(&buf);
+			chr->stmt_query(id, &buf);
+			if (SQL_ERROR == SQL->StmtPrepareStr(stmt, StrBuf->Value(&buf))) {
+				SqlStmt_ShowDebug(stmt);
+				StrBuf->Destroy(&buf);
+				SQL->StmtFree(stmt);
+				return NULL;
+			}
+			StrBuf->Destroy(&buf);
+			chr->stmt_cache[id] = stmt;
+		}
+
+		count = SQL->StmtNumParams(stmt);
+		for (i = 0; i < count; i++) {
+			if (SQL_ERROR == SQL->StmtBindParam(stmt, i, SQLDT_INT, param, sizeof *param))
+				break;
+		}
+		if (i == count && SQL_SUCCESS == SQL->StmtExecute(stmt))
+			return stmt;
+
+		SqlStmt_ShowDebug(stmt);
+		SQL->StmtFree(stmt);
+		chr->stmt_cache[id] = NULL;
+	}
+	return NULL;
+}
+
+/**
+ * Frees all the cached statements.
+ */
+static void char_stmt_final(void)
+{
+	int i;
+
+	for (i = 0; i < CHAR_STMT_MAX; i++) {
+		if (chr->stmt_cache[i] != NULL) {
+			SQL->StmtFree(chr->stmt_cache[i]);
+			chr->stmt_cache[i] = NULL;
+		}
+	}
+}
+
+//=====================================================================================================
+/**
+ * Initializes the character cache.
+ */
+static void char_cache_init(void)
+{
+	chr->cache.db = idb_alloc(DB_OPT_BASE);
+	chr->cache.account_db = idb_alloc(DB_OPT_BASE);
+	chr->cache.unsynced_db = idb_alloc(DB_OPT_BASE);
+	chr->cache.head = chr->cache.tail = NULL;
+	chr->cache.count = 0;
+}
+
+/**
+ * Frees the character cache.
+ */
+static void char_cache_final(void)
+{
+	while (chr->cache.head != NULL)
+		chr->cache_remove(chr->cache.head);
+	if (chr->cache.db != NULL)
+		db_destroy(chr->cache.db);
+	if (chr->cache.account_db != NULL)
+		db_destroy(chr->cache.account_db);
+	if (chr->cache.unsynced_db != NULL)
+		db_destroy(chr->cache.unsynced_db);
+	chr->cache.db = NULL;
+	chr->cache.account_db = NULL;
+	chr->cache.unsynced_db = NULL;
+}
+
+/**
+ * Loads a character from memory.
+ *
+ * Online characters are served from chr->char_db_ as long as their last
+ * save succeeded, offline ones from the LRU list. A full load of an offline
+ * character moves it back to chr->char_db_.
+ *
+ * @param char_id         The character ID.
+ * @param[out] p          The character data.
+ * @param load_everything Whether the character is being selected (see chr->mmo_char_fromsql).
+ * @return false if the character has to be loaded from SQL.
+ */
+static bool char_cache_load(int char_id, struct mmo_charstatus *p, bool load_everything)
+{
+	struct mmo_charstatus *cp;
+	struct char_cache_entry *entry = NULL;
+
+	nullpo_retr(false, p);
+
+	if (chr->cache.max_entries <= 0)
+		return false;
+
+	if ((cp = idb_get(chr->char_db_, char_id)) != NULL) {
+		if (idb_exists(chr->cache.unsynced_db, char_id)) {
+			chr->cache.misses++;
+			return false;
+		}
+	} else if ((entry = idb_get(chr->cache.db, char_id)) != NULL) {
+		cp = &entry->status;
+	} else {
+		chr->cache.misses++;
+		return false;
+	}
+
+	chr->cache.hits++;
+	memcpy(p, cp, sizeof(*p));
+
+	if (entry == NULL)
+		return true;
+
+	if (!load_everything) {
+		// Only peeking, keep it cached as the most recently used entry
+		chr->cache_unlink(entry);
+		entry->next = chr->cache.head;
+		if (chr->cache.head != NULL)
+			chr->cache.head->prev = entry;
+		chr->cache.head = entry;
+		if (chr->cache.tail == NULL)
+			chr->cache.tail = entry;
+		chr->cache.count++;
+		return true;
+	}
+
+	chr->cache_remove(entry);
+
+	cp = idb_ensure(chr->char_db_, char_id, chr->create_charstatus);
+	memcpy(cp, p, sizeof(*cp));
+	// Account data is shared, other characters of the account may hold stale copies.
+	chr->cache_invalidate_account(p->account_id);
+
+	if (chr->show_save_log)
+		ShowInfo("Loaded char (%d - %s) from cache\n", char_id, p->name);
+	return true;
+}
+
+/**
+ * Caches a character going offline, evicting the least recently used
+ * entries when the cache is full.
+ *
+ * @param cp The character data, as last saved to SQL.
+ */
+static void char_cache_add(const struct mmo_charstatus *cp)
+{
+	struct char_cache_entry *entry;
+
+	nullpo_retv(cp);
+
+	if (chr->cache.max_entries <= 0)
+		return;
+
+	if ((entry = idb_get(chr->cache.db, cp->char_id)) != NULL) {
+		chr->cache_unlink(entry);
+	} else {
+		while (chr->cache.count >= chr->cache.max_entries && chr->cache.tail != NULL) {
+			chr->cache_remove(chr->cache.tail);
+			chr->cache.evictions++;
+		}
+		CREATE(entry, struct char_cache_entry, 1);
+		idb_put(chr->cache.db, cp->char_id, entry);
+		entry->account_next = idb_get(chr->cache.account_db, cp->account_id);
+		if (entry->account_next != NULL)
+			entry->account_next->account_prev = entry;
+		idb_put(chr->cache.account_db, cp->account_id, entry);
+	}
+
+	memcpy(&entry->status, cp, sizeof(entry->status));
+	entry->prev = NULL;
+	entry->next = chr->cache.head;
+	if (chr->cache.head != NULL)
+		chr->cache.head->prev = entry;
+	chr->cache.head = entry;
+	if (chr->cache.tail == NULL)
+		chr->cache.tail = entry;
+	chr->cache.count++;
+}
+
+/**
+ * Unlinks an entry from the LRU list. The entry stays in the cache database.
+ *
+ * @param entry The entry.
+ */
+static void char_cache_unlink(struct char_cache_entry *entry)
+{
+	nullpo_retv(entry);
+
+	if (entry->prev != NULL)
+		entry->prev->next = entry->next;
+	else
+		chr->cache.head = entry->next;
+	if (entry->next != NULL)
+		entry->next->prev = entry->prev;
+	else
+		chr->cache.tail = entry->prev;
+	entry->prev = entry->next = NULL;
+	chr->cache.count--;
+}
+
+/**
+ * Removes an entry from the cache and frees it.
+ *
+ * @param entry The entry.
+ */
+static void char_cache_remove(struct char_cache_entry *entry)
+{
+	nullpo_retv(entry);
+
+	chr->cache_unlink(entry);
+	if (entry->account_prev != NULL)
+		entry->account_prev->account_next = entry->account_next;
+	else if (entry->account_next != NULL)
+		idb_put(chr->cache.account_db, entry->status.account_id, entry->account_next);
+	else
+		idb_remove(chr->cache.account_db, entry->status.account_id);
+	if (entry->account_next != NULL)
+		entry->account_next->account_prev = entry->account_prev;
+	idb_remove(chr->cache.db, entry->status.char_id);
+	aFree(entry);
+}
+
+/**
+ * Drops the cached data of a character, after it was changed in SQL
+ * without going through chr->mmo_char_tosql.
+ *
+ * @param char_id The character ID.
+ */
+static void char_cache_invalidate(int char_id)
+{
+	struct char_cache_entry *entry;
+
+	if (chr->cache.db == NULL)
+		return;
+
+	if ((entry = idb_get(chr->cache.db, char_id)) != NULL) {
+		chr->cache_remove(entry);
+		chr->cache.invalidations++;
+	}
+	if (idb_exists(chr->char_db_, char_id))
+		idb_iput(chr->cache.unsynced_db, char_id, 1);
+}
+
+/**
+ * Drops the cached data of all the offline characters of an account.
+ *
+ * @param account_id The account ID.
+ */
+static void char_cache_invalidate_account(int account_id)
+{
+	struct char_cache_entry *entry;
+
+	if (chr->cache.account_db == NULL)
+		return;
+
+	while ((entry = idb_get(chr->cache.account_db, account_id)) != NULL)
+		chr->cache_invalidate(entry->status.char_id);
+}
+
+/**
+ * Drops the cached data of every character, after a change in SQL
+ * affecting many characters (e.g. a guild or party being disbanded).
+ */
+static void char_cache_invalidate_all(void)
+{
+	struct DBIterator *iter;
+	struct mmo_charstatus *cp;
+
+	if (chr->cache.db == NULL)
+		return;
+
+	while (chr->cache.head != NULL) {
+		chr->cache_remove(chr->cache.head);
+		chr->cache.invalidations++;
+	}
+
+	iter = db_iterator(chr->char_db_);
+	for (cp = dbi_first(iter); dbi_exists(iter); cp = dbi_next(iter))
+		idb_iput(chr->cache.unsynced_db, cp->char_id, 1);
+	dbi_destroy(iter);
+}
+
+/**
+ * Shows the character cache statistics on the console.
+ */
+static void char_cache_report(void)
+{
+	uint64 loads = chr->cache.hits + chr->cache.misses;
+
+	ShowInfo("Character cache: %d/%d offline characters, %"PRIuS" KB.\n",
+	         chr->cache.count, chr->cache.max_entries, (size_t)chr->cache.count * sizeof(struct char_cache_entry) / 1024);
+	ShowInfo("Character cache: %u online characters, %u not synchronized with SQL.\n",
+	         db_size(chr->char_db_), db_size(chr->cache.unsynced_db));
+	ShowInfo("Character cache: %"PRIu64" hits, %"PRIu64" misses (%.1f%% hit rate), %"PRIu64" evictions, %"PRIu64" invalidations.\n",
+	         chr->cache.hits, chr->cache.misses, loads > 0 ? chr->cache.hits * 100. / loads : 0.,
+	         chr->cache.evictions, chr->cache.invalidations);
+}
+
+#ifdef CONSOLE_INPUT
+/**
+ * Console command: cache:report
+ */
+static CPCMD(cache_report)
+{
+	chr->cache_report();
+}
+#endif // CONSOLE_INPUT
+
 //=====================================================================================================
 // Loads the basic character rooster for the given account. Returns total buffer used.
 static int char_mmo_chars_fromsql(struct char_session_data *sd, uint8 *buf, int *count)
@@ -1078,11 +1485,6 @@ static int char_mmo_chars_fromsql(struct char_session_data *sd, uint8 *buf, int
 	nullpo_ret(sd);
 	nullpo_ret(buf);
 
-	stmt = SQL->StmtMalloc(inter->sql_handle);
-	if( stmt == NULL ) {
-		SqlStmt_ShowDebug(stmt);
-		return 0;
-	}
 	memset(&p, 0, sizeof(p));
 
 	for(i = 0 ; i < MAX_CHARS; i++ ) {
@@ -1091,15 +1493,10 @@ static int char_mmo_chars_fromsql(struct char_session_data *sd, uint8 *buf, int
 	}
 
 	// read char data
-	if (SQL_ERROR == SQL->StmtPrepare(stmt, "SELECT "
-		"`char_id`,`char_num`,`name`,`class`,`base_level`,`job_level`,`base_exp`,`job_exp`,`zeny`,"
-		"`str`,`agi`,`vit`,`int`,`dex`,`luk`,`max_hp`,`hp`,`max_sp`,`sp`,"
-		"`status_point`,`skill_point`,`option`,`karma`,`manner`,`hair`,`hair_color`,"
-		"`clothes_color`,`body`,`weapon`,`shield`,`head_top`,`head_mid`,`head_bottom`,`last_map`,`rename`,`delete_date`,"
-		"`robe`,`slotchange`,`unban_time`,`sex`,`title_id`,`inventory_size`"
-		" FROM `%s` WHERE `account_id`='%d' AND `char_num` < '%d'", char_db, sd->account_id, MAX_CHARS)
-	 || SQL_ERROR == SQL->StmtExecute(stmt)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 0,  SQLDT_INT,    &p.char_id,          sizeof p.char_id,          NULL, NULL)
+	if ((stmt = chr->stmt_execute(CHAR_STMT_LIST, &sd->account_id)) == NULL)
+		return 0;
+
+	if (SQL_ERROR == SQL->StmtBindColumn(stmt, 0,  SQLDT_INT,    &p.char_id,         sizeof p.char_id,          NULL, NULL)
 	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 1,  SQLDT_UCHAR,  &p.slot,             sizeof p.slot,             NULL, NULL)
 	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 2,  SQLDT_STRING, &p.name,             sizeof p.name,             NULL, NULL)
 	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 3,  SQLDT_INT,    &p.class,            sizeof p.class,            NULL, NULL)
@@ -1143,7 +1540,7 @@ static int char_mmo_chars_fromsql(struct char_session_data *sd, uint8 *buf, int
 	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 41, SQLDT_INT,    &p.inventorySize,    sizeof p.inventorySize,    NULL, NULL)
 	) {
 		SqlStmt_ShowDebug(stmt);
-		SQL->StmtFree(stmt);
+		SQL->StmtFreeResult(stmt);
 		return 0;
 	}
 
@@ -1167,7 +1564,7 @@ static int char_mmo_chars_fromsql(struct char_session_data *sd, uint8 *buf, int
 
 	memset(sd->new_name, 0, sizeof(sd->new_name));
 
-	SQL->StmtFree(stmt);
+	SQL->StmtFreeResult(stmt);
 	if (count)
 		*count = tmpCount;
 	return j;
@@ -1176,23 +1573,18 @@ static int char_mmo_chars_fromsql(struct char_session_data *sd, uint8 *buf, int
 //=====================================================================================================
 static int char_mmo_char_fromsql(int char_id, struct mmo_charstatus *p, bool load_everything)
 {
-	int i = 0;
 	char t_msg[128] = "";
 	struct mmo_charstatus* cp;
 	struct SqlStmt *stmt;
 	char last_map[MAP_NAME_LENGTH_EXT];
 	char save_map[MAP_NAME_LENGTH_EXT];
-	char point_map[MAP_NAME_LENGTH_EXT];
-	struct point tmp_point;
-	struct s_skill tmp_skill;
-	struct s_friend tmp_friend;
-#ifdef HOTKEY_SAVING
-	struct hotkey tmp_hotkey;
-	int hotkey_num = 0;
-#endif
 	unsigned int opt;
-	int account_id;
 	char sex[2];
+	int8 accdata_null = 0;
+	int detail_type = 0, detail_idx = 0;
+	int64 detail_a = 0, detail_b = 0, detail_c = 0;
+	char detail_text[NAME_LENGTH];
+	int memo_count = 0, friend_count = 0;
 
 	nullpo_ret(p);
 
@@ -1202,26 +1594,14 @@ static int char_mmo_char_fromsql(int char_id, struct mmo_charstatus *p, bool loa
 	if (chr->show_save_log)
 		ShowInfo("Char load request (%d)\n", char_id);
 
-	stmt = SQL->StmtMalloc(inter->sql_handle);
-	if( stmt == NULL )
-	{
-		SqlStmt_ShowDebug(stmt);
+	if (chr->cache_load(char_id, p, load_everything))
+		return 1;
+
+	// read char data and account data
+	if ((stmt = chr->stmt_execute(CHAR_STMT_LOAD, &char_id)) == NULL)
 		return 0;
-	}
 
-	// read char data
-	if (SQL_ERROR == SQL->StmtPrepare(stmt, "SELECT "
-		"`char_id`,`account_id`,`char_num`,`name`,`class`,`base_level`,`job_level`,`base_exp`,`job_exp`,`zeny`,"
-		"`str`,`agi`,`vit`,`int`,`dex`,`luk`,`max_hp`,`hp`,`max_sp`,`sp`,"
-		"`status_point`,`skill_point`,`option`,`karma`,`manner`,`party_id`,`guild_id`,`pet_id`,`homun_id`,`elemental_id`,`hair`,"
-		"`hair_color`,`clothes_color`,`body`,`weapon`,`shield`,`head_top`,`head_mid`,`head_bottom`,`last_map`,`last_x`,`last_y`,"
-		"`save_map`,`save_x`,`save_y`,`partner_id`,`father`,`mother`,`child`,`fame`,`rename`,`delete_date`,`robe`,`slotchange`,"
-		"`char_opt`,`font`,`uniqueitem_counter`,`sex`,`hotkey_rowshift`,`hotkey_rowshift2`,`clan_id`,`last_login`,"
-		"`title_id`, `inventory_size`"
-		" FROM `%s` WHERE `char_id`=? LIMIT 1", char_db)
-	 || SQL_ERROR == SQL->StmtBindParam(stmt, 0, SQLDT_INT, &char_id, sizeof char_id)
-	 || SQL_ERROR == SQL->StmtExecute(stmt)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 0,  SQLDT_INT,    &p->char_id,            sizeof p->char_id,            NULL, NULL)
+	if (SQL_ERROR == SQL->StmtBindColumn(stmt, 0,  SQLDT_INT,    &p->char_id,            sizeof p->char_id,            NULL, NULL)
 	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 1,  SQLDT_INT,    &p->account_id,         sizeof p->account_id,         NULL, NULL)
 	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 2,  SQLDT_UCHAR,  &p->slot,               sizeof p->slot,               NULL, NULL)
 	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 3,  SQLDT_STRING, &p->name,               sizeof p->name,               NULL, NULL)
@@ -1285,21 +1665,34 @@ static int char_mmo_char_fromsql(int char_id, struct mmo_charstatus *p, bool loa
 	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 61, SQLDT_INT64,  &p->last_login,         sizeof p->last_login,         NULL, NULL)
 	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 62, SQLDT_INT,    &p->title_id,           sizeof p->title_id,           NULL, NULL)
 	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 63, SQLDT_INT,    &p->inventorySize,      sizeof p->inventorySize,      NULL, NULL)
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 64, SQLDT_INT,    &p->bank_vault,         sizeof p->bank_vault,         NULL, &accdata_null)
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 65, SQLDT_USHORT, &p->mod_exp,            sizeof p->mod_exp,            NULL, NULL)
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 66, SQLDT_USHORT, &p->mod_drop,           sizeof p->mod_drop,           NULL, NULL)
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 67, SQLDT_USHORT, &p->mod_death,          sizeof p->mod_death,          NULL, NULL)
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 68, SQLDT_SHORT,  &p->attendance_count,   sizeof p->attendance_count,   NULL, NULL)
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 69, SQLDT_INT64,  &p->attendance_timer,   sizeof p->attendance_timer,   NULL, NULL)
 	) {
 		SqlStmt_ShowDebug(stmt);
-		SQL->StmtFree(stmt);
+		SQL->StmtFreeResult(stmt);
 		return 0;
 	}
 	if (SQL_SUCCESS != SQL->StmtNextRow(stmt))
 	{
 		ShowError("Requested non-existant character id: %d!\n", char_id);
-		SQL->StmtFree(stmt);
+		SQL->StmtFreeResult(stmt);
 		return 0;
 	}
+	SQL->StmtFreeResult(stmt);
 
 	p->sex = chr->mmo_gender(NULL, p, sex[0]);
 
-	account_id = p->account_id;
+	if (accdata_null != 0) {
+		/* default */
+		p->bank_vault = 0;
+		p->mod_exp = p->mod_drop = p->mod_death = 100;
+		p->attendance_count = 0;
+		p->attendance_timer = 0;
+	}
 
 	p->last_point.map = mapindex->name2id(last_map);
 	p->save_point.map = mapindex->name2id(save_map);
@@ -1324,30 +1717,80 @@ static int char_mmo_char_fromsql(int char_id, struct mmo_charstatus *p, bool loa
 	}
 
 	strcat(t_msg, " status");
+	if (accdata_null == 0)
+		strcat(t_msg, " accdata");
 
 	if (!load_everything) // For quick selection of data when displaying the char menu
-	{
-		SQL->StmtFree(stmt);
 		return 1;
-	}
 
-	//read memo data
+	//read memo points, skills, friends and hotkeys
 	//`memo` (`memo_id`,`char_id`,`map`,`x`,`y`)
-	memset(&tmp_point, 0, sizeof(tmp_point));
-	if (SQL_ERROR == SQL->StmtPrepare(stmt, "SELECT `map`,`x`,`y` FROM `%s` WHERE `char_id`=? ORDER by `memo_id` LIMIT %d", memo_db, MAX_MEMOPOINTS)
-	 || SQL_ERROR == SQL->StmtBindParam(stmt, 0, SQLDT_INT, &char_id, sizeof char_id)
-	 || SQL_ERROR == SQL->StmtExecute(stmt)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 0, SQLDT_STRING, &point_map,   sizeof point_map,   NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 1, SQLDT_INT16,  &tmp_point.x, sizeof tmp_point.x, NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 2, SQLDT_INT16,  &tmp_point.y, sizeof tmp_point.y, NULL, NULL)
-	)
+	//`skill` (`char_id`, `id`, `lv`)
+	//`friends` (`char_id`, `friend_account`, `friend_id`)
+	//`hotkey` (`char_id`, `hotkey`, `type`, `itemskill_id`, `skill_lvl`
+	memset(detail_text, 0, sizeof(detail_text));
+	if ((stmt = chr->stmt_execute(CHAR_STMT_DETAILS, &char_id)) == NULL
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 0, SQLDT_INT,    &detail_type, sizeof detail_type, NULL, NULL)
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 1, SQLDT_INT,    &detail_idx,  sizeof detail_idx,  NULL, NULL)
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 2, SQLDT_INT64,  &detail_a,    sizeof detail_a,    NULL, NULL)
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 3, SQLDT_INT64,  &detail_b,    sizeof detail_b,    NULL, NULL)
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 4, SQLDT_INT64,  &detail_c,    sizeof detail_c,    NULL, NULL)
+	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 5, SQLDT_STRING, &detail_text, sizeof detail_text, NULL, NULL)
+	) {
 		SqlStmt_ShowDebug(stmt);
+	}
 
-	for( i = 0; i < MAX_MEMOPOINTS && SQL_SUCCESS == SQL->StmtNextRow(stmt); ++i ) {
-		tmp_point.map = mapindex->name2id(point_map);
-		memcpy(&p->memo_point[i], &tmp_point, sizeof(tmp_point));
+	while (stmt != NULL && SQL_SUCCESS == SQL->StmtNextRow(stmt)) {
+		switch (detail_type) {
+		case CHAR_DETAILS_MEMO:
+			if (memo_count >= MAX_MEMOPOINTS)
+				break;
+			p->memo_point[memo_count].map = mapindex->name2id(detail_text);
+			p->memo_point[memo_count].x = (int16)detail_a;
+			p->memo_point[memo_count].y = (int16)detail_b;
+			memo_count++;
+			break;
+		case CHAR_DETAILS_SKILL:
+		{
+			unsigned short skill_id = (unsigned short)detail_a;
+			if (skillid2idx[skill_id]) {
+				struct s_skill *sk = &p->skill[skillid2idx[skill_id]];
+				sk->id = skill_id;
+				sk->lv = (unsigned char)detail_b;
+				sk->flag = (unsigned char)detail_c;
+			} else {
+				ShowWarning("chr->mmo_char_fromsql: ignoring invalid skill (id=%u,lv=%u) of character %s (AID=%d,CID=%d)\n", skill_id, (unsigned int)detail_b, p->name, p->account_id, p->char_id);
+			}
+			break;
+		}
+		case CHAR_DETAILS_FRIEND:
+			if (friend_count >= MAX_FRIENDS)
+				break;
+			p->friends[friend_count].account_id = (int)detail_a;
+			p->friends[friend_count].char_id = (int)detail_b;
+			safestrncpy(p->friends[friend_count].name, detail_text, sizeof(p->friends[friend_count].name));
+			friend_count++;
+			break;
+#ifdef HOTKEY_SAVING
+		case CHAR_DETAILS_HOTKEY:
+			if (detail_idx >= 0 && detail_idx < MAX_HOTKEYS_DB) {
+				struct hotkey *hk = &p->hotkeys[detail_idx];
+				hk->type = (unsigned char)detail_a;
+				hk->id = (unsigned int)detail_b;
+				hk->lv = (unsigned short)detail_c;
+			} else {
+				ShowWarning("chr->mmo_char_fromsql: ignoring invalid hotkey (hotkey=%d,type=%u,id=%u,lv=%u) of character %s (AID=%d,CID=%d)\n", detail_idx, (unsigned int)detail_a, (unsigned int)detail_b, (unsigned int)detail_c, p->name, p->account_id, p->char_id);
+			}
+			break;
+#endif
+		}
 	}
-	strcat(t_msg, " memo");
+	if (stmt != NULL)
+		SQL->StmtFreeResult(stmt);
+	strcat(t_msg, " memo skills friends");
+#ifdef HOTKEY_SAVING
+	strcat(t_msg, " hotkeys");
+#endif
 
 	/* read inventory [Smokexyz/Hercules] */
 	if (chr->getitemdata_from_sql(p->inventory, MAX_INVENTORY, p->char_id, TABLE_INVENTORY) > 0)
@@ -1357,99 +1800,12 @@ static int char_mmo_char_fromsql(int char_id, struct mmo_charstatus *p, bool loa
 	if (chr->getitemdata_from_sql(p->cart, MAX_CART, p->char_id, TABLE_CART) > 0)
 		strcat(t_msg, " cart");
 
-	//read skill
-	//`skill` (`char_id`, `id`, `lv`)
-	memset(&tmp_skill, 0, sizeof(tmp_skill));
-	if (SQL_ERROR == SQL->StmtPrepare(stmt, "SELECT `id`, `lv`,`flag` FROM `%s` WHERE `char_id`=? LIMIT %d", skill_db, MAX_SKILL_DB)
-	 || SQL_ERROR == SQL->StmtBindParam(stmt, 0, SQLDT_INT, &char_id, sizeof char_id)
-	 || SQL_ERROR == SQL->StmtExecute(stmt)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 0, SQLDT_USHORT, &tmp_skill.id,   sizeof tmp_skill.id,   NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 1, SQLDT_UCHAR,  &tmp_skill.lv,   sizeof tmp_skill.lv,   NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 2, SQLDT_UCHAR,  &tmp_skill.flag, sizeof tmp_skill.flag, NULL, NULL)
-	) {
-		SqlStmt_ShowDebug(stmt);
-	}
-
-	if (tmp_skill.flag != SKILL_FLAG_PERM_GRANTED)
-		tmp_skill.flag = SKILL_FLAG_PERMANENT;
-
-	for (i = 0; i < MAX_SKILL_DB && SQL_SUCCESS == SQL->StmtNextRow(stmt); ++i) {
-		if( skillid2idx[tmp_skill.id] )
-			memcpy(&p->skill[skillid2idx[tmp_skill.id]], &tmp_skill, sizeof(tmp_skill));
-		else
-			ShowWarning("chr->mmo_char_fromsql: ignoring invalid skill (id=%u,lv=%u) of character %s (AID=%d,CID=%d)\n", tmp_skill.id, tmp_skill.lv, p->name, p->account_id, p->char_id);
-	}
-	strcat(t_msg, " skills");
-
-	//read friends
-	//`friends` (`char_id`, `friend_account`, `friend_id`)
-	memset(&tmp_friend, 0, sizeof(tmp_friend));
-	if (SQL_ERROR == SQL->StmtPrepare(stmt, "SELECT c.`account_id`, c.`char_id`, c.`name` FROM `%s` c LEFT JOIN `%s` f ON f.`friend_account` = c.`account_id` AND f.`friend_id` = c.`char_id` WHERE f.`char_id`=? LIMIT %d", char_db, friend_db, MAX_FRIENDS)
-	 || SQL_ERROR == SQL->StmtBindParam(stmt, 0, SQLDT_INT, &char_id, sizeof char_id)
-	 || SQL_ERROR == SQL->StmtExecute(stmt)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 0, SQLDT_INT,    &tmp_friend.account_id, sizeof tmp_friend.account_id, NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 1, SQLDT_INT,    &tmp_friend.char_id,    sizeof tmp_friend.char_id,    NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 2, SQLDT_STRING, &tmp_friend.name,       sizeof tmp_friend.name,       NULL, NULL)
-	) {
-		SqlStmt_ShowDebug(stmt);
-	}
-
-	for( i = 0; i < MAX_FRIENDS && SQL_SUCCESS == SQL->StmtNextRow(stmt); ++i )
-		memcpy(&p->friends[i], &tmp_friend, sizeof(tmp_friend));
-	strcat(t_msg, " friends");
-
-#ifdef HOTKEY_SAVING
-	//read hotkeys
-	//`hotkey` (`char_id`, `hotkey`, `type`, `itemskill_id`, `skill_lvl`
-	memset(&tmp_hotkey, 0, sizeof(tmp_hotkey));
-	if (SQL_ERROR == SQL->StmtPrepare(stmt, "SELECT `hotkey`, `type`, `itemskill_id`, `skill_lvl` FROM `%s` WHERE `char_id`=?", hotkey_db)
-	 || SQL_ERROR == SQL->StmtBindParam(stmt, 0, SQLDT_INT, &char_id, sizeof char_id)
-	 || SQL_ERROR == SQL->StmtExecute(stmt)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 0, SQLDT_INT,    &hotkey_num,      sizeof hotkey_num,      NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 1, SQLDT_UCHAR,  &tmp_hotkey.type, sizeof tmp_hotkey.type, NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 2, SQLDT_UINT,   &tmp_hotkey.id,   sizeof tmp_hotkey.id,   NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 3, SQLDT_USHORT, &tmp_hotkey.lv,   sizeof tmp_hotkey.lv,   NULL, NULL)
-	) {
-		SqlStmt_ShowDebug(stmt);
-	}
-
-	while( SQL_SUCCESS == SQL->StmtNextRow(stmt) )
-	{
-		if( hotkey_num >= 0 && hotkey_num < MAX_HOTKEYS_DB )
-			memcpy(&p->hotkeys[hotkey_num], &tmp_hotkey, sizeof(tmp_hotkey));
-		else
-			ShowWarning("chr->mmo_char_fromsql: ignoring invalid hotkey (hotkey=%d,type=%u,id=%u,lv=%u) of character %s (AID=%d,CID=%d)\n", hotkey_num, tmp_hotkey.type, tmp_hotkey.id, tmp_hotkey.lv, p->name, p->account_id, p->char_id);
-	}
-	strcat(t_msg, " hotkeys");
-#endif
-
 	/* Mercenary Owner DataBase */
 	inter_mercenary->owner_fromsql(char_id, p);
 	strcat(t_msg, " mercenary");
 
-	/* default */
-	p->mod_exp = p->mod_drop = p->mod_death = 100;
-
-	//`account_data` (`account_id`,`bank_vault`,`base_exp`,`base_drop`,`base_death`,`attendance_count`, `attendance_timer`)
-	if (SQL_ERROR == SQL->StmtPrepare(stmt, "SELECT `bank_vault`,`base_exp`,`base_drop`,`base_death`,`attendance_count`, `attendance_timer` FROM `%s` WHERE `account_id`=? LIMIT 1", account_data_db)
-	 || SQL_ERROR == SQL->StmtBindParam(stmt, 0, SQLDT_INT, &account_id, sizeof account_id)
-	 || SQL_ERROR == SQL->StmtExecute(stmt)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 0, SQLDT_INT,    &p->bank_vault, sizeof p->bank_vault, NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 1, SQLDT_USHORT, &p->mod_exp,    sizeof p->mod_exp,    NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 2, SQLDT_USHORT, &p->mod_drop,   sizeof p->mod_drop,   NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 3, SQLDT_USHORT, &p->mod_death,  sizeof p->mod_death,  NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 4, SQLDT_SHORT,  &p->attendance_count, sizeof p->attendance_count, NULL, NULL)
-	 || SQL_ERROR == SQL->StmtBindColumn(stmt, 5, SQLDT_INT64,  &p->attendance_timer, sizeof p->attendance_timer, NULL, NULL)
-	) {
-		SqlStmt_ShowDebug(stmt);
-	}
-
-	if( SQL_SUCCESS == SQL->StmtNextRow(stmt) )
-		strcat(t_msg, " accdata");
-
 	if (chr->show_save_log)
 		ShowInfo("Loaded char (%d - %s): %s\n", char_id, p->name, t_msg); //ok. all data load successfully!
-	SQL->StmtFree(stmt);
 
 	/* load options into proper vars */
 	if (opt & OPT_ALLOW_PARTY)
@@ -1461,6 +1817,9 @@ static int char_mmo_char_fromsql(int char_id, struct mmo_charstatus *p, bool loa
 
 	cp = idb_ensure(chr->char_db_, char_id, chr->create_charstatus);
 	memcpy(cp, p, sizeof(struct mmo_charstatus));
+	idb_remove(chr->cache.unsynced_db, char_id);
+	// Account data is shared, other characters of the account may hold stale copies.
+	chr->cache_invalidate_account(p->account_id);
 	return 1;
 }
 
@@ -1468,6 +1827,7 @@ static int char_mmo_char_fromsql(int char_id, struct mmo_charstatus *p, bool loa
 static int char_mmo_char_sql_init(void)
 {
 	chr->char_db_= idb_alloc(DB_OPT_RELEASE_DATA);
+	chr->cache_init();
 
 	//the 'set offline' part is now in check_login_conn ...
 	//if the server connects to loginserver
@@ -1498,6 +1858,9 @@ static bool char_char_slotchange(struct char_session_data *sd, int fd, unsigned
 		return false;
 
 	from_id = sd->found_char[from];
+	chr->cache_invalidate(from_id);
+	if (sd->found_char[to] > 0)
+		chr->cache_invalidate(sd->found_char[to]);
 
 	if( sd->found_char[to] > 0 ) {/* moving char to occupied slot */
 		bool result = false;
@@ -1576,6 +1939,8 @@ static int char_rename_char_sql(struct char_session_data *sd, int char_id)
 		Sql_ShowDebug(inter->sql_handle);
 		return 3;
 	}
+	// The name is also cached in the friend lists of other characters
+	chr->cache_invalidate_all();
 
 	// Change character's name into guild_db.
 	if( char_dat.guild_id )
@@ -1826,6 +2191,8 @@ static int char_divorce_char_sql(int partner_id1, int partner_id2)
 {
 	unsigned char buf[64];
 
+	chr->cache_invalidate(partner_id1);
+	chr->cache_invalidate(partner_id2);
 	if( SQL_ERROR == SQL->Query(inter->sql_handle, "UPDATE `%s` SET `partner_id`='0' WHERE `char_id`='%d' OR `char_id`='%d' LIMIT 2", char_db, partner_id1, partner_id2) )
 		Sql_ShowDebug(inter->sql_handle);
 	if( SQL_ERROR == SQL->Query(inter->sql_handle, "DELETE FROM `%s` WHERE (`nameid`='%d' OR `nameid`='%d') AND (`char_id`='%d' OR `char_id`='%d') LIMIT 2", inventory_db, WEDDING_RING_M, WEDDING_RING_F, partner_id1, partner_id2) )
@@ -1981,6 +2348,9 @@ static int char_delete_char_sql(int char_id)
 		Sql_ShowDebug(inter->sql_handle);
 #endif
 
+	/* other characters may refer to it as friend, partner or family */
+	chr->cache_invalidate_all();
+
 	/* delete character */
 	if (SQL_ERROR == SQL->Query(inter->sql_handle, "DELETE FROM `%s` WHERE `char_id`='%d'", char_db, char_id)) {
 		Sql_ShowDebug(inter->sql_handle);
@@ -2199,6 +2569,7 @@ static void char_mmo_char_send_ban_list(int fd, struct char_session_data *sd)
 					WFIFOL(fd, 4 + (24*c)) = 0;
 					/* also update on mysql */
 					sd->unban_time[i] = 0;
+					chr->cache_invalidate(sd->found_char[i]);
 					if( SQL_ERROR == SQL->Query(inter->sql_handle, "UPDATE `%s` SET `unban_time`='0' WHERE `char_id`='%d' LIMIT 1", char_db, sd->found_char[i]) )
 						Sql_ShowDebug(inter->sql_handle);
 				}
@@ -2565,6 +2936,8 @@ static void char_change_sex_sub(int sex, int acc, int char_id, int class, int gu
 
 	const char *query_inv = "UPDATE `%s` SET `equip`='0' WHERE `char_id`=?";
 
+	chr->cache_invalidate(char_id);
+
 	/** Don't change gender if resetting the view data fails to prevent character from being unable to login. **/
 	if (SQL_ERROR == SQL->StmtPrepare(stmt, query_inv, inventory_db)
 	    || SQL_ERROR == SQL->StmtBindParam(stmt, 0, SQLDT_INT32, &char_id, sizeof(char_id))
@@ -3338,6 +3711,7 @@ static void char_parse_frommap_remove_friend(int fd)
 {
 	int char_id = RFIFOL(fd,2);
 	int friend_id = RFIFOL(fd,6);
+	chr->cache_invalidate(char_id);
 	if( SQL_ERROR == SQL->Query(inter->sql_handle, "DELETE FROM `%s` WHERE `char_id`='%d' AND `friend_id`='%d' LIMIT 1",
 		friend_db, char_id, friend_id) ) {
 		Sql_ShowDebug(inter->sql_handle);
@@ -3421,6 +3795,7 @@ static void char_ban(int account_id, int char_id, time_t *unban_time, short year
 static void char_unban(int char_id, int *result)
 {
 	/* handled by char server, so no redirection */
+	chr->cache_invalidate(char_id);
 	if( SQL_ERROR == SQL->Query(inter->sql_handle, "UPDATE `%s` SET `unban_time` = '0' WHERE `char_id` = '%d' LIMIT 1", char_db, char_id) ) {
 		Sql_ShowDebug(inter->sql_handle);
 		if (result)
@@ -4272,6 +4647,7 @@ static void char_delete2_req(int fd, struct char_session_data *sd)
 	// success
 	delete_date = time(NULL)+char_del_delay;
 
+	chr->cache_invalidate(char_id);
 	if( SQL_SUCCESS != SQL->Query(inter->sql_handle, "UPDATE `%s` SET `delete_date`='%lu' WHERE `char_id`='%d'", char_db, (unsigned long)delete_date, char_id) )
 	{
 		Sql_ShowDebug(inter->sql_handle);
@@ -4371,6 +4747,7 @@ static void char_delete2_cancel(int fd, struct char_session_data *sd)
 	// there is no need to check, whether or not the character was
 	// queued for deletion, as the client prints an error message by
 	// itself, if it was not the case (@see chr->delete2_cancel_ack)
+	chr->cache_invalidate(char_id);
 	if( SQL_SUCCESS != SQL->Query(inter->sql_handle, "UPDATE `%s` SET `delete_date`='0' WHERE `char_id`='%d'", char_db, char_id) )
 	{
 		Sql_ShowDebug(inter->sql_handle);
@@ -5742,6 +6119,10 @@ static bool char_config_read_database(const char *filename, const struct config_
 	libconfig->setting_lookup_mutable_string(setting, "db_path", chr->db_path, sizeof(chr->db_path));
 	libconfig->set_db_path(chr->db_path);
 	libconfig->setting_lookup_bool_real(setting, "log_char", &chr->enable_logs);
+	if (libconfig->setting_lookup_int(setting, "char_cache_size", &chr->cache.max_entries) == CONFIG_TRUE) {
+		if (chr->cache.max_entries < 0)
+			chr->cache.max_entries = 0;
+	}
 	return true;
 }
 
@@ -6139,6 +6520,8 @@ int do_final(void)
 	if( SQL_ERROR == SQL->Query(inter->sql_handle, "DELETE FROM `%s`", ragsrvinfo_db) )
 		Sql_ShowDebug(inter->sql_handle);
 
+	chr->stmt_final();
+	chr->cache_final();
 	chr->char_db_->destroy(chr->char_db_, NULL);
 	chr->online_char_db->destroy(chr->online_char_db, chr->online_char_destroy_sub);
 	auth_db->destroy(auth_db, NULL);
@@ -6391,6 +6774,7 @@ int do_init(int argc, char **argv)
 	Sql_HerculesUpdateCheck(inter->sql_handle);
 #ifdef CONSOLE_INPUT
 	console->input->setSQL(inter->sql_handle);
+	console->input->addCommand("cache:report", CPCMD_A(cache_report));
 	console->display_gplnotice();
 #endif
 	ShowStatus("The char-server is "CL_GREEN"ready"CL_RESET" (Server is listening on the port %d).\n\n", chr->port);
@@ -6445,6 +6829,9 @@ void char_defaults(void)
 	chr->char_fd = -1;
 	chr->online_char_db = NULL;
 	chr->char_db_ = NULL;
+	memset(chr->stmt_cache, 0, sizeof(chr->stmt_cache));
+	memset(&chr->cache, 0, sizeof(chr->cache));
+	chr->cache.max_entries = DEFAULT_CHAR_CACHE_SIZE;
 
 	memset(chr->userid, 0, sizeof(chr->userid));
 	memset(chr->passwd, 0, sizeof(chr->passwd));
@@ -6478,6 +6865,19 @@ void char_defaults(void)
 	chr->mmo_gender = char_mmo_gender;
 	chr->mmo_chars_fromsql = char_mmo_chars_fromsql;
 	chr->mmo_char_fromsql = char_mmo_char_fromsql;
+	chr->stmt_query = char_stmt_query;
+	chr->stmt_execute = char_stmt_execute;
+	chr->stmt_final = char_stmt_final;
+	chr->cache_init = char_cache_init;
+	chr->cache_final = char_cache_final;
+	chr->cache_load = char_cache_load;
+	chr->cache_add = char_cache_add;
+	chr->cache_unlink = char_cache_unlink;
+	chr->cache_remove = char_cache_remove;
+	chr->cache_invalidate = char_cache_invalidate;
+	chr->cache_invalidate_account = char_cache_invalidate_account;
+	chr->cache_invalidate_all = char_cache_invalidate_all;
+	chr->cache_report = char_cache_report;
 	chr->mmo_char_sql_init = char_mmo_char_sql_init;
 	chr->char_slotchange = char_char_slotchange;
 	chr->rename_char_sql = char_rename_char_sql;
@@ -30,6 +30,8 @@
 /* Forward Declarations */
 struct config_setting_t; // common/conf.h
 struct config_t; // common/conf.h
+struct SqlStmt; // common/sql.h
+struct StringBuf; // common/strlib.h
 
 enum E_CHARSERVER_ST {
 	CHARSERVER_ST_RUNNING = CORE_ST_LAST,
@@ -90,6 +92,7 @@ struct mmo_map_server {
 };
 
 #define DEFAULT_CHAR_AUTOSAVE_INTERVAL (300*1000)
+#define DEFAULT_CHAR_CACHE_SIZE 0
 
 enum inventory_table_type {
 	TABLE_INVENTORY,
@@ -98,6 +101,52 @@ enum inventory_table_type {
 	TABLE_GUILD_STORAGE,
 };
 
+/// Statements kept prepared for the lifetime of the char-server.
+enum char_stmt_id {
+	CHAR_STMT_LIST,    ///< Character list of an account.
+	CHAR_STMT_LOAD,    ///< Character status and account data.
+	CHAR_STMT_DETAILS, ///< Memo points, skills, friends and hotkeys of a character.
+	CHAR_STMT_MAX
+};
+
+/// Row types of CHAR_STMT_DETAILS.
+enum char_details_type {
+	CHAR_DETAILS_MEMO,
+	CHAR_DETAILS_SKILL,
+	CHAR_DETAILS_FRIEND,
+	CHAR_DETAILS_HOTKEY,
+};
+
+/// Offline character kept in memory by the character cache.
+struct char_cache_entry {
+	struct mmo_charstatus status;
+	struct char_cache_entry *prev; ///< More recently used entry.
+	struct char_cache_entry *next; ///< Less recently used entry.
+	struct char_cache_entry *account_prev; ///< Previous cached character of the same account.
+	struct char_cache_entry *account_next; ///< Next cached character of the same account.
+};
+
+/**
+ * Write-through cache of recently active characters.
+ *
+ * Online characters are kept in chr->char_db_, which always holds the last
+ * data saved to SQL unless the character is in unsynced_db. Characters
+ * going offline are moved to a LRU list bounded by max_entries.
+ */
+struct char_cache {
+	struct DBMap *db;             ///< Offline characters: int char_id -> struct char_cache_entry*
+	struct DBMap *account_db;     ///< Offline characters by account: int account_id -> struct char_cache_entry* (first of the account)
+	struct DBMap *unsynced_db;    ///< Online characters whose chr->char_db_ data may differ from SQL: int char_id -> 1
+	struct char_cache_entry *head; ///< Most recently used entry.
+	struct char_cache_entry *tail; ///< Least recently used entry.
+	int count;                    ///< Amount of cached offline characters.
+	int max_entries;              ///< Maximum amount of cached offline characters (0 disables the cache).
+	uint64 hits;                  ///< Loads served from memory.
+	uint64 misses;                ///< Loads that went to SQL.
+	uint64 evictions;             ///< Entries dropped to make room for newer ones.
+	uint64 invalidations;         ///< Entries dropped because SQL was changed directly.
+};
+
 struct char_auth_node {
 	int account_id;
 	int char_id;
@@ -137,6 +186,9 @@ struct char_interface {
 
 	char db_path[256]; //< Database directory (db)
 
+	struct SqlStmt *stmt_cache[CHAR_STMT_MAX]; ///< Prepared statements, see chr->stmt_execute
+	struct char_cache cache; ///< Character cache, see chr->cache_load
+
 	int (*waiting_disconnect) (int tid, int64 tick, int id, intptr_t data);
 	int (*delete_char_sql) (int char_id);
 	struct DBData (*create_online_char_data) (union DBKey key, va_list args);
@@ -157,6 +209,19 @@ struct char_interface {
 	int (*mmo_gender) (const struct char_session_data *sd, const struct mmo_charstatus *p, char sex);
 	int (*mmo_chars_fromsql) (struct char_session_data* sd, uint8* buf, int *count);
 	int (*mmo_char_fromsql) (int char_id, struct mmo_charstatus* p, bool load_everything);
+	void (*stmt_query) (enum char_stmt_id id, struct StringBuf *buf);
+	struct SqlStmt *(*stmt_execute) (enum char_stmt_id id, const int *param);
+	void (*stmt_final) (void);
+	void (*cache_init) (void);
+	void (*cache_final) (void);
+	bool (*cache_load) (int char_id, struct mmo_charstatus *p, bool load_everything);
+	void (*cache_add) (const struct mmo_charstatus *cp);
+	void (*cache_unlink) (struct char_cache_entry *entry);
+	void (*cache_remove) (struct char_cache_entry *entry);
+	void (*cache_invalidate) (int char_id);
+	void (*cache_invalidate_account) (int account_id);
+	void (*cache_invalidate_all) (void);
+	void (*cache_report) (void);
 	int (*mmo_char_sql_init) (void);
 	bool (*char_slotchange) (struct char_session_data *sd, int fd, unsigned short from, unsigned short to);
 	int (*rename_char_sql) (struct char_session_data *sd, int char_id);
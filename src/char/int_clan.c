@@ -71,6 +71,7 @@ static int inter_clan_kick_inactive_members(int clan_id, int kick_interval)
 		Sql_ShowDebug(inter->sql_handle);
 		return 0;
 	}
+	chr->cache_invalidate_all();
 
 	return 1;
 }
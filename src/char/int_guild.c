@@ -37,6 +37,7 @@
 #include "common/sql.h"
 #include "common/strlib.h"
 #include "common/timer.h"
+#include "common/utils.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -108,6 +109,7 @@ static int inter_guild_removemember_tosql(int account_id, int char_id)
 {
 	if( SQL_ERROR == SQL->Query(inter->sql_handle, "DELETE from `%s` where `account_id` = '%d' and `char_id` = '%d'", guild_member_db, account_id, char_id) )
 		Sql_ShowDebug(inter->sql_handle);
+	chr->cache_invalidate(char_id);
 	if( SQL_ERROR == SQL->Query(inter->sql_handle, "UPDATE `%s` SET `guild_id` = '0' WHERE `char_id` = '%d'", char_db, char_id) )
 		Sql_ShowDebug(inter->sql_handle);
 	return 0;
@@ -268,6 +270,7 @@ static bool inter_guild_tosql(struct guild *g, int flag)
 					Sql_ShowDebug(inter->sql_handle);
 				if (m->modified&GS_MEMBER_NEW || new_guild == 1)
 				{
+					chr->cache_invalidate(m->char_id);
 					if( SQL_ERROR == SQL->Query(inter->sql_handle, "UPDATE `%s` SET `guild_id` = '%d' WHERE `char_id` = '%d'",
 						char_db, g->guild_id, m->char_id) )
 						Sql_ShowDebug(inter->sql_handle);
@@ -439,6 +442,7 @@ static struct guild *inter_guild_fromsql(int guild_id)
 			*p |= *data - 'A' + 10;
 		++data;
 	}
+	g->emblem_hash = g->emblem_len > 0 ? hash_fnv1a64(g->emblem_data, g->emblem_len) : 0;
 
 	// load guild member info
 	if( SQL_ERROR == SQL->Query(inter->sql_handle, "SELECT g.`account_id`,g.`char_id`,g.`hair`,g.`hair_color`,g.`gender`,g.`class`,g.`lv`,g.`exp`,g.`exp_payper`,g.`online`,g.`position`,g.`name`,c.`last_login`"
@@ -1066,6 +1070,7 @@ static bool inter_guild_leave(int guild_id, int account_id, int char_id, int fla
 	struct guild *g = inter_guild->fromsql(guild_id);
 	if (g == NULL) {
 		// Unknown guild, just update the player
+		chr->cache_invalidate(char_id);
 		if (SQL_ERROR == SQL->Query(inter->sql_handle, "UPDATE `%s` SET `guild_id`='0' WHERE `account_id`='%d' AND `char_id`='%d'", char_db, account_id, char_id))
 			Sql_ShowDebug(inter->sql_handle);
 		// mapif->guild_withdraw(guild_id,account_id,char_id,flag,g->member[i].name,mes);
@@ -1201,6 +1206,7 @@ static bool inter_guild_disband(int guild_id)
 	//printf("- Update guild %d of char\n",guild_id);
 	if (SQL_ERROR == SQL->Query(inter->sql_handle, "UPDATE `%s` SET `guild_id`='0' WHERE `guild_id`='%d'", char_db, guild_id))
 		Sql_ShowDebug(inter->sql_handle);
+	chr->cache_invalidate_all();
 
 	mapif->guild_broken(guild_id, 0);
 
@@ -1235,8 +1241,11 @@ static bool inter_guild_update_basic_info(int guild_id, enum guild_basic_info ty
 			if( value < 0 && abs(value) > g->exp )
 				return 0;
 			g->exp += value;
-			inter_guild->calcinfo(g);
-			break;
+			g->save_flag |= GS_LEVEL;
+			// Unless the guild leveled up (and calcinfo already sent it whole), only the experience is sent.
+			if (!inter_guild->calcinfo(g))
+				mapif->guild_basicinfochanged(g->guild_id, GBI_EXP, &g->exp, sizeof(g->exp));
+			return true;
 
 		case GBI_GUILDLV:
 			value = *((const int16 *)data);
@@ -1257,11 +1266,11 @@ static bool inter_guild_update_basic_info(int guild_id, enum guild_basic_info ty
 		case GBI_SKILLLV:
 			gd_skill = *((const struct guild_skill*)data);
 			memcpy(&(g->skill[(gd_skill.id - GD_SKILLBASE)]), &gd_skill, sizeof(gd_skill));
-			if( !inter_guild->calcinfo(g) )
-				mapif->guild_info(g);
-			g->save_flag |= GS_SKILL;
+			if (!inter_guild->calcinfo(g))
+				mapif->guild_basicinfochanged(g->guild_id, GBI_SKILLLV, &gd_skill, sizeof(gd_skill));
+			g->save_flag |= GS_SKILL | GS_LEVEL;
 			mapif->guild_skillupack(g->guild_id, gd_skill.id, 0);
-			break;
+			return true;
 
 		default:
 			ShowError("int_guild: GuildBasicInfoChange: Unknown type %u, see mmo.h::guild_basic_info for more information\n", type);
@@ -1558,6 +1567,7 @@ static bool inter_guild_update_emblem(int len, int guild_id, const char *data)
 		g->emblem_data = aReallocz(g->emblem_data, len);
 	memcpy(g->emblem_data, data, len);
 	g->emblem_len = len;
+	g->emblem_hash = hash_fnv1a64(g->emblem_data, g->emblem_len);
 	g->emblem_id++;
 	g->save_flag |= GS_EMBLEM; //Change guild
 	mapif->guild_emblem(g);
@@ -1677,6 +1687,9 @@ static int inter_guild_parse_frommap(int fd)
 	case 0x3034: mapif->parse_GuildLeave(fd, RFIFOL(fd,2), RFIFOL(fd,6), RFIFOL(fd,10), RFIFOB(fd,14), RFIFOP(fd,15)); break;
 	case 0x3035: mapif->parse_GuildChangeMemberInfoShort(fd,RFIFOL(fd,2),RFIFOL(fd,6),RFIFOL(fd,10),RFIFOB(fd,14),RFIFOL(fd,15),RFIFOL(fd,19)); break;
 	case 0x3036: mapif->parse_BreakGuild(fd,RFIFOL(fd,2)); break;
+	case HEADER_MAPCHAR_GUILD_EMBLEM_REQ:
+		mapif->parse_GuildEmblemRequest(fd);
+		break;
 	case 0x3039: mapif->parse_GuildBasicInfoChange(fd, RFIFOL(fd,4), RFIFOW(fd,8), RFIFOP(fd,10), RFIFOW(fd,2)-10); break;
 	case 0x303A: mapif->parse_GuildMemberInfoChange(fd, RFIFOL(fd,4), RFIFOL(fd,8), RFIFOL(fd,12), RFIFOW(fd,16), RFIFOP(fd,18), RFIFOW(fd,2)-18); break;
 	case 0x303B: mapif->parse_GuildPosition(fd, RFIFOL(fd,4), RFIFOL(fd,8), RFIFOP(fd,12)); break;
@@ -200,6 +200,7 @@ static int inter_party_tosql(struct party *p, int flag, int index)
 		// we'll skip name-checking and just reset everyone with the same party id [celest]
 		if( SQL_ERROR == SQL->Query(inter->sql_handle, "UPDATE `%s` SET `party_id`='0' WHERE `party_id`='%d'", char_db, party_id) )
 			Sql_ShowDebug(inter->sql_handle);
+		chr->cache_invalidate_all();
 		if( SQL_ERROR == SQL->Query(inter->sql_handle, "DELETE FROM `%s` WHERE `party_id`='%d'", party_db, party_id) )
 			Sql_ShowDebug(inter->sql_handle);
 		//Remove from memory
@@ -236,6 +237,7 @@ static int inter_party_tosql(struct party *p, int flag, int index)
 
 	if( flag & PS_ADDMEMBER )
 	{// Add one party member.
+		chr->cache_invalidate(p->member[index].char_id);
 		if( SQL_ERROR == SQL->Query(inter->sql_handle, "UPDATE `%s` SET `party_id`='%d' WHERE `account_id`='%d' AND `char_id`='%d'",
 			char_db, party_id, p->member[index].account_id, p->member[index].char_id) )
 			Sql_ShowDebug(inter->sql_handle);
@@ -243,6 +245,7 @@ static int inter_party_tosql(struct party *p, int flag, int index)
 
 	if( flag & PS_DELMEMBER )
 	{// Remove one party member.
+		chr->cache_invalidate(p->member[index].char_id);
 		if( SQL_ERROR == SQL->Query(inter->sql_handle, "UPDATE `%s` SET `party_id`='0' WHERE `party_id`='%d' AND `account_id`='%d' AND `char_id`='%d'",
 			char_db, party_id, p->member[index].account_id, p->member[index].char_id) )
 			Sql_ShowDebug(inter->sql_handle);
@@ -33,6 +33,7 @@
 #include "common/socket.h"
 #include "common/sql.h"
 #include "common/strlib.h" // StringBuf
+#include "common/timer.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -364,16 +365,513 @@ static int inter_storage_guild_storage_fromsql(int guild_id, struct guild_storag
 	return 0;
 }
 
+/**
+ * Returns the slot layout database of a storage table.
+ *
+ * @param table TABLE_STORAGE or TABLE_GUILD_STORAGE.
+ * @return The database, or NULL for other tables.
+ */
+static struct DBMap *inter_storage_slots_db(enum inventory_table_type table)
+{
+	switch (table) {
+	case TABLE_STORAGE:
+		return inter_storage->account_slots;
+	case TABLE_GUILD_STORAGE:
+		return inter_storage->guild_slots;
+	case TABLE_INVENTORY:
+	case TABLE_CART:
+		break;
+	}
+	ShowError("inter_storage_slots_db: Invalid table type %d!\n", (int)table);
+	return NULL;
+}
+
+/**
+ * Records the slot layout of a storage that is being sent to a map-server.
+ *
+ * @param table    TABLE_STORAGE or TABLE_GUILD_STORAGE.
+ * @param owner_id Account or guild ID owning the storage.
+ * @param items    The items, in the order they are sent. (item.id holds the row ID)
+ * @param count    The amount of items.
+ */
+static void inter_storage_slots_load(enum inventory_table_type table, int owner_id, const struct item *items, int count)
+{
+	struct DBMap *db = inter_storage->slots_db(table);
+	struct inter_storage_slots *slots;
+
+	if (db == NULL)
+		return;
+
+	if ((slots = idb_get(db, owner_id)) == NULL) {
+		CREATE(slots, struct inter_storage_slots, 1);
+		VECTOR_INIT(slots->ids);
+		idb_put(db, owner_id, slots);
+	}
+
+	VECTOR_TRUNCATE(slots->ids);
+	if (count > 0) {
+		nullpo_retv(items);
+		VECTOR_ENSURE(slots->ids, count, 1);
+		for (int i = 0; i < count; i++)
+			VECTOR_PUSH(slots->ids, items[i].nameid != 0 ? items[i].id : 0);
+	}
+	slots->last_used = timer->gettick();
+}
+
+/**
+ * Appends the item columns written by inter_storage_slots_tosql() to a query.
+ *
+ * @param buf The query buffer.
+ */
+static void inter_storage_slot_columns(StringBuf *buf)
+{
+	nullpo_retv(buf);
+
+	StrBuf->AppendStr(buf, "`nameid`, `amount`, `equip`, `identify`, `refine`, `grade`, `attribute`, `expire_time`, `bound`, `unique_id`");
+	for (int j = 0; j < MAX_SLOTS; ++j)
+		StrBuf->Printf(buf, ", `card%d`", j);
+	for (int j = 0; j < MAX_ITEM_OPTIONS; ++j)
+		StrBuf->Printf(buf, ", `opt_idx%d`, `opt_val%d`", j, j);
+}
+
+/**
+ * Appends the values of an item, in inter_storage_slot_columns() order, to a query.
+ *
+ * @param buf The query buffer.
+ * @param it  The item.
+ */
+static void inter_storage_slot_values(StringBuf *buf, const struct item *it)
+{
+	nullpo_retv(buf);
+	nullpo_retv(it);
+
+	StrBuf->Printf(buf, "'%d', '%d', '%u', '%d', '%d', '%d', '%d', '%u', '%d', '%"PRIu64"'",
+				   it->nameid, it->amount, it->equip, it->identify, it->refine, it->grade, it->attribute,
+				   it->expire_time, it->bound, it->unique_id);
+	for (int j = 0; j < MAX_SLOTS; ++j)
+		StrBuf->Printf(buf, ", '%d'", it->card[j]);
+	for (int j = 0; j < MAX_ITEM_OPTIONS; ++j)
+		StrBuf->Printf(buf, ", '%d', '%d'", it->option[j].index, it->option[j].value);
+}
+
+/**
+ * Saves the modified slots of an account or guild storage.
+ *
+ * Each entry is a <slot>.W <struct item>.P pair as sent by the map-server. Emptied slots delete
+ * their row, slots with a known row are replaced and new slots are inserted, recording the new row ID.
+ * When full is set the storage is rewritten from the entries, reusing the existing rows, and its slot
+ * layout rebuilt.
+ *
+ * @param table    TABLE_STORAGE or TABLE_GUILD_STORAGE.
+ * @param owner_id Account or guild ID owning the storage.
+ * @param full     Whether the entries hold the whole storage.
+ * @param entries  The slot entries.
+ * @param count    The amount of entries.
+ * @return Error code
+ * @retval 0 in case of success.
+ * @retval 1 in case of error, or if the slot layout is unknown and the save was not full;
+ *           the map-server is expected to retry with a full save.
+ */
+static int inter_storage_slots_tosql(enum inventory_table_type table, int owner_id, bool full, const uint8 *entries, int count)
+{
+	const size_t entry_size = 2 + sizeof(struct item);
+	const char *tablename = NULL;
+	const char *owner_column = NULL;
+	int max_slots = 0;
+	struct DBMap *db = inter_storage->slots_db(table);
+
+	switch (table) {
+	case TABLE_STORAGE:
+		tablename = storage_db;
+		owner_column = "account_id";
+		max_slots = MAX_STORAGE;
+		break;
+	case TABLE_GUILD_STORAGE:
+		tablename = guild_storage_db;
+		owner_column = "guild_id";
+		max_slots = MAX_GUILD_STORAGE;
+		break;
+	case TABLE_INVENTORY:
+	case TABLE_CART:
+	default:
+		ShowError("inter_storage_slots_tosql: Invalid table type %d!\n", (int)table);
+		return 1;
+	}
+
+	Assert_retr(1, count == 0 || entries != NULL);
+
+	struct inter_storage_slots *slots = idb_get(db, owner_id);
+
+	if (slots == NULL) {
+		if (!full) {
+			ShowWarning("inter_storage_slots_tosql: Unknown slot layout for %s %d, a full save is required.\n", owner_column, owner_id);
+			return 1;
+		}
+		CREATE(slots, struct inter_storage_slots, 1);
+		VECTOR_INIT(slots->ids);
+		idb_put(db, owner_id, slots);
+	}
+	slots->last_used = timer->gettick();
+
+	bool failed = false;
+	int total_deletes = 0, total_updates = 0, total_inserts = 0;
+	int *old_ids = NULL;
+	int old_count = 0;
+	StringBuf buf;
+
+	StrBuf->Init(&buf);
+
+	if (SQL_ERROR == SQL->QueryStr(inter->sql_handle, "START TRANSACTION")) {
+		Sql_ShowDebug(inter->sql_handle);
+		failed = true;
+	}
+
+	/**
+	 * A full save reuses the rows the owner already has, so nothing is deleted before the
+	 * new contents are written: `storage` and `guild_storage` may be MyISAM tables, where
+	 * the transaction doesn't protect anything.
+	 */
+	if (!failed && full) {
+		if (SQL_ERROR == SQL->Query(inter->sql_handle, "SELECT `id` FROM `%s` WHERE `%s`='%d' ORDER BY `id`", tablename, owner_column, owner_id)) {
+			Sql_ShowDebug(inter->sql_handle);
+			failed = true;
+		} else {
+			int rows = (int)SQL->NumRows(inter->sql_handle);
+
+			if (rows > 0)
+				CREATE(old_ids, int, rows);
+			while (old_count < rows && SQL_SUCCESS == SQL->NextRow(inter->sql_handle)) {
+				char *data;
+
+				SQL->GetData(inter->sql_handle, 0, &data, NULL);
+				old_ids[old_count++] = atoi(data);
+			}
+			SQL->FreeResult(inter->sql_handle);
+		}
+		VECTOR_TRUNCATE(slots->ids);
+	}
+
+	/**
+	 * Handle deletions, if any.
+	 */
+	StrBuf->Printf(&buf, "DELETE FROM `%s` WHERE `%s`='%d' AND `id` IN (", tablename, owner_column, owner_id);
+	for (int i = 0; i < count && !failed; i++) {
+		int slot = RBUFW(entries, i * entry_size);
+		struct item it;
+
+		memcpy(&it, RBUFP(entries, i * entry_size + 2), sizeof(it));
+		if (it.nameid != 0 || slot >= VECTOR_LENGTH(slots->ids) || VECTOR_INDEX(slots->ids, slot) == 0)
+			continue;
+
+		StrBuf->Printf(&buf, "%s'%d'", total_deletes == 0 ? "" : ", ", VECTOR_INDEX(slots->ids, slot));
+		VECTOR_INDEX(slots->ids, slot) = 0;
+		total_deletes++;
+	}
+	StrBuf->AppendStr(&buf, ")");
+
+	if (!failed && total_deletes > 0 && SQL_ERROR == SQL->QueryStr(inter->sql_handle, StrBuf->Value(&buf))) {
+		Sql_ShowDebug(inter->sql_handle);
+		failed = true;
+	}
+
+	/**
+	 * Replace the rows of modified slots, if any.
+	 */
+	StrBuf->Clear(&buf);
+	StrBuf->Printf(&buf, "REPLACE INTO `%s` (`id`, `%s`, ", tablename, owner_column);
+	inter_storage->slot_columns(&buf);
+	StrBuf->AppendStr(&buf, ") VALUES ");
+	for (int i = 0; i < count && !failed; i++) {
+		int slot = RBUFW(entries, i * entry_size);
+		struct item it;
+
+		memcpy(&it, RBUFP(entries, i * entry_size + 2), sizeof(it));
+		if (it.nameid == 0 || slot >= VECTOR_LENGTH(slots->ids) || VECTOR_INDEX(slots->ids, slot) == 0)
+			continue;
+
+		StrBuf->Printf(&buf, "%s('%d', '%d', ", total_updates == 0 ? "" : ", ", VECTOR_INDEX(slots->ids, slot), owner_id);
+		inter_storage->slot_values(&buf, &it);
+		StrBuf->AppendStr(&buf, ")");
+		total_updates++;
+	}
+
+	if (!failed && total_updates > 0 && SQL_ERROR == SQL->QueryStr(inter->sql_handle, StrBuf->Value(&buf))) {
+		Sql_ShowDebug(inter->sql_handle);
+		failed = true;
+	}
+
+	/**
+	 * A full save first overwrites the owner's existing rows, then inserts the remaining slots
+	 * with a single statement and finally deletes the rows that are no longer used.
+	 * Auto-increment IDs of a multi-row INSERT grow in row order and are above every existing
+	 * row, so the new row IDs are read back in ID order to rebuild the slot layout.
+	 */
+	if (full && !failed) {
+		int *new_slots = NULL;
+		int reused = 0;
+		StringBuf insert_buf;
+
+		if (count > 0)
+			CREATE(new_slots, int, count);
+
+		StrBuf->Init(&insert_buf);
+		StrBuf->Clear(&buf);
+		StrBuf->Printf(&buf, "REPLACE INTO `%s` (`id`, `%s`, ", tablename, owner_column);
+		inter_storage->slot_columns(&buf);
+		StrBuf->AppendStr(&buf, ") VALUES ");
+		StrBuf->Printf(&insert_buf, "INSERT INTO `%s` (`%s`, ", tablename, owner_column);
+		inter_storage->slot_columns(&insert_buf);
+		StrBuf->AppendStr(&insert_buf, ") VALUES ");
+		for (int i = 0; i < count; i++) {
+			int slot = RBUFW(entries, i * entry_size);
+			struct item it;
+
+			memcpy(&it, RBUFP(entries, i * entry_size + 2), sizeof(it));
+			if (it.nameid == 0)
+				continue;
+
+			if (slot >= max_slots) {
+				ShowError("inter_storage_slots_tosql: Invalid slot %d for %s %d, item %d skipped.\n", slot, owner_column, owner_id, it.nameid);
+				continue;
+			}
+
+			if (slot >= VECTOR_LENGTH(slots->ids)) {
+				VECTOR_ENSURE(slots->ids, slot + 1 - VECTOR_LENGTH(slots->ids), 1);
+				while (VECTOR_LENGTH(slots->ids) <= slot)
+					VECTOR_PUSH(slots->ids, 0);
+			}
+
+			if (reused < old_count) {
+				StrBuf->Printf(&buf, "%s('%d', '%d', ", total_updates == 0 ? "" : ", ", old_ids[reused], owner_id);
+				inter_storage->slot_values(&buf, &it);
+				StrBuf->AppendStr(&buf, ")");
+				VECTOR_INDEX(slots->ids, slot) = old_ids[reused++];
+				total_updates++;
+			} else {
+				StrBuf->Printf(&insert_buf, "%s('%d', ", total_inserts == 0 ? "" : ", ", owner_id);
+				inter_storage->slot_values(&insert_buf, &it);
+				StrBuf->AppendStr(&insert_buf, ")");
+				new_slots[total_inserts++] = slot;
+			}
+		}
+
+		if (total_updates > 0 && SQL_ERROR == SQL->QueryStr(inter->sql_handle, StrBuf->Value(&buf))) {
+			Sql_ShowDebug(inter->sql_handle);
+			failed = true;
+		}
+
+		if (!failed && total_inserts > 0 && SQL_ERROR == SQL->QueryStr(inter->sql_handle, StrBuf->Value(&insert_buf))) {
+			Sql_ShowDebug(inter->sql_handle);
+			failed = true;
+		}
+		StrBuf->Destroy(&insert_buf);
+
+		if (!failed && total_inserts > 0) {
+			if (SQL_ERROR == SQL->Query(inter->sql_handle, "SELECT `id` FROM `%s` WHERE `%s`='%d' AND `id`>'%d' ORDER BY `id`",
+			                            tablename, owner_column, owner_id, old_count > 0 ? old_ids[old_count - 1] : 0)) {
+				Sql_ShowDebug(inter->sql_handle);
+				failed = true;
+			} else if ((int)SQL->NumRows(inter->sql_handle) != total_inserts) {
+				ShowError("inter_storage_slots_tosql: Expected %d new rows for %s %d after a full save, found %d.\n", total_inserts, owner_column, owner_id, (int)SQL->NumRows(inter->sql_handle));
+				failed = true;
+			} else {
+				for (int i = 0; i < total_inserts && SQL_SUCCESS == SQL->NextRow(inter->sql_handle); i++) {
+					char *data;
+
+					SQL->GetData(inter->sql_handle, 0, &data, NULL);
+					VECTOR_INDEX(slots->ids, new_slots[i]) = atoi(data);
+				}
+			}
+			SQL->FreeResult(inter->sql_handle);
+		}
+
+		if (!failed && reused < old_count) {
+			StrBuf->Clear(&buf);
+			StrBuf->Printf(&buf, "DELETE FROM `%s` WHERE `%s`='%d' AND `id` IN (", tablename, owner_column, owner_id);
+			for (int i = reused; i < old_count; i++)
+				StrBuf->Printf(&buf, "%s'%d'", i == reused ? "" : ", ", old_ids[i]);
+			StrBuf->AppendStr(&buf, ")");
+			total_deletes = old_count - reused;
+
+			if (SQL_ERROR == SQL->QueryStr(inter->sql_handle, StrBuf->Value(&buf))) {
+				Sql_ShowDebug(inter->sql_handle);
+				failed = true;
+			}
+		}
+
+		aFree(new_slots);
+	}
+
+	/**
+	 * Insert the new slots of a delta save one by one, to learn their row IDs.
+	 */
+	for (int i = 0; i < count && !failed && !full; i++) {
+		int slot = RBUFW(entries, i * entry_size);
+		struct item it;
+
+		memcpy(&it, RBUFP(entries, i * entry_size + 2), sizeof(it));
+		if (it.nameid == 0 || (slot < VECTOR_LENGTH(slots->ids) && VECTOR_INDEX(slots->ids, slot) != 0))
+			continue;
+
+		if (slot >= max_slots) {
+			ShowError("inter_storage_slots_tosql: Invalid slot %d for %s %d, item %d skipped.\n", slot, owner_column, owner_id, it.nameid);
+			continue;
+		}
+
+		StrBuf->Clear(&buf);
+		StrBuf->Printf(&buf, "INSERT INTO `%s` (`%s`, ", tablename, owner_column);
+		inter_storage->slot_columns(&buf);
+		StrBuf->Printf(&buf, ") VALUES ('%d', ", owner_id);
+		inter_storage->slot_values(&buf, &it);
+		StrBuf->AppendStr(&buf, ")");
+
+		if (SQL_ERROR == SQL->QueryStr(inter->sql_handle, StrBuf->Value(&buf))) {
+			Sql_ShowDebug(inter->sql_handle);
+			failed = true;
+			break;
+		}
+
+		if (slot >= VECTOR_LENGTH(slots->ids)) {
+			VECTOR_ENSURE(slots->ids, slot + 1 - VECTOR_LENGTH(slots->ids), 1);
+			while (VECTOR_LENGTH(slots->ids) <= slot)
+				VECTOR_PUSH(slots->ids, 0);
+		}
+		VECTOR_INDEX(slots->ids, slot) = (int)SQL->LastInsertId(inter->sql_handle);
+		total_inserts++;
+	}
+
+	StrBuf->Destroy(&buf);
+	aFree(old_ids);
+
+	if (!failed && SQL_ERROR == SQL->QueryStr(inter->sql_handle, "COMMIT")) {
+		Sql_ShowDebug(inter->sql_handle);
+		failed = true;
+	}
+
+	if (failed) {
+		if (SQL_ERROR == SQL->QueryStr(inter->sql_handle, "ROLLBACK"))
+			Sql_ShowDebug(inter->sql_handle);
+		// The layout no longer matches the table, the next save has to be a full one.
+		inter_storage->slots_delete(table, owner_id);
+		ShowError("inter_storage_slots_tosql: Couldn't save storage item data! (%s: %d)\n", owner_column, owner_id);
+		return 1;
+	}
+
+	ShowInfo("storage save complete - %s: %d (deleted: %d, updated: %d, inserted: %d%s)\n", owner_column, owner_id,
+			 total_deletes, total_updates, total_inserts, full ? ", full" : "");
+	return 0;
+}
+
+/**
+ * Frees a slot layout.
+ *
+ * @param slots The slot layout.
+ */
+static void inter_storage_slots_free(struct inter_storage_slots *slots)
+{
+	nullpo_retv(slots);
+
+	VECTOR_CLEAR(slots->ids);
+	aFree(slots);
+}
+
+/**
+ * Drops the slot layout of a storage.
+ *
+ * @param table    TABLE_STORAGE or TABLE_GUILD_STORAGE.
+ * @param owner_id Account or guild ID owning the storage.
+ */
+static void inter_storage_slots_delete(enum inventory_table_type table, int owner_id)
+{
+	struct DBMap *db = inter_storage->slots_db(table);
+	struct inter_storage_slots *slots;
+
+	if (db == NULL)
+		return;
+
+	if ((slots = idb_get(db, owner_id)) != NULL) {
+		idb_remove(db, owner_id);
+		inter_storage->slots_free(slots);
+	}
+}
+
+/**
+ * Drops the slot layouts which have not been used for STORAGE_SLOTS_EXPIRE.
+ *
+ * @param db      The slot layout database.
+ * @param tick    The current tick.
+ * @param account Whether db is keyed by account ID; layouts of online accounts are kept.
+ */
+static void inter_storage_slots_expire(struct DBMap *db, int64 tick, bool account)
+{
+	struct DBIterator *iter;
+	union DBKey key;
+
+	nullpo_retv(db);
+
+	iter = db_iterator(db);
+	for (struct DBData *data = iter->first(iter, &key); dbi_exists(iter); data = iter->next(iter, &key)) {
+		struct inter_storage_slots *slots = DB->data2ptr(data);
+
+		if (DIFF_TICK(tick, slots->last_used) < STORAGE_SLOTS_EXPIRE)
+			continue;
+
+		if (account) {
+			const struct online_char_data *character = idb_get(chr->online_char_db, key.i);
+
+			if (character != NULL && character->char_id != -1)
+				continue;
+		}
+
+		inter_storage->slots_free(slots);
+		dbi_remove(iter);
+	}
+	dbi_destroy(iter);
+}
+
+/**
+ * Timer to expire unused slot layouts.
+ *
+ * @see timer->do_timer()
+ */
+static int inter_storage_slots_expire_timer(int tid, int64 tick, int id, intptr_t data)
+{
+	inter_storage->slots_expire(inter_storage->account_slots, tick, true);
+	inter_storage->slots_expire(inter_storage->guild_slots, tick, false);
+	return 0;
+}
+
 //---------------------------------------------------------
 // storage data initialize
 static int inter_storage_sql_init(void)
 {
+	inter_storage->account_slots = idb_alloc(DB_OPT_BASE);
+	inter_storage->guild_slots = idb_alloc(DB_OPT_BASE);
+
+	timer->add_func_list(inter_storage->slots_expire_timer, "inter_storage->slots_expire_timer");
+	timer->add_interval(timer->gettick() + 60 * 1000, inter_storage->slots_expire_timer, 0, 0, 5 * 60 * 1000);
 	return 1;
 }
 // storage data finalize
 static void inter_storage_sql_final(void)
 {
-	return;
+	struct DBMap *dbs[2] = { inter_storage->account_slots, inter_storage->guild_slots };
+
+	for (int i = 0; i < 2; i++) {
+		struct DBIterator *iter;
+		struct inter_storage_slots *slots;
+
+		if (dbs[i] == NULL)
+			continue;
+
+		iter = db_iterator(dbs[i]);
+		for (slots = dbi_first(iter); dbi_exists(iter); slots = dbi_next(iter))
+			inter_storage->slots_free(slots);
+		dbi_destroy(iter);
+		db_destroy(dbs[i]);
+	}
+	inter_storage->account_slots = NULL;
+	inter_storage->guild_slots = NULL;
 }
 
 // q?f[^?
@@ -381,12 +879,14 @@ static int inter_storage_delete(int account_id)
 {
 	if( SQL_ERROR == SQL->Query(inter->sql_handle, "DELETE FROM `%s` WHERE `account_id`='%d'", storage_db, account_id) )
 		Sql_ShowDebug(inter->sql_handle);
+	inter_storage->slots_delete(TABLE_STORAGE, account_id);
 	return 0;
 }
 static int inter_storage_guild_storage_delete(int guild_id)
 {
 	if( SQL_ERROR == SQL->Query(inter->sql_handle, "DELETE FROM `%s` WHERE `guild_id`='%d'", guild_storage_db, guild_id) )
 		Sql_ShowDebug(inter->sql_handle);
+	inter_storage->slots_delete(TABLE_GUILD_STORAGE, guild_id);
 	return 0;
 }
 
@@ -404,6 +904,7 @@ static bool inter_storage_retrieve_bound_items(int char_id, int account_id, int
 	struct item items[MAX_INVENTORY];
 	unsigned int bound_item[MAX_INVENTORY] = {0};
 
+	chr->cache_invalidate(char_id);
 	StrBuf->Init(&buf);
 	StrBuf->AppendStr(&buf, "SELECT `id`, `nameid`, `amount`, `equip`, `identify`, `refine`, `grade`, `attribute`, `expire_time`, `bound`, `unique_id`");
 	for (j = 0; j < MAX_SLOTS; ++j)
@@ -563,6 +1064,9 @@ static bool inter_storage_retrieve_bound_items(int char_id, int account_id, int
 		return false;
 	}
 
+	// The new rows aren't in the guild storage's slot layout, it's rebuilt when the storage is loaded again.
+	inter_storage->slots_delete(TABLE_GUILD_STORAGE, guild_id);
+
 	StrBuf->Destroy(&buf);
 	SQL->StmtFree(stmt);
 #endif
@@ -590,6 +1094,9 @@ void inter_storage_defaults(void)
 {
 	inter_storage = &inter_storage_s;
 
+	inter_storage->account_slots = NULL;
+	inter_storage->guild_slots = NULL;
+
 	inter_storage->tosql = inter_storage_tosql;
 	inter_storage->fromsql = inter_storage_fromsql;
 	inter_storage->guild_storage_tosql = inter_storage_guild_storage_tosql;
@@ -598,6 +1105,15 @@ void inter_storage_defaults(void)
 	inter_storage->sql_final = inter_storage_sql_final;
 	inter_storage->delete_ = inter_storage_delete;
 	inter_storage->guild_storage_delete = inter_storage_guild_storage_delete;
+	inter_storage->slots_db = inter_storage_slots_db;
+	inter_storage->slots_load = inter_storage_slots_load;
+	inter_storage->slots_tosql = inter_storage_slots_tosql;
+	inter_storage->slots_delete = inter_storage_slots_delete;
+	inter_storage->slots_free = inter_storage_slots_free;
+	inter_storage->slots_expire = inter_storage_slots_expire;
+	inter_storage->slots_expire_timer = inter_storage_slots_expire_timer;
+	inter_storage->slot_columns = inter_storage_slot_columns;
+	inter_storage->slot_values = inter_storage_slot_values;
 	inter_storage->parse_frommap = inter_storage_parse_frommap;
 	inter_storage->retrieve_bound_items = inter_storage_retrieve_bound_items;
 }
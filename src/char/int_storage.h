@@ -21,16 +21,37 @@
 #ifndef CHAR_INT_STORAGE_H
 #define CHAR_INT_STORAGE_H
 
+#include "char/char.h" // enum inventory_table_type
 #include "common/db.h"
 #include "common/hercules.h"
 
+struct StringBuf;
+struct item;
 struct storage_data;
 struct guild_storage;
 
+#ifndef STORAGE_SLOTS_EXPIRE
+#define STORAGE_SLOTS_EXPIRE (30 * 60 * 1000) //!< Time after which an unused slot layout is dropped, in milliseconds.
+#endif
+
+/**
+ * DB row IDs of a storage, indexed by the slots the map-server uses for it.
+ *
+ * Built when the storage is sent to a map-server and kept up to date by its saves,
+ * so that a save only touches the rows of the slots it carries.
+ **/
+struct inter_storage_slots {
+	int64 last_used;      ///< Tick of the last load or save.
+	VECTOR_DECL(int) ids; ///< Row ID of each slot (0 = empty slot).
+};
+
 /**
  * inter_storage interface
  **/
 struct inter_storage_interface {
+	struct DBMap *account_slots; // int account_id -> struct inter_storage_slots*
+	struct DBMap *guild_slots;   // int guild_id -> struct inter_storage_slots*
+
 	int (*tosql) (int account_id, const struct storage_data *p);
 	int (*fromsql) (int account_id, struct storage_data *p);
 	bool (*guild_storage_tosql) (int guild_id, const struct guild_storage *gstor);
@@ -41,6 +62,15 @@ struct inter_storage_interface {
 	int (*guild_storage_delete) (int guild_id);
 	int (*parse_frommap) (int fd);
 	bool (*retrieve_bound_items) (int char_id, int account_id, int guild_id);
+	struct DBMap *(*slots_db) (enum inventory_table_type table);
+	void (*slots_load) (enum inventory_table_type table, int owner_id, const struct item *items, int count);
+	int (*slots_tosql) (enum inventory_table_type table, int owner_id, bool full, const uint8 *entries, int count);
+	void (*slots_delete) (enum inventory_table_type table, int owner_id);
+	void (*slots_free) (struct inter_storage_slots *slots);
+	void (*slots_expire) (struct DBMap *db, int64 tick, bool account);
+	int (*slots_expire_timer) (int tid, int64 tick, int id, intptr_t data);
+	void (*slot_columns) (struct StringBuf *buf);
+	void (*slot_values) (struct StringBuf *buf, const struct item *it);
 };
 
 #ifdef HERCULES_CORE
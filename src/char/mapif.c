@@ -468,14 +468,19 @@ static int mapif_guild_noinfo(int guild_id)
 	return 0;
 }
 
+/**
+ * Sends guild info to the map-server.
+ *
+ * The emblem isn't included: map-servers look it up by g->emblem_hash and
+ * only request it (see mapif_parse_GuildEmblemRequest) when it's not stored yet.
+ */
 static int mapif_guild_info(const struct guild *g)
 {
-	mapif->guild_info_emblem(g);
 	mapif->guild_info_basic(g);
 	return 0;
 }
 
-// Send emblem before guild info
+// Send emblem data requested by the map-server
 static int mapif_guild_info_emblem(const struct guild *g)
 {
 	nullpo_ret(g);
@@ -736,6 +741,24 @@ static int mapif_parse_CreateGuild(int fd, int account_id, const char *name, con
 	return 0;
 }
 
+/**
+ * Sends the emblem of a guild to the map-server, which doesn't have it stored yet.
+ *
+ * Requests for an emblem that was replaced in the meantime are ignored, the new
+ * one has already been sent by mapif->guild_emblem.
+ */
+static int mapif_parse_GuildEmblemRequest(int fd)
+{
+	const struct PACKET_MAPCHAR_GUILD_EMBLEM_REQ *p = RFIFOP(fd, 0);
+	const struct guild *g = inter_guild->fromsql(p->guild_id);
+
+	if (g == NULL || g->emblem_len <= 0 || g->emblem_hash != p->emblem_hash)
+		return 0;
+
+	mapif->guild_info_emblem(g);
+	return 0;
+}
+
 // Return guild info to client
 static int mapif_parse_GuildInfo(int fd, int guild_id)
 {
@@ -1768,14 +1791,16 @@ static void mapif_rodex_checkname(int fd, int reqchar_id, int target_char_id, in
 /**
  * Sends loaded guild storage to a map-server.
  *
+ * The storage is sent in pages of up to STORAGE_PAGE_SIZE items.
+ *
  * Packets sent:
- * 0x3818 <len>.W <account id>.L <guild id != 0>.L <flag>.B <capacity>.L <amount>.L {<item>.P}*<capacity>
+ * 0x3818 <len>.W <account id>.L <guild id != 0>.L <flag>.B <capacity>.L <amount>.L <offset>.L {<item>.P}*<count>
  * 0x3818 <len>.W <account id>.L <guild id == 0>.L
  *
  * @param fd         The map-server's fd.
  * @param account_id The requesting character's account id.
  * @param guild_id   The requesting guild's ID.
- * @param flag       Additional options, passed through to the map server (1 = open storage)
+ * @param flag       Additional options, passed through to the map server (STORAGE_PAGE_OPEN = open storage)
  * @return Error code
  * @retval 0 in case of success.
  */
@@ -1788,20 +1813,38 @@ static int mapif_load_guild_storage(int fd, int account_id, int guild_id, char f
 		struct guild_storage *gs = aCalloc(1, sizeof(*gs));
 
 		if (inter_storage->guild_storage_fromsql(guild_id, gs) == 0) {
-			int size = 21 + sizeof gs->items.data[0] * gs->items.capacity;
-			WFIFOHEAD(fd, size);
-			WFIFOW(fd, 0) = 0x3818;
-			WFIFOW(fd, 2) = size;
-			WFIFOL(fd, 4) = account_id;
-			WFIFOL(fd, 8) = guild_id;
-			WFIFOB(fd, 12) = flag;
-			WFIFOL(fd, 13) = gs->items.capacity;
-			WFIFOL(fd, 17) = gs->items.amount;
-			if (gs->items.data != NULL) {
-				memcpy(WFIFOP(fd, 21), gs->items.data, sizeof gs->items.data[0] * gs->items.capacity);
+			int offset = 0;
+
+			inter_storage->slots_load(TABLE_GUILD_STORAGE, guild_id, gs->items.data, gs->items.capacity);
+
+			do {
+				int count = min(gs->items.capacity - offset, STORAGE_PAGE_SIZE);
+				int size = 25 + sizeof gs->items.data[0] * count;
+				int page_flag = flag & STORAGE_PAGE_OPEN;
+
+				if (offset == 0)
+					page_flag |= STORAGE_PAGE_FIRST;
+				if (offset + count >= gs->items.capacity)
+					page_flag |= STORAGE_PAGE_LAST;
+
+				WFIFOHEAD(fd, size);
+				WFIFOW(fd, 0) = 0x3818;
+				WFIFOW(fd, 2) = size;
+				WFIFOL(fd, 4) = account_id;
+				WFIFOL(fd, 8) = guild_id;
+				WFIFOB(fd, 12) = page_flag;
+				WFIFOL(fd, 13) = gs->items.capacity;
+				WFIFOL(fd, 17) = gs->items.amount;
+				WFIFOL(fd, 21) = offset;
+				if (count > 0)
+					memcpy(WFIFOP(fd, 25), &gs->items.data[offset], sizeof gs->items.data[0] * count);
+				WFIFOSET(fd, size);
+
+				offset += count;
+			} while (offset < gs->items.capacity);
+
+			if (gs->items.data != NULL)
 				aFree(gs->items.data);
-			}
-			WFIFOSET(fd, size);
 			aFree(gs);
 			return 0;
 		}
@@ -1830,31 +1873,46 @@ static int mapif_save_guild_storage_ack(int fd, int account_id, int guild_id, in
 }
 
 /**
- * Loads the account storage and send to the map server.
- * @packet 0x3805     [out] <account_id>.L <struct item[]>.P
+ * Loads the account storage and sends it to the map server, in pages of up to STORAGE_PAGE_SIZE items.
+ * @packet 0x3805     [out] <packet_len>.W <account_id>.L <flag>.B <struct item[]>.P
  * @param  fd         [in]  file/socket descriptor.
  * @param  account_id [in]  account id of the session.
+ * @param  flag       [in]  options passed through to the map server (STORAGE_PAGE_OPEN).
  * @return 1 on success, 0 on failure.
  */
-static int mapif_account_storage_load(int fd, int account_id)
+static int mapif_account_storage_load(int fd, int account_id, int flag)
 {
 	struct storage_data stor = { 0 };
-	int count = 0, i = 0, len = 0;
+	int count = 0, i = 0, offset = 0;
 
 	Assert_ret(account_id > 0);
 
 	VECTOR_INIT(stor.item);
 	count = inter_storage->fromsql(account_id, &stor);
 
-	len = 8 + count * sizeof(struct item);
+	inter_storage->slots_load(TABLE_STORAGE, account_id, VECTOR_DATA(stor.item), count);
 
-	WFIFOHEAD(fd, len);
-	WFIFOW(fd, 0) = 0x3805;
-	WFIFOW(fd, 2) = (uint16) len;
-	WFIFOL(fd, 4) = account_id;
-	for (i = 0; i < count; i++)
-		memcpy(WFIFOP(fd, 8 + i * sizeof(struct item)), &VECTOR_INDEX(stor.item, i), sizeof(struct item));
-	WFIFOSET(fd, len);
+	do {
+		int page = min(count - offset, STORAGE_PAGE_SIZE);
+		int len = 9 + page * sizeof(struct item);
+		int page_flag = flag & STORAGE_PAGE_OPEN;
+
+		if (offset == 0)
+			page_flag |= STORAGE_PAGE_FIRST;
+		if (offset + page >= count)
+			page_flag |= STORAGE_PAGE_LAST;
+
+		WFIFOHEAD(fd, len);
+		WFIFOW(fd, 0) = 0x3805;
+		WFIFOW(fd, 2) = (uint16) len;
+		WFIFOL(fd, 4) = account_id;
+		WFIFOB(fd, 8) = page_flag;
+		for (i = 0; i < page; i++)
+			memcpy(WFIFOP(fd, 9 + i * sizeof(struct item)), &VECTOR_INDEX(stor.item, offset + i), sizeof(struct item));
+		WFIFOSET(fd, len);
+
+		offset += page;
+	} while (offset < count);
 
 	VECTOR_CLEAR(stor.item);
 
@@ -1863,7 +1921,7 @@ static int mapif_account_storage_load(int fd, int account_id)
 
 /**
  * Parses account storage load request from map server.
- * @packet 0x3010 [in] <account_id>.L
+ * @packet 0x3010 [in] <account_id>.L <flag>.B
  * @param  fd     [in] file/socket descriptor
  * @return 1 on success, 0 on failure.
  */
@@ -1874,7 +1932,7 @@ static int mapif_parse_AccountStorageLoad(int fd)
 	Assert_ret(fd > 0);
 	Assert_ret(account_id > 0);
 
-	mapif->account_storage_load(fd, account_id);
+	mapif->account_storage_load(fd, account_id, RFIFOB(fd, 6));
 
 	return 1;
 }
@@ -1883,7 +1941,7 @@ static int mapif_parse_AccountStorageLoad(int fd)
  * Parses an account storage save request from the map server.
  *
  * @code{.unparsed}
- *	@packet 0x3011 [in] <packet_len>.W <account_id>.L <struct item[]>.P
+ *	@packet 0x3011 [in] <packet_len>.W <account_id>.L <full>.B {<slot>.W <struct item>.P}*
  * @endcode
  *
  * @attention If the size of packet 0x3011 changes,
@@ -1899,34 +1957,23 @@ static int mapif_parse_AccountStorageLoad(int fd)
  **/
 static int mapif_parse_AccountStorageSave(int fd)
 {
-	int payload_size = RFIFOW(fd, 2) - 8, account_id = RFIFOL(fd, 4);
-	int i = 0, count = 0;
-	struct storage_data p_stor = { 0 };
+	int payload_size = RFIFOW(fd, 2) - 9, account_id = RFIFOL(fd, 4);
+	bool full = RFIFOB(fd, 8) != 0;
+	int count = 0;
 
 	Assert_ret(fd > 0);
 	Assert_ret(account_id > 0);
 
-	count = payload_size/sizeof(struct item);
-
-	VECTOR_INIT(p_stor.item);
-
-	if (count > 0) {
-		VECTOR_ENSURE(p_stor.item, count, 1);
-
-		for (i = 0; i < count; i++) {
-			const struct item *it = RFIFOP(fd, 8 + i * sizeof(struct item));
-
-			VECTOR_PUSH(p_stor.item, *it);
-		}
-
-		p_stor.aggregate = count;
+	if (payload_size < 0 || payload_size % (2 + sizeof(struct item)) != 0) {
+		ShowError("mapif_parse_AccountStorageSave: data size mismatch! (AID: %d, payload: %d)\n", account_id, payload_size);
+		mapif->sAccountStorageSaveAck(fd, account_id, false);
+		return 0;
 	}
 
-	inter_storage->tosql(account_id, &p_stor);
+	count = payload_size / (2 + sizeof(struct item));
 
-	VECTOR_CLEAR(p_stor.item);
-
-	mapif->sAccountStorageSaveAck(fd, account_id, true);
+	mapif->sAccountStorageSaveAck(fd, account_id,
+	                              inter_storage->slots_tosql(TABLE_STORAGE, account_id, full, RFIFOP(fd, 9), count) == 0);
 
 	return 1;
 }
@@ -1961,7 +2008,7 @@ static int mapif_parse_LoadGuildStorage(int fd)
  * Parses a guild storage save request from the map server.
  *
  * @code{.unparsed}
- *	@packet 0x3019 [in] <packet_len>.W <account_id>.L <guild_id>.L {<struct item>.P}*<capacity>
+ *	@packet 0x3019 [in] <packet_len>.W <account_id>.L <guild_id>.L <full>.B {<slot>.W <struct item>.P}*
  * @endcode
  *
  * @attention If the size of packet 0x3019 changes,
@@ -1971,45 +2018,43 @@ static int mapif_parse_LoadGuildStorage(int fd)
  * @see intif_send_guild_storage()
  *
  * @param[in] fd The file/socket descriptor.
- * @return Always 0.
+ * @return 0 on success, 1 on failure.
  *
  **/
 static int mapif_parse_SaveGuildStorage(int fd)
 {
 	RFIFOHEAD(fd);
-	int len = RFIFOW(fd, 2);
+	int payload_size = RFIFOW(fd, 2) - 13;
 	int account_id = RFIFOL(fd, 4);
 	int guild_id = RFIFOL(fd, 8);
-	int storage_capacity = RFIFOL(fd, 12);
-	int storage_amount = RFIFOL(fd, 16);
+	bool full = RFIFOB(fd, 12) != 0;
 
-	int expected = 20 + sizeof(struct item) * storage_capacity;
-	if (expected != len) {
-		ShowError("mapif_parse_SaveGuildStorage: data size mismatch: %d != %d\n", len, expected);
+	if (payload_size < 0 || payload_size % (2 + sizeof(struct item)) != 0) {
+		ShowError("mapif_parse_SaveGuildStorage: data size mismatch! (GID: %d, payload: %d)\n", guild_id, payload_size);
 
 		mapif->save_guild_storage_ack(fd, account_id, guild_id, 1);
 		return 1;
 	}
 
-	struct guild_storage gstor = { 0 };
-
-	if (storage_capacity > 0) {
-		gstor.items.data = aCalloc(storage_capacity, sizeof gstor.items.data[0]);
-		memcpy(gstor.items.data, RFIFOP(fd, 20), sizeof gstor.items.data[0] * storage_capacity);
+	if (SQL_ERROR == SQL->Query(inter->sql_handle, "SELECT `guild_id` FROM `%s` WHERE `guild_id`='%d'", guild_db, guild_id)) {
+		Sql_ShowDebug(inter->sql_handle);
+		mapif->save_guild_storage_ack(fd, account_id, guild_id, 1);
+		return 1;
+	} else if (SQL->NumRows(inter->sql_handle) < 1) {
+		// guild doesn't exist
+		SQL->FreeResult(inter->sql_handle);
+		mapif->save_guild_storage_ack(fd, account_id, guild_id, 1);
+		return 1;
 	}
-	gstor.items.amount = storage_amount;
-	gstor.items.capacity = storage_capacity;
-	gstor.guild_id = guild_id;
+	SQL->FreeResult(inter->sql_handle);
+
+	int count = payload_size / (2 + sizeof(struct item));
 
-	if (!inter_storage->guild_storage_tosql(guild_id, &gstor)) {
-		if (gstor.items.data != NULL)
-			aFree(gstor.items.data);
+	if (inter_storage->slots_tosql(TABLE_GUILD_STORAGE, guild_id, full, RFIFOP(fd, 13), count) != 0) {
 		mapif->save_guild_storage_ack(fd, account_id, guild_id, 1);
 		return 1;
 	}
 
-	if (gstor.items.data != NULL)
-		aFree(gstor.items.data);
 	mapif->save_guild_storage_ack(fd, account_id, guild_id, 0);
 	return 0;
 }
@@ -2438,6 +2483,7 @@ void mapif_defaults(void)
 	mapif->parse_GuildAlliance = mapif_parse_GuildAlliance;
 	mapif->parse_GuildNotice = mapif_parse_GuildNotice;
 	mapif->parse_GuildEmblem = mapif_parse_GuildEmblem;
+	mapif->parse_GuildEmblemRequest = mapif_parse_GuildEmblemRequest;
 	mapif->parse_GuildCastleDataLoad = mapif_parse_GuildCastleDataLoad;
 	mapif->parse_GuildCastleDataSave = mapif_parse_GuildCastleDataSave;
 	mapif->parse_GuildMasterChange = mapif_parse_GuildMasterChange;
@@ -98,6 +98,7 @@ struct mapif_interface {
 	int (*parse_GuildAlliance) (int fd, int guild_id1, int guild_id2, int account_id1, int account_id2, int flag);
 	int (*parse_GuildNotice) (int fd, int guild_id, const char *mes1, const char *mes2);
 	int (*parse_GuildEmblem) (int fd);
+	int (*parse_GuildEmblemRequest) (int fd);
 	int (*parse_GuildCastleDataLoad) (int fd, int len, const int *castle_ids);
 	int (*parse_GuildCastleDataSave) (int fd, int castle_id, int index, int value);
 	int (*parse_GuildMasterChange) (int fd, int guild_id, const char* name, int len);
@@ -176,7 +177,7 @@ struct mapif_interface {
 	int (*save_guild_storage_ack) (int fd, int account_id, int guild_id, int fail);
 	int (*parse_LoadGuildStorage) (int fd);
 	int (*parse_SaveGuildStorage) (int fd);
-	int (*account_storage_load) (int fd, int account_id);
+	int (*account_storage_load) (int fd, int account_id, int flag);
 	int (*pAccountStorageLoad) (int fd);
 	int (*pAccountStorageSave) (int fd);
 	void (*sAccountStorageSaveAck) (int fd, int account_id, bool save);
@@ -101,6 +101,8 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 	#endif // CHAR_CAPIIF_H
 	#ifdef CHAR_CHAR_H
 		{ "char_auth_node", sizeof(struct char_auth_node), SERVER_TYPE_CHAR },
+		{ "char_cache", sizeof(struct char_cache), SERVER_TYPE_CHAR },
+		{ "char_cache_entry", sizeof(struct char_cache_entry), SERVER_TYPE_CHAR },
 		{ "char_interface", sizeof(struct char_interface), SERVER_TYPE_CHAR },
 		{ "char_session_data", sizeof(struct char_session_data), SERVER_TYPE_CHAR },
 		{ "mmo_map_server", sizeof(struct mmo_map_server), SERVER_TYPE_CHAR },
@@ -187,6 +189,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 	#endif // CHAR_INT_RODEX_H
 	#ifdef CHAR_INT_STORAGE_H
 		{ "inter_storage_interface", sizeof(struct inter_storage_interface), SERVER_TYPE_CHAR },
+		{ "inter_storage_slots", sizeof(struct inter_storage_slots), SERVER_TYPE_CHAR },
 	#else
 		#define CHAR_INT_STORAGE_H
 	#endif // CHAR_INT_STORAGE_H
@@ -323,6 +326,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 	#ifdef COMMON_MAPCHARPACKETS_H
 		{ "PACKET_MAPCHAR_AGENCY_JOIN_PARTY_REQ", sizeof(struct PACKET_MAPCHAR_AGENCY_JOIN_PARTY_REQ), SERVER_TYPE_ALL },
 		{ "PACKET_MAPCHAR_GUILD_EMBLEM", sizeof(struct PACKET_MAPCHAR_GUILD_EMBLEM), SERVER_TYPE_ALL },
+		{ "PACKET_MAPCHAR_GUILD_EMBLEM_REQ", sizeof(struct PACKET_MAPCHAR_GUILD_EMBLEM_REQ), SERVER_TYPE_ALL },
 	#else
 		#define COMMON_MAPCHARPACKETS_H
 	#endif // COMMON_MAPCHARPACKETS_H
@@ -381,6 +385,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 		{ "script_reg_state", sizeof(struct script_reg_state), SERVER_TYPE_ALL },
 		{ "script_reg_str", sizeof(struct script_reg_str), SERVER_TYPE_ALL },
 		{ "status_change_data", sizeof(struct status_change_data), SERVER_TYPE_ALL },
+		{ "storage_changes", sizeof(struct storage_changes), SERVER_TYPE_ALL },
 		{ "storage_data", sizeof(struct storage_data), SERVER_TYPE_ALL },
 	#else
 		#define COMMON_MMO_H
@@ -405,6 +410,13 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 	#else
 		#define COMMON_PACKETS_STRUCT_H
 	#endif // COMMON_PACKETS_STRUCT_H
+	#ifdef COMMON_PROFILER_H
+		{ "profiler_interface", sizeof(struct profiler_interface), SERVER_TYPE_ALL },
+		{ "profiler_stats", sizeof(struct profiler_stats), SERVER_TYPE_ALL },
+		{ "profiler_zone", sizeof(struct profiler_zone), SERVER_TYPE_ALL },
+	#else
+		#define COMMON_PROFILER_H
+	#endif // COMMON_PROFILER_H
 	#ifdef COMMON_RANDOM_H
 		{ "rnd_interface", sizeof(struct rnd_interface), SERVER_TYPE_ALL },
 	#else
@@ -455,6 +467,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 	#endif // COMMON_THREAD_H
 	#ifdef COMMON_TIMER_H
 		{ "TimerData", sizeof(struct TimerData), SERVER_TYPE_ALL },
+		{ "TimerTask", sizeof(struct TimerTask), SERVER_TYPE_ALL },
 		{ "timer_interface", sizeof(struct timer_interface), SERVER_TYPE_ALL },
 	#else
 		#define COMMON_TIMER_H
@@ -616,6 +629,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 		{ "hCSData", sizeof(struct hCSData), SERVER_TYPE_MAP },
 		{ "merge_item", sizeof(struct merge_item), SERVER_TYPE_MAP },
 		{ "s_packet_db", sizeof(struct s_packet_db), SERVER_TYPE_MAP },
+		{ "s_packet_stats", sizeof(struct s_packet_stats), SERVER_TYPE_MAP },
 	#else
 		#define MAP_CLIF_H
 	#endif // MAP_CLIF_H
@@ -666,8 +680,10 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 	#ifdef MAP_GUILD_H
 		{ "eventlist", sizeof(struct eventlist), SERVER_TYPE_MAP },
 		{ "guardian_data", sizeof(struct guardian_data), SERVER_TYPE_MAP },
+		{ "guild_emblem", sizeof(struct guild_emblem), SERVER_TYPE_MAP },
 		{ "guild_expcache", sizeof(struct guild_expcache), SERVER_TYPE_MAP },
 		{ "guild_interface", sizeof(struct guild_interface), SERVER_TYPE_MAP },
+		{ "guild_xy_entry", sizeof(struct guild_xy_entry), SERVER_TYPE_MAP },
 		{ "s_guild_skill_tree", sizeof(struct s_guild_skill_tree), SERVER_TYPE_MAP },
 	#else
 		#define MAP_GUILD_H
@@ -706,6 +722,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 		{ "item_combo", sizeof(struct item_combo), SERVER_TYPE_MAP },
 		{ "item_data", sizeof(struct item_data), SERVER_TYPE_MAP },
 		{ "item_group", sizeof(struct item_group), SERVER_TYPE_MAP },
+		{ "item_hot_data", sizeof(struct item_hot_data), SERVER_TYPE_MAP },
 		{ "item_lapineddukddak", sizeof(struct item_lapineddukddak), SERVER_TYPE_MAP },
 		{ "item_lapineupgrade", sizeof(struct item_lapineupgrade), SERVER_TYPE_MAP },
 		{ "item_package", sizeof(struct item_package), SERVER_TYPE_MAP },
@@ -722,6 +739,9 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 	#endif // MAP_ITEMDB_H
 	#ifdef MAP_LOG_H
 		{ "log_interface", sizeof(struct log_interface), SERVER_TYPE_MAP },
+		{ "log_journal_header", sizeof(struct log_journal_header), SERVER_TYPE_MAP },
+		{ "log_journal_record", sizeof(struct log_journal_record), SERVER_TYPE_MAP },
+		{ "log_record", sizeof(struct log_record), SERVER_TYPE_MAP },
 	#else
 		#define MAP_LOG_H
 	#endif // MAP_LOG_H
@@ -744,6 +764,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 		#define MAP_MAPIIF_H
 	#endif // MAP_MAPIIF_H
 	#ifdef MAP_MAPREG_H
+		{ "mapreg_delete", sizeof(struct mapreg_delete), SERVER_TYPE_MAP },
 		{ "mapreg_interface", sizeof(struct mapreg_interface), SERVER_TYPE_MAP },
 		{ "mapreg_save", sizeof(struct mapreg_save), SERVER_TYPE_MAP },
 	#else
@@ -780,6 +801,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 	#ifdef MAP_MOB_H
 		{ "item_drop", sizeof(struct item_drop), SERVER_TYPE_MAP },
 		{ "item_drop_list", sizeof(struct item_drop_list), SERVER_TYPE_MAP },
+		{ "mob_ai_hot", sizeof(struct mob_ai_hot), SERVER_TYPE_MAP },
 		{ "mob_chat", sizeof(struct mob_chat), SERVER_TYPE_MAP },
 		{ "mob_data", sizeof(struct mob_data), SERVER_TYPE_MAP },
 		{ "mob_db", sizeof(struct mob_db), SERVER_TYPE_MAP },
@@ -798,7 +820,9 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 		{ "event_data", sizeof(struct event_data), SERVER_TYPE_MAP },
 		{ "npc_barter_currency", sizeof(struct npc_barter_currency), SERVER_TYPE_MAP },
 		{ "npc_chat_interface", sizeof(struct npc_chat_interface), SERVER_TYPE_MAP },
+		{ "npc_chat_listeners", sizeof(struct npc_chat_listeners), SERVER_TYPE_MAP },
 		{ "npc_data", sizeof(struct npc_data), SERVER_TYPE_MAP },
+		{ "npc_event_batch", sizeof(struct npc_event_batch), SERVER_TYPE_MAP },
 		{ "npc_interface", sizeof(struct npc_interface), SERVER_TYPE_MAP },
 		{ "npc_item_list", sizeof(struct npc_item_list), SERVER_TYPE_MAP },
 		{ "npc_label_list", sizeof(struct npc_label_list), SERVER_TYPE_MAP },
@@ -809,6 +833,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 		{ "npc_timerevent_list", sizeof(struct npc_timerevent_list), SERVER_TYPE_MAP },
 		{ "pcre_interface", sizeof(struct pcre_interface), SERVER_TYPE_MAP },
 		{ "pcrematch_entry", sizeof(struct pcrematch_entry), SERVER_TYPE_MAP },
+		{ "pcrematch_matcher", sizeof(struct pcrematch_matcher), SERVER_TYPE_MAP },
 		{ "pcrematch_set", sizeof(struct pcrematch_set), SERVER_TYPE_MAP },
 	#else
 		#define MAP_NPC_H
@@ -1075,6 +1100,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 		{ "party_data", sizeof(struct party_data), SERVER_TYPE_MAP },
 		{ "party_interface", sizeof(struct party_interface), SERVER_TYPE_MAP },
 		{ "party_member_data", sizeof(struct party_member_data), SERVER_TYPE_MAP },
+		{ "party_xy_entry", sizeof(struct party_xy_entry), SERVER_TYPE_MAP },
 	#else
 		#define MAP_PARTY_H
 	#endif // MAP_PARTY_H
@@ -1107,6 +1133,8 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 		{ "s_addeffectonskill", sizeof(struct s_addeffectonskill), SERVER_TYPE_MAP },
 		{ "s_autobonus", sizeof(struct s_autobonus), SERVER_TYPE_MAP },
 		{ "s_autospell", sizeof(struct s_autospell), SERVER_TYPE_MAP },
+		{ "s_inventory_index", sizeof(struct s_inventory_index), SERVER_TYPE_MAP },
+		{ "s_packet_rate", sizeof(struct s_packet_rate), SERVER_TYPE_MAP },
 		{ "sg_data", sizeof(struct sg_data), SERVER_TYPE_MAP },
 		{ "skill_tree_entry", sizeof(struct skill_tree_entry), SERVER_TYPE_MAP },
 		{ "skill_tree_requirement", sizeof(struct skill_tree_requirement), SERVER_TYPE_MAP },
@@ -1171,6 +1199,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 		{ "script_queue_iterator", sizeof(struct script_queue_iterator), SERVER_TYPE_MAP },
 		{ "script_retinfo", sizeof(struct script_retinfo), SERVER_TYPE_MAP },
 		{ "script_stack", sizeof(struct script_stack), SERVER_TYPE_MAP },
+		{ "script_stack_chunk", sizeof(struct script_stack_chunk), SERVER_TYPE_MAP },
 		{ "script_state", sizeof(struct script_state), SERVER_TYPE_MAP },
 		{ "script_string_buf", sizeof(struct script_string_buf), SERVER_TYPE_MAP },
 		{ "script_syntax_data", sizeof(struct script_syntax_data), SERVER_TYPE_MAP },
@@ -1221,6 +1250,7 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 		{ "sc_display_entry", sizeof(struct sc_display_entry), SERVER_TYPE_MAP },
 		{ "status_change", sizeof(struct status_change), SERVER_TYPE_MAP },
 		{ "status_change_entry", sizeof(struct status_change_entry), SERVER_TYPE_MAP },
+		{ "status_change_slot", sizeof(struct status_change_slot), SERVER_TYPE_MAP },
 		{ "status_data", sizeof(struct status_data), SERVER_TYPE_MAP },
 		{ "status_interface", sizeof(struct status_interface), SERVER_TYPE_MAP },
 		{ "weapon_atk", sizeof(struct weapon_atk), SERVER_TYPE_MAP },
@@ -1253,6 +1283,8 @@ HPExport const struct s_HPMDataCheck HPMDataCheck[] = {
 	#endif // MAP_UNIT_H
 	#ifdef MAP_VENDING_H
 		{ "s_vending", sizeof(struct s_vending), SERVER_TYPE_MAP },
+		{ "s_vending_index_bucket", sizeof(struct s_vending_index_bucket), SERVER_TYPE_MAP },
+		{ "s_vending_index_entry", sizeof(struct s_vending_index_entry), SERVER_TYPE_MAP },
 		{ "vending_interface", sizeof(struct vending_interface), SERVER_TYPE_MAP },
 	#else
 		#define MAP_VENDING_H
@@ -302,6 +302,9 @@ struct pet_interface *pet;
 #ifdef CHAR_PINCODE_H /* pincode */
 struct pincode_interface *pincode;
 #endif // CHAR_PINCODE_H
+#ifdef COMMON_PROFILER_H /* profiler */
+struct profiler_interface *profiler;
+#endif // COMMON_PROFILER_H
 #ifdef MAP_QUEST_H /* quest */
 struct quest_interface *quest;
 #endif // MAP_QUEST_H
@@ -740,6 +743,10 @@ HPExport const char *HPM_shared_symbols(int server_type)
 	if ((server_type&(SERVER_TYPE_CHAR)) != 0 && !HPM_SYMBOL("pincode", pincode))
 		return "pincode";
 #endif // CHAR_PINCODE_H
+#ifdef COMMON_PROFILER_H /* profiler */
+	if ((server_type&(SERVER_TYPE_ALL)) != 0 && !HPM_SYMBOL("profiler", profiler))
+		return "profiler";
+#endif // COMMON_PROFILER_H
 #ifdef MAP_QUEST_H /* quest */
 	if ((server_type&(SERVER_TYPE_MAP)) != 0 && !HPM_SYMBOL("quest", quest))
 		return "quest";
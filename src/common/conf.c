@@ -23,9 +23,13 @@
 #include "conf.h"
 
 #include "common/core.h"
+#include "common/memmgr.h" // aCalloc, aFree
+#include "common/mutex.h"
 #include "common/nullpo.h" // nullpo_retv
 #include "common/showmsg.h" // ShowError
 #include "common/strlib.h" // safestrncpy
+#include "common/sysinfo.h" // cpucores
+#include "common/thread.h"
 #include "common/utils.h" // exists
 
 #include <libconfig/libconfig.h>
@@ -73,6 +77,9 @@ static void config_format_db_path(const char *filename, char *path_buf, int buff
  */
 static int config_load_file(struct config_t *config, const char *config_filename)
 {
+	if (config_filename != NULL && libconfig->prefetch_take(config, config_filename))
+		return CONFIG_TRUE;
+
 	libconfig->init(config);
 
 	if (config_filename != NULL && strlen(config_filename) < 300) {
@@ -96,6 +103,222 @@ static int config_load_file(struct config_t *config, const char *config_filename
 	return CONFIG_TRUE;
 }
 
+#define CONFIG_PREFETCH_MAX_WORKERS 8
+
+/// Configuration file parsed by a worker thread (@see config_prefetch)
+struct config_prefetch_entry {
+	char filename[256];
+	struct config_t config;
+	bool loaded;                          ///< Whether the file was parsed successfully
+	bool done;                            ///< Whether a worker finished with this file (protected by prefetch.lock)
+	struct config_prefetch_entry *next;   ///< Next entry in prefetch.list (main thread only)
+	struct config_prefetch_entry *queued; ///< Next entry waiting for a worker (protected by prefetch.lock)
+};
+
+/// Worker pool parsing configuration files in background
+static struct {
+	struct config_prefetch_entry *list;  ///< All prefetched files not taken yet
+	struct config_prefetch_entry *queue; ///< Files waiting for a worker
+	struct mutex_data *lock;
+	struct cond_data *queue_cond;        ///< Signaled when a file is queued or the pool is closing
+	struct cond_data *done_cond;         ///< Signaled when a worker finishes a file
+	struct thread_handle *workers[CONFIG_PREFETCH_MAX_WORKERS];
+	int worker_count;
+	bool closing;
+} prefetch;
+
+/**
+ * Worker thread of config_prefetch.
+ *
+ * Only calls libconfig directly (no hooks, no memmgr, no console output),
+ * errors are reported when the file is loaded again by libconfig->load_file.
+ * Runs until config_prefetch_clear closes the pool.
+ */
+static void *config_prefetch_worker(void *param)
+{
+	while (true) {
+		mutex->lock(prefetch.lock);
+		while (prefetch.queue == NULL && !prefetch.closing)
+			mutex->cond_wait(prefetch.queue_cond, prefetch.lock, -1);
+		struct config_prefetch_entry *entry = prefetch.queue;
+		if (entry != NULL)
+			prefetch.queue = entry->queued;
+		mutex->unlock(prefetch.lock);
+
+		if (entry == NULL)
+			break;
+
+		config_init(&entry->config);
+		if (strlen(entry->filename) < 300) {
+			char include_path[350];
+			strcpy(include_path, "conf/import/include/");
+			strcat(include_path, SERVER_NAME);
+			config_set_include_dir(&entry->config, include_path);
+		}
+		entry->loaded = (config_read_file(&entry->config, entry->filename) == CONFIG_TRUE);
+
+		mutex->lock(prefetch.lock);
+		entry->done = true;
+		mutex->cond_broadcast(prefetch.done_cond);
+		mutex->unlock(prefetch.lock);
+	}
+
+	return NULL;
+}
+
+/**
+ * Starts parsing a configuration file in a worker thread.
+ *
+ * The next libconfig->load_file() call for the same file waits for the
+ * worker and takes its result instead of parsing the file again, so
+ * independent big files (e.g. databases) are parsed in parallel while
+ * the main thread loads other data.
+ * Must be followed by libconfig->prefetch_clear() once loading is over.
+ *
+ * @param config_filename The file to read.
+ */
+static void config_prefetch(const char *config_filename)
+{
+	nullpo_retv(config_filename);
+
+	if (!exists(config_filename))
+		return;
+
+	if (prefetch.lock == NULL) {
+		prefetch.lock = mutex->create();
+		prefetch.queue_cond = mutex->cond_create();
+		prefetch.done_cond = mutex->cond_create();
+		prefetch.closing = false;
+	}
+
+	int max_workers = cap_value(sysinfo->cpucores(), 1, CONFIG_PREFETCH_MAX_WORKERS);
+	if (prefetch.worker_count < max_workers) {
+		struct thread_handle *worker = thread->create(config_prefetch_worker, NULL);
+		if (worker != NULL)
+			prefetch.workers[prefetch.worker_count++] = worker;
+	}
+	if (prefetch.worker_count == 0)
+		return; // no threads, load_file will parse it
+
+	struct config_prefetch_entry *entry = aCalloc(1, sizeof(*entry));
+	safestrncpy(entry->filename, config_filename, sizeof(entry->filename));
+	entry->next = prefetch.list;
+	prefetch.list = entry;
+
+	mutex->lock(prefetch.lock);
+	struct config_prefetch_entry **tail = &prefetch.queue;
+	while (*tail != NULL)
+		tail = &(*tail)->queued;
+	*tail = entry;
+	mutex->cond_signal(prefetch.queue_cond);
+	mutex->unlock(prefetch.lock);
+}
+
+/**
+ * Starts parsing a database file in a worker thread.
+ * @see config_prefetch
+ *
+ * @param filename File name, relative to db_path (e.g. re/item_db.conf)
+ */
+static void config_prefetch_db(const char *filename)
+{
+	char filepath[256];
+
+	nullpo_retv(filename);
+
+	libconfig->format_db_path(filename, filepath, sizeof(filepath));
+	libconfig->prefetch(filepath);
+}
+
+/**
+ * Points all settings of a moved configuration to their new owner.
+ */
+static void config_prefetch_set_owner(struct config_setting_t *setting, struct config_t *config)
+{
+	setting->config = config;
+
+	if (setting->type != CONFIG_TYPE_GROUP && setting->type != CONFIG_TYPE_ARRAY && setting->type != CONFIG_TYPE_LIST)
+		return;
+	if (setting->value.list == NULL)
+		return;
+
+	for (unsigned int i = 0; i < setting->value.list->length; i++)
+		config_prefetch_set_owner(setting->value.list->elements[i], config);
+}
+
+/**
+ * Takes the result of a prefetched configuration file, waiting for its
+ * worker if needed.
+ *
+ * @param config          Where to store the configuration (uninitialized).
+ * @param config_filename The file to read.
+ *
+ * @retval true  if the file was prefetched and parsed, 'config' holds its contents.
+ * @retval false if the file wasn't prefetched or failed to parse.
+ */
+static bool config_prefetch_take(struct config_t *config, const char *config_filename)
+{
+	nullpo_retr(false, config);
+	nullpo_retr(false, config_filename);
+
+	struct config_prefetch_entry **prev = &prefetch.list;
+	while (*prev != NULL && strcmp((*prev)->filename, config_filename) != 0)
+		prev = &(*prev)->next;
+
+	struct config_prefetch_entry *entry = *prev;
+	if (entry == NULL)
+		return false;
+	*prev = entry->next;
+
+	mutex->lock(prefetch.lock);
+	while (!entry->done)
+		mutex->cond_wait(prefetch.done_cond, prefetch.lock, -1);
+	mutex->unlock(prefetch.lock);
+
+	bool loaded = entry->loaded;
+	if (loaded) {
+		memcpy(config, &entry->config, sizeof(*config));
+		config_prefetch_set_owner(config->root, config);
+	} else {
+		config_destroy(&entry->config);
+	}
+	aFree(entry);
+	return loaded;
+}
+
+/**
+ * Stops the worker threads and discards files that were prefetched but never loaded.
+ */
+static void config_prefetch_clear(void)
+{
+	if (prefetch.lock == NULL)
+		return;
+
+	mutex->lock(prefetch.lock);
+	prefetch.closing = true;
+	prefetch.queue = NULL;
+	mutex->cond_broadcast(prefetch.queue_cond);
+	mutex->unlock(prefetch.lock);
+
+	for (int i = 0; i < prefetch.worker_count; i++)
+		thread->wait(prefetch.workers[i], NULL);
+	prefetch.worker_count = 0;
+
+	while (prefetch.list != NULL) {
+		struct config_prefetch_entry *entry = prefetch.list;
+		prefetch.list = entry->next;
+		if (entry->done)
+			config_destroy(&entry->config);
+		aFree(entry);
+	}
+
+	mutex->cond_destroy(prefetch.queue_cond);
+	mutex->cond_destroy(prefetch.done_cond);
+	mutex->destroy(prefetch.lock);
+	prefetch.queue_cond = prefetch.done_cond = NULL;
+	prefetch.lock = NULL;
+}
+
 //
 // Functions to copy settings from libconfig/contrib
 //
@@ -561,6 +784,10 @@ void libconfig_defaults(void) {
 	libconfig->lookup_string = config_lookup_string;
 	/* those are custom and are from src/common/conf.c */
 	libconfig->load_file = config_load_file;
+	libconfig->prefetch = config_prefetch;
+	libconfig->prefetch_db = config_prefetch_db;
+	libconfig->prefetch_take = config_prefetch_take;
+	libconfig->prefetch_clear = config_prefetch_clear;
 	libconfig->setting_copy_simple = config_setting_copy_simple;
 	libconfig->setting_copy_elem = config_setting_copy_elem;
 	libconfig->setting_copy_aggregate = config_setting_copy_aggregate;
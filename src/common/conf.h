@@ -105,6 +105,10 @@ struct libconfig_interface {
 	/* those are custom and are from src/common/conf.c */
 	/* Functions to copy settings from libconfig/contrib */
 	int (*load_file) (struct config_t *config, const char *config_filename);
+	void (*prefetch) (const char *config_filename);
+	void (*prefetch_db) (const char *filename);
+	bool (*prefetch_take) (struct config_t *config, const char *config_filename);
+	void (*prefetch_clear) (void);
 	void (*setting_copy_simple) (struct config_setting_t *parent, const struct config_setting_t *src);
 	void (*setting_copy_elem) (struct config_setting_t *parent, const struct config_setting_t *src);
 	void (*setting_copy_aggregate) (struct config_setting_t *parent, const struct config_setting_t *src);
@@ -31,7 +31,9 @@
 #include "common/mmo.h"
 #include "common/mutex.h"
 #include "common/nullpo.h"
+#include "common/profiler.h"
 #include "common/showmsg.h"
+#include "common/socket.h"
 #include "common/spinlock.h"
 #include "common/sql.h"
 #include "common/strlib.h"
@@ -158,6 +160,98 @@ static CPCMD_C(mem_report, server)
 #endif
 }
 
+/**
+ * Displays socket fifo buffer pool statistics
+ **/
+static CPCMD_C(fifo_report, server)
+{
+	sockt->fifo_report();
+}
+
+/**
+ * Starts the hot path profiler
+ **/
+static CPCMD_C(start, profiler)
+{
+	profiler->start();
+	ShowInfo("Profiler started.\n");
+}
+
+/**
+ * Stops the hot path profiler, keeping its statistics
+ **/
+static CPCMD_C(stop, profiler)
+{
+	profiler->stop();
+	ShowInfo("Profiler stopped.\n");
+}
+
+/**
+ * Clears the hot path profiler statistics
+ **/
+static CPCMD_C(reset, profiler)
+{
+	profiler->reset();
+	ShowInfo("Profiler statistics cleared.\n");
+}
+
+/**
+ * Displays the most expensive profiler zones
+ * Usage: profiler report [timer|socket|sql|script] [count]
+ **/
+static CPCMD_C(report, profiler)
+{
+	enum profiler_category category = PROFILER_CATEGORY_MAX;
+	int count = 20;
+	char *tok;
+
+	for (tok = line != NULL ? strtok(line, " ") : NULL; tok != NULL; tok = strtok(NULL, " ")) {
+		int i;
+
+		if (ISDIGIT(*tok)) {
+			count = max(atoi(tok), 1);
+			continue;
+		}
+		for (i = 0; i < PROFILER_CATEGORY_MAX; i++) {
+			if (strcmpi(tok, profiler->category_name(i)) == 0)
+				break;
+		}
+		if (i == PROFILER_CATEGORY_MAX) {
+			ShowDebug("usage: profiler report [timer|socket|sql|script] [count]\n");
+			return;
+		}
+		category = i;
+	}
+
+	profiler->report(category, count);
+}
+
+/**
+ * Exports the profiler statistics in the Prometheus text format
+ * Usage: profiler export <file> [interval in seconds]
+ *        profiler export off
+ **/
+static CPCMD_C(export, profiler)
+{
+	char filename[256];
+	int interval = 0;
+
+	if (line == NULL || sscanf(line, "%255s %d", filename, &interval) < 1) {
+		ShowDebug("usage: profiler export <file> [interval in seconds] | profiler export off\n");
+		return;
+	}
+
+	if (strcmpi(filename, "off") == 0) {
+		profiler->export_every(NULL, 0);
+		ShowInfo("Periodic profiler export stopped.\n");
+	} else if (interval > 0) {
+		profiler->export_every(filename, interval * 1000);
+		ShowInfo("Exporting profiler statistics to '%s' every %d seconds.\n", filename, interval);
+	} else if (profiler->export_file(filename)) {
+		ShowInfo("Profiler statistics exported to '%s'.\n", filename);
+	}
+}
+
 /**
  * Displays command list
  **/
@@ -249,7 +343,17 @@ static void console_load_defaults(void)
 		CP_DEF_S(ers_report,server),
 		CP_DEF_S(mem_report,server),
 		CP_DEF_S(malloc_usage,server),
+		CP_DEF_S(fifo_report,server),
 		CP_DEF_S(exit,server),
+		/**
+		 * Profiler related commands
+		 **/
+		CP_DEF_C(profiler),
+		CP_DEF_S(start,profiler),
+		CP_DEF_S(stop,profiler),
+		CP_DEF_S(reset,profiler),
+		CP_DEF_S(report,profiler),
+		CP_DEF_S(export,profiler),
 		/**
 		 * Sql related commands
 		 **/
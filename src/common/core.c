@@ -38,6 +38,7 @@
 #include "common/mutex.h"
 #include "common/nullpo.h"
 #include "common/packets.h"
+#include "common/profiler.h"
 #include "common/random.h"
 #include "common/showmsg.h"
 #include "common/socket.h"
@@ -261,6 +262,7 @@ static void core_defaults(void)
 	libconfig_defaults();
 	sql_defaults();
 	timer_defaults();
+	profiler_defaults();
 	db_defaults();
 	socket_defaults();
 	packets_defaults();
@@ -346,6 +348,17 @@ static CMDLINEARG(version)
 	return false;
 }
 
+/**
+ * --profiler handler
+ *
+ * Starts measuring the server's hot paths as soon as it boots.
+ */
+static CMDLINEARG(profiler)
+{
+	profiler->start();
+	return true;
+}
+
 /**
  * Checks if there is a value available for the current argument
  *
@@ -440,6 +453,7 @@ static void cmdline_init(void)
 	CMDLINEARG_DEF(help, 'h', "Displays this help screen", CMDLINE_OPT_NORMAL);
 	CMDLINEARG_DEF(version, 'v', "Displays the server's version.", CMDLINE_OPT_NORMAL);
 	CMDLINEARG_DEF2(load-plugin, loadplugin, "Loads an additional plugin (can be repeated).", CMDLINE_OPT_PARAM|CMDLINE_OPT_PREINIT);
+	CMDLINEARG_DEF2(profiler, profiler, "Enables the hot path profiler at startup.", CMDLINE_OPT_NORMAL);
 	cmdline_args_init_local();
 }
 
@@ -521,6 +535,7 @@ int main(int argc, char **argv)
 #endif
 
 	timer->init();
+	profiler->init();
 
 	/* timer first */
 	rnd->init();
@@ -539,8 +554,11 @@ int main(int argc, char **argv)
 
 	// Main runtime cycle
 	while (core->runflag != CORE_ST_STOP) {
+		uint64 prof = profiler->begin();
 		int next = timer->perform(timer->gettick_nocache());
 		sockt->perform(next);
+		if (prof != 0) // latency of the cycle, without the time spent idle
+			profiler->end(profiler->find_name(PROFILER_CORE, "cycle"), prof + sockt->last_wait);
 	}
 
 	console->final();
@@ -548,6 +566,7 @@ int main(int argc, char **argv)
 	retval = do_final();
 	HPM->final();
 	timer->final();
+	profiler->final();
 	packets->final();
 	sockt->final();
 	DB->final();
@@ -46,6 +46,13 @@ struct PACKET_MAPCHAR_GUILD_EMBLEM {
 } __attribute__((packed));
 DEFINE_PACKET_ID(MAPCHAR_GUILD_EMBLEM, 0x303f)
 
+struct PACKET_MAPCHAR_GUILD_EMBLEM_REQ {
+	int16 packetType;
+	int guild_id;
+	uint64 emblem_hash;
+} __attribute__((packed));
+DEFINE_PACKET_ID(MAPCHAR_GUILD_EMBLEM_REQ, 0x3037)
+
 #if !defined(sun) && (!defined(__NETBSD__) || __NetBSD_Version__ >= 600000000) // NetBSD 5 and Solaris don't like pragma pack but accept the packed attribute
 #pragma pack(pop)
 #endif // not NetBSD < 6 / Solaris
@@ -498,6 +498,22 @@ struct item {
 	struct item_option option[MAX_ITEM_OPTIONS];
 };
 
+/**
+ * Amount of items sent per inter-server storage load page (0x3805 and 0x3818).
+ **/
+#ifndef STORAGE_PAGE_SIZE
+#define STORAGE_PAGE_SIZE 100
+#endif
+
+/**
+ * Flags of the inter-server storage load pages (0x3805 and 0x3818).
+ **/
+enum storage_page_flag {
+	STORAGE_PAGE_OPEN  = 0x1, ///< Open the storage for the requesting character once it has been loaded.
+	STORAGE_PAGE_FIRST = 0x2, ///< First page of the storage.
+	STORAGE_PAGE_LAST  = 0x4, ///< Last page of the storage.
+};
+
 /**
  * Prevents @ref MAX_STORAGE from causing oversized 0x3011 inter-server packets.
  *
@@ -509,7 +525,7 @@ struct item {
  * @anchor MAX_STORAGE_ASSERT
  *
  **/
-STATIC_ASSERT(MAX_STORAGE * sizeof(struct item) + 8 <= 0xFFFF, "The maximum amount of item slots per account storage is limited by the inter-server communication layout. Use a smaller value!");
+STATIC_ASSERT(MAX_STORAGE * (sizeof(struct item) + 2) + 9 <= 0xFFFF, "The maximum amount of item slots per account storage is limited by the inter-server communication layout. Use a smaller value!");
 
 //Equip position constants
 enum equip_pos {
@@ -644,11 +660,26 @@ struct status_change_data {
 	int total_tick;             ///< Total duration.
 };
 
+/// Amount of slots covered by struct storage_changes.
+#define STORAGE_CHANGES_SLOTS (MAX_STORAGE > MAX_GUILD_STORAGE ? MAX_STORAGE : MAX_GUILD_STORAGE)
+
+/**
+ * Per-slot modification tracking of a storage.
+ *
+ * Only the flagged slots are sent to the char-server when the storage is saved.
+ */
+struct storage_changes {
+	bool full;                                        ///< Whether the next save has to rewrite the whole storage.
+	uint32 slots[(STORAGE_CHANGES_SLOTS + 31) / 32];  ///< Bitmask of the modified slots.
+};
+
 struct storage_data {
 	bool save;                     ///< save flag.
 	bool received;                 ///< received flag.
+	bool requested;                ///< Whether the storage has been requested from the char-server and not received yet.
 	int aggregate;                 ///< total item count.
 	VECTOR_DECL(struct item) item; ///< item vector.
+	struct storage_changes changes; ///< Slots modified since the last save.
 };
 
 struct guild_storage {
@@ -656,11 +687,13 @@ struct guild_storage {
 	bool in_use;  ///< Whether storage is in use by other guild members
 	bool dirty;   ///< Whether the struct was modified and needs to be saved
 	bool locked;  ///< Whenever item retrieval is happening and the storage can't be accessed
+	bool loading; ///< Whether the storage pages are being received from the char-server
 	struct {
 		int amount;        ///< Currently stored items (Note: the array is not compacted!)
 		int capacity;      ///< Current size of the data array
 		struct item *data; ///< Data array
 	} items;      ///< Items
+	struct storage_changes changes; ///< Slots modified since the last save
 };
 
 /**
@@ -674,7 +707,7 @@ struct guild_storage {
  * @anchor MAX_GUILD_STORAGE_ASSERT
  *
  **/
-STATIC_ASSERT(20 + sizeof(struct item) * MAX_GUILD_STORAGE <= 0xFFFF, "The maximum amount of item slots per guild storage is limited by the inter-server communication layout. Use a smaller value!");
+STATIC_ASSERT(13 + (sizeof(struct item) + 2) * MAX_GUILD_STORAGE <= 0xFFFF, "The maximum amount of item slots per guild storage is limited by the inter-server communication layout. Use a smaller value!");
 
 struct s_pet {
 	int account_id;
@@ -981,6 +1014,7 @@ struct guild {
 	int emblem_id;                                        ///< Sequential ID of the current emblem
 	int emblem_len;                                       ///< Guild emblem data length
 	char *emblem_data;                                   ///< Guild emblem data
+	uint64 emblem_hash;                                   ///< Content hash of the guild emblem data (0 if there's no emblem)
 	struct guild_alliance alliance[MAX_GUILDALLIANCE];    ///< Guild alliances data
 	struct guild_expulsion expulsion[MAX_GUILDEXPULSION]; ///< Guild expulsion records
 	struct guild_skill skill[MAX_GUILDSKILL];             ///< Guild skills data
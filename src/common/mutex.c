@@ -212,11 +212,18 @@ static void cond_wait(struct cond_data *c, struct mutex_data *m, sysint timeout_
 	if (timeout_ticks < 0) {
 		pthread_cond_wait(&c->hCond,  &m->hMutex);
 	} else {
+		// pthread_cond_timedwait expects an absolute wall clock time, while
+		// timer ticks are monotonic and can't be used as a deadline.
 		struct timespec wtime;
-		int64 exact_timeout = timer->gettick() + timeout_ticks;
-
-		wtime.tv_sec = exact_timeout/1000;
-		wtime.tv_nsec = (exact_timeout%1000)*1000000;
+		struct timeval now;
+
+		gettimeofday(&now, NULL);
+		wtime.tv_sec = now.tv_sec + (time_t)(timeout_ticks/1000);
+		wtime.tv_nsec = now.tv_usec*1000 + (long)(timeout_ticks%1000)*1000000;
+		if (wtime.tv_nsec >= 1000000000) {
+			wtime.tv_sec++;
+			wtime.tv_nsec -= 1000000000;
+		}
 
 		pthread_cond_timedwait( &c->hCond,  &m->hMutex,  &wtime);
 	}
@@ -36,7 +36,7 @@ packetLen(0x300c, 0)
 packetLen(0x300d, 0)
 packetLen(0x300e, 0)
 packetLen(0x300f, 0)
-packetLen(0x3010, 6)
+packetLen(0x3010, 7)
 packetLen(0x3011, -1)
 packetLen(0x3012, 6)
 packetLen(0x3013, -1)
@@ -75,7 +75,7 @@ packetLen(0x3033, -1)
 packetLen(0x3034, 55)
 packetLen(0x3035, 23)
 packetLen(0x3036, 6)
-packetLen(0x3037, 0)
+packetLen(0x3037, 14)
 packetLen(0x3038, 14)
 packetLen(0x3039, -1)
 packetLen(0x303a, -1)
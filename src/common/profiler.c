@@ -0,0 +1,658 @@
+/**
+ * This file is part of Hercules.
+ * http://herc.ws - http://github.com/HerculesWS/Hercules
+ *
+ * Copyright (C) 2012-2024 Hercules Dev Team
+ *
+ * Hercules is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#define HERCULES_CORE
+
+#include "profiler.h"
+
+#include "common/cbasetypes.h"
+#include "common/core.h"
+#include "common/db.h"
+#include "common/memmgr.h"
+#include "common/mutex.h"
+#include "common/nullpo.h"
+#include "common/showmsg.h"
+#include "common/strlib.h"
+#include "common/timer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef WIN32
+#	define PROFILER_TLS __declspec(thread)
+#else
+#	define PROFILER_TLS __thread
+#endif
+
+static struct profiler_interface profiler_s;
+struct profiler_interface *profiler;
+
+/// Statistics collected by a thread, indexed by zone ID.
+struct profiler_thread {
+	struct profiler_thread *next;
+	int size;
+	struct profiler_stats *stats;
+};
+
+/// Protects the zone registry and the thread list.
+static struct mutex_data *profiler_lock = NULL;
+
+static VECTOR_DECL(struct profiler_zone) profiler_zones;
+static struct DBMap *profiler_keys[PROFILER_CATEGORY_MAX];
+static struct DBMap *profiler_names[PROFILER_CATEGORY_MAX];
+static struct profiler_thread *profiler_threads = NULL;
+
+/// Statistics of the calling thread.
+static PROFILER_TLS struct profiler_thread *profiler_local = NULL;
+
+/// Counter units per microsecond, used to pick histogram buckets.
+static uint64 profiler_ticks_per_us = 1;
+
+static char *profiler_export_filename = NULL;
+static int profiler_export_tid = INVALID_TIMER;
+
+/// Temporary record used to sort reports.
+struct profiler_entry {
+	int zone;
+	struct profiler_stats stats;
+};
+
+/// @copydoc profiler_interface::category_name()
+static const char *profiler_category_name(enum profiler_category category)
+{
+	switch (category) {
+	case PROFILER_TIMER:  return "timer";
+	case PROFILER_SOCKET: return "socket";
+	case PROFILER_SQL:    return "sql";
+	case PROFILER_SCRIPT: return "script";
+	case PROFILER_CORE:   return "core";
+	case PROFILER_CATEGORY_MAX: break;
+	}
+	return "unknown";
+}
+
+/// @copydoc profiler_interface::start()
+static void profiler_start(void)
+{
+	profiler->enabled = true;
+}
+
+/// @copydoc profiler_interface::stop()
+static void profiler_stop(void)
+{
+	profiler->enabled = false;
+}
+
+/// @copydoc profiler_interface::reset()
+static void profiler_reset(void)
+{
+	struct profiler_thread *t;
+
+	mutex->lock(profiler_lock);
+	for (t = profiler_threads; t != NULL; t = t->next)
+		memset(t->stats, 0, t->size * sizeof(t->stats[0]));
+	mutex->unlock(profiler_lock);
+}
+
+/// @copydoc profiler_interface::find()
+static int profiler_find(enum profiler_category category, int64 key)
+{
+	int zone;
+
+	Assert_retr(-1, category >= 0 && category < PROFILER_CATEGORY_MAX);
+
+	if (!profiler->enabled)
+		return -1;
+
+	mutex->lock(profiler_lock);
+	zone = i64db_iget(profiler_keys[category], key) - 1;
+	mutex->unlock(profiler_lock);
+
+	return zone;
+}
+
+/**
+ * Appends a zone to the registry. The registry lock must be held.
+ *
+ * @return the new zone ID.
+ */
+static int profiler_register_zone(enum profiler_category category, int64 key, const char *name)
+{
+	struct profiler_zone *z;
+
+	VECTOR_ENSURE(profiler_zones, 1, 64);
+	VECTOR_PUSHZEROED(profiler_zones);
+	z = &VECTOR_LAST(profiler_zones);
+	z->category = category;
+	z->key = key;
+	safestrncpy(z->name, name, sizeof(z->name));
+
+	return VECTOR_LENGTH(profiler_zones) - 1;
+}
+
+/// @copydoc profiler_interface::add()
+static int profiler_add(enum profiler_category category, int64 key, const char *name)
+{
+	int zone;
+
+	Assert_retr(-1, category >= 0 && category < PROFILER_CATEGORY_MAX);
+	nullpo_retr(-1, name);
+
+	mutex->lock(profiler_lock);
+	if ((zone = i64db_iget(profiler_keys[category], key) - 1) < 0) {
+		zone = profiler->register_zone(category, key, name);
+		i64db_iput(profiler_keys[category], key, zone + 1);
+	}
+	mutex->unlock(profiler_lock);
+
+	return zone;
+}
+
+/// @copydoc profiler_interface::find_name()
+static int profiler_find_name(enum profiler_category category, const char *name)
+{
+	char key[PROFILER_NAME_LENGTH];
+	int zone;
+
+	Assert_retr(-1, category >= 0 && category < PROFILER_CATEGORY_MAX);
+	nullpo_retr(-1, name);
+
+	safestrncpy(key, name, sizeof(key));
+
+	mutex->lock(profiler_lock);
+	if ((zone = strdb_iget(profiler_names[category], key) - 1) < 0) {
+		zone = profiler->register_zone(category, 0, key);
+		strdb_iput(profiler_names[category], key, zone + 1);
+	}
+	mutex->unlock(profiler_lock);
+
+	return zone;
+}
+
+/// @copydoc profiler_interface::find_sql()
+static int profiler_find_sql(const char *query)
+{
+	char name[PROFILER_NAME_LENGTH];
+	const char *p;
+	int len = 0;
+
+	nullpo_retr(-1, query);
+
+	if (!profiler->enabled)
+		return -1;
+
+	// Keep the statement up to its first literal, so that queries only
+	// differing by their values share a zone.
+	for (p = query; *p != '\0' && len < (int)sizeof(name) - 1; p++) {
+		if (*p == '\'' || *p == '"')
+			break;
+		if (ISDIGIT(*p) && (p == query || !(ISALNUM(p[-1]) || p[-1] == '_')))
+			break;
+		if (ISSPACE(*p)) {
+			if (len > 0 && name[len - 1] != ' ')
+				name[len++] = ' ';
+			continue;
+		}
+		name[len++] = *p;
+	}
+	while (len > 0 && name[len - 1] == ' ')
+		len--;
+	name[len] = '\0';
+
+	return profiler->find_name(PROFILER_SQL, name);
+}
+
+/// @copydoc profiler_interface::begin()
+static uint64 profiler_begin(void)
+{
+	if (!profiler->enabled)
+		return 0;
+	return timer->perf_counter();
+}
+
+/**
+ * Makes room for a zone in the calling thread's statistics.
+ *
+ * @param zone The zone ID.
+ * @return the calling thread's statistics.
+ */
+static struct profiler_thread *profiler_local_grow(int zone)
+{
+	struct profiler_thread *t = profiler_local;
+	int size;
+
+	mutex->lock(profiler_lock);
+	if (t == NULL) {
+		CREATE(t, struct profiler_thread, 1);
+		t->next = profiler_threads;
+		profiler_threads = t;
+		profiler_local = t;
+	}
+	size = max(zone + 1, VECTOR_LENGTH(profiler_zones));
+	if (size > t->size) {
+		RECREATE(t->stats, struct profiler_stats, size);
+		memset(t->stats + t->size, 0, (size - t->size) * sizeof(t->stats[0]));
+		t->size = size;
+	}
+	mutex->unlock(profiler_lock);
+
+	return t;
+}
+
+/// @copydoc profiler_interface::end()
+static void profiler_end(int zone, uint64 start)
+{
+	struct profiler_thread *t = profiler_local;
+	struct profiler_stats *st;
+	uint64 elapsed, us;
+	int bucket = 0;
+
+	if (start == 0 || zone < 0)
+		return;
+
+	elapsed = timer->perf_counter() - start;
+
+	if (t == NULL || zone >= t->size)
+		t = profiler->local_grow(zone);
+
+	st = &t->stats[zone];
+	st->count++;
+	st->total += elapsed;
+	if (elapsed > st->max)
+		st->max = elapsed;
+
+	for (us = elapsed / profiler_ticks_per_us; us > 0 && bucket < PROFILER_BUCKETS - 1; us >>= 1)
+		bucket++;
+	st->buckets[bucket]++;
+}
+
+/**
+ * Merges the statistics of a zone across all threads. The registry lock must be held.
+ */
+static void profiler_merge(int zone, struct profiler_stats *out)
+{
+	const struct profiler_thread *t;
+	int i;
+
+	memset(out, 0, sizeof(*out));
+	for (t = profiler_threads; t != NULL; t = t->next) {
+		const struct profiler_stats *st;
+
+		if (zone >= t->size)
+			continue;
+		st = &t->stats[zone];
+		out->count += st->count;
+		out->total += st->total;
+		out->max = max(out->max, st->max);
+		for (i = 0; i < PROFILER_BUCKETS; i++)
+			out->buckets[i] += st->buckets[i];
+	}
+}
+
+/// @copydoc profiler_interface::zone_stats()
+static bool profiler_zone_stats(int zone, struct profiler_stats *out)
+{
+	bool found = false;
+
+	nullpo_retr(false, out);
+
+	mutex->lock(profiler_lock);
+	if (zone >= 0 && zone < VECTOR_LENGTH(profiler_zones)) {
+		profiler->merge(zone, out);
+		found = true;
+	}
+	mutex->unlock(profiler_lock);
+
+	return found;
+}
+
+/// qsort comparator, sorts report entries by descending total time.
+static int profiler_entry_cmp(const void *a, const void *b)
+{
+	const struct profiler_entry *ea = a, *eb = b;
+
+	if (ea->stats.total != eb->stats.total)
+		return ea->stats.total < eb->stats.total ? 1 : -1;
+	return ea->zone - eb->zone;
+}
+
+/**
+ * Returns the percentile latency of a histogram, as the upper bound of the
+ * bucket it falls in.
+ *
+ * @return the latency in microseconds, or 0 if it falls in the last bucket.
+ */
+static uint64 profiler_percentile(const struct profiler_stats *st, int percent)
+{
+	uint64 target = (st->count * percent + 99) / 100, seen = 0;
+	int i;
+
+	for (i = 0; i < PROFILER_BUCKETS - 1; i++) {
+		seen += st->buckets[i];
+		if (seen >= target)
+			return UINT64_C(1) << i;
+	}
+	return 0;
+}
+
+/// @copydoc profiler_interface::report()
+static void profiler_report(enum profiler_category category, int count)
+{
+	struct profiler_entry *entries;
+	uint64 frequency = timer->perf_frequency();
+	uint64 totals[PROFILER_CATEGORY_MAX] = { 0 };
+	int i, length = 0;
+
+	mutex->lock(profiler_lock);
+	entries = aMalloc(max(VECTOR_LENGTH(profiler_zones), 1) * sizeof(*entries));
+	for (i = 0; i < VECTOR_LENGTH(profiler_zones); i++) {
+		const struct profiler_zone *z = &VECTOR_INDEX(profiler_zones, i);
+
+		profiler->merge(i, &entries[length].stats);
+		if (entries[length].stats.count == 0)
+			continue;
+		totals[z->category] += entries[length].stats.total;
+		if (category != PROFILER_CATEGORY_MAX && z->category != category)
+			continue;
+		entries[length].zone = i;
+		length++;
+	}
+	mutex->unlock(profiler_lock);
+
+	qsort(entries, length, sizeof(*entries), profiler->entry_cmp);
+
+	ShowInfo("Profiler is %s. Time per category:", profiler->enabled ? "running" : "stopped");
+	for (i = 0; i < PROFILER_CATEGORY_MAX; i++)
+		ShowMessage(" %s %.1fms", profiler->category_name(i), (double)totals[i] * 1000 / frequency);
+	ShowMessage("\n");
+
+	if (length == 0) {
+		ShowInfo("No zone has been measured yet.\n");
+		aFree(entries);
+		return;
+	}
+
+	ShowInfo("%-6s %-48s %10s %12s %10s %10s %10s\n", "Type", "Zone", "Count", "Total (ms)", "Avg (us)", "p99 (us)", "Max (us)");
+	for (i = 0; i < length && i < count; i++) {
+		const struct profiler_stats *st = &entries[i].stats;
+		const struct profiler_zone *z = &VECTOR_INDEX(profiler_zones, entries[i].zone);
+		uint64 p99 = profiler->percentile(st, 99);
+		char p99_str[24];
+
+		if (p99 != 0)
+			snprintf(p99_str, sizeof(p99_str), "<%"PRIu64, p99);
+		else
+			safestrncpy(p99_str, "-", sizeof(p99_str));
+
+		ShowInfo("%-6s %-48.48s %10"PRIu64" %12.2f %10.1f %10s %10.1f\n",
+		         profiler->category_name(z->category), z->name, st->count,
+		         (double)st->total * 1000 / frequency,
+		         (double)st->total * 1000000 / frequency / st->count,
+		         p99_str,
+		         (double)st->max * 1000000 / frequency);
+	}
+	aFree(entries);
+}
+
+/**
+ * Appends a Prometheus label value, escaping it as required by the format.
+ */
+static void profiler_prometheus_label(struct StringBuf *buf, const char *value)
+{
+	const char *p;
+
+	for (p = value; *p != '\0'; p++) {
+		switch (*p) {
+		case '\\': StrBuf->AppendStr(buf, "\\\\"); break;
+		case '"':  StrBuf->AppendStr(buf, "\\\""); break;
+		case '\n': StrBuf->AppendStr(buf, "\\n"); break;
+		default:   StrBuf->Printf(buf, "%c", *p); break;
+		}
+	}
+}
+
+/**
+ * Appends the label set of a zone, without the closing brace.
+ */
+static void profiler_prometheus_labels(struct StringBuf *buf, const char *server, const struct profiler_zone *z)
+{
+	StrBuf->Printf(buf, "{server=\"%s\",category=\"%s\",zone=\"", server, profiler->category_name(z->category));
+	profiler->prometheus_label(buf, z->name);
+	StrBuf->AppendStr(buf, "\"");
+}
+
+/// @copydoc profiler_interface::prometheus()
+static void profiler_prometheus(struct StringBuf *buf)
+{
+	const char *server;
+	double frequency = (double)timer->perf_frequency();
+	int i, j;
+
+	nullpo_retv(buf);
+
+	switch (SERVER_TYPE) {
+	case SERVER_TYPE_LOGIN: server = "login"; break;
+	case SERVER_TYPE_CHAR:  server = "char"; break;
+	case SERVER_TYPE_MAP:   server = "map"; break;
+	case SERVER_TYPE_API:   server = "api"; break;
+	case SERVER_TYPE_UNKNOWN:
+	default:                server = "unknown"; break;
+	}
+
+	StrBuf->AppendStr(buf, "# HELP hercules_profiler_enabled Whether the profiler is measuring zones.\n");
+	StrBuf->AppendStr(buf, "# TYPE hercules_profiler_enabled gauge\n");
+	StrBuf->Printf(buf, "hercules_profiler_enabled{server=\"%s\"} %d\n", server, profiler->enabled ? 1 : 0);
+
+	mutex->lock(profiler_lock);
+	StrBuf->AppendStr(buf, "# HELP hercules_profiler_zone_seconds Time spent in instrumented zones.\n");
+	StrBuf->AppendStr(buf, "# TYPE hercules_profiler_zone_seconds histogram\n");
+	for (i = 0; i < VECTOR_LENGTH(profiler_zones); i++) {
+		const struct profiler_zone *z = &VECTOR_INDEX(profiler_zones, i);
+		struct profiler_stats st;
+		uint64 cumulative = 0;
+
+		profiler->merge(i, &st);
+		if (st.count == 0)
+			continue;
+
+		for (j = 0; j < PROFILER_BUCKETS - 1; j++) {
+			cumulative += st.buckets[j];
+			StrBuf->AppendStr(buf, "hercules_profiler_zone_seconds_bucket");
+			profiler->prometheus_labels(buf, server, z);
+			StrBuf->Printf(buf, ",le=\"%g\"} %"PRIu64"\n", (double)(UINT64_C(1) << j) / 1000000, cumulative);
+		}
+		StrBuf->AppendStr(buf, "hercules_profiler_zone_seconds_bucket");
+		profiler->prometheus_labels(buf, server, z);
+		StrBuf->Printf(buf, ",le=\"+Inf\"} %"PRIu64"\n", st.count);
+
+		StrBuf->AppendStr(buf, "hercules_profiler_zone_seconds_sum");
+		profiler->prometheus_labels(buf, server, z);
+		StrBuf->Printf(buf, "} %.9f\n", (double)st.total / frequency);
+
+		StrBuf->AppendStr(buf, "hercules_profiler_zone_seconds_count");
+		profiler->prometheus_labels(buf, server, z);
+		StrBuf->Printf(buf, "} %"PRIu64"\n", st.count);
+	}
+
+	StrBuf->AppendStr(buf, "# HELP hercules_profiler_zone_max_seconds Longest time spent in an instrumented zone.\n");
+	StrBuf->AppendStr(buf, "# TYPE hercules_profiler_zone_max_seconds gauge\n");
+	for (i = 0; i < VECTOR_LENGTH(profiler_zones); i++) {
+		struct profiler_stats st;
+
+		profiler->merge(i, &st);
+		if (st.count == 0)
+			continue;
+
+		StrBuf->AppendStr(buf, "hercules_profiler_zone_max_seconds");
+		profiler->prometheus_labels(buf, server, &VECTOR_INDEX(profiler_zones, i));
+		StrBuf->Printf(buf, "} %.9f\n", (double)st.max / frequency);
+	}
+	mutex->unlock(profiler_lock);
+}
+
+/// @copydoc profiler_interface::export_file()
+static bool profiler_export_file(const char *filename)
+{
+	char tmpname[1024];
+	StringBuf buf;
+	FILE *fp;
+	bool ok;
+
+	nullpo_retr(false, filename);
+
+	snprintf(tmpname, sizeof(tmpname), "%s.tmp", filename);
+	if ((fp = fopen(tmpname, "w")) == NULL) {
+		ShowError("profiler_export_file: Unable to open '%s' for writing.\n", tmpname);
+		return false;
+	}
+
+	StrBuf->Init(&buf);
+	profiler->prometheus(&buf);
+	ok = fwrite(StrBuf->Value(&buf), 1, StrBuf->Length(&buf), fp) == (size_t)StrBuf->Length(&buf);
+	StrBuf->Destroy(&buf);
+
+	if (fclose(fp) != 0 || !ok) {
+		ShowError("profiler_export_file: Unable to write '%s'.\n", tmpname);
+		remove(tmpname);
+		return false;
+	}
+
+#ifdef WIN32
+	remove(filename); // rename() doesn't replace existing files
+#endif
+	if (rename(tmpname, filename) != 0) {
+		ShowError("profiler_export_file: Unable to rename '%s' to '%s'.\n", tmpname, filename);
+		remove(tmpname);
+		return false;
+	}
+	return true;
+}
+
+/// @copydoc profiler_interface::export_timer()
+static int profiler_export_timer(int tid, int64 tick, int id, intptr_t data)
+{
+	if (profiler_export_filename != NULL)
+		profiler->export_file(profiler_export_filename);
+	return 0;
+}
+
+/// @copydoc profiler_interface::export_every()
+static void profiler_export_every(const char *filename, int interval)
+{
+	if (profiler_export_tid != INVALID_TIMER) {
+		timer->delete(profiler_export_tid, profiler->export_timer);
+		profiler_export_tid = INVALID_TIMER;
+	}
+	if (profiler_export_filename != NULL) {
+		aFree(profiler_export_filename);
+		profiler_export_filename = NULL;
+	}
+
+	if (filename == NULL)
+		return;
+
+	Assert_retv(interval > 0);
+
+	profiler_export_filename = aStrdup(filename);
+	profiler_export_tid = timer->add_interval(timer->gettick() + interval, profiler->export_timer, 0, 0, interval);
+}
+
+/// @copydoc profiler_interface::init()
+static void profiler_init(void)
+{
+	int i;
+
+	profiler_lock = mutex->create();
+	VECTOR_INIT(profiler_zones);
+	for (i = 0; i < PROFILER_CATEGORY_MAX; i++) {
+		profiler_keys[i] = i64db_alloc(DB_OPT_BASE);
+		profiler_names[i] = strdb_alloc(DB_OPT_DUP_KEY, PROFILER_NAME_LENGTH);
+	}
+
+	profiler_ticks_per_us = max(timer->perf_frequency() / 1000000, 1);
+
+	timer->add_func_list(profiler->export_timer, "profiler_export_timer");
+}
+
+/// @copydoc profiler_interface::final()
+static void profiler_final(void)
+{
+	struct profiler_thread *t;
+	int i;
+
+	profiler->enabled = false;
+
+	if (profiler_export_filename != NULL) {
+		aFree(profiler_export_filename);
+		profiler_export_filename = NULL;
+	}
+	profiler_export_tid = INVALID_TIMER;
+
+	while ((t = profiler_threads) != NULL) {
+		profiler_threads = t->next;
+		if (t->stats != NULL)
+			aFree(t->stats);
+		aFree(t);
+	}
+	profiler_local = NULL;
+
+	for (i = 0; i < PROFILER_CATEGORY_MAX; i++) {
+		db_destroy(profiler_keys[i]);
+		db_destroy(profiler_names[i]);
+	}
+	VECTOR_CLEAR(profiler_zones);
+
+	mutex->destroy(profiler_lock);
+	profiler_lock = NULL;
+}
+
+/// Interface base initialization.
+void profiler_defaults(void)
+{
+	profiler = &profiler_s;
+	profiler->enabled = false;
+
+	profiler->init = profiler_init;
+	profiler->final = profiler_final;
+	profiler->start = profiler_start;
+	profiler->stop = profiler_stop;
+	profiler->reset = profiler_reset;
+	profiler->find = profiler_find;
+	profiler->add = profiler_add;
+	profiler->find_name = profiler_find_name;
+	profiler->find_sql = profiler_find_sql;
+	profiler->begin = profiler_begin;
+	profiler->end = profiler_end;
+	profiler->zone_stats = profiler_zone_stats;
+	profiler->report = profiler_report;
+	profiler->prometheus = profiler_prometheus;
+	profiler->export_file = profiler_export_file;
+	profiler->export_every = profiler_export_every;
+	profiler->export_timer = profiler_export_timer;
+	profiler->category_name = profiler_category_name;
+
+	profiler->register_zone = profiler_register_zone;
+	profiler->local_grow = profiler_local_grow;
+	profiler->merge = profiler_merge;
+	profiler->entry_cmp = profiler_entry_cmp;
+	profiler->percentile = profiler_percentile;
+	profiler->prometheus_label = profiler_prometheus_label;
+	profiler->prometheus_labels = profiler_prometheus_labels;
+}
@@ -0,0 +1,214 @@
+/**
+ * This file is part of Hercules.
+ * http://herc.ws - http://github.com/HerculesWS/Hercules
+ *
+ * Copyright (C) 2012-2024 Hercules Dev Team
+ *
+ * Hercules is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/hercules.h"
+
+/** @file
+ * Low overhead instrumentation of the server's hot paths.
+ *
+ * Timer callbacks, session parse functions, SQL queries, script commands and
+ * server cycles are measured in zones, using the timer's high resolution counter.
+ * Each thread accumulates its own statistics, which are merged on report.
+ */
+
+struct StringBuf;
+struct profiler_thread;
+
+/// Length of a zone name, including the terminating NUL.
+#define PROFILER_NAME_LENGTH 64
+
+/**
+ * Amount of latency histogram buckets.
+ *
+ * Bucket 0 counts zones shorter than 1us, bucket N zones shorter than 2^N us,
+ * the last bucket counts everything else.
+ */
+#define PROFILER_BUCKETS 22
+
+/// Kind of instrumented code.
+enum profiler_category {
+	PROFILER_TIMER,  ///< Timer callbacks, by function.
+	PROFILER_SOCKET, ///< Session parse functions, by the ID of the first pending packet.
+	PROFILER_SQL,    ///< SQL queries, by query text up to the first literal.
+	PROFILER_SCRIPT, ///< Script commands, by command.
+	PROFILER_CORE,   ///< Server cycles, excluding the time spent waiting for socket events.
+	PROFILER_CATEGORY_MAX
+};
+
+/// An instrumented zone.
+struct profiler_zone {
+	enum profiler_category category;
+	int64 key;
+	char name[PROFILER_NAME_LENGTH];
+};
+
+/// Statistics of a zone.
+struct profiler_stats {
+	uint64 count;                     ///< Amount of times the zone was entered.
+	uint64 total;                     ///< Total time spent in the zone, in counter units.
+	uint64 max;                       ///< Longest time spent in the zone, in counter units.
+	uint64 buckets[PROFILER_BUCKETS]; ///< Latency histogram.
+};
+
+/// The profiler interface.
+struct profiler_interface {
+	/// Whether zones are currently being measured.
+	bool enabled;
+
+	void (*init) (void);
+	void (*final) (void);
+
+	/**
+	 * Starts measuring zones.
+	 */
+	void (*start) (void);
+
+	/**
+	 * Stops measuring zones. The collected statistics are kept.
+	 */
+	void (*stop) (void);
+
+	/**
+	 * Clears the statistics of every thread.
+	 */
+	void (*reset) (void);
+
+	/**
+	 * Looks up a zone by key.
+	 *
+	 * @param category The zone category.
+	 * @param key      The zone key (function address, packet ID...).
+	 * @return the zone ID, or -1 if it is not registered yet or the profiler is stopped.
+	 */
+	int (*find) (enum profiler_category category, int64 key);
+
+	/**
+	 * Registers a zone, if it doesn't exist yet.
+	 *
+	 * @param category The zone category.
+	 * @param key      The zone key.
+	 * @param name     The name shown in reports.
+	 * @return the zone ID.
+	 */
+	int (*add) (enum profiler_category category, int64 key, const char *name);
+
+	/**
+	 * Looks up a zone by name, registering it if it doesn't exist yet.
+	 *
+	 * @param category The zone category.
+	 * @param name     The zone name.
+	 * @return the zone ID.
+	 */
+	int (*find_name) (enum profiler_category category, const char *name);
+
+	/**
+	 * Looks up the zone of a SQL query, registering it if it doesn't exist yet.
+	 *
+	 * Queries are grouped by their text up to the first literal value.
+	 *
+	 * @param query The query.
+	 * @return the zone ID, or -1 if the profiler is stopped.
+	 */
+	int (*find_sql) (const char *query);
+
+	/**
+	 * Enters a zone.
+	 *
+	 * @return the current counter value, or 0 when the profiler is disabled.
+	 */
+	uint64 (*begin) (void);
+
+	/**
+	 * Leaves a zone, accounting the time spent in it to the calling thread.
+	 *
+	 * @param zone  The zone ID.
+	 * @param start The value returned by begin().
+	 */
+	void (*end) (int zone, uint64 start);
+
+	/**
+	 * Merges the statistics of a zone across all threads.
+	 *
+	 * @param zone The zone ID.
+	 * @param[out] out The merged statistics.
+	 * @return false if the zone doesn't exist.
+	 */
+	bool (*zone_stats) (int zone, struct profiler_stats *out);
+
+	/**
+	 * Shows the zones with the highest total time on the console.
+	 *
+	 * @param category The category to show, or PROFILER_CATEGORY_MAX for all of them.
+	 * @param count    The maximum amount of zones to show.
+	 */
+	void (*report) (enum profiler_category category, int count);
+
+	/**
+	 * Writes the statistics in the Prometheus text exposition format.
+	 *
+	 * @param buf The buffer to append to.
+	 */
+	void (*prometheus) (struct StringBuf *buf);
+
+	/**
+	 * Writes the statistics in the Prometheus text exposition format to a file.
+	 *
+	 * The file is written to a temporary file first and renamed, so that
+	 * collectors never read a partial file.
+	 *
+	 * @param filename The file to write.
+	 * @return success status.
+	 */
+	bool (*export_file) (const char *filename);
+
+	/**
+	 * Periodically exports the statistics to a file.
+	 *
+	 * @param filename The file to write, or NULL to stop exporting.
+	 * @param interval The export interval, in milliseconds.
+	 */
+	void (*export_every) (const char *filename, int interval);
+
+	int (*export_timer) (int tid, int64 tick, int id, intptr_t data);
+
+	/**
+	 * Returns the name of a category, as used in reports.
+	 */
+	const char *(*category_name) (enum profiler_category category);
+
+	/* private */
+	int (*register_zone) (enum profiler_category category, int64 key, const char *name);
+	struct profiler_thread *(*local_grow) (int zone);
+	void (*merge) (int zone, struct profiler_stats *out);
+	int (*entry_cmp) (const void *a, const void *b);
+	uint64 (*percentile) (const struct profiler_stats *st, int percent);
+	void (*prometheus_label) (struct StringBuf *buf, const char *value);
+	void (*prometheus_labels) (struct StringBuf *buf, const char *server, const struct profiler_zone *z);
+};
+
+#ifdef HERCULES_CORE
+void profiler_defaults(void);
+#endif // HERCULES_CORE
+
+HPShared struct profiler_interface *profiler; ///< Pointer to the profiler interface.
+
+#endif /* COMMON_PROFILER_H */
@@ -30,6 +30,7 @@
 #include "common/memmgr.h"
 #include "common/mmo.h"
 #include "common/nullpo.h"
+#include "common/profiler.h"
 #include "common/packets.h"
 #include "common/showmsg.h"
 #include "common/strlib.h"
@@ -300,6 +301,32 @@ static time_t socket_data_last_tick = 0;
 // The connection is closed if it goes over the limit.
 #define WFIFO_MAX (1*1024*1024)
 
+// smallest pooled fifo buffer, each size class doubles the previous one
+#define FIFO_POOL_MIN_SIZE (2*1024)
+// number of fifo buffer size classes (2 KB .. 2 MB), bigger buffers are not pooled
+#define FIFO_POOL_CLASSES 11
+// maximum amount of memory kept in the free list of each size class
+#define FIFO_POOL_CACHE_BYTES (4*1024*1024)
+// seconds without sending after which an empty write fifo is shrunk back to its nominal size
+#define FIFO_IDLE_SHRINK_TIME 30
+// interval of the idle fifo check (ms)
+#define FIFO_IDLE_CHECK_INTERVAL (10*1000)
+
+/// Released fifo buffer, linked through its own memory
+struct fifo_pool_entry {
+	struct fifo_pool_entry *next;
+};
+
+/// Free list and occupancy of a fifo buffer size class
+static struct fifo_pool_class {
+	struct fifo_pool_entry *free; ///< cached buffers
+	int cached;                   ///< buffers in the free list
+	int in_use;                   ///< buffers held by sessions
+	int peak;                     ///< highest in_use
+	uint64 allocs;                ///< buffers obtained from the allocator
+	uint64 reuses;                ///< requests served from the free list
+} fifo_pool[FIFO_POOL_CLASSES + 1]; // last entry accounts the unpooled buffers
+
 #ifdef SEND_SHORTLIST
 static int send_shortlist_array[MAXCONN]; // we only support MAXCONN sockets, limit the array to that
 static int send_shortlist_count = 0;// how many fd's are in the shortlist
@@ -752,11 +779,13 @@ static int make_connection(uint32 ip, uint16 port, struct hSockOpt *opt)
 
 static int create_session(int fd, RecvFunc func_recv, SendFunc func_send, ParseFunc func_parse, ConnectedFunc func_client_connected, DeleteFunc func_delete)
 {
+	size_t rsize = RFIFO_SIZE, wsize = WFIFO_SIZE;
+
 	CREATE(sockt->session[fd], struct socket_data, 1);
-	CREATE(sockt->session[fd]->rdata, unsigned char, RFIFO_SIZE);
-	CREATE(sockt->session[fd]->wdata, unsigned char, WFIFO_SIZE);
-	sockt->session[fd]->max_rdata  = RFIFO_SIZE;
-	sockt->session[fd]->max_wdata  = WFIFO_SIZE;
+	sockt->session[fd]->rdata = sockt->fifo_alloc(&rsize);
+	sockt->session[fd]->wdata = sockt->fifo_alloc(&wsize);
+	sockt->session[fd]->max_rdata  = rsize;
+	sockt->session[fd]->max_wdata  = wsize;
 	sockt->session[fd]->func_recv  = func_recv;
 	sockt->session[fd]->func_send  = func_send;
 	sockt->session[fd]->func_parse = func_parse;
@@ -777,8 +806,8 @@ static void delete_session(int fd)
 		socket_data_qo -= sockt->session[fd]->wdata_size;
 #endif  // SHOW_SERVER_STATS
 		sockt->session[fd]->func_delete(fd);
-		aFree(sockt->session[fd]->rdata);
-		aFree(sockt->session[fd]->wdata);
+		sockt->fifo_free(sockt->session[fd]->rdata, sockt->session[fd]->max_rdata);
+		sockt->fifo_free(sockt->session[fd]->wdata, sockt->session[fd]->max_wdata);
 		if( sockt->session[fd]->session_data )
 			aFree(sockt->session[fd]->session_data);
 		HPM->data_store_destroy(&sockt->session[fd]->hdata);
@@ -793,13 +822,15 @@ static int realloc_fifo(int fd, unsigned int rfifo_size, unsigned int wfifo_size
 		return 0;
 
 	if( sockt->session[fd]->max_rdata != rfifo_size && sockt->session[fd]->rdata_size < rfifo_size) {
-		RECREATE(sockt->session[fd]->rdata, unsigned char, rfifo_size);
-		sockt->session[fd]->max_rdata  = rfifo_size;
+		size_t size = rfifo_size;
+		sockt->session[fd]->rdata = sockt->fifo_realloc(sockt->session[fd]->rdata, sockt->session[fd]->max_rdata, sockt->session[fd]->rdata_size, &size);
+		sockt->session[fd]->max_rdata  = size;
 	}
 
 	if( sockt->session[fd]->max_wdata != wfifo_size && sockt->session[fd]->wdata_size < wfifo_size) {
-		RECREATE(sockt->session[fd]->wdata, unsigned char, wfifo_size);
-		sockt->session[fd]->max_wdata  = wfifo_size;
+		size_t size = wfifo_size;
+		sockt->session[fd]->wdata = sockt->fifo_realloc(sockt->session[fd]->wdata, sockt->session[fd]->max_wdata, sockt->session[fd]->wdata_size, &size);
+		sockt->session[fd]->max_wdata  = size;
 	}
 	return 0;
 }
@@ -825,12 +856,210 @@ static int realloc_writefifo(int fd, size_t addition)
 		return 0;
 	}
 
-	RECREATE(sockt->session[fd]->wdata, unsigned char, newsize);
+	sockt->session[fd]->wdata = sockt->fifo_realloc(sockt->session[fd]->wdata, sockt->session[fd]->max_wdata, sockt->session[fd]->wdata_size, &newsize);
 	sockt->session[fd]->max_wdata  = newsize;
 
 	return 0;
 }
 
+/**
+ * Gets the pool size class of a fifo buffer.
+ *
+ * @param size Requested buffer size.
+ * @return the smallest class that fits size, or FIFO_POOL_CLASSES if the buffer is not pooled.
+ */
+static int fifo_class(size_t size)
+{
+	int c = 0;
+
+	while (c < FIFO_POOL_CLASSES && ((size_t)FIFO_POOL_MIN_SIZE << c) < size)
+		c++;
+	return c;
+}
+
+/**
+ * Allocates a fifo buffer from the pool.
+ *
+ * Each size class keeps a free list of separately allocated buffers.
+ * The buffer is zeroed, whether it is new or reused.
+ *
+ * @param[in,out] size Requested size, set to the actual size of the buffer (the size class).
+ * @return the buffer, to be released with sockt->fifo_free.
+ */
+static uint8 *fifo_alloc(size_t *size)
+{
+	struct fifo_pool_class *pc;
+	uint8 *buf;
+	int c;
+
+	nullpo_retr(NULL, size);
+	c = sockt->fifo_class(*size);
+	pc = &fifo_pool[c];
+
+	if (c < FIFO_POOL_CLASSES)
+		*size = (size_t)FIFO_POOL_MIN_SIZE << c;
+
+	if (pc->free != NULL) {
+		buf = (uint8 *)pc->free;
+		pc->free = pc->free->next;
+		pc->cached--;
+		pc->reuses++;
+		memset(buf, 0, *size); // don't leak the data of the previous owner
+	} else {
+		buf = aCalloc(1, *size);
+		pc->allocs++;
+	}
+
+	if (++pc->in_use > pc->peak)
+		pc->peak = pc->in_use;
+	return buf;
+}
+
+/**
+ * Releases a fifo buffer to the pool.
+ *
+ * The buffer is kept for reuse unless its size class already caches
+ * FIFO_POOL_CACHE_BYTES worth of buffers.
+ *
+ * @param buf  Buffer obtained from sockt->fifo_alloc.
+ * @param size Size of the buffer.
+ */
+static void fifo_free(uint8 *buf, size_t size)
+{
+	struct fifo_pool_class *pc;
+	int c;
+
+	if (buf == NULL)
+		return;
+
+	c = sockt->fifo_class(size);
+	pc = &fifo_pool[c];
+	pc->in_use--;
+
+	if (c == FIFO_POOL_CLASSES || (size_t)(pc->cached + 1) * size > FIFO_POOL_CACHE_BYTES) {
+		aFree(buf);
+		return;
+	}
+
+	struct fifo_pool_entry *entry = (struct fifo_pool_entry *)buf;
+	entry->next = pc->free;
+	pc->free = entry;
+	pc->cached++;
+}
+
+/**
+ * Moves the contents of a fifo buffer to a buffer of another size.
+ *
+ * @param buf      Current buffer.
+ * @param old_size Size of the current buffer.
+ * @param used     Bytes of the current buffer to keep.
+ * @param[in,out] new_size Requested size, set to the actual size of the new buffer.
+ * @return the new buffer.
+ */
+static uint8 *fifo_realloc(uint8 *buf, size_t old_size, size_t used, size_t *new_size)
+{
+	uint8 *newbuf;
+
+	nullpo_retr(buf, new_size);
+	if (sockt->fifo_class(*new_size) == sockt->fifo_class(old_size) && old_size >= *new_size) {
+		*new_size = old_size; // same size class
+		return buf;
+	}
+
+	newbuf = sockt->fifo_alloc(new_size);
+	if (used > 0)
+		memcpy(newbuf, buf, min(used, *new_size));
+	sockt->fifo_free(buf, old_size);
+	return newbuf;
+}
+
+/**
+ * Returns idle memory held by the fifo buffers.
+ *
+ * Empty write fifos that haven't sent anything for FIFO_IDLE_SHRINK_TIME
+ * seconds are shrunk back to their nominal size, and half of the buffers
+ * cached by each size class are released, so that resident memory follows
+ * actual traffic rather than past bursts.
+ */
+static void fifo_trim(void)
+{
+	int i;
+
+	for (i = 1; i < sockt->fd_max; i++) {
+		struct socket_data *s = sockt->session[i];
+		size_t nominal;
+
+		if (s == NULL || s->wdata_size != 0)
+			continue;
+
+		nominal = s->flag.server ? FIFOSIZE_SERVERLINK : WFIFO_SIZE;
+		if (s->max_wdata <= nominal || sockt->last_tick - s->wdata_tick < FIFO_IDLE_SHRINK_TIME)
+			continue;
+
+		s->wdata = sockt->fifo_realloc(s->wdata, s->max_wdata, 0, &nominal);
+		s->max_wdata = nominal;
+	}
+
+	for (i = 0; i < FIFO_POOL_CLASSES; i++) {
+		struct fifo_pool_class *pc = &fifo_pool[i];
+		int release = (pc->cached + 1) / 2;
+
+		while (release-- > 0) {
+			struct fifo_pool_entry *entry = pc->free;
+			pc->free = entry->next;
+			pc->cached--;
+			aFree(entry);
+		}
+	}
+}
+
+/**
+ * Releases every cached fifo buffer.
+ */
+static void fifo_pool_final(void)
+{
+	int i;
+
+	for (i = 0; i < FIFO_POOL_CLASSES; i++) {
+		struct fifo_pool_class *pc = &fifo_pool[i];
+
+		while (pc->free != NULL) {
+			struct fifo_pool_entry *entry = pc->free;
+			pc->free = entry->next;
+			aFree(entry);
+		}
+		pc->cached = 0;
+	}
+}
+
+/**
+ * Displays the occupancy of each fifo buffer size class.
+ */
+static void fifo_report(void)
+{
+	size_t total = 0;
+	int i;
+
+	ShowInfo("Socket fifo buffers:\n");
+	for (i = 0; i <= FIFO_POOL_CLASSES; i++) {
+		const struct fifo_pool_class *pc = &fifo_pool[i];
+
+		if (pc->allocs == 0)
+			continue;
+
+		if (i == FIFO_POOL_CLASSES) {
+			ShowMessage("   unpooled: %5d in use (peak %5d), %"PRIu64" allocations\n", pc->in_use, pc->peak, pc->allocs);
+			continue;
+		}
+
+		size_t size = (size_t)FIFO_POOL_MIN_SIZE << i;
+		total += size * (pc->in_use + pc->cached);
+		ShowMessage("   %5"PRIuS" KB: %5d in use (peak %5d), %4d cached, %"PRIu64" allocations, %"PRIu64" reuses\n",
+		            size / 1024, pc->in_use, pc->peak, pc->cached, pc->allocs, pc->reuses);
+	}
+	ShowInfo("Pooled fifo memory: %.2f MB\n", (double)total / (1024 * 1024));
+}
+
 /// advance the RFIFO cursor (marking 'len' bytes as processed)
 static int rfifoskip(int fd, size_t len)
 {
@@ -968,7 +1197,8 @@ static int do_sockets(int next)
 	fd_set rfd;
 	struct timeval timeout;
 #endif  // SOCKET_EPOLL
-	int ret,i;
+	int ret,i,n,first;
+	uint64 wait_start = 0;
 
 	// PRESEND Timers are executed before do_sendrecv and can send packets and/or set sessions to eof.
 	// Send remaining data and process client-side disconnects here.
@@ -984,6 +1214,11 @@ static int do_sockets(int next)
 	}
 #endif  // SEND_SHORTLIST
 
+	if (sockt->parse_next > 0)
+		next = 0; // sessions were left unparsed, don't wait for new events
+	if (profiler->enabled)
+		wait_start = timer->perf_counter();
+
 #ifndef SOCKET_EPOLL
 	// Select based Event Dispatcher:
 
@@ -1018,6 +1253,7 @@ static int do_sockets(int next)
 	}
 #endif  // SOCKET_EPOLL
 
+	sockt->last_wait = wait_start != 0 ? timer->perf_counter() - wait_start : 0;
 	sockt->last_tick = time(NULL);
 
 #if defined(WIN32)
@@ -1085,9 +1321,23 @@ static int do_sockets(int next)
 	}
 #endif  // SEND_SHORTLIST
 
-	// parse input data on each socket
-	for(i = 1; i < sockt->fd_max; i++)
+	// parse input data on each socket, starting where the previous cycle ran out of budget
+	timer->budget_start();
+	first = sockt->parse_next;
+	sockt->parse_next = 0;
+	if (first < 1 || first >= sockt->fd_max)
+		first = 1;
+	for (n = 1; n < sockt->fd_max; n++)
 	{
+		i = first + n - 1;
+		if (i >= sockt->fd_max)
+			i -= sockt->fd_max - 1;
+
+		if (n > 1 && timer->budget_exceeded()) {
+			sockt->parse_next = i;
+			break;
+		}
+
 		if(!sockt->session[i])
 			continue;
 
@@ -1101,7 +1351,24 @@ static int do_sockets(int next)
 			}
 		}
 
-		sockt->session[i]->func_parse(i);
+		if (profiler->enabled && RFIFOREST(i) >= 2) {
+			int packet_id = RFIFOW(i, 0);
+			uint64 prof = profiler->begin();
+
+			sockt->session[i]->func_parse(i);
+
+			if (prof != 0) {
+				int zone = profiler->find(PROFILER_SOCKET, packet_id);
+				if (zone < 0) {
+					char name[8];
+					snprintf(name, sizeof(name), "0x%04x", (unsigned int)packet_id);
+					zone = profiler->add(PROFILER_SOCKET, packet_id, name);
+				}
+				profiler->end(zone, prof);
+			}
+		} else {
+			sockt->session[i]->func_parse(i);
+		}
 
 		if(!sockt->session[i])
 			continue;
@@ -1273,6 +1540,14 @@ static int connect_check_(uint32 ip)
 	return connect_ok;
 }
 
+/// Timer function.
+/// Shrinks idle fifos and releases cached fifo buffers.
+static int fifo_idle_check(int tid, int64 tick, int id, intptr_t data)
+{
+	sockt->fifo_trim();
+	return 0;
+}
+
 /// Timer function.
 /// Deletes old connection history records.
 static int connect_check_clear(int tid, int64 tick, int id, intptr_t data)
@@ -1514,6 +1789,12 @@ static bool socket_config_read(const char *filename, bool imported)
 		sockt->stall_time = i32;
 	}
 
+	if (libconfig->setting_lookup_int(setting, "cycle_budget", &i32) == CONFIG_TRUE) {
+		if (i32 < 0)
+			i32 = 0;
+		timer->cycle_budget = i32;
+	}
+
 #ifdef SOCKET_EPOLL
 	if (libconfig->setting_lookup_int(setting, "epoll_maxevents", &i32) == CONFIG_TRUE) {
 		if (i32 < 16)
@@ -1562,9 +1843,10 @@ static void socket_final(void)
 			sockt->close(i);
 
 	// sockt->session[0]
-	aFree(sockt->session[0]->rdata);
-	aFree(sockt->session[0]->wdata);
+	sockt->fifo_free(sockt->session[0]->rdata, sockt->session[0]->max_rdata);
+	sockt->fifo_free(sockt->session[0]->wdata, sockt->session[0]->max_wdata);
 	aFree(sockt->session[0]);
+	sockt->fifo_pool_final();
 
 	aFree(sockt->session);
 
@@ -1787,6 +2069,9 @@ static void socket_init(void)
 	timer->add_func_list(connect_check_clear, "connect_check_clear");
 	timer->add_interval(timer->gettick()+1000, connect_check_clear, 0, 0, 5*60*1000);
 
+	timer->add_func_list(fifo_idle_check, "fifo_idle_check");
+	timer->add_interval(timer->gettick()+FIFO_IDLE_CHECK_INTERVAL, fifo_idle_check, 0, 0, FIFO_IDLE_CHECK_INTERVAL);
+
 	ShowInfo("Server supports up to '"CL_WHITE"%"PRIu64""CL_RESET"' concurrent connections.\n", rlim_cur);
 }
 
@@ -2182,6 +2467,8 @@ void socket_defaults(void)
 	/* */
 	sockt->stall_time = 60;
 	sockt->last_tick = 0;
+	sockt->parse_next = 0;
+	sockt->last_wait = 0;
 	/* */
 	memset(&sockt->addr_, 0, sizeof(sockt->addr_));
 	sockt->naddr_ = 0;
@@ -2202,6 +2489,13 @@ void socket_defaults(void)
 	sockt->make_connection = make_connection;
 	sockt->realloc_fifo = realloc_fifo;
 	sockt->realloc_writefifo = realloc_writefifo;
+	sockt->fifo_class = fifo_class;
+	sockt->fifo_alloc = fifo_alloc;
+	sockt->fifo_free = fifo_free;
+	sockt->fifo_realloc = fifo_realloc;
+	sockt->fifo_trim = fifo_trim;
+	sockt->fifo_pool_final = fifo_pool_final;
+	sockt->fifo_report = fifo_report;
 	sockt->wfifoset = wfifoset;
 	sockt->wfifohead = wfifohead;
 	sockt->rfifoskip = rfifoskip;
@@ -182,6 +182,8 @@ struct socket_interface {
 	/* */
 	time_t stall_time;
 	time_t last_tick;
+	int parse_next;     ///< Session to resume parsing from, when the previous cycle ran out of budget (0 = none).
+	uint64 last_wait;   ///< Time spent waiting for events in the last cycle, in timer->perf_counter() units (profiler only).
 
 	const char *SOCKET_CONF_FILENAME;
 	/* */
@@ -207,6 +209,13 @@ struct socket_interface {
 	int (*make_connection) (uint32 ip, uint16 port, struct hSockOpt *opt);
 	int (*realloc_fifo) (int fd, unsigned int rfifo_size, unsigned int wfifo_size);
 	int (*realloc_writefifo) (int fd, size_t addition);
+	int (*fifo_class) (size_t size);
+	uint8 *(*fifo_alloc) (size_t *size);
+	void (*fifo_free) (uint8 *buf, size_t size);
+	uint8 *(*fifo_realloc) (uint8 *buf, size_t old_size, size_t used, size_t *new_size);
+	void (*fifo_trim) (void);
+	void (*fifo_pool_final) (void);
+	void (*fifo_report) (void);
 	int (*wfifoset) (int fd, size_t len, bool validate);
 	void (*wfifohead) (int fd, size_t len);
 	int (*rfifoskip) (int fd, size_t len);
@@ -28,6 +28,7 @@
 #include "common/conf.h"
 #include "common/memmgr.h"
 #include "common/nullpo.h"
+#include "common/profiler.h"
 #include "common/showmsg.h"
 #include "common/strlib.h"
 #include "common/timer.h"
@@ -75,6 +76,7 @@ struct SqlStmt {
 	size_t max_columns;
 	bool bind_params;
 	bool bind_columns;
+	int profiler_zone; ///< Profiler zone of the prepared query (-1 = not looked up yet)
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -102,6 +104,22 @@ static struct Sql *Sql_Malloc(void)
 	return self;
 }
 
+/// Initializes the client library for the calling thread.
+static int Sql_ThreadInit(void)
+{
+	if (mysql_thread_init() != 0) {
+		ShowSQL("Sql_ThreadInit: Failed to initialize the client library for this thread.\n");
+		return SQL_ERROR;
+	}
+	return SQL_SUCCESS;
+}
+
+/// Releases the client library data of the calling thread.
+static void Sql_ThreadEnd(void)
+{
+	mysql_thread_end();
+}
+
 static int Sql_P_Keepalive(struct Sql *self);
 
 /// Establishes a connection.
@@ -223,6 +241,15 @@ static int Sql_P_Keepalive(struct Sql *self)
 	return timer->add_interval(timer->gettick() + ping_interval*1000, Sql_P_KeepaliveTimer, 0, (intptr_t)self, ping_interval*1000);
 }
 
+/// Stops the keepalive (periodic ping) of the connection.
+static void Sql_StopKeepalive(struct Sql *self)
+{
+	if (self != NULL && self->keepalive != INVALID_TIMER) {
+		timer->delete(self->keepalive, Sql_P_KeepaliveTimer);
+		self->keepalive = INVALID_TIMER;
+	}
+}
+
 /// Escapes a string.
 static size_t Sql_EscapeString(struct Sql *self, char *out_to, const char *from)
 {
@@ -255,23 +282,35 @@ static int Sql_Query(struct Sql *self, const char *query, ...)
 	return res;
 }
 
+/// Accounts the time spent in a query to its profiler zone.
+static void Sql_P_Profile(const char *query, uint64 start)
+{
+	if (start != 0)
+		profiler->end(profiler->find_sql(query), start);
+}
+
 /// Executes a query.
 static int Sql_QueryV(struct Sql *self, const char *query, va_list args) __attribute__((format(printf, 2, 0)));
 static int Sql_QueryV(struct Sql *self, const char *query, va_list args)
 {
+	uint64 prof;
+
 	if( self == NULL )
 		return SQL_ERROR;
 
 	SQL->FreeResult(self);
 	StrBuf->Clear(&self->buf);
 	StrBuf->Vprintf(&self->buf, query, args);
+	prof = profiler->begin();
 	if( mysql_real_query(&self->handle, StrBuf->Value(&self->buf), (unsigned long)StrBuf->Length(&self->buf)) )
 	{
+		Sql_P_Profile(StrBuf->Value(&self->buf), prof);
 		ShowSQL("DB error - %s\n", mysql_error(&self->handle));
 		hercules_mysql_error_handler(mysql_errno(&self->handle));
 		return SQL_ERROR;
 	}
 	self->result = mysql_store_result(&self->handle);
+	Sql_P_Profile(StrBuf->Value(&self->buf), prof);
 	if( mysql_errno(&self->handle) != 0 )
 	{
 		ShowSQL("DB error - %s\n", mysql_error(&self->handle));
@@ -284,19 +323,24 @@ static int Sql_QueryV(struct Sql *self, const char *query, va_list args)
 /// Executes a query.
 static int Sql_QueryStr(struct Sql *self, const char *query)
 {
+	uint64 prof;
+
 	if( self == NULL )
 		return SQL_ERROR;
 
 	SQL->FreeResult(self);
 	StrBuf->Clear(&self->buf);
 	StrBuf->AppendStr(&self->buf, query);
+	prof = profiler->begin();
 	if( mysql_real_query(&self->handle, StrBuf->Value(&self->buf), (unsigned long)StrBuf->Length(&self->buf)) )
 	{
+		Sql_P_Profile(StrBuf->Value(&self->buf), prof);
 		ShowSQL("DB error - %s\n", mysql_error(&self->handle));
 		hercules_mysql_error_handler(mysql_errno(&self->handle));
 		return SQL_ERROR;
 	}
 	self->result = mysql_store_result(&self->handle);
+	Sql_P_Profile(StrBuf->Value(&self->buf), prof);
 	if( mysql_errno(&self->handle) != 0 )
 	{
 		ShowSQL("DB error - %s\n", mysql_error(&self->handle));
@@ -306,21 +350,46 @@ static int Sql_QueryStr(struct Sql *self, const char *query)
 	return SQL_SUCCESS;
 }
 
+/// Executes a query from a thread that owns the handle.
+static int Sql_QueryRaw(struct Sql *self, const char *query, size_t len, char *out_error, size_t error_len)
+{
+	MYSQL_RES *result;
+
+	if (self == NULL || query == NULL)
+		return SQL_ERROR;
+
+	if (mysql_real_query(&self->handle, query, (unsigned long)len) == 0) {
+		// Statements without a result set (INSERT, UPDATE...) return NULL here.
+		if ((result = mysql_store_result(&self->handle)) != NULL)
+			mysql_free_result(result);
+		if (mysql_errno(&self->handle) == 0)
+			return SQL_SUCCESS;
+	}
+	if (out_error != NULL && error_len > 0)
+		safestrncpy(out_error, mysql_error(&self->handle), error_len);
+	return SQL_ERROR;
+}
+
 static int Sql_QueryStrFetch(struct Sql *self, const char *query)
 {
+	uint64 prof;
+
 	if( self == NULL )
 		return SQL_ERROR;
 
 	SQL->FreeResult(self);
 	StrBuf->Clear(&self->buf);
 	StrBuf->AppendStr(&self->buf, query);
+	prof = profiler->begin();
 	if( mysql_real_query(&self->handle, StrBuf->Value(&self->buf), (unsigned long)StrBuf->Length(&self->buf)) )
 	{
+		Sql_P_Profile(StrBuf->Value(&self->buf), prof);
 		ShowSQL("DB error - %s\n", mysql_error(&self->handle));
 		hercules_mysql_error_handler(mysql_errno(&self->handle));
 		return SQL_ERROR;
 	}
 	self->result = mysql_store_result(&self->handle);
+	Sql_P_Profile(StrBuf->Value(&self->buf), prof);
 	if( mysql_errno(&self->handle) != 0 )
 	{
 		ShowSQL("DB error - %s\n", mysql_error(&self->handle));
@@ -656,6 +725,7 @@ static struct SqlStmt *SqlStmt_Malloc(struct Sql *sql)
 	self->max_columns = 0;
 	self->bind_params = false;
 	self->bind_columns = false;
+	self->profiler_zone = -1;
 
 	return self;
 }
@@ -691,6 +761,7 @@ static int SqlStmt_PrepareV(struct SqlStmt *self, const char *query, va_list arg
 		return SQL_ERROR;
 	}
 	self->bind_params = false;
+	self->profiler_zone = -1;
 
 	return SQL_SUCCESS;
 }
@@ -711,6 +782,7 @@ static int SqlStmt_PrepareStr(struct SqlStmt *self, const char *query)
 		return SQL_ERROR;
 	}
 	self->bind_params = false;
+	self->profiler_zone = -1;
 
 	return SQL_SUCCESS;
 }
@@ -764,10 +836,13 @@ PRAGMA_GCC46(GCC diagnostic pop)
 /// Executes the prepared statement.
 static int SqlStmt_Execute(struct SqlStmt *self)
 {
+	uint64 prof;
+
 	if( self == NULL )
 		return SQL_ERROR;
 
 	SQL->StmtFreeResult(self);
+	prof = profiler->begin();
 	if( (self->bind_params && mysql_stmt_bind_param(self->stmt, self->params)) ||
 		mysql_stmt_execute(self->stmt) )
 	{
@@ -783,6 +858,12 @@ static int SqlStmt_Execute(struct SqlStmt *self)
 		return SQL_ERROR;
 	}
 
+	if (prof != 0) {
+		if (self->profiler_zone < 0)
+			self->profiler_zone = profiler->find_sql(StrBuf->Value(&self->buf));
+		profiler->end(self->profiler_zone, prof);
+	}
+
 	return SQL_SUCCESS;
 }
 
@@ -1142,12 +1223,14 @@ void sql_defaults(void)
 	SQL->GetColumnNames = Sql_GetColumnNames;
 	SQL->SetEncoding = Sql_SetEncoding;
 	SQL->Ping = Sql_Ping;
+	SQL->StopKeepalive = Sql_StopKeepalive;
 	SQL->EscapeString = Sql_EscapeString;
 	SQL->EscapeStringLen = Sql_EscapeStringLen;
 	SQL->Query = Sql_Query;
 	SQL->QueryV = Sql_QueryV;
 	SQL->QueryStr = Sql_QueryStr;
 	SQL->QueryStrFetch = Sql_QueryStrFetch;
+	SQL->QueryRaw = Sql_QueryRaw;
 	SQL->LastInsertId = Sql_LastInsertId;
 	SQL->NumColumns = Sql_NumColumns;
 	SQL->NumRows = Sql_NumRows;
@@ -1157,6 +1240,8 @@ void sql_defaults(void)
 	SQL->ShowDebug_ = Sql_ShowDebug_;
 	SQL->Free = Sql_Free;
 	SQL->Malloc = Sql_Malloc;
+	SQL->ThreadInit = Sql_ThreadInit;
+	SQL->ThreadEnd = Sql_ThreadEnd;
 
 	/* SqlStmt defaults [Susu] */
 	SQL->StmtBindColumn = SqlStmt_BindColumn;
@@ -97,6 +97,10 @@ struct sql_interface {
 	///
 	/// @return SQL_SUCCESS or SQL_ERROR
 	int (*Ping) (struct Sql *self);
+	/// Stops the keepalive (periodic ping) of the connection.
+	/// Used when the handle is handed over to another thread, since the
+	/// keepalive timer runs on the main thread.
+	void (*StopKeepalive) (struct Sql *self);
 	/// Escapes a string.
 	/// The output buffer must be at least strlen(from)*2+1 in size.
 	///
@@ -131,6 +135,13 @@ struct sql_interface {
 	///
 	/// @return SQL_SUCCESS or SQL_ERROR
 	int (*QueryStrFetch) (struct Sql *self, const char *query);
+	/// Executes a query from a thread that owns the handle.
+	/// Unlike QueryStr, it doesn't use the query buffer of the handle, the
+	/// memory manager or the console, and any result is discarded.
+	/// On error, the mysql error message is copied to out_error.
+	///
+	/// @return SQL_SUCCESS or SQL_ERROR
+	int (*QueryRaw) (struct Sql *self, const char *query, size_t len, char *out_error, size_t error_len);
 	/// Returns the number of the AUTO_INCREMENT column of the last INSERT/UPDATE query.
 	///
 	/// @return Value of the auto-increment column
@@ -161,6 +172,11 @@ struct sql_interface {
 	void (*Free) (struct Sql *self);
 	/// Allocates and initializes a new Sql handle.
 	struct Sql *(*Malloc) (void);
+	/// Initializes the client library for the calling thread.
+	/// Threads other than the main one must call it before using a Sql handle.
+	int (*ThreadInit) (void);
+	/// Releases the client library data of the calling thread (see ThreadInit).
+	void (*ThreadEnd) (void);
 
 	///////////////////////////////////////////////////////////////////////////////
 	// Prepared Statements
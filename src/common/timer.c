@@ -26,6 +26,7 @@
 #include "common/db.h"
 #include "common/memmgr.h"
 #include "common/nullpo.h"
+#include "common/profiler.h"
 #include "common/showmsg.h"
 #include "common/utils.h"
 
@@ -74,6 +75,12 @@ static BHEAP_VAR(int, timer_heap);
 // server startup time
 static time_t start_time;
 
+// resumable work items
+static VECTOR_DECL(struct TimerTask) timer_tasks;
+
+// perf_counter() value at which the budget of the current cycle phase ends (0 = unlimited)
+static uint64 timer_budget_deadline = 0;
+
 
 /*----------------------------
  * Timer debugging
@@ -224,6 +231,57 @@ static int64 sys_tick(void)
 #endif
 }
 
+/**
+ * High resolution counter, used to measure short intervals (profiling).
+ *
+ * Uses the calibrated RDTSC source when enabled, otherwise the most precise
+ * monotonic clock available on the platform.
+ *
+ * @return the current counter value, in units of 1/timer->perf_frequency() seconds.
+ */
+static uint64 timer_perf_counter(void)
+{
+#if defined(ENABLE_RDTSC)
+	return rdtsc_();
+#elif defined(WIN32)
+	LARGE_INTEGER count;
+	QueryPerformanceCounter(&count);
+	return (uint64)count.QuadPart;
+#elif defined(HAVE_MONOTONIC_CLOCK)
+	struct timespec tval;
+	clock_gettime(CLOCK_MONOTONIC, &tval);
+	return (uint64)tval.tv_sec * 1000000000 + (uint64)tval.tv_nsec;
+#else
+	struct timeval tval;
+	gettimeofday(&tval, NULL);
+	return (uint64)tval.tv_sec * 1000000 + (uint64)tval.tv_usec;
+#endif
+}
+
+/**
+ * Frequency of the high resolution counter.
+ *
+ * @return the amount of timer->perf_counter() units per second.
+ */
+static uint64 timer_perf_frequency(void)
+{
+#if defined(ENABLE_RDTSC)
+	return RDTSC_CLOCK * 1000;
+#elif defined(WIN32)
+	static uint64 frequency = 0;
+	if (frequency == 0) {
+		LARGE_INTEGER freq;
+		QueryPerformanceFrequency(&freq);
+		frequency = (uint64)freq.QuadPart;
+	}
+	return frequency;
+#elif defined(HAVE_MONOTONIC_CLOCK)
+	return 1000000000;
+#else
+	return 1000000;
+#endif
+}
+
 //////////////////////////////////////////////////////////////////////////
 #if defined(TICK_CACHE) && TICK_CACHE > 1
 //////////////////////////////////////////////////////////////////////////
@@ -477,6 +535,9 @@ static int64 timer_settick(int tid, int64 tick)
 static int do_timer(int64 tick)
 {
 	int64 diff = TIMER_MAX_INTERVAL; // return value
+	bool first = true, pending = false;
+
+	timer->budget_start();
 
 	// process all timers one by one
 	while (BHEAP_LENGTH(timer_heap) > 0) {
@@ -486,16 +547,33 @@ static int do_timer(int64 tick)
 		if( diff > 0 )
 			break; // no more expired timers to process
 
+		if (!first && timer->budget_exceeded()) {
+			// out of budget, the remaining expired timers run in the next cycle
+			pending = true;
+			break;
+		}
+		first = false;
+
 		// remove timer
 		BHEAP_POP(timer_heap, DIFFTICK_MINTOPCMP, swap);
 		timer_data[tid].type |= TIMER_REMOVE_HEAP;
 
 		if( timer_data[tid].func ) {
+			TimerFunc func = timer_data[tid].func;
+			uint64 prof = profiler->begin();
+
 			if( diff < -1000 )
 				// timer was delayed for more than 1 second, use current tick instead
-				timer_data[tid].func(tid, tick, timer_data[tid].id, timer_data[tid].data);
+				func(tid, tick, timer_data[tid].id, timer_data[tid].data);
 			else
-				timer_data[tid].func(tid, timer_data[tid].tick, timer_data[tid].id, timer_data[tid].data);
+				func(tid, timer_data[tid].tick, timer_data[tid].id, timer_data[tid].data);
+
+			if (prof != 0) {
+				int zone = profiler->find(PROFILER_TIMER, (int64)(intptr_t)func);
+				if (zone < 0)
+					zone = profiler->add(PROFILER_TIMER, (int64)(intptr_t)func, search_timer_func_list(func));
+				profiler->end(zone, prof);
+			}
 		}
 
 		// in the case the function didn't change anything...
@@ -525,9 +603,63 @@ static int do_timer(int64 tick)
 		}
 	}
 
+	if (timer->perform_tasks() || pending)
+		return 0; // don't wait for socket events, work is left
+
 	return (int)cap_value(diff, TIMER_MIN_INTERVAL, TIMER_MAX_INTERVAL);
 }
 
+/// @copydoc timer_interface::budget_start()
+static void timer_budget_start(void)
+{
+	if (timer->cycle_budget > 0)
+		timer_budget_deadline = timer->perf_counter() + timer->perf_frequency() * timer->cycle_budget / 1000;
+	else
+		timer_budget_deadline = 0;
+}
+
+/// @copydoc timer_interface::budget_exceeded()
+static bool timer_budget_exceeded(void)
+{
+	return timer_budget_deadline != 0 && timer->perf_counter() >= timer_budget_deadline;
+}
+
+/// @copydoc timer_interface::add_task()
+static void timer_add_task(TaskFunc func, int id, intptr_t data)
+{
+	struct TimerTask *task;
+
+	nullpo_retv(func);
+
+	VECTOR_ENSURE(timer_tasks, 1, 8);
+	VECTOR_PUSHZEROED(timer_tasks);
+	task = &VECTOR_LAST(timer_tasks);
+	task->func = func;
+	task->id = id;
+	task->data = data;
+}
+
+/// @copydoc timer_interface::perform_tasks()
+static bool timer_perform_tasks(void)
+{
+	int i, count = VECTOR_LENGTH(timer_tasks);
+
+	// Every task queued at the start gets one slice per cycle, even when
+	// the timers used up the budget, so that they can't be starved by a busy
+	// server. Each task is expected to keep its own slice short.
+	for (i = 0; i < count && VECTOR_LENGTH(timer_tasks) > 0; i++) {
+		struct TimerTask task = VECTOR_FIRST(timer_tasks); // the vector may grow while running it
+
+		VECTOR_ERASE(timer_tasks, 0);
+		if (!task.func(task.id, task.data, false)) {
+			VECTOR_ENSURE(timer_tasks, 1, 8);
+			VECTOR_PUSH(timer_tasks, task); // round-robin
+		}
+	}
+
+	return VECTOR_LENGTH(timer_tasks) > 0;
+}
+
 static unsigned long timer_get_uptime(void)
 {
 	return (unsigned long)difftime(time(NULL), start_time);
@@ -540,6 +672,7 @@ static void timer_init(void)
 #endif
 
 	time(&start_time);
+	VECTOR_INIT(timer_tasks);
 }
 
 static void timer_final(void)
@@ -553,6 +686,12 @@ static void timer_final(void)
 		aFree(tfl);
 	}
 
+	while (VECTOR_LENGTH(timer_tasks) > 0) {
+		struct TimerTask task = VECTOR_POP(timer_tasks);
+		task.func(task.id, task.data, true);
+	}
+	VECTOR_CLEAR(timer_tasks);
+
 	if (timer_data) aFree(timer_data);
 	BHEAP_CLEAR(timer_heap);
 	if (free_timer_list) aFree(free_timer_list);
@@ -664,4 +803,11 @@ void timer_defaults(void)
 	timer->check_timers = timer_check_timers;
 	timer->get_current_clocksource = timer_get_current_clocksource;
 	timer->get_available_clocksource = timer_get_available_clocksource;
+	timer->perf_counter = timer_perf_counter;
+	timer->perf_frequency = timer_perf_frequency;
+	timer->cycle_budget = 0;
+	timer->budget_start = timer_budget_start;
+	timer->budget_exceeded = timer_budget_exceeded;
+	timer->add_task = timer_add_task;
+	timer->perform_tasks = timer_perform_tasks;
 }
@@ -50,6 +50,27 @@ struct TimerData {
 	intptr_t data;
 };
 
+/**
+ * A resumable work item, see timer_interface::add_task().
+ *
+ * Each call does a slice of the work, checking timer->budget_exceeded()
+ * between steps.
+ *
+ * @param id    General-purpose storage.
+ * @param data  General-purpose storage.
+ * @param abort Whether the server is shutting down: the task must only release its data.
+ * @return true when the work is finished, false to be called again in the next cycle.
+ */
+typedef bool (*TaskFunc)(int id, intptr_t data, bool abort);
+
+struct TimerTask {
+	TaskFunc func;
+
+	// general-purpose storage
+	int id;
+	intptr_t data;
+};
+
 
 /*=====================================
 * Interface : timer.h
@@ -80,6 +101,43 @@ struct timer_interface {
 	void (*check_timers) (void);
 	bool (*get_current_clocksource) (char *buf, int buf_size);
 	bool (*get_available_clocksource) (char *buf, int buf_size);
+	uint64 (*perf_counter) (void);
+	uint64 (*perf_frequency) (void);
+
+	/**
+	 * Time budget of each phase of a server cycle (timers and tasks, packet
+	 * parsing), in milliseconds. 0 means unlimited.
+	 *
+	 * Work left when the budget is used up is resumed in the next cycle.
+	 */
+	int cycle_budget;
+
+	/**
+	 * Starts the budget of a cycle phase.
+	 */
+	void (*budget_start) (void);
+
+	/**
+	 * Checks whether the budget of the current cycle phase is used up.
+	 */
+	bool (*budget_exceeded) (void);
+
+	/**
+	 * Queues a resumable work item, run in slices at the end of each cycle's
+	 * timer phase until it reports to be finished.
+	 *
+	 * @param func The task function.
+	 * @param id   General-purpose storage passed to func.
+	 * @param data General-purpose storage passed to func.
+	 */
+	void (*add_task) (TaskFunc func, int id, intptr_t data);
+
+	/**
+	 * Runs one slice of each queued task.
+	 *
+	 * @return whether tasks are left for the next cycle.
+	 */
+	bool (*perform_tasks) (void);
 };
 
 #ifdef HERCULES_CORE
@@ -421,6 +421,29 @@ uint64 get_percentage64(const uint64 A, const uint64 B)
 	return (uint64)floor(result);
 }
 
+/**
+ * Calculates the 64-bit FNV-1a hash of a memory block.
+ *
+ * Used to address contents (such as guild emblems) across servers.
+ *
+ * @param data   The data to hash.
+ * @param length The length of the data, in bytes.
+ * @return the hash value.
+ */
+uint64 hash_fnv1a64(const void *data, size_t length)
+{
+	const uint8 *p = data;
+	uint64 hash = UINT64_C(0xcbf29ce484222325);
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		hash ^= p[i];
+		hash *= UINT64_C(0x100000001b3);
+	}
+
+	return hash;
+}
+
 /**
  * Applies a percentual rate modifier.
  *
@@ -58,6 +58,9 @@ uint64 get_percentage64(const uint64 A, const uint64 B);
 int64 apply_percentrate64(int64 value, int rate, int maxrate);
 int apply_percentrate(int value, int rate, int maxrate);
 
+/// calculates the 64-bit FNV-1a hash of 'length' bytes of 'data'
+uint64 hash_fnv1a64(const void *data, size_t length);
+
 const char* timestamp2string(char* str, size_t size, time_t timestamp, const char* format);
 
 //////////////////////////////////////////////////////////////////////////
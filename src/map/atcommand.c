@@ -4355,7 +4355,7 @@ ACMD(mount_peco)
 		return false;
 	}
 
-	if (sd->sc.data[SC_ALL_RIDING]) {
+	if (sc_data(&sd->sc, SC_ALL_RIDING)) {
 		clif->message(fd, msg_fd(fd, MSGTBL_ALREADY_MOUNTED)); // You are already mounting something else
 		return false;
 	}
@@ -4915,7 +4915,7 @@ ACMD(jail)
 		return false;
 	}
 
-	if (pl_sd->sc.data[SC_JAILED])
+	if (sc_data(&pl_sd->sc, SC_JAILED))
 	{
 		clif->message(fd, msg_fd(fd, MSGTBL_WARPED_TO_JAIL)); // Player warped in jails.
 		return false;
@@ -4967,7 +4967,7 @@ ACMD(unjail)
 		return false;
 	}
 
-	if (!pl_sd->sc.data[SC_JAILED])
+	if (!sc_data(&pl_sd->sc, SC_JAILED))
 	{
 		clif->message(fd, msg_fd(fd, MSGTBL_PLAYER_NOT_IN_JAIL)); // This player is not in jails.
 		return false;
@@ -5053,9 +5053,9 @@ ACMD(jailfor)
 	}
 
 	//Added by Coltaro
-	if (pl_sd->sc.data[SC_JAILED] && pl_sd->sc.data[SC_JAILED]->val1 != INT_MAX) {
+	if (sc_data(&pl_sd->sc, SC_JAILED) && sc_data(&pl_sd->sc, SC_JAILED)->val1 != INT_MAX) {
 		//Update the player's jail time
-		jailtime += pl_sd->sc.data[SC_JAILED]->val1;
+		jailtime += sc_data(&pl_sd->sc, SC_JAILED)->val1;
 		if (jailtime <= 0) {
 			jailtime = 0;
 			clif->message(pl_sd->fd, msg_fd(fd, MSGTBL_UNJAILED_BY_GM)); // GM has discharge you.
@@ -5094,23 +5094,23 @@ ACMD(jailtime)
 {
 	int year, month, day, hour, minute;
 
-	if (!sd->sc.data[SC_JAILED]) {
+	if (!sc_data(&sd->sc, SC_JAILED)) {
 		clif->message(fd, msg_fd(fd, MSGTBL_NOT_IN_JAIL)); // You are not in jail.
 		return false;
 	}
 
-	if (sd->sc.data[SC_JAILED]->val1 == INT_MAX) {
+	if (sc_data(&sd->sc, SC_JAILED)->val1 == INT_MAX) {
 		clif->message(fd, msg_fd(fd, MSGTBL_JAILED_INDEFINITELY)); // You have been jailed indefinitely.
 		return true;
 	}
 
-	if (sd->sc.data[SC_JAILED]->val1 <= 0) { // Was not jailed with @jailfor (maybe @jail? or warped there? or got recalled?)
+	if (sc_data(&sd->sc, SC_JAILED)->val1 <= 0) { // Was not jailed with @jailfor (maybe @jail? or warped there? or got recalled?)
 		clif->message(fd, msg_fd(fd, MSGTBL_JAILED_UNKNOWN_TIME)); // You have been jailed for an unknown amount of time.
 		return false;
 	}
 
 	//Get remaining jail time
-	atcommand->get_jail_time(sd->sc.data[SC_JAILED]->val1,&year,&month,&day,&hour,&minute);
+	atcommand->get_jail_time(sc_data(&sd->sc, SC_JAILED)->val1,&year,&month,&day,&hour,&minute);
 	snprintf(atcmd_output, sizeof(atcmd_output),msg_fd(fd, MSGTBL_JAILFOR_TIME),msg_fd(fd, MSGTBL_WILL_REMAIN),year,month,day,hour,minute); // You will remain in jail for %d years, %d months, %d days, %d hours and %d minutes
 
 	clif->message(fd, atcmd_output);
@@ -5155,7 +5155,7 @@ ACMD(disguise)
 		return false;
 	}
 
-	if (sd->sc.data[SC_MONSTER_TRANSFORM] != NULL || sd->sc.data[SC_ACTIVE_MONSTER_TRANSFORM] != NULL)
+	if (sc_data(&sd->sc, SC_MONSTER_TRANSFORM) != NULL || sc_data(&sd->sc, SC_ACTIVE_MONSTER_TRANSFORM) != NULL)
 	{
 		clif->message(fd, msg_fd(fd, MSGTBL_NOT_DISGUISE_WHILE_TRANSFORMED)); // Character cannot be disguised while in monster form.
 		return false;
@@ -5671,6 +5671,8 @@ ACMD(clearstorage)
 	}
 
 	if (sd->storage.received == false) {
+		if (!sd->storage.requested)
+			intif->request_account_storage(sd, 0);
 		clif->message(fd, msg_fd(fd, MSGTBL_STORAGE_NOT_LOADED)); // "Storage has not been loaded yet"
 		return false;
 	}
@@ -6934,7 +6936,7 @@ ACMD(unmute)
 		return false;
 	}
 
-	if (!pl_sd->sc.data[SC_NOCHAT]) {
+	if (!sc_data(&pl_sd->sc, SC_NOCHAT)) {
 		clif->message(sd->fd,msg_fd(fd, MSGTBL_UNMUTE_NOT_MUTED)); // Player is not muted.
 		return false;
 	}
@@ -8766,6 +8768,12 @@ ACMD(itemlist)
 	StringBuf buf;
 
 	if( strcmpi(info->command, "storagelist") == 0 ) {
+		if (sd->storage.received == false) {
+			if (!sd->storage.requested)
+				intif->request_account_storage(sd, 0);
+			clif->message(fd, msg_fd(fd, MSGTBL_STORAGE_NOT_LOADED)); // "Storage has not been loaded yet"
+			return false;
+		}
 		location = "storage";
 		items = VECTOR_DATA(sd->storage.item);
 		size = VECTOR_LENGTH(sd->storage.item);
@@ -9174,7 +9182,7 @@ ACMD(cashmount)
 
 	clif->message(sd->fd, msg_fd(fd, MSGTBL_NEW_MOUNT_NOTICE)); // NOTICE: If you crash with mount, your Lua files are outdated.
 
-	if (!sd->sc.data[SC_ALL_RIDING]) {
+	if (!sc_data(&sd->sc, SC_ALL_RIDING)) {
 		clif->message(sd->fd, msg_fd(fd, MSGTBL_NEW_MOUNT_MOUNTED)); // You are mounted now.
 		sc_start(NULL, &sd->bl, SC_ALL_RIDING, 100, battle_config.boarding_halter_speed, INFINITE_DURATION, 0);
 	} else {
@@ -10159,7 +10167,7 @@ ACMD(costume)
 
 	if (!*message) {
 		for (k = 0; k < len; k++) {
-			if (sd->sc.data[name2id[k]]) {
+			if (sc_data(&sd->sc, name2id[k])) {
 				snprintf(atcmd_output, sizeof(atcmd_output), msg_fd(fd, MSGTBL_COSTUME_REMOVED), names[k]); // Costume '%s' removed.
 				clif->message(sd->fd, atcmd_output);
 				status_change_end(&sd->bl, name2id[k], INVALID_TIMER);
@@ -10182,7 +10190,7 @@ ACMD(costume)
 		return true;
 
 	for (k = 0; k < len; k++) {
-		if (sd->sc.data[name2id[k]]) {
+		if (sc_data(&sd->sc, name2id[k])) {
 			snprintf(atcmd_output, sizeof(atcmd_output), msg_fd(fd, MSGTBL_COSTUME_ALREADY), names[k]); // You're already with a '%s' costume, type '@costume' to remove it.
 			clif->message(sd->fd, atcmd_output);
 			return false;
@@ -10453,6 +10461,120 @@ ACMD(camerainfo)
 	return true;
 }
 
+/**
+ * Displays client packet statistics.
+ * Usage:
+ *   @packetstats [count|bytes|time] [<amount>] - top packet IDs
+ *   @packetstats flood [<amount>]              - sessions with the highest packet rate
+ *   @packetstats player <name>                 - packet rate histogram of a player
+ *   @packetstats dump                          - appends the statistics to PACKET_STATS_FILE
+ *   @packetstats reset                         - clears the statistics
+ */
+ACMD(packetstats)
+{
+	char mode[16] = "", param[NAME_LENGTH] = "";
+	double frequency = (double)timer->perf_frequency();
+	int amount = 10, i;
+
+	if (battle_config.packet_stats == PACKET_STATS_OFF) {
+		clif->message(fd, "Packet statistics are disabled (battle config packet_stats).");
+		return false;
+	}
+
+	if (*message != '\0')
+		sscanf(message, "%15s %23[^\n]", mode, param);
+	if (*param != '\0' && ISDIGIT(*param))
+		amount = cap_value(atoi(param), 1, 50);
+
+	if (strcmpi(mode, "reset") == 0) {
+		clif->packet_stats_reset();
+		clif->message(fd, "Packet statistics cleared.");
+		return true;
+	}
+
+	if (strcmpi(mode, "dump") == 0) {
+		if (!clif->packet_stats_dump(PACKET_STATS_FILE))
+			return false;
+		snprintf(atcmd_output, sizeof(atcmd_output), "Packet statistics appended to %s.", PACKET_STATS_FILE);
+		clif->message(fd, atcmd_output);
+		return true;
+	}
+
+	if (strcmpi(mode, "player") == 0) {
+		struct map_session_data *pl_sd;
+		const struct s_packet_rate *rate;
+		StringBuf buf;
+
+		if (*param == '\0' || (pl_sd = map->nick2sd(param, true)) == NULL) {
+			clif->message(fd, msg_fd(fd, MSGTBL_CHARACTER_NOT_FOUND)); // Character not found.
+			return false;
+		}
+		rate = &pl_sd->packet_rate;
+		snprintf(atcmd_output, sizeof(atcmd_output), "%s: %"PRIu64" packets, %"PRIu64" bytes, peak %d packets/s.",
+		             pl_sd->status.name, rate->count, rate->bytes, rate->peak);
+		clif->message(fd, atcmd_output);
+
+		StrBuf->Init(&buf);
+		StrBuf->AppendStr(&buf, "Seconds at");
+		for (i = 0; i < PACKET_RATE_BUCKETS; i++)
+			StrBuf->Printf(&buf, " %d%s: %u", 1 << i, i == PACKET_RATE_BUCKETS - 1 ? "+" : "", rate->histogram[i]);
+		StrBuf->AppendStr(&buf, " packets/s");
+		clif->message(fd, StrBuf->Value(&buf));
+		StrBuf->Destroy(&buf);
+		return true;
+	}
+
+	if (strcmpi(mode, "flood") == 0) {
+		struct map_session_data *list[50];
+		int count = clif->packet_rate_top(list, amount);
+
+		clif->message(fd, "Character - peak packets/s - packets in the last second - total packets");
+		for (i = 0; i < count; i++) {
+			const struct s_packet_rate *rate = &list[i]->packet_rate;
+			snprintf(atcmd_output, sizeof(atcmd_output), "%s (AID %d) - %d/s - %d - %"PRIu64,
+			             list[i]->status.name, list[i]->status.account_id, rate->peak,
+			             DIFF_TICK(timer->gettick(), rate->window_tick) < 1000 ? rate->window_count : 0, rate->count);
+			clif->message(fd, atcmd_output);
+		}
+		return true;
+	}
+
+	{
+		enum packet_stats_sort sort = PACKET_STATS_SORT_TIME;
+		int ids[50];
+		int count;
+
+		if (strcmpi(mode, "count") == 0) {
+			sort = PACKET_STATS_SORT_COUNT;
+		} else if (strcmpi(mode, "bytes") == 0) {
+			sort = PACKET_STATS_SORT_BYTES;
+		} else if (*mode != '\0' && strcmpi(mode, "time") != 0) {
+			if (!ISDIGIT(*mode)) {
+				clif->message(fd, "Usage: @packetstats [count|bytes|time|flood|player|dump|reset] [<amount>|<name>]");
+				return false;
+			}
+			amount = cap_value(atoi(mode), 1, 50);
+		}
+
+		count = clif->packet_stats_top(ids, amount, sort);
+		snprintf(atcmd_output, sizeof(atcmd_output), "Packet statistics over the last %"PRId64" seconds (%s):",
+		             (int64)(DIFF_TICK(timer->gettick(), clif->packet_stats_since) / 1000),
+		             battle_config.packet_stats == PACKET_STATS_SAMPLED ? "sampled handler time" : "full handler time");
+		clif->message(fd, atcmd_output);
+		clif->message(fd, "Packet - count - bytes - handler time ms (avg us, max us)");
+		for (i = 0; i < count; i++) {
+			const struct s_packet_stats *ps = &clif->packet_stats[ids[i]];
+			snprintf(atcmd_output, sizeof(atcmd_output), "0x%04X - %"PRIu64" - %"PRIu64" - %.2f (%.1f, %.1f)",
+			             (unsigned int)ids[i], ps->count, ps->bytes,
+			             (double)ps->time * 1000 / frequency,
+			             ps->timed > 0 ? (double)ps->time * 1000000 / frequency / ps->timed : 0.,
+			             (double)ps->max_time * 1000000 / frequency);
+			clif->message(fd, atcmd_output);
+		}
+	}
+	return true;
+}
+
 ACMD(refineryui)
 {
 #if PACKETVER_MAIN_NUM >= 20161005 || PACKETVER_RE_NUM >= 20161005 || defined(PACKETVER_ZERO)
@@ -10819,6 +10941,7 @@ static void atcommand_basecommands(void)
 		ACMD_DEF(reloadclans),
 		ACMD_DEF(setzone),
 		ACMD_DEF(camerainfo),
+		ACMD_DEF(packetstats),
 		ACMD_DEF(refineryui),
 		ACMD_DEF(gradeui),
 		ACMD_DEF(reloadgradedb),
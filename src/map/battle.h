@@ -652,6 +652,10 @@ struct Battle_Config {
 	int feature_goldpc_default_mode;
 
 	int venom_dust_exp; // Enable exp given by venom dust
+
+	int packet_stats;
+	int packet_stats_sample;
+	int packet_stats_dump_interval;
 };
 
 /* criteria for battle_config.idletime_criteria */
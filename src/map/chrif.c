@@ -1072,6 +1072,7 @@ static bool chrif_save_scdata(struct map_session_data *sd)
 	int64 tick;
 	struct status_change_data data;
 	struct status_change *sc;
+	const struct status_change_entry *sce;
 	const struct TimerData *td;
 
 	nullpo_retr(false, sd);
@@ -1084,11 +1085,11 @@ static bool chrif_save_scdata(struct map_session_data *sd)
 	WFIFOL(chrif->fd,4) = sd->status.account_id;
 	WFIFOL(chrif->fd,8) = sd->status.char_id;
 
-	for (i = 0; i < SC_MAX; i++) {
-		if (!sc->data[i])
+	for (i = sc_next(sc, SC_NONE); i < SC_MAX; i = sc_next(sc, i)) {
+		if ((sce = sc_data(sc, i)) == NULL)
 			continue;
-		if (sc->data[i]->timer != INVALID_TIMER) {
-			td = timer->get(sc->data[i]->timer);
+		if (sce->timer != INVALID_TIMER) {
+			td = timer->get(sce->timer);
 			if (td == NULL || td->func != status->change_timer)
 				continue;
 			if (DIFF_TICK32(td->tick,tick) > 0)
@@ -1098,12 +1099,12 @@ static bool chrif_save_scdata(struct map_session_data *sd)
 		} else {
 			data.tick = INFINITE_DURATION;
 		}
-		data.total_tick = sc->data[i]->total_tick;
+		data.total_tick = sce->total_tick;
 		data.type = i;
-		data.val1 = sc->data[i]->val1;
-		data.val2 = sc->data[i]->val2;
-		data.val3 = sc->data[i]->val3;
-		data.val4 = sc->data[i]->val4;
+		data.val1 = sce->val1;
+		data.val2 = sce->val2;
+		data.val3 = sce->val3;
+		data.val4 = sce->val4;
 		memcpy(WFIFOP(chrif->fd,14 +count*sizeof(struct status_change_data)),
 			&data, sizeof(struct status_change_data));
 		count++;
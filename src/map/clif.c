@@ -404,7 +404,7 @@ static int clif_send_sub(struct block_list *bl, va_list ap)
 	}
 
 	/* unless visible, hold it here */
-	if( clif->ally_only && !sd->sc.data[SC_CLAIRVOYANCE] && !sd->special_state.intravision && battle->check_target( src_bl, &sd->bl, BCT_ENEMY ) > 0 )
+	if( clif->ally_only && !sc_data(&sd->sc, SC_CLAIRVOYANCE) && !sd->special_state.intravision && battle->check_target( src_bl, &sd->bl, BCT_ENEMY ) > 0 )
 		return 0;
 
 	return clif->send_actual(fd, buf, len);
@@ -1625,11 +1625,11 @@ static bool clif_spawn(struct block_list *bl)
 				for (i = 0; i < sd->sc_display_count; i++) {
 					enum sc_type type = sd->sc_display[i]->type;
 
-					if (sc->data[type] == NULL)
+					if (sc_data(sc, type) == NULL)
 						continue;
 
 					int tick = 0;
-					int tid = sc->data[type]->timer;
+					int tid = sc_data(sc, type)->timer;
 					const struct TimerData *td = (tid > 0) ? timer->get(tid) : NULL;
 
 					if (td != NULL)
@@ -3858,6 +3858,8 @@ static void clif_updatestatus(struct map_session_data *sd, enum status_point_typ
 				clif->hpmeter(sd);
 			if (!battle_config.party_hp_mode && sd->status.party_id)
 				clif->party_hp(sd);
+			else if (sd->status.party_id)
+				party->xy_mark(sd); // Sent by party->send_xy_timer
 			if (sd->bg_id)
 				clif->bg_hp(sd);
 			break;
@@ -4979,7 +4981,7 @@ static void clif_getareachar_pc(struct map_session_data *sd, struct map_session_
 	ARR_FIND( 0, MAX_PC_DEVOTION, i, dstsd->devotion[i] > 0 );
 	if( i < MAX_PC_DEVOTION ) clif->devotion(&dstsd->bl, sd);
 	// display link (dstsd - crusader) to sd
-	if( dstsd->sc.data[SC_DEVOTION] && (d_bl = map->id2bl(dstsd->sc.data[SC_DEVOTION]->val1)) != NULL )
+	if( sc_data(&dstsd->sc, SC_DEVOTION) && (d_bl = map->id2bl(sc_data(&dstsd->sc, SC_DEVOTION)->val1)) != NULL )
 		clif->devotion(d_bl, sd);
 }
 
@@ -5125,6 +5127,7 @@ static int clif_damage(struct block_list *src, struct block_list *dst, int sdela
 {
 	struct packet_damage p;
 	struct status_change *sc;
+	const struct status_change_entry *sce;
 #if PACKETVER < 20071113
 	short damage,damage2;
 #else
@@ -5136,9 +5139,9 @@ static int clif_damage(struct block_list *src, struct block_list *dst, int sdela
 
 	sc = status->get_sc(dst);
 
-	if(sc && sc->count && sc->data[SC_ILLUSION]) {
-		if(in_damage) in_damage = in_damage*(sc->data[SC_ILLUSION]->val2) + rnd()%100;
-		if(in_damage2) in_damage2 = in_damage2*(sc->data[SC_ILLUSION]->val2) + rnd()%100;
+	if (sc && sc->count && (sce = sc_data(sc, SC_ILLUSION)) != NULL) {
+		if(in_damage) in_damage = in_damage*(sce->val2) + rnd()%100;
+		if(in_damage2) in_damage2 = in_damage2*(sce->val2) + rnd()%100;
 	}
 
 #if PACKETVER < 20071113
@@ -5934,8 +5937,8 @@ static int clif_skill_damage(struct block_list *src, struct block_list *dst, int
 
 	const struct status_change *sc = status->get_sc(dst);
 	if (sc != NULL && sc->count) {
-		if (sc->data[SC_ILLUSION] != NULL && damage != 0)
-			damage = damage * (sc->data[SC_ILLUSION]->val2) + rnd() % 100;
+		if (sc_data(sc, SC_ILLUSION) != NULL && damage != 0)
+			damage = damage * (sc_data(sc, SC_ILLUSION)->val2) + rnd() % 100;
 	}
 
 	struct PACKET_ZC_NOTIFY_SKILL p = { 0 };
@@ -5989,8 +5992,8 @@ static int clif_skill_damage2(struct block_list *src, struct block_list *dst, in
 
 	const struct status_change *sc = status->get_sc(dst);
 	if (sc != NULL && sc->count) {
-		if (sc->data[SC_ILLUSION] != NULL && damage != 0)
-			damage = damage * (sc->data[SC_ILLUSION]->val2) + rnd() % 100;
+		if (sc_data(sc, SC_ILLUSION) != NULL && damage != 0)
+			damage = damage * (sc_data(sc, SC_ILLUSION)->val2) + rnd() % 100;
 	}
 
 	struct PACKET_ZC_NOTIFY_SKILL_POSITION p = { 0 };
@@ -9696,9 +9699,9 @@ static void clif_refresh_storagewindow(struct map_session_data *sd)
 	nullpo_retv(sd);
 	// Notify the client that the storage is open
 	if (sd->state.storage_flag == STORAGE_FLAG_NORMAL) {
-		if (sd->storage.aggregate > 0) {
-			storage->sortitem(VECTOR_DATA(sd->storage.item), VECTOR_LENGTH(sd->storage.item));
-		}
+		if (sd->storage.aggregate > 0
+		 && storage->sortitem_changes(VECTOR_DATA(sd->storage.item), VECTOR_LENGTH(sd->storage.item), &sd->storage.changes))
+			sd->storage.save = true;
 		clif->storageList(sd, VECTOR_DATA(sd->storage.item), VECTOR_LENGTH(sd->storage.item));
 		clif->updatestorageamount(sd, sd->storage.aggregate, MAX_STORAGE);
 	}
@@ -9715,7 +9718,8 @@ static void clif_refresh_storagewindow(struct map_session_data *sd)
 					sd->status.account_id, sd->status.guild_id);
 				return;
 			}
-			storage->sortitem(gstor->items.data, gstor->items.capacity);
+			if (storage->sortitem_changes(gstor->items.data, gstor->items.capacity, &gstor->changes))
+				gstor->dirty = true;
 			clif->guildStorageList(sd, gstor->items.data, gstor->items.capacity);
 			clif->updatestorageamount(sd, gstor->items.amount, sd->guild->max_storage);
 		}
@@ -11549,7 +11553,7 @@ static void clif_parse_LoadEndAck(int fd, struct map_session_data *sd)
 	if (sd->sc.opt2 != 0) // Client loses these on warp.
 		clif->changeoption(&sd->bl);
 
-	if ((sd->sc.data[SC_MONSTER_TRANSFORM] != NULL || sd->sc.data[SC_ACTIVE_MONSTER_TRANSFORM] != NULL)
+	if ((sc_data(&sd->sc, SC_MONSTER_TRANSFORM) != NULL || sc_data(&sd->sc, SC_ACTIVE_MONSTER_TRANSFORM) != NULL)
 	    && battle_config.mon_trans_disable_in_gvg != 0
 	    && map_flag_gvg2(sd->bl.m)) {
 		status_change_end(&sd->bl, SC_MONSTER_TRANSFORM, INVALID_TIMER);
@@ -11824,7 +11828,7 @@ static void clif_parse_WalkToXY(int fd, struct map_session_data *sd)
 	else if (pc_cant_act_except_npc(sd) || (sd->npc_id != 0 && sd->state.using_megaphone == 0) || pc_isvending(sd))
 		return;
 
-	if(sd->sc.data[SC_RUN] || sd->sc.data[SC_WUGDASH])
+	if(sc_data(&sd->sc, SC_RUN) || sc_data(&sd->sc, SC_WUGDASH))
 		return;
 
 	RFIFOPOS(fd, packet_db[RFIFOW(fd, 0)].pos[0], &x, &y, NULL);
@@ -11870,13 +11874,13 @@ static void clif_parse_QuitGame(int fd, struct map_session_data *sd) __attribute
 static void clif_parse_QuitGame(int fd, struct map_session_data *sd)
 {
 	/* Rovert's prevent logout option fixed [Valaris] */
-	if (!sd->sc.data[SC_CLOAKING]
-		&& !sd->sc.data[SC_HIDING]
-		&& !sd->sc.data[SC_CHASEWALK]
-		&& !sd->sc.data[SC_CLOAKINGEXCEED]
-		&& !sd->sc.data[SC__INVISIBILITY]
-		&& !sd->sc.data[SC_SUHIDE]
-		&& !sd->sc.data[SC_NEWMOON]
+	if (!sc_data(&sd->sc, SC_CLOAKING)
+		&& !sc_data(&sd->sc, SC_HIDING)
+		&& !sc_data(&sd->sc, SC_CHASEWALK)
+		&& !sc_data(&sd->sc, SC_CLOAKINGEXCEED)
+		&& !sc_data(&sd->sc, SC__INVISIBILITY)
+		&& !sc_data(&sd->sc, SC_SUHIDE)
+		&& !sc_data(&sd->sc, SC_NEWMOON)
 		&& (!battle_config.prevent_logout || DIFF_TICK(timer->gettick(), sd->canlog_tick) > battle_config.prevent_logout)
 	) {
 		clif->disconnect_ack(sd, 0);
@@ -12042,7 +12046,7 @@ static void clif_parse_GlobalMessage(int fd, struct map_session_data *sd)
 	logs->chat(LOG_CHAT_GLOBAL, 0, sd->status.char_id, sd->status.account_id, mapindex_id2name(sd->mapindex), sd->bl.x, sd->bl.y, NULL, message);
 
 	// trigger listening npcs
-	map->foreachinrange(npc_chat->sub, &sd->bl, AREA_SIZE, BL_NPC, full_message, strlen(full_message), &sd->bl);
+	npc_chat->message(sd, full_message, (int)strlen(full_message));
 }
 
 static void clif_parse_MapMove(int fd, struct map_session_data *sd) __attribute__((nonnull (2)));
@@ -12169,12 +12173,12 @@ static void clif_parse_ActionRequest_sub(struct map_session_data *sd, enum actio
 	// Statuses that don't let the player sit / attack / talk with NPCs(targeted)
 	// (not all are included in pc_can_attack)
 	if (sd->sc.count && (
-		sd->sc.data[SC_TRICKDEAD] ||
-		(sd->sc.data[SC_AUTOCOUNTER] && action_type != ACT_ATTACK_REPEAT) ||
-		sd->sc.data[SC_BLADESTOP] ||
-		sd->sc.data[SC_DEEP_SLEEP] ||
-		sd->sc.data[SC_SUHIDE] ||
-		sd->sc.data[SC_GRAVITYCONTROL])
+		sc_data(&sd->sc, SC_TRICKDEAD) ||
+		(sc_data(&sd->sc, SC_AUTOCOUNTER) && action_type != ACT_ATTACK_REPEAT) ||
+		sc_data(&sd->sc, SC_BLADESTOP) ||
+		sc_data(&sd->sc, SC_DEEP_SLEEP) ||
+		sc_data(&sd->sc, SC_SUHIDE) ||
+		sc_data(&sd->sc, SC_GRAVITYCONTROL))
 		)
 		return;
 
@@ -12223,7 +12227,7 @@ static void clif_parse_ActionRequest_sub(struct map_session_data *sd, enum actio
 				break;
 			}
 
-			if (sd->sc.data[SC_SITDOWN_FORCE] || sd->sc.data[SC_BANANA_BOMB_SITDOWN_POSTDELAY])
+			if (sc_data(&sd->sc, SC_SITDOWN_FORCE) || sc_data(&sd->sc, SC_BANANA_BOMB_SITDOWN_POSTDELAY))
 				return;
 
 			if(pc_issit(sd)) {
@@ -12239,9 +12243,9 @@ static void clif_parse_ActionRequest_sub(struct map_session_data *sd, enum actio
 				break;
 
 			if (sd->sc.count && (
-				sd->sc.data[SC_DANCING] ||
-				sd->sc.data[SC_ANKLESNARE] ||
-				(sd->sc.data[SC_GRAVITATION] && sd->sc.data[SC_GRAVITATION]->val3 == BCT_SELF)
+				sc_data(&sd->sc, SC_DANCING) ||
+				sc_data(&sd->sc, SC_ANKLESNARE) ||
+				(sc_data(&sd->sc, SC_GRAVITATION) && sc_data(&sd->sc, SC_GRAVITATION)->val3 == BCT_SELF)
 			)) //No sitting during these states either.
 				break;
 
@@ -12253,7 +12257,7 @@ static void clif_parse_ActionRequest_sub(struct map_session_data *sd, enum actio
 		break;
 		case ACT_STAND: // standup
 
-			if (sd->sc.data[SC_SITDOWN_FORCE] || sd->sc.data[SC_BANANA_BOMB_SITDOWN_POSTDELAY])
+			if (sc_data(&sd->sc, SC_SITDOWN_FORCE) || sc_data(&sd->sc, SC_BANANA_BOMB_SITDOWN_POSTDELAY))
 				return;
 
 			if (!pc_issit(sd)) {
@@ -12321,13 +12325,13 @@ static void clif_parse_Restart(int fd, struct map_session_data *sd)
 			break;
 		case 0x01:
 			/* Rovert's Prevent logout option - Fixed [Valaris] */
-			if (!sd->sc.data[SC_CLOAKING]
-				&& !sd->sc.data[SC_HIDING]
-				&& !sd->sc.data[SC_CHASEWALK]
-				&& !sd->sc.data[SC_CLOAKINGEXCEED]
-				&& !sd->sc.data[SC__INVISIBILITY]
-				&& !sd->sc.data[SC_SUHIDE]
-				&& !sd->sc.data[SC_NEWMOON]
+			if (!sc_data(&sd->sc, SC_CLOAKING)
+				&& !sc_data(&sd->sc, SC_HIDING)
+				&& !sc_data(&sd->sc, SC_CHASEWALK)
+				&& !sc_data(&sd->sc, SC_CLOAKINGEXCEED)
+				&& !sc_data(&sd->sc, SC__INVISIBILITY)
+				&& !sc_data(&sd->sc, SC_SUHIDE)
+				&& !sc_data(&sd->sc, SC_NEWMOON)
 				&& (!battle_config.prevent_logout || DIFF_TICK(timer->gettick(), sd->canlog_tick) > battle_config.prevent_logout)
 			) {
 				//Send to char-server for character selection.
@@ -12507,13 +12511,13 @@ static void clif_parse_TakeItem(int fd, struct map_session_data *sd)
 			break;
 
 		if( sd->sc.count && (
-				 sd->sc.data[SC_HIDING] ||
-				 sd->sc.data[SC_CLOAKING] ||
-				 sd->sc.data[SC_TRICKDEAD] ||
-				 sd->sc.data[SC_BLADESTOP] ||
-				 sd->sc.data[SC_CLOAKINGEXCEED] ||
-				 sd->sc.data[SC_SUHIDE] ||
-				 sd->sc.data[SC_NEWMOON] ||
+				 sc_data(&sd->sc, SC_HIDING) ||
+				 sc_data(&sd->sc, SC_CLOAKING) ||
+				 sc_data(&sd->sc, SC_TRICKDEAD) ||
+				 sc_data(&sd->sc, SC_BLADESTOP) ||
+				 sc_data(&sd->sc, SC_CLOAKINGEXCEED) ||
+				 sc_data(&sd->sc, SC_SUHIDE) ||
+				 sc_data(&sd->sc, SC_NEWMOON) ||
 				 pc_ismuted(&sd->sc, MANNER_NOITEM)
 			) )
 			break;
@@ -12548,8 +12552,8 @@ static void clif_parse_DropItem(int fd, struct map_session_data *sd)
 			break;
 
 		if (sd->sc.count && (
-			sd->sc.data[SC_AUTOCOUNTER] ||
-			sd->sc.data[SC_BLADESTOP] ||
+			sc_data(&sd->sc, SC_AUTOCOUNTER) ||
+			sc_data(&sd->sc, SC_BLADESTOP) ||
 			pc_ismuted(&sd->sc, MANNER_NOITEM)
 		))
 			break;
@@ -13248,7 +13252,7 @@ static void clif_parse_RemoveOption(int fd, struct map_session_data *sd)
 		pc->setoption(sd,sd->sc.option&~(OPTION_RIDING|OPTION_FALCON|OPTION_DRAGON|OPTION_MADOGEAR));
 	} else {
 #ifdef NEW_CARTS
-		if (sd->sc.data[SC_PUSH_CART])
+		if (sc_data(&sd->sc, SC_PUSH_CART))
 			pc->setcart(sd,0);
 #else // not NEW_CARTS
 		pc->setoption(sd,sd->sc.option&~OPTION_CART);
@@ -13284,7 +13288,7 @@ static void clif_parse_reqGearOff(int fd, struct map_session_data *sd)
 		break;
 	case REMOVE_MOUNT_CART:
 		// this packet exists in clients with only new carts [4144]
-		if (sd->sc.data[SC_PUSH_CART])
+		if (sc_data(&sd->sc, SC_PUSH_CART))
 			pc->setcart(sd, 0);
 		break;
 	case REMOVE_MOUNT_0:
@@ -13431,7 +13435,7 @@ static void clif_parse_UseSkillToPos_homun(struct homun_data *hd, struct map_ses
 		return;
 	}
 
-	if( hd->sc.data[SC_BASILICA] )
+	if( sc_data(&hd->sc, SC_BASILICA) )
 		return;
 	lv = homun->checkskill(hd, skill_id);
 	if( skill_lv > lv )
@@ -13478,7 +13482,7 @@ static void clif_parse_UseSkillToPos_mercenary(struct mercenary_data *md, struct
 		return;
 	}
 
-	if( md->sc.data[SC_BASILICA] )
+	if( sc_data(&md->sc, SC_BASILICA) )
 		return;
 	lv = mercenary->checkskill(md, skill_id);
 	if( skill_lv > lv )
@@ -13563,9 +13567,9 @@ static void clif_useSkillToIdReal(int fd, struct map_session_data *sd, int skill
 		// Only for combo skills whose prerequisite induced delay
 		if (battle_config.combo_cache_skill
 			&& !skip_combo_check
-			&& sd->sc.data[SC_COMBOATTACK] != NULL
+			&& sc_data(&sd->sc, SC_COMBOATTACK) != NULL
 			&& skill->is_combo(skill_id)
-			&& skill->delay_fix(&sd->bl, sd->sc.data[SC_COMBOATTACK]->val1, pc->checkskill(sd, sd->sc.data[SC_COMBOATTACK]->val1)) > 0
+			&& skill->delay_fix(&sd->bl, sc_data(&sd->sc, SC_COMBOATTACK)->val1, pc->checkskill(sd, sc_data(&sd->sc, SC_COMBOATTACK)->val1)) > 0
 		) {
 			timer->add(sd->ud.canact_tick, clif->combo_delay_timer, sd->bl.id, (intptr_t)MakeDWord((uint16)skill_id, (uint16)skill_lv));
 			return;
@@ -13580,7 +13584,7 @@ static void clif_useSkillToIdReal(int fd, struct map_session_data *sd, int skill
 	if (sd->sc.option & OPTION_COSTUME && sd->auto_cast_current.type != AUTOCAST_ITEM) // Item skills can be used with costumes
 		return;
 
-	if (sd->sc.data[SC_BASILICA] && (skill_id != HP_BASILICA || sd->sc.data[SC_BASILICA]->val4 != sd->bl.id))
+	if (sc_data(&sd->sc, SC_BASILICA) && (skill_id != HP_BASILICA || sc_data(&sd->sc, SC_BASILICA)->val4 != sd->bl.id))
 		return; // On basilica only caster can use Basilica again to stop it.
 
 	if (sd->menuskill_id) {
@@ -13737,7 +13741,7 @@ static void clif_parse_UseSkillToPosSub(int fd, struct map_session_data *sd, uin
 	if( sd->sc.option&OPTION_COSTUME )
 		return;
 
-	if( sd->sc.data[SC_BASILICA] && (skill_id != HP_BASILICA || sd->sc.data[SC_BASILICA]->val4 != sd->bl.id) )
+	if( sc_data(&sd->sc, SC_BASILICA) && (skill_id != HP_BASILICA || sc_data(&sd->sc, SC_BASILICA)->val4 != sd->bl.id) )
 		return; // On basilica only caster can use Basilica again to stop it.
 
 	if( sd->menuskill_id ) {
@@ -17578,15 +17582,15 @@ static void clif_parse_AutoRevive(int fd, struct map_session_data *sd)
 	if (!pc_isdead(sd))
 		return;
 
-	if (sd->sc.data[SC_HELLPOWER]) //Cannot res while under the effect of SC_HELLPOWER.
+	if (sc_data(&sd->sc, SC_HELLPOWER)) //Cannot res while under the effect of SC_HELLPOWER.
 		return;
 
 	int item_position = pc->have_item_chain(sd, ECC_SIEGFRIED);
 	int hpsp = 100;
 
 	if (item_position == INDEX_NOT_FOUND) {
-		if (sd->sc.data[SC_LIGHT_OF_REGENE])
-			hpsp = 20 * sd->sc.data[SC_LIGHT_OF_REGENE]->val1;
+		if (sc_data(&sd->sc, SC_LIGHT_OF_REGENE))
+			hpsp = 20 * sc_data(&sd->sc, SC_LIGHT_OF_REGENE)->val1;
 		else
 			return;
 	}
@@ -22011,8 +22015,8 @@ static int clif_delay_damage(int64 tick, struct block_list *src, struct block_li
 
 	sc = status->get_sc(dst);
 
-	if(sc && sc->count && sc->data[SC_ILLUSION]) {
-		if(in_damage) in_damage = in_damage*(sc->data[SC_ILLUSION]->val2) + rnd()%100;
+	if(sc && sc->count && sc_data(sc, SC_ILLUSION)) {
+		if(in_damage) in_damage = in_damage*(sc_data(sc, SC_ILLUSION)->val2) + rnd()%100;
 	}
 
 #if PACKETVER < 20071113
@@ -26248,6 +26252,7 @@ static int clif_parse(int fd)
 
 	for( pnum = 0; pnum < 3; ++pnum ) { // Limit max packets per cycle to 3 (delay packet spammers) [FlavioJS]  -- This actually aids packet spammers, but stuff like /str+ gets slow without it [Ai4rei]
 		unsigned short (*parse_cmd_func)(int fd, struct map_session_data *sd);
+		uint64 stats_start = 0;
 		// begin main client packet processing loop
 
 		sd = sockt->session[fd]->session_data;
@@ -26347,6 +26352,9 @@ static int clif_parse(int fd)
 			}
 		}
 
+		if (battle_config.packet_stats != PACKET_STATS_OFF)
+			stats_start = clif->packet_stats_begin();
+
 		if( packet_db[cmd].func == clif->pDebug )
 			packet_db[cmd].func(fd, sd);
 		else if( packet_db[cmd].func != NULL ) {
@@ -26390,6 +26398,9 @@ static int clif_parse(int fd)
 #endif
 		}
 
+		if (battle_config.packet_stats != PACKET_STATS_OFF)
+			clif->packet_stats_end(fd, cmd, packet_len, stats_start);
+
 		RFIFOSKIP(fd, packet_len);
 
 	}; // main loop end
@@ -26410,6 +26421,273 @@ static const struct s_packet_db *clif_packet(int packet_id)
 	return &packet_db[packet_id];
 }
 
+/**
+ * Starts accounting a client packet handler.
+ *
+ * @return the counter value to pass to clif->packet_stats_end(), or 0 if the handler isn't timed.
+ */
+static uint64 clif_packet_stats_begin(void)
+{
+	if (battle_config.packet_stats == PACKET_STATS_SAMPLED
+	 && ++clif->packet_stats_sampler % battle_config.packet_stats_sample != 0)
+		return 0;
+	return timer->perf_counter();
+}
+
+/**
+ * Accounts a dispatched client packet to its packet ID and to the session rate.
+ *
+ * @param fd         The session the packet was received from.
+ * @param cmd        The packet ID.
+ * @param packet_len The packet length.
+ * @param start      The value returned by clif->packet_stats_begin().
+ */
+static void clif_packet_stats_end(int fd, int cmd, int packet_len, uint64 start)
+{
+	struct s_packet_stats *ps;
+	struct map_session_data *sd;
+
+	if (clif->packet_stats == NULL || cmd < MIN_PACKET_DB || cmd > MAX_PACKET_DB)
+		return;
+
+	ps = &clif->packet_stats[cmd];
+	ps->count++;
+	ps->bytes += packet_len;
+	if (start != 0) {
+		uint64 elapsed = timer->perf_counter() - start;
+		ps->timed++;
+		ps->time += elapsed;
+		if (elapsed > ps->max_time)
+			ps->max_time = elapsed;
+	}
+
+	// The handler may have attached (login) or detached (logout) the session data.
+	if (sockt->session_is_valid(fd) && (sd = sockt->session[fd]->session_data) != NULL)
+		clif->packet_rate_add(&sd->packet_rate, packet_len, timer->gettick());
+}
+
+/**
+ * Returns the histogram bucket of a packet rate.
+ *
+ * @param rate Packets received in one second (> 0).
+ * @return the bucket index.
+ */
+static int clif_packet_rate_bucket(int rate)
+{
+	int bucket = 0;
+
+	while (rate > 1 && bucket < PACKET_RATE_BUCKETS - 1) {
+		rate >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+/**
+ * Accounts a packet to a session's rate, closing the current one second
+ * window into the histogram when it has elapsed.
+ *
+ * @param rate       The session rate.
+ * @param packet_len The packet length.
+ * @param tick       The current tick.
+ */
+static void clif_packet_rate_add(struct s_packet_rate *rate, int packet_len, int64 tick)
+{
+	nullpo_retv(rate);
+
+	if (DIFF_TICK(tick, rate->window_tick) >= 1000) {
+		if (rate->window_count > 0)
+			rate->histogram[clif->packet_rate_bucket(rate->window_count)]++;
+		rate->window_tick = tick;
+		rate->window_count = 0;
+	}
+
+	rate->window_count++;
+	if (rate->window_count > rate->peak)
+		rate->peak = rate->window_count;
+	rate->count++;
+	rate->bytes += packet_len;
+}
+
+/**
+ * Clears the packet statistics and the rate of every online session.
+ */
+static void clif_packet_stats_reset(void)
+{
+	struct s_mapiterator *iter;
+	struct map_session_data *sd;
+
+	if (clif->packet_stats != NULL)
+		memset(clif->packet_stats, 0, (MAX_PACKET_DB + 1) * sizeof(*clif->packet_stats));
+	clif->packet_stats_since = timer->gettick();
+
+	iter = mapit_getallusers();
+	for (sd = BL_UCAST(BL_PC, mapit->first(iter)); mapit->exists(iter); sd = BL_UCAST(BL_PC, mapit->next(iter)))
+		memset(&sd->packet_rate, 0, sizeof(sd->packet_rate));
+	mapit->free(iter);
+}
+
+/**
+ * Returns the packet IDs with the highest statistics.
+ *
+ * @param[out] ids The packet IDs, in descending order.
+ * @param max      The size of ids.
+ * @param sort     The statistic to order by.
+ * @return the amount of IDs written.
+ */
+static int clif_packet_stats_top(int *ids, int max, enum packet_stats_sort sort)
+{
+	int cmd, count = 0;
+
+	nullpo_ret(ids);
+
+	if (clif->packet_stats == NULL)
+		return 0;
+
+	for (cmd = MIN_PACKET_DB; cmd <= MAX_PACKET_DB; cmd++) {
+		const struct s_packet_stats *ps = &clif->packet_stats[cmd];
+		uint64 value;
+		int i;
+
+		if (ps->count == 0)
+			continue;
+
+		switch (sort) {
+		case PACKET_STATS_SORT_BYTES: value = ps->bytes; break;
+		case PACKET_STATS_SORT_TIME:  value = ps->time; break;
+		case PACKET_STATS_SORT_COUNT:
+		default:                      value = ps->count; break;
+		}
+
+		// insertion into the (small) sorted top list
+		for (i = count; i > 0; i--) {
+			const struct s_packet_stats *other = &clif->packet_stats[ids[i - 1]];
+			uint64 other_value = sort == PACKET_STATS_SORT_BYTES ? other->bytes : sort == PACKET_STATS_SORT_TIME ? other->time : other->count;
+			if (other_value >= value)
+				break;
+			if (i < max)
+				ids[i] = ids[i - 1];
+		}
+		if (i < max) {
+			ids[i] = cmd;
+			if (count < max)
+				count++;
+		}
+	}
+	return count;
+}
+
+/**
+ * Returns the online sessions with the highest peak packet rate.
+ *
+ * @param[out] list The sessions, in descending order.
+ * @param max       The size of list.
+ * @return the amount of sessions written.
+ */
+static int clif_packet_rate_top(struct map_session_data **list, int max)
+{
+	struct s_mapiterator *iter;
+	struct map_session_data *sd;
+	int count = 0;
+
+	nullpo_ret(list);
+
+	iter = mapit_getallusers();
+	for (sd = BL_UCAST(BL_PC, mapit->first(iter)); mapit->exists(iter); sd = BL_UCAST(BL_PC, mapit->next(iter))) {
+		int i;
+
+		if (sd->packet_rate.count == 0)
+			continue;
+
+		for (i = count; i > 0 && list[i - 1]->packet_rate.peak < sd->packet_rate.peak; i--) {
+			if (i < max)
+				list[i] = list[i - 1];
+		}
+		if (i < max) {
+			list[i] = sd;
+			if (count < max)
+				count++;
+		}
+	}
+	mapit->free(iter);
+
+	return count;
+}
+
+/**
+ * Appends the packet statistics to a file.
+ *
+ * @param filename The file to append to.
+ * @return success status.
+ */
+static bool clif_packet_stats_dump(const char *filename)
+{
+	struct map_session_data *top_sd[20];
+	int ids[MAX_PACKET_DB - MIN_PACKET_DB + 1];
+	double frequency = (double)timer->perf_frequency();
+	char timestring[64];
+	time_t now = time(NULL);
+	FILE *fp;
+	int i, j, count;
+
+	nullpo_retr(false, filename);
+
+	if ((fp = fopen(filename, "a")) == NULL) {
+		ShowError("clif_packet_stats_dump: Unable to open '%s' for writing.\n", filename);
+		return false;
+	}
+
+	strftime(timestring, sizeof(timestring), "%Y-%m-%d %H:%M:%S", localtime(&now));
+	fprintf(fp, "=== %s, mode %d, %"PRId64" seconds of data ===\n", timestring, battle_config.packet_stats,
+	        (int64)(DIFF_TICK(timer->gettick(), clif->packet_stats_since) / 1000));
+	fprintf(fp, "%-8s %12s %14s %12s %12s %10s %10s\n", "Packet", "Count", "Bytes", "Timed", "Time (ms)", "Avg (us)", "Max (us)");
+
+	count = clif->packet_stats_top(ids, ARRAYLENGTH(ids), PACKET_STATS_SORT_TIME);
+	for (i = 0; i < count; i++) {
+		const struct s_packet_stats *ps = &clif->packet_stats[ids[i]];
+
+		fprintf(fp, "0x%04X   %12"PRIu64" %14"PRIu64" %12"PRIu64" %12.2f %10.1f %10.1f\n",
+		        (unsigned int)ids[i], ps->count, ps->bytes, ps->timed,
+		        (double)ps->time * 1000 / frequency,
+		        ps->timed > 0 ? (double)ps->time * 1000000 / frequency / ps->timed : 0.,
+		        (double)ps->max_time * 1000000 / frequency);
+	}
+
+	count = clif->packet_rate_top(top_sd, ARRAYLENGTH(top_sd));
+	if (count > 0) {
+		fprintf(fp, "%-24s %8s %8s %12s %14s  %s\n", "Character", "AID", "Peak/s", "Count", "Bytes", "Seconds at 1,2,4..512+ packets/s");
+		for (i = 0; i < count; i++) {
+			const struct s_packet_rate *rate = &top_sd[i]->packet_rate;
+
+			fprintf(fp, "%-24s %8d %8d %12"PRIu64" %14"PRIu64" ", top_sd[i]->status.name, top_sd[i]->status.account_id,
+			        rate->peak, rate->count, rate->bytes);
+			for (j = 0; j < PACKET_RATE_BUCKETS; j++)
+				fprintf(fp, " %u", rate->histogram[j]);
+			fprintf(fp, "\n");
+		}
+	}
+	fprintf(fp, "\n");
+	fclose(fp);
+
+	return true;
+}
+
+/**
+ * Periodically appends the packet statistics to PACKET_STATS_FILE.
+ */
+static int clif_packet_stats_timer(int tid, int64 tick, int id, intptr_t data)
+{
+	if (battle_config.packet_stats == PACKET_STATS_OFF || battle_config.packet_stats_dump_interval == 0)
+		return 0;
+
+	if (DIFF_TICK(tick, clif->packet_stats_last_dump) < (int64)battle_config.packet_stats_dump_interval * 1000)
+		return 0;
+
+	clif->packet_stats_last_dump = tick;
+	clif->packet_stats_dump(PACKET_STATS_FILE);
+	return 0;
+}
+
 static void __attribute__ ((unused)) packetdb_addpacket(int cmd, ...)
 {
 	va_list va;
@@ -26521,6 +26799,11 @@ static int do_init_clif(bool minimal)
 	timer->add_func_list(clif->clearunit_delayed_sub, "clif_clearunit_delayed_sub");
 	timer->add_func_list(clif->delayquit, "clif_delayquit");
 
+	CREATE(clif->packet_stats, struct s_packet_stats, MAX_PACKET_DB + 1);
+	clif->packet_stats_since = clif->packet_stats_last_dump = timer->gettick();
+	timer->add_func_list(clif->packet_stats_timer, "clif_packet_stats_timer");
+	timer->add_interval(timer->gettick() + 1000, clif->packet_stats_timer, 0, 0, 1000);
+
 	clif->delay_clearunit_ers = ers_new(sizeof(struct mob_data), "clif.c::delay_clearunit_ers", ERS_OPT_CLEAR);
 	clif->delayed_damage_ers = ers_new(sizeof(struct cdelayed_damage),"clif.c::delayed_damage_ers",ERS_OPT_CLEAR);
 
@@ -26540,6 +26823,11 @@ static void do_final_clif(void)
 	ers_destroy(clif->delay_clearunit_ers);
 	ers_destroy(clif->delayed_damage_ers);
 
+	if (clif->packet_stats != NULL) {
+		aFree(clif->packet_stats);
+		clif->packet_stats = NULL;
+	}
+
 	for(i = 0; i < CASHSHOP_TAB_MAX; i++) {
 		int k;
 		for( k = 0; k < clif->cs.item_count[i]; k++ ) {
@@ -26566,6 +26854,10 @@ void clif_defaults(void)
 	clif->ally_only = false;
 	clif->delayed_damage_ers = NULL;
 	clif->cmd = -1;
+	clif->packet_stats = NULL;
+	clif->packet_stats_sampler = 0;
+	clif->packet_stats_since = 0;
+	clif->packet_stats_last_dump = 0;
 	/* core */
 	clif->init = do_init_clif;
 	clif->final = do_final_clif;
@@ -26580,6 +26872,15 @@ void clif_defaults(void)
 	clif->parse_cmd = clif_parse_cmd_optional;
 	clif->decrypt_cmd = clif_decrypt_cmd;
 	clif->packet = clif_packet;
+	clif->packet_stats_begin = clif_packet_stats_begin;
+	clif->packet_stats_end = clif_packet_stats_end;
+	clif->packet_rate_add = clif_packet_rate_add;
+	clif->packet_rate_bucket = clif_packet_rate_bucket;
+	clif->packet_stats_reset = clif_packet_stats_reset;
+	clif->packet_stats_top = clif_packet_stats_top;
+	clif->packet_rate_top = clif_packet_rate_top;
+	clif->packet_stats_dump = clif_packet_stats_dump;
+	clif->packet_stats_timer = clif_packet_stats_timer;
 	/* auth */
 	clif->authok = clif_authok;
 	clif->auth_error = clif_auth_error;
@@ -50,6 +50,7 @@ struct party_booking_ad_info;
 struct party_data;
 struct pet_data;
 struct quest;
+struct s_packet_rate;
 struct s_vending;
 struct skill_cd;
 struct skill_unit;
@@ -743,6 +744,36 @@ struct s_packet_db {
 	short pos[MAX_PACKET_POS];
 };
 
+/// File the packet statistics are periodically appended to.
+#define PACKET_STATS_FILE "log/packet_stats.log"
+
+/**
+ * Packet statistics modes (battle_config.packet_stats)
+ **/
+enum packet_stats_mode {
+	PACKET_STATS_OFF     = 0, ///< No accounting.
+	PACKET_STATS_FULL    = 1, ///< Count every packet and time every handler.
+	PACKET_STATS_SAMPLED = 2, ///< Count every packet, time one handler out of battle_config.packet_stats_sample.
+};
+
+/**
+ * Packet statistics ordering, used for reports.
+ **/
+enum packet_stats_sort {
+	PACKET_STATS_SORT_COUNT,
+	PACKET_STATS_SORT_BYTES,
+	PACKET_STATS_SORT_TIME,
+};
+
+/// Receive/dispatch statistics of a client packet ID.
+struct s_packet_stats {
+	uint64 count;    ///< Packets received.
+	uint64 bytes;    ///< Bytes received.
+	uint64 timed;    ///< Packets whose handler was timed.
+	uint64 time;     ///< Cumulative handler time of the timed packets, in timer->perf_counter() units.
+	uint64 max_time; ///< Longest handler time, in timer->perf_counter() units.
+};
+
 struct hCSData {
 	int id;
 	unsigned int price;
@@ -949,6 +980,11 @@ struct clif_interface {
 	struct eri *delayed_damage_ers;
 	/* */
 	VECTOR_DECL(struct attendance_entry) attendance_data;
+	/* packet statistics, indexed by packet ID */
+	struct s_packet_stats *packet_stats;
+	uint64 packet_stats_sampler;
+	int64 packet_stats_since;
+	int64 packet_stats_last_dump;
 	/* core */
 	int (*init) (bool minimal);
 	void (*final) (void);
@@ -961,6 +997,15 @@ struct clif_interface {
 	int (*send_actual) (int fd, void *buf, int len);
 	int (*parse) (int fd);
 	const struct s_packet_db *(*packet) (int packet_id);
+	uint64 (*packet_stats_begin) (void);
+	void (*packet_stats_end) (int fd, int cmd, int packet_len, uint64 start);
+	void (*packet_rate_add) (struct s_packet_rate *rate, int packet_len, int64 tick);
+	int (*packet_rate_bucket) (int rate);
+	void (*packet_stats_reset) (void);
+	int (*packet_stats_top) (int *ids, int max, enum packet_stats_sort sort);
+	int (*packet_rate_top) (struct map_session_data **list, int max);
+	bool (*packet_stats_dump) (const char *filename);
+	int (*packet_stats_timer) (int tid, int64 tick, int id, intptr_t data);
 	unsigned short (*parse_cmd) ( int fd, struct map_session_data *sd );
 	unsigned short (*decrypt_cmd) ( int cmd, struct map_session_data *sd );
 	/* client-specific logic */
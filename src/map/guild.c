@@ -449,10 +449,148 @@ static int guild_send_xy_timer_sub(union DBKey key, struct DBData *data, va_list
 	return 0;
 }
 
-//Code from party_send_xy_timer [Skotlex]
+/**
+ * Queues a guild member for the next position update.
+ *
+ * Called when the player moves, so that guild->send_xy_timer only looks at
+ * the members that changed.
+ *
+ * @param sd The player.
+ */
+static void guild_xy_mark(struct map_session_data *sd)
+{
+	nullpo_retv(sd);
+
+	if (sd->status.guild_id == 0 || sd->state.guild_xy_dirty)
+		return;
+
+	sd->state.guild_xy_dirty = 1;
+	VECTOR_ENSURE(guild->xy_dirty, 1, 64);
+	VECTOR_PUSH(guild->xy_dirty, sd->bl.id);
+}
+
+/**
+ * Queues every online member of a guild for a position update.
+ *
+ * Used when the member list changes, so that the members see the
+ * positions of the mates that don't move.
+ *
+ * @param g The guild.
+ */
+static void guild_send_xy_clear(struct guild *g)
+{
+	nullpo_retv(g);
+
+	for (int i = 0; i < g->max_member; i++) {
+		struct map_session_data *sd = g->member[i].sd;
+
+		if (sd == NULL)
+			continue;
+		sd->guild_x = -1;
+		sd->guild_y = -1;
+		guild->xy_mark(sd);
+	}
+}
+
+/// Orders queued members by guild.
+static int guild_xy_entry_cmp(const void *a, const void *b)
+{
+	const struct guild_xy_entry *ea = a, *eb = b;
+
+	if (ea->guild_id != eb->guild_id)
+		return ea->guild_id < eb->guild_id ? -1 : 1;
+	return 0;
+}
+
+/**
+ * Sends the positions of the queued members of a guild.
+ *
+ * Each member on the same map as a moved mate receives all the new
+ * positions in a row, instead of one broadcast per moved member.
+ *
+ * @param g       The guild.
+ * @param entries The queued members of the guild (reordered).
+ * @param count   The amount of entries.
+ */
+static void guild_send_xy_batch(struct guild *g, struct guild_xy_entry *entries, int count)
+{
+	int moved = 0;
+
+	nullpo_retv(g);
+	nullpo_retv(entries);
+
+	for (int k = 0; k < count; k++) {
+		struct map_session_data *sd = entries[k].sd;
+
+		if (sd->fd == 0 || (sd->guild_x == sd->bl.x && sd->guild_y == sd->bl.y))
+			continue;
+		sd->guild_x = sd->bl.x;
+		sd->guild_y = sd->bl.y;
+		entries[moved++].sd = sd; // Keep the moved members at the front
+	}
+
+	if (moved == 0)
+		return;
+
+	if (map->enable_spy) {
+		// Guild spies only receive the broadcast packets
+		for (int k = 0; k < moved; k++)
+			clif->guild_xy(entries[k].sd);
+		return;
+	}
+
+	for (int i = 0; i < g->max_member; i++) {
+		struct map_session_data *tsd = g->member[i].sd;
+
+		if (tsd == NULL || tsd->fd == 0)
+			continue;
+
+		for (int k = 0; k < moved; k++) {
+			if (entries[k].sd != tsd && entries[k].sd->bl.m == tsd->bl.m)
+				clif->guild_xy_single(tsd->fd, entries[k].sd);
+		}
+	}
+}
+
+/**
+ * Sends the position updates of the guild members queued by guild->xy_mark.
+ */
 static int guild_send_xy_timer(int tid, int64 tick, int id, intptr_t data)
 {
-	guild->db->foreach(guild->db,guild->send_xy_timer_sub,tick);
+	int count;
+
+	if (VECTOR_LENGTH(guild->xy_dirty) == 0)
+		return 0;
+
+	VECTOR_TRUNCATE(guild->xy_batch);
+	VECTOR_ENSURE(guild->xy_batch, VECTOR_LENGTH(guild->xy_dirty), 64);
+	for (int k = 0; k < VECTOR_LENGTH(guild->xy_dirty); k++) {
+		struct map_session_data *sd = map->id2sd(VECTOR_INDEX(guild->xy_dirty, k));
+
+		if (sd == NULL)
+			continue;
+		sd->state.guild_xy_dirty = 0;
+		if (sd->status.guild_id == 0 || sd->guild == NULL || sd->bg_id != 0)
+			continue;
+
+		VECTOR_PUSHZEROED(guild->xy_batch);
+		VECTOR_LAST(guild->xy_batch).guild_id = sd->status.guild_id;
+		VECTOR_LAST(guild->xy_batch).sd = sd;
+	}
+	VECTOR_TRUNCATE(guild->xy_dirty);
+	count = VECTOR_LENGTH(guild->xy_batch);
+
+	qsort(VECTOR_DATA(guild->xy_batch), count, sizeof(struct guild_xy_entry), guild->xy_entry_cmp);
+	for (int start = 0, end; start < count; start = end) {
+		int guild_id = VECTOR_INDEX(guild->xy_batch, start).guild_id;
+		struct guild *g = guild->search(guild_id);
+
+		for (end = start + 1; end < count && VECTOR_INDEX(guild->xy_batch, end).guild_id == guild_id; end++)
+			;
+		if (g != NULL)
+			guild->send_xy_batch(g, &VECTOR_INDEX(guild->xy_batch, start), end - start);
+	}
+
 	return 0;
 }
 
@@ -687,14 +825,25 @@ static int guild_recv_info(const struct guild *sg, struct fifo_chunk_buf *emblem
 	g->instance = instance_save;
 	g->instances = instances_save;
 
-	if (emblem_buf == NULL) {
+	// The emblem is resolved by hash, sg->emblem_data is meaningless here.
+	if (guild_new) {
 		g->emblem_data = NULL;
 		g->emblem_len = 0;
+		g->emblem_hash = 0;
 	} else {
-		if (!guild_new)
-			aFree(before.emblem_data);
-		g->emblem_data = aMalloc(emblem_buf->data_size);
-		memcpy(g->emblem_data, emblem_buf->data, emblem_buf->data_size);
+		g->emblem_data = before.emblem_data;
+		g->emblem_len = before.emblem_len;
+		g->emblem_hash = before.emblem_hash;
+	}
+
+	if (emblem_buf != NULL) {
+		guild->emblem_set(g, emblem_buf->data, (int)emblem_buf->data_size);
+	} else if (sg->emblem_len <= 0) {
+		guild->emblem_release(g);
+	} else if (!guild->emblem_attach(g, sg->emblem_hash)) {
+		// Not stored yet, members get it once it arrives (guild->emblem_recv)
+		guild->emblem_release(g);
+		intif->guild_emblem_request(g->guild_id, sg->emblem_hash);
 	}
 
 	if(g->max_member > MAX_GUILD) {
@@ -738,6 +887,8 @@ static int guild_recv_info(const struct guild *sg, struct fifo_chunk_buf *emblem
 		}
 	}
 
+	guild->send_xy_clear(g);
+
 	//Occurrence of an event
 	if (guild->infoevent_db->remove(guild->infoevent_db, DB->i2key(sg->guild_id), &data)) {
 		struct eventlist *ev = DB->data2ptr(&data), *ev2;
@@ -944,6 +1095,12 @@ static int guild_member_added(int guild_id, int account_id, int char_id, int fla
 	clif->guild_belonginfo(sd,g);
 	clif->guild_notice(sd,g);
 
+	// Exchange the positions of the new member and the online mates
+	guild->send_xy_clear(g);
+	sd->guild_x = -1;
+	sd->guild_y = -1;
+	guild->xy_mark(sd);
+
 	//TODO: send new emblem info to others
 
 	if( sd2!=NULL )
@@ -1367,10 +1524,7 @@ static int guild_emblem_changed(int len, int guild_id, int emblem_id, const char
 	if(g==NULL)
 		return 0;
 
-	if (len > g->emblem_len)
-		g->emblem_data = aReallocz(g->emblem_data, len);
-	memcpy(g->emblem_data, data, len);
-	g->emblem_len = len;
+	guild->emblem_set(g, data, len);
 	g->emblem_id = emblem_id;
 
 	for(i=0;i<g->max_member;i++){
@@ -1417,6 +1571,133 @@ static int guild_emblem_changed(int len, int guild_id, int emblem_id, const char
 	return 0;
 }
 
+/**
+ * Receives a guild emblem that was requested from the char-server.
+ *
+ * @param guild_id  The guild ID.
+ * @param emblem_id The emblem ID the data belongs to.
+ * @param data      The emblem data.
+ * @param len       The length of the emblem data.
+ */
+static void guild_emblem_recv(int guild_id, int emblem_id, const char *data, int len)
+{
+	struct guild *g = guild->search(guild_id);
+	int i;
+
+	nullpo_retv(data);
+	if (g == NULL || g->emblem_id != emblem_id) // Replaced in the meantime
+		return;
+
+	guild->emblem_set(g, data, len);
+
+	for (i = 0; i < g->max_member; i++) {
+		struct map_session_data *sd = g->member[i].sd;
+		if (sd != NULL)
+			clif->guild_emblem(sd, g);
+	}
+}
+
+/**
+ * Sets the emblem of a guild, storing the data if no other guild uses the same image.
+ *
+ * Emblems are keyed by hash_fnv1a64(), which isn't collision resistant, so the
+ * data is compared before sharing a stored emblem. An image whose hash collides
+ * with a different stored one is kept unshared by this guild.
+ *
+ * @param g    The guild.
+ * @param data The emblem data.
+ * @param len  The length of the emblem data (0 removes the emblem).
+ */
+static void guild_emblem_set(struct guild *g, const char *data, int len)
+{
+	struct guild_emblem *e;
+	uint64 hash;
+
+	nullpo_retv(g);
+
+	if (data == NULL || len <= 0) {
+		guild->emblem_release(g);
+		return;
+	}
+
+	hash = hash_fnv1a64(data, len);
+	if ((e = ui64db_get(guild->emblem_db, hash)) != NULL && e->len == len && memcmp(e->data, data, len) == 0) {
+		guild->emblem_attach(g, hash);
+		return;
+	}
+
+	guild->emblem_release(g);
+
+	e = aMalloc(sizeof(*e) + len);
+	e->hash = hash;
+	e->refcount = 0;
+	e->len = len;
+	memcpy(e->data, data, len);
+
+	if (ui64db_exists(guild->emblem_db, hash)) {
+		// Hash collision with another guild's emblem
+		e->refcount = 1;
+		g->emblem_data = e->data;
+		g->emblem_len = e->len;
+		g->emblem_hash = e->hash;
+		return;
+	}
+
+	ui64db_put(guild->emblem_db, hash, e);
+	guild->emblem_attach(g, hash);
+}
+
+/**
+ * Makes a guild use a stored emblem.
+ *
+ * @param g    The guild.
+ * @param hash The content hash of the emblem.
+ * @return false if no emblem with that hash is stored.
+ */
+static bool guild_emblem_attach(struct guild *g, uint64 hash)
+{
+	struct guild_emblem *e;
+
+	nullpo_retr(false, g);
+
+	if ((e = ui64db_get(guild->emblem_db, hash)) == NULL)
+		return false;
+	if (g->emblem_data == e->data)
+		return true;
+
+	guild->emblem_release(g);
+	e->refcount++;
+	g->emblem_data = e->data;
+	g->emblem_len = e->len;
+	g->emblem_hash = e->hash;
+	return true;
+}
+
+/**
+ * Detaches the emblem of a guild, freeing it when no other guild uses it.
+ *
+ * @param g The guild.
+ */
+static void guild_emblem_release(struct guild *g)
+{
+	nullpo_retv(g);
+
+	if (g->emblem_data != NULL) {
+		struct guild_emblem *e = (struct guild_emblem *)(g->emblem_data - offsetof(struct guild_emblem, data));
+
+		if (--e->refcount <= 0) {
+			if (ui64db_get(guild->emblem_db, e->hash) == e)
+				ui64db_remove(guild->emblem_db, e->hash); // DB_OPT_RELEASE_DATA frees it
+			else
+				aFree(e); // unshared, see guild_emblem_set
+		}
+	}
+
+	g->emblem_data = NULL;
+	g->emblem_len = 0;
+	g->emblem_hash = 0;
+}
+
 /**
  * @see DBCreateData
  */
@@ -1560,7 +1841,7 @@ static void guild_guildaura_refresh(struct map_session_data *sd, uint16 skill_id
 		return;
 	if( !skill_lv )
 		return;
-	if (sd->sc.data[type] && (group = skill->id2group(sd->sc.data[type]->val4)) != NULL) {
+	if (sc_data(&sd->sc, type) && (group = skill->id2group(sc_data(&sd->sc, type)->val4)) != NULL) {
 		skill->del_unitgroup(group);
 		status_change_end(&sd->bl,type,INVALID_TIMER);
 	}
@@ -1977,7 +2258,7 @@ static int guild_broken(int guild_id, int flag)
 
 	HPM->data_store_destroy(&g->hdata);
 
-	aFree(g->emblem_data);
+	guild->emblem_release(g);
 	idb_remove(guild->db,guild_id);
 	return 0;
 }
@@ -2456,7 +2737,7 @@ static int guild_castle_db_final(union DBKey key, struct DBData *data, va_list a
 static int guild_db_final(union DBKey key, struct DBData *data, va_list ap)
 {
 	struct guild* g = DB->data2ptr(data);
-	aFree(g->emblem_data);
+	guild->emblem_release(g);
 	return 0;
 }
 
@@ -2481,7 +2762,10 @@ static void do_init_guild(bool minimal)
 	guild->castle_db    = idb_alloc(DB_OPT_BASE);
 	guild->expcache_db  = idb_alloc(DB_OPT_BASE);
 	guild->infoevent_db = idb_alloc(DB_OPT_BASE);
+	guild->emblem_db    = ui64db_alloc(DB_OPT_RELEASE_DATA);
 	guild->expcache_ers = ers_new(sizeof(struct guild_expcache),"guild.c::expcache_ers",ERS_OPT_NONE);
+	VECTOR_INIT(guild->xy_dirty);
+	VECTOR_INIT(guild->xy_batch);
 
 	guild->read_castledb_libconfig();
 	sv->readdb(map->db_path, "guild_skill_tree.txt", ',', 2+MAX_GUILD_SKILL_REQUIRE*2, 2+MAX_GUILD_SKILL_REQUIRE*2, -1, guild->read_guildskill_tree_db); //guild skill tree [Komurka]
@@ -2513,7 +2797,10 @@ static void do_final_guild(void)
 	guild->castle_db->destroy(guild->castle_db,guild->castle_db_final);
 	guild->expcache_db->destroy(guild->expcache_db,guild->expcache_db_final);
 	guild->infoevent_db->destroy(guild->infoevent_db,guild->eventlist_db_final);
+	db_destroy(guild->emblem_db);
 	ers_destroy(guild->expcache_ers);
+	VECTOR_CLEAR(guild->xy_dirty);
+	VECTOR_CLEAR(guild->xy_batch);
 
 	if( guild->flags )
 		aFree(guild->flags);
@@ -2530,6 +2817,7 @@ void guild_defaults(void)
 	guild->castle_db = NULL;
 	guild->expcache_db = NULL;
 	guild->infoevent_db = NULL;
+	guild->emblem_db = NULL;
 	/* */
 	guild->expcache_ers = NULL;
 	/* */
@@ -2590,6 +2878,10 @@ void guild_defaults(void)
 	guild->notice_changed = guild_notice_changed;
 	guild->change_emblem = guild_change_emblem;
 	guild->emblem_changed = guild_emblem_changed;
+	guild->emblem_recv = guild_emblem_recv;
+	guild->emblem_set = guild_emblem_set;
+	guild->emblem_attach = guild_emblem_attach;
+	guild->emblem_release = guild_emblem_release;
 	guild->send_message = guild_send_message;
 	guild->send_dot_remove = guild_send_dot_remove;
 	guild->skillupack = guild_skillupack;
@@ -2623,6 +2915,10 @@ void guild_defaults(void)
 	guild->payexp_timer_sub = guild_payexp_timer_sub;
 	guild->send_xy_timer_sub = guild_send_xy_timer_sub;
 	guild->send_xy_timer = guild_send_xy_timer;
+	guild->xy_mark = guild_xy_mark;
+	guild->send_xy_clear = guild_send_xy_clear;
+	guild->xy_entry_cmp = guild_xy_entry_cmp;
+	guild->send_xy_batch = guild_send_xy_batch;
 	guild->create_expcache = create_expcache;
 	guild->eventlist_db_final = eventlist_db_final;
 	guild->expcache_db_final = guild_expcache_db_final;
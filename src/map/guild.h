@@ -68,6 +68,25 @@ struct s_guild_skill_tree {
 };
 
 
+/**
+ * A guild emblem, addressed by the hash of its contents.
+ *
+ * Guilds using the same image share a single copy, and the char-server is
+ * only asked for emblems that aren't stored yet.
+ **/
+struct guild_emblem {
+	uint64 hash;  ///< Content hash, see hash_fnv1a64().
+	int refcount; ///< Amount of guilds using the emblem.
+	int len;      ///< Length of the emblem data.
+	char data[];  ///< Emblem data.
+};
+
+/// A queued guild member, grouped by guild when the updates are sent.
+struct guild_xy_entry {
+	int guild_id;
+	struct map_session_data *sd;
+};
+
 struct guild_interface {
 	void (*init) (bool minimal);
 	void (*final) (void);
@@ -76,8 +95,11 @@ struct guild_interface {
 	struct DBMap *castle_db; // int castle_id -> struct guild_castle*
 	struct DBMap *expcache_db; // int char_id -> struct guild_expcache*
 	struct DBMap *infoevent_db; // int guild_id -> struct eventlist*
+	struct DBMap *emblem_db; // uint64 hash -> struct guild_emblem*
 	/* */
 	struct eri *expcache_ers; //For handling of guild exp payment.
+	VECTOR_DECL(int) xy_dirty; ///< Account IDs of the members that moved since the last update.
+	VECTOR_DECL(struct guild_xy_entry) xy_batch; ///< Work buffer of send_xy_timer.
 	/* */
 	struct s_guild_skill_tree skill_tree[MAX_GUILDSKILL];
 	/* guild flags cache */
@@ -136,6 +158,10 @@ struct guild_interface {
 	int (*notice_changed) (int guild_id,const char *mes1,const char *mes2);
 	int (*change_emblem) (struct map_session_data *sd,int len,const char *data);
 	int (*emblem_changed) (int len,int guild_id,int emblem_id,const char *data);
+	void (*emblem_recv) (int guild_id, int emblem_id, const char *data, int len);
+	void (*emblem_set) (struct guild *g, const char *data, int len);
+	bool (*emblem_attach) (struct guild *g, uint64 hash);
+	void (*emblem_release) (struct guild *g);
 	int (*send_message) (struct map_session_data *sd, const char *mes);
 	int (*send_dot_remove) (struct map_session_data *sd);
 	int (*skillupack) (int guild_id,uint16 skill_id,int account_id);
@@ -171,6 +197,10 @@ struct guild_interface {
 	int (*payexp_timer_sub) (union DBKey key, struct DBData *data, va_list ap);
 	int (*send_xy_timer_sub) (union DBKey key, struct DBData *data, va_list ap);
 	int (*send_xy_timer) (int tid, int64 tick, int id, intptr_t data);
+	void (*xy_mark) (struct map_session_data *sd);
+	void (*send_xy_clear) (struct guild *g);
+	int (*xy_entry_cmp) (const void *a, const void *b);
+	void (*send_xy_batch) (struct guild *g, struct guild_xy_entry *entries, int count);
 	struct DBData (*create_expcache) (union DBKey key, va_list args);
 	int (*eventlist_db_final) (union DBKey key, struct DBData *data, va_list ap);
 	int (*expcache_db_final) (union DBKey key, struct DBData *data, va_list ap);
@@ -306,10 +306,11 @@ static int intif_request_registry(struct map_session_data *sd, int flag)
 
 /**
  * Request the inter-server for a character's storage data.
- * @packet 0x3010  [out] <account_id>.L
+ * @packet 0x3010  [out] <account_id>.L <flag>.B
  * @param  sd      [in]  pointer to session data.
+ * @param  flag    [in]  options passed back with the storage pages (STORAGE_PAGE_OPEN).
  */
-static void intif_request_account_storage(const struct map_session_data *sd)
+static void intif_request_account_storage(struct map_session_data *sd, int flag)
 {
 	nullpo_retv(sd);
 
@@ -317,61 +318,88 @@ static void intif_request_account_storage(const struct map_session_data *sd)
 	if (intif->CheckForCharServer())
 		return;
 
-	WFIFOHEAD(inter_fd, 6);
+	WFIFOHEAD(inter_fd, 7);
 	WFIFOW(inter_fd, 0) = 0x3010;
 	WFIFOL(inter_fd, 2) = sd->status.account_id;
-	WFIFOSET(inter_fd, 6);
+	WFIFOB(inter_fd, 6) = flag & STORAGE_PAGE_OPEN;
+	WFIFOSET(inter_fd, 7);
+
+	sd->storage.requested = true;
 }
 
 /**
- * Parse the reception of account storage from the inter-server.
- * @packet 0x3805 [in] <packet_len>.W <account_id>.L <struct item[]>.P
+ * Parse the reception of a page of account storage from the inter-server.
+ *
+ * The storage is marked as received once its last page arrives.
+ *
+ * @packet 0x3805 [in] <packet_len>.W <account_id>.L <flag>.B <struct item[]>.P
  * @param  fd     [in] file/socket descriptor.
  */
 static void intif_parse_account_storage(int fd)
 {
-	int account_id = 0, payload_size = 0, storage_count = 0;
+	int account_id = 0, payload_size = 0, storage_count = 0, flag = 0;
 	int i = 0;
 	struct map_session_data *sd = NULL;
 
 	Assert_retv(fd > 0);
 
-	payload_size = RFIFOW(fd, 2) - 8;
+	payload_size = RFIFOW(fd, 2) - 9;
+	flag = RFIFOB(fd, 8);
 
 	if ((account_id = RFIFOL(fd, 4)) == 0 || (sd = map->id2sd(account_id)) == NULL) {
-		ShowError("intif_parse_account_storage: Session pointer was null for account id %d!\n", account_id);
+		if ((flag & STORAGE_PAGE_FIRST) != 0)
+			ShowError("intif_parse_account_storage: Session pointer was null for account id %d!\n", account_id);
 		return;
 	}
 
 	if (sd->storage.received == true) {
-		ShowError("intif_parse_account_storage: Multiple calls from the inter-server received.\n");
+		if ((flag & STORAGE_PAGE_FIRST) != 0)
+			ShowError("intif_parse_account_storage: Multiple calls from the inter-server received.\n");
+		// The char-server rebuilt its slot layout from the database, which may not match ours anymore.
+		sd->storage.changes.full = true;
 		return;
 	}
 
+	if ((flag & STORAGE_PAGE_FIRST) != 0) {
+		VECTOR_TRUNCATE(sd->storage.item);
+		sd->storage.aggregate = 0;
+	}
+
 	storage_count = (payload_size/sizeof(struct item));
 
 	VECTOR_ENSURE(sd->storage.item, storage_count, 1);
 
-	sd->storage.aggregate = storage_count; // Total items in storage.
+	sd->storage.aggregate += storage_count; // Total items in storage.
 
 	for (i = 0; i < storage_count; i++) {
-		const struct item *it = RFIFOP(fd, 8 + i * sizeof(struct item));
+		const struct item *it = RFIFOP(fd, 9 + i * sizeof(struct item));
 		VECTOR_PUSH(sd->storage.item, *it);
 	}
 
+	if ((flag & STORAGE_PAGE_LAST) == 0)
+		return;
+
 	sd->storage.received = true; // Mark the storage state as received.
+	sd->storage.requested = false;
 	sd->storage.save = false; // Initialize the save flag as false.
+	storage->clear_changes(&sd->storage.changes);
 
 	pc->checkitem(sd); // re-check remaining items.
+
+	if ((flag & STORAGE_PAGE_OPEN) != 0)
+		storage->open(sd);
 }
 
 /**
- * Sends account storage information for saving to the character server.
+ * Sends the modified account storage slots to the character server for saving.
  *
  * @code{.unparsed}
- *	@packet 0x3011 [out] <packet_len>.W <account_id>.L <struct item[]>.P
+ *	@packet 0x3011 [out] <packet_len>.W <account_id>.L <full>.B {<slot>.W <struct item>.P}*
  * @endcode
  *
+ * Only the slots flagged in storage.changes are sent (emptied ones included), unless a full rewrite
+ * was requested, in which case every non-empty slot is sent.
+ *
  * @attention If the size of packet 0x3011 changes,
  *            @ref MAX_STORAGE_ASSERT "the related static assertion check"
  *            in mmo.h needs to be adjusted, too.
@@ -383,7 +411,9 @@ static void intif_parse_account_storage(int fd)
  **/
 static void intif_send_account_storage(struct map_session_data *sd)
 {
-	int len = 0, i = 0, c = 0;
+	const struct item empty = { 0 };
+	int len = 9, i = 0, c = 0, max_slot;
+	bool full;
 
 	nullpo_retv(sd);
 
@@ -394,22 +424,33 @@ static void intif_send_account_storage(struct map_session_data *sd)
 	if (intif->CheckForCharServer())
 		return;
 
-	len = 8 + sd->storage.aggregate * sizeof(struct item);
+	full = sd->storage.changes.full;
+	// Slots past the end of the storage were emptied when it was compacted.
+	max_slot = full ? VECTOR_LENGTH(sd->storage.item) : MAX_STORAGE;
 
-	WFIFOHEAD(inter_fd, len);
+	WFIFOHEAD(inter_fd, 9 + max_slot * (2 + sizeof(struct item)));
+
+	for (i = 0; i < max_slot; i++) {
+		const struct item *it = i < VECTOR_LENGTH(sd->storage.item) ? &VECTOR_INDEX(sd->storage.item, i) : &empty;
 
-	WFIFOW(inter_fd, 0) = 0x3011;
-	WFIFOW(inter_fd, 2) = (uint16) len;
-	WFIFOL(inter_fd, 4) = sd->status.account_id;
-	for (i = 0, c = 0; i < VECTOR_LENGTH(sd->storage.item); i++) {
-		if (VECTOR_INDEX(sd->storage.item, i).nameid == 0)
+		if (full ? it->nameid == 0 : !storage->is_changed(&sd->storage.changes, i))
 			continue;
-		memcpy(WFIFOP(inter_fd, 8 + c * sizeof(struct item)), &VECTOR_INDEX(sd->storage.item, i), sizeof(struct item));
+
+		WFIFOW(inter_fd, len) = i;
+		memcpy(WFIFOP(inter_fd, len + 2), it, sizeof(struct item));
+		len += 2 + sizeof(struct item);
 		c++;
 	}
 
-	WFIFOSET(inter_fd, len);
+	if (c > 0 || full) {
+		WFIFOW(inter_fd, 0) = 0x3011;
+		WFIFOW(inter_fd, 2) = (uint16) len;
+		WFIFOL(inter_fd, 4) = sd->status.account_id;
+		WFIFOB(inter_fd, 8) = full ? 1 : 0;
+		WFIFOSET(inter_fd, len);
+	}
 
+	storage->clear_changes(&sd->storage.changes);
 	sd->storage.save = false; // Save request has been sent
 }
 
@@ -432,6 +473,8 @@ static void intif_parse_account_storage_save_ack(int fd)
 
 	if (saved == 0) {
 		ShowError("intif_parse_account_storage_save_ack: Storage has not been saved! (AID: %d)\n", account_id);
+		// The sent slots are no longer tracked, rewrite the whole storage on the next attempt.
+		sd->storage.changes.full = true;
 		sd->storage.save = true; // Flag it as unsaved, to re-attempt later
 		return;
 	}
@@ -454,12 +497,15 @@ static int intif_request_guild_storage(int account_id, int guild_id)
 }
 
 /**
- * Sends guild storage information for saving to the character server.
+ * Sends the modified guild storage slots to the character server for saving.
  *
  * @code{.unparsed}
- *	@packet 0x3019 [out] <packet_len>.W <account_id>.L <guild_id>.L {<struct item>.P} * <capacity>
+ *	@packet 0x3019 [out] <packet_len>.W <account_id>.L <guild_id>.L <full>.B {<slot>.W <struct item>.P}*
  * @endcode
  *
+ * Only the slots flagged in gstor->changes are sent (emptied ones included), unless a full rewrite
+ * was requested, in which case every non-empty slot is sent.
+ *
  * @attention If the size of packet 0x3019 changes,
  *            @ref MAX_GUILD_STORAGE_ASSERT "the related static assertion check"
  *            in mmo.h needs to be adjusted, too.
@@ -468,29 +514,37 @@ static int intif_request_guild_storage(int account_id, int guild_id)
  *
  * @param[in] account_id The account ID of the character who initiated saving the guild storage information.
  * @param[in] gstor Pointer to the guild storage data containing the information to save.
- * @return Always 0.
+ * @return 0 on success, 1 on failure.
  *
  */
 static int intif_send_guild_storage(int account_id, struct guild_storage *gstor)
 {
-	int size;
+	int len = 13;
+	bool full;
 
 	if (intif->CheckForCharServer())
 		return 1;
 
 	nullpo_retr(1, gstor);
-	size = 20 + sizeof(gstor->items.data[0])*gstor->items.capacity;
+	full = gstor->changes.full;
 
-	WFIFOHEAD(inter_fd, size);
+	WFIFOHEAD(inter_fd, 13 + (2 + sizeof(gstor->items.data[0])) * gstor->items.capacity);
 	WFIFOW(inter_fd,0) = 0x3019;
-	WFIFOW(inter_fd,2) = size;
 	WFIFOL(inter_fd,4) = account_id;
 	WFIFOL(inter_fd,8) = gstor->guild_id;
-	WFIFOL(inter_fd,12) = gstor->items.capacity;
-	WFIFOL(inter_fd,16) = gstor->items.amount;
-	if (gstor->items.data != NULL)
-		memcpy(WFIFOP(inter_fd, 20), gstor->items.data, sizeof(gstor->items.data[0])*gstor->items.capacity);
-	WFIFOSET(inter_fd, size);
+	WFIFOB(inter_fd,12) = full ? 1 : 0;
+	for (int i = 0; i < gstor->items.capacity; i++) {
+		if (full ? gstor->items.data[i].nameid == 0 : !storage->is_changed(&gstor->changes, i))
+			continue;
+
+		WFIFOW(inter_fd, len) = i;
+		memcpy(WFIFOP(inter_fd, len + 2), &gstor->items.data[i], sizeof(gstor->items.data[0]));
+		len += 2 + sizeof(gstor->items.data[0]);
+	}
+	WFIFOW(inter_fd,2) = len;
+	WFIFOSET(inter_fd, len);
+
+	storage->clear_changes(&gstor->changes);
 	return 0;
 }
 
@@ -939,6 +993,26 @@ static int intif_guild_emblem(int guild_id, int data_len, const char *data)
 	return 0;
 }
 
+/**
+ * Requests a guild emblem that isn't stored yet from the char-server.
+ *
+ * @param guild_id    The guild ID.
+ * @param emblem_hash The content hash of the emblem.
+ */
+static int intif_guild_emblem_request(int guild_id, uint64 emblem_hash)
+{
+	if (intif->CheckForCharServer())
+		return 0;
+
+	WFIFOHEAD(inter_fd, sizeof(struct PACKET_MAPCHAR_GUILD_EMBLEM_REQ));
+	struct PACKET_MAPCHAR_GUILD_EMBLEM_REQ *p = WFIFOP(inter_fd, 0);
+	p->packetType = HEADER_MAPCHAR_GUILD_EMBLEM_REQ;
+	p->guild_id = guild_id;
+	p->emblem_hash = emblem_hash;
+	WFIFOSET(inter_fd, sizeof(struct PACKET_MAPCHAR_GUILD_EMBLEM_REQ));
+	return 0;
+}
+
 /**
  * Requests guild castles data from char-server.
  * @param num Number of castles, size of castle_ids array.
@@ -1134,22 +1208,24 @@ static void intif_parse_Registers(int fd)
 }
 
 /**
- * Loads received guild storage into memory.
+ * Loads a received page of guild storage into memory.
  *
  * Expected packets:
- * 0x3818 <len>.W <account id>.L <guild id != 0>.L <flag>.B <capacity>.L <amount>.L {<item>.P}*<capacity>
+ * 0x3818 <len>.W <account id>.L <guild id != 0>.L <flag>.B <capacity>.L <amount>.L <offset>.L {<item>.P}*
  * 0x3818 <len>.W <account id>.L <guild id == 0>.L
- * <flag> 0: Don't open storage
- * <flag> 1: Open storage
+ * <flag> is a combination of storage_page_flag:
+ *   STORAGE_PAGE_OPEN: Open storage once loaded
+ *   STORAGE_PAGE_FIRST: First page, (re)allocates the storage
+ *   STORAGE_PAGE_LAST: Last page, the storage can be used
  *
  * @param fd The receiving fd.
  */
 static void intif_parse_LoadGuildStorage(int fd)
 {
-	struct guild_storage *gstor = NULL;
+	struct guild_storage *gstor;
 	struct map_session_data *sd = NULL;
 
-	int flag, storage_capacity, storage_amount, expected_size;
+	int flag, storage_capacity, storage_amount, offset, count;
 	int account_id = RFIFOL(fd, 4);
 	int guild_id = RFIFOL(fd, 8);
 
@@ -1159,63 +1235,89 @@ static void intif_parse_LoadGuildStorage(int fd)
 	flag = RFIFOB(fd,12);
 	storage_capacity = RFIFOL(fd, 13);
 	storage_amount = RFIFOL(fd, 17);
+	offset = RFIFOL(fd, 21);
 	if (storage_capacity < storage_amount)
 		storage_capacity = storage_amount;
 
-	expected_size = 21 + (sizeof(gstor->items.data[0])*storage_capacity);
-	if (RFIFOW(fd,2) != expected_size) {
-		ShowError("intif_parse_LoadGuildStorage: data size mismatch! Expected: %d Received: %d\n",
-			expected_size, RFIFOW(fd,2));
+	count = (RFIFOW(fd, 2) - 25) / (int)sizeof(gstor->items.data[0]);
+	if (RFIFOW(fd, 2) != 25 + sizeof(gstor->items.data[0]) * count || offset < 0 || offset + count > storage_capacity) {
+		ShowError("intif_parse_LoadGuildStorage: data size mismatch! Capacity: %d Offset: %d Received: %d\n",
+			storage_capacity, offset, RFIFOW(fd,2));
 		return;
 	}
 
 	sd = map->id2sd(account_id);
-	// When flag is true a player should always be attached, otherwise it's not possible
-	// to open the storage later
-	if ((flag&1) == 1 && sd == NULL) // Player logged off/invalid data
-		return;
 
-	gstor = gstorage->ensure(guild_id);
-	if (gstor == NULL) {
-		ShowWarning("intif_parse_LoadGuildStorage: Invalid guild_id (%d)!\n", guild_id);
-		return;
-	}
-	if (gstor->in_use) {
-		// Already open.. lets ignore this update
-		ShowWarning("intif_parse_LoadGuildStorage: storage received for a client was already opened (User AID %d: CID %d)\n",
-			flag?sd->status.account_id:0, flag?sd->status.char_id:0);
-		return;
+	if ((flag & STORAGE_PAGE_FIRST) != 0) {
+		// When flag is true a player should always be attached, otherwise it's not possible
+		// to open the storage later
+		if ((flag & STORAGE_PAGE_OPEN) != 0 && sd == NULL) // Player logged off/invalid data
+			return;
+
+		gstor = gstorage->ensure(guild_id);
+		if (gstor == NULL) {
+			ShowWarning("intif_parse_LoadGuildStorage: Invalid guild_id (%d)!\n", guild_id);
+			return;
+		}
+		if (gstor->in_use) {
+			// Already open.. lets ignore this update
+			ShowWarning("intif_parse_LoadGuildStorage: storage received for a client was already opened (User AID %d: CID %d)\n",
+				sd != NULL ? sd->status.account_id : 0, sd != NULL ? sd->status.char_id : 0);
+			// The char-server rebuilt its slot layout from the database, which may not match ours anymore.
+			gstor->changes.full = true;
+			return;
+		}
+
+		if (gstor->dirty) { // Already have storage, and it has been modified and not saved yet! Exploit! [Skotlex]
+			ShowWarning("intif_parse_LoadGuildStorage: received storage for an already modified non-saved storage! (User AID %d: CID%d)\n",
+				sd != NULL ? sd->status.account_id : 0, sd != NULL ? sd->status.char_id : 0);
+			gstor->changes.full = true;
+			return;
+		}
+
+		// Clear current storage information and fetch new data
+		gstor->in_use = false;
+		gstor->locked = false;
+		gstor->dirty = false;
+		gstor->loading = true;
+		gstor->items.capacity = max(storage_capacity, 1);
+		gstor->items.amount = storage_amount;
+		if (gstor->items.data != NULL) {
+			aFree(gstor->items.data);
+		}
+		gstor->items.data = aCalloc(gstor->items.capacity, sizeof(gstor->items.data[0]));
+	} else if ((gstor = idb_get(gstorage->db, guild_id)) == NULL || !gstor->loading) {
+		return; // The first page was ignored.
 	}
 
-	if (gstor->dirty) { // Already have storage, and it has been modified and not saved yet! Exploit! [Skotlex]
-		ShowWarning("intif_parse_LoadGuildStorage: received storage for an already modified non-saved storage! (User AID %d: CID%d)\n",
-			flag?sd->status.account_id:0, flag?sd->status.char_id:0);
+	if (count > 0 && offset + count <= gstor->items.capacity)
+		memcpy(&gstor->items.data[offset], RFIFOP(fd, 25), sizeof(gstor->items.data[0]) * count);
+
+	if ((flag & STORAGE_PAGE_LAST) == 0)
 		return;
-	}
 
-	// Clear current storage information and fetch new data
-	gstor->in_use = false;
-	gstor->locked = false;
-	gstor->dirty = false;
-	gstor->items.capacity = max(storage_capacity, 1);
-	gstor->items.amount = storage_amount;
-	if (gstor->items.data != NULL) {
-		aFree(gstor->items.data);
-	}
-	gstor->items.data = aCalloc(gstor->items.capacity, sizeof(gstor->items.data[0]));
-	if (storage_capacity > 0) {
-		memcpy(gstor->items.data, RFIFOP(fd, 21), sizeof(gstor->items.data[0])*storage_capacity);
-	}
+	gstor->loading = false;
+	storage->clear_changes(&gstor->changes);
 
-	if ((flag&1) == 1)
+	if ((flag & STORAGE_PAGE_OPEN) != 0 && sd != NULL)
 		gstorage->open(sd);
-
-	return;
 }
 
 // ACK guild_storage saved
 static void intif_parse_SaveGuildStorage(int fd)
 {
+	if (RFIFOB(fd, 10) != 0) {
+		struct guild_storage *gstor = idb_get(gstorage->db, RFIFOL(fd, 6));
+
+		ShowError("intif_parse_SaveGuildStorage: Guild storage has not been saved! (GID: %u)\n", RFIFOL(fd, 6));
+		if (gstor != NULL) {
+			// The sent slots are no longer tracked, rewrite the whole storage on the next attempt.
+			gstor->changes.full = true;
+			gstor->dirty = true;
+		}
+		return;
+	}
+
 	gstorage->saved(/*RFIFOL(fd,2), */RFIFOL(fd,6));
 }
 
@@ -1282,7 +1384,7 @@ static void intif_parse_GuildCreated(int fd)
 	guild->created(RFIFOL(fd,2),RFIFOL(fd,6));
 }
 
-// ACK guild infos
+// Guild emblem requested with intif->guild_emblem_request
 static void intif_parse_GuildInfoEmblem(int fd)
 {
 	struct PACKET_CHARMAP_GUILD_INFO_EMBLEM *p = RFIFOP(fd, 0);
@@ -1290,17 +1392,13 @@ static void intif_parse_GuildInfoEmblem(int fd)
 	RFIFO_CHUNKED_INIT(p, p->packetLength - sizeof(struct PACKET_CHARMAP_GUILD_INFO_EMBLEM), intif->emblem_tmp);
 
 	RFIFO_CHUNKED_ERROR(p) {
-		intif->emblem_tmp_done = false;
-		intif->emblem_tmp_guild_id = 0;
-		intif->emblem_tmp_emblem_id = 0;
 		fifo_chunk_buf_clear(intif->emblem_tmp);
 		return;
 	}
 
 	RFIFO_CHUNKED_COMPLETE(p) {
-		intif->emblem_tmp_done = true;
-		intif->emblem_tmp_guild_id = p->guild_id;
-		intif->emblem_tmp_emblem_id = p->emblem_id;
+		guild->emblem_recv(p->guild_id, p->emblem_id, intif->emblem_tmp.data, (int)intif->emblem_tmp.data_size);
+		fifo_chunk_buf_clear(intif->emblem_tmp);
 	}
 }
 
@@ -1317,17 +1415,8 @@ static void intif_parse_GuildInfo(int fd)
 	if (p->packetLength != sizeof(struct PACKET_CHARMAP_GUILD_INFO))
 		ShowError("intif: guild info: data size mismatch - Gid: %d recv size: %d Expected size: %"PRIuS"\n",
 		          p->g.guild_id, p->packetLength, sizeof(struct PACKET_CHARMAP_GUILD_INFO));
-	if (intif->emblem_tmp_done == false ||
-	    intif->emblem_tmp_guild_id != p->g.guild_id ||
-	    intif->emblem_tmp_emblem_id != p->g.emblem_id) {
-		guild->recv_info(&p->g, NULL);
-	} else {
-		guild->recv_info(&p->g, &intif->emblem_tmp);
-	}
-	intif->emblem_tmp_done = false;
-	intif->emblem_tmp_guild_id = 0;
-	intif->emblem_tmp_emblem_id = 0;
-	fifo_chunk_buf_clear(intif->emblem_tmp);
+	// The emblem is looked up by p->g.emblem_hash
+	guild->recv_info(&p->g, NULL);
 }
 
 // ACK adding guild member
@@ -1458,11 +1547,6 @@ static void intif_parse_GuildEmblem(int fd)
 {
 	struct PACKET_CHARMAP_GUILD_EMBLEM *p = RFIFOP(fd, 0);
 
-	// reset tmp emblem fields always for avoid reuse emblem buffer for other things [4144]
-	intif->emblem_tmp_done = false;
-	intif->emblem_tmp_guild_id = 0;
-	intif->emblem_tmp_emblem_id = 0;
-
 	RFIFO_CHUNKED_INIT(p, p->packetLength - sizeof(struct PACKET_CHARMAP_GUILD_EMBLEM), intif->emblem_tmp);
 
 	RFIFO_CHUNKED_ERROR(p) {
@@ -2905,9 +2989,6 @@ void intif_defaults(void)
 	intif = &intif_s;
 
 	fifo_chunk_buf_init(intif->emblem_tmp);
-	intif->emblem_tmp_done = false;
-	intif->emblem_tmp_guild_id = 0;
-	intif->emblem_tmp_emblem_id = 0;
 
 	/* funcs */
 	intif->parse = intif_parse;
@@ -2940,6 +3021,7 @@ void intif_defaults(void)
 	intif->guild_alliance = intif_guild_alliance;
 	intif->guild_notice = intif_guild_notice;
 	intif->guild_emblem = intif_guild_emblem;
+	intif->guild_emblem_request = intif_guild_emblem_request;
 	intif->guild_castle_dataload = intif_guild_castle_dataload;
 	intif->guild_castle_datasave = intif_guild_castle_datasave;
 	intif->request_petdata = intif_request_petdata;
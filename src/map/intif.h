@@ -54,9 +54,6 @@ struct rodex_message;
 *-------------------------------------*/
 struct intif_interface {
 	struct fifo_chunk_buf emblem_tmp;
-	bool emblem_tmp_done;
-	int emblem_tmp_guild_id;
-	int emblem_tmp_emblem_id;
 
 	/* funcs */
 	void (*final) (void);
@@ -65,7 +62,7 @@ struct intif_interface {
 	                  int pet_equip, short intimate, short hungry, char rename_flag, char incubate, char *pet_name);
 	int (*saveregistry) (struct map_session_data *sd);
 	int (*request_registry) (struct map_session_data *sd, int flag);
-	void (*request_account_storage) (const struct map_session_data *sd);
+	void (*request_account_storage) (struct map_session_data *sd, int flag);
 	void (*send_account_storage) (struct map_session_data *sd);
 	int (*request_guild_storage) (int account_id, int guild_id);
 	int (*send_guild_storage) (int account_id, struct guild_storage *gstor);
@@ -91,6 +88,7 @@ struct intif_interface {
 	int (*guild_alliance) (int guild_id1, int guild_id2, int account_id1, int account_id2, int flag);
 	int (*guild_notice) (int guild_id, const char *mes1, const char *mes2);
 	int (*guild_emblem) (int guild_id, int len, const char *data);
+	int (*guild_emblem_request) (int guild_id, uint64 emblem_hash);
 	int (*guild_castle_dataload) (int num, int *castle_ids);
 	int (*guild_castle_datasave) (int castle_id, int index, int value);
 	void (*itembound_req) (int char_id, int aid, int guild_id);
@@ -367,14 +367,137 @@ static const struct item_group *itemdb_search_group(int nameid)
 /// Returns the item_data or NULL if it does not exist.
 static struct item_data *itemdb_exists(int nameid)
 {
-	struct item_data* item;
-
 	if( nameid >= 0 && nameid < ARRAYLENGTH(itemdb->array) )
 		return itemdb->array[nameid];
-	item = (struct item_data*)idb_get(itemdb->other,nameid);
-	if( item == &itemdb->dummy )
-		return NULL;// dummy data, doesn't exist
-	return item;
+
+	int idx = itemdb->index_get(nameid);
+	if (idx < 0)
+		return NULL;
+	return itemdb->dense[idx];
+}
+
+/**
+ * Adds a newly created item to the dense item index.
+ *
+ * @param id Item data (must not be in the index yet).
+ */
+static void itemdb_index_add(struct item_data *id)
+{
+	nullpo_retv(id);
+	Assert_retv(id->nameid >= 0 && id->nameid <= MAX_ITEM_ID);
+
+	int page = id->nameid >> ITEMDB_INDEX_PAGE_BITS;
+	if (itemdb->index[page] == NULL)
+		CREATE(itemdb->index[page], int, ITEMDB_INDEX_PAGE_SIZE);
+
+	if (itemdb->dense_count == itemdb->dense_size) {
+		itemdb->dense_size = max(itemdb->dense_size * 2, 1024);
+		RECREATE(itemdb->dense, struct item_data *, itemdb->dense_size);
+		RECREATE(itemdb->hot, struct item_hot_data, itemdb->dense_size);
+	}
+
+	int idx = itemdb->dense_count++;
+	itemdb->dense[idx] = id;
+	itemdb->index[page][id->nameid & (ITEMDB_INDEX_PAGE_SIZE - 1)] = idx + 1;
+	itemdb->hot_update(id);
+}
+
+/**
+ * Gets the dense index of an item.
+ * Lookup is two array accesses for any item id.
+ *
+ * @param nameid Item id.
+ * @return index in itemdb->dense and itemdb->hot or -1 if the item doesn't exist.
+ */
+static int itemdb_index_get(int nameid)
+{
+	if (nameid < 0 || nameid > MAX_ITEM_ID)
+		return -1;
+
+	const int *page = itemdb->index[nameid >> ITEMDB_INDEX_PAGE_BITS];
+	if (page == NULL)
+		return -1;
+	return page[nameid & (ITEMDB_INDEX_PAGE_SIZE - 1)] - 1;
+}
+
+/**
+ * Removes all items from the dense item index.
+ */
+static void itemdb_index_clear(void)
+{
+	for (int i = 0; i < ITEMDB_INDEX_PAGES; i++) {
+		if (itemdb->index[i] != NULL)
+			aFree(itemdb->index[i]);
+		itemdb->index[i] = NULL;
+	}
+	aFree(itemdb->dense);
+	aFree(itemdb->hot);
+	itemdb->dense = NULL;
+	itemdb->hot = NULL;
+	itemdb->dense_count = itemdb->dense_size = 0;
+}
+
+/**
+ * Copies hot fields of an item to its itemdb->hot entry.
+ * Must be called whenever one of these fields is changed after the item is created.
+ *
+ * @param id Item data.
+ */
+static void itemdb_hot_update(struct item_data *id)
+{
+	nullpo_retv(id);
+
+	struct item_hot_data *hot;
+	if (id == &itemdb->dummy) {
+		hot = &itemdb->hot_dummy;
+	} else {
+		int idx = itemdb->index_get(id->nameid);
+		if (idx < 0 || itemdb->dense[idx] != id)
+			return;
+		hot = &itemdb->hot[idx];
+	}
+
+	hot->nameid = id->nameid;
+	hot->weight = id->weight;
+	hot->equip = id->equip;
+	hot->atk = id->atk;
+	hot->matk = id->matk;
+	hot->def = id->def;
+	hot->type = (int16)id->type;
+	hot->subtype = (int16)id->subtype;
+	hot->slot = (int16)id->slot;
+	hot->range = (int16)id->range;
+	hot->wlv = (int16)id->wlv;
+	hot->elv = (int16)id->elv;
+}
+
+/**
+ * Refreshes hot fields of all items, after the item database is read.
+ */
+static void itemdb_hot_update_all(void)
+{
+	for (int i = 0; i < itemdb->dense_count; i++)
+		itemdb->hot_update(itemdb->dense[i]);
+	itemdb->hot_update(&itemdb->dummy);
+}
+
+/**
+ * Searches for the hot fields of an item.
+ * Like itemdb_search, returns the dummy item fields if it doesn't exist.
+ *
+ * @param nameid Item id.
+ * @return hot fields of the item.
+ */
+static const struct item_hot_data *itemdb_hot_search(int nameid)
+{
+	int idx = itemdb->index_get(nameid);
+
+	if (idx >= 0)
+		return &itemdb->hot[idx];
+
+	itemdb->search(nameid); // warns about unknown item
+	itemdb->hot_dummy.nameid = nameid;
+	return &itemdb->hot_dummy;
 }
 
 /**
@@ -674,17 +797,20 @@ static struct item_data *itemdb_load(int nameid)
 	if( nameid >= 0 && nameid < ARRAYLENGTH(itemdb->array) )
 	{
 		id = itemdb->array[nameid];
-		if( id == NULL || id == &itemdb->dummy )
+		if( id == NULL || id == &itemdb->dummy ) {
 			id = itemdb->array[nameid] = itemdb->create_item_data(nameid);
+			itemdb->index_add(id);
+		}
 		return id;
 	}
 
-	id = (struct item_data*)idb_get(itemdb->other, nameid);
-	if( id == NULL || id == &itemdb->dummy )
-	{
-		id = itemdb->create_item_data(nameid);
-		idb_put(itemdb->other, nameid, id);
-	}
+	int idx = itemdb->index_get(nameid);
+	if (idx >= 0)
+		return itemdb->dense[idx];
+
+	id = itemdb->create_item_data(nameid);
+	idb_put(itemdb->other, nameid, id);
+	itemdb->index_add(id);
 	return id;
 }
 
@@ -694,10 +820,12 @@ static struct item_data *itemdb_load(int nameid)
 static struct item_data *itemdb_search(int nameid)
 {
 	struct item_data* id;
-	if( nameid >= 0 && nameid < ARRAYLENGTH(itemdb->array) )
+	if( nameid >= 0 && nameid < ARRAYLENGTH(itemdb->array) ) {
 		id = itemdb->array[nameid];
-	else
-		id = (struct item_data*)idb_get(itemdb->other, nameid);
+	} else {
+		int idx = itemdb->index_get(nameid);
+		id = (idx >= 0) ? itemdb->dense[idx] : NULL;
+	}
 
 	if( id == NULL )
 	{
@@ -3015,6 +3143,8 @@ static void itemdb_read(bool minimal)
 
 	itemdb->other->foreach(itemdb->other, itemdb->addname_sub);
 
+	itemdb->hot_update_all();
+
 	itemdb->read_options();
 
 	if (minimal)
@@ -3208,6 +3338,7 @@ static void itemdb_clear(bool total)
 	if (total)
 		return;
 
+	itemdb->index_clear();
 	itemdb->other->clear(itemdb->other, itemdb->final_sub);
 	itemdb->options->clear(itemdb->options, itemdb->options_final_sub);
 	itemdb->reform->clear(itemdb->reform, itemdb->reform_final_sub);
@@ -3224,10 +3355,18 @@ static void itemdb_reload(void)
 
 	int i,d,k;
 
+	// parse the biggest databases in parallel while the old data is cleared
+	libconfig->prefetch_db(DBPATH"item_db.conf");
+	libconfig->prefetch_db("item_db2.conf");
+	libconfig->prefetch_db(DBPATH"item_combo_db.conf");
+	libconfig->prefetch_db(DBPATH"item_group.conf");
+	libconfig->prefetch_db(DBPATH"item_chain.conf");
+
 	itemdb->clear(false);
 
 	// read new data
 	itemdb->read(false);
+	libconfig->prefetch_clear();
 
 	//Epoque's awesome @reloaditemdb fix - thanks! [Ind]
 	//- Fixes the need of a @reloadmobdb after a @reloaditemdb to re-link monster drop data
@@ -3300,6 +3439,9 @@ static void do_final_itemdb(void)
 {
 	itemdb->clear(true);
 
+	itemdb->index_clear();
+	aFree(itemdb->index);
+	itemdb->index = NULL;
 	itemdb->other->destroy(itemdb->other, itemdb->final_sub);
 	itemdb->options->destroy(itemdb->options, itemdb->options_final_sub);
 	itemdb->reform->destroy(itemdb->reform, itemdb->reform_final_sub);
@@ -3312,6 +3454,7 @@ static void do_init_itemdb(bool minimal)
 {
 	memset(itemdb->array, 0, sizeof(itemdb->array));
 	itemdb->other = idb_alloc(DB_OPT_BASE);
+	CREATE(itemdb->index, int *, ITEMDB_INDEX_PAGES);
 	itemdb->options = idb_alloc(DB_OPT_RELEASE_DATA);
 	itemdb->reform = idb_alloc(DB_OPT_RELEASE_DATA);
 	itemdb->names = strdb_alloc(DB_OPT_BASE,ITEM_NAME_LENGTH);
@@ -3354,6 +3497,12 @@ void itemdb_defaults(void)
 	/* */
 	/* itemdb->array is cleared on itemdb->init() */
 	itemdb->other = NULL;
+	itemdb->index = NULL;
+	itemdb->dense = NULL;
+	itemdb->hot = NULL;
+	itemdb->dense_count = 0;
+	itemdb->dense_size = 0;
+	memset(&itemdb->hot_dummy, 0, sizeof(itemdb->hot_dummy));
 	memset(&itemdb->dummy, 0, sizeof(struct item_data));
 	/* */
 	itemdb->read_groups = itemdb_read_groups;
@@ -3370,6 +3519,12 @@ void itemdb_defaults(void)
 	itemdb->load = itemdb_load;
 	itemdb->search = itemdb_search;
 	itemdb->exists = itemdb_exists;
+	itemdb->index_add = itemdb_index_add;
+	itemdb->index_get = itemdb_index_get;
+	itemdb->index_clear = itemdb_index_clear;
+	itemdb->hot_update = itemdb_hot_update;
+	itemdb->hot_update_all = itemdb_hot_update_all;
+	itemdb->hot_search = itemdb_hot_search;
 	itemdb->option_exists = itemdb_option_exists;
 	itemdb->reform_exists = itemdb_reform_exists;
 	itemdb->in_group = itemdb_in_group;
@@ -45,6 +45,11 @@ struct hplugin_data_store;
 #endif
 #endif
 
+/// Item id bits covered by one page of itemdb->index
+#define ITEMDB_INDEX_PAGE_BITS 16
+#define ITEMDB_INDEX_PAGE_SIZE (1 << ITEMDB_INDEX_PAGE_BITS)
+#define ITEMDB_INDEX_PAGES ((MAX_ITEM_ID >> ITEMDB_INDEX_PAGE_BITS) + 1)
+
 #ifndef MAX_ITEMDELAYS
 #define MAX_ITEMDELAYS 10 // The maximum number of item delays
 #endif
@@ -541,6 +546,27 @@ struct item_reform {
 	bool PreserveGrade;
 };
 
+/**
+ * Item fields read by weight, inventory, drop and status calculation loops.
+ * Kept in a compact table parallel to itemdb->dense, so these loops don't
+ * touch the whole struct item_data.
+ * @see itemdb_hot_search
+ */
+struct item_hot_data {
+	int nameid;
+	int weight;
+	int equip;
+	int atk;
+	int matk;
+	int def;
+	int16 type;
+	int16 subtype;
+	int16 slot;
+	int16 range;
+	int16 wlv;
+	int16 elv;
+};
+
 struct item_data {
 	int nameid;
 	char name[ITEM_NAME_LENGTH],jname[ITEM_NAME_LENGTH];
@@ -622,18 +648,18 @@ struct item_data {
 
 #define itemdb_name(n)        (itemdb->search(n)->name)
 #define itemdb_jname(n)       (itemdb->search(n)->jname)
-#define itemdb_type(n)        (itemdb->search(n)->type)
-#define itemdb_atk(n)         (itemdb->search(n)->atk)
-#define itemdb_def(n)         (itemdb->search(n)->def)
-#define itemdb_subtype(n)     (itemdb->search(n)->subtype)
+#define itemdb_type(n)        (itemdb->hot_search(n)->type)
+#define itemdb_atk(n)         (itemdb->hot_search(n)->atk)
+#define itemdb_def(n)         (itemdb->hot_search(n)->def)
+#define itemdb_subtype(n)     (itemdb->hot_search(n)->subtype)
 #define itemdb_sprite(n)      (itemdb->search(n)->view_sprite)
-#define itemdb_weight(n)      (itemdb->search(n)->weight)
-#define itemdb_equip(n)       (itemdb->search(n)->equip)
+#define itemdb_weight(n)      (itemdb->hot_search(n)->weight)
+#define itemdb_equip(n)       (itemdb->hot_search(n)->equip)
 #define itemdb_usescript(n)   (itemdb->search(n)->script)
 #define itemdb_equipscript(n) (itemdb->search(n)->script)
-#define itemdb_wlv(n)         (itemdb->search(n)->wlv)
-#define itemdb_range(n)       (itemdb->search(n)->range)
-#define itemdb_slot(n)        (itemdb->search(n)->slot)
+#define itemdb_wlv(n)         (itemdb->hot_search(n)->wlv)
+#define itemdb_range(n)       (itemdb->hot_search(n)->range)
+#define itemdb_slot(n)        (itemdb->hot_search(n)->slot)
 #define itemdb_available(n)   (itemdb->search(n)->flag.available)
 #define itemdb_viewid(n)      (itemdb->search(n)->view_id)
 #define itemdb_autoequip(n)   (itemdb->search(n)->flag.autoequip)
@@ -687,6 +713,12 @@ struct itemdb_interface {
 	/* */
 	struct item_data *array[MAX_ITEMDB];
 	struct DBMap *other;// int nameid -> struct item_data*
+	int **index; ///< Item id -> dense index + 1 (0: item doesn't exist), split in pages of ITEMDB_INDEX_PAGE_SIZE ids
+	struct item_data **dense; ///< Dense index -> item data
+	struct item_hot_data *hot; ///< Dense index -> hot fields of the item
+	int dense_count;
+	int dense_size;
+	struct item_hot_data hot_dummy; ///< Hot fields of itemdb->dummy
 	struct DBMap *options; // int opt_id -> struct itemdb_option*
 	struct item_data dummy; //This is the default dummy item used for non-existant items. [Skotlex]
 	struct DBMap *reform; // int reform_id -> struct item_reform *
@@ -705,6 +737,12 @@ struct itemdb_interface {
 	struct item_data* (*load)(int nameid);
 	struct item_data* (*search)(int nameid);
 	struct item_data* (*exists) (int nameid);
+	void (*index_add) (struct item_data *id);
+	int (*index_get) (int nameid);
+	void (*index_clear) (void);
+	void (*hot_update) (struct item_data *id);
+	void (*hot_update_all) (void);
+	const struct item_hot_data *(*hot_search) (int nameid);
 	struct itemdb_option* (*option_exists) (int idx);
 	struct item_reform* (*reform_exists) (int idx);
 	bool (*in_group) (struct item_group *group, int nameid);
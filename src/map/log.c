@@ -29,15 +29,26 @@
 #include "map/pc.h"
 #include "common/cbasetypes.h"
 #include "common/conf.h"
+#include "common/memmgr.h"
 #include "common/nullpo.h"
 #include "common/showmsg.h"
 #include "common/sql.h" // SQL_INNODB
 #include "common/strlib.h"
 #include "common/HPM.h"
+#include "common/mutex.h"
+#include "common/thread.h"
+#include "common/utils.h" // cap_value
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef WIN32
+#	include "common/winapi.h"
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
 
 static struct log_interface log_s;
 struct log_interface *logs;
@@ -139,33 +150,45 @@ static bool should_log_item(int nameid, int amount, int refine_level, struct ite
 }
 static void log_branch_sub_sql(struct map_session_data *sd)
 {
-	struct SqlStmt *stmt;
+	char timestring[255];
+	char esc_name[NAME_LENGTH * 2 + 1];
+	char row[LOG_RECORD_SIZE];
+	time_t curtime;
+	int len;
 
 	nullpo_retv(sd);
-	stmt = SQL->StmtMalloc(logs->mysql_handle);
-	if( SQL_SUCCESS != SQL->StmtPrepare(stmt, LOG_QUERY " INTO `%s` (`branch_date`, `account_id`, `char_id`, `char_name`, `map`) VALUES (NOW(), '%d', '%d', ?, '%s')", logs->config.log_branch, sd->status.account_id, sd->status.char_id, mapindex_id2name(sd->mapindex) )
-	   ||  SQL_SUCCESS != SQL->StmtBindParam(stmt, 0, SQLDT_STRING, sd->status.name, strnlen(sd->status.name, NAME_LENGTH))
-	   ||  SQL_SUCCESS != SQL->StmtExecute(stmt) )
-	{
-		SqlStmt_ShowDebug(stmt);
-		SQL->StmtFree(stmt);
-		return;
-	}
-	SQL->StmtFree(stmt);
+	time(&curtime);
+	strftime(timestring, sizeof(timestring), "%Y-%m-%d %H:%M:%S", localtime(&curtime));
+	SQL->EscapeStringLen(logs->mysql_handle, esc_name, sd->status.name, strnlen(sd->status.name, NAME_LENGTH));
+	len = snprintf(row, sizeof(row), "('%s', '%d', '%d', '%s', '%s')",
+	               timestring, sd->status.account_id, sd->status.char_id, esc_name, mapindex_id2name(sd->mapindex));
+	logs->queue_push(LOG_TARGET_BRANCH, row, len);
 }
 static void log_branch_sub_txt(struct map_session_data *sd)
 {
 	char timestring[255];
+	char line[LOG_RECORD_SIZE];
 	time_t curtime;
-	FILE* logfp;
+	int len;
 
 	nullpo_retv(sd);
-	if( ( logfp = fopen(logs->config.log_branch, "a") ) == NULL )
-		return;
 	time(&curtime);
 	strftime(timestring, sizeof(timestring), "%m/%d/%Y %H:%M:%S", localtime(&curtime));
-	fprintf(logfp,"%s - %s[%d:%d]\t%s\n", timestring, sd->status.name, sd->status.account_id, sd->status.char_id, mapindex_id2name(sd->mapindex));
-	fclose(logfp);
+	len = snprintf(line, sizeof(line), "%s - %s[%d:%d]\t%s\n", timestring, sd->status.name, sd->status.account_id, sd->status.char_id, mapindex_id2name(sd->mapindex));
+	logs->queue_push(LOG_TARGET_BRANCH, line, len);
+}
+static void log_branch_sub_journal(struct map_session_data *sd)
+{
+	struct log_journal_record record = { 0 };
+
+	nullpo_retv(sd);
+	record.target = LOG_TARGET_BRANCH;
+	record.time = (int64)time(NULL);
+	record.char_id = sd->status.char_id;
+	record.account_id = sd->status.account_id;
+	safestrncpy(record.name, sd->status.name, sizeof(record.name));
+	safestrncpy(record.map, mapindex_id2name(sd->mapindex), sizeof(record.map));
+	logs->journal_write(&record, NULL);
 }
 
 /// logs items, that summon monsters
@@ -180,35 +203,60 @@ static void log_branch(struct map_session_data *sd)
 }
 static void log_pick_sub_sql(int id, int16 m, e_log_pick_type type, int amount, struct item *itm, struct item_data *data)
 {
+	char timestring[255];
+	char row[LOG_RECORD_SIZE];
+	time_t curtime;
+	int len;
+
 	nullpo_retv(itm);
-	if (SQL_ERROR == SQL->Query(logs->mysql_handle,
-	    LOG_QUERY " INTO `%s` (`time`, `char_id`, `type`, `nameid`, `amount`, `refine`, `grade`, `card0`, `card1`, `card2`, `card3`, "
-		"`opt_idx0`, `opt_val0`, `opt_idx1`, `opt_val1`, `opt_idx2`, `opt_val2`, `opt_idx3`, `opt_val3`, `opt_idx4`, `opt_val4`, `map`, `unique_id`) "
-	    "VALUES (NOW(), '%d', '%c', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%s', '%"PRIu64"')",
-	    logs->config.log_pick, id, logs->picktype2char(type), itm->nameid, amount, itm->refine, itm->grade, itm->card[0], itm->card[1], itm->card[2], itm->card[3],
+	time(&curtime);
+	strftime(timestring, sizeof(timestring), "%Y-%m-%d %H:%M:%S", localtime(&curtime));
+	len = snprintf(row, sizeof(row),
+	    "('%s', '%d', '%c', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%s', '%"PRIu64"')",
+	    timestring, id, logs->picktype2char(type), itm->nameid, amount, itm->refine, itm->grade, itm->card[0], itm->card[1], itm->card[2], itm->card[3],
 		itm->option[0].index, itm->option[0].value, itm->option[1].index, itm->option[1].value, itm->option[2].index, itm->option[2].value,
 		itm->option[3].index, itm->option[3].value, itm->option[4].index, itm->option[4].value,
-	    map->list[m].name, itm->unique_id))
-	{
-		Sql_ShowDebug(logs->mysql_handle);
-		return;
-	}
+	    map->list[m].name, itm->unique_id);
+	logs->queue_push(LOG_TARGET_PICK, row, len);
 }
 static void log_pick_sub_txt(int id, int16 m, e_log_pick_type type, int amount, struct item *itm, struct item_data *data)
 {
 	char timestring[255];
+	char line[LOG_RECORD_SIZE];
 	time_t curtime;
-	FILE* logfp;
+	int len;
 
 	nullpo_retv(itm);
-	if( ( logfp = fopen(logs->config.log_pick, "a") ) == NULL )
-		return;
 	time(&curtime);
 	strftime(timestring, sizeof(timestring), "%m/%d/%Y %H:%M:%S", localtime(&curtime));
-	fprintf(logfp,"%s - %d\t%c\t%d,%d,%d,%d,%d,%d,%d,%s,'%"PRIu64"'\n",
+	len = snprintf(line, sizeof(line), "%s - %d\t%c\t%d,%d,%d,%d,%d,%d,%d,%s,'%"PRIu64"'\n",
 	        timestring, id, logs->picktype2char(type), itm->nameid, amount, itm->refine, itm->card[0], itm->card[1], itm->card[2], itm->card[3],
 		map->list[m].name, itm->unique_id);
-	fclose(logfp);
+	logs->queue_push(LOG_TARGET_PICK, line, len);
+}
+static void log_pick_sub_journal(int id, int16 m, e_log_pick_type type, int amount, struct item *itm, struct item_data *data)
+{
+	struct log_journal_record record = { 0 };
+	int i;
+
+	nullpo_retv(itm);
+	record.target = LOG_TARGET_PICK;
+	record.type = logs->picktype2char(type);
+	record.time = (int64)time(NULL);
+	record.char_id = id;
+	record.nameid = itm->nameid;
+	record.amount = amount;
+	record.refine = itm->refine;
+	record.grade = itm->grade;
+	for (i = 0; i < MAX_SLOTS; i++)
+		record.card[i] = itm->card[i];
+	for (i = 0; i < MAX_ITEM_OPTIONS; i++) {
+		record.option[i].index = itm->option[i].index;
+		record.option[i].value = itm->option[i].value;
+	}
+	record.unique_id = itm->unique_id;
+	safestrncpy(record.map, map->list[m].name, sizeof(record.map));
+	logs->journal_write(&record, NULL);
 }
 /// logs item transactions (generic)
 static void log_pick(int id, int16 m, e_log_pick_type type, int amount, struct item *itm, struct item_data *data)
@@ -241,29 +289,49 @@ static void log_pick_mob(struct mob_data *md, e_log_pick_type type, int amount,
 }
 static void log_zeny_sub_sql(struct map_session_data *sd, e_log_pick_type type, struct map_session_data *src_sd, int amount)
 {
+	char timestring[255];
+	char row[LOG_RECORD_SIZE];
+	time_t curtime;
+	int len;
+
 	nullpo_retv(sd);
 	nullpo_retv(src_sd);
-	if( SQL_ERROR == SQL->Query(logs->mysql_handle, LOG_QUERY " INTO `%s` (`time`, `char_id`, `src_id`, `type`, `amount`, `map`) VALUES (NOW(), '%d', '%d', '%c', '%d', '%s')",
-							   logs->config.log_zeny, sd->status.char_id, src_sd->status.char_id, logs->picktype2char(type), amount, mapindex_id2name(sd->mapindex)) )
-	{
-		Sql_ShowDebug(logs->mysql_handle);
-		return;
-	}
+	time(&curtime);
+	strftime(timestring, sizeof(timestring), "%Y-%m-%d %H:%M:%S", localtime(&curtime));
+	len = snprintf(row, sizeof(row), "('%s', '%d', '%d', '%c', '%d', '%s')",
+	               timestring, sd->status.char_id, src_sd->status.char_id, logs->picktype2char(type), amount, mapindex_id2name(sd->mapindex));
+	logs->queue_push(LOG_TARGET_ZENY, row, len);
 }
 static void log_zeny_sub_txt(struct map_session_data *sd, e_log_pick_type type, struct map_session_data *src_sd, int amount)
 {
 	char timestring[255];
+	char line[LOG_RECORD_SIZE];
 	time_t curtime;
-	FILE* logfp;
+	int len;
 
 	nullpo_retv(sd);
 	nullpo_retv(src_sd);
-	if( ( logfp = fopen(logs->config.log_zeny, "a") ) == NULL )
-		return;
 	time(&curtime);
 	strftime(timestring, sizeof(timestring), "%m/%d/%Y %H:%M:%S", localtime(&curtime));
-	fprintf(logfp, "%s - %s[%d]\t%s[%d]\t%d\t\n", timestring, src_sd->status.name, src_sd->status.account_id, sd->status.name, sd->status.account_id, amount);
-	fclose(logfp);
+	len = snprintf(line, sizeof(line), "%s - %s[%d]\t%s[%d]\t%d\t\n", timestring, src_sd->status.name, src_sd->status.account_id, sd->status.name, sd->status.account_id, amount);
+	logs->queue_push(LOG_TARGET_ZENY, line, len);
+}
+static void log_zeny_sub_journal(struct map_session_data *sd, e_log_pick_type type, struct map_session_data *src_sd, int amount)
+{
+	struct log_journal_record record = { 0 };
+
+	nullpo_retv(sd);
+	nullpo_retv(src_sd);
+	record.target = LOG_TARGET_ZENY;
+	record.type = logs->picktype2char(type);
+	record.time = (int64)time(NULL);
+	record.char_id = sd->status.char_id;
+	record.account_id = sd->status.account_id;
+	record.id = src_sd->status.char_id;
+	record.amount = amount;
+	safestrncpy(record.name, sd->status.name, sizeof(record.name));
+	safestrncpy(record.map, mapindex_id2name(sd->mapindex), sizeof(record.map));
+	logs->journal_write(&record, NULL);
 }
 /// logs zeny transactions
 static void log_zeny(struct map_session_data *sd, e_log_pick_type type, struct map_session_data *src_sd, int amount)
@@ -277,29 +345,49 @@ static void log_zeny(struct map_session_data *sd, e_log_pick_type type, struct m
 }
 static void log_mvpdrop_sub_sql(struct map_session_data *sd, int monster_id, int *log_mvp)
 {
+	char timestring[255];
+	char row[LOG_RECORD_SIZE];
+	time_t curtime;
+	int len;
+
 	nullpo_retv(sd);
 	nullpo_retv(log_mvp);
-	if( SQL_ERROR == SQL->Query(logs->mysql_handle, LOG_QUERY " INTO `%s` (`mvp_date`, `kill_char_id`, `monster_id`, `prize`, `mvpexp`, `map`) VALUES (NOW(), '%d', '%d', '%d', '%d', '%s') ",
-							   logs->config.log_mvpdrop, sd->status.char_id, monster_id, log_mvp[0], log_mvp[1], mapindex_id2name(sd->mapindex)) )
-	{
-		Sql_ShowDebug(logs->mysql_handle);
-		return;
-	}
+	time(&curtime);
+	strftime(timestring, sizeof(timestring), "%Y-%m-%d %H:%M:%S", localtime(&curtime));
+	len = snprintf(row, sizeof(row), "('%s', '%d', '%d', '%d', '%d', '%s')",
+	               timestring, sd->status.char_id, monster_id, log_mvp[0], log_mvp[1], mapindex_id2name(sd->mapindex));
+	logs->queue_push(LOG_TARGET_MVPDROP, row, len);
 }
 static void log_mvpdrop_sub_txt(struct map_session_data *sd, int monster_id, int *log_mvp)
 {
 	char timestring[255];
+	char line[LOG_RECORD_SIZE];
 	time_t curtime;
-	FILE* logfp;
+	int len;
 
 	nullpo_retv(sd);
 	nullpo_retv(log_mvp);
-	if( ( logfp = fopen(logs->config.log_mvpdrop,"a") ) == NULL )
-		return;
 	time(&curtime);
 	strftime(timestring, sizeof(timestring), "%m/%d/%Y %H:%M:%S", localtime(&curtime));
-	fprintf(logfp,"%s - %s[%d:%d]\t%d\t%d,%d\n", timestring, sd->status.name, sd->status.account_id, sd->status.char_id, monster_id, log_mvp[0], log_mvp[1]);
-	fclose(logfp);
+	len = snprintf(line, sizeof(line), "%s - %s[%d:%d]\t%d\t%d,%d\n", timestring, sd->status.name, sd->status.account_id, sd->status.char_id, monster_id, log_mvp[0], log_mvp[1]);
+	logs->queue_push(LOG_TARGET_MVPDROP, line, len);
+}
+static void log_mvpdrop_sub_journal(struct map_session_data *sd, int monster_id, int *log_mvp)
+{
+	struct log_journal_record record = { 0 };
+
+	nullpo_retv(sd);
+	nullpo_retv(log_mvp);
+	record.target = LOG_TARGET_MVPDROP;
+	record.time = (int64)time(NULL);
+	record.char_id = sd->status.char_id;
+	record.account_id = sd->status.account_id;
+	record.id = monster_id;
+	record.nameid = log_mvp[0];
+	record.amount = log_mvp[1];
+	safestrncpy(record.name, sd->status.name, sizeof(record.name));
+	safestrncpy(record.map, mapindex_id2name(sd->mapindex), sizeof(record.map));
+	logs->journal_write(&record, NULL);
 }
 /// logs MVP monster rewards
 static void log_mvpdrop(struct map_session_data *sd, int monster_id, int *log_mvp)
@@ -314,36 +402,50 @@ static void log_mvpdrop(struct map_session_data *sd, int monster_id, int *log_mv
 
 static void log_atcommand_sub_sql(struct map_session_data *sd, const char *message)
 {
-	struct SqlStmt *stmt;
+	char timestring[255];
+	char esc_name[NAME_LENGTH * 2 + 1];
+	char esc_message[255 * 2 + 1];
+	char row[LOG_RECORD_SIZE];
+	time_t curtime;
+	int len;
 
 	nullpo_retv(sd);
 	nullpo_retv(message);
-	stmt = SQL->StmtMalloc(logs->mysql_handle);
-	if( SQL_SUCCESS != SQL->StmtPrepare(stmt, LOG_QUERY " INTO `%s` (`atcommand_date`, `account_id`, `char_id`, `char_name`, `map`, `command`) VALUES (NOW(), '%d', '%d', ?, '%s', ?)", logs->config.log_gm, sd->status.account_id, sd->status.char_id, mapindex_id2name(sd->mapindex) )
-	   ||  SQL_SUCCESS != SQL->StmtBindParam(stmt, 0, SQLDT_STRING, sd->status.name, strnlen(sd->status.name, NAME_LENGTH))
-	   ||  SQL_SUCCESS != SQL->StmtBindParam(stmt, 1, SQLDT_STRING, message, safestrnlen(message, 255))
-	   ||  SQL_SUCCESS != SQL->StmtExecute(stmt) )
-	{
-		SqlStmt_ShowDebug(stmt);
-		SQL->StmtFree(stmt);
-		return;
-	}
-	SQL->StmtFree(stmt);
+	time(&curtime);
+	strftime(timestring, sizeof(timestring), "%Y-%m-%d %H:%M:%S", localtime(&curtime));
+	SQL->EscapeStringLen(logs->mysql_handle, esc_name, sd->status.name, strnlen(sd->status.name, NAME_LENGTH));
+	SQL->EscapeStringLen(logs->mysql_handle, esc_message, message, safestrnlen(message, 255));
+	len = snprintf(row, sizeof(row), "('%s', '%d', '%d', '%s', '%s', '%s')",
+	               timestring, sd->status.account_id, sd->status.char_id, esc_name, mapindex_id2name(sd->mapindex), esc_message);
+	logs->queue_push(LOG_TARGET_GM, row, len);
 }
 static void log_atcommand_sub_txt(struct map_session_data *sd, const char *message)
 {
 	char timestring[255];
+	char line[LOG_RECORD_SIZE];
 	time_t curtime;
-	FILE* logfp;
+	int len;
 
 	nullpo_retv(sd);
 	nullpo_retv(message);
-	if( ( logfp = fopen(logs->config.log_gm, "a") ) == NULL )
-		return;
 	time(&curtime);
 	strftime(timestring, sizeof(timestring), "%m/%d/%Y %H:%M:%S", localtime(&curtime));
-	fprintf(logfp, "%s - %s[%d]: %s\n", timestring, sd->status.name, sd->status.account_id, message);
-	fclose(logfp);
+	len = snprintf(line, sizeof(line), "%s - %s[%d]: %.255s\n", timestring, sd->status.name, sd->status.account_id, message);
+	logs->queue_push(LOG_TARGET_GM, line, len);
+}
+static void log_atcommand_sub_journal(struct map_session_data *sd, const char *message)
+{
+	struct log_journal_record record = { 0 };
+
+	nullpo_retv(sd);
+	nullpo_retv(message);
+	record.target = LOG_TARGET_GM;
+	record.time = (int64)time(NULL);
+	record.char_id = sd->status.char_id;
+	record.account_id = sd->status.account_id;
+	safestrncpy(record.name, sd->status.name, sizeof(record.name));
+	safestrncpy(record.map, mapindex_id2name(sd->mapindex), sizeof(record.map));
+	logs->journal_write(&record, message);
 }
 /// logs used atcommands
 static void log_atcommand(struct map_session_data *sd, const char *message)
@@ -359,36 +461,50 @@ static void log_atcommand(struct map_session_data *sd, const char *message)
 
 static void log_npc_sub_sql(struct map_session_data *sd, const char *message)
 {
-	struct SqlStmt *stmt;
+	char timestring[255];
+	char esc_name[NAME_LENGTH * 2 + 1];
+	char esc_message[255 * 2 + 1];
+	char row[LOG_RECORD_SIZE];
+	time_t curtime;
+	int len;
 
 	nullpo_retv(sd);
 	nullpo_retv(message);
-	stmt = SQL->StmtMalloc(logs->mysql_handle);
-	if (SQL_SUCCESS != SQL->StmtPrepare(stmt, LOG_QUERY " INTO `%s` (`npc_date`, `account_id`, `char_id`, `char_name`, `map`, `mes`) VALUES (NOW(), '%d', '%d', ?, '%s', ?)", logs->config.log_npc, sd->status.account_id, sd->status.char_id, mapindex_id2name(sd->mapindex) )
-	 || SQL_SUCCESS != SQL->StmtBindParam(stmt, 0, SQLDT_STRING, sd->status.name, strnlen(sd->status.name, NAME_LENGTH))
-	 || SQL_SUCCESS != SQL->StmtBindParam(stmt, 1, SQLDT_STRING, message, safestrnlen(message, 255))
-	 || SQL_SUCCESS != SQL->StmtExecute(stmt)
-	) {
-		SqlStmt_ShowDebug(stmt);
-		SQL->StmtFree(stmt);
-		return;
-	}
-	SQL->StmtFree(stmt);
+	time(&curtime);
+	strftime(timestring, sizeof(timestring), "%Y-%m-%d %H:%M:%S", localtime(&curtime));
+	SQL->EscapeStringLen(logs->mysql_handle, esc_name, sd->status.name, strnlen(sd->status.name, NAME_LENGTH));
+	SQL->EscapeStringLen(logs->mysql_handle, esc_message, message, safestrnlen(message, 255));
+	len = snprintf(row, sizeof(row), "('%s', '%d', '%d', '%s', '%s', '%s')",
+	               timestring, sd->status.account_id, sd->status.char_id, esc_name, mapindex_id2name(sd->mapindex), esc_message);
+	logs->queue_push(LOG_TARGET_NPC, row, len);
 }
 static void log_npc_sub_txt(struct map_session_data *sd, const char *message)
 {
 	char timestring[255];
+	char line[LOG_RECORD_SIZE];
 	time_t curtime;
-	FILE* logfp;
+	int len;
 
 	nullpo_retv(sd);
 	nullpo_retv(message);
-	if( ( logfp = fopen(logs->config.log_npc, "a") ) == NULL )
-		return;
 	time(&curtime);
 	strftime(timestring, sizeof(timestring), "%m/%d/%Y %H:%M:%S", localtime(&curtime));
-	fprintf(logfp, "%s - %s[%d]: %s\n", timestring, sd->status.name, sd->status.account_id, message);
-	fclose(logfp);
+	len = snprintf(line, sizeof(line), "%s - %s[%d]: %.255s\n", timestring, sd->status.name, sd->status.account_id, message);
+	logs->queue_push(LOG_TARGET_NPC, line, len);
+}
+static void log_npc_sub_journal(struct map_session_data *sd, const char *message)
+{
+	struct log_journal_record record = { 0 };
+
+	nullpo_retv(sd);
+	nullpo_retv(message);
+	record.target = LOG_TARGET_NPC;
+	record.time = (int64)time(NULL);
+	record.char_id = sd->status.char_id;
+	record.account_id = sd->status.account_id;
+	safestrncpy(record.name, sd->status.name, sizeof(record.name));
+	safestrncpy(record.map, mapindex_id2name(sd->mapindex), sizeof(record.map));
+	logs->journal_write(&record, message);
 }
 /// logs messages passed to script command 'logmes'
 static void log_npc(struct map_session_data *sd, const char *message)
@@ -416,21 +532,22 @@ static void log_npc(struct map_session_data *sd, const char *message)
  */
 static void log_chat_sub_sql(e_log_chat_type type, int type_id, int src_charid, int src_accid, const char *mapname, int x, int y, const char *dst_charname, const char *message)
 {
-	struct SqlStmt* stmt;
+	char timestring[255];
+	char esc_name[NAME_LENGTH * 2 + 1];
+	char esc_message[CHAT_SIZE_MAX * 2 + 1];
+	char row[LOG_RECORD_SIZE];
+	time_t curtime;
+	int len;
 
 	nullpo_retv(dst_charname);
 	nullpo_retv(message);
-	stmt = SQL->StmtMalloc(logs->mysql_handle);
-	if( SQL_SUCCESS != SQL->StmtPrepare(stmt, LOG_QUERY " INTO `%s` (`time`, `type`, `type_id`, `src_charid`, `src_accountid`, `src_map`, `src_map_x`, `src_map_y`, `dst_charname`, `message`) VALUES (NOW(), '%c', '%d', '%d', '%d', '%s', '%d', '%d', ?, ?)", logs->config.log_chat, logs->chattype2char(type), type_id, src_charid, src_accid, mapname, x, y)
-	 || SQL_SUCCESS != SQL->StmtBindParam(stmt, 0, SQLDT_STRING, dst_charname, safestrnlen(dst_charname, NAME_LENGTH))
-	 || SQL_SUCCESS != SQL->StmtBindParam(stmt, 1, SQLDT_STRING, message, safestrnlen(message, CHAT_SIZE_MAX))
-	 || SQL_SUCCESS != SQL->StmtExecute(stmt)
-	) {
-		SqlStmt_ShowDebug(stmt);
-		SQL->StmtFree(stmt);
-		return;
-	}
-	SQL->StmtFree(stmt);
+	time(&curtime);
+	strftime(timestring, sizeof(timestring), "%Y-%m-%d %H:%M:%S", localtime(&curtime));
+	SQL->EscapeStringLen(logs->mysql_handle, esc_name, dst_charname, safestrnlen(dst_charname, NAME_LENGTH));
+	SQL->EscapeStringLen(logs->mysql_handle, esc_message, message, safestrnlen(message, CHAT_SIZE_MAX));
+	len = snprintf(row, sizeof(row), "('%s', '%c', '%d', '%d', '%d', '%s', '%d', '%d', '%s', '%s')",
+	               timestring, logs->chattype2char(type), type_id, src_charid, src_accid, mapname, x, y, esc_name, esc_message);
+	logs->queue_push(LOG_TARGET_CHAT, row, len);
 }
 
 /**
@@ -449,18 +566,50 @@ static void log_chat_sub_sql(e_log_chat_type type, int type_id, int src_charid,
 static void log_chat_sub_txt(e_log_chat_type type, int type_id, int src_charid, int src_accid, const char *mapname, int x, int y, const char *dst_charname, const char *message)
 {
 	char timestring[255];
+	char line[LOG_RECORD_SIZE];
 	time_t curtime;
-	FILE* logfp;
+	int len;
 
 	nullpo_retv(mapname);
 	nullpo_retv(dst_charname);
 	nullpo_retv(message);
-	if( ( logfp = fopen(logs->config.log_chat, "a") ) == NULL )
-		return;
 	time(&curtime);
 	strftime(timestring, sizeof(timestring), "%m/%d/%Y %H:%M:%S", localtime(&curtime));
-	fprintf(logfp, "%s - %c,%d,%d,%d,%s,%d,%d,%s,%s\n", timestring, logs->chattype2char(type), type_id, src_charid, src_accid, mapname, x, y, dst_charname, message);
-	fclose(logfp);
+	len = snprintf(line, sizeof(line), "%s - %c,%d,%d,%d,%s,%d,%d,%s,%.*s\n", timestring, logs->chattype2char(type), type_id, src_charid, src_accid, mapname, x, y, dst_charname, CHAT_SIZE_MAX, message);
+	logs->queue_push(LOG_TARGET_CHAT, line, len);
+}
+
+/**
+ * Logs a chat message to the binary journal.
+ *
+ * @param type         Chat type.
+ * @param type_id      Additional ID, dependent on chat type (Guild ID, Party ID, etc). Zero when unused.
+ * @param src_charid   Source character ID.
+ * @param src_accid    Source account ID.
+ * @param mapname      Source location map name
+ * @param x            Source location x coordinate
+ * @param y            Source location y coordinate
+ * @param dst_charname Destination character name. Must not be NULL.
+ * @param message      Message to log.
+ */
+static void log_chat_sub_journal(e_log_chat_type type, int type_id, int src_charid, int src_accid, const char *mapname, int x, int y, const char *dst_charname, const char *message)
+{
+	struct log_journal_record record = { 0 };
+
+	nullpo_retv(mapname);
+	nullpo_retv(dst_charname);
+	nullpo_retv(message);
+	record.target = LOG_TARGET_CHAT;
+	record.type = logs->chattype2char(type);
+	record.time = (int64)time(NULL);
+	record.char_id = src_charid;
+	record.account_id = src_accid;
+	record.id = type_id;
+	record.x = (int16)x;
+	record.y = (int16)y;
+	safestrncpy(record.name, dst_charname, sizeof(record.name));
+	safestrncpy(record.map, mapname, sizeof(record.map));
+	logs->journal_write(&record, message);
 }
 
 /**
@@ -515,6 +664,533 @@ static void log_sql_final(void)
 	logs->mysql_handle = NULL;
 }
 
+/// Column list of each log table, indexed by enum log_target
+static const char *log_sql_columns[LOG_TARGET_MAX] = {
+	"(`branch_date`, `account_id`, `char_id`, `char_name`, `map`)",
+	"(`time`, `char_id`, `type`, `nameid`, `amount`, `refine`, `grade`, `card0`, `card1`, `card2`, `card3`, "
+		"`opt_idx0`, `opt_val0`, `opt_idx1`, `opt_val1`, `opt_idx2`, `opt_val2`, `opt_idx3`, `opt_val3`, `opt_idx4`, `opt_val4`, `map`, `unique_id`)",
+	"(`time`, `char_id`, `src_id`, `type`, `amount`, `map`)",
+	"(`mvp_date`, `kill_char_id`, `monster_id`, `prize`, `mvpexp`, `map`)",
+	"(`atcommand_date`, `account_id`, `char_id`, `char_name`, `map`, `command`)",
+	"(`npc_date`, `account_id`, `char_id`, `char_name`, `map`, `mes`)",
+	"(`time`, `type`, `type_id`, `src_charid`, `src_accountid`, `src_map`, `src_map_x`, `src_map_y`, `dst_charname`, `message`)",
+};
+
+/// Background writer of log events
+static struct {
+	struct log_record *ring;      ///< Events waiting to be written
+	int head;                     ///< First waiting event (protected by lock)
+	int count;                    ///< Number of waiting events (protected by lock)
+	char *query;                  ///< Multi-row INSERT buffer (writer thread only)
+	struct Sql *sql_handle;       ///< Log database connection of the writer thread
+	size_t query_size;
+	FILE *files[LOG_TARGET_MAX];  ///< Open text log files (writer thread only)
+	struct thread_handle *writer;
+	struct mutex_data *lock;
+	struct mutex_data *spill_lock;
+	struct cond_data *wake;       ///< Signaled when flush_rows events are waiting or the writer is stopping
+	bool running;
+	bool spilling;                ///< Whether the queue is full and events go to disk (main thread only)
+	uint64 written, spilled, failed;
+	bool error_pending;           ///< Whether last_error wasn't reported yet (protected by lock)
+	char last_error[256];
+} log_queue;
+
+/**
+ * Returns the table (or file) an event target is written to.
+ */
+static const char *log_target_name(enum log_target target)
+{
+	switch (target) {
+	case LOG_TARGET_BRANCH:  return logs->config.log_branch;
+	case LOG_TARGET_PICK:    return logs->config.log_pick;
+	case LOG_TARGET_ZENY:    return logs->config.log_zeny;
+	case LOG_TARGET_MVPDROP: return logs->config.log_mvpdrop;
+	case LOG_TARGET_GM:      return logs->config.log_gm;
+	case LOG_TARGET_NPC:     return logs->config.log_npc;
+	case LOG_TARGET_CHAT:    return logs->config.log_chat;
+	case LOG_TARGET_MAX:     break;
+	}
+	return NULL;
+}
+
+/**
+ * Appends data to a file on disk, used when an event can't go through the queue.
+ * Can be called from the writer thread.
+ *
+ * @param filename Destination file.
+ * @param data     Data to append.
+ * @param len      Length of data.
+ */
+static void log_spill(const char *filename, const char *data, size_t len)
+{
+	FILE *fp;
+
+	nullpo_retv(filename);
+	nullpo_retv(data);
+
+	if (log_queue.spill_lock != NULL)
+		mutex->lock(log_queue.spill_lock);
+	if ((fp = fopen(filename, "a")) != NULL) {
+		fwrite(data, 1, len, fp);
+		fclose(fp);
+	}
+	if (log_queue.spill_lock != NULL)
+		mutex->unlock(log_queue.spill_lock);
+}
+
+/**
+ * Writes a single event right away, when the background writer isn't running.
+ *
+ * @param target Event destination.
+ * @param data   SQL row (for SQL logs) or text line.
+ * @param len    Length of data.
+ */
+static void log_write_sync(enum log_target target, const char *data, int len)
+{
+	nullpo_retv(data);
+
+	if (logs->config.sql_logs) {
+		if (SQL_ERROR == SQL->Query(logs->mysql_handle, LOG_QUERY " INTO `%s` %s VALUES %.*s", logs->target_name(target), log_sql_columns[target], len, data))
+			Sql_ShowDebug(logs->mysql_handle);
+	} else {
+		logs->spill(logs->target_name(target), data, (size_t)len);
+	}
+}
+
+/**
+ * Writes a batch of events from the writer thread.
+ *
+ * SQL events are grouped into one multi-row INSERT per table, text events
+ * are appended to files kept open by the writer and flushed once per batch.
+ * Statements that fail are saved to the spill file so no event is lost.
+ * Only uses the lock, libc and SQL->QueryRaw (no memmgr or console output).
+ *
+ * @param records Events to write.
+ * @param count   Number of events.
+ */
+static void log_queue_write(struct log_record *records, int count)
+{
+	int i, t;
+
+	nullpo_retv(records);
+
+	if (!logs->config.sql_logs) {
+		for (i = 0; i < count; i++) {
+			t = records[i].target;
+			if (log_queue.files[t] == NULL && (log_queue.files[t] = fopen(logs->target_name(t), "a")) == NULL)
+				continue;
+			fwrite(records[i].data, 1, records[i].len, log_queue.files[t]);
+		}
+		for (t = 0; t < LOG_TARGET_MAX; t++) {
+			if (log_queue.files[t] != NULL)
+				fflush(log_queue.files[t]);
+		}
+		return;
+	}
+
+	for (t = 0; t < LOG_TARGET_MAX; t++) {
+		size_t header_len = 0, len = 0;
+		int rows = 0;
+
+		for (i = 0; i <= count; i++) {
+			// write what was gathered once the buffer is full or the batch is over
+			if (rows > 0 && (i == count || (records[i].target == t && len + records[i].len + 3 > log_queue.query_size))) {
+				char error[256];
+				if (SQL_ERROR == SQL->QueryRaw(log_queue.sql_handle, log_queue.query, len, error, sizeof(error))) {
+					log_queue.query[len++] = ';';
+					log_queue.query[len++] = '\n';
+					logs->spill(logs->config.spill_file, log_queue.query, len);
+					mutex->lock(log_queue.lock);
+					log_queue.failed += rows;
+					log_queue.error_pending = true;
+					safestrncpy(log_queue.last_error, error, sizeof(log_queue.last_error));
+					mutex->unlock(log_queue.lock);
+				}
+				rows = 0;
+			}
+			if (i == count || records[i].target != t)
+				continue;
+			if (rows == 0) {
+				if (header_len == 0)
+					header_len = (size_t)snprintf(log_queue.query, log_queue.query_size, LOG_QUERY " INTO `%s` %s VALUES ", logs->target_name(t), log_sql_columns[t]);
+				len = header_len;
+			} else {
+				log_queue.query[len++] = ',';
+			}
+			memcpy(log_queue.query + len, records[i].data, records[i].len);
+			len += records[i].len;
+			rows++;
+		}
+	}
+}
+
+/**
+ * Background writer thread.
+ *
+ * Sleeps until flush_rows events are waiting or flush_interval ms elapsed,
+ * then writes everything that is waiting. Events are written straight
+ * from the ring: the main thread doesn't touch slots until head moves past them.
+ * Drains the queue before exiting when the writer is stopped.
+ */
+static void *log_queue_writer(void *param)
+{
+	if (log_queue.sql_handle != NULL)
+		SQL->ThreadInit();
+
+	mutex->lock(log_queue.lock);
+	while (true) {
+		if (log_queue.count < logs->config.flush_rows && log_queue.running)
+			mutex->cond_wait(log_queue.wake, log_queue.lock, logs->config.flush_interval);
+
+		while (log_queue.count > 0) {
+			int head = log_queue.head;
+			int n = min(log_queue.count, min(logs->config.queue_size - head, logs->config.flush_rows));
+
+			mutex->unlock(log_queue.lock);
+			logs->queue_write(&log_queue.ring[head], n);
+			mutex->lock(log_queue.lock);
+
+			log_queue.head = (head + n) % logs->config.queue_size;
+			log_queue.count -= n;
+			log_queue.written += n;
+		}
+
+		if (!log_queue.running)
+			break;
+	}
+	mutex->unlock(log_queue.lock);
+
+	if (log_queue.sql_handle != NULL)
+		SQL->ThreadEnd();
+
+	return NULL;
+}
+
+/**
+ * Queues a formatted log event for the background writer.
+ *
+ * Never blocks on I/O: when the queue is full the event is spilled to disk
+ * (to the spill file for SQL logs, straight to its file for text logs).
+ * Without a writer the event is written right away.
+ *
+ * @param target Event destination.
+ * @param data   SQL row (for SQL logs) or text line.
+ * @param len    Length of data, as returned by snprintf.
+ */
+static void log_queue_push(enum log_target target, const char *data, int len)
+{
+	char error[256];
+	bool report = false;
+
+	nullpo_retv(data);
+	Assert_retv(target >= LOG_TARGET_BRANCH && target < LOG_TARGET_MAX);
+	Assert_retv(len > 0 && len < LOG_RECORD_SIZE);
+
+	if (log_queue.writer == NULL) {
+		logs->write_sync(target, data, len);
+		return;
+	}
+
+	mutex->lock(log_queue.lock);
+	if (log_queue.error_pending) {
+		safestrncpy(error, log_queue.last_error, sizeof(error));
+		log_queue.error_pending = false;
+		report = true;
+	}
+	if (log_queue.count < logs->config.queue_size) {
+		struct log_record *record = &log_queue.ring[(log_queue.head + log_queue.count) % logs->config.queue_size];
+		record->target = target;
+		record->len = len;
+		memcpy(record->data, data, len);
+		if (++log_queue.count == logs->config.flush_rows)
+			mutex->cond_signal(log_queue.wake);
+		mutex->unlock(log_queue.lock);
+		log_queue.spilling = false;
+	} else {
+		mutex->unlock(log_queue.lock);
+		if (!log_queue.spilling) {
+			ShowWarning("log_queue_push: Log queue is full (%d events), writing to disk until the writer catches up.\n", logs->config.queue_size);
+			log_queue.spilling = true;
+		}
+		log_queue.spilled++;
+		if (logs->config.sql_logs) {
+			char query[LOG_RECORD_SIZE + 512];
+			int qlen = snprintf(query, sizeof(query), LOG_QUERY " INTO `%s` %s VALUES %.*s;\n", logs->target_name(target), log_sql_columns[target], len, data);
+			logs->spill(logs->config.spill_file, query, (size_t)cap_value(qlen, 0, (int)sizeof(query) - 1));
+		} else {
+			logs->spill(logs->target_name(target), data, (size_t)len);
+		}
+	}
+
+	if (report)
+		ShowSQL("Log writer: %s (statement saved to '%s')\n", error, logs->config.spill_file);
+}
+
+/**
+ * Starts the background log writer, when enabled.
+ * The writer opens its own log database connection, logs->mysql_handle
+ * stays with the main thread (e.g. to escape strings while formatting rows).
+ */
+static void log_queue_init(void)
+{
+	if (!logs->config.async || logs->config.journal_logs || (logs->config.sql_logs && logs->mysql_handle == NULL))
+		return;
+
+	logs->config.queue_size = max(logs->config.queue_size, 1);
+	logs->config.flush_rows = cap_value(logs->config.flush_rows, 1, logs->config.queue_size);
+	logs->config.flush_interval = max(logs->config.flush_interval, 1);
+
+	memset(&log_queue, 0, sizeof(log_queue));
+	log_queue.ring = aMalloc(sizeof(*log_queue.ring) * logs->config.queue_size);
+	// leaves room for the statement header and the ';\n' added when spilling
+	log_queue.query_size = (size_t)logs->config.flush_rows * (LOG_RECORD_SIZE + 1) + 512;
+	log_queue.query = aMalloc(log_queue.query_size);
+	log_queue.lock = mutex->create();
+	log_queue.spill_lock = mutex->create();
+	log_queue.wake = mutex->cond_create();
+	log_queue.running = true;
+
+	if (logs->config.sql_logs) {
+		log_queue.sql_handle = SQL->Malloc();
+		if (SQL_ERROR == SQL->Connect(log_queue.sql_handle, logs->db_id, logs->db_pw, logs->db_ip, logs->db_port, logs->db_name)) {
+			ShowError("log_queue_init: Failed to connect the log writer to the Log Database, logs will be written synchronously.\n");
+			logs->queue_final();
+			return;
+		}
+		if (map->default_codepage[0] != '\0' && SQL_ERROR == SQL->SetEncoding(log_queue.sql_handle, map->default_codepage))
+			Sql_ShowDebug(log_queue.sql_handle);
+		// pinged by the main thread otherwise
+		SQL->StopKeepalive(log_queue.sql_handle);
+	}
+
+	if ((log_queue.writer = thread->create(logs->queue_writer, NULL)) == NULL) {
+		ShowError("log_queue_init: Failed to start the log writer thread, logs will be written synchronously.\n");
+		logs->queue_final();
+		return;
+	}
+	ShowStatus("Log writer started (queue size: %d, flush every %d events or %d ms).\n", logs->config.queue_size, logs->config.flush_rows, logs->config.flush_interval);
+}
+
+/**
+ * Stops the background log writer after it wrote all waiting events.
+ */
+static void log_queue_final(void)
+{
+	int i;
+
+	if (log_queue.lock == NULL)
+		return;
+
+	if (log_queue.writer != NULL) {
+		mutex->lock(log_queue.lock);
+		log_queue.running = false;
+		mutex->cond_signal(log_queue.wake);
+		mutex->unlock(log_queue.lock);
+		thread->wait(log_queue.writer, NULL);
+		log_queue.writer = NULL;
+
+		if (log_queue.error_pending)
+			ShowSQL("Log writer: %s (statement saved to '%s')\n", log_queue.last_error, logs->config.spill_file);
+		ShowStatus("Log writer stopped: %"PRIu64" events written, %"PRIu64" spilled to disk, %"PRIu64" failed.\n", log_queue.written, log_queue.spilled, log_queue.failed);
+	}
+
+	for (i = 0; i < LOG_TARGET_MAX; i++) {
+		if (log_queue.files[i] != NULL)
+			fclose(log_queue.files[i]);
+	}
+	if (log_queue.sql_handle != NULL)
+		SQL->Free(log_queue.sql_handle);
+	aFree(log_queue.ring);
+	aFree(log_queue.query);
+	mutex->cond_destroy(log_queue.wake);
+	mutex->destroy(log_queue.spill_lock);
+	mutex->destroy(log_queue.lock);
+	memset(&log_queue, 0, sizeof(log_queue));
+}
+
+/// Binary journal segment being written
+static struct {
+	char filename[512];
+	uint8 *base;          ///< Mapped segment, starts with struct log_journal_header
+	size_t size;          ///< Mapped size
+	int sequence;         ///< Number of segments opened since startup
+	time_t retry_time;    ///< No new segment is tried before this time after a failure (0 = no failure)
+	uint64 dropped;       ///< Events lost since the last failure
+#ifdef WIN32
+	HANDLE file;
+	HANDLE mapping;
+#else
+	int fd;
+#endif
+} log_journal;
+
+/**
+ * Returns the SQL column list of the table of an event target.
+ */
+static const char *log_get_sql_columns(enum log_target target)
+{
+	Assert_retr(NULL, target >= LOG_TARGET_BRANCH && target < LOG_TARGET_MAX);
+	return log_sql_columns[target];
+}
+
+/**
+ * Closes the journal segment being written, trimming it to its used size.
+ */
+static void log_journal_close(void)
+{
+	uint64 used;
+
+	if (log_journal.base == NULL)
+		return;
+
+	used = ((struct log_journal_header *)log_journal.base)->used;
+#ifdef WIN32
+	{
+		LARGE_INTEGER end;
+		UnmapViewOfFile(log_journal.base);
+		CloseHandle(log_journal.mapping);
+		end.QuadPart = (LONGLONG)used;
+		if (SetFilePointerEx(log_journal.file, end, NULL, FILE_BEGIN))
+			SetEndOfFile(log_journal.file);
+		CloseHandle(log_journal.file);
+	}
+#else
+	munmap(log_journal.base, log_journal.size);
+	if (ftruncate(log_journal.fd, (off_t)used) != 0)
+		ShowWarning("log_journal_close: Failed to trim journal segment '%s'.\n", log_journal.filename);
+	close(log_journal.fd);
+#endif
+	log_journal.base = NULL;
+}
+
+/**
+ * Closes the journal segment being written and opens a new one.
+ *
+ * Segments are preallocated to journal_segment_size bytes and memory-mapped,
+ * so writing an event is a copy to memory. They are named
+ * <journal_path>-<date>-<time>-<sequence>.hjl, in chronological order.
+ *
+ * @retval false if the new segment couldn't be created.
+ */
+static bool log_journal_rotate(void)
+{
+	char timestring[32];
+	time_t curtime;
+	size_t size = (size_t)logs->config.journal_segment_size;
+	struct log_journal_header *header;
+
+	logs->journal_close();
+
+	time(&curtime);
+	strftime(timestring, sizeof(timestring), "%Y%m%d-%H%M%S", localtime(&curtime));
+	snprintf(log_journal.filename, sizeof(log_journal.filename), "%s-%s-%04d" LOG_JOURNAL_EXT, logs->config.journal_path, timestring, ++log_journal.sequence);
+
+#ifdef WIN32
+	log_journal.file = CreateFileA(log_journal.filename, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (log_journal.file == INVALID_HANDLE_VALUE) {
+		ShowError("log_journal_rotate: Failed to create journal segment '%s'.\n", log_journal.filename);
+		return false;
+	}
+	log_journal.mapping = CreateFileMappingA(log_journal.file, NULL, PAGE_READWRITE, (DWORD)((uint64)size >> 32), (DWORD)(size & 0xFFFFFFFF), NULL);
+	if (log_journal.mapping == NULL) {
+		ShowError("log_journal_rotate: Failed to map journal segment '%s'.\n", log_journal.filename);
+		CloseHandle(log_journal.file);
+		return false;
+	}
+	if ((log_journal.base = MapViewOfFile(log_journal.mapping, FILE_MAP_WRITE, 0, 0, size)) == NULL) {
+		ShowError("log_journal_rotate: Failed to map journal segment '%s'.\n", log_journal.filename);
+		CloseHandle(log_journal.mapping);
+		CloseHandle(log_journal.file);
+		return false;
+	}
+#else
+	if ((log_journal.fd = open(log_journal.filename, O_RDWR | O_CREAT | O_EXCL, 0644)) < 0) {
+		ShowError("log_journal_rotate: Failed to create journal segment '%s'.\n", log_journal.filename);
+		return false;
+	}
+	if (ftruncate(log_journal.fd, (off_t)size) != 0
+	 || (log_journal.base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, log_journal.fd, 0)) == MAP_FAILED) {
+		ShowError("log_journal_rotate: Failed to map journal segment '%s'.\n", log_journal.filename);
+		log_journal.base = NULL;
+		close(log_journal.fd);
+		return false;
+	}
+#endif
+	log_journal.size = size;
+
+	// the file is zero-filled, only the non-zero fields are set
+	header = (struct log_journal_header *)log_journal.base;
+	memcpy(header->magic, LOG_JOURNAL_MAGIC, sizeof(header->magic));
+	header->version = LOG_JOURNAL_VERSION;
+	header->used = sizeof(*header);
+	return true;
+}
+
+/**
+ * Appends a record to the binary journal, opening a new segment when the
+ * current one is full.
+ *
+ * @param record Record to write; size and text_len are filled here.
+ * @param text   Text stored after the record (NULL when unused).
+ */
+static void log_journal_write(struct log_journal_record *record, const char *text)
+{
+	struct log_journal_header *header;
+	size_t size;
+
+	nullpo_retv(record);
+
+	record->text_len = (text != NULL) ? (uint16)safestrnlen(text, CHAT_SIZE_MAX) : 0;
+	size = (sizeof(*record) + record->text_len + 7) & ~(size_t)7;
+	record->size = (uint16)size;
+
+	if (log_journal.base == NULL || ((struct log_journal_header *)log_journal.base)->used + size > log_journal.size) {
+		// After a failure, the events are dropped for a while instead of retrying (and reporting) on each one
+		if (log_journal.retry_time != 0 && time(NULL) < log_journal.retry_time) {
+			log_journal.dropped++;
+			return;
+		}
+		if (!logs->journal_rotate()) {
+			ShowError("log_journal_write: Journal unavailable, events are dropped for the next %d seconds.\n", LOG_JOURNAL_RETRY_INTERVAL);
+			log_journal.retry_time = time(NULL) + LOG_JOURNAL_RETRY_INTERVAL;
+			log_journal.dropped++;
+			return;
+		}
+		if (log_journal.retry_time != 0) {
+			ShowWarning("log_journal_write: Journal available again, %"PRIu64" events were dropped.\n", log_journal.dropped);
+			log_journal.retry_time = 0;
+			log_journal.dropped = 0;
+		}
+	}
+	header = (struct log_journal_header *)log_journal.base;
+
+	memcpy(log_journal.base + header->used, record, sizeof(*record));
+	if (record->text_len > 0)
+		memcpy(log_journal.base + header->used + sizeof(*record), text, record->text_len);
+
+	if (header->count == 0) {
+		header->min_time = header->max_time = record->time;
+		header->min_char_id = header->max_char_id = record->char_id;
+	} else {
+		header->min_time = min(header->min_time, record->time);
+		header->max_time = max(header->max_time, record->time);
+		header->min_char_id = min(header->min_char_id, record->char_id);
+		header->max_char_id = max(header->max_char_id, record->char_id);
+	}
+	header->targets |= 1U << record->target;
+	header->used += size;
+	header->count++;
+}
+
+/**
+ * Closes the binary journal on shutdown.
+ */
+static void log_journal_final(void)
+{
+	logs->journal_close();
+}
+
 /**
  * Initializes logs->config variables
  */
@@ -529,6 +1205,9 @@ static void log_set_defaults(void)
 	//map_log/database default values
 	logs->config.sql_logs = true;
 	// file/table names defaults are defined inside log_config_read_database
+	logs->config.journal_logs = false;
+	safestrncpy(logs->config.journal_path, "log/journal", sizeof(logs->config.journal_path));
+	logs->config.journal_segment_size = 64 * 1024 * 1024;
 
 	//map_log/filter/item default values
 	logs->config.filter = 1;              // logs any item
@@ -536,6 +1215,13 @@ static void log_set_defaults(void)
 	logs->config.rare_items_log   = 100;  // log rare items. drop chance <= 1%
 	logs->config.price_items_log  = 1000; // 1000z
 	logs->config.amount_items_log = 100;
+
+	//map_log/queue default values
+	logs->config.async = true;
+	logs->config.queue_size = 4096;
+	logs->config.flush_rows = 128;
+	logs->config.flush_interval = 1000;
+	safestrncpy(logs->config.spill_file, "log/spilled_logs.sql", sizeof(logs->config.spill_file));
 }
 
 /**
@@ -561,6 +1247,15 @@ static bool log_config_read_database(const char *filename, struct config_t *conf
 		return false;
 	}
 	libconfig->setting_lookup_bool_real(setting, "use_sql", &logs->config.sql_logs);
+	libconfig->setting_lookup_bool_real(setting, "use_journal", &logs->config.journal_logs);
+	libconfig->setting_lookup_mutable_string(setting, "journal_path", logs->config.journal_path, sizeof(logs->config.journal_path));
+	if (libconfig->setting_lookup_int64(setting, "journal_segment_size", &logs->config.journal_segment_size) == CONFIG_TRUE
+	 && (logs->config.journal_segment_size < LOG_JOURNAL_SEGMENT_MIN || logs->config.journal_segment_size > LOG_JOURNAL_SEGMENT_MAX
+	  || (uint64)logs->config.journal_segment_size > SIZE_MAX)) {
+		ShowWarning("log_config_read: Invalid journal_segment_size %"PRId64" in %s, it must be between %d and %"PRId64" bytes. Defaulting to 64 MB.\n",
+		            logs->config.journal_segment_size, filename, LOG_JOURNAL_SEGMENT_MIN, LOG_JOURNAL_SEGMENT_MAX);
+		logs->config.journal_segment_size = 64 * 1024 * 1024;
+	}
 
 	// map_log.database defaults are defined in order to not make unecessary calls to safestrncpy [Panikon]
 	if (libconfig->setting_lookup_mutable_string(setting, "log_branch_db",
@@ -594,6 +1289,34 @@ static bool log_config_read_database(const char *filename, struct config_t *conf
 	return true;
 }
 
+/**
+ * Reads 'map_log/queue' and initializes required variables.
+ * The block is optional, defaults are kept when it's missing.
+ *
+ * @param filename Path to configuration file (used in error and warning messages).
+ * @param config   The current config being parsed.
+ * @param imported Whether the current config is imported from another file.
+ *
+ * @retval false in case of error.
+ */
+static bool log_config_read_queue(const char *filename, struct config_t *config, bool imported)
+{
+	struct config_setting_t *setting = NULL;
+
+	nullpo_retr(false, filename);
+	nullpo_retr(false, config);
+
+	if ((setting = libconfig->lookup(config, "map_log/queue")) == NULL)
+		return true;
+
+	libconfig->setting_lookup_bool_real(setting, "async", &logs->config.async);
+	libconfig->setting_lookup_int(setting, "size", &logs->config.queue_size);
+	libconfig->setting_lookup_int(setting, "flush_rows", &logs->config.flush_rows);
+	libconfig->setting_lookup_int(setting, "flush_interval", &logs->config.flush_interval);
+	libconfig->setting_lookup_mutable_string(setting, "spill_file", logs->config.spill_file, sizeof(logs->config.spill_file));
+	return true;
+}
+
 /**
  * Reads 'map_log/filter/item' and initializes required variables.
  *
@@ -719,11 +1442,20 @@ static bool log_config_read(const char *filename, bool imported)
 		retval = false;
 	if (!log_config_read_filter(filename, &config, imported))
 		retval = false;
+	if (!log_config_read_queue(filename, &config, imported))
+		retval = false;
 
 	if (!HPM->parse_conf(&config, filename, HPCT_LOG, imported))
 		retval = false;
 
-	target = logs->config.sql_logs ? "table" : "file";
+	if (logs->config.journal_logs) {
+		// the journal replaces the SQL and flat file backends
+		logs->config.sql_logs = false;
+		target = "journal";
+		ShowInfo("Logging to binary journal segments '%s-*" LOG_JOURNAL_EXT "'.\n", logs->config.journal_path);
+	} else {
+		target = logs->config.sql_logs ? "table" : "file";
+	}
 
 	if (logs->config.enable_logs && logs->config.filter)
 		ShowInfo("Logging item transactions to %s '%s'.\n", target, logs->config.log_pick);
@@ -764,7 +1496,15 @@ static bool log_config_read(const char *filename, bool imported)
 
 static void log_config_complete(void)
 {
-	if( logs->config.sql_logs ) {
+	if (logs->config.journal_logs) {
+		logs->pick_sub = log_pick_sub_journal;
+		logs->zeny_sub = log_zeny_sub_journal;
+		logs->npc_sub = log_npc_sub_journal;
+		logs->chat_sub = log_chat_sub_journal;
+		logs->atcommand_sub = log_atcommand_sub_journal;
+		logs->branch_sub = log_branch_sub_journal;
+		logs->mvpdrop_sub = log_mvpdrop_sub_journal;
+	} else if( logs->config.sql_logs ) {
 		logs->pick_sub = log_pick_sub_sql;
 		logs->zeny_sub = log_zeny_sub_sql;
 		logs->npc_sub = log_npc_sub_sql;
@@ -814,6 +1554,21 @@ void log_defaults(void)
 	logs->sql_init = log_sql_init;
 	logs->sql_final = log_sql_final;
 
+	logs->journal_rotate = log_journal_rotate;
+	logs->journal_close = log_journal_close;
+	logs->journal_write = log_journal_write;
+	logs->journal_final = log_journal_final;
+	logs->get_sql_columns = log_get_sql_columns;
+
+	logs->queue_init = log_queue_init;
+	logs->queue_final = log_queue_final;
+	logs->queue_push = log_queue_push;
+	logs->queue_writer = log_queue_writer;
+	logs->queue_write = log_queue_write;
+	logs->write_sync = log_write_sync;
+	logs->spill = log_spill;
+	logs->target_name = log_target_name;
+
 	logs->picktype2char = log_picktype2char;
 	logs->chattype2char = log_chattype2char;
 	logs->should_log_item = should_log_item;
@@ -22,6 +22,7 @@
 #define MAP_LOG_H
 
 #include "common/hercules.h"
+#include "common/mmo.h" // MAX_SLOTS, MAX_ITEM_OPTIONS, NAME_LENGTH, MAP_NAME_LENGTH_EXT
 
 /**
  * Declarations
@@ -43,6 +44,20 @@ struct mob_data;
 	#define LOG_QUERY "INSERT DELAYED"
 #endif
 
+/// Maximum size of a formatted log event (SQL row or text line)
+#define LOG_RECORD_SIZE 1024
+
+/// Binary journal segment identification
+#define LOG_JOURNAL_MAGIC "HJL"
+#define LOG_JOURNAL_VERSION 1
+/// Binary journal segment file extension
+#define LOG_JOURNAL_EXT ".hjl"
+/// Bounds of the journal_segment_size setting, in bytes
+#define LOG_JOURNAL_SEGMENT_MIN (1024 * 1024)
+#define LOG_JOURNAL_SEGMENT_MAX (INT64_C(4) * 1024 * 1024 * 1024)
+/// Seconds to wait before trying to open a new journal segment after a failure
+#define LOG_JOURNAL_RETRY_INTERVAL 60
+
 /**
  * Enumerations
  **/
@@ -96,6 +111,76 @@ typedef enum e_log_pick_type {
 	LOG_TYPE_ALL              = 0xFFFFFFFF,
 } e_log_pick_type;
 
+/// destination of a log event (table or file, depending on 'use_sql')
+enum log_target {
+	LOG_TARGET_BRANCH,
+	LOG_TARGET_PICK,
+	LOG_TARGET_ZENY,
+	LOG_TARGET_MVPDROP,
+	LOG_TARGET_GM,
+	LOG_TARGET_NPC,
+	LOG_TARGET_CHAT,
+	LOG_TARGET_MAX
+};
+
+/// formatted log event waiting in the writer queue
+struct log_record {
+	enum log_target target;
+	int len;
+	char data[LOG_RECORD_SIZE];
+};
+
+#if !defined(sun) && (!defined(__NETBSD__) || __NetBSD_Version__ >= 600000000) // NetBSD 5 and Solaris don't like pragma pack but accept the packed attribute
+#pragma pack(push, 1)
+#endif // not NetBSD < 6 / Solaris
+
+/**
+ * Header at the beginning of each binary journal segment.
+ * Holds the min/max time and char_id of its records, so queries can skip
+ * whole segments without reading them.
+ */
+struct log_journal_header {
+	char magic[4];        ///< LOG_JOURNAL_MAGIC
+	uint32 version;       ///< LOG_JOURNAL_VERSION
+	uint64 used;          ///< Bytes used by the header and records
+	uint32 count;         ///< Number of records
+	uint32 targets;       ///< Bitmask of the targets (1 << enum log_target) present in the segment
+	int64 min_time, max_time;
+	int32 min_char_id, max_char_id;
+} __attribute__((packed));
+
+/**
+ * Binary journal record, shared by all event types (unused fields are zero).
+ * Followed by text_len bytes of text, padded to 8 bytes.
+ */
+struct log_journal_record {
+	uint16 size;          ///< Size of the record and its text
+	uint8 target;         ///< enum log_target
+	char type;            ///< Pick/zeny/chat type character, as in the SQL logs
+	int32 char_id;        ///< Character (chat: source character)
+	int64 time;
+	int32 account_id;
+	int32 id;             ///< Zeny: source char_id, MVP: monster id, chat: type_id
+	int32 nameid;         ///< Pick: item id, MVP: prize item id
+	int32 amount;         ///< Pick/zeny: amount, MVP: experience
+	int16 x, y;           ///< Chat: source coordinates
+	int8 refine;
+	int8 grade;
+	uint16 text_len;      ///< Length of the text (command, logmes or chat message)
+	int32 card[MAX_SLOTS];
+	struct {
+		int16 index;
+		int16 value;
+	} option[MAX_ITEM_OPTIONS];
+	uint64 unique_id;
+	char map[MAP_NAME_LENGTH_EXT];
+	char name[NAME_LENGTH]; ///< Character name (chat: destination name)
+} __attribute__((packed));
+
+#if !defined(sun) && (!defined(__NETBSD__) || __NetBSD_Version__ >= 600000000) // NetBSD 5 and Solaris don't like pragma pack but accept the packed attribute
+#pragma pack(pop)
+#endif // not NetBSD < 6 / Solaris
+
 /// filters for item logging
 typedef enum e_log_filter {
 	LOG_FILTER_NONE     = 0x000,
@@ -124,6 +209,12 @@ struct log_interface {
 		int zeny, chat;
 		bool branch, mvpdrop, commands, npc;
 		char log_branch[64], log_pick[64], log_zeny[64], log_mvpdrop[64], log_gm[64], log_npc[64], log_chat[64];
+		bool journal_logs;
+		char journal_path[256];
+		int64 journal_segment_size;
+		bool async;
+		int queue_size, flush_rows, flush_interval;
+		char spill_file[256];
 	} config;
 	/* */
 	char db_ip[32];
@@ -155,6 +246,21 @@ struct log_interface {
 	void (*sql_init) (void);
 	void (*sql_final) (void);
 
+	bool (*journal_rotate) (void);
+	void (*journal_close) (void);
+	void (*journal_write) (struct log_journal_record *record, const char *text);
+	void (*journal_final) (void);
+	const char *(*get_sql_columns) (enum log_target target);
+
+	void (*queue_init) (void);
+	void (*queue_final) (void);
+	void (*queue_push) (enum log_target target, const char *data, int len);
+	void *(*queue_writer) (void *param);
+	void (*queue_write) (struct log_record *records, int count);
+	void (*write_sync) (enum log_target target, const char *data, int len);
+	void (*spill) (const char *filename, const char *data, size_t len);
+	const char *(*target_name) (enum log_target target);
+
 	char (*picktype2char) (e_log_pick_type type);
 	char (*chattype2char) (e_log_chat_type type);
 	bool (*should_log_item) (int nameid, int amount, int refine_level, struct item_data *id);
@@ -153,6 +153,8 @@ static int map_freeblock(struct block_list *bl)
 	if (map->block_free_lock == 0) {
 		if( bl->type == BL_ITEM )
 			ers_free(map->flooritem_ers, bl);
+		else if (bl->type == BL_MOB)
+			mob->data_free(BL_UCAST(BL_MOB, bl));
 		else
 			aFree(bl);
 		bl = NULL;
@@ -194,6 +196,8 @@ static int map_freeblock_unlock(void)
 #endif
 			if( map->block_free[i]->type == BL_ITEM )
 				ers_free(map->flooritem_ers, map->block_free[i]);
+			else if (map->block_free[i]->type == BL_MOB)
+				mob->data_free(BL_UCAST(BL_MOB, map->block_free[i]));
 			else
 				aFree(map->block_free[i]);
 			map->block_free[i] = NULL;
@@ -298,6 +302,12 @@ static int map_addblock(struct block_list *bl)
 	map->update_cell_bl(bl, true);
 #endif
 
+	if (bl->type == BL_PC) {
+		// Queue the new position for the party and guild minimap dots
+		party->xy_mark(BL_UCAST(BL_PC, bl));
+		guild->xy_mark(BL_UCAST(BL_PC, bl));
+	}
+
 	return 0;
 }
 
@@ -352,6 +362,7 @@ static int map_delblock(struct block_list *bl)
 static int map_moveblock(struct block_list *bl, int x1, int y1, int64 tick)
 {
 	struct status_change *sc = NULL;
+	struct status_change_entry *sce;
 	int x0, y0;
 	int moveblock;
 
@@ -378,8 +389,8 @@ static int map_moveblock(struct block_list *bl, int x1, int y1, int64 tick)
 		status_change_end(bl, SC_NJ_TATAMIGAESHI, INVALID_TIMER);
 		status_change_end(bl, SC_MAGICROD, INVALID_TIMER);
 		status_change_end(bl, SC_SU_STOOP, INVALID_TIMER);
-		if (sc && sc->data[SC_PROPERTYWALK] &&
-			sc->data[SC_PROPERTYWALK]->val3 >= skill->get_maxcount(sc->data[SC_PROPERTYWALK]->val1,sc->data[SC_PROPERTYWALK]->val2) )
+		if (sc && sc_data(sc, SC_PROPERTYWALK) &&
+			sc_data(sc, SC_PROPERTYWALK)->val3 >= skill->get_maxcount(sc_data(sc, SC_PROPERTYWALK)->val1,sc_data(sc, SC_PROPERTYWALK)->val2) )
 			status_change_end(bl,SC_PROPERTYWALK,INVALID_TIMER);
 	} else if (bl->type == BL_NPC) {
 		npc->unsetcells(BL_UCAST(BL_NPC, bl));
@@ -401,6 +412,12 @@ static int map_moveblock(struct block_list *bl, int x1, int y1, int64 tick)
 
 		skill->unit_move(bl,tick,3);
 
+		if (sd != NULL) {
+			// Queue the new position for the party and guild minimap dots
+			party->xy_mark(sd);
+			guild->xy_mark(sd);
+		}
+
 		if (sd != NULL && sd->shadowform_id != 0) {
 			//Shadow Form Target Moving
 			struct block_list *d_bl;
@@ -412,46 +429,46 @@ static int map_moveblock(struct block_list *bl, int x1, int y1, int64 tick)
 		}
 
 		if (sc && sc->count) {
-			if (sc->data[SC_DANCING])
-				skill->unit_move_unit_group(skill->id2group(sc->data[SC_DANCING]->val2), bl->m, x1-x0, y1-y0);
+			if ((sce = sc_data(sc, SC_DANCING)) != NULL)
+				skill->unit_move_unit_group(skill->id2group(sce->val2), bl->m, x1-x0, y1-y0);
 			else {
-				if (sc->data[SC_CLOAKING])
-					skill->check_cloaking(bl, sc->data[SC_CLOAKING]);
-				if (sc->data[SC_WARM])
-					skill->unit_move_unit_group(skill->id2group(sc->data[SC_WARM]->val4), bl->m, x1-x0, y1-y0);
-				if (sc->data[SC_BANDING])
-					skill->unit_move_unit_group(skill->id2group(sc->data[SC_BANDING]->val4), bl->m, x1-x0, y1-y0);
-
-				if (sc->data[SC_NEUTRALBARRIER_MASTER])
-					skill->unit_move_unit_group(skill->id2group(sc->data[SC_NEUTRALBARRIER_MASTER]->val2), bl->m, x1-x0, y1-y0);
-				else if (sc->data[SC_STEALTHFIELD_MASTER])
-					skill->unit_move_unit_group(skill->id2group(sc->data[SC_STEALTHFIELD_MASTER]->val2), bl->m, x1-x0, y1-y0);
-
-				if( sc->data[SC__SHADOWFORM] ) {//Shadow Form Caster Moving
+				if (sc_data(sc, SC_CLOAKING))
+					skill->check_cloaking(bl, sc_data(sc, SC_CLOAKING));
+				if ((sce = sc_data(sc, SC_WARM)) != NULL)
+					skill->unit_move_unit_group(skill->id2group(sce->val4), bl->m, x1-x0, y1-y0);
+				if ((sce = sc_data(sc, SC_BANDING)) != NULL)
+					skill->unit_move_unit_group(skill->id2group(sce->val4), bl->m, x1-x0, y1-y0);
+
+				if ((sce = sc_data(sc, SC_NEUTRALBARRIER_MASTER)) != NULL)
+					skill->unit_move_unit_group(skill->id2group(sce->val2), bl->m, x1-x0, y1-y0);
+				else if ((sce = sc_data(sc, SC_STEALTHFIELD_MASTER)) != NULL)
+					skill->unit_move_unit_group(skill->id2group(sce->val2), bl->m, x1-x0, y1-y0);
+
+				if( (sce = sc_data(sc, SC__SHADOWFORM)) != NULL ) {//Shadow Form Caster Moving
 					struct block_list *d_bl;
-					if( (d_bl = map->id2bl(sc->data[SC__SHADOWFORM]->val2)) == NULL || !check_distance_bl(bl,d_bl,10) )
+					if( (d_bl = map->id2bl(sce->val2)) == NULL || !check_distance_bl(bl,d_bl,10) )
 						status_change_end(bl,SC__SHADOWFORM,INVALID_TIMER);
 				}
 
-				if (sc->data[SC_PROPERTYWALK]
-				 && sc->data[SC_PROPERTYWALK]->val3 < skill->get_maxcount(sc->data[SC_PROPERTYWALK]->val1,sc->data[SC_PROPERTYWALK]->val2)
+				if ((sce = sc_data(sc, SC_PROPERTYWALK)) != NULL
+				 && sce->val3 < skill->get_maxcount(sce->val1,sce->val2)
 				 && map->find_skill_unit_oncell(bl,bl->x,bl->y,SO_ELECTRICWALK,NULL,0) == NULL
 				 && map->find_skill_unit_oncell(bl,bl->x,bl->y,SO_FIREWALK,NULL,0) == NULL
-				 && skill->unitsetting(bl,sc->data[SC_PROPERTYWALK]->val1,sc->data[SC_PROPERTYWALK]->val2,x0, y0,0)
+				 && skill->unitsetting(bl,sce->val1,sce->val2,x0, y0,0)
 				) {
-					sc->data[SC_PROPERTYWALK]->val3++;
+					sce->val3++;
 				}
 			}
 			/* Guild Aura Moving */
 			if (sd != NULL && sd->state.gmaster_flag) {
-				if (sc->data[SC_LEADERSHIP])
-					skill->unit_move_unit_group(skill->id2group(sc->data[SC_LEADERSHIP]->val4), bl->m, x1-x0, y1-y0);
-				if (sc->data[SC_GLORYWOUNDS])
-					skill->unit_move_unit_group(skill->id2group(sc->data[SC_GLORYWOUNDS]->val4), bl->m, x1-x0, y1-y0);
-				if (sc->data[SC_SOULCOLD])
-					skill->unit_move_unit_group(skill->id2group(sc->data[SC_SOULCOLD]->val4), bl->m, x1-x0, y1-y0);
-				if (sc->data[SC_HAWKEYES])
-					skill->unit_move_unit_group(skill->id2group(sc->data[SC_HAWKEYES]->val4), bl->m, x1-x0, y1-y0);
+				if ((sce = sc_data(sc, SC_LEADERSHIP)) != NULL)
+					skill->unit_move_unit_group(skill->id2group(sce->val4), bl->m, x1-x0, y1-y0);
+				if ((sce = sc_data(sc, SC_GLORYWOUNDS)) != NULL)
+					skill->unit_move_unit_group(skill->id2group(sce->val4), bl->m, x1-x0, y1-y0);
+				if ((sce = sc_data(sc, SC_SOULCOLD)) != NULL)
+					skill->unit_move_unit_group(skill->id2group(sce->val4), bl->m, x1-x0, y1-y0);
+				if ((sce = sc_data(sc, SC_HAWKEYES)) != NULL)
+					skill->unit_move_unit_group(skill->id2group(sce->val4), bl->m, x1-x0, y1-y0);
 			}
 		}
 	} else if (bl->type == BL_NPC) {
@@ -1987,6 +2004,7 @@ static void map_addiddb(struct block_list *bl)
 	} else if (bl->type == BL_MOB) {
 		struct mob_data *md = BL_UCAST(BL_MOB, bl);
 		idb_put(map->mobid_db,bl->id,bl);
+		mob->ai_add(md);
 
 		if (md->state.boss == BTYPE_MVP)
 			idb_put(map->bossid_db, bl->id, bl);
@@ -2012,6 +2030,7 @@ static void map_deliddb(struct block_list *bl)
 	} else if (bl->type == BL_MOB) {
 		idb_remove(map->mobid_db,bl->id);
 		idb_remove(map->bossid_db,bl->id);
+		mob->ai_remove(BL_UCAST(BL_MOB, bl));
 	}
 
 	if( bl->type & BL_REGEN )
@@ -2026,6 +2045,7 @@ static void map_deliddb(struct block_list *bl)
 static int map_quit(struct map_session_data *sd)
 {
 	int i;
+	const struct status_change_entry *sce;
 
 	nullpo_ret(sd);
 
@@ -2081,14 +2101,12 @@ static int map_quit(struct map_session_data *sd)
 	//(changing map-servers invokes unit_free but bypasses map->quit)
 	if( sd->sc.count ) {
 		//Status that are not saved...
-		for(i=0; i < SC_MAX; i++){
+		for (i = sc_next(&sd->sc, SC_NONE); i < SC_MAX; i = sc_next(&sd->sc, i)) {
 			if ( status->get_sc_type(i)&SC_NO_SAVE ) {
-				if ( !sd->sc.data[i] )
-					continue;
 				switch( i ){
 					case SC_ENDURE:
 					case SC_GDSKILL_REGENERATION:
-						if( !sd->sc.data[i]->val4 )
+						if ((sce = sc_data(&sd->sc, i)) == NULL || sce->val4 == 0)
 							break;
 						FALLTHROUGH
 					default:
@@ -2135,6 +2153,7 @@ static int map_quit(struct map_session_data *sd)
 	}
 
 	if( sd->state.vending ) {
+		vending->index_remove(sd);
 		idb_remove(vending->db, sd->status.char_id);
 	}
 
@@ -6569,6 +6588,8 @@ int do_final(void)
 	db_destroy(map->iwall_db);
 	db_destroy(map->regen_db);
 
+	logs->queue_final();
+	logs->journal_final();
 	map->sql_close();
 	ers_destroy(map->iterator_ers);
 	ers_destroy(map->flooritem_ers);
@@ -6908,6 +6929,51 @@ static CMDLINEARG(loadscript)
 	return true;
 }
 
+/**
+ * Starts parsing the biggest database files in background.
+ *
+ * Their loaders run later during the init sequence and pick up the parsed
+ * files instead of parsing them again (@see libconfig->prefetch).
+ */
+static void map_prefetch_db(void)
+{
+	const char *filenames[] = {
+		DBPATH"item_db.conf",
+		"item_db2.conf",
+		DBPATH"item_combo_db.conf",
+		DBPATH"item_group.conf",
+		DBPATH"item_chain.conf",
+		DBPATH"skill_db.conf",
+		"skill_db2.conf",
+		DBPATH"mob_db.conf",
+		"mob_db2.conf",
+		DBPATH"mob_skill_db.conf",
+		"mob_skill_db2.conf",
+		DBPATH_RE"job_db.conf",
+	};
+
+	for (int i = 0; i < ARRAYLENGTH(filenames); i++)
+		libconfig->prefetch_db(filenames[i]);
+}
+
+/**
+ * Reports how long loading a subsystem took.
+ *
+ * @param name    Subsystem name, for the report.
+ * @param tick    Tick when loading started, updated to the current tick.
+ * @param minimal Whether the server is starting in minimal mode (nothing is reported).
+ */
+static void map_show_load_time(const char *name, int64 *tick, bool minimal)
+{
+	nullpo_retv(name);
+	nullpo_retv(tick);
+
+	int64 now = timer->gettick_nocache();
+	if (!minimal)
+		ShowInfo("Loaded '"CL_WHITE"%s"CL_RESET"' in "CL_WHITE"%"PRId64""CL_RESET" ms.\n", name, now - *tick);
+	*tick = now;
+}
+
 /**
  * Defines the local command line arguments
  */
@@ -7037,6 +7103,7 @@ int do_init(int argc, char *argv[])
 		map->sql_init();
 		if (logs->config.sql_logs)
 			logs->sql_init();
+		logs->queue_init();
 	}
 
 	i = mapindex->init();
@@ -7074,30 +7141,52 @@ int do_init(int argc, char *argv[])
 	clif->init(minimal);
 	ircbot->init(minimal);
 	script->init(minimal);
+	if (!minimal)
+		map->prefetch_db();
+	int64 load_tick = timer->gettick_nocache();
 	itemdb->init(minimal);
+	map->show_load_time("itemdb", &load_tick, minimal);
 	clan->init(minimal);
+	load_tick = timer->gettick_nocache();
 	skill->init(minimal);
+	map->show_load_time("skill", &load_tick, minimal);
 	if (!minimal)
 		map->read_zone_db();/* read after item and skill initialization */
+	load_tick = timer->gettick_nocache();
 	mob->init(minimal);
+	map->show_load_time("mob", &load_tick, minimal);
 	pc->init(minimal);
+	map->show_load_time("pc", &load_tick, minimal);
 	refine->init(minimal);
+	map->show_load_time("refine", &load_tick, minimal);
 	grader->init(minimal);
+	map->show_load_time("grader", &load_tick, minimal);
 	status->init(minimal);
+	map->show_load_time("status", &load_tick, minimal);
 	party->init(minimal);
 	guild->init(minimal);
 	gstorage->init(minimal);
+	load_tick = timer->gettick_nocache();
 	pet->init(minimal);
+	map->show_load_time("pet", &load_tick, minimal);
 	homun->init(minimal);
+	map->show_load_time("homun", &load_tick, minimal);
 	mercenary->init(minimal);
+	map->show_load_time("mercenary", &load_tick, minimal);
 	elemental->init(minimal);
+	map->show_load_time("elemental", &load_tick, minimal);
 	quest->init(minimal);
+	map->show_load_time("quest", &load_tick, minimal);
 	achievement->init(minimal);
+	map->show_load_time("achievement", &load_tick, minimal);
 	stylist->init(minimal);
 	macro->init(minimal);
 	enchantui->init(minimal);
 	goldpc->init(minimal);
+	load_tick = timer->gettick_nocache();
 	npc->init(minimal);
+	map->show_load_time("npc", &load_tick, minimal);
+	libconfig->prefetch_clear();
 	unit->init(minimal);
 	bg->init(minimal);
 	duel->init(minimal);
@@ -7422,6 +7511,8 @@ PRAGMA_GCC9(GCC diagnostic pop)
 	map->zone_str2skillid = map_zone_str2skillid;
 	map->zone_bl_type = map_zone_bl_type;
 	map->read_zone_db = read_map_zone_db;
+	map->prefetch_db = map_prefetch_db;
+	map->show_load_time = map_show_load_time;
 	map->nick_db_final = nick_db_final;
 	map->cleanup_db_sub = cleanup_db_sub;
 	map->abort_sub = map_abort_sub;
@@ -1521,6 +1521,8 @@ END_ZEROED_BLOCK;
 	unsigned short (*zone_str2skillid) (const char *name);
 	enum bl_type (*zone_bl_type) (const char *entry, enum map_zone_skill_subtype *subtype);
 	void (*read_zone_db) (void);
+	void (*prefetch_db) (void);
+	void (*show_load_time) (const char *name, int64 *tick, bool minimal);
 	int (*nick_db_final) (union DBKey key, struct DBData *data, va_list args);
 	int (*cleanup_db_sub) (union DBKey key, struct DBData *data, va_list va);
 	int (*abort_sub) (struct map_session_data *sd, va_list ap);
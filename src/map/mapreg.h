@@ -28,11 +28,16 @@
 /** Forward Declarations **/
 struct config_setting_t;
 struct eri;
+struct SqlStmt;
 
 #ifndef MAPREG_AUTOSAVE_INTERVAL
 #define MAPREG_AUTOSAVE_INTERVAL (300 * 1000) //!< Interval for auto-saving permanent global variables to the database in milliseconds.
 #endif /** MAPREG_AUTOSAVE_INTERVAL **/
 
+#ifndef MAPREG_SAVE_BATCH
+#define MAPREG_SAVE_BATCH 100 //!< Maximum amount of variables written by a single INSERT query when saving.
+#endif /** MAPREG_SAVE_BATCH **/
+
 /** Global variable structure. **/
 struct mapreg_save {
 	int64 uid;         //!< The variable's unique ID.
@@ -44,12 +49,20 @@ struct mapreg_save {
 	bool save;         //!< Whether the variable's save operation is pending.
 };
 
+/** Permanent global variable pending deletion from the database. **/
+struct mapreg_delete {
+	int64 uid;       //!< The variable's unique ID.
+	bool is_string;  //!< Whether the variable is stored in the string table.
+};
+
 /** The mapreg interface structure. **/
 struct mapreg_interface {
 	/** Interface variables. **/
 	struct eri *ers;    //!< Entry manager for global variables.
 	struct reg_db regs; //!< Generic database for global variables.
 	bool dirty;         //!< Whether there are modified global variables to be saved.
+	VECTOR_DECL(int64) dirty_list;                 //!< Unique IDs of the variables pending a save (may hold stale entries).
+	VECTOR_DECL(struct mapreg_delete) delete_list; //!< Variables pending deletion from the database.
 	bool skip_insert;   //!< Whether to skip inserting the variable into the SQL database in mapreg_set_*_db().
 	char num_db[32];    //!< Name of SQL table which holds permanent global integer variables.
 	char str_db[32];    //!< Name of SQL table which holds permanent global string variables.
@@ -69,6 +82,10 @@ struct mapreg_interface {
 	void (*save_num_db) (const char *name, unsigned int index, int value);
 	void (*save_str_db) (const char *name, unsigned int index, const char *value);
 	void (*save) (void);
+	void (*mark_dirty) (struct mapreg_save *var);
+	void (*queue_delete) (int64 uid, bool is_string);
+	bool (*save_deletes) (void);
+	bool (*save_batch) (struct SqlStmt **stmt, int *prepared, bool is_string, struct mapreg_save **vars, int count);
 	int (*save_timer) (int tid, int64 tick, int id, intptr_t data);
 	int (*destroyreg) (union DBKey key, struct DBData *data, va_list ap);
 	void (*reload) (void);
@@ -92,10 +92,8 @@ static bool mapreg_set_num_db(int64 uid, const char *name, unsigned int index, i
 	if (var != NULL) {
 		var->u.i = value;
 
-		if (script->is_permanent_variable(name)) {
-			var->save = true;
-			mapreg->dirty = true;
-		}
+		if (script->is_permanent_variable(name))
+			mapreg->mark_dirty(var);
 
 		return true;
 	}
@@ -111,28 +109,9 @@ static bool mapreg_set_num_db(int64 uid, const char *name, unsigned int index, i
 	var->is_string = false;
 	i64db_put(mapreg->regs.vars, uid, var);
 
-	if (script->is_permanent_variable(name) && !mapreg->skip_insert) {
-		struct SqlStmt *stmt = SQL->StmtMalloc(map->mysql_handle);
-
-		if (stmt == NULL) {
-			SqlStmt_ShowDebug(stmt);
-			return false;
-		}
-
-		const char *query = "INSERT INTO `%s` (`key`, `index`, `value`) VALUES (?, ?, ?)";
-
-		if (SQL_ERROR == SQL->StmtPrepare(stmt, query, mapreg->num_db)
-		    || SQL_ERROR == SQL->StmtBindParam(stmt, 0, SQLDT_STRING, name, strlen(name))
-		    || SQL_ERROR == SQL->StmtBindParam(stmt, 1, SQLDT_UINT32, &index, sizeof(index))
-		    || SQL_ERROR == SQL->StmtBindParam(stmt, 2, SQLDT_INT32, &value, sizeof(value))
-		    || SQL_ERROR == SQL->StmtExecute(stmt)) {
-			SqlStmt_ShowDebug(stmt);
-			SQL->StmtFree(stmt);
-			return false;
-		}
-
-		SQL->StmtFree(stmt);
-	}
+	// The row is written by the next mapreg->save() call.
+	if (script->is_permanent_variable(name) && !mapreg->skip_insert)
+		mapreg->mark_dirty(var);
 
 	return true;
 }
@@ -154,6 +133,10 @@ static bool mapreg_delete_num_db(int64 uid, const char *name, unsigned int index
 
 	struct mapreg_save *var = i64db_get(mapreg->regs.vars, uid);
 
+	// Variables which are not loaded have no row to delete.
+	if (var != NULL && script->is_permanent_variable(name))
+		mapreg->queue_delete(uid, false);
+
 	if (var != NULL)
 		ers_free(mapreg->ers, var);
 
@@ -162,28 +145,6 @@ static bool mapreg_delete_num_db(int64 uid, const char *name, unsigned int index
 
 	i64db_remove(mapreg->regs.vars, uid);
 
-	if (script->is_permanent_variable(name)) {
-		struct SqlStmt *stmt = SQL->StmtMalloc(map->mysql_handle);
-
-		if (stmt == NULL) {
-			SqlStmt_ShowDebug(stmt);
-			return false;
-		}
-
-		const char *query = "DELETE FROM `%s` WHERE `key`=? AND `index`=?";
-
-		if (SQL_ERROR == SQL->StmtPrepare(stmt, query, mapreg->num_db)
-		    || SQL_ERROR == SQL->StmtBindParam(stmt, 0, SQLDT_STRING, name, strlen(name))
-		    || SQL_ERROR == SQL->StmtBindParam(stmt, 1, SQLDT_UINT32, &index, sizeof(index))
-		    || SQL_ERROR == SQL->StmtExecute(stmt)) {
-			SqlStmt_ShowDebug(stmt);
-			SQL->StmtFree(stmt);
-			return false;
-		}
-
-		SQL->StmtFree(stmt);
-	}
-
 	return true;
 }
 
@@ -237,10 +198,8 @@ static bool mapreg_set_str_db(int64 uid, const char *name, unsigned int index, c
 
 		var->u.str = aStrdup(value);
 
-		if (script->is_permanent_variable(name)) {
-			var->save = true;
-			mapreg->dirty = true;
-		}
+		if (script->is_permanent_variable(name))
+			mapreg->mark_dirty(var);
 
 		return true;
 	}
@@ -256,28 +215,9 @@ static bool mapreg_set_str_db(int64 uid, const char *name, unsigned int index, c
 	var->is_string = true;
 	i64db_put(mapreg->regs.vars, uid, var);
 
-	if (script->is_permanent_variable(name) && !mapreg->skip_insert) {
-		struct SqlStmt *stmt = SQL->StmtMalloc(map->mysql_handle);
-
-		if (stmt == NULL) {
-			SqlStmt_ShowDebug(stmt);
-			return false;
-		}
-
-		const char *query = "INSERT INTO `%s` (`key`, `index`, `value`) VALUES (?, ?, ?)";
-
-		if (SQL_ERROR == SQL->StmtPrepare(stmt, query, mapreg->str_db)
-		    || SQL_ERROR == SQL->StmtBindParam(stmt, 0, SQLDT_STRING, name, strlen(name))
-		    || SQL_ERROR == SQL->StmtBindParam(stmt, 1, SQLDT_UINT32, &index, sizeof(index))
-		    || SQL_ERROR == SQL->StmtBindParam(stmt, 2, SQLDT_STRING, value, strlen(value))
-		    || SQL_ERROR == SQL->StmtExecute(stmt)) {
-			SqlStmt_ShowDebug(stmt);
-			SQL->StmtFree(stmt);
-			return false;
-		}
-
-		SQL->StmtFree(stmt);
-	}
+	// The row is written by the next mapreg->save() call.
+	if (script->is_permanent_variable(name) && !mapreg->skip_insert)
+		mapreg->mark_dirty(var);
 
 	return true;
 }
@@ -299,6 +239,10 @@ static bool mapreg_delete_str_db(int64 uid, const char *name, unsigned int index
 
 	struct mapreg_save *var = i64db_get(mapreg->regs.vars, uid);
 
+	// Variables which are not loaded have no row to delete.
+	if (var != NULL && script->is_permanent_variable(name))
+		mapreg->queue_delete(uid, true);
+
 	if (var != NULL) {
 		if (var->u.str != NULL)
 			aFree(var->u.str);
@@ -311,28 +255,6 @@ static bool mapreg_delete_str_db(int64 uid, const char *name, unsigned int index
 
 	i64db_remove(mapreg->regs.vars, uid);
 
-	if (script->is_permanent_variable(name)) {
-		struct SqlStmt *stmt = SQL->StmtMalloc(map->mysql_handle);
-
-		if (stmt == NULL) {
-			SqlStmt_ShowDebug(stmt);
-			return false;
-		}
-
-		const char *query = "DELETE FROM `%s` WHERE `key`=? AND `index`=?";
-
-		if (SQL_ERROR == SQL->StmtPrepare(stmt, query, mapreg->str_db)
-		    || SQL_ERROR == SQL->StmtBindParam(stmt, 0, SQLDT_STRING, name, strlen(name))
-		    || SQL_ERROR == SQL->StmtBindParam(stmt, 1, SQLDT_UINT32, &index, sizeof(index))
-		    || SQL_ERROR == SQL->StmtExecute(stmt)) {
-			SqlStmt_ShowDebug(stmt);
-			SQL->StmtFree(stmt);
-			return false;
-		}
-
-		SQL->StmtFree(stmt);
-	}
-
 	return true;
 }
 
@@ -540,32 +462,239 @@ static void mapreg_save_str_db(const char *name, unsigned int index, const char
 }
 
 /**
- * Saves permanent global variables to the database.
+ * Flags a permanent global variable as modified and queues it for the next save.
+ *
+ * @param var The modified variable.
  *
  **/
-static void mapreg_save(void)
+static void mapreg_mark_dirty(struct mapreg_save *var)
 {
-	if (mapreg->dirty) {
-		struct DBIterator *iter = db_iterator(mapreg->regs.vars);
-		struct mapreg_save *var = NULL;
+	nullpo_retv(var);
+
+	if (var->save)
+		return;
 
-		for (var = dbi_first(iter); dbi_exists(iter); var = dbi_next(iter)) {
-			if (var->save) {
-				int index = script_getvaridx(var->uid);
-				const char *name = script->get_str(script_getvarid(var->uid));
+	var->save = true;
+	VECTOR_ENSURE(mapreg->dirty_list, 1, 64);
+	VECTOR_PUSH(mapreg->dirty_list, var->uid);
+	mapreg->dirty = true;
+}
+
+/**
+ * Queues the deletion of a permanent global variable's row for the next save.
+ *
+ * @param uid The variable's unique ID.
+ * @param is_string Whether the variable is a string variable.
+ *
+ **/
+static void mapreg_queue_delete(int64 uid, bool is_string)
+{
+	struct mapreg_delete entry = { .uid = uid, .is_string = is_string };
+
+	VECTOR_ENSURE(mapreg->delete_list, 1, 64);
+	VECTOR_PUSH(mapreg->delete_list, entry);
+	mapreg->dirty = true;
+}
+
+/**
+ * Deletes the rows of all queued permanent global variables from the database.
+ *
+ * One prepared statement per table is re-executed for every queued row.
+ *
+ * @return True on success, otherwise false.
+ *
+ **/
+static bool mapreg_save_deletes(void)
+{
+	struct SqlStmt *stmt[2] = { NULL, NULL };
+	const char *query = "DELETE FROM `%s` WHERE `key`=? AND `index`=?";
+	bool ret_val = true;
 
-				if (!var->is_string)
-					mapreg->save_num_db(name, index, var->u.i);
-				else
-					mapreg->save_str_db(name, index, var->u.str);
+	for (int i = 0; i < VECTOR_LENGTH(mapreg->delete_list); i++) {
+		const struct mapreg_delete *entry = &VECTOR_INDEX(mapreg->delete_list, i);
+		const char *name = script->get_str(script_getvarid(entry->uid));
+		unsigned int index = script_getvaridx(entry->uid);
+		int type = entry->is_string ? 1 : 0;
 
-				var->save = false;
+		if (stmt[type] == NULL) {
+			stmt[type] = SQL->StmtMalloc(map->mysql_handle);
+
+			if (stmt[type] == NULL
+			    || SQL_ERROR == SQL->StmtPrepare(stmt[type], query, entry->is_string ? mapreg->str_db : mapreg->num_db)) {
+				SqlStmt_ShowDebug(stmt[type]);
+				ret_val = false;
+				break;
 			}
 		}
 
-		dbi_destroy(iter);
+		if (SQL_ERROR == SQL->StmtBindParam(stmt[type], 0, SQLDT_STRING, name, strlen(name))
+		    || SQL_ERROR == SQL->StmtBindParam(stmt[type], 1, SQLDT_UINT32, &index, sizeof(index))
+		    || SQL_ERROR == SQL->StmtExecute(stmt[type])) {
+			SqlStmt_ShowDebug(stmt[type]);
+			ret_val = false;
+			break;
+		}
+	}
+
+	for (int i = 0; i < 2; i++) {
+		if (stmt[i] != NULL)
+			SQL->StmtFree(stmt[i]);
+	}
+
+	return ret_val;
+}
+
+/**
+ * Writes a batch of permanent global variables to the database with a single multi-row upsert.
+ *
+ * The statement is kept prepared across calls as long as the batch size does not change.
+ *
+ * @param stmt Pointer to the cached statement handle; allocated on first use.
+ * @param prepared Pointer to the batch size the cached statement was prepared for.
+ * @param is_string Whether the batch holds string variables.
+ * @param vars The variables to write.
+ * @param count The amount of variables to write. (1 to MAPREG_SAVE_BATCH)
+ * @return True on success, otherwise false.
+ *
+ **/
+static bool mapreg_save_batch(struct SqlStmt **stmt, int *prepared, bool is_string, struct mapreg_save **vars, int count)
+{
+	nullpo_retr(false, stmt);
+	nullpo_retr(false, prepared);
+	nullpo_retr(false, vars);
+	Assert_retr(false, count > 0 && count <= MAPREG_SAVE_BATCH);
+
+	if (*stmt == NULL && (*stmt = SQL->StmtMalloc(map->mysql_handle)) == NULL) {
+		SqlStmt_ShowDebug(*stmt);
+		return false;
+	}
+
+	if (*prepared != count) {
+		StringBuf buf;
+
+		StrBuf->Init(&buf);
+		StrBuf->Printf(&buf, "INSERT INTO `%s` (`key`, `index`, `value`) VALUES ", is_string ? mapreg->str_db : mapreg->num_db);
+
+		for (int i = 0; i < count; i++)
+			StrBuf->AppendStr(&buf, (i == 0) ? "(?, ?, ?)" : ", (?, ?, ?)");
+
+		StrBuf->AppendStr(&buf, " ON DUPLICATE KEY UPDATE `value`=VALUES(`value`)");
+
+		if (SQL_ERROR == SQL->StmtPrepareStr(*stmt, StrBuf->Value(&buf))) {
+			SqlStmt_ShowDebug(*stmt);
+			StrBuf->Destroy(&buf);
+			*prepared = 0;
+			return false;
+		}
+
+		StrBuf->Destroy(&buf);
+		*prepared = count;
+	}
+
+	unsigned int index[MAPREG_SAVE_BATCH];
+
+	for (int i = 0; i < count; i++) {
+		const char *name = script->get_str(script_getvarid(vars[i]->uid));
+		size_t col = (size_t)i * 3;
+
+		index[i] = script_getvaridx(vars[i]->uid);
+
+		if (SQL_ERROR == SQL->StmtBindParam(*stmt, col, SQLDT_STRING, name, strlen(name))
+		    || SQL_ERROR == SQL->StmtBindParam(*stmt, col + 1, SQLDT_UINT32, &index[i], sizeof(index[i]))
+		    || (is_string && SQL_ERROR == SQL->StmtBindParam(*stmt, col + 2, SQLDT_STRING, vars[i]->u.str, strlen(vars[i]->u.str)))
+		    || (!is_string && SQL_ERROR == SQL->StmtBindParam(*stmt, col + 2, SQLDT_INT32, &vars[i]->u.i, sizeof(vars[i]->u.i)))) {
+			SqlStmt_ShowDebug(*stmt);
+			return false;
+		}
+	}
+
+	if (SQL_ERROR == SQL->StmtExecute(*stmt)) {
+		SqlStmt_ShowDebug(*stmt);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Saves modified permanent global variables to the database.
+ *
+ * Only the variables on the dirty and delete lists are written, inside a single transaction:
+ * queued deletions first, then batched upserts of up to MAPREG_SAVE_BATCH rows per statement.
+ * On failure the lists are kept so the next save retries them.
+ *
+ **/
+static void mapreg_save(void)
+{
+	if (!mapreg->dirty)
+		return;
+
+	VECTOR_DECL(struct mapreg_save *) vars[2];
+	bool success = true;
+
+	VECTOR_INIT(vars[0]);
+	VECTOR_INIT(vars[1]);
+
+	// Collect the live entries of the dirty list; stale and duplicate entries are skipped.
+	for (int i = 0; i < VECTOR_LENGTH(mapreg->dirty_list); i++) {
+		struct mapreg_save *var = i64db_get(mapreg->regs.vars, VECTOR_INDEX(mapreg->dirty_list, i));
+		int type;
+
+		if (var == NULL || !var->save)
+			continue;
+
+		var->save = false;
+		type = var->is_string ? 1 : 0;
+		VECTOR_ENSURE(vars[type], 1, 64);
+		VECTOR_PUSH(vars[type], var);
+	}
+
+	if (SQL_ERROR == SQL->QueryStr(map->mysql_handle, "START TRANSACTION")) {
+		Sql_ShowDebug(map->mysql_handle);
+		success = false;
+	}
+
+	if (success && VECTOR_LENGTH(mapreg->delete_list) > 0)
+		success = mapreg->save_deletes();
+
+	for (int type = 0; type < 2 && success; type++) {
+		struct SqlStmt *stmt = NULL;
+		int prepared = 0;
+
+		for (int i = 0; i < VECTOR_LENGTH(vars[type]) && success; i += MAPREG_SAVE_BATCH) {
+			int count = min(VECTOR_LENGTH(vars[type]) - i, MAPREG_SAVE_BATCH);
+
+			success = mapreg->save_batch(&stmt, &prepared, (type == 1), &VECTOR_INDEX(vars[type], i), count);
+		}
+
+		if (stmt != NULL)
+			SQL->StmtFree(stmt);
+	}
+
+	if (success && SQL_ERROR == SQL->QueryStr(map->mysql_handle, "COMMIT")) {
+		Sql_ShowDebug(map->mysql_handle);
+		success = false;
+	}
+
+	if (success) {
+		VECTOR_TRUNCATE(mapreg->dirty_list);
+		VECTOR_TRUNCATE(mapreg->delete_list);
 		mapreg->dirty = false;
+	} else {
+		if (SQL_ERROR == SQL->QueryStr(map->mysql_handle, "ROLLBACK"))
+			Sql_ShowDebug(map->mysql_handle);
+
+		// Keep the lists; restore the flags so the variables are written on the next attempt.
+		for (int type = 0; type < 2; type++) {
+			for (int i = 0; i < VECTOR_LENGTH(vars[type]); i++)
+				VECTOR_INDEX(vars[type], i)->save = true;
+		}
+
+		ShowError("%s: Failed to save permanent global variables, retrying on the next save.\n", __func__);
 	}
+
+	VECTOR_CLEAR(vars[0]);
+	VECTOR_CLEAR(vars[1]);
 }
 
 /**
@@ -620,12 +749,20 @@ static int mapreg_destroy_reg(union DBKey key, struct DBData *data, va_list ap)
  * Reloads permanent global variables, saving them to the database beforehand.
  *
  * This has the effect of clearing the temporary global variables and reloading the permanent ones.
+ * If the save fails, the variables are kept as they are so that no pending change is lost.
  *
  **/
 static void mapreg_reload(void)
 {
 	mapreg->save();
+	if (mapreg->dirty) {
+		ShowError("%s: Failed to save permanent global variables, skipping the reload to keep the pending changes.\n", __func__);
+		return;
+	}
+
 	mapreg->regs.vars->clear(mapreg->regs.vars, mapreg->destroyreg);
+	VECTOR_TRUNCATE(mapreg->dirty_list);
+	VECTOR_TRUNCATE(mapreg->delete_list);
 
 	if (mapreg->regs.arrays != NULL) {
 		mapreg->regs.arrays->destroy(mapreg->regs.arrays, script->array_free_db);
@@ -680,6 +817,8 @@ static void mapreg_final(void)
 	mapreg->save();
 	mapreg->regs.vars->destroy(mapreg->regs.vars, mapreg->destroyreg);
 	ers_destroy(mapreg->ers);
+	VECTOR_CLEAR(mapreg->dirty_list);
+	VECTOR_CLEAR(mapreg->delete_list);
 
 	if (mapreg->regs.arrays != NULL)
 		mapreg->regs.arrays->destroy(mapreg->regs.arrays, script->array_free_db);
@@ -712,6 +851,8 @@ void mapreg_defaults(void)
 	mapreg->regs.vars = NULL;
 	mapreg->regs.arrays = NULL;
 	mapreg->dirty = false;
+	VECTOR_INIT(mapreg->dirty_list);
+	VECTOR_INIT(mapreg->delete_list);
 	mapreg->skip_insert = false;
 	safestrncpy(mapreg->num_db, "map_reg_num_db", sizeof(mapreg->num_db));
 	safestrncpy(mapreg->str_db, "map_reg_str_db", sizeof(mapreg->str_db));
@@ -731,6 +872,10 @@ void mapreg_defaults(void)
 	mapreg->save_num_db = mapreg_save_num_db;
 	mapreg->save_str_db = mapreg_save_str_db;
 	mapreg->save = mapreg_save;
+	mapreg->mark_dirty = mapreg_mark_dirty;
+	mapreg->queue_delete = mapreg_queue_delete;
+	mapreg->save_deletes = mapreg_save_deletes;
+	mapreg->save_batch = mapreg_save_batch;
 	mapreg->save_timer = mapreg_save_timer;
 	mapreg->destroyreg = mapreg_destroy_reg;
 	mapreg->reload = mapreg_reload;
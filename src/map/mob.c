@@ -377,6 +377,81 @@ static int mob_parse_dataset(struct spawn_data *data)
 	return 1;
 }
 
+/**
+ * Allocates a zeroed mob_data from the monster pool.
+ *
+ * Monsters are created and removed all the time (respawns, dynamic mobs,
+ * script and event spawns), so they come from slabs of MOB_POOL_CHUNK
+ * entries instead of the allocator. They are returned to the pool by
+ * map->freeblock.
+ *
+ * @return the monster data.
+ */
+static struct mob_data *mob_data_alloc(void)
+{
+	struct mob_data *md = ers_alloc(mob->data_ers, struct mob_data);
+
+	memset(md, 0, sizeof(*md));
+	return md;
+}
+
+/**
+ * Returns a monster's data to the pool.
+ *
+ * @param md The monster, which must no longer be referenced.
+ */
+static void mob_data_free(struct mob_data *md)
+{
+	nullpo_retv(md);
+	ers_free(mob->data_ers, md);
+}
+
+/**
+ * Registers a monster in the lazy AI list.
+ *
+ * Called by map->addiddb, so that the list holds the same monsters as map->mobid_db.
+ *
+ * @param md The monster.
+ */
+static void mob_ai_add(struct mob_data *md)
+{
+	struct mob_ai_hot *hot;
+
+	nullpo_retv(md);
+	if (md->ai_index != INDEX_NOT_FOUND)
+		return;
+
+	VECTOR_ENSURE(mob->ai_list, 1, MOB_POOL_CHUNK);
+	md->ai_index = VECTOR_LENGTH(mob->ai_list);
+	VECTOR_PUSHZEROED(mob->ai_list);
+	hot = &VECTOR_LAST(mob->ai_list);
+	hot->md = md;
+	hot->last_thinktime = timer->gettick();
+}
+
+/**
+ * Removes a monster from the lazy AI list, moving the last entry in its place.
+ *
+ * @param md The monster.
+ */
+static void mob_ai_remove(struct mob_data *md)
+{
+	int last;
+
+	nullpo_retv(md);
+	if (md->ai_index == INDEX_NOT_FOUND)
+		return;
+	Assert_retv(md->ai_index < VECTOR_LENGTH(mob->ai_list) && VECTOR_INDEX(mob->ai_list, md->ai_index).md == md);
+
+	last = VECTOR_LENGTH(mob->ai_list) - 1;
+	if (md->ai_index != last) {
+		VECTOR_INDEX(mob->ai_list, md->ai_index) = VECTOR_INDEX(mob->ai_list, last);
+		VECTOR_INDEX(mob->ai_list, md->ai_index).md->ai_index = md->ai_index;
+	}
+	VECTOR_LENGTH(mob->ai_list)--;
+	md->ai_index = INDEX_NOT_FOUND;
+}
+
 /**
  * Generates basic mob data by using the passed spawn data.
  *
@@ -389,7 +464,7 @@ static struct mob_data *mob_spawn_dataset(struct spawn_data *data, int npc_id)
 {
 	nullpo_retr(NULL, data);
 
-	struct mob_data *md = (struct mob_data *)aCalloc(1, sizeof(struct mob_data));
+	struct mob_data *md = mob->data_alloc();
 
 	memcpy(md->name, data->name, NAME_LENGTH);
 	md->bl.id = npc->get_new_npc_id();
@@ -404,6 +479,7 @@ static struct mob_data *mob_spawn_dataset(struct spawn_data *data, int npc_id)
 	md->spawn_timer = INVALID_TIMER;
 	md->deletetimer = INVALID_TIMER;
 	md->skill_idx = -1;
+	md->ai_index = INDEX_NOT_FOUND;
 
 	if (data->level > 0 && data->level <= MAX_LEVEL)
 		md->level = data->level;
@@ -417,8 +493,10 @@ static struct mob_data *mob_spawn_dataset(struct spawn_data *data, int npc_id)
 	if (data->eventname[0] != '\0' && strlen(data->eventname) >= 4)
 		memcpy(md->npc_event, data->eventname, 50);
 
-	if ((md->db->status.mode & MD_LOOTER) == MD_LOOTER)
-		md->lootitem = (struct item *)aCalloc(LOOTITEM_SIZE, sizeof(struct item));
+	if ((md->db->status.mode & MD_LOOTER) == MD_LOOTER) {
+		md->lootitem = ers_alloc(mob->loot_ers, struct item);
+		memset(md->lootitem, 0, sizeof(struct item) * LOOTITEM_SIZE);
+	}
 
 	status->set_viewdata(&md->bl, md->class_);
 	status->change_init(&md->bl);
@@ -512,7 +590,7 @@ static bool mob_ksprotected(struct block_list *src, struct block_list *target)
 		if( md->db->mexp || md->master_id )
 			return false; // MVP, Slaves mobs ignores KS
 
-		if( (sce = md->sc.data[SC_KSPROTECTED]) == NULL )
+		if( (sce = sc_data(&md->sc, SC_KSPROTECTED)) == NULL )
 			break; // No KS Protected
 
 		if( sd->bl.id == sce->val1 || // Same Owner
@@ -1123,9 +1201,11 @@ static int mob_spawn(struct mob_data *md)
 	int i=0;
 	int64 tick = timer->gettick();
 	int64 c = 0;
+	struct mob_ai_hot *hot;
 
 	nullpo_retr(1, md);
-	md->last_thinktime = tick;
+	if ((hot = mob_ai_hot(md)) != NULL)
+		hot->last_thinktime = tick;
 	if (md->bl.prev != NULL)
 		unit->remove_map(&md->bl,CLR_RESPAWN,ALC_MARK);
 	else if (md->spawn && md->class_ != md->spawn->class_) {
@@ -1181,7 +1261,8 @@ static int mob_spawn(struct mob_data *md)
 	md->next_walktime = tick+rnd()%1000+MIN_RANDOMWALKTIME;
 	md->last_linktime = tick;
 	md->dmgtick = tick - 5000;
-	md->last_pcneartime = 0;
+	if (hot != NULL)
+		hot->last_pcneartime = 0;
 
 	for (i = 0, c = tick-MOB_MAX_DELAY; i < MAX_MOBSKILL; i++)
 		md->skilldelay[i] = c;
@@ -1712,6 +1793,7 @@ static int mob_warpchase(struct mob_data *md, struct block_list *target)
  *------------------------------------------*/
 static bool mob_ai_sub_hard(struct mob_data *md, int64 tick)
 {
+	struct mob_ai_hot *hot;
 	struct block_list *tbl = NULL, *abl = NULL;
 	uint32 mode;
 	int view_range, can_move;
@@ -1720,23 +1802,26 @@ static bool mob_ai_sub_hard(struct mob_data *md, int64 tick)
 	if(md->bl.prev == NULL || md->status.hp <= 0)
 		return false;
 
-	if (DIFF_TICK(tick, md->last_thinktime) < MIN_MOBTHINKTIME)
+	if ((hot = mob_ai_hot(md)) == NULL)
+		return false;
+
+	if (DIFF_TICK(tick, hot->last_thinktime) < MIN_MOBTHINKTIME)
 		return false;
 
-	md->last_thinktime = tick;
+	hot->last_thinktime = tick;
 
 	if (md->ud.skilltimer != INVALID_TIMER)
 		return false;
 
 	// Abnormalities
 	if(( md->sc.opt1 > 0 && md->sc.opt1 != OPT1_STONEWAIT && md->sc.opt1 != OPT1_BURNING && md->sc.opt1 != OPT1_CRYSTALIZE )
-	  || md->sc.data[SC_DEEP_SLEEP] || md->sc.data[SC_BLADESTOP] || md->sc.data[SC__MANHOLE] || md->sc.data[SC_CURSEDCIRCLE_TARGET]) {
+	  || sc_data(&md->sc, SC_DEEP_SLEEP) || sc_data(&md->sc, SC_BLADESTOP) || sc_data(&md->sc, SC__MANHOLE) || sc_data(&md->sc, SC_CURSEDCIRCLE_TARGET)) {
 		//Should reset targets.
 		md->target_id = md->attacked_id = 0;
 		return false;
 	}
 
-	if (md->sc.count && md->sc.data[SC_BLIND])
+	if (md->sc.count && sc_data(&md->sc, SC_BLIND))
 		view_range = 3;
 	else
 		view_range = md->db->range2;
@@ -1771,9 +1856,9 @@ static bool mob_ai_sub_hard(struct mob_data *md, int64 tick)
 			//Rude attacked check.
 			if (!battle->check_range(&md->bl, tbl, md->status.rhw.range)
 			 && ( //Can't attack back and can't reach back.
-			       (!can_move && DIFF_TICK(tick, md->ud.canmove_tick) > 0 && (battle_config.mob_ai&0x2 || (md->sc.data[SC_SPIDERWEB] && md->sc.data[SC_SPIDERWEB]->val1)
-			      || md->sc.data[SC_WUGBITE] || md->sc.data[SC_VACUUM_EXTREME] || md->sc.data[SC_THORNS_TRAP]
-			      || md->sc.data[SC__MANHOLE] // Not yet confirmed if boss will teleport once it can't reach target.
+			       (!can_move && DIFF_TICK(tick, md->ud.canmove_tick) > 0 && (battle_config.mob_ai&0x2 || (sc_data(&md->sc, SC_SPIDERWEB) && sc_data(&md->sc, SC_SPIDERWEB)->val1)
+			      || sc_data(&md->sc, SC_WUGBITE) || sc_data(&md->sc, SC_VACUUM_EXTREME) || sc_data(&md->sc, SC_THORNS_TRAP)
+			      || sc_data(&md->sc, SC__MANHOLE) // Not yet confirmed if boss will teleport once it can't reach target.
 			      || md->walktoxy_fail_count > 0)
 			       )
 			    || !mob->can_reach(md, tbl, md->min_chase, MSS_RUSH)
@@ -1788,7 +1873,7 @@ static bool mob_ai_sub_hard(struct mob_data *md, int64 tick)
 			}
 		}
 		else
-		if( (abl = map->id2bl(md->attacked_id)) && (!tbl || mob->can_changetarget(md, abl, mode) || (md->sc.count && md->sc.data[SC__CHAOS]))) {
+		if( (abl = map->id2bl(md->attacked_id)) && (!tbl || mob->can_changetarget(md, abl, mode) || (md->sc.count && sc_data(&md->sc, SC__CHAOS)))) {
 			int dist;
 			if( md->bl.m != abl->m || abl->prev == NULL
 			 || (dist = distance_bl(&md->bl, abl)) >= MAX_MINCHASE // Attacker longer than visual area
@@ -1796,9 +1881,9 @@ static bool mob_ai_sub_hard(struct mob_data *md, int64 tick)
 			 || (battle_config.mob_ai&0x2 && !status->check_skilluse(&md->bl, abl, 0, 0)) // Cannot normal attack back to Attacker
 			 || (!battle->check_range(&md->bl, abl, md->status.rhw.range) // Not on Melee Range and ...
 			    && ( // Reach check
-					(!can_move && DIFF_TICK(tick, md->ud.canmove_tick) > 0 && (battle_config.mob_ai&0x2 || (md->sc.data[SC_SPIDERWEB] && md->sc.data[SC_SPIDERWEB]->val1)
-						|| md->sc.data[SC_WUGBITE] || md->sc.data[SC_VACUUM_EXTREME] || md->sc.data[SC_THORNS_TRAP]
-						|| md->sc.data[SC__MANHOLE] // Not yet confirmed if boss will teleport once it can't reach target.
+					(!can_move && DIFF_TICK(tick, md->ud.canmove_tick) > 0 && (battle_config.mob_ai&0x2 || (sc_data(&md->sc, SC_SPIDERWEB) && sc_data(&md->sc, SC_SPIDERWEB)->val1)
+						|| sc_data(&md->sc, SC_WUGBITE) || sc_data(&md->sc, SC_VACUUM_EXTREME) || sc_data(&md->sc, SC_THORNS_TRAP)
+						|| sc_data(&md->sc, SC__MANHOLE) // Not yet confirmed if boss will teleport once it can't reach target.
 						|| md->walktoxy_fail_count > 0)
 					)
 					   || !mob->can_reach(md, abl, dist+md->db->range3, MSS_RUSH)
@@ -1855,7 +1940,7 @@ static bool mob_ai_sub_hard(struct mob_data *md, int64 tick)
 
 	if ((!tbl && mode&MD_AGGRESSIVE) || md->state.skillstate == MSS_FOLLOW) {
 		map->foreachinrange(mob->ai_sub_hard_activesearch, &md->bl, view_range, DEFAULT_ENEMY_TYPE(md), md, &tbl, mode);
-	} else if ((mode&MD_CHANGECHASE && (md->state.skillstate == MSS_RUSH || md->state.skillstate == MSS_FOLLOW)) || (md->sc.count && md->sc.data[SC__CHAOS])) {
+	} else if ((mode&MD_CHANGECHASE && (md->state.skillstate == MSS_RUSH || md->state.skillstate == MSS_FOLLOW)) || (md->sc.count && sc_data(&md->sc, SC__CHAOS))) {
 		int search_size;
 		search_size = view_range<md->status.rhw.range ? view_range:md->status.rhw.range;
 		map->foreachinrange (mob->ai_sub_hard_changechase, &md->bl, search_size, DEFAULT_ENEMY_TYPE(md), md, &tbl);
@@ -2001,9 +2086,12 @@ static int mob_ai_sub_hard_timer(struct block_list *bl, va_list ap)
 
 	if (mob->ai_sub_hard(md, tick)) {
 		//Hard AI triggered.
+		struct mob_ai_hot *hot = mob_ai_hot(md);
+
 		if(!md->state.spotted)
 			md->state.spotted = 1;
-		md->last_pcneartime = tick;
+		if (hot != NULL)
+			hot->last_pcneartime = tick;
 	}
 	return 0;
 }
@@ -2026,45 +2114,60 @@ static int mob_ai_sub_foreachclient(struct map_session_data *sd, va_list ap)
  *------------------------------------------*/
 static int mob_ai_sub_lazy(struct mob_data *md, va_list args)
 {
-	int64 tick;
+	int64 tick = va_arg(args, int64);
+
+	return mob->ai_think_lazy(md, tick);
+}
+
+/**
+ * Runs the lazy AI of a monster.
+ *
+ * @param md   The monster.
+ * @param tick The current tick.
+ * @return 1 if the hard AI ran or the monster is dead, 0 otherwise.
+ */
+static int mob_ai_think_lazy(struct mob_data *md, int64 tick)
+{
+	struct mob_ai_hot *hot;
 
 	nullpo_ret(md);
 
 	if(md->bl.prev == NULL)
 		return 0;
 
-	tick = va_arg(args, int64);
-
 	if (battle_config.mob_ai&0x20 && map->list[md->bl.m].users>0)
 		return (int)mob->ai_sub_hard(md, tick);
 
 	if (md->bl.prev==NULL || md->status.hp == 0)
 		return 1;
 
+	if ((hot = mob_ai_hot(md)) == NULL)
+		return 0;
+
 	if (battle_config.mob_active_time
-	 && md->last_pcneartime
+	 && hot->last_pcneartime
 	 && !(md->status.mode&MD_BOSS)
-	 && DIFF_TICK(tick,md->last_thinktime) > MIN_MOBTHINKTIME
+	 && DIFF_TICK(tick,hot->last_thinktime) > MIN_MOBTHINKTIME
 	) {
-		if (DIFF_TICK(tick,md->last_pcneartime) < battle_config.mob_active_time)
+		if (DIFF_TICK(tick,hot->last_pcneartime) < battle_config.mob_active_time)
 			return (int)mob->ai_sub_hard(md, tick);
-		md->last_pcneartime = 0;
+		hot->last_pcneartime = 0;
 	}
 
 	if(battle_config.boss_active_time &&
-		md->last_pcneartime &&
+		hot->last_pcneartime &&
 		(md->status.mode&MD_BOSS) &&
-		DIFF_TICK(tick,md->last_thinktime) > MIN_MOBTHINKTIME)
+		DIFF_TICK(tick,hot->last_thinktime) > MIN_MOBTHINKTIME)
 	{
-		if (DIFF_TICK(tick,md->last_pcneartime) < battle_config.boss_active_time)
+		if (DIFF_TICK(tick,hot->last_pcneartime) < battle_config.boss_active_time)
 			return (int)mob->ai_sub_hard(md, tick);
-		md->last_pcneartime = 0;
+		hot->last_pcneartime = 0;
 	}
 
-	if(DIFF_TICK(tick,md->last_thinktime)< 10*MIN_MOBTHINKTIME)
+	if(DIFF_TICK(tick,hot->last_thinktime)< 10*MIN_MOBTHINKTIME)
 		return 0;
 
-	md->last_thinktime=tick;
+	hot->last_thinktime=tick;
 
 	if (md->master_id) {
 		mob->ai_sub_hard_slavemob(md,tick);
@@ -2091,7 +2194,24 @@ static int mob_ai_sub_lazy(struct mob_data *md, va_list args)
  *------------------------------------------*/
 static int mob_ai_lazy(int tid, int64 tick, int id, intptr_t data)
 {
-	map->foreachmob(mob->ai_sub_lazy,tick);
+	// A monster removed during the walk is replaced by the last one, which may have been visited already
+	mob->lazy_pass++;
+	for (int i = VECTOR_LENGTH(mob->ai_list) - 1; i >= 0; i--) {
+		struct mob_ai_hot *hot;
+
+		if (i >= VECTOR_LENGTH(mob->ai_list))
+			continue;
+		hot = &VECTOR_INDEX(mob->ai_list, i);
+		if (hot->lazy_pass == mob->lazy_pass)
+			continue;
+		hot->lazy_pass = mob->lazy_pass;
+
+		// Without players around, the lazy AI only thinks every 10 * MIN_MOBTHINKTIME
+		if (!(battle_config.mob_ai&0x20) && hot->last_pcneartime == 0 && DIFF_TICK(tick, hot->last_thinktime) < 10*MIN_MOBTHINKTIME)
+			continue;
+
+		mob->ai_think_lazy(hot->md, tick);
+	}
 	return 0;
 }
 
@@ -2580,11 +2700,11 @@ static int mob_dead(struct mob_data *md, struct block_list *src, int type)
 	) { //Experience calculation.
 		int bonus = 100; //Bonus on top of your share (common to all attackers).
 		int pnum = 0;
-		if (md->sc.data[SC_RICHMANKIM])
-			bonus += md->sc.data[SC_RICHMANKIM]->val2;
+		if (sc_data(&md->sc, SC_RICHMANKIM))
+			bonus += sc_data(&md->sc, SC_RICHMANKIM)->val2;
 		if(sd) {
 			temp = status->get_class(&md->bl);
-			if(sd->sc.data[SC_MIRACLE]) i = 2; //All mobs are Star Targets
+			if(sc_data(&sd->sc, SC_MIRACLE)) i = 2; //All mobs are Star Targets
 			else
 			ARR_FIND(0, MAX_PC_FEELHATE, i, temp == sd->hate_mob[i] &&
 				(battle_config.allow_skill_without_day || pc->sg_info[i].day_func()));
@@ -2758,11 +2878,11 @@ static int mob_dead(struct mob_data *md, struct block_list *src, int type)
 
 					drop_rate_bonus += sd->dropaddrace[md->status.race] + (is_boss(src) ? sd->dropaddrace[RC_BOSS] : sd->dropaddrace[RC_NONBOSS]); // bonus2 bDropAddRace[KeiKun]
 
-					if (sd->sc.data[SC_CASH_RECEIVEITEM] != NULL) // Increase drop rate if user has SC_CASH_RECEIVEITEM
-						drop_rate_bonus += sd->sc.data[SC_CASH_RECEIVEITEM]->val1;
+					if (sc_data(&sd->sc, SC_CASH_RECEIVEITEM) != NULL) // Increase drop rate if user has SC_CASH_RECEIVEITEM
+						drop_rate_bonus += sc_data(&sd->sc, SC_CASH_RECEIVEITEM)->val1;
 
-					if (sd->sc.data[SC_OVERLAPEXPUP] != NULL)
-						drop_rate_bonus += sd->sc.data[SC_OVERLAPEXPUP]->val2;
+					if (sc_data(&sd->sc, SC_OVERLAPEXPUP) != NULL)
+						drop_rate_bonus += sc_data(&sd->sc, SC_OVERLAPEXPUP)->val2;
 
 					if (drop_rate_bonus != 100) {
 						drop_rate = (int)(0.5 + drop_rate * drop_rate_bonus / 100.);
@@ -2965,7 +3085,7 @@ static int mob_dead(struct mob_data *md, struct block_list *src, int type)
 		mvp_sd = NULL;
 	}
 
-	rebirth =  ( md->sc.data[SC_KAIZEL] || (md->sc.data[SC_REBIRTH] && !md->state.rebirth) );
+	rebirth =  ( sc_data(&md->sc, SC_KAIZEL) || (sc_data(&md->sc, SC_REBIRTH) && !md->state.rebirth) );
 	if( !rebirth ) { // Only trigger event on final kill
 		md->status.hp = 0; //So that npc_event invoked functions KNOW that mob is dead
 		if( src ) {
@@ -3070,13 +3190,16 @@ static int mob_dead(struct mob_data *md, struct block_list *src, int type)
 static void mob_revive(struct mob_data *md, unsigned int hp)
 {
 	int64 tick = timer->gettick();
+	struct mob_ai_hot *hot;
 
 	nullpo_retv(md);
 	md->state.skillstate = MSS_IDLE;
-	md->last_thinktime = tick;
 	md->next_walktime = tick+rnd()%1000+MIN_RANDOMWALKTIME;
 	md->last_linktime = tick;
-	md->last_pcneartime = 0;
+	if ((hot = mob_ai_hot(md)) != NULL) {
+		hot->last_thinktime = tick;
+		hot->last_pcneartime = 0;
+	}
 	memset(md->dmglog, 0, sizeof(md->dmglog)); // Reset the damage done on the rebirthed monster, otherwise will grant full exp + damage done. [Valaris]
 	md->tdmg = 0;
 	if (!md->bl.prev)
@@ -3531,11 +3654,11 @@ static int mob_getfriendstatus_sub(struct block_list *bl, va_list ap)
 
 	if (cond2 == -1) { // Check for any of the common status alignments.
 		for (int i = SC_COMMON_MIN; i <= SC_COMMON_MAX; i++) {
-			if ((flag = (sc->data[i] != NULL)) != 0) // Once an effect was found, break out. [Skotlex]
+			if ((flag = (sc_data(sc, i) != NULL)) != 0) // Once an effect was found, break out. [Skotlex]
 				break;
 		}
 	} else {
-		flag = (sc->data[cond2] != NULL);
+		flag = (sc_data(sc, cond2) != NULL);
 	}
 
 	if ((flag ^ (cond1 == MSC_FRIENDSTATUSOFF)) != 0)
@@ -3642,11 +3765,11 @@ static int mob_use_skill(struct mob_data *md, int64 tick, int event)
 			case MSC_MYSTATUSOFF: // Status change x is inactive.
 				if (cond_data == -1) { // Check for any of the common status alignments.
 					for (int j = SC_COMMON_MIN; j <= SC_COMMON_MAX; j++) {
-						if ((flag = (md->sc.data[j] != NULL)) != 0)
+						if ((flag = (sc_data(&md->sc, j) != NULL)) != 0)
 							break;
 					}
 				} else {
-					flag = (md->sc.data[cond_data] != NULL);
+					flag = (sc_data(&md->sc, cond_data) != NULL);
 				}
 
 				flag ^= (cast_cond == MSC_MYSTATUSOFF);
@@ -6032,6 +6155,12 @@ static void mob_reload(void)
 {
 	int i;
 
+	// parse the mob and mob skill databases in parallel while the old data is cleared
+	libconfig->prefetch_db(DBPATH"mob_db.conf");
+	libconfig->prefetch_db("mob_db2.conf");
+	libconfig->prefetch_db(DBPATH"mob_skill_db.conf");
+	libconfig->prefetch_db("mob_skill_db2.conf");
+
 	//Mob skills need to be cleared before re-reading them. [Skotlex]
 	for (i = 0; i < MAX_MOB_DB; i++)
 		if (mob->db_data[i] && !mob->is_clone(i)) {
@@ -6054,6 +6183,7 @@ static void mob_reload(void)
 	mob->destroy_drop_groups();
 
 	mob->load(false);
+	libconfig->prefetch_clear();
 	map->foreachmob(mob->reload_sub_mob);
 }
 
@@ -6079,12 +6209,20 @@ static int do_init_mob(bool minimal)
 	mob->makedummymobdb(0); //The first time this is invoked, it creates the dummy mob
 	item_drop_ers = ers_new(sizeof(struct item_drop),"mob.c::item_drop_ers",ERS_OPT_CLEAN);
 	item_drop_list_ers = ers_new(sizeof(struct item_drop_list),"mob.c::item_drop_list_ers",ERS_OPT_NONE);
+	mob->data_ers = ers_new(sizeof(struct mob_data), "mob.c::data_ers", ERS_OPT_FLEX_CHUNK);
+	mob->loot_ers = ers_new(sizeof(struct item) * LOOTITEM_SIZE, "mob.c::loot_ers", ERS_OPT_FLEX_CHUNK);
+	ers_chunk_size(mob->data_ers, MOB_POOL_CHUNK);
+	ers_chunk_size(mob->loot_ers, MOB_POOL_CHUNK);
+	VECTOR_INIT(mob->ai_list);
 
 	mob->load(minimal);
 
 	if (minimal)
 		return 0;
 
+	// Pre-warm the first slab of the pool before the spawns are loaded
+	mob->data_free(mob->data_alloc());
+
 	timer->add_func_list(mob->delayspawn,"mob_delayspawn");
 	timer->add_func_list(mob->delay_item_drop,"mob_delay_item_drop");
 	timer->add_func_list(mob->ai_hard,"mob_ai_hard");
@@ -6167,6 +6305,9 @@ static int do_final_mob(void)
 	db_destroy(mob->item_drop_ratio_other_db);
 	ers_destroy(item_drop_ers);
 	ers_destroy(item_drop_list_ers);
+	ers_destroy(mob->data_ers);
+	ers_destroy(mob->loot_ers);
+	VECTOR_CLEAR(mob->ai_list);
 	return 0;
 }
 
@@ -6265,6 +6406,11 @@ void mob_defaults(void)
 	mob->ai_sub_hard_timer = mob_ai_sub_hard_timer;
 	mob->ai_sub_foreachclient = mob_ai_sub_foreachclient;
 	mob->ai_sub_lazy = mob_ai_sub_lazy;
+	mob->ai_think_lazy = mob_ai_think_lazy;
+	mob->ai_add = mob_ai_add;
+	mob->ai_remove = mob_ai_remove;
+	mob->data_alloc = mob_data_alloc;
+	mob->data_free = mob_data_free;
 	mob->ai_lazy = mob_ai_lazy;
 	mob->ai_hard = mob_ai_hard;
 	mob->setdropitem_options = mob_setdropitem_options;
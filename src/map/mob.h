@@ -28,6 +28,7 @@
 #include "common/db.h"
 #include "common/mmo.h" // struct item
 
+struct eri;
 struct hplugin_data_store;
 
 // Change this to increase the table size in your mob_db to accommodate a larger mob database.
@@ -46,6 +47,9 @@ struct hplugin_data_store;
 //Min time between random walks
 #define MIN_RANDOMWALKTIME 4000
 
+// Amount of monsters allocated at once by the mob_data pool.
+#define MOB_POOL_CHUNK 256
+
 //Distance that slaves should keep from their master.
 #define MOB_SLAVEDISTANCE 2
 
@@ -249,15 +253,8 @@ struct mob_data {
 		int provoke_flag; // Celest
 	} state;
 	struct guardian_data* guardian_data;
-	struct {
-		int id;
-		unsigned int dmg;
-		unsigned int flag : 2; //0: Normal. 1: Homunc exp. 2: Pet exp
-	} dmglog[DAMAGELOG_SIZE];
 	int dmg_taken_rate;
-	struct spawn_data *spawn; //Spawn data.
 	int spawn_timer; //Required for Convex Mirror
-	struct item *lootitem;
 	int class_;
 	unsigned int tdmg; //Stores total damage given to the mob, for exp calculations. [Skotlex]
 	int level;
@@ -267,7 +264,8 @@ struct mob_data {
 	int clan_id; // Clan System
 	int npc_id; // NPC ID if spawned with monster/areamonster/guardian/bg_monster/atcommand("@monster xy") (Used to kill mob on NPC unload.)
 
-	int64 next_walktime, last_thinktime, last_linktime, last_pcneartime, dmgtick;
+	int ai_index; ///< Entry in mob->ai_list, holding the think ticks (INDEX_NOT_FOUND if not registered).
+	int64 next_walktime, last_linktime, dmgtick;
 	short move_fail_count;
 	short lootitem_count;
 	short min_chase;
@@ -277,8 +275,6 @@ struct mob_data {
 	int master_id,master_dist;
 
 	int8 skill_idx;// key of array
-	int64 skilldelay[MAX_MOBSKILL];
-	char npc_event[EVENT_NAME_LENGTH];
 	/**
 	 * Did this monster summon something?
 	 * Used to flag summon deletions, saves a worth amount of memory
@@ -289,8 +285,35 @@ struct mob_data {
 	 **/
 	int tomb_nid;
 	struct hplugin_data_store *hdata; ///< HPM Plugin Data Store
+
+	// Rarely used data, kept apart from the fields read by the AI on every think
+	int64 skilldelay[MAX_MOBSKILL];
+	struct {
+		int id;
+		unsigned int dmg;
+		unsigned int flag : 2; //0: Normal. 1: Homunc exp. 2: Pet exp
+	} dmglog[DAMAGELOG_SIZE];
+	struct spawn_data *spawn; //Spawn data.
+	struct item *lootitem; ///< Looted items (LOOTITEM_SIZE entries, from mob->loot_ers), NULL if not a looter.
+	char npc_event[EVENT_NAME_LENGTH];
 };
 
+/**
+ * Think ticks of a monster, read by the lazy AI on every pass.
+ *
+ * They are kept in a dense array (mob->ai_list) so that the lazy AI can skip
+ * idle monsters without touching their mob_data.
+ */
+struct mob_ai_hot {
+	struct mob_data *md;    ///< The monster.
+	int64 last_thinktime;   ///< Last time the AI ran.
+	int64 last_pcneartime;  ///< Last time a player was in sight (0 if none recently).
+	uint32 lazy_pass;       ///< Last mob_ai_lazy pass that visited the monster.
+};
+
+/// Returns the think ticks of a monster, or NULL if it isn't registered. @see struct mob_ai_hot
+#define mob_ai_hot(md) ((md)->ai_index != INDEX_NOT_FOUND ? &VECTOR_INDEX(mob->ai_list, (md)->ai_index) : NULL)
+
 
 enum {
 	MST_TARGET = 0,
@@ -506,6 +529,10 @@ struct mob_interface {
 	int mora[5];
 	struct item_drop_ratio **item_drop_ratio_db;
 	struct DBMap *item_drop_ratio_other_db;
+	struct eri *data_ers; ///< mob_data pool.
+	struct eri *loot_ers; ///< Loot lists pool.
+	VECTOR_DECL(struct mob_ai_hot) ai_list; ///< Think ticks of the monsters in map->mobid_db.
+	uint32 lazy_pass; ///< Number of the current mob_ai_lazy pass.
 	/* */
 	int (*init) (bool mimimal);
 	int (*final) (void);
@@ -560,6 +587,11 @@ struct mob_interface {
 	int (*ai_sub_hard_timer) (struct block_list *bl, va_list ap);
 	int (*ai_sub_foreachclient) (struct map_session_data *sd, va_list ap);
 	int (*ai_sub_lazy) (struct mob_data *md, va_list args);
+	int (*ai_think_lazy) (struct mob_data *md, int64 tick);
+	void (*ai_add) (struct mob_data *md);
+	void (*ai_remove) (struct mob_data *md);
+	struct mob_data *(*data_alloc) (void);
+	void (*data_free) (struct mob_data *md);
 	int (*ai_lazy) (int tid, int64 tick, int id, intptr_t data);
 	int (*ai_hard) (int tid, int64 tick, int id, intptr_t data);
 	void (*setdropitem_options) (struct item *item, struct optdrop_group *options);
@@ -48,11 +48,14 @@
 #include "common/ers.h"
 #include "common/memmgr.h"
 #include "common/msgtable.h"
+#include "common/mutex.h"
 #include "common/nullpo.h"
 #include "common/showmsg.h"
 #include "common/socket.h"
 #include "common/sql.h"
 #include "common/strlib.h"
+#include "common/sysinfo.h"
+#include "common/thread.h"
 #include "common/timer.h"
 #include "common/utils.h"
 
@@ -485,9 +488,76 @@ static int npc_event_doall(const char *name)
 	return npc->event_doall_id(name, 0);
 }
 
+/**
+ * Runs a global event in slices, as a timer task, so that events with
+ * many listeners don't block the server cycle.
+ *
+ * The listeners no longer run atomically within one tick: when the cycle
+ * budget runs out, the remaining ones run in the following cycles.
+ *
+ * Events are looked up by name when they run: NPCs unloaded in the
+ * meantime are skipped.
+ *
+ * @param name The event label.
+ * @return the amount of queued events.
+ */
+static int npc_event_doall_queue(const char *name)
+{
+	struct linkdb_node **label_linkdb;
+	struct linkdb_node *node;
+	struct npc_event_batch *batch;
+	int count = 0;
+
+	nullpo_ret(name);
+
+	if ((label_linkdb = strdb_get(npc->ev_label_db, name)) == NULL)
+		return 0;
+
+	for (node = *label_linkdb; node != NULL; node = node->next)
+		count++;
+	if (count == 0)
+		return 0;
+
+	CREATE(batch, struct npc_event_batch, 1);
+	batch->names = aCalloc(count, sizeof(*batch->names));
+	for (node = *label_linkdb; node != NULL && batch->count < count; node = node->next) {
+		const struct event_data *ev = node->data;
+		snprintf(batch->names[batch->count++], EVENT_NAME_LENGTH, "%s::%s", ev->nd->exname, name);
+	}
+
+	timer->add_task(npc->event_doall_task, 0, (intptr_t)batch);
+	return count;
+}
+
+/**
+ * Runs events queued by npc->event_doall_queue(), until the cycle budget is used up.
+ *
+ * @see TaskFunc
+ */
+static bool npc_event_doall_task(int id, intptr_t data, bool abort)
+{
+	struct npc_event_batch *batch = (struct npc_event_batch *)data;
+
+	nullpo_retr(true, batch);
+
+	while (!abort && batch->pos < batch->count) {
+		npc->event_do(batch->names[batch->pos++]);
+		if (timer->budget_exceeded())
+			break;
+	}
+
+	if (!abort && batch->pos < batch->count)
+		return false;
+
+	aFree(batch->names);
+	aFree(batch);
+	return true;
+}
+
 /*==========================================
  * Clock event execution
  * OnMinute/OnClock/OnHour/OnDay/OnDDHHMM
+ * The events are queued, see npc_event_doall_queue()
  *------------------------------------------*/
 static int npc_event_do_clock(int tid, int64 tick, int id, intptr_t data)
 {
@@ -515,23 +585,23 @@ static int npc_event_do_clock(int tid, int64 tick, int id, intptr_t data)
 		}
 
 		sprintf(buf,"OnMinute%02d",t->tm_min);
-		c += npc->event_doall(buf);
+		c += npc->event_doall_queue(buf);
 
 		sprintf(buf,"OnClock%02d%02d",t->tm_hour,t->tm_min);
-		c += npc->event_doall(buf);
+		c += npc->event_doall_queue(buf);
 
 		sprintf(buf,"On%s%02d%02d",day,t->tm_hour,t->tm_min);
-		c += npc->event_doall(buf);
+		c += npc->event_doall_queue(buf);
 	}
 
 	if (t->tm_hour != ev_tm_b.tm_hour) {
 		sprintf(buf,"OnHour%02d",t->tm_hour);
-		c += npc->event_doall(buf);
+		c += npc->event_doall_queue(buf);
 	}
 
 	if (t->tm_mday != ev_tm_b.tm_mday) {
 		sprintf(buf,"OnDay%02d%02d",t->tm_mon+1,t->tm_mday);
-		c += npc->event_doall(buf);
+		c += npc->event_doall_queue(buf);
 	}
 
 	memcpy(&ev_tm_b,t,sizeof(ev_tm_b));
@@ -1059,7 +1129,7 @@ static int npc_touch_areanpc(struct map_session_data *sd, int16 m, int16 x, int1
 	}
 	switch(map->list[m].npc[i]->subtype) {
 		case WARP:
-			if( pc_ishiding(sd) || (sd->sc.count && sd->sc.data[SC_CAMOUFLAGE]) )
+			if( pc_ishiding(sd) || (sd->sc.count && sc_data(&sd->sc, SC_CAMOUFLAGE)) )
 				break; // hidden chars cannot use warps
 			pc->setpos(sd,map->list[m].npc[i]->u.warp.mapindex,map->list[m].npc[i]->u.warp.x,map->list[m].npc[i]->u.warp.y,CLR_OUTSIGHT);
 			break;
@@ -1074,7 +1144,7 @@ static int npc_touch_areanpc(struct map_session_data *sd, int16 m, int16 x, int1
 				 && (sd->bl.y >= (map->list[m].npc[j]->bl.y - map->list[m].npc[j]->u.warp.ys)
 				  && sd->bl.y <= (map->list[m].npc[j]->bl.y + map->list[m].npc[j]->u.warp.ys))
 				) {
-					if( pc_ishiding(sd) || (sd->sc.count && sd->sc.data[SC_CAMOUFLAGE]) )
+					if( pc_ishiding(sd) || (sd->sc.count && sc_data(&sd->sc, SC_CAMOUFLAGE)) )
 						break; // hidden chars cannot use warps
 					pc->setpos(sd,map->list[m].npc[j]->u.warp.mapindex,map->list[m].npc[j]->u.warp.x,map->list[m].npc[j]->u.warp.y,CLR_OUTSIGHT);
 					found_warp = 1;
@@ -5422,45 +5492,253 @@ static const char *npc_parse_unknown_object(const char *w1, const char *w2, cons
 	return start;
 }
 
+/// Npc source file read by a worker thread (@see npc_src_prefetch_start)
+struct npc_src_prefetch_entry {
+	const struct npc_src_list *file;
+	char *buffer; ///< File contents, allocated with malloc (NULL if it couldn't be read)
+	size_t len;
+	bool done;    ///< Whether a worker finished reading the file
+};
+
+/// Worker pool reading npc source files ahead of the parser
+static struct {
+	struct npc_src_prefetch_entry *entries;
+	int count;
+	int next;     ///< Next entry to be read by a worker
+	int consumed; ///< Next entry to be taken by the parser
+	bool stopping;
+	struct mutex_data *lock;
+	struct cond_data *read_cond; ///< Signaled when the parser takes a file or the pool is stopping
+	struct cond_data *done_cond; ///< Signaled when a worker finishes a file
+	struct thread_handle *workers[NPC_SRC_PREFETCH_MAX_WORKERS];
+	int worker_count;
+} src_prefetch;
+
 /**
- * Parses a script file and creates NPCs/functions/mapflags/monsters/etc
- * accordingly.
+ * Worker thread of npc_src_prefetch_start.
+ * Reads files in list order, staying at most NPC_SRC_PREFETCH_WINDOW files
+ * ahead of the parser. Doesn't use memmgr or console output, which aren't
+ * thread safe.
+ */
+static void *npc_src_prefetch_worker(void *param)
+{
+	while (true) {
+		mutex->lock(src_prefetch.lock);
+		while (!src_prefetch.stopping && src_prefetch.next < src_prefetch.count
+		    && src_prefetch.next - src_prefetch.consumed >= NPC_SRC_PREFETCH_WINDOW)
+			mutex->cond_wait(src_prefetch.read_cond, src_prefetch.lock, -1);
+		if (src_prefetch.stopping || src_prefetch.next >= src_prefetch.count) {
+			mutex->unlock(src_prefetch.lock);
+			break;
+		}
+		struct npc_src_prefetch_entry *entry = &src_prefetch.entries[src_prefetch.next++];
+		mutex->unlock(src_prefetch.lock);
+
+		char *buffer = NULL;
+		size_t len = 0;
+		FILE *fp = fopen(entry->file->name, "rb");
+		if (fp != NULL) {
+			fseek(fp, 0, SEEK_END);
+			long size = ftell(fp);
+			if (size >= 0 && (buffer = malloc((size_t)size + 1)) != NULL) {
+				fseek(fp, 0, SEEK_SET);
+				len = fread(buffer, sizeof(char), (size_t)size, fp);
+				buffer[len] = '\0';
+				if (ferror(fp)) {
+					free(buffer);
+					buffer = NULL;
+				}
+			}
+			fclose(fp);
+		}
+
+		mutex->lock(src_prefetch.lock);
+		entry->buffer = buffer;
+		entry->len = len;
+		entry->done = true;
+		mutex->cond_broadcast(src_prefetch.done_cond);
+		mutex->unlock(src_prefetch.lock);
+	}
+
+	return NULL;
+}
+
+/**
+ * Starts reading all files of npc->src_files in background, so the parser
+ * doesn't wait for disk I/O between files.
+ * Must be followed by npc->src_prefetch_stop() once all files are parsed.
+ */
+static void npc_src_prefetch_start(void)
+{
+	const struct npc_src_list *file;
+	int count = 0;
+
+	if (src_prefetch.entries != NULL)
+		return;
+
+	for (file = npc->src_files; file != NULL; file = file->next)
+		count++;
+	if (count == 0)
+		return;
+
+	src_prefetch.entries = aCalloc(count, sizeof(*src_prefetch.entries));
+	src_prefetch.count = count;
+	src_prefetch.next = src_prefetch.consumed = 0;
+	src_prefetch.stopping = false;
+	count = 0;
+	for (file = npc->src_files; file != NULL; file = file->next)
+		src_prefetch.entries[count++].file = file;
+
+	src_prefetch.lock = mutex->create();
+	src_prefetch.read_cond = mutex->cond_create();
+	src_prefetch.done_cond = mutex->cond_create();
+
+	int max_workers = cap_value(sysinfo->cpucores(), 1, NPC_SRC_PREFETCH_MAX_WORKERS);
+	for (src_prefetch.worker_count = 0; src_prefetch.worker_count < max_workers; src_prefetch.worker_count++) {
+		if ((src_prefetch.workers[src_prefetch.worker_count] = thread->create(npc->src_prefetch_worker, NULL)) == NULL)
+			break;
+	}
+}
+
+/**
+ * Takes the contents of a file read by npc_src_prefetch_start, waiting for
+ * its worker if needed.
  *
- * @param filepath  File name and path.
- * @param runOnInit Whether the OnInit label should be called.
- * @retval EXIT_SUCCESS if filepath was loaded correctly.
- * @retval EXIT_FAILURE if there were errors/warnings when loading filepath.
+ * @param filepath File to take, must be the next file of npc->src_files to be parsed.
+ * @param buffer   Where to store the file contents (allocated with malloc, the worker's buffer is handed over).
+ * @param len      Where to store the file length.
+ * @retval true  if the file was read in background.
+ * @retval false if it wasn't or it couldn't be read, the caller must read it.
  */
-static int npc_parsesrcfile(const char *filepath, bool runOnInit)
+static bool npc_src_prefetch_take(const char *filepath, char **buffer, size_t *len)
+{
+	nullpo_retr(false, filepath);
+	nullpo_retr(false, buffer);
+	nullpo_retr(false, len);
+
+	if (src_prefetch.entries == NULL || src_prefetch.worker_count == 0 || src_prefetch.consumed >= src_prefetch.count)
+		return false;
+
+	struct npc_src_prefetch_entry *entry = &src_prefetch.entries[src_prefetch.consumed];
+	if (strcmp(entry->file->name, filepath) != 0)
+		return false;
+
+	mutex->lock(src_prefetch.lock);
+	while (!entry->done)
+		mutex->cond_wait(src_prefetch.done_cond, src_prefetch.lock, -1);
+	src_prefetch.consumed++;
+	mutex->cond_broadcast(src_prefetch.read_cond);
+	mutex->unlock(src_prefetch.lock);
+
+	if (entry->buffer == NULL)
+		return false;
+
+	*len = entry->len;
+	*buffer = entry->buffer;
+	entry->buffer = NULL;
+	return true;
+}
+
+/**
+ * Stops the workers started by npc_src_prefetch_start and frees unparsed files.
+ */
+static void npc_src_prefetch_stop(void)
+{
+	if (src_prefetch.entries == NULL)
+		return;
+
+	mutex->lock(src_prefetch.lock);
+	src_prefetch.stopping = true;
+	mutex->cond_broadcast(src_prefetch.read_cond);
+	mutex->unlock(src_prefetch.lock);
+
+	for (int i = 0; i < src_prefetch.worker_count; i++)
+		thread->wait(src_prefetch.workers[i], NULL);
+	src_prefetch.worker_count = 0;
+
+	for (int i = 0; i < src_prefetch.count; i++) {
+		if (src_prefetch.entries[i].buffer != NULL)
+			free(src_prefetch.entries[i].buffer);
+	}
+	aFree(src_prefetch.entries);
+	src_prefetch.entries = NULL;
+	src_prefetch.count = 0;
+
+	mutex->cond_destroy(src_prefetch.read_cond);
+	mutex->cond_destroy(src_prefetch.done_cond);
+	mutex->destroy(src_prefetch.lock);
+	src_prefetch.read_cond = src_prefetch.done_cond = NULL;
+	src_prefetch.lock = NULL;
+}
+
+/**
+ * Reads a whole npc source file.
+ *
+ * The contents are allocated with malloc rather than memmgr, so that the
+ * buffers read by the prefetch workers can be handed over as they are.
+ *
+ * @param filepath File to read.
+ * @param len      Where to store the file length.
+ * @return File contents (must be released by the caller with free) or NULL on failure.
+ */
+static char *npc_read_srcfile(const char *filepath, size_t *len)
 {
-	int success = EXIT_SUCCESS;
-	int16 m, x, y;
 	FILE* fp;
-	size_t len;
 	char* buffer;
-	const char* p;
 
-	nullpo_retr(EXIT_FAILURE, filepath);
+	nullpo_retr(NULL, filepath);
+	nullpo_retr(NULL, len);
+
+	if (npc->src_prefetch_take(filepath, &buffer, len))
+		return buffer;
 
 	// read whole file to buffer
 	fp = fopen(filepath, "rb");
 	if( fp == NULL ) {
 		ShowError("npc_parsesrcfile: File not found '%s'.\n", filepath);
-		return EXIT_FAILURE;
+		return NULL;
 	}
 	fseek(fp, 0, SEEK_END);
-	len = ftell(fp);
-	buffer = (char*)aMalloc(len+1);
+	*len = ftell(fp);
+	if ((buffer = malloc(*len + 1)) == NULL) {
+		ShowError("npc_parsesrcfile: Out of memory reading file '%s'.\n", filepath);
+		fclose(fp);
+		return NULL;
+	}
 	fseek(fp, 0, SEEK_SET);
-	len = fread(buffer, sizeof(char), len, fp);
-	buffer[len] = '\0';
+	*len = fread(buffer, sizeof(char), *len, fp);
+	buffer[*len] = '\0';
 	if( ferror(fp) ) {
 		ShowError("npc_parsesrcfile: Failed to read file '%s' - %s\n", filepath, strerror(errno));
-		aFree(buffer);
+		free(buffer);
 		fclose(fp);
-		return EXIT_FAILURE;
+		return NULL;
 	}
 	fclose(fp);
+	return buffer;
+}
+
+/**
+ * Parses a script file and creates NPCs/functions/mapflags/monsters/etc
+ * accordingly.
+ *
+ * @param filepath  File name and path.
+ * @param runOnInit Whether the OnInit label should be called.
+ * @retval EXIT_SUCCESS if filepath was loaded correctly.
+ * @retval EXIT_FAILURE if there were errors/warnings when loading filepath.
+ */
+static int npc_parsesrcfile(const char *filepath, bool runOnInit)
+{
+	int success = EXIT_SUCCESS;
+	int16 m, x, y;
+	size_t len;
+	char* buffer;
+	const char* p;
+
+	nullpo_retr(EXIT_FAILURE, filepath);
+
+	if ((buffer = npc->read_srcfile(filepath, &len)) == NULL)
+		return EXIT_FAILURE;
 
 	if ((unsigned char)buffer[0] == 0xEF && (unsigned char)buffer[1] == 0xBB && (unsigned char)buffer[2] == 0xBF) {
 		// UTF-8 BOM. This is most likely an error on the user's part, because:
@@ -5469,7 +5747,7 @@ static int npc_parsesrcfile(const char *filepath, bool runOnInit)
 		// - If the user really wants to use UTF-8 (instead of latin1, EUC-KR, SJIS, etc), then they can still do it <without BOM>.
 		// More info at http://unicode.org/faq/utf_bom.html#bom5 and http://en.wikipedia.org/wiki/Byte_order_mark#UTF-8
 		ShowError("npc_parsesrcfile: Detected unsupported UTF-8 BOM in file '%s'. Stopping (please consider using another character set.)\n", filepath);
-		aFree(buffer);
+		free(buffer);
 		return EXIT_FAILURE;
 	}
 
@@ -5613,7 +5891,7 @@ static int npc_parsesrcfile(const char *filepath, bool runOnInit)
 			p = npc->parse_unknown_object(w1, w2, w3, w4, p, buffer, filepath, &success);
 		}
 	}
-	aFree(buffer);
+	free(buffer);
 
 	return success;
 }
@@ -5725,11 +6003,13 @@ static void npc_process_files(int npc_min)
 	struct npc_src_list *file; // Current file
 
 	ShowStatus("Loading NPCs...\r");
+	npc->src_prefetch_start();
 	for( file = npc->src_files; file != NULL; file = file->next ) {
 		ShowStatus("Loading NPC file: %s"CL_CLL"\r", file->name);
 		if (npc->parsesrcfile(file->name, false) != EXIT_SUCCESS)
 			map->retval = EXIT_FAILURE;
 	}
+	npc->src_prefetch_stop();
 	ShowInfo ("Done loading '"CL_WHITE"%d"CL_RESET"' NPCs:"CL_CLL"\n"
 		"\t-'"CL_WHITE"%d"CL_RESET"' Warps\n"
 		"\t-'"CL_WHITE"%d"CL_RESET"' Shops\n"
@@ -5912,6 +6192,7 @@ static int do_final_npc(void)
 	npc->path_db->destroy(npc->path_db, npc->path_db_clear_sub);
 	ers_destroy(npc->timer_event_ers);
 	npc->clearsrcfile();
+	npc_chat->final();
 
 	return 0;
 }
@@ -6113,6 +6394,8 @@ void npc_defaults(void)
 	npc->event_do = npc_event_do;
 	npc->event_doall_id = npc_event_doall_id;
 	npc->event_doall = npc_event_doall;
+	npc->event_doall_queue = npc_event_doall_queue;
+	npc->event_doall_task = npc_event_doall_task;
 	npc->event_do_clock = npc_event_do_clock;
 	npc->event_do_oninit = npc_event_do_oninit;
 	npc->timerevent_export = npc_timerevent_export;
@@ -6184,6 +6467,11 @@ void npc_defaults(void)
 	npc->parse_mapflag = npc_parse_mapflag;
 	npc->parse_unknown_mapflag = npc_parse_unknown_mapflag;
 	npc->parsesrcfile = npc_parsesrcfile;
+	npc->read_srcfile = npc_read_srcfile;
+	npc->src_prefetch_start = npc_src_prefetch_start;
+	npc->src_prefetch_worker = npc_src_prefetch_worker;
+	npc->src_prefetch_take = npc_src_prefetch_take;
+	npc->src_prefetch_stop = npc_src_prefetch_stop;
 	npc->parse_unknown_object = npc_parse_unknown_object;
 	npc->script_event = npc_script_event;
 	npc->read_event_script = npc_read_event_script;
@@ -189,6 +189,9 @@ enum npce_event {
 	NPCE_MAX
 };
 
+#define NPC_SRC_PREFETCH_MAX_WORKERS 4 ///< Maximum number of threads reading npc source files ahead of the parser
+#define NPC_SRC_PREFETCH_WINDOW 64     ///< Maximum number of files read ahead of the parser
+
 // linked list of npc source files
 struct npc_src_list {
 	struct npc_src_list* next;
@@ -200,6 +203,13 @@ struct event_data {
 	int pos;
 };
 
+/// Global event queued with npc->event_doall_queue(), run across server cycles.
+struct npc_event_batch {
+	int count;                        ///< Amount of events.
+	int pos;                          ///< Next event to run.
+	char (*names)[EVENT_NAME_LENGTH]; ///< Full name ("npcname::label") of each event.
+};
+
 struct npc_path_data {
 	char* path;
 	unsigned short references;
@@ -252,6 +262,8 @@ struct npc_interface {
 	int (*event_do) (const char *name);
 	int (*event_doall_id) (const char *name, int rid);
 	int (*event_doall) (const char *name);
+	int (*event_doall_queue) (const char *name);
+	bool (*event_doall_task) (int id, intptr_t data, bool abort);
 	int (*event_do_clock) (int tid, int64 tick, int id, intptr_t data);
 	void (*event_do_oninit) ( bool reload );
 	int (*timerevent_export) (struct npc_data *nd, int i);
@@ -324,6 +336,11 @@ struct npc_interface {
 	const char *(*parse_mapflag) (const char *w1, const char *w2, const char *w3, const char *w4, const char *start, const char *buffer, const char *filepath, int *retval);
 	void (*parse_unknown_mapflag) (const char *name, const char *w3, const char *w4, const char *start, const char *buffer, const char *filepath, int *retval);
 	int (*parsesrcfile) (const char *filepath, bool runOnInit);
+	char *(*read_srcfile) (const char *filepath, size_t *len);
+	void (*src_prefetch_start) (void);
+	void *(*src_prefetch_worker) (void *param);
+	bool (*src_prefetch_take) (const char *filepath, char **buffer, size_t *len);
+	void (*src_prefetch_stop) (void);
 	int (*script_event) (struct map_session_data *sd, enum npce_event type);
 	void (*read_event_script) (void);
 	int (*path_db_clear_sub) (union DBKey key, struct DBData *data, va_list args);
@@ -393,16 +410,54 @@ struct pcrematch_set {
 	int setid;
 };
 
+/**
+ * All active patterns of a NPC compiled into a single expression
+ *
+ * Each pattern becomes one capture-wrapped alternative, in priority order,
+ * so a single exec tells which pattern matched first.
+ */
+struct pcrematch_matcher {
+	pcre* pcre_;
+	pcre_extra* pcre_extra_;
+	int count;                         ///< Number of alternatives
+	struct pcrematch_entry** entries;  ///< Pattern of each alternative
+	int* group;                        ///< Capture group wrapping each alternative
+	int* group_count;                  ///< Capture groups of each pattern itself
+	int* ovector;
+	int ovector_size;
+};
+
 /**
  * Entire data structure hung off a NPC
  */
 struct npc_parse {
 	struct pcrematch_set* active;
 	struct pcrematch_set* inactive;
+	struct pcrematch_matcher* matcher; ///< Compiled active patterns, NULL when they can't be combined
+	bool dirty;                        ///< Active patterns changed since the matcher was compiled
+	bool listening;                    ///< Registered in npc_chat->listeners
+	int16 listen_m;                    ///< Map the NPC is registered on, when listening
+};
+
+/**
+ * Listening NPCs of a map
+ */
+struct npc_chat_listeners {
+	VECTOR_DECL(int) ids; ///< IDs of the NPCs that have at least one active pattern set
 };
 
 struct npc_chat_interface {
+	struct DBMap *listeners; ///< int16 m -> struct npc_chat_listeners*, created on first use
+	/* */
 	int (*sub) (struct block_list* bl, va_list ap);
+	void (*message) (struct map_session_data* sd, const char* msg, int len);
+	int (*match) (struct npc_data* nd, struct map_session_data* sd, const char* msg, int len);
+	bool (*run_match) (struct npc_data* nd, struct map_session_data* sd, const char* label, const char* msg, int* offsets, int count, int group, int group_count);
+	void (*update_listener) (struct npc_data* nd);
+	bool (*combinable) (const char* pattern);
+	struct pcrematch_matcher* (*compile_matcher) (struct npc_parse* npcParse);
+	void (*free_matcher) (struct pcrematch_matcher* matcher);
+	void (*final) (void);
 	void (*finalize) (struct npc_data* nd);
 	void (*def_pattern) (struct npc_data* nd, int setid, const char* pattern, const char* label);
 	struct pcrematch_entry* (*create_pcrematch_entry) (struct pcrematch_set* set);
@@ -427,6 +482,8 @@ struct pcre_interface {
 	void (*free_substring) (const char *stringptr);
 	int (*copy_named_substring) (const pcre *code, const char *subject, int *ovector, int stringcount, const char *stringname, char *buffer, int buffersize);
 	int (*get_substring) (const char *subject, int *ovector, int stringcount, int stringnumber, const char **stringptr);
+	int (*fullinfo) (const pcre *code, const pcre_extra *extra, int what, void *where);
+	void (*free_study) (pcre_extra *extra);
 };
 
 /**
@@ -22,9 +22,12 @@
 
 #include "npc.h" // struct npc_data
 
+#include "map/map.h" // AREA_SIZE, map->id2nd()
 #include "map/mob.h" // struct mob_data
+#include "map/path.h" // check_distance_bl()
 #include "map/pc.h" // struct map_session_data
 #include "map/script.h" // set_var()
+#include "common/db.h"
 #include "common/memmgr.h"
 #include "common/nullpo.h"
 #include "common/showmsg.h"
@@ -46,6 +49,12 @@ static struct pcre_interface libpcre_s;
 struct npc_chat_interface *npc_chat;
 struct pcre_interface *libpcre;
 
+#ifdef PCRE_STUDY_JIT_COMPILE
+#define NPC_CHAT_STUDY_OPTIONS PCRE_STUDY_JIT_COMPILE
+#else
+#define NPC_CHAT_STUDY_OPTIONS 0
+#endif
+
 /**
  *  Written by MouseJstr in a vision... (2/21/2005)
  *
@@ -102,7 +111,7 @@ static void finalize_pcrematch_entry(struct pcrematch_entry *e)
 {
 	nullpo_retv(e);
 	libpcre->free(e->pcre_);
-	libpcre->free(e->pcre_extra_);
+	libpcre->free_study(e->pcre_extra_);
 	aFree(e->pattern);
 	aFree(e->label);
 }
@@ -181,6 +190,8 @@ static void activate_pcreset(struct npc_data *nd, int setid)
 	if (pcreset->next != NULL)
 		pcreset->next->prev = pcreset;
 	npcParse->active = pcreset;
+	npcParse->dirty = true;
+	npc_chat->update_listener(nd);
 }
 
 /**
@@ -221,6 +232,8 @@ static void deactivate_pcreset(struct npc_data *nd, int setid)
 	if (pcreset->next != NULL)
 		pcreset->next->prev = pcreset;
 	npcParse->inactive = pcreset;
+	npcParse->dirty = true;
+	npc_chat->update_listener(nd);
 }
 
 /**
@@ -273,6 +286,11 @@ static void delete_pcreset(struct npc_data *nd, int setid)
 		pcreset->head = n;
 	}
 	aFree(pcreset);
+
+	if (active) {
+		npcParse->dirty = true;
+		npc_chat->update_listener(nd);
+	}
 }
 
 /**
@@ -322,7 +340,8 @@ static void npc_chat_def_pattern(struct npc_data *nd, int setid, const char *pat
 	e->pattern = aStrdup(pattern);
 	e->label = aStrdup(label);
 	e->pcre_ = libpcre->compile(pattern, PCRE_CASELESS, &err, &erroff, NULL);
-	e->pcre_extra_ = libpcre->study(e->pcre_, 0, &err);
+	e->pcre_extra_ = libpcre->study(e->pcre_, NPC_CHAT_STUDY_OPTIONS, &err);
+	nd->chatdb->dirty = true; // the set may be active already
 }
 
 /**
@@ -347,37 +366,278 @@ static void npc_chat_finalize(struct npc_data *nd)
 		npc_chat->delete_pcreset(nd, npcParse->inactive->setid);
 
 	// Additional cleaning up [Lance]
+	npc_chat->free_matcher(npcParse->matcher);
 	aFree(npcParse);
+	nd->chatdb = NULL;
 }
 
 /**
- * Handler called whenever a global message is spoken in a NPC's area
+ * Keeps npc_chat->listeners in sync with whether a NPC has any active pattern set
+ * and with the map it is on (called again when the NPC changes maps)
  */
-static int npc_chat_sub(struct block_list *bl, va_list ap)
+static void npc_chat_update_listener(struct npc_data *nd)
 {
-	struct npc_data *nd = NULL;
-	struct npc_parse *npcParse = NULL;
-	char *msg;
-	int len, i;
-	struct map_session_data* sd;
-	struct npc_label_list* lst;
-	struct pcrematch_set* pcreset;
-	struct pcrematch_entry* e;
+	struct npc_parse *npcParse;
+	struct npc_chat_listeners *list;
+	bool listening;
+	int i;
 
-	nullpo_ret(bl);
-	Assert_ret(bl->type == BL_NPC);
-	nd = BL_UCAST(BL_NPC, bl);
+	nullpo_retv(nd);
+	npcParse = nd->chatdb;
+	if (npcParse == NULL)
+		return;
+
+	listening = (npcParse->active != NULL && nd->bl.m >= 0);
+	if (npcParse->listening == listening && (!listening || npcParse->listen_m == nd->bl.m))
+		return;
+
+	if (npcParse->listening && (list = idb_get(npc_chat->listeners, npcParse->listen_m)) != NULL) {
+		ARR_FIND(0, VECTOR_LENGTH(list->ids), i, VECTOR_INDEX(list->ids, i) == nd->bl.id);
+		if (i < VECTOR_LENGTH(list->ids))
+			VECTOR_ERASE(list->ids, i);
+	}
+	npcParse->listening = listening;
+	if (!listening)
+		return;
+
+	npcParse->listen_m = nd->bl.m;
+	if (npc_chat->listeners == NULL)
+		npc_chat->listeners = idb_alloc(DB_OPT_BASE);
+	if ((list = idb_get(npc_chat->listeners, nd->bl.m)) == NULL) {
+		CREATE(list, struct npc_chat_listeners, 1);
+		VECTOR_INIT(list->ids);
+		idb_put(npc_chat->listeners, nd->bl.m, list);
+	}
+	VECTOR_ENSURE(list->ids, 1, 16);
+	VECTOR_PUSH(list->ids, nd->bl.id);
+}
+
+/**
+ * Whether a pattern can be embedded as an alternative of a combined expression
+ *
+ * Constructs that refer to group numbers or reach outside of their own group
+ * (backreferences, recursion, conditionals, \Q without \E, extended mode
+ * comments, start of pattern verbs) would change meaning once embedded, the
+ * NPC then keeps matching its patterns one by one.
+ */
+static bool npc_chat_combinable(const char *pattern)
+{
+	const char *p;
+
+	nullpo_retr(false, pattern);
+	for (p = pattern; *p != '\0'; p++) {
+		if (p[0] == '\\') {
+			if (p[1] == '\0')
+				return false;
+			if ((p[1] >= '1' && p[1] <= '9') || p[1] == 'g' || p[1] == 'k' || p[1] == 'Q')
+				return false;
+			p++; // skip escaped character
+			continue;
+		}
+		if (p[0] != '(')
+			continue;
+		if (p[1] == '*')
+			return false;
+		if (p[1] == '?') {
+			const char *opt = p + 2;
+			if (*opt == '\0' || strchr("|(P&R+0123456789", *opt) != NULL)
+				return false;
+			if (*opt == '-' && opt[1] >= '0' && opt[1] <= '9')
+				return false;
+			// inline options, (?x) comments would swallow the closing parenthesis
+			for (; *opt != '\0' && *opt != ')' && *opt != ':'; opt++) {
+				if (*opt == 'x')
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Compiles all active patterns of a NPC into one expression
+ *
+ * The expression is anchored at the subject start and each alternative is
+ * preceded by a lazy skip, so the first pattern in priority order that
+ * matches anywhere wins, exactly like trying them one after another.
+ *
+ * @return the matcher, or NULL if the patterns can't be combined.
+ */
+static struct pcrematch_matcher *npc_chat_compile_matcher(struct npc_parse *npcParse)
+{
+	struct pcrematch_matcher *matcher;
+	struct pcrematch_set *pcreset;
+	struct pcrematch_entry *e;
+	StringBuf buf;
+	const char *err;
+	int erroff, count = 0, group = 1;
+
+	nullpo_retr(NULL, npcParse);
+
+	for (pcreset = npcParse->active; pcreset != NULL; pcreset = pcreset->next) {
+		for (e = pcreset->head; e != NULL; e = e->next) {
+			if (e->pcre_ == NULL)
+				continue; // never matches
+			if (!npc_chat->combinable(e->pattern))
+				return NULL;
+			count++;
+		}
+	}
+	if (count < 2)
+		return NULL; // nothing to gain
+
+	CREATE(matcher, struct pcrematch_matcher, 1);
+	CREATE(matcher->entries, struct pcrematch_entry *, count);
+	CREATE(matcher->group, int, count);
+	CREATE(matcher->group_count, int, count);
+
+	StrBuf->Init(&buf);
+	StrBuf->AppendStr(&buf, "\\A(?:");
+	for (pcreset = npcParse->active; pcreset != NULL; pcreset = pcreset->next) {
+		for (e = pcreset->head; e != NULL; e = e->next) {
+			int group_count = 0;
+
+			if (e->pcre_ == NULL)
+				continue;
+			if (libpcre->fullinfo(e->pcre_, NULL, PCRE_INFO_CAPTURECOUNT, &group_count) != 0)
+				break;
+
+			if (matcher->count > 0)
+				StrBuf->AppendStr(&buf, "|");
+			StrBuf->Printf(&buf, "[\\s\\S]*?(%s)", e->pattern);
+			matcher->entries[matcher->count] = e;
+			matcher->group[matcher->count] = group;
+			matcher->group_count[matcher->count] = group_count;
+			matcher->count++;
+			group += 1 + group_count;
+		}
+	}
+	StrBuf->AppendStr(&buf, ")");
+
+	if (matcher->count == count)
+		matcher->pcre_ = libpcre->compile(StrBuf->Value(&buf), PCRE_CASELESS, &err, &erroff, NULL);
+	StrBuf->Destroy(&buf);
+
+	if (matcher->pcre_ == NULL) {
+		npc_chat->free_matcher(matcher);
+		return NULL;
+	}
+
+	matcher->pcre_extra_ = libpcre->study(matcher->pcre_, NPC_CHAT_STUDY_OPTIONS, &err);
+	matcher->ovector_size = 3 * group; // 1/3 reserved for temp space required by pcre_exec
+	CREATE(matcher->ovector, int, matcher->ovector_size);
+
+	return matcher;
+}
+
+/**
+ * Releases a matcher created by npc_chat->compile_matcher
+ */
+static void npc_chat_free_matcher(struct pcrematch_matcher *matcher)
+{
+	if (matcher == NULL)
+		return;
+
+	if (matcher->pcre_ != NULL)
+		libpcre->free(matcher->pcre_);
+	libpcre->free_study(matcher->pcre_extra_);
+	aFree(matcher->entries);
+	aFree(matcher->group);
+	aFree(matcher->group_count);
+	aFree(matcher->ovector);
+	aFree(matcher);
+}
+
+/**
+ * Sets the captured strings and runs the label of a matched pattern
+ *
+ * @param offsets pcre_exec output vector.
+ * @param count   pcre_exec return value.
+ * @param group   Group holding the whole match of the pattern.
+ * @param group_count Number of capture groups of the pattern, following group.
+ * @return true if the label was found and run.
+ */
+static bool npc_chat_run_match(struct npc_data *nd, struct map_session_data *sd, const char *label, const char *msg, int *offsets, int count, int group, int group_count)
+{
+	struct npc_label_list *lst;
+	int i, n = 1;
+
+	nullpo_retr(false, nd);
+	nullpo_retr(false, sd);
+	nullpo_retr(false, label);
+	nullpo_retr(false, offsets);
+
+	// same amount of strings as matching the pattern alone would give
+	for (i = group_count; i > 0; i--) {
+		if (group + i < count && offsets[2 * (group + i)] >= 0) {
+			n = i + 1;
+			break;
+		}
+	}
+
+	// save out the matched strings
+	for (i = 0; i < n; i++) {
+		char var[SCRIPT_VARNAME_LENGTH + 1];
+		char val[SCRIPT_STRING_VAR_LENGTH + 1];
+		snprintf(var, sizeof(var), "$@p%i$", i);
+		libpcre->copy_substring(msg, offsets, count, group + i, val, sizeof(val));
+		script->set_var(sd, var, val);
+	}
+
+	// find the target label.. this sucks..
+	lst = nd->u.scr.label_list;
+	ARR_FIND(0, nd->u.scr.label_list_num, i, strncmp(lst[i].name, label, sizeof(lst[i].name)) == 0);
+	if (i == nd->u.scr.label_list_num) {
+		ShowWarning("npc_chat_run_match: Unable to find label: %s\n", label);
+		return false;
+	}
+
+	// run the npc script
+	script->run_npc(nd->u.scr.script, lst[i].pos, sd->bl.id, nd->bl.id);
+	return true;
+}
+
+/**
+ * Matches a global message against the active patterns of a NPC
+ * and runs the label of the first matching one.
+ */
+static int npc_chat_match(struct npc_data *nd, struct map_session_data *sd, const char *msg, int len)
+{
+	struct npc_parse *npcParse;
+	struct pcrematch_matcher *matcher;
+	struct pcrematch_set *pcreset;
+	struct pcrematch_entry *e;
+
+	nullpo_ret(nd);
+	nullpo_ret(sd);
+	nullpo_ret(msg);
 	npcParse = nd->chatdb;
 
 	// Not interested in anything you might have to say...
 	if (npcParse == NULL || npcParse->active == NULL)
 		return 0;
 
-	msg = va_arg(ap,char*);
-	len = va_arg(ap,int);
-	sd = va_arg(ap,struct map_session_data *);
+	if (npcParse->dirty) {
+		npc_chat->free_matcher(npcParse->matcher);
+		npcParse->matcher = npc_chat->compile_matcher(npcParse);
+		npcParse->dirty = false;
+	}
 
-	nullpo_ret(sd);
+	if ((matcher = npcParse->matcher) != NULL) {
+		int k, r = libpcre->exec(matcher->pcre_, matcher->pcre_extra_, msg, len, 0, 0, matcher->ovector, matcher->ovector_size);
+		if (r <= 0)
+			return 0;
+
+		// only the alternative that matched has its wrapping group set
+		for (k = 0; k < matcher->count; k++) {
+			int group = matcher->group[k];
+			if (group < r && matcher->ovector[2 * group] >= 0) {
+				npc_chat->run_match(nd, sd, matcher->entries[k]->label, msg, matcher->ovector, r, group, matcher->group_count[k]);
+				break;
+			}
+		}
+		return 0;
+	}
 
 	// iterate across all active sets
 	for (pcreset = npcParse->active; pcreset != NULL; pcreset = pcreset->next)
@@ -389,28 +649,8 @@ static int npc_chat_sub(struct block_list *bl, va_list ap)
 
 			// perform pattern match
 			int r = libpcre->exec(e->pcre_, e->pcre_extra_, msg, len, 0, 0, offsets, ARRAYLENGTH(offsets));
-			if (r > 0)
-			{
-				// save out the matched strings
-				for (i = 0; i < r; i++)
-				{
-					char var[SCRIPT_VARNAME_LENGTH + 1];
-					char val[SCRIPT_STRING_VAR_LENGTH + 1];
-					snprintf(var, sizeof(var), "$@p%i$", i);
-					libpcre->copy_substring(msg, offsets, r, i, val, sizeof(val));
-					script->set_var(sd, var, val);
-				}
-
-				// find the target label.. this sucks..
-				lst = nd->u.scr.label_list;
-				ARR_FIND(0, nd->u.scr.label_list_num, i, strncmp(lst[i].name, e->label, sizeof(lst[i].name)) == 0);
-				if (i == nd->u.scr.label_list_num) {
-					ShowWarning("npc_chat_sub: Unable to find label: %s\n", e->label);
-					return 0;
-				}
-
-				// run the npc script
-				script->run_npc(nd->u.scr.script,lst[i].pos,sd->bl.id,nd->bl.id);
+			if (r > 0) {
+				npc_chat->run_match(nd, sd, e->label, msg, offsets, r, 0, r - 1);
 				return 0;
 			}
 		}
@@ -418,6 +658,101 @@ static int npc_chat_sub(struct block_list *bl, va_list ap)
 	return 0;
 }
 
+/**
+ * Handler called whenever a global message is spoken in a NPC's area
+ */
+static int npc_chat_sub(struct block_list *bl, va_list ap)
+{
+	struct npc_data *nd;
+	char *msg;
+	int len;
+	struct map_session_data *sd;
+
+	nullpo_ret(bl);
+	Assert_ret(bl->type == BL_NPC);
+	nd = BL_UCAST(BL_NPC, bl);
+
+	msg = va_arg(ap,char*);
+	len = va_arg(ap,int);
+	sd = va_arg(ap,struct map_session_data *);
+
+	return npc_chat->match(nd, sd, msg, len);
+}
+
+/**
+ * Delivers a global message to the listening NPCs in the speaker's area
+ *
+ * Only NPCs with an active pattern set on the speaker's map are considered,
+ * so chat on maps without listeners costs a single lookup.
+ */
+static void npc_chat_message(struct map_session_data *sd, const char *msg, int len)
+{
+	const struct npc_chat_listeners *list;
+	int ids_buf[32];
+	int *ids = ids_buf;
+	int i, count = 0;
+
+	nullpo_retv(sd);
+	nullpo_retv(msg);
+
+	if (npc_chat->listeners == NULL || (list = idb_get(npc_chat->listeners, sd->bl.m)) == NULL
+	 || VECTOR_LENGTH(list->ids) == 0)
+		return;
+	if (VECTOR_LENGTH(list->ids) > ARRAYLENGTH(ids_buf))
+		ids = aMalloc(VECTOR_LENGTH(list->ids) * sizeof(*ids));
+
+	// scripts may change the listeners, pick the ones in range beforehand
+	for (i = 0; i < VECTOR_LENGTH(list->ids); i++) {
+		struct npc_data *nd = map->id2nd(VECTOR_INDEX(list->ids, i));
+		if (nd != NULL && nd->bl.prev != NULL && nd->bl.m == sd->bl.m && check_distance_bl(&sd->bl, &nd->bl, AREA_SIZE))
+			ids[count++] = nd->bl.id;
+	}
+
+	map->freeblock_lock();
+	for (i = 0; i < count; i++) {
+		struct npc_data *nd = map->id2nd(ids[i]);
+		if (nd != NULL)
+			npc_chat->match(nd, sd, msg, len);
+	}
+	map->freeblock_unlock();
+
+	if (ids != ids_buf)
+		aFree(ids);
+}
+
+/**
+ * Releases the listener index, NPCs are expected to be unloaded already
+ */
+static void npc_chat_final(void)
+{
+	struct DBIterator *iter;
+	struct npc_chat_listeners *list;
+
+	if (npc_chat->listeners == NULL)
+		return;
+
+	iter = db_iterator(npc_chat->listeners);
+	for (list = dbi_first(iter); dbi_exists(iter); list = dbi_next(iter)) {
+		VECTOR_CLEAR(list->ids);
+		aFree(list);
+	}
+	dbi_destroy(iter);
+	db_destroy(npc_chat->listeners);
+	npc_chat->listeners = NULL;
+}
+
+/**
+ * pcre_free_study is only available along with JIT support
+ */
+static void npc_chat_pcre_free_study(pcre_extra *extra)
+{
+#ifdef PCRE_STUDY_JIT_COMPILE
+	pcre_free_study(extra);
+#else
+	pcre_free(extra);
+#endif
+}
+
 // Various script built-ins used to support these functions
 BUILDIN(defpattern)
 {
@@ -469,7 +804,17 @@ void npc_chat_defaults(void)
 {
 	npc_chat = &npc_chat_s;
 
+	npc_chat->listeners = NULL;
+
 	npc_chat->sub = npc_chat_sub;
+	npc_chat->message = npc_chat_message;
+	npc_chat->match = npc_chat_match;
+	npc_chat->run_match = npc_chat_run_match;
+	npc_chat->update_listener = npc_chat_update_listener;
+	npc_chat->combinable = npc_chat_combinable;
+	npc_chat->compile_matcher = npc_chat_compile_matcher;
+	npc_chat->free_matcher = npc_chat_free_matcher;
+	npc_chat->final = npc_chat_final;
 	npc_chat->finalize = npc_chat_finalize;
 	npc_chat->def_pattern = npc_chat_def_pattern;
 	npc_chat->create_pcrematch_entry = create_pcrematch_entry;
@@ -489,4 +834,6 @@ void npc_chat_defaults(void)
 	libpcre->free_substring = pcre_free_substring;
 	libpcre->copy_named_substring = pcre_copy_named_substring;
 	libpcre->get_substring = pcre_get_substring;
+	libpcre->fullinfo = pcre_fullinfo;
+	libpcre->free_study = npc_chat_pcre_free_study;
 }
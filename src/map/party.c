@@ -363,6 +363,8 @@ static int party_recv_info(const struct party *sp, int char_id)
 			}
 		}
 	}
+	// The member data was reset, resend every online member's position (and HP) to the party
+	party->send_xy_clear(p);
 	if( char_id != 0 ) {
 		// requester
 		sd = map->charid2sd(char_id);
@@ -674,7 +676,7 @@ static int party_member_withdraw(int party_id, int account_id, int char_id)
 		if( p && p->instances )
 			instance->check_kick(sd);
 	}
-	if (sd && sd->sc.data[SC_DANCING]) {
+	if (sd && sc_data(&sd->sc, SC_DANCING)) {
 		status_change_end(&sd->bl, SC_DANCING, INVALID_TIMER);
 		status_change_end(&sd->bl, SC_DRUMBATTLE, INVALID_TIMER);
 		status_change_end(&sd->bl, SC_NIBELUNGEN, INVALID_TIMER);
@@ -974,7 +976,7 @@ static int party_skill_check(struct map_session_data *sd, int party_id, uint16 s
 				break;
 			case MO_COMBOFINISH: //Increase Counter rate of Star Gladiators
 				if ((p_sd->job & MAPID_UPPERMASK) == MAPID_STAR_GLADIATOR
-					&& sd->sc.data[SC_COUNTERKICK_READY]
+					&& sc_data(&sd->sc, SC_COUNTERKICK_READY)
 					&& pc->checkskill(p_sd,SG_FRIEND)) {
 					sc_start4(&p_sd->bl,&p_sd->bl,SC_SKILLRATE_UP,100,TK_COUNTER,
 						50+50*pc->checkskill(p_sd,SG_FRIEND), //+100/150/200% rate
@@ -986,41 +988,133 @@ static int party_skill_check(struct map_session_data *sd, int party_id, uint16 s
 	return 0;
 }
 
-static int party_send_xy_timer(int tid, int64 tick, int id, intptr_t data)
+/**
+ * Queues a party member for the next position (and HP) update.
+ *
+ * Called when the player moves or, with party_hp_mode, when its HP changes,
+ * so that party->send_xy_timer only looks at the members that changed.
+ *
+ * @param sd The player.
+ */
+static void party_xy_mark(struct map_session_data *sd)
 {
-	struct DBIterator *iter = db_iterator(party->db);
-	struct party_data* p;
+	nullpo_retv(sd);
 
-	// for each existing party,
-	for( p = dbi_first(iter); dbi_exists(iter); p = dbi_next(iter) )
-	{
+	if (sd->status.party_id == 0 || sd->state.party_xy_dirty)
+		return;
+
+	sd->state.party_xy_dirty = 1;
+	VECTOR_ENSURE(party->xy_dirty, 1, 64);
+	VECTOR_PUSH(party->xy_dirty, sd->bl.id);
+}
+
+/// Orders queued members by party.
+static int party_xy_entry_cmp(const void *a, const void *b)
+{
+	const struct party_xy_entry *ea = a, *eb = b;
+
+	if (ea->party_id != eb->party_id)
+		return ea->party_id < eb->party_id ? -1 : 1;
+	return 0;
+}
+
+/**
+ * Sends the updates of the queued members of a party.
+ *
+ * Each member on the same map as a moved mate receives all the new
+ * positions in a row, instead of one broadcast per moved member.
+ *
+ * @param p       The party.
+ * @param entries The queued members of the party (reordered).
+ * @param count   The amount of entries.
+ */
+static void party_send_xy_batch(struct party_data *p, struct party_xy_entry *entries, int count)
+{
+	int moved = 0;
+
+	nullpo_retv(p);
+	nullpo_retv(entries);
+
+	for (int k = 0; k < count; k++) {
+		struct map_session_data *sd = entries[k].sd;
 		int i;
 
-		if( !p->party.count )
-		{// no online party members so do not iterate
+		ARR_FIND(0, MAX_PARTY, i, p->data[i].sd == sd);
+		if (i == MAX_PARTY)
 			continue;
+
+		if (p->data[i].x != sd->bl.x || p->data[i].y != sd->bl.y) {
+			p->data[i].x = sd->bl.x;
+			p->data[i].y = sd->bl.y;
+			entries[moved++].sd = sd; // Keep the moved members at the front
+		}
+		if (battle_config.party_hp_mode && p->data[i].hp != sd->battle_status.hp) {
+			clif->party_hp(sd);
+			p->data[i].hp = sd->battle_status.hp;
 		}
+	}
 
-		// for each member of this party,
-		for( i = 0; i < MAX_PARTY; i++ )
-		{
-			struct map_session_data* sd = p->data[i].sd;
-			if( !sd || sd->bg_id ) continue;
-
-			if( p->data[i].x != sd->bl.x || p->data[i].y != sd->bl.y )
-			{// perform position update
-				clif->party_xy(sd);
-				p->data[i].x = sd->bl.x;
-				p->data[i].y = sd->bl.y;
-			}
-			if (battle_config.party_hp_mode && p->data[i].hp != sd->battle_status.hp)
-			{// perform hp update
-				clif->party_hp(sd);
-				p->data[i].hp = sd->battle_status.hp;
-			}
+	if (moved == 0)
+		return;
+
+	if (map->enable_spy) {
+		// Party spies only receive the broadcast packets
+		for (int k = 0; k < moved; k++)
+			clif->party_xy(entries[k].sd);
+		return;
+	}
+
+	for (int i = 0; i < MAX_PARTY; i++) {
+		struct map_session_data *tsd = p->data[i].sd;
+
+		if (tsd == NULL || tsd->fd == 0)
+			continue;
+
+		for (int k = 0; k < moved; k++) {
+			if (entries[k].sd != tsd && entries[k].sd->bl.m == tsd->bl.m)
+				clif->party_xy_single(tsd->fd, entries[k].sd);
 		}
 	}
-	dbi_destroy(iter);
+}
+
+/**
+ * Sends the position (and HP) updates of the party members queued by party->xy_mark.
+ */
+static int party_send_xy_timer(int tid, int64 tick, int id, intptr_t data)
+{
+	int count;
+
+	if (VECTOR_LENGTH(party->xy_dirty) == 0)
+		return 0;
+
+	VECTOR_TRUNCATE(party->xy_batch);
+	VECTOR_ENSURE(party->xy_batch, VECTOR_LENGTH(party->xy_dirty), 64);
+	for (int k = 0; k < VECTOR_LENGTH(party->xy_dirty); k++) {
+		struct map_session_data *sd = map->id2sd(VECTOR_INDEX(party->xy_dirty, k));
+
+		if (sd == NULL)
+			continue;
+		sd->state.party_xy_dirty = 0;
+		if (sd->status.party_id == 0 || sd->bg_id != 0)
+			continue;
+
+		VECTOR_PUSHZEROED(party->xy_batch);
+		VECTOR_LAST(party->xy_batch).party_id = sd->status.party_id;
+		VECTOR_LAST(party->xy_batch).sd = sd;
+	}
+	VECTOR_TRUNCATE(party->xy_dirty);
+	count = VECTOR_LENGTH(party->xy_batch);
+
+	qsort(VECTOR_DATA(party->xy_batch), count, sizeof(struct party_xy_entry), party->xy_entry_cmp);
+	for (int start = 0, end; start < count; start = end) {
+		int party_id = VECTOR_INDEX(party->xy_batch, start).party_id;
+		struct party_data *p = party->search(party_id);
+
+		for (end = start + 1; end < count && VECTOR_INDEX(party->xy_batch, end).party_id == party_id; end++)
+			;
+		if (p != NULL)
+			party->send_xy_batch(p, &VECTOR_INDEX(party->xy_batch, start), end - start);
+	}
 
 	return 0;
 }
@@ -1036,6 +1130,7 @@ static int party_send_xy_clear(struct party_data *p)
 		p->data[i].hp = 0;
 		p->data[i].x = 0;
 		p->data[i].y = 0;
+		party->xy_mark(p->data[i].sd);
 	}
 	return 0;
 }
@@ -1557,6 +1652,8 @@ static void do_final_party(void)
 {
 	party->db->destroy(party->db,party->db_final);
 	db_destroy(party->booking_db); // Party Booking [Spiria]
+	VECTOR_CLEAR(party->xy_dirty);
+	VECTOR_CLEAR(party->xy_batch);
 }
 // Constructor, init vars
 static void do_init_party(bool minimal)
@@ -1566,6 +1663,8 @@ static void do_init_party(bool minimal)
 
 	party->db = idb_alloc(DB_OPT_RELEASE_DATA);
 	party->booking_db = idb_alloc(DB_OPT_RELEASE_DATA); // Party Booking [Spiria]
+	VECTOR_INIT(party->xy_dirty);
+	VECTOR_INIT(party->xy_batch);
 	timer->add_func_list(party->send_xy_timer, "party_send_xy_timer");
 	timer->add_interval(timer->gettick()+battle_config.party_update_interval, party->send_xy_timer, 0, 0, battle_config.party_update_interval);
 }
@@ -1630,6 +1729,9 @@ void party_defaults(void)
 	party->vforeachsamemap = party_vforeachsamemap;
 	party->foreachsamemap = party_foreachsamemap;
 	party->send_xy_timer = party_send_xy_timer;
+	party->xy_mark = party_xy_mark;
+	party->xy_entry_cmp = party_xy_entry_cmp;
+	party->send_xy_batch = party_send_xy_batch;
 	party->fill_member = party_fill_member;
 	party->sd_check = party_sd_check;
 	party->check_state = party_check_state;
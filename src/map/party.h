@@ -44,6 +44,12 @@ struct party_member_data {
 	unsigned short x, y;
 };
 
+/// A queued party member, grouped by party when the updates are sent.
+struct party_xy_entry {
+	int party_id;
+	struct map_session_data *sd;
+};
+
 struct party_data {
 	struct party party;
 	struct party_member_data data[MAX_PARTY];
@@ -93,6 +99,8 @@ struct party_booking_ad_info {
 struct party_interface {
 	struct DBMap *db; // int party_id -> struct party_data* (releases data)
 	struct DBMap *booking_db; // int char_id -> struct party_booking_ad_info* (releases data) // Party Booking [Spiria]
+	VECTOR_DECL(int) xy_dirty; ///< Account IDs of the members that moved (or whose HP changed) since the last update.
+	VECTOR_DECL(struct party_xy_entry) xy_batch; ///< Work buffer of send_xy_timer.
 	unsigned int booking_nextid;
 	/* funcs */
 	void (*init) (bool minimal);
@@ -146,6 +154,9 @@ struct party_interface {
 	int (*vforeachsamemap) (int (*func)(struct block_list *,va_list),struct map_session_data *sd,int range, va_list ap);
 	int (*foreachsamemap) (int (*func)(struct block_list *,va_list),struct map_session_data *sd,int range,...);
 	int (*send_xy_timer) (int tid, int64 tick, int id, intptr_t data);
+	void (*xy_mark) (struct map_session_data *sd);
+	int (*xy_entry_cmp) (const void *a, const void *b);
+	void (*send_xy_batch) (struct party_data *p, struct party_xy_entry *entries, int count);
 	void (*fill_member) (struct party_member* member, struct map_session_data* sd, unsigned int leader);
 	struct map_session_data *(*sd_check) (int party_id, int account_id, int char_id);
 	void (*check_state) (struct party_data *p);
@@ -224,8 +224,8 @@ static int pc_getmaxspiritball(struct map_session_data *sd, int min)
 
 	if ( min && result < min )
 		result = min;
-	else if ( sd->sc.data[SC_RAISINGDRAGON] )
-		result += sd->sc.data[SC_RAISINGDRAGON]->val1;
+	else if ( sc_data(&sd->sc, SC_RAISINGDRAGON) )
+		result += sc_data(&sd->sc, SC_RAISINGDRAGON)->val1;
 	if ( result > MAX_SPIRITBALL )
 		result = MAX_SPIRITBALL;
 	return result;
@@ -330,7 +330,7 @@ static void pc_addsoulball(struct map_session_data *sd, int max)
 
 	const struct status_change *sc = status->get_sc(&sd->bl);
 
-	if (sc == NULL || sc->data[SC_SOULENERGY] == NULL) {
+	if (sc == NULL || sc_data(sc, SC_SOULENERGY) == NULL) {
 		sc_start(&sd->bl, &sd->bl, SC_SOULENERGY, 100, 0, skill->get_time2(SP_SOULCOLLECT, 1), 0);
 		sd->soulball = 0;
 	}
@@ -359,14 +359,14 @@ static void pc_delsoulball(struct map_session_data *sd, int count, bool type)
 
 	struct status_change *sc = status->get_sc(&sd->bl);
 
-	if (sd->soulball <= 0 || sc == NULL || sc->data[SC_SOULENERGY] == NULL) {
+	if (sd->soulball <= 0 || sc == NULL || sc_data(sc, SC_SOULENERGY) == NULL) {
 		sd->soulball = 0;
 	} else {
 		sd->soulball -= cap_value(count, 0, sd->soulball);
 		if (sd->soulball == 0)
 			status_change_end(&sd->bl, SC_SOULENERGY, INVALID_TIMER);
 		else
-			sc->data[SC_SOULENERGY]->val1 = sd->soulball;
+			sc_data(sc, SC_SOULENERGY)->val1 = sd->soulball;
 	}
 
 	if (type == 0)
@@ -393,7 +393,7 @@ static int pc_check_banding(struct block_list *bl, va_list ap)
 
 	sc = status->get_sc(bl);
 
-	if( sc && sc->data[SC_BANDING] )
+	if( sc && sc_data(sc, SC_BANDING) )
 	{
 		b_sd[(*c)++] = tsd->bl.id;
 		return 1;
@@ -418,9 +418,9 @@ static int pc_banding(struct map_session_data *sd, uint16 skill_lv)
 
 	if( c < 1 ) {
 		//just recalc status no need to recalc hp
-		if( (sc = status->get_sc(&sd->bl)) != NULL  && sc->data[SC_BANDING] ) {
+		if( (sc = status->get_sc(&sd->bl)) != NULL  && sc_data(sc, SC_BANDING) ) {
 			// No more Royal Guards in Banding found.
-			sc->data[SC_BANDING]->val2 = 0; // Reset the counter
+			sc_data(sc, SC_BANDING)->val2 = 0; // Reset the counter
 			status_calc_bl(&sd->bl, status->sc2scb_flag(SC_BANDING));
 		}
 		return 0;
@@ -457,8 +457,8 @@ static int pc_banding(struct map_session_data *sd, uint16 skill_lv)
 		bsd = map->id2sd(b_sd[j]);
 		if( bsd != NULL ) {
 			status->set_hp(&bsd->bl, hp, STATUS_HEAL_DEFAULT); // Set hp
-			if( (sc = status->get_sc(&bsd->bl)) != NULL  && sc->data[SC_BANDING] ) {
-				sc->data[SC_BANDING]->val2 = c; // Set the counter. It doesn't count your self.
+			if( (sc = status->get_sc(&bsd->bl)) != NULL  && sc_data(sc, SC_BANDING) ) {
+				sc_data(sc, SC_BANDING)->val2 = c; // Set the counter. It doesn't count your self.
 				status_calc_bl(&bsd->bl, status->sc2scb_flag(SC_BANDING)); // Set atk and def.
 			}
 		}
@@ -699,7 +699,7 @@ static int pc_makesavestatus(struct map_session_data *sd)
 #else
 	sd->status.option = sd->sc.option&(OPTION_INVISIBLE|OPTION_CART|OPTION_FALCON|OPTION_RIDING|OPTION_DRAGON|OPTION_WUG|OPTION_WUGRIDER|OPTION_MADOGEAR);
 #endif
-	if (sd->sc.data[SC_JAILED]) { //When Jailed, do not move last point.
+	if (sc_data(&sd->sc, SC_JAILED)) { //When Jailed, do not move last point.
 		if(pc_isdead(sd)){
 			pc->setrestartvalue(sd,0);
 		} else {
@@ -766,6 +766,7 @@ static int pc_setnewpc(struct map_session_data *sd, int account_id, int char_id,
 	sd->battle_status.speed = sd->base_status.speed = DEFAULT_WALK_SPEED;
 	sd->state.warp_clean = 1;
 	sd->catch_target_class = -1;
+	pc->inventory_index_build(sd);
 	return 0;
 }
 
@@ -837,6 +838,7 @@ static int pc_setinventorydata(struct map_session_data *sd)
 		int id = sd->status.inventory[i].nameid;
 		sd->inventory_data[i] = id?itemdb->search(id):NULL;
 	}
+	pc->inventory_index_build(sd);
 	return 0;
 }
 
@@ -1129,25 +1131,25 @@ static int pc_isequip(struct map_session_data *sd, int n)
 	}
 
 	if (sd->sc.count != 0) {
-		if ((item->equip & EQP_ARMS) != 0 && item->type == IT_WEAPON && sd->sc.data[SC_NOEQUIPWEAPON] != NULL) // Also works with left-hand weapons. [DracoRPG]
+		if ((item->equip & EQP_ARMS) != 0 && item->type == IT_WEAPON && sc_data(&sd->sc, SC_NOEQUIPWEAPON) != NULL) // Also works with left-hand weapons. [DracoRPG]
 			return 0;
 
-		if ((item->equip & EQP_SHIELD) != 0 && item->type == IT_ARMOR && sd->sc.data[SC_NOEQUIPSHIELD] != NULL)
+		if ((item->equip & EQP_SHIELD) != 0 && item->type == IT_ARMOR && sc_data(&sd->sc, SC_NOEQUIPSHIELD) != NULL)
 			return 0;
 
-		if ((item->equip & EQP_ARMOR) != 0 && sd->sc.data[SC_NOEQUIPARMOR] != NULL)
+		if ((item->equip & EQP_ARMOR) != 0 && sc_data(&sd->sc, SC_NOEQUIPARMOR) != NULL)
 			return 0;
 
-		if ((item->equip & EQP_HEAD_TOP) != 0 && sd->sc.data[SC_NOEQUIPHELM] != NULL)
+		if ((item->equip & EQP_HEAD_TOP) != 0 && sc_data(&sd->sc, SC_NOEQUIPHELM) != NULL)
 			return 0;
 
-		if ((item->equip & EQP_ACC) != 0 && sd->sc.data[SC__STRIPACCESSARY] != NULL)
+		if ((item->equip & EQP_ACC) != 0 && sc_data(&sd->sc, SC__STRIPACCESSARY) != NULL)
 			return 0;
 
-		if (item->equip != 0 && sd->sc.data[SC_KYOUGAKU] != NULL)
+		if (item->equip != 0 && sc_data(&sd->sc, SC_KYOUGAKU) != NULL)
 			return 0;
 
-		if (sd->sc.data[SC_SOULLINK] != NULL && sd->sc.data[SC_SOULLINK]->val2 == SL_SUPERNOVICE) { // Spirit of Super Novice equip bonuses. [Skotlex]
+		if (sc_data(&sd->sc, SC_SOULLINK) != NULL && sc_data(&sd->sc, SC_SOULLINK)->val2 == SL_SUPERNOVICE) { // Spirit of Super Novice equip bonuses. [Skotlex]
 			if (sd->status.base_level > 90 && (item->equip & EQP_HELM) != 0)
 				return 1; // Can equip all helms.
 
@@ -1591,8 +1593,7 @@ static int pc_reg_received(struct map_session_data *sd)
 	//Auth is fully okay, update last_login
 	sd->status.last_login = time(NULL);
 
-	// Storage Request
-	intif->request_account_storage(sd);
+	// Account storage is requested on first use, see storage_storageopen().
 
 	intif->Mail_requestinbox(sd->status.char_id, 0); // MAIL SYSTEM - Request Mail Inbox
 	intif->request_questlog(sd);
@@ -1782,7 +1783,7 @@ static int pc_calc_skilltree(struct map_session_data *sd)
 				if(!sd->status.skill[idx].lv && (
 					(inf2&INF2_QUEST_SKILL && !battle_config.quest_skill_learn) ||
 					inf2&INF2_WEDDING_SKILL ||
-					(inf2&INF2_SPIRIT_SKILL && !sd->sc.data[SC_SOULLINK])
+					(inf2&INF2_SPIRIT_SKILL && !sc_data(&sd->sc, SC_SOULLINK))
 				))
 					continue; //Cannot be learned via normal means. Note this check DOES allows raising already known skills.
 
@@ -1896,7 +1897,7 @@ static void pc_check_skilltree(struct map_session_data *sd, int skill_id)
 			if( !sd->status.skill[idx].lv && (
 				(j&INF2_QUEST_SKILL && !battle_config.quest_skill_learn) ||
 				j&INF2_WEDDING_SKILL ||
-				(j&INF2_SPIRIT_SKILL && !sd->sc.data[SC_SOULLINK])
+				(j&INF2_SPIRIT_SKILL && !sc_data(&sd->sc, SC_SOULLINK))
 			) )
 				continue; //Cannot be learned via normal means.
 
@@ -2014,7 +2015,7 @@ static int pc_updateweightstatus(struct map_session_data *sd)
 
 	nullpo_retr(1, sd);
 
-	old_overweight = (sd->sc.data[SC_WEIGHTOVER90]) ? 2 : (sd->sc.data[SC_WEIGHTOVER50]) ? 1 : 0;
+	old_overweight = (sc_data(&sd->sc, SC_WEIGHTOVER90)) ? 2 : (sc_data(&sd->sc, SC_WEIGHTOVER50)) ? 1 : 0;
 	new_overweight = (pc_is90overweight(sd)) ? 2 : (pc_isoverhealweight(sd)) ? 1 : 0;
 
 	if( old_overweight == new_overweight )
@@ -4552,13 +4553,12 @@ static int pc_checkadditem(struct map_session_data *sd, int nameid, int amount)
 	if( data->stack.inventory && amount > data->stack.amount )
 		return ADDITEM_OVERAMOUNT;
 
-	for(int i = 0; i < sd->status.inventorySize; i++) {
-		// FIXME: This does not consider the checked item's cards, thus could check a wrong slot for stackability.
-		if(sd->status.inventory[i].nameid==nameid){
-			if( amount > MAX_AMOUNT - sd->status.inventory[i].amount || ( data->stack.inventory && amount > data->stack.amount - sd->status.inventory[i].amount ) )
-				return ADDITEM_OVERAMOUNT;
-			return ADDITEM_EXIST;
-		}
+	int i = pc->inventory_first(sd, nameid);
+	// FIXME: This does not consider the checked item's cards, thus could check a wrong slot for stackability.
+	if (i != INDEX_NOT_FOUND && i < sd->status.inventorySize) {
+		if( amount > MAX_AMOUNT - sd->status.inventory[i].amount || ( data->stack.inventory && amount > data->stack.amount - sd->status.inventory[i].amount ) )
+			return ADDITEM_OVERAMOUNT;
+		return ADDITEM_EXIST;
 	}
 
 	return ADDITEM_NEW;
@@ -4573,8 +4573,11 @@ static int pc_inventoryblank(struct map_session_data *sd)
 	nullpo_ret(sd);
 	int b = 0;
 
-	for (int i = 0; i < sd->status.inventorySize; i++) {
-		if(sd->status.inventory[i].nameid==0)
+	for (int word = 0; word * 32 < sd->status.inventorySize; word++) {
+		uint32 bits = sd->inventory_index.free[word];
+		if ((word + 1) * 32 > sd->status.inventorySize)
+			bits &= (1U << (sd->status.inventorySize % 32)) - 1;
+		for (; bits != 0; bits &= bits - 1)
 			b++;
 	}
 
@@ -4766,12 +4769,192 @@ static int pc_getzeny(struct map_session_data *sd, int zeny, enum e_log_pick_typ
  * @retval INDEX_NOT_FOUND if the item wasn't found.
  */
 static int pc_search_inventory(struct map_session_data *sd, int item_id)
+{
+	nullpo_retr(INDEX_NOT_FOUND, sd);
+
+	if (item_id == 0)
+		return pc->inventory_free_slot(sd);
+
+	for (int i = pc->inventory_first(sd, item_id); i != INDEX_NOT_FOUND && i < sd->status.inventorySize; i = pc->inventory_next(sd, i)) {
+		if (sd->status.inventory[i].amount > 0)
+			return i;
+	}
+	return INDEX_NOT_FOUND;
+}
+
+/**
+ * Rebuilds the inventory index of a player from its inventory.
+ *
+ * @param sd The player.
+ */
+static void pc_inventory_index_build(struct map_session_data *sd)
+{
+	struct s_inventory_index *idx;
+
+	nullpo_retv(sd);
+	idx = &sd->inventory_index;
+
+	for (int b = 0; b < INVENTORY_INDEX_BUCKETS; b++)
+		idx->head[b] = INDEX_NOT_FOUND;
+	memset(idx->free, 0, sizeof(idx->free));
+
+	// Walk backwards, so that pushing to the front of the buckets keeps them in ascending order
+	for (int i = MAX_INVENTORY - 1; i >= 0; i--) {
+		int b = sd->status.inventory[i].nameid & (INVENTORY_INDEX_BUCKETS - 1);
+
+		if (sd->status.inventory[i].nameid == 0) {
+			idx->free[i / 32] |= 1U << (i % 32);
+			continue;
+		}
+		idx->next[i] = idx->head[b];
+		idx->head[b] = i;
+	}
+}
+
+/**
+ * Adds an inventory slot to the index, after an item was stored in it.
+ *
+ * @param sd The player.
+ * @param n  The inventory slot.
+ */
+static void pc_inventory_index_add(struct map_session_data *sd, int n)
+{
+	struct s_inventory_index *idx;
+	int16 *link;
+
+	nullpo_retv(sd);
+	Assert_retv(n >= 0 && n < MAX_INVENTORY);
+	Assert_retv(sd->status.inventory[n].nameid != 0);
+	idx = &sd->inventory_index;
+
+	link = &idx->head[sd->status.inventory[n].nameid & (INVENTORY_INDEX_BUCKETS - 1)];
+	while (*link != INDEX_NOT_FOUND && *link < n)
+		link = &idx->next[*link];
+	if (*link == n)
+		return; // Already indexed
+
+	idx->next[n] = *link;
+	*link = n;
+	idx->free[n / 32] &= ~(1U << (n % 32));
+}
+
+/**
+ * Removes an inventory slot from the index, before its item is cleared.
+ *
+ * @param sd The player.
+ * @param n  The inventory slot.
+ */
+static void pc_inventory_index_remove(struct map_session_data *sd, int n)
+{
+	struct s_inventory_index *idx;
+	int16 *link;
+
+	nullpo_retv(sd);
+	Assert_retv(n >= 0 && n < MAX_INVENTORY);
+	idx = &sd->inventory_index;
+
+	link = &idx->head[sd->status.inventory[n].nameid & (INVENTORY_INDEX_BUCKETS - 1)];
+	while (*link != INDEX_NOT_FOUND && *link < n)
+		link = &idx->next[*link];
+	if (*link == n)
+		*link = idx->next[n];
+	idx->free[n / 32] |= 1U << (n % 32);
+}
+
+/**
+ * Returns the first inventory slot holding an item.
+ *
+ * Slots past the current inventory size are returned as well, callers
+ * have to check them.
+ *
+ * @param sd     The player.
+ * @param nameid The item ID.
+ * @return the lowest slot holding the item, or INDEX_NOT_FOUND.
+ */
+static int pc_inventory_first(struct map_session_data *sd, int nameid)
 {
 	int i;
+
+	nullpo_retr(INDEX_NOT_FOUND, sd);
+	if (nameid == 0)
+		return INDEX_NOT_FOUND;
+
+	i = sd->inventory_index.head[nameid & (INVENTORY_INDEX_BUCKETS - 1)];
+	while (i != INDEX_NOT_FOUND && sd->status.inventory[i].nameid != nameid)
+		i = sd->inventory_index.next[i];
+	return i;
+}
+
+/**
+ * Returns the next inventory slot holding the same item as a slot.
+ *
+ * @code
+ *	for (i = pc->inventory_first(sd, nameid); i != INDEX_NOT_FOUND; i = pc->inventory_next(sd, i)) {
+ *		// sd->status.inventory[i].nameid == nameid here
+ *	}
+ * @endcode
+ *
+ * @param sd The player.
+ * @param n  The current slot, which must still hold the item.
+ * @return the next slot holding the item, or INDEX_NOT_FOUND.
+ */
+static int pc_inventory_next(struct map_session_data *sd, int n)
+{
+	int nameid, i;
+
 	nullpo_retr(INDEX_NOT_FOUND, sd);
+	Assert_retr(INDEX_NOT_FOUND, n >= 0 && n < MAX_INVENTORY);
 
-	ARR_FIND(0, sd->status.inventorySize, i, sd->status.inventory[i].nameid == item_id && (sd->status.inventory[i].amount > 0 || item_id == 0));
-	return (i < sd->status.inventorySize) ? i : INDEX_NOT_FOUND;
+	nameid = sd->status.inventory[n].nameid;
+	i = sd->inventory_index.next[n];
+	while (i != INDEX_NOT_FOUND && sd->status.inventory[i].nameid != nameid)
+		i = sd->inventory_index.next[i];
+	return i;
+}
+
+/**
+ * Returns the first empty inventory slot.
+ *
+ * @param sd The player.
+ * @return the slot, or INDEX_NOT_FOUND if the inventory is full.
+ */
+static int pc_inventory_free_slot(struct map_session_data *sd)
+{
+	nullpo_retr(INDEX_NOT_FOUND, sd);
+
+	for (int word = 0; word < INVENTORY_FREE_WORDS; word++) {
+		uint32 bits = sd->inventory_index.free[word];
+		int i;
+
+		if (bits == 0)
+			continue;
+#if defined(__GNUC__)
+		i = word * 32 + __builtin_ctz(bits);
+#else
+		for (i = word * 32; (bits & 1) == 0; i++)
+			bits >>= 1;
+#endif
+		return (i < sd->status.inventorySize) ? i : INDEX_NOT_FOUND;
+	}
+	return INDEX_NOT_FOUND;
+}
+
+/**
+ * Counts the amount of an item in the inventory.
+ *
+ * @param sd     The player.
+ * @param nameid The item ID.
+ * @return the total amount.
+ */
+static int pc_inventory_count(struct map_session_data *sd, int nameid)
+{
+	int count = 0;
+
+	nullpo_ret(sd);
+
+	for (int i = pc->inventory_first(sd, nameid); i != INDEX_NOT_FOUND && i < sd->status.inventorySize; i = pc->inventory_next(sd, i))
+		count += sd->status.inventory[i].amount;
+	return count;
 }
 
 /*==========================================
@@ -4839,9 +5022,8 @@ static int pc_additem(struct map_session_data *sd, const struct item *item_data,
 
 	// Stackable | Non Rental
 	if( itemdb->isstackable2(data) && item_data->expire_time == 0 ) {
-		for (i = 0; i < sd->status.inventorySize; i++) {
-			if( sd->status.inventory[i].nameid == item_data->nameid &&
-			    sd->status.inventory[i].bound == item_data->bound &&
+		for (i = pc->inventory_first(sd, item_data->nameid); i != INDEX_NOT_FOUND && i < sd->status.inventorySize; i = pc->inventory_next(sd, i)) {
+			if( sd->status.inventory[i].bound == item_data->bound &&
 			    sd->status.inventory[i].expire_time == 0 &&
 				sd->status.inventory[i].unique_id == item_data->unique_id &&
 			    memcmp(&sd->status.inventory[i].card, &item_data->card, sizeof(item_data->card)) == 0 ) {
@@ -4852,6 +5034,8 @@ static int pc_additem(struct map_session_data *sd, const struct item *item_data,
 				break;
 			}
 		}
+		if (i == INDEX_NOT_FOUND)
+			i = sd->status.inventorySize;
 	}
 
 	if (i >= sd->status.inventorySize) {
@@ -4868,6 +5052,7 @@ static int pc_additem(struct map_session_data *sd, const struct item *item_data,
 
 		sd->status.inventory[i].amount = amount;
 		sd->inventory_data[i] = data;
+		pc->inventory_index_add(sd, i);
 		clif->additem(sd,i,amount,0);
 
 	}
@@ -4940,6 +5125,7 @@ static int pc_delitem(struct map_session_data *sd, int n, int amount, int type,
 	if( sd->status.inventory[n].amount <= 0 ){
 		if(sd->status.inventory[n].equip)
 			pc->unequipitem(sd, n, PCUNEQUIPITEM_RECALC|PCUNEQUIPITEM_FORCE);
+		pc->inventory_index_remove(sd, n);
 		memset(&sd->status.inventory[n],0,sizeof(sd->status.inventory[0]));
 		sd->inventory_data[n] = NULL;
 	}
@@ -5200,7 +5386,7 @@ static int pc_isUseitem(struct map_session_data *sd, int n)
 		case ITEMID_M_BERSERK_POTION:
 			if( sd->md == NULL || sd->md->db == NULL )
 				return 0;
-			if (sd->md->sc.data[SC_BERSERK])
+			if (sc_data(&sd->md->sc, SC_BERSERK))
 				return 0;
 			if( nameid == ITEMID_M_AWAKENING_POTION && sd->md->db->lv < 40 )
 				return 0;
@@ -5357,19 +5543,19 @@ static int pc_useitem(struct map_session_data *sd, int n)
 
 	// Statuses that don't let the player use items
 	if (sd->sc.count && (
-		sd->sc.data[SC_BERSERK] ||
-		(sd->sc.data[SC_GRAVITATION] && sd->sc.data[SC_GRAVITATION]->val3 == BCT_SELF) ||
-		sd->sc.data[SC_TRICKDEAD] ||
-		sd->sc.data[SC_HIDING] ||
-		sd->sc.data[SC__SHADOWFORM] ||
-		sd->sc.data[SC__INVISIBILITY] ||
-		sd->sc.data[SC__MANHOLE] ||
-		sd->sc.data[SC_KG_KAGEHUMI] ||
-		sd->sc.data[SC_WHITEIMPRISON] ||
-		sd->sc.data[SC_DEEP_SLEEP] ||
-		sd->sc.data[SC_SATURDAY_NIGHT_FEVER] ||
-		sd->sc.data[SC_COLD] ||
-		sd->sc.data[SC_SUHIDE] ||
+		sc_data(&sd->sc, SC_BERSERK) ||
+		(sc_data(&sd->sc, SC_GRAVITATION) && sc_data(&sd->sc, SC_GRAVITATION)->val3 == BCT_SELF) ||
+		sc_data(&sd->sc, SC_TRICKDEAD) ||
+		sc_data(&sd->sc, SC_HIDING) ||
+		sc_data(&sd->sc, SC__SHADOWFORM) ||
+		sc_data(&sd->sc, SC__INVISIBILITY) ||
+		sc_data(&sd->sc, SC__MANHOLE) ||
+		sc_data(&sd->sc, SC_KG_KAGEHUMI) ||
+		sc_data(&sd->sc, SC_WHITEIMPRISON) ||
+		sc_data(&sd->sc, SC_DEEP_SLEEP) ||
+		sc_data(&sd->sc, SC_SATURDAY_NIGHT_FEVER) ||
+		sc_data(&sd->sc, SC_COLD) ||
+		sc_data(&sd->sc, SC_SUHIDE) ||
 		pc_ismuted(&sd->sc, MANNER_NOITEM)
 	    ))
 		return 0;
@@ -5380,7 +5566,7 @@ static int pc_useitem(struct map_session_data *sd, int n)
 
 	/* Items with delayed consume are not meant to work while in mounts except reins of mount(12622) */
 	if (sd->inventory_data[n]->flag.delay_consume && nameid != ITEMID_BOARDING_HALTER) {
-		if( sd->sc.data[SC_ALL_RIDING] )
+		if( sc_data(&sd->sc, SC_ALL_RIDING) )
 			return 0;
 		else if( pc_issit(sd) )
 			return 0;
@@ -5439,8 +5625,8 @@ static int pc_useitem(struct map_session_data *sd, int n)
 
 				// If Earth Spike Scroll is used while SC_EARTHSCROLL is active, there is a chance to don't consume the scroll. [Kenpachi]
 				if ((nameid == ITEMID_EARTH_SCROLL_1_3 || nameid == ITEMID_EARTH_SCROLL_1_5)
-				    && sd->sc.count > 0 && sd->sc.data[SC_EARTHSCROLL] != NULL
-				    && rnd() % 100 > sd->sc.data[SC_EARTHSCROLL]->val2) {
+				    && sd->sc.count > 0 && sc_data(&sd->sc, SC_EARTHSCROLL) != NULL
+				    && rnd() % 100 > sc_data(&sd->sc, SC_EARTHSCROLL)->val2) {
 					return 0;
 				}
 
@@ -5475,7 +5661,7 @@ static int pc_useitem(struct map_session_data *sd, int n)
 	if (sd->status.inventory[n].card[0] == CARD0_CREATE
 	 && pc->fame_rank(MakeDWord(sd->status.inventory[n].card[2], sd->status.inventory[n].card[3]), RANKTYPE_ALCHEMIST) > 0) {
 		script->potion_flag = 2; // Famous player's potions have 50% more efficiency
-		if (sd->sc.data[SC_SOULLINK] && sd->sc.data[SC_SOULLINK]->val2 == SL_ROGUE)
+		if (sc_data(&sd->sc, SC_SOULLINK) && sc_data(&sd->sc, SC_SOULLINK)->val2 == SL_ROGUE)
 			script->potion_flag = 3; //Even more effective potions.
 	}
 
@@ -5490,7 +5676,7 @@ static int pc_useitem(struct map_session_data *sd, int n)
 
 	// If Earth Spike Scroll is used while SC_EARTHSCROLL is active, there is a chance to don't consume the scroll. [Kenpachi]
 	if ((nameid == ITEMID_EARTH_SCROLL_1_3 || nameid == ITEMID_EARTH_SCROLL_1_5) && sd->sc.count > 0
-	    && sd->sc.data[SC_EARTHSCROLL] != NULL && rnd() % 100 > sd->sc.data[SC_EARTHSCROLL]->val2) {
+	    && sc_data(&sd->sc, SC_EARTHSCROLL) != NULL && rnd() % 100 > sc_data(&sd->sc, SC_EARTHSCROLL)->val2) {
 		removeItem = false;
 	}
 
@@ -5907,7 +6093,7 @@ static int pc_steal_coin(struct map_session_data *sd, struct block_list *target,
 	if (sd == NULL || md == NULL)
 		return 0;
 
-	if (md->state.steal_coin_flag || md->sc.data[SC_STONE] || md->sc.data[SC_FREEZE] || md->status.mode&MD_BOSS)
+	if (md->state.steal_coin_flag || sc_data(&md->sc, SC_STONE) || sc_data(&md->sc, SC_FREEZE) || md->status.mode&MD_BOSS)
 		return 0;
 
 	if (mob_is_treasure(md))
@@ -6055,7 +6241,7 @@ static int pc_setpos(struct map_session_data *sd, unsigned short map_index, int
 			map->cellfromcache(&map->list[map_id]);
 
 		if (sd->sc.count != 0) { // Cancel some map related stuff.
-			if (sd->sc.data[SC_JAILED] != NULL)
+			if (sc_data(&sd->sc, SC_JAILED) != NULL)
 				return 4; // You may not get out!
 
 			status_change_end(&sd->bl, SC_CASH_BOSS_ALARM, INVALID_TIMER);
@@ -6069,8 +6255,8 @@ static int pc_setpos(struct map_session_data *sd, unsigned short map_index, int
 			status_change_end(&sd->bl, SC_STEALTHFIELD_MASTER, INVALID_TIMER);
 			status_change_end(&sd->bl, SC_STEALTHFIELD, INVALID_TIMER);
 
-			if (sd->sc.data[SC_KNOWLEDGE] != NULL) {
-				struct status_change_entry *sce = sd->sc.data[SC_KNOWLEDGE];
+			if (sc_data(&sd->sc, SC_KNOWLEDGE) != NULL) {
+				struct status_change_entry *sce = sc_data(&sd->sc, SC_KNOWLEDGE);
 
 				if (sce->timer != INVALID_TIMER)
 					timer->delete(sce->timer, status->change_timer);
@@ -6346,18 +6532,18 @@ static int pc_checkallowskill(struct map_session_data *sd)
 		// Skills requiring specific weapon types
 		if( scw_list[i] == SC_DANCING && !battle_config.dancing_weaponswitch_fix )
 			continue;
-		if( sd->sc.data[scw_list[i]]
+		if( sc_data(&sd->sc, scw_list[i])
 		 && !pc_check_weapontype(sd,skill->get_weapontype(status->sc2skill(scw_list[i]))))
 			status_change_end(&sd->bl, scw_list[i], INVALID_TIMER);
 	}
 
-	if(sd->sc.data[SC_STRUP] && sd->weapontype != W_FIST)
+	if(sc_data(&sd->sc, SC_STRUP) && sd->weapontype != W_FIST)
 		// Spurt requires bare hands (feet, in fact xD)
 		status_change_end(&sd->bl, SC_STRUP, INVALID_TIMER);
 
 	if (!sd->has_shield) { // Skills requiring a shield
 		for (i = 0; i < ARRAYLENGTH(scs_list); i++)
-			if(sd->sc.data[scs_list[i]])
+			if(sc_data(&sd->sc, scs_list[i]))
 				status_change_end(&sd->bl, scs_list[i], INVALID_TIMER);
 	}
 	return 0;
@@ -6398,7 +6584,7 @@ int pc_get_skill_cooldown(struct map_session_data *sd, uint16 skill_id, uint16 s
 
 	if (skill_id == SJ_NOVAEXPLOSING) {
 		const struct status_change *sc = status->get_sc(&sd->bl);
-		if (sc != NULL && sc->data[SC_DIMENSION] != NULL)
+		if (sc != NULL && sc_data(sc, SC_DIMENSION) != NULL)
 			return 0;
 	}
 
@@ -6858,16 +7044,16 @@ static void pc_calcexp(struct map_session_data *sd, uint64 *base_exp, uint64 *jo
 
 
 	//Buffs modifier
-	if (sd->sc.data[SC_CASH_PLUSEXP]) {
-		buff_job_ratio += sd->sc.data[SC_CASH_PLUSEXP]->val1;
-		buff_ratio += sd->sc.data[SC_CASH_PLUSEXP]->val1;
+	if (sc_data(&sd->sc, SC_CASH_PLUSEXP)) {
+		buff_job_ratio += sc_data(&sd->sc, SC_CASH_PLUSEXP)->val1;
+		buff_ratio += sc_data(&sd->sc, SC_CASH_PLUSEXP)->val1;
 	}
-	if (sd->sc.data[SC_OVERLAPEXPUP]) {
-		buff_job_ratio  += sd->sc.data[SC_OVERLAPEXPUP]->val1;
-		buff_ratio += sd->sc.data[SC_OVERLAPEXPUP]->val1;
+	if (sc_data(&sd->sc, SC_OVERLAPEXPUP)) {
+		buff_job_ratio  += sc_data(&sd->sc, SC_OVERLAPEXPUP)->val1;
+		buff_ratio += sc_data(&sd->sc, SC_OVERLAPEXPUP)->val1;
 	}
-	if (sd->sc.data[SC_CASH_PLUSONLYJOBEXP])
-		buff_job_ratio += sd->sc.data[SC_CASH_PLUSONLYJOBEXP]->val1;
+	if (sc_data(&sd->sc, SC_CASH_PLUSONLYJOBEXP))
+		buff_job_ratio += sc_data(&sd->sc, SC_CASH_PLUSONLYJOBEXP)->val1;
 
 	//Applying Race and PK modifier First then Premium (Perment modifier) and finally buff modifier
 	jexp += apply_percentrate64(jexp, race_ratio, 100);
@@ -7599,7 +7785,7 @@ static int pc_resetskill(struct map_session_data *sd, int flag)
 		if( i&OPTION_CART && pc->checkskill(sd, MC_PUSHCART) )
 			i &= ~OPTION_CART;
 #else
-		if( sd->sc.data[SC_PUSH_CART] )
+		if( sc_data(&sd->sc, SC_PUSH_CART) )
 			pc->setcart(sd, 0);
 #endif
 		if( i != sd->sc.option )
@@ -7608,7 +7794,7 @@ static int pc_resetskill(struct map_session_data *sd, int flag)
 		if( homun_alive(sd->hd) && pc->checkskill(sd, AM_CALLHOMUN) )
 			homun->vaporize(sd, HOM_ST_REST, true);
 
-		if ((sd->sc.data[SC_SPRITEMABLE] && pc->checkskill(sd, SU_SPRITEMABLE)))
+		if ((sc_data(&sd->sc, SC_SPRITEMABLE) && pc->checkskill(sd, SU_SPRITEMABLE)))
 			status_change_end(&sd->bl, SC_SPRITEMABLE, INVALID_TIMER);
 	}
 
@@ -7655,15 +7841,15 @@ static int pc_resetskill(struct map_session_data *sd, int flag)
 
 	if (!(flag&PCRESETSKILL_RECOUNT)) {
 		// Remove all SCs that can't be inactivated without a skill
-		if( sd->sc.data[SC_STORMKICK_READY] )
+		if( sc_data(&sd->sc, SC_STORMKICK_READY) )
 			status_change_end(&sd->bl, SC_STORMKICK_READY, INVALID_TIMER);
-		if( sd->sc.data[SC_DOWNKICK_READY] )
+		if( sc_data(&sd->sc, SC_DOWNKICK_READY) )
 			status_change_end(&sd->bl, SC_DOWNKICK_READY, INVALID_TIMER);
-		if( sd->sc.data[SC_TURNKICK_READY] )
+		if( sc_data(&sd->sc, SC_TURNKICK_READY) )
 			status_change_end(&sd->bl, SC_TURNKICK_READY, INVALID_TIMER);
-		if( sd->sc.data[SC_COUNTERKICK_READY] )
+		if( sc_data(&sd->sc, SC_COUNTERKICK_READY) )
 			status_change_end(&sd->bl, SC_COUNTERKICK_READY, INVALID_TIMER);
-		if( sd->sc.data[SC_DODGE_READY] )
+		if( sc_data(&sd->sc, SC_DODGE_READY) )
 			status_change_end(&sd->bl, SC_DODGE_READY, INVALID_TIMER);
 	}
 
@@ -7738,7 +7924,7 @@ static int pc_skillatk_bonus(struct map_session_data *sd, uint16 skill_id)
 	ARR_FIND(0, ARRAYLENGTH(sd->skillatk), i, sd->skillatk[i].id == skill_id);
 	if( i < ARRAYLENGTH(sd->skillatk) ) bonus = sd->skillatk[i].val;
 
-	if(sd->sc.data[SC_PYROTECHNIC_OPTION] || sd->sc.data[SC_AQUAPLAY_OPTION])
+	if(sc_data(&sd->sc, SC_PYROTECHNIC_OPTION) || sc_data(&sd->sc, SC_AQUAPLAY_OPTION))
 		bonus += 10;
 
 	return bonus;
@@ -8140,8 +8326,8 @@ static int pc_dead(struct map_session_data *sd, struct block_list *src)
 	}
 
 	if (battle_config.death_penalty_type != 0 && pc->isDeathPenaltyJob(sd->job) && !map_flag_gvg2(sd->bl.m)
-	    && map->list[sd->bl.m].flag.noexppenalty == 0 && sd->sc.data[SC_BABY] == NULL
-	    && sd->sc.data[SC_CASH_DEATHPENALTY] == NULL && !pc->auto_exp_insurance(sd)) {
+	    && map->list[sd->bl.m].flag.noexppenalty == 0 && sc_data(&sd->sc, SC_BABY) == NULL
+	    && sc_data(&sd->sc, SC_CASH_DEATHPENALTY) == NULL && !pc->auto_exp_insurance(sd)) {
 		if (battle_config.death_penalty_base > 0) {
 			unsigned int base_penalty = 0;
 			int rate = battle_config.death_penalty_base;
@@ -8719,16 +8905,16 @@ static int pc_itemheal(struct map_session_data *sd, int itemid, int hp, int sp)
 			hp = tmp;
 
 		// Recovery Potion
-		if( sd->sc.data[SC_HEALPLUS] )
-			hp += (int)(hp * sd->sc.data[SC_HEALPLUS]->val1/100.);
+		if( sc_data(&sd->sc, SC_HEALPLUS) )
+			hp += (int)(hp * sc_data(&sd->sc, SC_HEALPLUS)->val1/100.);
 
 		// 2014 Halloween Event : Pumpkin Bonus
-		if ( sd->sc.data[SC_MTF_PUMPKIN] && itemid == ITEMID_PUMPKIN )
-			hp += (int)(hp * sd->sc.data[SC_MTF_PUMPKIN]->val1/100);
+		if ( sc_data(&sd->sc, SC_MTF_PUMPKIN) && itemid == ITEMID_PUMPKIN )
+			hp += (int)(hp * sc_data(&sd->sc, SC_MTF_PUMPKIN)->val1/100);
 
 		// Activation Potion
-		if (sd->sc.data[SC_VITALIZE_POTION] != NULL)
-			hp += hp * sd->sc.data[SC_VITALIZE_POTION]->val3 / 100;
+		if (sc_data(&sd->sc, SC_VITALIZE_POTION) != NULL)
+			hp += hp * sc_data(&sd->sc, SC_VITALIZE_POTION)->val3 / 100;
 	}
 	if(sp) {
 		bonus = 100 + (sd->battle_status.int_<<1)
@@ -8742,34 +8928,34 @@ static int pc_itemheal(struct map_session_data *sd, int itemid, int hp, int sp)
 			sp = tmp;
 	}
 	if( sd->sc.count ) {
-		if ( sd->sc.data[SC_CRITICALWOUND] ) {
-			hp -= hp * sd->sc.data[SC_CRITICALWOUND]->val2 / 100;
-			sp -= sp * sd->sc.data[SC_CRITICALWOUND]->val2 / 100;
+		if ( sc_data(&sd->sc, SC_CRITICALWOUND) ) {
+			hp -= hp * sc_data(&sd->sc, SC_CRITICALWOUND)->val2 / 100;
+			sp -= sp * sc_data(&sd->sc, SC_CRITICALWOUND)->val2 / 100;
 		}
 
-		if( sd->sc.data[SC_VITALITYACTIVATION] ){
+		if( sc_data(&sd->sc, SC_VITALITYACTIVATION) ){
 			hp += hp / 2; // 1.5 times
 			sp -= sp / 2;
 		}
 
-		if ( sd->sc.data[SC_DEATHHURT] ) {
+		if ( sc_data(&sd->sc, SC_DEATHHURT) ) {
 			hp -= hp * 20 / 100;
 			sp -= sp * 20 / 100;
 		}
 
-		if( sd->sc.data[SC_WATER_INSIGNIA] && sd->sc.data[SC_WATER_INSIGNIA]->val1 == 2 ) {
+		if( sc_data(&sd->sc, SC_WATER_INSIGNIA) && sc_data(&sd->sc, SC_WATER_INSIGNIA)->val1 == 2 ) {
 			hp += hp / 10;
 			sp += sp / 10;
 		}
 #ifdef RENEWAL
-		if( sd->sc.data[SC_EXTREMITYFIST2] )
+		if( sc_data(&sd->sc, SC_EXTREMITYFIST2) )
 			sp = 0;
 #endif
-		if (sd->sc.data[SC_BITESCAR]) {
+		if (sc_data(&sd->sc, SC_BITESCAR)) {
 			hp = 0;
 		}
 
-		if (sd->sc.data[SC_NO_RECOVER_STATE]) {
+		if (sc_data(&sd->sc, SC_NO_RECOVER_STATE)) {
 			hp = 0;
 			sp = 0;
 		}
@@ -8886,7 +9072,7 @@ static int pc_jobchange(struct map_session_data *sd, int class, int upper)
 		for (i = 0; i < MAX_SKILL_TREE && (id = pc->skill_tree[class_idx][i].id) > 0; i++) {
 			//Remove status specific to your current tree skills.
 			enum sc_type sc = skill->get_sc_type(id);
-			if (sc > SC_COMMON_MAX && sd->sc.data[sc])
+			if (sc > SC_COMMON_MAX && sc_data(&sd->sc, sc))
 				status_change_end(&sd->bl, sc, INVALID_TIMER);
 		}
 	}
@@ -8973,7 +9159,7 @@ static int pc_jobchange(struct map_session_data *sd, int class, int upper)
 	if( i&OPTION_CART && !pc->checkskill(sd, MC_PUSHCART) )
 		i&=~OPTION_CART;
 #else
-	if( sd->sc.data[SC_PUSH_CART] && !pc->checkskill(sd, MC_PUSHCART) )
+	if( sc_data(&sd->sc, SC_PUSH_CART) && !pc->checkskill(sd, MC_PUSHCART) )
 		pc->setcart(sd, 0);
 #endif
 	if(i != sd->sc.option)
@@ -8982,7 +9168,7 @@ static int pc_jobchange(struct map_session_data *sd, int class, int upper)
 	if(homun_alive(sd->hd) && !pc->checkskill(sd, AM_CALLHOMUN))
 		homun->vaporize(sd, HOM_ST_REST, true);
 
-	if ((sd->sc.data[SC_SPRITEMABLE] && pc->checkskill(sd, SU_SPRITEMABLE)))
+	if ((sc_data(&sd->sc, SC_SPRITEMABLE) && pc->checkskill(sd, SU_SPRITEMABLE)))
 		status_change_end(&sd->bl, SC_SPRITEMABLE, INVALID_TIMER);
 
 	if(sd->status.manner < 0)
@@ -9231,18 +9417,20 @@ static int pc_setoption(struct map_session_data *sd, int type)
 	if( (type&OPTION_MADOGEAR && !(p_type&OPTION_MADOGEAR))
 	|| (!(type&OPTION_MADOGEAR) && p_type&OPTION_MADOGEAR) ) {
 		int i;
+		struct status_change_entry *sce;
 		status_calc_pc(sd, SCO_NONE);
 
 		// End all SCs that can be reset when mado is taken off
-		for( i = 0; i < SC_MAX; i++ ) {
-			if ( !sd->sc.data[i] || !status->get_sc_type(i) )
+		for (i = sc_next(&sd->sc, SC_NONE); i < SC_MAX; i = sc_next(&sd->sc, i)) {
+			if ( !status->get_sc_type(i) )
 				continue;
 			if ( status->get_sc_type(i)&SC_MADO_NO_RESET )
 				continue;
 			switch (i) {
 				case SC_BERSERK:
 				case SC_SATURDAY_NIGHT_FEVER:
-					sd->sc.data[i]->val2 = 0;
+					if ((sce = sc_data(&sd->sc, i)) != NULL)
+						sce->val2 = 0;
 					break;
 			}
 			status_change_end(&sd->bl, (sc_type)i, INVALID_TIMER);
@@ -9299,7 +9487,7 @@ static int pc_setcart(struct map_session_data *sd, int type)
 
 	switch( type ) {
 		case 0:
-			if( !sd->sc.data[SC_PUSH_CART] )
+			if( !sc_data(&sd->sc, SC_PUSH_CART) )
 				return 0;
 			status_change_end(&sd->bl,SC_PUSH_CART,INVALID_TIMER);
 			clif->clearcart(sd->fd);
@@ -9308,13 +9496,13 @@ static int pc_setcart(struct map_session_data *sd, int type)
 				pc->unequipitem(sd, sd->equip_index[EQI_AMMO], PCUNEQUIPITEM_FORCE);
 			break;
 		default:/* everything else is an allowed ID so we can move on */
-			if( !sd->sc.data[SC_PUSH_CART] ) /* first time, so fill cart data */
+			if( !sc_data(&sd->sc, SC_PUSH_CART) ) /* first time, so fill cart data */
 				clif->cartList(sd);
 			clif->updatestatus(sd, SP_CARTINFO);
 		        sc_start(NULL, &sd->bl, SC_PUSH_CART, 100, type, 0, MC_PUSHCART);
 			clif->sc_load(&sd->bl, sd->bl.id, AREA, status->get_sc_icon(SC_ON_PUSH_CART), type, 0, 0);
-			if( sd->sc.data[SC_PUSH_CART] )/* forcefully update */
-				sd->sc.data[SC_PUSH_CART]->val1 = type;
+			if( sc_data(&sd->sc, SC_PUSH_CART) )/* forcefully update */
+				sc_data(&sd->sc, SC_PUSH_CART)->val1 = type;
 			break;
 	}
 
@@ -9463,18 +9651,18 @@ static bool pc_can_attack(struct map_session_data *sd, int target_id)
 {
 	nullpo_retr(false, sd);
 
-	if( sd->sc.data[SC_BASILICA] ||
-		sd->sc.data[SC__SHADOWFORM] ||
-		sd->sc.data[SC__MANHOLE] ||
-		sd->sc.data[SC_CURSEDCIRCLE_ATKER] ||
-		sd->sc.data[SC_CURSEDCIRCLE_TARGET] ||
-		sd->sc.data[SC_COLD] ||
-		sd->sc.data[SC_ALL_RIDING] || // The client doesn't let you, this is to make cheat-safe
-		sd->sc.data[SC_TRICKDEAD] ||
-		(sd->sc.data[SC_SIREN] && sd->sc.data[SC_SIREN]->val2 == target_id) ||
-		sd->sc.data[SC_BLADESTOP] ||
-		sd->sc.data[SC_DEEP_SLEEP] ||
-		sd->sc.data[SC_FALLENEMPIRE] ||
+	if( sc_data(&sd->sc, SC_BASILICA) ||
+		sc_data(&sd->sc, SC__SHADOWFORM) ||
+		sc_data(&sd->sc, SC__MANHOLE) ||
+		sc_data(&sd->sc, SC_CURSEDCIRCLE_ATKER) ||
+		sc_data(&sd->sc, SC_CURSEDCIRCLE_TARGET) ||
+		sc_data(&sd->sc, SC_COLD) ||
+		sc_data(&sd->sc, SC_ALL_RIDING) || // The client doesn't let you, this is to make cheat-safe
+		sc_data(&sd->sc, SC_TRICKDEAD) ||
+		(sc_data(&sd->sc, SC_SIREN) && sc_data(&sd->sc, SC_SIREN)->val2 == target_id) ||
+		sc_data(&sd->sc, SC_BLADESTOP) ||
+		sc_data(&sd->sc, SC_DEEP_SLEEP) ||
+		sc_data(&sd->sc, SC_FALLENEMPIRE) ||
 		sd->block_action.attack)
 			return false;
 
@@ -9490,8 +9678,8 @@ static bool pc_can_talk(struct map_session_data *sd)
 {
 	nullpo_retr(false, sd);
 
-	if( sd->sc.data[SC_BERSERK] ||
-		(sd->sc.data[SC_DEEP_SLEEP] && sd->sc.data[SC_DEEP_SLEEP]->val2) ||
+	if( sc_data(&sd->sc, SC_BERSERK) ||
+		(sc_data(&sd->sc, SC_DEEP_SLEEP) && sc_data(&sd->sc, SC_DEEP_SLEEP)->val2) ||
 		pc_ismuted(&sd->sc, MANNER_NOCHAT) ||
 		sd->block_action.chat)
 		return false;
@@ -10171,7 +10359,7 @@ static int pc_equipitem(struct map_session_data *sd, int n, int req_pos)
 	}
 
 	// If the character is in berserk mode, the item can't be equipped.
-	if (sd->sc.count != 0 && (sd->sc.data[SC_BERSERK] != NULL || sd->sc.data[SC_NO_SWITCH_EQUIP] != NULL)) {
+	if (sd->sc.count != 0 && (sc_data(&sd->sc, SC_BERSERK) != NULL || sc_data(&sd->sc, SC_NO_SWITCH_EQUIP) != NULL)) {
 		clif->equipitemack(sd, n, 0, EIA_FAIL);
 		return 0;
 	}
@@ -10403,13 +10591,13 @@ static int pc_unequipitem(struct map_session_data *sd, int n, int flag)
 	}
 
 	// If the character is in berserk mode, the item can't be unequipped.
-	if (sd->sc.count != 0 && (sd->sc.data[SC_BERSERK] != NULL || sd->sc.data[SC_NO_SWITCH_EQUIP] != NULL)
+	if (sd->sc.count != 0 && (sc_data(&sd->sc, SC_BERSERK) != NULL || sc_data(&sd->sc, SC_NO_SWITCH_EQUIP) != NULL)
 	    && (flag & PCUNEQUIPITEM_FORCE) == 0) {
 		clif->unequipitemack(sd, n, 0, UIA_FAIL);
 		return 0;
 	}
 
-	if ((flag & PCUNEQUIPITEM_FORCE) == 0 && sd->sc.count != 0 && sd->sc.data[SC_KYOUGAKU] != NULL) {
+	if ((flag & PCUNEQUIPITEM_FORCE) == 0 && sd->sc.count != 0 && sc_data(&sd->sc, SC_KYOUGAKU) != NULL) {
 		clif->unequipitemack(sd, n, 0, UIA_FAIL);
 		return 0;
 	}
@@ -10434,7 +10622,7 @@ static int pc_unequipitem(struct map_session_data *sd, int n, int flag)
 
 	status_change_end(&sd->bl, SC_HEAT_BARREL, INVALID_TIMER);
 	if ((pos & EQP_ARMS) != 0 && sd->weapontype1 == W_FIST && sd->weapontype2 == W_FIST
-	    && (sd->sc.data[SC_TK_SEVENWIND] == NULL || sd->sc.data[SC_ASPERSIO] != NULL)) { // Check for Seven Wind. (But not level seven!)
+	    && (sc_data(&sd->sc, SC_TK_SEVENWIND) == NULL || sc_data(&sd->sc, SC_ASPERSIO) != NULL)) { // Check for Seven Wind. (But not level seven!)
 		skill->enchant_elemental_end(&sd->bl, -1);
 	}
 
@@ -10495,7 +10683,7 @@ static int pc_unequipitem(struct map_session_data *sd, int n, int flag)
 		status_calc_pc(sd, SCO_NONE);
 	}
 
-	if (sd->sc.data[SC_CRUCIS] != NULL && !battle->check_undead(sd->battle_status.race, sd->battle_status.def_ele))
+	if (sc_data(&sd->sc, SC_CRUCIS) != NULL && !battle->check_undead(sd->battle_status.race, sd->battle_status.def_ele))
 		status_change_end(&sd->bl, SC_CRUCIS, INVALID_TIMER);
 
 	// Execute unequip script. [Skotlex]
@@ -10591,6 +10779,8 @@ static int pc_checkitem(struct map_session_data *sd)
 			sd->itemcheck &= ~PCCHECKITEM_CART;
 		}
 
+		/* The account storage is only loaded on first use: until then the flag is kept set,
+		 * and the check runs once the last storage page arrives (intif_parse_account_storage). */
 		if (sd->itemcheck & PCCHECKITEM_STORAGE && sd->storage.received == true) {
 			for (i = 0; i < VECTOR_LENGTH(sd->storage.item); i++) {
 				struct item *it = &VECTOR_INDEX(sd->storage.item, i);
@@ -10604,8 +10794,11 @@ static int pc_checkitem(struct map_session_data *sd)
 					continue;
 				}
 
-				if (it->unique_id == 0 && itemdb->isstackable(id) == 0)
+				if (it->unique_id == 0 && itemdb->isstackable(id) == 0) {
 					it->unique_id = itemdb->unique_id(sd);
+					storage->mark_changed(&sd->storage.changes, i);
+					sd->storage.save = true;
+				}
 			}
 
 			storage->close(sd);
@@ -11075,12 +11268,12 @@ static void pc_overheat(struct map_session_data *sd, int val)
 		limit[] = { 10, 20, 28, 46, 66 };
 
 	nullpo_retv(sd);
-	if( !pc_ismadogear(sd) || sd->sc.data[SC_OVERHEAT] )
+	if( !pc_ismadogear(sd) || sc_data(&sd->sc, SC_OVERHEAT) )
 		return; // already burning
 
 	skill_lv = cap_value(pc->checkskill(sd,NC_MAINFRAME),0,4);
-	if( sd->sc.data[SC_OVERHEAT_LIMITPOINT] ) {
-		heat += sd->sc.data[SC_OVERHEAT_LIMITPOINT]->val1;
+	if( sc_data(&sd->sc, SC_OVERHEAT_LIMITPOINT) ) {
+		heat += sc_data(&sd->sc, SC_OVERHEAT_LIMITPOINT)->val1;
 		status_change_end(&sd->bl,SC_OVERHEAT_LIMITPOINT,INVALID_TIMER);
 	}
 
@@ -12000,8 +12193,8 @@ static void pc_scdata_received(struct map_session_data *sd)
 	}
 
 
-	if (sd->sc.data[SC_SOULENERGY] != NULL)
-		sd->soulball = sd->sc.data[SC_SOULENERGY]->val1;
+	if (sc_data(&sd->sc, SC_SOULENERGY) != NULL)
+		sd->soulball = sc_data(&sd->sc, SC_SOULENERGY)->val1;
 
 	sd->state.scloaded = 1;
 	if (sd->state.standalone) {
@@ -12140,6 +12333,7 @@ static void pc_autotrade_start(struct map_session_data *sd)
 		sd->vend_num = count;
 		sd->state.vending = true;
 		idb_put(vending->db, sd->status.char_id, sd);
+		vending->index_add(sd);
 		if( map->list[sd->bl.m].users )
 			clif->showvendingboard(&sd->bl,sd->message,0);
 	}
@@ -12844,6 +13038,13 @@ void pc_defaults(void)
 	pc->checkadditem = pc_checkadditem;
 	pc->inventoryblank = pc_inventoryblank;
 	pc->search_inventory = pc_search_inventory;
+	pc->inventory_index_build = pc_inventory_index_build;
+	pc->inventory_index_add = pc_inventory_index_add;
+	pc->inventory_index_remove = pc_inventory_index_remove;
+	pc->inventory_first = pc_inventory_first;
+	pc->inventory_next = pc_inventory_next;
+	pc->inventory_free_slot = pc_inventory_free_slot;
+	pc->inventory_count = pc_inventory_count;
 	pc->payzeny = pc_payzeny;
 	pc->additem = pc_additem;
 	pc->getzeny = pc_getzeny;
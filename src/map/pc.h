@@ -194,6 +194,38 @@ struct autocast_data {
 	bool itemskill_instant_cast; // Used by itemskill() script command, to cast skill instantaneously.
 	bool itemskill_cast_on_self; // Used by itemskill() script command, to forcefully cast skill on invoking character.
 };
+/// Amount of buckets of the per-session packet rate histogram.
+#define PACKET_RATE_BUCKETS 10
+
+/** Client packet rate of a session. **/
+struct s_packet_rate {
+	int64 window_tick; ///< Start of the current one second window.
+	int window_count;  ///< Packets received in the current window.
+	int peak;          ///< Highest amount of packets received in one window.
+	uint64 count;      ///< Packets received.
+	uint64 bytes;      ///< Bytes received.
+	/// Seconds spent at each rate: bucket N counts windows with 2^N to 2^(N+1)-1 packets, the last bucket everything above.
+	unsigned int histogram[PACKET_RATE_BUCKETS];
+};
+
+/// Amount of item ID buckets of the inventory index (power of 2).
+#define INVENTORY_INDEX_BUCKETS 64
+/// Amount of 32 bit words of the free inventory slots bitmap.
+#define INVENTORY_FREE_WORDS ((MAX_INVENTORY + 31) / 32)
+
+/**
+ * Index of the inventory of a player.
+ *
+ * Slots holding an item are chained by item ID bucket, in ascending slot
+ * order, so that lookups return the same slot as a linear search would.
+ * Maintained by pc->additem and pc->delitem, rebuilt by pc->setinventorydata.
+ */
+struct s_inventory_index {
+	int16 head[INVENTORY_INDEX_BUCKETS]; ///< First slot of each bucket (INDEX_NOT_FOUND if empty).
+	int16 next[MAX_INVENTORY];           ///< Next slot of the same bucket (INDEX_NOT_FOUND if last).
+	uint32 free[INVENTORY_FREE_WORDS];   ///< Bitmap of the empty slots.
+};
+
 struct map_session_data {
 	struct block_list bl;
 	struct unit_data ud;
@@ -269,6 +301,8 @@ struct map_session_data {
 		unsigned int grade_ui : 1;
 		unsigned int reform_ui : 1;
 		unsigned int enchant_ui : 1;
+		unsigned int party_xy_dirty : 1; ///< Queued in party->xy_dirty.
+		unsigned int guild_xy_dirty : 1; ///< Queued in guild->xy_dirty.
 	} state;
 	struct {
 		unsigned char no_weapon_damage, no_magic_damage, no_misc_damage;
@@ -292,6 +326,7 @@ struct map_session_data {
 
 	struct mmo_charstatus status;
 	struct item_data *inventory_data[MAX_INVENTORY]; // direct pointers to itemdb entries (faster than doing item_id lookups)
+	struct s_inventory_index inventory_index; ///< Item ID to inventory slots index.
 	struct storage_data storage; ///< Account Storage
 	enum pc_checkitem_types itemcheck;
 	short equip_index[EQI_MAX];
@@ -695,6 +730,8 @@ END_ZEROED_BLOCK;
 	VECTOR_DECL(int) agency_requests;
 
 	int last_added_quest_id; ///< Most recent quest id added to quest log in this play session
+
+	struct s_packet_rate packet_rate; ///< Client packet rate, when battle_config.packet_stats is enabled.
 };
 
 #define EQP_WEAPON EQP_HAND_R
@@ -736,11 +773,11 @@ END_ZEROED_BLOCK;
 #define pc_ishiding(sd)       ( (sd)->sc.option&(OPTION_HIDE|OPTION_CLOAK|OPTION_CHASEWALK) )
 #define pc_iscloaking(sd)     ( !((sd)->sc.option&OPTION_CHASEWALK) && ((sd)->sc.option&OPTION_CLOAK) )
 #define pc_ischasewalk(sd)    ( (sd)->sc.option&OPTION_CHASEWALK )
-#define pc_ismuted(sc, type)  ( (sc)->data[SC_NOCHAT] != NULL && (battle_config.manner_system & (type)) != 0 )
+#define pc_ismuted(sc, type)  ( sc_data((sc), SC_NOCHAT) != NULL && (battle_config.manner_system & (type)) != 0 )
 #define pc_isvending(sd)      ((sd)->state.vending || (sd)->state.prevend || (sd)->state.buyingstore)
 
 #ifdef NEW_CARTS
-	#define pc_iscarton(sd)       ( (sd)->sc.data[SC_PUSH_CART] )
+	#define pc_iscarton(sd)       ( sc_data(&(sd)->sc, SC_PUSH_CART) )
 #else
 	#define pc_iscarton(sd)       ( (sd)->sc.option&OPTION_CART )
 #endif
@@ -801,13 +838,13 @@ END_ZEROED_BLOCK;
 	#define pc_leftside_mdef(sd) ((sd)->battle_status.mdef)
 	#define pc_rightside_mdef(sd) ( (sd)->battle_status.mdef2 - ((sd)->battle_status.vit>>1) )
 #define pc_leftside_matk(sd) (\
-	((sd)->sc.data[SC_MAGICPOWER] && (sd)->sc.data[SC_MAGICPOWER]->val4) \
-		?((sd)->battle_status.matk_min * 100 + 50) / ((sd)->sc.data[SC_MAGICPOWER]->val3+100) \
+	(sc_data(&(sd)->sc, SC_MAGICPOWER) && sc_data(&(sd)->sc, SC_MAGICPOWER)->val4) \
+		?((sd)->battle_status.matk_min * 100 + 50) / (sc_data(&(sd)->sc, SC_MAGICPOWER)->val3+100) \
 		:(sd)->battle_status.matk_min \
 )
 #define pc_rightside_matk(sd) (\
-	((sd)->sc.data[SC_MAGICPOWER] && (sd)->sc.data[SC_MAGICPOWER]->val4) \
-		?((sd)->battle_status.matk_max * 100 + 50) / ((sd)->sc.data[SC_MAGICPOWER]->val3+100) \
+	(sc_data(&(sd)->sc, SC_MAGICPOWER) && sc_data(&(sd)->sc, SC_MAGICPOWER)->val4) \
+		?((sd)->battle_status.matk_max * 100 + 50) / (sc_data(&(sd)->sc, SC_MAGICPOWER)->val3+100) \
 		:(sd)->battle_status.matk_max \
 )
 #endif
@@ -1010,6 +1047,13 @@ END_ZEROED_BLOCK; /* End */
 	int (*checkadditem) (struct map_session_data *sd,int nameid,int amount);
 	int (*inventoryblank) (struct map_session_data *sd);
 	int (*search_inventory) (struct map_session_data *sd,int item_id);
+	void (*inventory_index_build) (struct map_session_data *sd);
+	void (*inventory_index_add) (struct map_session_data *sd, int n);
+	void (*inventory_index_remove) (struct map_session_data *sd, int n);
+	int (*inventory_first) (struct map_session_data *sd, int nameid);
+	int (*inventory_next) (struct map_session_data *sd, int n);
+	int (*inventory_free_slot) (struct map_session_data *sd);
+	int (*inventory_count) (struct map_session_data *sd, int nameid);
 	int (*payzeny) (struct map_session_data *sd,int zeny, enum e_log_pick_type type, struct map_session_data *tsd);
 	int (*additem) (struct map_session_data *sd, const struct item *item_data, int amount, e_log_pick_type log_type);
 	int (*getzeny) (struct map_session_data *sd,int zeny, enum e_log_pick_type type, struct map_session_data *tsd);
@@ -1391,7 +1391,7 @@ static int pet_recovery_timer(int tid, int64 tick, int id, intptr_t data)
 		return 0;
 	}
 
-	if (sd->sc.data[pd->recovery->type]) {
+	if (sc_data(&sd->sc, pd->recovery->type)) {
 		//Display a heal animation?
 		//Detoxify is chosen for now.
 		clif->skill_nodamage(&pd->bl,&sd->bl,TF_DETOXIFY,1,1);
@@ -64,10 +64,10 @@ static void rodex_refresh_stamps(struct map_session_data *sd)
 
 	// Note : Weirdly, iRO starts this with maximum messages of the day and decrements
 	//        but our clients starts this at 0 and increments
-	if (sd->sc.data[SC_DAILYSENDMAILCNT] == NULL) {
+	if (sc_data(&sd->sc, SC_DAILYSENDMAILCNT) == NULL) {
 		sc_start2(NULL, &sd->bl, SC_DAILYSENDMAILCNT, 100, today, 0, INFINITE_DURATION, 0);
 	} else {
-		int sc_date = sd->sc.data[SC_DAILYSENDMAILCNT]->val1;
+		int sc_date = sc_data(&sd->sc, SC_DAILYSENDMAILCNT)->val1;
 		if (sc_date != today) {
 			sc_start2(NULL, &sd->bl, SC_DAILYSENDMAILCNT, 100, today, 0, INFINITE_DURATION, 0);
 		}
@@ -263,13 +263,13 @@ static int rodex_send_mail(struct map_session_data *sd, const char *receiver_nam
 
 	rodex_refresh_stamps(sd);
 
-	if (sd->sc.data[SC_DAILYSENDMAILCNT] != NULL) {
-		if (sd->sc.data[SC_DAILYSENDMAILCNT]->val2 >= DAILY_MAX_MAILS) {
+	if (sc_data(&sd->sc, SC_DAILYSENDMAILCNT) != NULL) {
+		if (sc_data(&sd->sc, SC_DAILYSENDMAILCNT)->val2 >= DAILY_MAX_MAILS) {
 			rodex->clean(sd, 1);
 			return RODEX_SEND_MAIL_COUNT_ERROR;
 		}
 
-		sc_start2(NULL, &sd->bl, SC_DAILYSENDMAILCNT, 100, sd->sc.data[SC_DAILYSENDMAILCNT]->val1, sd->sc.data[SC_DAILYSENDMAILCNT]->val2 + 1, INFINITE_DURATION, 0);
+		sc_start2(NULL, &sd->bl, SC_DAILYSENDMAILCNT, 100, sc_data(&sd->sc, SC_DAILYSENDMAILCNT)->val1, sc_data(&sd->sc, SC_DAILYSENDMAILCNT)->val2 + 1, INFINITE_DURATION, 0);
 	} else {
 		sc_start2(NULL, &sd->bl, SC_DAILYSENDMAILCNT, 100, date_get_date(), 1, INFINITE_DURATION, 0);
 	}
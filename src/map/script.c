@@ -69,6 +69,7 @@
 #include "common/mmo.h" // NEW_CARTS
 #include "common/msgtable.h"
 #include "common/nullpo.h"
+#include "common/profiler.h"
 #include "common/random.h"
 #include "common/showmsg.h"
 #include "common/socket.h" // usage: getcharip
@@ -4067,11 +4068,20 @@ static int conv_num(struct script_state *st, struct script_data *data)
 static void stack_expand(struct script_stack *stack)
 {
 	nullpo_retv(stack);
-	stack->sp_max += 64;
-	stack->stack_data = (struct script_data*)aRealloc(stack->stack_data,
-			stack->sp_max * sizeof(stack->stack_data[0]) );
-	memset(stack->stack_data + (stack->sp_max - 64), 0,
-			64 * sizeof(stack->stack_data[0]) );
+	if (stack->sp_max == SCRIPT_STACK_CHUNK) {
+		// Outgrows the pooled buffer, move to the heap
+		struct script_data *stack_data = aMalloc(2 * sizeof(struct script_stack_chunk));
+		memcpy(stack_data, stack->stack_data, sizeof(struct script_stack_chunk));
+		ers_free(script->stack_data_ers, stack->stack_data);
+		stack->stack_data = stack_data;
+		stack->sp_max += SCRIPT_STACK_CHUNK;
+	} else {
+		stack->sp_max += SCRIPT_STACK_CHUNK;
+		stack->stack_data = (struct script_data*)aRealloc(stack->stack_data,
+				stack->sp_max * sizeof(stack->stack_data[0]) );
+	}
+	memset(stack->stack_data + (stack->sp_max - SCRIPT_STACK_CHUNK), 0,
+			SCRIPT_STACK_CHUNK * sizeof(stack->stack_data[0]) );
 }
 
 /// Pushes a value into the stack (with reference)
@@ -4266,8 +4276,9 @@ static struct script_state *script_alloc_state(struct script_code *rootscript, i
 	st->pending_refs = NULL;
 	st->pending_ref_count = 0;
 	st->stack->sp = 0;
-	st->stack->sp_max = 64;
-	CREATE(st->stack->stack_data, struct script_data, st->stack->sp_max);
+	st->stack->sp_max = SCRIPT_STACK_CHUNK;
+	st->stack->stack_data = ers_alloc(script->stack_data_ers, struct script_stack_chunk)->data;
+	memset(st->stack->stack_data, 0, sizeof(struct script_stack_chunk));
 	st->stack->defsp = st->stack->sp;
 	st->stack->scope.vars = i64db_alloc(DB_OPT_RELEASE_DATA);
 	st->stack->scope.arrays = NULL;
@@ -4326,7 +4337,10 @@ static void script_free_state(struct script_state *st)
 			if( st->stack->scope.arrays )
 				st->stack->scope.arrays->destroy(st->stack->scope.arrays,script->array_free_db);
 			script->pop_stack(st, 0, st->stack->sp);
-			aFree(st->stack->stack_data);
+			if (st->stack->sp_max == SCRIPT_STACK_CHUNK)
+				ers_free(script->stack_data_ers, st->stack->stack_data);
+			else
+				aFree(st->stack->stack_data);
 			ers_free(script->stack_ers, st->stack);
 			st->stack = NULL;
 		}
@@ -4884,8 +4898,17 @@ static int run_func(struct script_state *st)
 	}
 
 	if(script->str_data[func].func) {
+		uint64 prof = profiler->begin();
+
 		if (!(script->str_data[func].func(st))) //Report error
 			script->reportsrc(st);
+
+		if (prof != 0) {
+			int zone = profiler->find(PROFILER_SCRIPT, func);
+			if (zone < 0)
+				zone = profiler->add(PROFILER_SCRIPT, func, script->get_str(func));
+			profiler->end(zone, prof);
+		}
 	} else {
 		ShowError("script:run_func: '%s' (id=%d type=%s) has no C function. please report this!!!\n",
 		          script->get_str(func), func, script->op2name(script->str_data[func].type));
@@ -5622,6 +5645,7 @@ static void do_final_script(void)
 
 	ers_destroy(script->st_ers);
 	ers_destroy(script->stack_ers);
+	ers_destroy(script->stack_data_ers);
 
 	db_destroy(script->st_db);
 
@@ -6141,8 +6165,11 @@ static void do_init_script(bool minimal)
 	script->stack_ers = ers_new(sizeof(struct script_stack), "script.c::script_stack", ERS_OPT_NONE|ERS_OPT_FLEX_CHUNK);
 	script->array_ers = ers_new(sizeof(struct script_array), "script.c::array_ers", ERS_OPT_CLEAN|ERS_OPT_CLEAR);
 
+	script->stack_data_ers = ers_new(sizeof(struct script_stack_chunk), "script.c::stack_data_ers", ERS_OPT_NONE|ERS_OPT_FLEX_CHUNK);
+
 	ers_chunk_size(script->st_ers, 10);
 	ers_chunk_size(script->stack_ers, 10);
+	ers_chunk_size(script->stack_data_ers, 10);
 
 	VECTOR_INIT(script->hq);
 	VECTOR_INIT(script->hqi);
@@ -7809,13 +7836,13 @@ static BUILDIN(percentheal)
 	if (sd == NULL)
 		return true;
 #ifdef RENEWAL
-	if( sd->sc.data[SC_EXTREMITYFIST2] )
+	if( sc_data(&sd->sc, SC_EXTREMITYFIST2) )
 		sp = 0;
 #endif
-	if (sd->sc.data[SC_BITESCAR]) {
+	if (sc_data(&sd->sc, SC_BITESCAR)) {
 		hp = 0;
 	}
-	if (sd->sc.data[SC_NO_RECOVER_STATE]) {
+	if (sc_data(&sd->sc, SC_NO_RECOVER_STATE)) {
 		hp = 0;
 		sp = 0;
 	}
@@ -8487,12 +8514,7 @@ static BUILDIN(countitem)
 		return false;
 	}
 
-	int nameid = id->nameid;
-
-	for (int i = 0; i < sd->status.inventorySize; i++) {
-		if (sd->status.inventory[i].nameid == nameid)
-			count += sd->status.inventory[i].amount;
-	}
+	count = pc->inventory_count(sd, id->nameid);
 
 	script_pushint(st,count);
 	return true;
@@ -8535,9 +8557,8 @@ static BUILDIN(countitem2)
 	c3 = script_getnum(st,8);
 	c4 = script_getnum(st,9);
 
-	for (int i = 0; i < sd->status.inventorySize; i++)
-		if (sd->status.inventory[i].nameid > 0 && sd->inventory_data[i] != NULL &&
-			sd->status.inventory[i].amount > 0 && sd->status.inventory[i].nameid == nameid &&
+	for (int i = pc->inventory_first(sd, nameid); i != INDEX_NOT_FOUND && i < sd->status.inventorySize; i = pc->inventory_next(sd, i))
+		if (sd->inventory_data[i] != NULL && sd->status.inventory[i].amount > 0 &&
 			sd->status.inventory[i].identify == iden && sd->status.inventory[i].refine == ref &&
 			sd->status.inventory[i].attribute == attr && sd->status.inventory[i].card[0] == c1 &&
 			sd->status.inventory[i].card[1] == c2 && sd->status.inventory[i].card[2] == c3 &&
@@ -9412,7 +9433,7 @@ static void buildin_delitem_delete(struct map_session_data *sd, int idx, int *am
 static bool buildin_delitem_search(struct map_session_data *sd, struct item *it, bool exact_match)
 {
 	bool delete_items = false;
-	int i, amount;
+	int i, next, amount;
 	struct item* inv;
 
 	nullpo_retr(false, sd);
@@ -9433,8 +9454,10 @@ static bool buildin_delitem_search(struct map_session_data *sd, struct item *it,
 		amount = it->amount;
 
 		// 1st pass -- less important items / exact match
-		for (i = 0; amount && i < ARRAYLENGTH(sd->status.inventory); i++) {
+		// the next slot is looked up first, as the current one may be emptied
+		for (i = pc->inventory_first(sd, it->nameid); amount && i != INDEX_NOT_FOUND; i = next) {
 			inv = &sd->status.inventory[i];
+			next = pc->inventory_next(sd, i);
 
 			if (!inv->nameid || !sd->inventory_data[i] || inv->nameid != it->nameid) {
 				// wrong/invalid item
@@ -9474,8 +9497,9 @@ static bool buildin_delitem_search(struct map_session_data *sd, struct item *it,
 			// either everything was already consumed or no items were skipped
 			;
 		} else {
-			for (i = 0; amount && i < ARRAYLENGTH(sd->status.inventory); i++) {
+			for (i = pc->inventory_first(sd, it->nameid); amount && i != INDEX_NOT_FOUND; i = next) {
 				inv = &sd->status.inventory[i];
+				next = pc->inventory_next(sd, i);
 
 				if (!inv->nameid || !sd->inventory_data[i] || inv->nameid != it->nameid) {
 					// wrong/invalid item
@@ -11934,12 +11958,6 @@ static BUILDIN(openstorage)
 	if (sd == NULL)
 		return false;
 
-	if (sd->storage.received == false) {
-		script_pushint(st, 0);
-		ShowWarning("buildin_openstorage: Storage data for AID %d has not been loaded.\n", sd->bl.id);
-		return false;
-	}
-
 	// Mapflag preventing from openstorage here
 	if (!pc_has_permission(sd, PC_PERM_BYPASS_NOSTORAGE) && (map->list[sd->bl.m].flag.nostorage & 2)) {
 		script_pushint(st, 0);
@@ -13710,7 +13728,7 @@ static BUILDIN(sc_end)
 
 	if (type >= 0 && type < SC_MAX) {
 		struct status_change *sc = status->get_sc(bl);
-		struct status_change_entry *sce = sc ? sc->data[type] : NULL;
+		struct status_change_entry *sce = sc ? sc_data(sc, type) : NULL;
 
 		if (!sce)
 			return true;
@@ -13782,22 +13800,22 @@ static BUILDIN(getstatus)
 		return true;
 	}
 
-	if( sd->sc.count == 0 || !sd->sc.data[id] )
+	if( sd->sc.count == 0 || !sc_data(&sd->sc, id) )
 	{// no status is active
 		script_pushint(st, 0);
 		return true;
 	}
 
 	switch( type ) {
-		case 1: script_pushint(st, sd->sc.data[id]->val1); break;
-		case 2: script_pushint(st, sd->sc.data[id]->val2); break;
-		case 3: script_pushint(st, sd->sc.data[id]->val3); break;
-		case 4: script_pushint(st, sd->sc.data[id]->val4); break;
+		case 1: script_pushint(st, sc_data(&sd->sc, id)->val1); break;
+		case 2: script_pushint(st, sc_data(&sd->sc, id)->val2); break;
+		case 3: script_pushint(st, sc_data(&sd->sc, id)->val3); break;
+		case 4: script_pushint(st, sc_data(&sd->sc, id)->val4); break;
 		case 5:
-			if (sd->sc.data[id]->infinite_duration) {
+			if (sc_data(&sd->sc, id)->infinite_duration) {
 				script_pushint(st, INFINITE_DURATION);
 			} else {
-				const struct TimerData *td = timer->get(sd->sc.data[id]->timer);
+				const struct TimerData *td = timer->get(sc_data(&sd->sc, id)->timer);
 
 				if (td != NULL) {
 					// return the amount of time remaining
@@ -16467,6 +16485,7 @@ static BUILDIN(setiteminfo)
 		script_pushint(st,-1);
 		return false;
 	}
+	itemdb->hot_update(it);
 	script_pushint(st,value);
 	return true;
 }
@@ -24919,7 +24938,7 @@ static BUILDIN(hascashmount)
 	if (sd == NULL)
 		return true;
 
-	if (sd->sc.data[SC_ALL_RIDING]) {
+	if (sc_data(&sd->sc, SC_ALL_RIDING)) {
 		script_pushint(st, 1);
 	} else {
 		script_pushint(st, 0);
@@ -24948,7 +24967,7 @@ static BUILDIN(setcashmount)
 #endif
 		script_pushint(st, 0); // Can't mount with one of these
 	} else {
-		if (sd->sc.data[SC_ALL_RIDING]) {
+		if (sc_data(&sd->sc, SC_ALL_RIDING)) {
 			status_change_end(&sd->bl, SC_ALL_RIDING, INVALID_TIMER);
 		} else {
 			sc_start(NULL, &sd->bl, SC_ALL_RIDING, 100, battle_config.boarding_halter_speed, INFINITE_DURATION, 0);
@@ -30479,6 +30498,7 @@ void script_defaults(void)
 	script->next_id = 0;
 	script->st_ers = NULL;
 	script->stack_ers = NULL;
+	script->stack_data_ers = NULL;
 	script->array_ers = NULL;
 
 	script->buildin = NULL;
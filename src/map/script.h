@@ -696,6 +696,15 @@ struct script_code {
 	unsigned short instances;
 };
 
+/// Initial capacity of a script stack, and the amount of entries it grows by.
+/// Stacks of this size are pooled (script->stack_data_ers).
+#define SCRIPT_STACK_CHUNK 64
+
+/// A pooled stack buffer, see SCRIPT_STACK_CHUNK.
+struct script_stack_chunk {
+	struct script_data data[SCRIPT_STACK_CHUNK];
+};
+
 struct script_stack {
 	int sp;                         ///< number of entries in the stack
 	int sp_max;                     ///< capacity of the stack
@@ -839,6 +848,7 @@ struct script_interface {
 	unsigned int next_id;
 	struct eri *st_ers;
 	struct eri *stack_ers;
+	struct eri *stack_data_ers; ///< Pool of initial stack buffers (SCRIPT_STACK_CHUNK entries).
 	/* */
 	VECTOR_DECL(struct script_queue) hq;
 	VECTOR_DECL(struct script_queue_iterator) hqi;
@@ -1207,25 +1207,25 @@ static int skill_calc_heal(struct block_list *src, struct block_list *target, ui
 		hp += hp*skill2_lv/100;
 
 	sc = status->get_sc(src);
-	if( sc && sc->count && sc->data[SC_OFFERTORIUM] ) {
+	if( sc && sc->count && sc_data(sc, SC_OFFERTORIUM) ) {
 		if( skill_id == AB_HIGHNESSHEAL || skill_id == AB_CHEAL || skill_id == PR_SANCTUARY || skill_id == AL_HEAL )
-			hp += hp * sc->data[SC_OFFERTORIUM]->val2 / 100;
+			hp += hp * sc_data(sc, SC_OFFERTORIUM)->val2 / 100;
 	}
 	sc = status->get_sc(target);
 	if (sc && sc->count) {
-		if(sc->data[SC_CRITICALWOUND] && heal) // Critical Wound has no effect on offensive heal. [Inkfish]
-			hp -= hp * sc->data[SC_CRITICALWOUND]->val2/100;
-		if(sc->data[SC_DEATHHURT] && heal)
+		if(sc_data(sc, SC_CRITICALWOUND) && heal) // Critical Wound has no effect on offensive heal. [Inkfish]
+			hp -= hp * sc_data(sc, SC_CRITICALWOUND)->val2/100;
+		if(sc_data(sc, SC_DEATHHURT) && heal)
 			hp -= hp * 20/100;
-		if(sc->data[SC_HEALPLUS] && skill_id != NPC_EVILLAND && skill_id != BA_APPLEIDUN)
-			hp += hp * sc->data[SC_HEALPLUS]->val1/100; // Only affects Heal, Sanctuary and PotionPitcher.(like bHealPower) [Inkfish]
-		if (sc->data[SC_VITALIZE_POTION] != NULL && skill_id != NPC_EVILLAND && skill_id != BA_APPLEIDUN)
-			hp += hp * sc->data[SC_VITALIZE_POTION]->val3 / 100;
-		if(sc->data[SC_WATER_INSIGNIA] && sc->data[SC_WATER_INSIGNIA]->val1 == 2)
+		if(sc_data(sc, SC_HEALPLUS) && skill_id != NPC_EVILLAND && skill_id != BA_APPLEIDUN)
+			hp += hp * sc_data(sc, SC_HEALPLUS)->val1/100; // Only affects Heal, Sanctuary and PotionPitcher.(like bHealPower) [Inkfish]
+		if (sc_data(sc, SC_VITALIZE_POTION) != NULL && skill_id != NPC_EVILLAND && skill_id != BA_APPLEIDUN)
+			hp += hp * sc_data(sc, SC_VITALIZE_POTION)->val3 / 100;
+		if(sc_data(sc, SC_WATER_INSIGNIA) && sc_data(sc, SC_WATER_INSIGNIA)->val1 == 2)
 			hp += hp / 10;
-		if (sc->data[SC_VITALITYACTIVATION])
+		if (sc_data(sc, SC_VITALITYACTIVATION))
 			hp = hp * 150 / 100;
-		if (sc->data[SC_NO_RECOVER_STATE])
+		if (sc_data(sc, SC_NO_RECOVER_STATE))
 			hp = 0;
 	}
 
@@ -1268,11 +1268,11 @@ static int can_copy(struct map_session_data *sd, uint16 skill_id)
 		return 0;
 
 	// Checks if preserve is active and if skill can be copied by Plagiarism
-	if (!sd->sc.data[SC_PRESERVE] && (skill->get_inf2(skill_id) & INF2_ALLOW_PLAGIARIZE))
+	if (!sc_data(&sd->sc, SC_PRESERVE) && (skill->get_inf2(skill_id) & INF2_ALLOW_PLAGIARIZE))
 		return 1;
 
 	/// Reproduce will only copy skills according on the list. [Jobbie]
-	if (sd->sc.data[SC__REPRODUCE] && sd->sc.data[SC__REPRODUCE]->val1 && (skill->get_inf2(skill_id) & INF2_ALLOW_REPRODUCE))
+	if (sc_data(&sd->sc, SC__REPRODUCE) && sc_data(&sd->sc, SC__REPRODUCE)->val1 && (skill->get_inf2(skill_id) & INF2_ALLOW_REPRODUCE))
 		return 2;
 
 	return 0;
@@ -1323,7 +1323,7 @@ static int skillnotok(uint16 skill_id, struct map_session_data *sd)
 	if (sd->auto_cast_current.type == AUTOCAST_ITEM)
 		return 0;
 
-	if( sd->sc.data[SC_ALL_RIDING] )
+	if( sc_data(&sd->sc, SC_ALL_RIDING) )
 		return 1;//You can't use skills while in the new mounts (The client doesn't let you, this is to make cheat-safe)
 
 	switch (skill_id) {
@@ -1430,11 +1430,11 @@ static int skillnotok_hom(uint16 skill_id, struct homun_data *hd)
 			}
 			break;
 	    case MH_GOLDENE_FERSE: //can be used with angriff
-			if(hd->sc.data[SC_ANGRIFFS_MODUS])
+			if(sc_data(&hd->sc, SC_ANGRIFFS_MODUS))
 				return 1;
 			/* Fall through */
 	    case MH_ANGRIFFS_MODUS:
-			if(hd->sc.data[SC_GOLDENE_FERSE])
+			if(sc_data(&hd->sc, SC_GOLDENE_FERSE))
 				return 1;
 			break;
 	    default:
@@ -1652,44 +1652,44 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 						clif->skill_fail(sd, RG_SNATCHER, USESKILL_FAIL_LEVEL, 0, 0);
 				}
 				// Chance to trigger Taekwon kicks [Dralnu]
-				if(sc && !sc->data[SC_COMBOATTACK]) {
-					if(sc->data[SC_STORMKICK_READY] &&
+				if(sc && !sc_data(sc, SC_COMBOATTACK)) {
+					if(sc_data(sc, SC_STORMKICK_READY) &&
 						sc_start4(src,src,SC_COMBOATTACK, 15, TK_STORMKICK,
 							bl->id, 2, 0,
 							(2000 - 4 * sstatus->agi - 2 * sstatus->dex), TK_STORMKICK))
 						; //Stance triggered
-					else if(sc->data[SC_DOWNKICK_READY] &&
+					else if(sc_data(sc, SC_DOWNKICK_READY) &&
 						sc_start4(src,src,SC_COMBOATTACK, 15, TK_DOWNKICK,
 							bl->id, 2, 0,
 							(2000 - 4 * sstatus->agi - 2 * sstatus->dex), TK_DOWNKICK))
 						; //Stance triggered
-					else if(sc->data[SC_TURNKICK_READY] &&
+					else if(sc_data(sc, SC_TURNKICK_READY) &&
 						sc_start4(src,src,SC_COMBOATTACK, 15, TK_TURNKICK,
 							bl->id, 2, 0,
 							(2000 - 4 * sstatus->agi - 2 * sstatus->dex), TK_TURNKICK))
 						; //Stance triggered
-						else if (sc->data[SC_COUNTERKICK_READY]) { //additional chance from SG_FRIEND [Komurka]
+						else if (sc_data(sc, SC_COUNTERKICK_READY)) { //additional chance from SG_FRIEND [Komurka]
 						rate = 20;
-						if (sc->data[SC_SKILLRATE_UP] && sc->data[SC_SKILLRATE_UP]->val1 == TK_COUNTER) {
-							rate += rate*sc->data[SC_SKILLRATE_UP]->val2/100;
+						if (sc_data(sc, SC_SKILLRATE_UP) && sc_data(sc, SC_SKILLRATE_UP)->val1 == TK_COUNTER) {
+							rate += rate*sc_data(sc, SC_SKILLRATE_UP)->val2/100;
 							status_change_end(src, SC_SKILLRATE_UP, INVALID_TIMER);
 						}
 						sc_start2(src, src, SC_COMBOATTACK, rate, TK_COUNTER, bl->id,
 							(2000 - 4 * sstatus->agi - 2 * sstatus->dex), TK_COUNTER);
 					}
 				}
-				if(sc && sc->data[SC_PYROCLASTIC] && (rnd() % 1000 <= sstatus->luk * 10 / 3 + 1) )
-					skill->castend_pos2(src, bl->x, bl->y, BS_HAMMERFALL,sc->data[SC_PYROCLASTIC]->val1, tick, 0);
+				if(sc && sc_data(sc, SC_PYROCLASTIC) && (rnd() % 1000 <= sstatus->luk * 10 / 3 + 1) )
+					skill->castend_pos2(src, bl->x, bl->y, BS_HAMMERFALL,sc_data(sc, SC_PYROCLASTIC)->val1, tick, 0);
 			}
 
 			if (sc) {
 				struct status_change_entry *sce;
 				// Enchant Poison gives a chance to poison attacked enemies
-				if((sce=sc->data[SC_ENCHANTPOISON])) //Don't use sc_start since chance comes in 1/10000 rate.
+				if((sce=sc_data(sc, SC_ENCHANTPOISON))) //Don't use sc_start since chance comes in 1/10000 rate.
 					status->change_start(src,bl,SC_POISON,sce->val2, sce->val1,src->id,0,0,
 						skill->get_time2(AS_ENCHANTPOISON, sce->val1), SCFLAG_NONE, skill_id);
 				// Enchant Deadly Poison gives a chance to deadly poison attacked enemies
-				if((sce=sc->data[SC_EDP]))
+				if((sce=sc_data(sc, SC_EDP)))
 					sc_start4(src,bl,SC_DPOISON,sce->val2, sce->val1,src->id,0,0,
 						skill->get_time2(ASC_EDP, sce->val1), skill_id);
 			}
@@ -1932,7 +1932,7 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 			break;
 
 		case PF_FOGWALL:
-			if (src != bl && !tsc->data[SC_DELUGE])
+			if (src != bl && !sc_data(tsc, SC_DELUGE))
 				sc_start(src, bl, SC_BLIND, 100, skill_lv, skill->get_time2(skill_id, skill_lv), skill_id);
 			break;
 
@@ -1980,7 +1980,7 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 			break;
 
 		case TK_JUMPKICK:
-			if (dstsd != NULL && (dstsd->job & MAPID_UPPERMASK) != MAPID_SOUL_LINKER && tsc->data[SC_PRESERVE] == NULL) {
+			if (dstsd != NULL && (dstsd->job & MAPID_UPPERMASK) != MAPID_SOUL_LINKER && sc_data(tsc, SC_PRESERVE) == NULL) {
 				// debuff the following statuses
 				status_change_end(bl, SC_SOULLINK, INVALID_TIMER);
 				status_change_end(bl, SC_ADRENALINE2, INVALID_TIMER);
@@ -2041,7 +2041,7 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 			sc_start4(src, bl, SC_FROSTMISTY, 15, skill_lv, 1000, src->id, 0, skill->get_time(skill_id, skill_lv), skill_id);
 			break;
 		case AB_ADORAMUS:
-			if( tsc && !tsc->data[SC_DEC_AGI] ) //Prevent duplicate agi-down effect.
+			if( tsc && !sc_data(tsc, SC_DEC_AGI) ) //Prevent duplicate agi-down effect.
 				sc_start(src, bl, SC_ADORAMUS, skill_lv * 4 + (sd ? sd->status.job_level : 50) / 2, skill_lv, skill->get_time(skill_id, skill_lv), skill_id);
 			break;
 		case WL_CRIMSONROCK:
@@ -2109,7 +2109,7 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 			break;
 		case NC_COLDSLOWER:
 			sc_start(src, bl, SC_FREEZE, 10 * skill_lv, skill_lv, skill->get_time(skill_id, skill_lv), skill_id);
-			if ( tsc && !tsc->data[SC_FREEZE] )
+			if ( tsc && !sc_data(tsc, SC_FREEZE) )
 				sc_start(src, bl, SC_FROSTMISTY, 20 + 10 * skill_lv, skill_lv, skill->get_time2(skill_id, skill_lv), skill_id);
 			break;
 		case NC_POWERSWING:
@@ -2133,10 +2133,10 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 			sc_start(src, bl, SC_STUN, rate, skill_lv, skill->get_time(skill_id, skill_lv), skill_id);
 			break;
 		case LG_HESPERUSLIT:
-			if ( sc && sc->data[SC_BANDING] ) {
-				if ( sc->data[SC_BANDING]->val2 == 4 ) // 4 banding RGs: Targets will be stunned at 100% chance for 4 ~ 8 seconds, irreducible by STAT.
+			if ( sc && sc_data(sc, SC_BANDING) ) {
+				if ( sc_data(sc, SC_BANDING)->val2 == 4 ) // 4 banding RGs: Targets will be stunned at 100% chance for 4 ~ 8 seconds, irreducible by STAT.
 					status->change_start(src, bl, SC_STUN, 10000, skill_lv, 0, 0, 0, 1000 * (4 + rnd() % 4), SCFLAG_FIXEDTICK, skill_id);
-				else if ( sc->data[SC_BANDING]->val2 == 6 ) // 6 banding RGs: activate Pinpoint Attack Lv1-5
+				else if ( sc_data(sc, SC_BANDING)->val2 == 6 ) // 6 banding RGs: activate Pinpoint Attack Lv1-5
 					skill->castend_damage_id(src,bl,LG_PINPOINTATTACK,1+rnd()%5,tick,0);
 			}
 			break;
@@ -2201,8 +2201,8 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 			break;
 		case SO_DIAMONDDUST:
 			rate = 5 + 5 * skill_lv;
-			if( sc && sc->data[SC_COOLER_OPTION] )
-				rate += sc->data[SC_COOLER_OPTION]->val3 / 5;
+			if( sc && sc_data(sc, SC_COOLER_OPTION) )
+				rate += sc_data(sc, SC_COOLER_OPTION)->val3 / 5;
 			sc_start(src, bl, SC_COLD, rate, skill_lv, skill->get_time2(skill_id, skill_lv), skill_id);
 			break;
 		case SO_VARETYR_SPEAR:
@@ -2260,7 +2260,7 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 			sc_start(src, bl, SC_STUN, 10 * skill_lv, skill_lv, 1000 * (skill_lv / 2 + 2), skill_id);
 			break;
 		case MH_LAVA_SLIDE:
-			if (tsc && !tsc->data[SC_BURNING])
+			if (tsc && !sc_data(tsc, SC_BURNING))
 				sc_start4(src, bl, SC_BURNING, 10 * skill_lv, skill_lv, 0, src->id, 0, skill->get_time(skill_id, skill_lv), skill_id);
 			break;
 		case MH_STAHL_HORN:
@@ -2305,7 +2305,7 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 			{
 				int i;
 				if ((dstsd != NULL && (dstsd->job & MAPID_UPPERMASK) == MAPID_SOUL_LINKER)
-					|| (tsc && tsc->data[SC_SOULLINK] && tsc->data[SC_SOULLINK]->val2 == SL_ROGUE)
+					|| (tsc && sc_data(tsc, SC_SOULLINK) && sc_data(tsc, SC_SOULLINK)->val2 == SL_ROGUE)
 					|| (dstsd && pc_ismadogear(dstsd))
 					|| rnd() % 100 >= 50 + 10 * skill_lv)
 				{
@@ -2315,9 +2315,7 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 				}
 				if (status->isimmune(bl) || !tsc || !tsc->count)
 					break;
-				for (i = 0; i < SC_MAX; i++) {
-					if (!tsc->data[i])
-						continue;
+				for (i = sc_next(tsc, SC_NONE); i < SC_MAX; i = sc_next(tsc, i)) {
 					if (SC_COMMON_MAX < i) {
 						if (status->get_sc_type(i) & SC_BB_NO_RESET)
 							continue;
@@ -2331,7 +2329,7 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 					case SC_DONTFORGETME:
 					case SC_FORTUNE:
 					case SC_SERVICEFORYOU:
-						if (tsc->data[i]->val4)
+						if (sc_data(tsc, i)->val4)
 							continue;
 						break;
 					case SC_ASSUMPTIO:
@@ -2340,7 +2338,7 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 						break;
 					case SC_BERSERK:
 					case SC_SATURDAY_NIGHT_FEVER:
-						tsc->data[i]->val2 = 0;
+						sc_data(tsc, i)->val2 = 0;
 						break;
 					}
 					status_change_end(bl, (sc_type)i, INVALID_TIMER);
@@ -2390,11 +2388,11 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 			rate = battle_config.equip_natural_break_rate;
 			if( sc )
 			{
-				if(sc->data[SC_GIANTGROWTH])
+				if(sc_data(sc, SC_GIANTGROWTH))
 					rate += 10;
-				if(sc->data[SC_OVERTHRUST])
+				if(sc_data(sc, SC_OVERTHRUST))
 					rate += 10;
-				if(sc->data[SC_OVERTHRUSTMAX])
+				if(sc_data(sc, SC_OVERTHRUSTMAX))
 					rate += 10;
 			}
 			if( rate )
@@ -2406,8 +2404,8 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 			rate = 0;
 			if( sd )
 				rate += sd->bonus.break_weapon_rate;
-			if( sc && sc->data[SC_MELTDOWN] )
-				rate += sc->data[SC_MELTDOWN]->val2;
+			if( sc && sc_data(sc, SC_MELTDOWN) )
+				rate += sc_data(sc, SC_MELTDOWN)->val2;
 			if( rate )
 				skill->break_equip(bl, EQP_WEAPON, rate, BCT_ENEMY);
 
@@ -2415,8 +2413,8 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 			rate = 0;
 			if( sd )
 				rate += sd->bonus.break_armor_rate;
-			if( sc && sc->data[SC_MELTDOWN] )
-				rate += sc->data[SC_MELTDOWN]->val3;
+			if( sc && sc_data(sc, SC_MELTDOWN) )
+				rate += sc_data(sc, SC_MELTDOWN)->val3;
 			if( rate )
 				skill->break_equip(bl, EQP_ARMOR, rate, BCT_ENEMY);
 		}
@@ -2436,14 +2434,14 @@ static int skill_additional_effect(struct block_list *src, struct block_list *bl
 	if( sd && sd->ed && sc && !status->isdead(bl) && !skill_id ) {
 		struct unit_data *ud = unit->bl2ud(src);
 
-		if( sc->data[SC_WILD_STORM_OPTION] )
-			temp = sc->data[SC_WILD_STORM_OPTION]->val2;
-		else if( sc->data[SC_UPHEAVAL_OPTION] )
-			temp = sc->data[SC_UPHEAVAL_OPTION]->val2;
-		else if( sc->data[SC_TROPIC_OPTION] )
-			temp = sc->data[SC_TROPIC_OPTION]->val3;
-		else if( sc->data[SC_CHILLY_AIR_OPTION] )
-			temp = sc->data[SC_CHILLY_AIR_OPTION]->val3;
+		if( sc_data(sc, SC_WILD_STORM_OPTION) )
+			temp = sc_data(sc, SC_WILD_STORM_OPTION)->val2;
+		else if( sc_data(sc, SC_UPHEAVAL_OPTION) )
+			temp = sc_data(sc, SC_UPHEAVAL_OPTION)->val2;
+		else if( sc_data(sc, SC_TROPIC_OPTION) )
+			temp = sc_data(sc, SC_TROPIC_OPTION)->val3;
+		else if( sc_data(sc, SC_CHILLY_AIR_OPTION) )
+			temp = sc_data(sc, SC_CHILLY_AIR_OPTION)->val3;
 		else
 			temp = 0;
 
@@ -2701,6 +2699,7 @@ static int skill_counter_additional_effect(struct block_list *src, struct block_
 	struct map_session_data *sd=NULL;
 	struct map_session_data *dstsd=NULL;
 	struct status_change *sc;
+	struct status_change_entry *sce, *sce_banding;
 
 	nullpo_ret(src);
 	nullpo_ret(bl);
@@ -2759,8 +2758,8 @@ static int skill_counter_additional_effect(struct block_list *src, struct block_
 			attack_type |= BF_WEAPON;
 			break;
 		case LG_HESPERUSLIT:
-			if ( sc && sc->data[SC_FORCEOFVANGUARD] && sc->data[SC_BANDING] && sc->data[SC_BANDING]->val2 > 6 ) {
-					for(int i = 0; i < sc->data[SC_FORCEOFVANGUARD]->val3 && sc->fv_counter <= sc->data[SC_FORCEOFVANGUARD]->val3 ; i++)
+			if ( sc && (sce = sc_data(sc, SC_FORCEOFVANGUARD)) != NULL && (sce_banding = sc_data(sc, SC_BANDING)) != NULL && sce_banding->val2 > 6 ) {
+					for(int i = 0; i < sce->val3 && sc->fv_counter <= sce->val3 ; i++)
 						clif->millenniumshield(bl, sc->fv_counter++);
 				}
 				break;
@@ -2808,11 +2807,11 @@ static int skill_counter_additional_effect(struct block_list *src, struct block_
 			sp += sd->bonus.magic_sp_gain_value;
 			hp += sd->bonus.magic_hp_gain_value;
 			if( skill_id == WZ_WATERBALL ) {// (bugreport:5303)
-				if( sc->data[SC_SOULLINK]
-				  && sc->data[SC_SOULLINK]->val2 == SL_WIZARD
-				  && sc->data[SC_SOULLINK]->val3 == WZ_WATERBALL
+				if( sc_data(sc, SC_SOULLINK)
+				  && sc_data(sc, SC_SOULLINK)->val2 == SL_WIZARD
+				  && sc_data(sc, SC_SOULLINK)->val3 == WZ_WATERBALL
 				)
-					sc->data[SC_SOULLINK]->val3 = 0; //Clear bounced spell check.
+					sc_data(sc, SC_SOULLINK)->val3 = 0; //Clear bounced spell check.
 			}
 		}
 		if (hp != 0 || sp != 0) {
@@ -2978,7 +2977,7 @@ static int skill_break_equip(struct block_list *bl, unsigned short where, int ra
 
 	for (i = 0; i < 4; i++) {
 		if (where&where_list[i]) {
-			if (sc && sc->count && sc->data[scdef[i]])
+			if (sc && sc->count && sc_data(sc, scdef[i]))
 				where&=~where_list[i];
 			else if (rnd()%10000 >= rate)
 				where&=~where_list[i];
@@ -3043,7 +3042,7 @@ static int skill_strip_equip(struct block_list *bl, unsigned short where, int ra
 		return 0;
 
 	for (i = 0; i < ARRAYLENGTH(pos); i++) {
-		if (where&pos[i] && sc->data[sc_def[i]])
+		if (where&pos[i] && sc_data(sc, sc_def[i]))
 			where&=~pos[i];
 	}
 	if (!where) return 0;
@@ -3088,7 +3087,7 @@ static int skill_blown(struct block_list *src, struct block_list *target, int co
 		case BL_PC:
 		{
 			struct map_session_data *sd = BL_UCAST(BL_PC, target);
-			if (sd->sc.data[SC_BASILICA] && sd->sc.data[SC_BASILICA]->val4 == sd->bl.id && !is_boss(src))
+			if (sc_data(&sd->sc, SC_BASILICA) && sc_data(&sd->sc, SC_BASILICA)->val4 == sd->bl.id && !is_boss(src))
 				return 0; // Basilica caster can't be knocked-back by normal monsters.
 			if (!(flag&0x2) && src != target && sd->special_state.no_knockback)
 				return 0;
@@ -3118,7 +3117,7 @@ static int skill_blown(struct block_list *src, struct block_list *target, int co
 
 	dir = unit_get_opposite_dir(dir); // take the reversed 'direction' and reverse it
 
-	if (tsc != NULL && tsc->data[SC_SU_STOOP]) // Any knockback will cancel it.
+	if (tsc != NULL && sc_data(tsc, SC_SU_STOOP)) // Any knockback will cancel it.
 		status_change_end(target, SC_SU_STOOP, INVALID_TIMER);
 
 	return unit->push(target, dir, count, (flag & 0x1) == 0x0); // send over the proper flag
@@ -3134,10 +3133,11 @@ static int skill_blown(struct block_list *src, struct block_list *target, int co
 static int skill_magic_reflect(struct block_list *src, struct block_list *bl, int type)
 {
 	struct status_change *sc = status->get_sc(bl);
+	struct status_change_entry *sce;
 	struct map_session_data* sd = BL_CAST(BL_PC, bl);
 
 	nullpo_ret(src);
-	if( sc && sc->data[SC_KYOMU] ) // Nullify reflecting ability
+	if( sc && sc_data(sc, SC_KYOMU) ) // Nullify reflecting ability
 		return  0;
 
 	// item-based reflection
@@ -3151,13 +3151,13 @@ static int skill_magic_reflect(struct block_list *src, struct block_list *bl, in
 	if( !sc || sc->count == 0 )
 		return 0;
 
-	if( sc->data[SC_MAGICMIRROR] && rnd()%100 < sc->data[SC_MAGICMIRROR]->val2 )
+	if( (sce = sc_data(sc, SC_MAGICMIRROR)) != NULL && rnd()%100 < sce->val2 )
 		return 1;
 
-	if( sc->data[SC_KAITE] && (src->type == BL_PC || status->get_lv(src) <= 80) )
+	if( (sce = sc_data(sc, SC_KAITE)) != NULL && (src->type == BL_PC || status->get_lv(src) <= 80) )
 	{// Kaite only works against non-players if they are low-level.
 		clif->specialeffect(bl, 438, AREA);
-		if( --sc->data[SC_KAITE]->val2 <= 0 )
+		if( --sce->val2 <= 0 )
 			status_change_end(bl, SC_KAITE, INVALID_TIMER);
 		return 2;
 	}
@@ -3191,6 +3191,7 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 	struct status_data *tstatus;
 #endif
 	struct status_change *sc;
+	struct status_change_entry *sce;
 	struct map_session_data *sd, *tsd;
 	int type;
 	int64 damage;
@@ -3235,11 +3236,11 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 	if(skill_id == WZ_FROSTNOVA && dsrc->x == bl->x && dsrc->y == bl->y)
 		return 0;
 	 //Trick Dead protects you from damage, but not from buffs and the like, hence it's placed here.
-	if (sc && sc->data[SC_TRICKDEAD])
+	if (sc && sc_data(sc, SC_TRICKDEAD))
 		return 0;
 	if ( skill_id != HW_GRAVITATION ) {
 		struct status_change *csc = status->get_sc(src);
-		if(csc && csc->data[SC_GRAVITATION] && csc->data[SC_GRAVITATION]->val3 == BCT_SELF )
+		if(csc && (sce = sc_data(csc, SC_GRAVITATION)) != NULL && sce->val3 == BCT_SELF )
 			return 0;
 	}
 
@@ -3282,15 +3283,15 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 			/* bugreport:7859 magical reflected zeroes blow count */
 			dmg.blewcount = 0;
 			//Spirit of Wizard blocks Kaite's reflection
-			if (reflecttype == 2 && sc && sc->data[SC_SOULLINK] && sc->data[SC_SOULLINK]->val2 == SL_WIZARD) {
+			if (reflecttype == 2 && sc && (sce = sc_data(sc, SC_SOULLINK)) != NULL && sce->val2 == SL_WIZARD) {
 				//Consume one Fragment per hit of the casted skill? [Skotlex]
 				int consumeitem = tsd ? pc->search_inventory(tsd, ITEMID_FRAGMENT_OF_CRYSTAL) : 0;
 				if (consumeitem != INDEX_NOT_FOUND) {
 					if ( tsd ) pc->delitem(tsd, consumeitem, 1, 0, DELITEM_SKILLUSE, LOG_TYPE_CONSUME);
 					dmg.damage = dmg.damage2 = 0;
 					dmg.dmg_lv = ATK_MISS;
-					sc->data[SC_SOULLINK]->val3 = skill_id;
-					sc->data[SC_SOULLINK]->val4 = dsrc->id;
+					sce->val3 = skill_id;
+					sce->val4 = dsrc->id;
 				}
 			} else if( reflecttype != 2 ) /* Kaite bypasses */
 				additional_effects = false;
@@ -3319,7 +3320,7 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 
 				dmg.damage = battle->attr_fix(bl, bl, dmg.damage, s_ele, status_get_element(bl), status_get_element_level(bl));
 
-				if( sc && sc->data[SC_ENERGYCOAT] ) {
+				if( sc && sc_data(sc, SC_ENERGYCOAT) ) {
 					struct status_data *st = status->get_status_data(bl);
 					int per = 100*st->sp / st->max_sp -1; //100% should be counted as the 80~99% interval
 					per /=20; //Uses 20% SP intervals.
@@ -3332,16 +3333,16 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 			}
 		#endif /* MAGIC_REFLECTION_TYPE */
 		}
-		if (sc && sc->data[SC_MAGICROD] && src == dsrc) {
+		if (sc && (sce = sc_data(sc, SC_MAGICROD)) != NULL && src == dsrc) {
 			int sp = skill->get_sp(skill_id, skill_lv);
 			dmg.damage = dmg.damage2 = 0;
 			dmg.dmg_lv = ATK_MISS; //This will prevent skill additional effect from taking effect. [Skotlex]
-			sp = sp * sc->data[SC_MAGICROD]->val2 / 100;
+			sp = sp * sce->val2 / 100;
 			if (skill_id == WZ_WATERBALL && skill_lv > 1)
 				sp = sp / ((skill_lv | 1) * (skill_lv | 1)); //Estimate SP cost of a single water-ball
 			status->heal(bl, 0, sp, STATUS_HEAL_SHOWEFFECT);
 			if (battle->bc->magicrod_type == 1)
-				clif->skill_nodamage(bl, bl, SA_MAGICROD, sc->data[SC_MAGICROD]->val1, 1); // Animation used here in eAthena [Wolfie]
+				clif->skill_nodamage(bl, bl, SA_MAGICROD, sce->val1, 1); // Animation used here in eAthena [Wolfie]
 		}
 	}
 
@@ -3361,10 +3362,10 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 
 	if( (skill_id == AL_INCAGI || skill_id == AL_BLESSING ||
 		skill_id == CASH_BLESSING || skill_id == CASH_INCAGI ||
-		skill_id == MER_INCAGI || skill_id == MER_BLESSING) && tsd && tsd->sc.data[SC_PROPERTYUNDEAD] )
+		skill_id == MER_INCAGI || skill_id == MER_BLESSING) && tsd && sc_data(&tsd->sc, SC_PROPERTYUNDEAD) )
 		damage = 1;
 
-	if( damage && sc && sc->data[SC_GENSOU] && dmg.flag&BF_MAGIC ){
+	if( damage && sc && sc_data(sc, SC_GENSOU) && dmg.flag&BF_MAGIC ){
 		struct block_list *nbl;
 		nbl = battle->get_enemy_area(bl,bl->x,bl->y,2,BL_CHAR,bl->id);
 		if (nbl) { // Only one target is chosen.
@@ -3392,9 +3393,8 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 
 	if (sd != NULL) {
 		int combo = 0; //Used to signal if this skill can be combo'ed later on.
-		struct status_change_entry *sce;
 
-		if ((sce = sd->sc.data[SC_COMBOATTACK])) {//End combo state after skill is invoked. [Skotlex]
+		if ((sce = sc_data(&sd->sc, SC_COMBOATTACK))) {//End combo state after skill is invoked. [Skotlex]
 			switch (skill_id) {
 			case TK_TURNKICK:
 			case TK_STORMKICK:
@@ -3441,7 +3441,7 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 					combo = 1;
 				FALLTHROUGH
 			case CH_CHAINCRUSH:
-				if (!combo && pc->checkskill(sd, MO_EXTREMITYFIST) > 0 && sd->spiritball > 0 && sd->sc.data[SC_EXPLOSIONSPIRITS])
+				if (!combo && pc->checkskill(sd, MO_EXTREMITYFIST) > 0 && sd->spiritball > 0 && sc_data(&sd->sc, SC_EXPLOSIONSPIRITS))
 					combo = 1;
 				break;
 			case AC_DOUBLE:
@@ -3462,7 +3462,7 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 				break;
 			case SL_STIN:
 			case SL_STUN:
-				if (skill_lv >= 7 && !sd->sc.data[SC_SMA_READY])
+				if (skill_lv >= 7 && !sc_data(&sd->sc, SC_SMA_READY))
 					sc_start(src, src, SC_SMA_READY, 100, skill_lv, skill->get_time(SL_SMA, skill_lv), skill_id);
 				break;
 			case GS_FULLBUSTER:
@@ -3643,7 +3643,7 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 	// Plagiarism and Reproduce Code Block [KeiKun]
 	if (bl->type == BL_PC && damage > 0 && dmg.flag&BF_SKILL && tsd
 		&& (pc->checkskill(tsd, RG_PLAGIARISM) || pc->checkskill(tsd, SC_REPRODUCE))
-		&& (!tsd->sc.data[SC_PRESERVE] || tsd->sc.data[SC__REPRODUCE])
+		&& (!sc_data(&tsd->sc, SC_PRESERVE) || sc_data(&tsd->sc, SC__REPRODUCE))
 		&& damage < tsd->battle_status.hp // Updated to not be able to copy skills if the blow will kill you. [Skotlex]
 		) {
 		int copy_skill = 0;
@@ -3711,7 +3711,7 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 		break;
 		case 2: // Reproduce
 		{
-			lv = sc ? sc->data[SC__REPRODUCE]->val1 : 1;
+			lv = sc ? sc_data(sc, SC__REPRODUCE)->val1 : 1;
 			pc->clear_existing_reproduceskill(tsd, false);
 
 			lv = min(lv, skill->get_max(copy_skill));
@@ -3748,7 +3748,7 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 
 	if( !dmg.amotion ) {
 		//Instant damage
-		if ((!sc || (!sc->data[SC_DEVOTION] && skill_id != CR_REFLECTSHIELD && !sc->data[SC_WATER_SCREEN_OPTION])) && !shadow_flag)
+		if ((!sc || (!sc_data(sc, SC_DEVOTION) && skill_id != CR_REFLECTSHIELD && !sc_data(sc, SC_WATER_SCREEN_OPTION))) && !shadow_flag)
 			status_fix_damage(src,bl,damage,dmg.dmotion); //Deal damage before knockback to allow stuff like firewall+storm gust combo.
 		if( !status->isdead(bl) && additional_effects )
 			skill->additional_effect(src,bl,skill_id,skill_lv,dmg.flag,dmg.dmg_lv,tick);
@@ -3837,8 +3837,7 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 	}
 
 	if (sc != NULL && skill_id != PA_PRESSURE && skill_id != SJ_NOVAEXPLOSING && skill_id != SP_SOULEXPLOSION) {
-		if (sc->data[SC_DEVOTION]) {
-			struct status_change_entry *sce = sc->data[SC_DEVOTION];
+		if ((sce = sc_data(sc, SC_DEVOTION)) != NULL) {
 			struct block_list *d_bl = map->id2bl(sce->val1);
 			struct mercenary_data *d_md = BL_CAST(BL_MER, d_bl);
 			struct map_session_data *d_sd = BL_CAST(BL_PC, d_bl);
@@ -3862,8 +3861,7 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 					status_fix_damage(src, bl, damage, dmg.dmotion);
 			}
 		}
-		if (sc->data[SC_WATER_SCREEN_OPTION]) {
-			struct status_change_entry *sce = sc->data[SC_WATER_SCREEN_OPTION];
+		if ((sce = sc_data(sc, SC_WATER_SCREEN_OPTION)) != NULL) {
 			struct block_list *e_bl = map->id2bl(sce->val1);
 
 			if (e_bl) {
@@ -3908,10 +3906,10 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 			case GC_VENOMPRESSURE:
 			{
 				struct status_change *ssc = status->get_sc(src);
-				if (ssc != NULL && ssc->data[SC_POISONINGWEAPON] != NULL && rnd() % 100 < 70 + 5 * skill_lv) {
-					sc_type poison_sc = ssc->data[SC_POISONINGWEAPON]->val2;
+				if (ssc != NULL && (sce = sc_data(ssc, SC_POISONINGWEAPON)) != NULL && rnd() % 100 < 70 + 5 * skill_lv) {
+					sc_type poison_sc = sce->val2;
 					int duration = skill->get_time2(GC_POISONINGWEAPON, (poison_sc == SC_VENOMBLEED ? 1 : 2));
-					sc_start(src, bl, poison_sc, 100, ssc->data[SC_POISONINGWEAPON]->val1, duration, skill_id);
+					sc_start(src, bl, poison_sc, 100, sce->val1, duration, skill_id);
 					status_change_end(src, SC_POISONINGWEAPON, INVALID_TIMER);
 					clif->skill_nodamage(src, bl, skill_id, skill_lv, 1);
 				}
@@ -3934,8 +3932,8 @@ static int skill_attack(int attack_type, struct block_list *src, struct block_li
 	if (!(flag&2)
 	 && (skill_id == MG_COLDBOLT || skill_id == MG_FIREBOLT || skill_id == MG_LIGHTNINGBOLT)
 	 && (sc = status->get_sc(src)) != NULL
-	 && sc->data[SC_DOUBLECASTING]
-	 && rnd() % 100 < sc->data[SC_DOUBLECASTING]->val2
+	 && (sce = sc_data(sc, SC_DOUBLECASTING)) != NULL
+	 && rnd() % 100 < sce->val2
 	) {
 		//skill->addtimerskill(src, tick + dmg.div_*dmg.amotion, bl->id, 0, 0, skill_id, skill_lv, BF_MAGIC, flag|2);
 		skill->addtimerskill(src, tick + dmg.amotion, bl->id, 0, 0, skill_id, skill_lv, BF_MAGIC, flag|2);
@@ -4431,10 +4429,10 @@ static int skill_timerskill(int tid, int64 tick, int id, intptr_t data)
 					} else {
 						struct status_change *sc = status->get_sc(src);
 						if(sc) {
-							if(sc->data[SC_SOULLINK] &&
-								sc->data[SC_SOULLINK]->val2 == SL_WIZARD &&
-								sc->data[SC_SOULLINK]->val3 == skl->skill_id)
-								sc->data[SC_SOULLINK]->val3 = 0; //Clear bounced spell check.
+							if(sc_data(sc, SC_SOULLINK) &&
+								sc_data(sc, SC_SOULLINK)->val2 == SL_WIZARD &&
+								sc_data(sc, SC_SOULLINK)->val3 == skl->skill_id)
+								sc_data(sc, SC_SOULLINK)->val3 = 0; //Clear bounced spell check.
 						}
 					}
 					break;
@@ -4935,7 +4933,7 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 			break;
 
 		case MO_COMBOFINISH:
-			if (!(flag&1) && sc && sc->data[SC_SOULLINK] && sc->data[SC_SOULLINK]->val2 == SL_MONK) {
+			if (!(flag&1) && sc && sc_data(sc, SC_SOULLINK) && sc_data(sc, SC_SOULLINK)->val2 == SL_MONK) {
 				//Becomes a splash attack when Soul Linked.
 				map->foreachinrange(skill->area_sub, bl,
 				                    skill->get_splash(skill_id, skill_lv),skill->splash_target(src),
@@ -5181,7 +5179,7 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 				if( (skill->area_temp[1] != bl->id && !(skill->get_inf2(skill_id)&INF2_NPC_SKILL)) || flag&SD_ANIMATION )
 					sflag |= SD_ANIMATION; // original target gets no animation (as well as all NPC skills)
 
-				if ( tsc && tsc->data[SC_HOVERING] && ( skill_id == SR_WINDMILL || skill_id == LG_MOONSLASHER ) )
+				if ( tsc && sc_data(tsc, SC_HOVERING) && ( skill_id == SR_WINDMILL || skill_id == LG_MOONSLASHER ) )
 					break;
 
 				if ((skill_id == SP_SHA || skill_id == SP_SWHOO) && bl->type != BL_MOB)
@@ -5561,14 +5559,14 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 		case RK_DRAGONBREATH:
 		{
 
-			if (tsc != NULL && tsc->data[SC_HIDING]) {
+			if (tsc != NULL && sc_data(tsc, SC_HIDING)) {
 				clif->skill_nodamage(src,src,skill_id,skill_lv,1);
 			} else
 				skill->attack(BF_WEAPON,src,src,bl,skill_id,skill_lv,tick,flag);
 		}
 			break;
 		case NPC_SELFDESTRUCTION: {
-			if (tsc != NULL && tsc->data[SC_HIDING])
+			if (tsc != NULL && sc_data(tsc, SC_HIDING))
 				break;
 			}
 			FALLTHROUGH
@@ -5668,14 +5666,14 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 			}
 			break;
 		case GC_WEAPONCRUSH:
-			if( sc && sc->data[SC_COMBOATTACK] && sc->data[SC_COMBOATTACK]->val1 == GC_WEAPONBLOCKING )
+			if( sc && sc_data(sc, SC_COMBOATTACK) && sc_data(sc, SC_COMBOATTACK)->val1 == GC_WEAPONBLOCKING )
 				skill->attack(BF_WEAPON,src,src,bl,skill_id,skill_lv,tick,flag);
 			else if( sd )
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_GC_WEAPONBLOCKING, 0, 0);
 			break;
 
 		case GC_CROSSRIPPERSLASHER:
-			if( sd && !(sc && sc->data[SC_ROLLINGCUTTER]) )
+			if( sd && !(sc && sc_data(sc, SC_ROLLINGCUTTER)) )
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_CONDITION, 0, 0);
 			else
 			{
@@ -5687,7 +5685,7 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 		case GC_PHANTOMMENACE:
 			if( flag&1 ) {
 				// Only Hits Invisible Targets
-				if(tsc && (tsc->option&(OPTION_HIDE|OPTION_CLOAK|OPTION_CHASEWALK) || tsc->data[SC__INVISIBILITY]) )
+				if(tsc && (tsc->option&(OPTION_HIDE|OPTION_CLOAK|OPTION_CHASEWALK) || sc_data(tsc, SC__INVISIBILITY)) )
 					skill->attack(BF_WEAPON,src,src,bl,skill_id,skill_lv,tick,flag);
 			}
 			break;
@@ -5717,11 +5715,11 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 				int i = SC_SUMMON5, x = 0;
 				int types[][2] = {{0, 0}, {0, 0}, {0, 0}, {0, 0}};
 				for(; i >= SC_SUMMON1; i--) {
-					if (sc->data[i]) {
-						int skillid = WL_TETRAVORTEX_FIRE + (sc->data[i]->val1 - WLS_FIRE) + (sc->data[i]->val1 == WLS_WIND) - (sc->data[i]->val1 == WLS_WATER);
+					if (sc_data(sc, i)) {
+						int skillid = WL_TETRAVORTEX_FIRE + (sc_data(sc, i)->val1 - WLS_FIRE) + (sc_data(sc, i)->val1 == WLS_WIND) - (sc_data(sc, i)->val1 == WLS_WATER);
 						if (x < 4) {
 							int sc_index = 0, rate = 0;
-							types[x][0] = (sc->data[i]->val1 - WLS_FIRE) + 1;
+							types[x][0] = (sc_data(sc, i)->val1 - WLS_FIRE) + 1;
 							types[x][1] = 25; // 25% each for equal sharing
 							if (x == 3) {
 								x = 0;
@@ -5745,31 +5743,31 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 				clif->skill_nodamage(src, bl, skill_id, skill_lv, 1);
 				skill->toggle_magicpower(src, skill_id, skill_lv);
 				// Priority is to release SpellBook
-				if (sc && sc->data[SC_READING_SB]) {
+				if (sc && sc_data(sc, SC_READING_SB)) {
 					// SpellBook
 					uint16 spell_skill_id, spell_skill_lv, point, s = 0;
 					int spell[SC_SPELLBOOK7-SC_SPELLBOOK1 + 1];
 					int cooldown;
 
 					for(i = SC_SPELLBOOK7; i >= SC_SPELLBOOK1; i--) // List all available spell to be released
-					if( sc->data[i] ) spell[s++] = i;
+					if( sc_data(sc, i) ) spell[s++] = i;
 
 					if ( s == 0 )
 						break;
 
 					i = spell[s==1?0:rnd()%s];// Random select of spell to be released.
-					if( s && sc->data[i] ){// Now extract the data from the preserved spell
-						spell_skill_id = sc->data[i]->val1;
-						spell_skill_lv = sc->data[i]->val2;
-						point = sc->data[i]->val3;
+					if( s && sc_data(sc, i) ){// Now extract the data from the preserved spell
+						spell_skill_id = sc_data(sc, i)->val1;
+						spell_skill_lv = sc_data(sc, i)->val2;
+						point = sc_data(sc, i)->val3;
 						status_change_end(src, (sc_type)i, INVALID_TIMER);
 					} else {
 						//something went wrong :(
 						break;
 					}
 
-					if( sc->data[SC_READING_SB]->val2 > point )
-						sc->data[SC_READING_SB]->val2 -= point;
+					if( sc_data(sc, SC_READING_SB)->val2 > point )
+						sc_data(sc, SC_READING_SB)->val2 -= point;
 					else // Last spell to be released
 						status_change_end(src, SC_READING_SB, INVALID_TIMER);
 
@@ -5785,8 +5783,8 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 						skill->blockpc_start(sd, spell_skill_id, cooldown);
 				}else if( sc ){ // Summon Balls
 					for(i = SC_SUMMON5; i >= SC_SUMMON1; i--){
-						if( sc->data[i] ){
-							int skillid = WL_SUMMON_ATK_FIRE + (sc->data[i]->val1 - WLS_FIRE);
+						if( sc_data(sc, i) ){
+							int skillid = WL_SUMMON_ATK_FIRE + (sc_data(sc, i)->val1 - WLS_FIRE);
 							skill->addtimerskill(src, tick + (int64)status_get_adelay(src) * (SC_SUMMON5 - i), bl->id, 0, 0, skillid, skill_lv, BF_MAGIC, flag);
 							status_change_end(src, (sc_type)i, INVALID_TIMER);
 							if(skill_lv == 1)
@@ -5946,12 +5944,12 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 
 		case WM_SOUND_OF_DESTRUCTION:
 			{
-				if( tsc && tsc->count && ( tsc->data[SC_SWING] || tsc->data[SC_SYMPHONY_LOVE] || tsc->data[SC_MOONLIT_SERENADE] ||
-						tsc->data[SC_RUSH_WINDMILL] || tsc->data[SC_ECHOSONG] || tsc->data[SC_HARMONIZE] ||
-						tsc->data[SC_SIREN] || tsc->data[SC_DEEP_SLEEP] || tsc->data[SC_SIRCLEOFNATURE] ||
-						tsc->data[SC_GLOOMYDAY] || tsc->data[SC_SONG_OF_MANA] ||
-						tsc->data[SC_DANCE_WITH_WUG] || tsc->data[SC_SATURDAY_NIGHT_FEVER] || tsc->data[SC_LERADS_DEW] ||
-						tsc->data[SC_MELODYOFSINK] || tsc->data[SC_BEYOND_OF_WARCRY] || tsc->data[SC_UNLIMITED_HUMMING_VOICE] ) &&
+				if( tsc && tsc->count && ( sc_data(tsc, SC_SWING) || sc_data(tsc, SC_SYMPHONY_LOVE) || sc_data(tsc, SC_MOONLIT_SERENADE) ||
+						sc_data(tsc, SC_RUSH_WINDMILL) || sc_data(tsc, SC_ECHOSONG) || sc_data(tsc, SC_HARMONIZE) ||
+						sc_data(tsc, SC_SIREN) || sc_data(tsc, SC_DEEP_SLEEP) || sc_data(tsc, SC_SIRCLEOFNATURE) ||
+						sc_data(tsc, SC_GLOOMYDAY) || sc_data(tsc, SC_SONG_OF_MANA) ||
+						sc_data(tsc, SC_DANCE_WITH_WUG) || sc_data(tsc, SC_SATURDAY_NIGHT_FEVER) || sc_data(tsc, SC_LERADS_DEW) ||
+						sc_data(tsc, SC_MELODYOFSINK) || sc_data(tsc, SC_BEYOND_OF_WARCRY) || sc_data(tsc, SC_UNLIMITED_HUMMING_VOICE) ) &&
 						rnd()%100 < 4 * skill_lv + 2 * (sd ? pc->checkskill(sd,WM_LESSON) : 10) + 10 * battle->calc_chorusbonus(sd)) {
 					skill->attack(BF_MISC,src,src,bl,skill_id,skill_lv,tick,flag);
 					status->change_start(src, bl, SC_STUN, 10000, skill_lv, 0, 0, 0, skill->get_time(skill_id, skill_lv), SCFLAG_FIXEDRATE, skill_id);
@@ -5978,7 +5976,7 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 
 		case SO_POISON_BUSTER:
 		{
-			if (tsc != NULL && tsc->data[SC_POISON]) {
+			if (tsc != NULL && sc_data(tsc, SC_POISON)) {
 				skill->attack(skill->get_type(skill_id, skill_lv), src, src, bl, skill_id, skill_lv, tick, flag);
 				status_change_end(bl, SC_POISON, INVALID_TIMER);
 			} else if( sd )
@@ -6054,7 +6052,7 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 
 				clif->skill_nodamage(src,battle->get_master(src),skill_id,skill_lv,1);
 				clif->skill_damage(src, src, tick, status_get_amotion(src), 0, -30000, 1, skill_id, skill_lv, BDT_SKILL);
-				if( (esc && esc->data[type2]) || (tsc && tsc->data[type]) ) {
+				if( (esc && sc_data(esc, type2)) || (tsc && sc_data(tsc, type)) ) {
 					elemental->clean_single_effect(ele, skill_id);
 				}
 				if( rnd()%100 < 50 )
@@ -6109,10 +6107,10 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 						status->change_start(src, bl, SC_HOWLING_MINE, 10000, skill_id, 0, 0, 0, skill->get_time(skill_id, skill_lv), SCFLAG_NOAVOID | SCFLAG_FIXEDTICK | SCFLAG_FIXEDRATE, skill_id);
 					break;
 				}
-				if (sd != NULL && sd->flicker && tsc != NULL && tsc->data[SC_HOWLING_MINE] != NULL && tsc->data[SC_HOWLING_MINE]->val2 == src->id) {
+				if (sd != NULL && sd->flicker && tsc != NULL && sc_data(tsc, SC_HOWLING_MINE) != NULL && sc_data(tsc, SC_HOWLING_MINE)->val2 == src->id) {
 					map->foreachinrange(skill->area_sub, bl, skill->get_splash(skill_id, skill_lv), BL_CHAR | BL_SKILL, src, skill_id, skill_lv, tick, flag | BCT_ENEMY | 1, skill->castend_damage_id);
 					flag |= 1; // Don't consume requirement
-					tsc->data[SC_HOWLING_MINE]->val3 = 1; // Mark the SC end because not expired
+					sc_data(tsc, SC_HOWLING_MINE)->val3 = 1; // Mark the SC end because not expired
 					status_change_end(bl, SC_HOWLING_MINE, INVALID_TIMER);
 					sc_start4(src, bl, SC_BURNING, 10 * skill_lv, skill_lv, 1000, src->id, 0, skill->get_time2(skill_id, skill_lv), skill_id);
 				}
@@ -6125,7 +6123,7 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 		case RL_QD_SHOT:
 			if (skill->area_temp[1] == bl->id)
 				break;
-			if ((flag & 1) && tsc != NULL && tsc->data[SC_CRIMSON_MARKER] != NULL)
+			if ((flag & 1) && tsc != NULL && sc_data(tsc, SC_CRIMSON_MARKER) != NULL)
 				skill->attack(skill->get_type(skill_id, skill_lv), src, src, bl, skill_id, skill_lv, tick, flag | SD_ANIMATION);
 			break;
 		case RL_D_TAIL:
@@ -6133,7 +6131,7 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 			if (flag & 1) {
 				skill->attack(skill->get_type(skill_id, skill_lv), src, src, bl, skill_id, skill_lv, tick, flag | SD_ANIMATION);
 			} else {
-				if (sd != NULL && tsc != NULL && tsc->data[SC_CRIMSON_MARKER] != NULL) {
+				if (sd != NULL && tsc != NULL && sc_data(tsc, SC_CRIMSON_MARKER) != NULL) {
 					int i;
 
 					ARR_FIND(0, MAX_SKILL_CRIMSON_MARKER, i, sd->c_marker[i] == bl->id);
@@ -6164,8 +6162,8 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 			}
 
 			// Check if the target is already tagged by another source.
-			if ((tsd != NULL && tsd->sc.data[SC_FLASHKICK] != NULL && tsd->sc.data[SC_FLASHKICK]->val1 != src->id) ||
-				(tmd != NULL && tmd->sc.data[SC_FLASHKICK] != NULL && tmd->sc.data[SC_FLASHKICK]->val1 != src->id)
+			if ((tsd != NULL && sc_data(&tsd->sc, SC_FLASHKICK) != NULL && sc_data(&tsd->sc, SC_FLASHKICK)->val1 != src->id) ||
+				(tmd != NULL && sc_data(&tmd->sc, SC_FLASHKICK) != NULL && sc_data(&tmd->sc, SC_FLASHKICK)->val1 != src->id)
 			) { // Same as the above check, but for monsters.
 				// Can't tag a player that was already tagged from another source.
 				if (sd != NULL) {
@@ -6207,7 +6205,7 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 			break;
 		case SJ_FALLINGSTAR_ATK:
 			if (sd != NULL) { // If a player used the skill it will search for targets marked by that player.
-				if (tsc != NULL && tsc->data[SC_FLASHKICK] != NULL && tsc->data[SC_FLASHKICK]->val4 == 1) { // Mark placed by a player.
+				if (tsc != NULL && sc_data(tsc, SC_FLASHKICK) != NULL && sc_data(tsc, SC_FLASHKICK)->val4 == 1) { // Mark placed by a player.
 					int i = 0;
 
 					ARR_FIND(0, MAX_STELLAR_MARKS, i, sd->stellar_mark[i] == bl->id);
@@ -6216,7 +6214,7 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 						skill->castend_damage_id(src, bl, SJ_FALLINGSTAR_ATK2, skill_lv, tick, 0);
 					}
 				}
-			} else if (tsc != NULL && tsc->data[SC_FLASHKICK] != NULL && tsc->data[SC_FLASHKICK]->val4 == 2) { // Mark placed by a monster.
+			} else if (tsc != NULL && sc_data(tsc, SC_FLASHKICK) != NULL && sc_data(tsc, SC_FLASHKICK)->val4 == 2) { // Mark placed by a monster.
 				// If a monster used the skill it will search for targets marked by any monster since they can't track their own targets.
 				skill->attack(BF_WEAPON, src, src, bl, skill_id, skill_lv, tick, flag);
 				skill->castend_damage_id(src, bl, SJ_FALLINGSTAR_ATK2, skill_lv, tick, 0);
@@ -6227,7 +6225,7 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 			skill->attack(BF_MISC, src, src, bl, skill_id, skill_lv, tick, flag);
 
 			// We can end Dimension here since the cooldown code is processed before this point.
-			if (sc != NULL && sc->data[SC_DIMENSION] != NULL)
+			if (sc != NULL && sc_data(sc, SC_DIMENSION) != NULL)
 				status_change_end(src, SC_DIMENSION, INVALID_TIMER);
 			else // Dimension not active? Activate the 2 second skill block penalty.
 				sc_start(src, &sd->bl, SC_NOVAEXPLOSING, 100, skill_lv, skill->get_time(skill_id, skill_lv), skill_id);
@@ -6235,11 +6233,11 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 			break;
 		case SP_SOULEXPLOSION:
 			if (!((tsc != NULL &&
-				(tsc->data[SC_SOULLINK] != NULL ||
-				tsc->data[SC_SOULGOLEM] != NULL ||
-				tsc->data[SC_SOULSHADOW] != NULL ||
-				tsc->data[SC_SOULFALCON] != NULL ||
-				tsc->data[SC_SOULFAIRY] != NULL))
+				(sc_data(tsc, SC_SOULLINK) != NULL ||
+				sc_data(tsc, SC_SOULGOLEM) != NULL ||
+				sc_data(tsc, SC_SOULSHADOW) != NULL ||
+				sc_data(tsc, SC_SOULFALCON) != NULL ||
+				sc_data(tsc, SC_SOULFAIRY) != NULL))
 				|| tstatus->hp > (10 * tstatus->max_hp / 100)
 			)) {
 				// Requires target to have a soul link or target to have more than 10% of MaxHP.
@@ -6273,7 +6271,7 @@ static int skill_castend_damage_id(struct block_list *src, struct block_list *bl
 			break;
 	}
 
-	if( sc && sc->data[SC_CURSEDCIRCLE_ATKER] ) //Should only remove after the skill has been casted.
+	if( sc && sc_data(sc, SC_CURSEDCIRCLE_ATKER) ) //Should only remove after the skill has been casted.
 		status_change_end(src,SC_CURSEDCIRCLE_ATKER,INVALID_TIMER);
 
 	map->freeblock_unlock();
@@ -6422,7 +6420,7 @@ static int skill_castend_id(int tid, int64 tick, int id, intptr_t data)
 
 		if( ud->skill_id == PR_LEXDIVINA || ud->skill_id == MER_LEXDIVINA ) {
 			sc = status->get_sc(target);
-			if( battle->check_target(src,target, BCT_ENEMY) <= 0 && (!sc || !sc->data[SC_SILENCE]) )
+			if( battle->check_target(src,target, BCT_ENEMY) <= 0 && (!sc || !sc_data(sc, SC_SILENCE)) )
 			{ //If it's not an enemy, and not silenced, you can't use the skill on them. [Skotlex]
 				clif->skill_nodamage (src, target, ud->skill_id, ud->skill_lv, 0);
 				break;
@@ -6468,7 +6466,7 @@ static int skill_castend_id(int tid, int64 tick, int id, intptr_t data)
 			}
 
 			if ((inf & BCT_ENEMY) != 0 && ud->skill_id != PF_SOULCHANGE // PF_SOULCHANGE is a friendly skill in Aegis under all circumstances.
-			 && (sc = status->get_sc(target)) != NULL && sc->data[SC_FOGWALL]
+			 && (sc = status->get_sc(target)) != NULL && sc_data(sc, SC_FOGWALL)
 			 && rnd() % 100 < 75
 			) {
 				// Fogwall makes all offensive-type targeted skills fail at 75%
@@ -6482,7 +6480,9 @@ static int skill_castend_id(int tid, int64 tick, int id, intptr_t data)
 			break;
 
 		if(md) {
-			md->last_thinktime=tick +MIN_MOBTHINKTIME;
+			struct mob_ai_hot *hot = mob_ai_hot(md);
+			if (hot != NULL)
+				hot->last_thinktime=tick +MIN_MOBTHINKTIME;
 			if(md->skill_idx >= 0 && md->db->skill[md->skill_idx].emotion >= 0)
 				clif->emotion(src, md->db->skill[md->skill_idx].emotion);
 		}
@@ -6540,8 +6540,8 @@ static int skill_castend_id(int tid, int64 tick, int id, intptr_t data)
 				break;
 			case CR_GRANDCROSS:
 			case NPC_GRANDDARKNESS:
-				if( (sc = status->get_sc(src)) && sc->data[SC_NOEQUIPSHIELD] ) {
-					const struct TimerData *td = timer->get(sc->data[SC_NOEQUIPSHIELD]->timer);
+				if( (sc = status->get_sc(src)) && sc_data(sc, SC_NOEQUIPSHIELD) ) {
+					const struct TimerData *td = timer->get(sc_data(sc, SC_NOEQUIPSHIELD)->timer);
 					if( td && td->func == status->change_timer && DIFF_TICK(td->tick,timer->gettick()+skill->get_time(ud->skill_id, ud->skill_lv)) > 0 )
 						break;
 				}
@@ -6573,14 +6573,14 @@ static int skill_castend_id(int tid, int64 tick, int id, intptr_t data)
 
 		sc = status->get_sc(src);
 		if(sc && sc->count) {
-			if( sc->data[SC_SOULLINK]
-			 && sc->data[SC_SOULLINK]->val2 == SL_WIZARD
-			 && sc->data[SC_SOULLINK]->val3 == ud->skill_id
+			if( sc_data(sc, SC_SOULLINK)
+			 && sc_data(sc, SC_SOULLINK)->val2 == SL_WIZARD
+			 && sc_data(sc, SC_SOULLINK)->val3 == ud->skill_id
 			 && ud->skill_id != WZ_WATERBALL
 			)
-				sc->data[SC_SOULLINK]->val3 = 0; //Clear bounced spell check.
+				sc_data(sc, SC_SOULLINK)->val3 = 0; //Clear bounced spell check.
 
-			if( sc->data[SC_DANCING] && skill->get_inf2(ud->skill_id)&INF2_SONG_DANCE && sd )
+			if( sc_data(sc, SC_DANCING) && skill->get_inf2(ud->skill_id)&INF2_SONG_DANCE && sd )
 				skill->blockpc_start(sd,BD_ADAPTATION,3000);
 		}
 
@@ -6604,7 +6604,7 @@ static int skill_castend_id(int tid, int64 tick, int id, intptr_t data)
 	} while(0);
 
 	//Skill failed.
-	if (ud->skill_id == MO_EXTREMITYFIST && sd && !(sc && sc->data[SC_FOGWALL])) {
+	if (ud->skill_id == MO_EXTREMITYFIST && sd && !(sc && sc_data(sc, SC_FOGWALL))) {
 		//When Asura fails... (except when it fails from Fog of Wall)
 		//Consume SP/spheres
 		skill->consume_requirement(sd,ud->skill_id, ud->skill_lv,1);
@@ -6844,7 +6844,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 
 	type = skill->get_sc_type(skill_id);
 	tsc = status->get_sc(bl);
-	tsce = (tsc != NULL && type != SC_NONE) ? tsc->data[type] : NULL;
+	tsce = (tsc != NULL && type != SC_NONE) ? sc_data(tsc, type) : NULL;
 
 	if (src != bl && type > SC_NONE
 	 && (element = skill->get_ele(skill_id, skill_lv)) > ELE_NEUTRAL
@@ -6881,9 +6881,9 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 
 				if (tsc && tsc->count)
 				{
-					if (tsc->data[SC_KAITE] && !(sstatus->mode&MD_BOSS))
+					if (sc_data(tsc, SC_KAITE) && !(sstatus->mode&MD_BOSS))
 					{ //Bounce back heal
-						if (--tsc->data[SC_KAITE]->val2 <= 0)
+						if (--sc_data(tsc, SC_KAITE)->val2 <= 0)
 							status_change_end(bl, SC_KAITE, INVALID_TIMER);
 						if (src == bl)
 							heal=0; //When you try to heal yourself under Kaite, the heal is voided.
@@ -6892,14 +6892,14 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 							dstsd = sd;
 						}
 					}
-					else if (tsc->data[SC_BERSERK])
+					else if (sc_data(tsc, SC_BERSERK))
 						heal = 0; //Needed so that it actually displays 0 when healing.
 				}
 				if (skill_id == AL_HEAL) {
 					status_change_end(bl, SC_BITESCAR, INVALID_TIMER);
 				}
 				clif->skill_nodamage (src, bl, skill_id, heal, 1);
-				if( tsc && tsc->data[SC_AKAITSUKI] && heal && skill_id != HLIF_HEAL )
+				if( tsc && sc_data(tsc, SC_AKAITSUKI) && heal && skill_id != HLIF_HEAL )
 					heal = ~heal + 1;
 				heal_get_jobexp = status->heal(bl, heal, 0, STATUS_HEAL_DEFAULT);
 
@@ -6953,7 +6953,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				break;
 			{
 				int per = 0, sper = 0;
-				if (tsc && tsc->data[SC_HELLPOWER])
+				if (tsc && sc_data(tsc, SC_HELLPOWER))
 					break;
 
 				if (map->list[bl->m].flag.pvp && dstsd && dstsd->pvp_point < 0)
@@ -6997,7 +6997,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			break;
 
 		case MER_DECAGI:
-			if( tsc && !tsc->data[SC_ADORAMUS] ) //Prevent duplicate agi-down effect.
+			if( tsc && !sc_data(tsc, SC_ADORAMUS) ) //Prevent duplicate agi-down effect.
 				clif->skill_nodamage(src, bl, skill_id, skill_lv,
 					sc_start(src, bl, type, (40 + skill_lv * 2 + (status->get_lv(src) + sstatus->int_) / 5), skill_lv, skill->get_time(skill_id, skill_lv), skill_id));
 			break;
@@ -7154,9 +7154,9 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 					int i;
 					const enum sc_type scs[] = { SC_QUAGMIRE, SC_PROVOKE, SC_ROKISWEIL, SC_GRAVITATION, SC_NJ_SUITON, SC_NOEQUIPWEAPON, SC_NOEQUIPSHIELD, SC_NOEQUIPARMOR, SC_NOEQUIPHELM, SC_BLADESTOP };
 					for (i = SC_COMMON_MIN; i <= SC_COMMON_MAX; i++)
-						if (tsc->data[i]) status_change_end(bl, (sc_type)i, INVALID_TIMER);
+						if (sc_data(tsc, i)) status_change_end(bl, (sc_type)i, INVALID_TIMER);
 					for (i = 0; i < ARRAYLENGTH(scs); i++)
-						if (tsc->data[scs[i]]) status_change_end(bl, scs[i], INVALID_TIMER);
+						if (sc_data(tsc, scs[i])) status_change_end(bl, scs[i], INVALID_TIMER);
 				}
 			}
 			break;
@@ -7212,12 +7212,12 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				}
 
 				if( sc && tsc ) {
-					if( !sc->data[SC_MARIONETTE_MASTER] && !tsc->data[SC_MARIONETTE] ) {
+					if( !sc_data(sc, SC_MARIONETTE_MASTER) && !sc_data(tsc, SC_MARIONETTE) ) {
 						sc_start(src, src, SC_MARIONETTE_MASTER, 100, bl->id, skill->get_time(skill_id, skill_lv), skill_id);
 						sc_start(src, bl, SC_MARIONETTE, 100, src->id, skill->get_time(skill_id, skill_lv), skill_id);
 						clif->skill_nodamage(src,bl,skill_id,skill_lv,1);
-					} else if( sc->data[SC_MARIONETTE_MASTER ] && sc->data[SC_MARIONETTE_MASTER ]->val1 == bl->id
-					        && tsc->data[SC_MARIONETTE] && tsc->data[SC_MARIONETTE]->val1 == src->id
+					} else if( sc_data(sc, SC_MARIONETTE_MASTER) && sc_data(sc, SC_MARIONETTE_MASTER)->val1 == bl->id
+					        && sc_data(tsc, SC_MARIONETTE) && sc_data(tsc, SC_MARIONETTE)->val1 == src->id
 					) {
 						status_change_end(src, SC_MARIONETTE_MASTER, INVALID_TIMER);
 						status_change_end(bl, SC_MARIONETTE, INVALID_TIMER);
@@ -7241,15 +7241,15 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 		case SA_SEISMICWEAPON:
 			if (dstsd) {
 				if (dstsd->weapontype == W_FIST ||
-					(dstsd->sc.count && !dstsd->sc.data[type] &&
+					(dstsd->sc.count && !sc_data(&dstsd->sc, type) &&
 					( //Allow re-enchanting to lengthen time. [Skotlex]
-						dstsd->sc.data[SC_PROPERTYFIRE] ||
-						dstsd->sc.data[SC_PROPERTYWATER] ||
-						dstsd->sc.data[SC_PROPERTYWIND] ||
-						dstsd->sc.data[SC_PROPERTYGROUND] ||
-						dstsd->sc.data[SC_PROPERTYDARK] ||
-						dstsd->sc.data[SC_PROPERTYTELEKINESIS] ||
-						dstsd->sc.data[SC_ENCHANTPOISON]
+						sc_data(&dstsd->sc, SC_PROPERTYFIRE) ||
+						sc_data(&dstsd->sc, SC_PROPERTYWATER) ||
+						sc_data(&dstsd->sc, SC_PROPERTYWIND) ||
+						sc_data(&dstsd->sc, SC_PROPERTYGROUND) ||
+						sc_data(&dstsd->sc, SC_PROPERTYDARK) ||
+						sc_data(&dstsd->sc, SC_PROPERTYTELEKINESIS) ||
+						sc_data(&dstsd->sc, SC_ENCHANTPOISON)
 					))
 					) {
 					if (sd) clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
@@ -7331,7 +7331,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 		case AL_BLESSING:
 		case MER_INCAGI:
 		case MER_BLESSING:
-			if (dstsd != NULL && tsc->data[SC_PROPERTYUNDEAD]) {
+			if (dstsd != NULL && sc_data(tsc, SC_PROPERTYUNDEAD)) {
 				skill->attack(BF_MISC,src,src,bl,skill_id,skill_lv,tick,flag);
 				break;
 			}
@@ -7511,13 +7511,13 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			break;
 		case AS_ENCHANTPOISON: // Prevent spamming [Valaris]
 			if (sd && dstsd && dstsd->sc.count) {
-				if (dstsd->sc.data[SC_PROPERTYFIRE] ||
-					dstsd->sc.data[SC_PROPERTYWATER] ||
-					dstsd->sc.data[SC_PROPERTYWIND] ||
-					dstsd->sc.data[SC_PROPERTYGROUND] ||
-					dstsd->sc.data[SC_PROPERTYDARK] ||
-					dstsd->sc.data[SC_PROPERTYTELEKINESIS]
-					//dstsd->sc.data[SC_ENCHANTPOISON] //People say you should be able to recast to lengthen the timer. [Skotlex]
+				if (sc_data(&dstsd->sc, SC_PROPERTYFIRE) ||
+					sc_data(&dstsd->sc, SC_PROPERTYWATER) ||
+					sc_data(&dstsd->sc, SC_PROPERTYWIND) ||
+					sc_data(&dstsd->sc, SC_PROPERTYGROUND) ||
+					sc_data(&dstsd->sc, SC_PROPERTYDARK) ||
+					sc_data(&dstsd->sc, SC_PROPERTYTELEKINESIS)
+					//sc_data(&dstsd->sc, SC_ENCHANTPOISON) //People say you should be able to recast to lengthen the timer. [Skotlex]
 				) {
 						clif->skill_nodamage(src,bl,skill_id,skill_lv,0);
 						clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
@@ -7599,7 +7599,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			if( tsc && tsc->count )
 			{
 				status_change_end(bl, SC_FREEZE, INVALID_TIMER);
-				if( tsc->data[SC_STONE] && tsc->opt1 == OPT1_STONE )
+				if( sc_data(tsc, SC_STONE) && tsc->opt1 == OPT1_STONE )
 					status_change_end(bl, SC_STONE, INVALID_TIMER);
 				status_change_end(bl, SC_SLEEP, INVALID_TIMER);
 				status_change_end(bl, SC_TRICKDEAD, INVALID_TIMER);
@@ -7627,10 +7627,10 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				if( (lv = status->get_lv(src) - dstsd->status.base_level) < 0 )
 					lv = -lv;
 				if( lv > battle_config.devotion_level_difference || // Level difference requeriments
-					(dstsd->sc.data[type] && dstsd->sc.data[type]->val1 != src->id) || // Cannot Devote a player devoted from another source
+					(sc_data(&dstsd->sc, type) && sc_data(&dstsd->sc, type)->val1 != src->id) || // Cannot Devote a player devoted from another source
 					(skill_id == ML_DEVOTION && (!mer || mer != dstsd->md)) || // Mercenary only can devote owner
 					(dstsd->job & MAPID_UPPERMASK) == MAPID_CRUSADER || // Crusader Cannot be devoted
-					(dstsd->sc.data[SC_HELLPOWER])) // Players affected by SC_HELLPOWERR cannot be devoted.
+					(sc_data(&dstsd->sc, SC_HELLPOWER))) // Players affected by SC_HELLPOWERR cannot be devoted.
 				{
 					if( sd )
 						clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
@@ -7676,7 +7676,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 					break;
 				}
 
-				if (dstsd->sc.data[type] && dstsd->sc.data[type]->val2 != src->id) { // Fail if a player is in unity with another source.
+				if (sc_data(&dstsd->sc, type) && sc_data(&dstsd->sc, type)->val2 != src->id) { // Fail if a player is in unity with another source.
 					if (sd != NULL)
 						clif->skill_fail(sd, skill_id, USESKILL_FAIL, 0, 0);
 					map->freeblock_unlock();
@@ -7826,7 +7826,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 					sc_start(src, bl, type, 100, skill_lv, skill->get_time(skill_id, skill_lv), skill_id);
 				}
 			}
-			if (skill_id == SJ_STAREMPEROR && sc != NULL && sc->data[SC_DIMENSION] != NULL) {
+			if (skill_id == SJ_STAREMPEROR && sc != NULL && sc_data(sc, SC_DIMENSION) != NULL) {
 				if (sd != NULL) {
 					pc->delspiritball(sd, sd->spiritball, 0);
 					sc_start2(src, bl, SC_DIMENSION1, 100, skill_lv, status_get_max_sp(src), skill->get_time2(SJ_BOOKOFDIMENSION, 1), SJ_BOOKOFDIMENSION);
@@ -7984,12 +7984,12 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			if (sd != NULL) {
 				if (!dstsd ||
 					!(
-						(sd->sc.data[SC_SOULLINK] && sd->sc.data[SC_SOULLINK]->val2 == SL_SOULLINKER)
+						(sc_data(&sd->sc, SC_SOULLINK) && sc_data(&sd->sc, SC_SOULLINK)->val2 == SL_SOULLINKER)
 						|| (dstsd->job & MAPID_UPPERMASK) == MAPID_SOUL_LINKER
 						|| dstsd->status.char_id == sd->status.char_id
 						|| dstsd->status.char_id == sd->status.partner_id
 						|| dstsd->status.char_id == sd->status.child
-						|| (skill_id == SP_KAUTE && dstsd->sc.data[SC_SOULUNITY] != NULL)
+						|| (skill_id == SP_KAUTE && sc_data(&dstsd->sc, SC_SOULUNITY) != NULL)
 					)
 				) {
 					status->change_start(src, src, SC_STUN, 10000, skill_lv, 0, 0, 0, 500, SCFLAG_FIXEDRATE, skill_id);
@@ -8070,7 +8070,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			break;
 
 		case BD_ADAPTATION:
-			if(tsc && tsc->data[SC_DANCING]){
+			if(tsc && sc_data(tsc, SC_DANCING)){
 				clif->skill_nodamage(src,bl,skill_id,skill_lv,1);
 				status_change_end(bl, SC_DANCING, INVALID_TIMER);
 			}
@@ -8142,10 +8142,10 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				if(status->isimmune(bl) || !tsc)
 					break;
 
-				if (sd && sd->sc.data[SC_PETROLOGY_OPTION])
-					brate = sd->sc.data[SC_PETROLOGY_OPTION]->val3;
+				if (sd && sc_data(&sd->sc, SC_PETROLOGY_OPTION))
+					brate = sc_data(&sd->sc, SC_PETROLOGY_OPTION)->val3;
 
-				if (tsc->data[SC_STONE]) {
+				if (sc_data(tsc, SC_STONE)) {
 					status_change_end(bl, SC_STONE, INVALID_TIMER);
 					clif->skill_nodamage(src,bl,skill_id,skill_lv,1);
 					break;
@@ -8441,7 +8441,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			}
 
 			//Special message when trying to use strip on FCP [Jobbie]
-			if( sd && skill_id == ST_FULLSTRIP && tsc && tsc->data[SC_PROTECTWEAPON] && tsc->data[SC_PROTECTHELM] && tsc->data[SC_PROTECTARMOR] && tsc->data[SC_PROTECTSHIELD])
+			if( sd && skill_id == ST_FULLSTRIP && tsc && sc_data(tsc, SC_PROTECTWEAPON) && sc_data(tsc, SC_PROTECTHELM) && sc_data(tsc, SC_PROTECTARMOR) && sc_data(tsc, SC_PROTECTSHIELD))
 			{
 				clif->gospel_info(sd, 0x28);
 				break;
@@ -8500,7 +8500,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 					script->potion_target = bl->id;
 					script->run_use_script(sd, sd->inventory_data[inventory_idx], 0);
 					script->potion_flag = script->potion_target = 0;
-					if( sd->sc.data[SC_SOULLINK] && sd->sc.data[SC_SOULLINK]->val2 == SL_ALCHEMIST )
+					if( sc_data(&sd->sc, SC_SOULLINK) && sc_data(&sd->sc, SC_SOULLINK)->val2 == SL_ALCHEMIST )
 						bonus += sd->status.base_level;
 					if( script->potion_per_hp > 0 || script->potion_per_sp > 0 ) {
 						hp = tstatus->max_hp * script->potion_per_hp / 100;
@@ -8554,19 +8554,19 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 					sp += sp * i / 100;
 				}
 				if( tsc && tsc->count ) {
-					if( tsc->data[SC_CRITICALWOUND] ) {
-						hp -= hp * tsc->data[SC_CRITICALWOUND]->val2 / 100;
-						sp -= sp * tsc->data[SC_CRITICALWOUND]->val2 / 100;
+					if( sc_data(tsc, SC_CRITICALWOUND) ) {
+						hp -= hp * sc_data(tsc, SC_CRITICALWOUND)->val2 / 100;
+						sp -= sp * sc_data(tsc, SC_CRITICALWOUND)->val2 / 100;
 					}
-					if( tsc->data[SC_DEATHHURT] ) {
+					if( sc_data(tsc, SC_DEATHHURT) ) {
 						hp -= hp * 20 / 100;
 						sp -= sp * 20 / 100;
 					}
-					if( tsc->data[SC_WATER_INSIGNIA] && tsc->data[SC_WATER_INSIGNIA]->val1 == 2 ) {
+					if( sc_data(tsc, SC_WATER_INSIGNIA) && sc_data(tsc, SC_WATER_INSIGNIA)->val1 == 2 ) {
 						hp += hp / 10;
 						sp += sp / 10;
 					}
-					if (tsc->data[SC_NO_RECOVER_STATE]) {
+					if (sc_data(tsc, SC_NO_RECOVER_STATE)) {
 						hp = 0;
 						sp = 0;
 					}
@@ -8578,10 +8578,10 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 					clif->skill_nodamage(NULL,bl,MG_SRECOVERY,sp,1);
 				if (tsc) {
 #ifdef RENEWAL
-					if (tsc->data[SC_EXTREMITYFIST2])
+					if (sc_data(tsc, SC_EXTREMITYFIST2))
 						sp = 0;
 #endif
-					if (tsc->data[SC_NO_RECOVER_STATE]) {
+					if (sc_data(tsc, SC_NO_RECOVER_STATE)) {
 						hp = 0;
 						sp = 0;
 					}
@@ -8657,7 +8657,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				}
 				clif->skill_nodamage(src,bl,skill_id,skill_lv,1);
 				if ((dstsd != NULL && (dstsd->job & MAPID_UPPERMASK) == MAPID_SOUL_LINKER)
-					|| (tsc && tsc->data[SC_SOULLINK] && tsc->data[SC_SOULLINK]->val2 == SL_ROGUE) //Rogue's spirit defends against dispel.
+					|| (tsc && sc_data(tsc, SC_SOULLINK) && sc_data(tsc, SC_SOULLINK)->val2 == SL_ROGUE) //Rogue's spirit defends against dispel.
 					|| (dstsd && pc_ismadogear(dstsd))
 					|| rnd()%100 >= 50+10*skill_lv )
 				{
@@ -8667,9 +8667,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				}
 				if(status->isimmune(bl) || !tsc || !tsc->count)
 					break;
-				for(i = 0; i < SC_MAX; i++) {
-					if ( !tsc->data[i] )
-							continue;
+				for (i = sc_next(tsc, SC_NONE); i < SC_MAX; i = sc_next(tsc, i)) {
 					if( SC_COMMON_MAX < i ) {
 						if ( status->get_sc_type(i)&SC_NO_DISPELL )
 							continue;
@@ -8686,7 +8684,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 						case SC_DONTFORGETME:
 						case SC_FORTUNE:
 						case SC_SERVICEFORYOU:
-							if( tsc->data[i]->val4 ) //val4 = out-of-song-area
+							if( sc_data(tsc, i)->val4 ) //val4 = out-of-song-area
 								continue;
 							break;
 						case SC_ASSUMPTIO:
@@ -8695,7 +8693,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 							break;
 						case SC_BERSERK:
 						case SC_SATURDAY_NIGHT_FEVER:
-							tsc->data[i]->val2=0;  //Mark a dispelled berserk to avoid setting hp to 100 by setting hp penalty to 0.
+							sc_data(tsc, i)->val2=0;  //Mark a dispelled berserk to avoid setting hp to 100 by setting hp penalty to 0.
 							break;
 					}
 					status_change_end(bl, (sc_type)i, INVALID_TIMER);
@@ -8760,9 +8758,9 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 		case SA_SPELLBREAKER:
 			{
 				int sp;
-				if(tsc && tsc->data[SC_MAGICROD]) {
+				if(tsc && sc_data(tsc, SC_MAGICROD)) {
 					sp = skill->get_sp(skill_id,skill_lv);
-					sp = sp * tsc->data[SC_MAGICROD]->val2 / 100;
+					sp = sp * sc_data(tsc, SC_MAGICROD)->val2 / 100;
 					if(sp < 1) sp = 1;
 					status->heal(bl, 0, sp, STATUS_HEAL_SHOWEFFECT);
 					status_percent_damage(bl, src, 0, -20, false); //20% max SP damage.
@@ -9196,7 +9194,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 
 				if(tsc && tsc->count){
 					status_change_end(bl, SC_FREEZE, INVALID_TIMER);
-					if(tsc->data[SC_STONE] && tsc->opt1 == OPT1_STONE)
+					if(sc_data(tsc, SC_STONE) && tsc->opt1 == OPT1_STONE)
 						status_change_end(bl, SC_STONE, INVALID_TIMER);
 					status_change_end(bl, SC_SLEEP, INVALID_TIMER);
 				}
@@ -9222,7 +9220,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 					clif->skill_nodamage(src,bl,skill_id,skill_lv,1);
 					break;
 				} else if (dstsd != NULL) {
-					if (tsc != NULL && tsc->data[SC_BERSERK] != NULL)
+					if (tsc != NULL && sc_data(tsc, SC_BERSERK) != NULL)
 						break; // [Aegis] can't use on berserked players.
 				}
 				sp1 = sstatus->sp;
@@ -9230,10 +9228,10 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 #ifdef RENEWAL
 				sp1 = sp1 / 2;
 				sp2 = sp2 / 2;
-				if (tsc && tsc->data[SC_EXTREMITYFIST2])
+				if (tsc && sc_data(tsc, SC_EXTREMITYFIST2))
 					sp1 = tstatus->sp;
 #endif // RENEWAL
-				if (tsc && tsc->data[SC_NO_RECOVER_STATE])
+				if (tsc && sc_data(tsc, SC_NO_RECOVER_STATE))
 					sp1 = tstatus->sp;
 				status->set_sp(src, sp2, STATUS_HEAL_FORCED | STATUS_HEAL_SHOWEFFECT);
 				status->set_sp(bl, sp1, STATUS_HEAL_FORCED | STATUS_HEAL_SHOWEFFECT);
@@ -9257,19 +9255,19 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 						sp = sp * (100 + pc->checkskill(dstsd,MG_SRECOVERY)*10 + pc->skillheal2_bonus(dstsd, skill_id))/100;
 				}
 				if( tsc && tsc->count ) {
-					if (tsc->data[SC_CRITICALWOUND]) {
-						hp -= hp * tsc->data[SC_CRITICALWOUND]->val2 / 100;
-						sp -= sp * tsc->data[SC_CRITICALWOUND]->val2 / 100;
+					if (sc_data(tsc, SC_CRITICALWOUND)) {
+						hp -= hp * sc_data(tsc, SC_CRITICALWOUND)->val2 / 100;
+						sp -= sp * sc_data(tsc, SC_CRITICALWOUND)->val2 / 100;
 					}
-					if (tsc->data[SC_DEATHHURT]) {
+					if (sc_data(tsc, SC_DEATHHURT)) {
 						hp -= hp * 20 / 100;
 						sp -= sp * 20 / 100;
 					}
-					if( tsc->data[SC_WATER_INSIGNIA] && tsc->data[SC_WATER_INSIGNIA]->val1 == 2) {
+					if( sc_data(tsc, SC_WATER_INSIGNIA) && sc_data(tsc, SC_WATER_INSIGNIA)->val1 == 2) {
 						hp += hp / 10;
 						sp += sp / 10;
 					}
-					if (tsc->data[SC_NO_RECOVER_STATE]) {
+					if (sc_data(tsc, SC_NO_RECOVER_STATE)) {
 						hp = 0;
 						sp = 0;
 					}
@@ -9312,7 +9310,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 
 		case CG_LONGINGFREEDOM:
 			{
-				if (tsc && !tsce && (tsce=tsc->data[SC_DANCING]) != NULL && tsce->val4
+				if (tsc && !tsce && (tsce=sc_data(tsc, SC_DANCING)) != NULL && tsce->val4
 					&& (tsce->val1&0xFFFF) != CG_MOONLIT) //Can't use Longing for Freedom while under Moonlight Petals. [Skotlex]
 				{
 					clif->skill_nodamage(src,bl,skill_id,skill_lv,
@@ -9324,7 +9322,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 		case CG_TAROTCARD:
 			{
 				int count = -1;
-				if (tsc && tsc->data[type]) {
+				if (tsc && sc_data(tsc, type)) {
 					map->freeblock_unlock();
 					return 0;
 				}
@@ -9443,10 +9441,10 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 		case SL_SUPERNOVICE:
 		case SL_WIZARD:
 			if (sd != NULL && tsc != NULL &&
-				(tsc->data[SC_SOULGOLEM] ||
-				tsc->data[SC_SOULSHADOW] ||
-				tsc->data[SC_SOULFALCON] ||
-				tsc->data[SC_SOULFAIRY])
+				(sc_data(tsc, SC_SOULGOLEM) ||
+				sc_data(tsc, SC_SOULSHADOW) ||
+				sc_data(tsc, SC_SOULFALCON) ||
+				sc_data(tsc, SC_SOULFAIRY))
 			) { // Soul links from Soul Linker and Soul Reaper skills don't stack.
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL, 0, 0);
 				break;
@@ -9469,10 +9467,10 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			break;
 		case SL_HIGH:
 			if (sd != NULL && tsc != NULL &&
-				(tsc->data[SC_SOULGOLEM] != NULL ||
-				tsc->data[SC_SOULSHADOW] != NULL ||
-				tsc->data[SC_SOULFALCON] != NULL ||
-				tsc->data[SC_SOULFAIRY] != NULL)
+				(sc_data(tsc, SC_SOULGOLEM) != NULL ||
+				sc_data(tsc, SC_SOULSHADOW) != NULL ||
+				sc_data(tsc, SC_SOULFALCON) != NULL ||
+				sc_data(tsc, SC_SOULFAIRY) != NULL)
 			) { // Soul links from Soul Linker and Soul Reaper skills don't stack.
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL, 0, 0);
 				break;
@@ -9495,15 +9493,15 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				break;
 			}
 			if (tsc != NULL) {
-				if (tsc->data[skill->get_sc_type(skill_id)]) { // Allow refreshing an already active soul link.
+				if (sc_data(tsc, skill->get_sc_type(skill_id))) { // Allow refreshing an already active soul link.
 					clif->skill_nodamage(src, bl, skill_id, skill_lv, sc_start(src, bl, type, 100, skill_lv, skill->get_time(skill_id, skill_lv), skill_id));
 					break;
 				} else if (
-					(tsc->data[SC_SOULLINK] != NULL ||
-					tsc->data[SC_SOULGOLEM] != NULL ||
-					tsc->data[SC_SOULSHADOW] != NULL ||
-					tsc->data[SC_SOULFALCON] != NULL ||
-					tsc->data[SC_SOULFAIRY] != NULL)
+					(sc_data(tsc, SC_SOULLINK) != NULL ||
+					sc_data(tsc, SC_SOULGOLEM) != NULL ||
+					sc_data(tsc, SC_SOULSHADOW) != NULL ||
+					sc_data(tsc, SC_SOULFALCON) != NULL ||
+					sc_data(tsc, SC_SOULFAIRY) != NULL)
 				) { // Soul links from Soul Linker and Soul Reaper skills don't stack.
 					clif->skill_fail(sd, skill_id, USESKILL_FAIL, 0, 0);
 					break;
@@ -9514,11 +9512,11 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 
 		case SP_SOULREVOLVE:
 			if (!(tsc != NULL &&
-				(tsc->data[SC_SOULLINK] != NULL ||
-				tsc->data[SC_SOULGOLEM] != NULL ||
-				tsc->data[SC_SOULSHADOW] != NULL ||
-				tsc->data[SC_SOULFALCON] != NULL ||
-				tsc->data[SC_SOULFAIRY] != NULL)
+				(sc_data(tsc, SC_SOULLINK) != NULL ||
+				sc_data(tsc, SC_SOULGOLEM) != NULL ||
+				sc_data(tsc, SC_SOULSHADOW) != NULL ||
+				sc_data(tsc, SC_SOULFALCON) != NULL ||
+				sc_data(tsc, SC_SOULFAIRY) != NULL)
 			)) {
 				if (sd != NULL)
 					clif->skill_fail(sd, skill_id, USESKILL_FAIL, 0, 0);
@@ -9972,17 +9970,17 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				}
 			}else if( sd ){
 				if( tsc && tsc->count ){
-					if(tsc->data[SC_MILLENNIUMSHIELD])
+					if(sc_data(tsc, SC_MILLENNIUMSHIELD))
 						skill->area_temp[5] |= 0x10;
-					if(tsc->data[SC_REFRESH])
+					if(sc_data(tsc, SC_REFRESH))
 						skill->area_temp[5] |= 0x20;
-					if(tsc->data[SC_GIANTGROWTH])
+					if(sc_data(tsc, SC_GIANTGROWTH))
 						skill->area_temp[5] |= 0x40;
-					if(tsc->data[SC_STONEHARDSKIN])
+					if(sc_data(tsc, SC_STONEHARDSKIN))
 						skill->area_temp[5] |= 0x80;
-					if(tsc->data[SC_VITALITYACTIVATION])
+					if(sc_data(tsc, SC_VITALITYACTIVATION))
 						skill->area_temp[5] |= 0x100;
-					if(tsc->data[SC_ABUNDANCE])
+					if(sc_data(tsc, SC_ABUNDANCE))
 						skill->area_temp[5] |= 0x200;
 				}
 				clif->skill_nodamage(src, bl, skill_id, skill_lv, 1);
@@ -9997,9 +9995,9 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				short count = 1;
 				skill->area_temp[2] = 0;
 				map->foreachinrange(skill->area_sub,src,skill->get_splash(skill_id,skill_lv),BL_CHAR,src,skill_id,skill_lv,tick,flag|BCT_ENEMY|SD_PREAMBLE|SD_SPLASH|1,skill->castend_damage_id);
-				if( tsc && tsc->data[SC_ROLLINGCUTTER] )
+				if( tsc && sc_data(tsc, SC_ROLLINGCUTTER) )
 				{ // Every time the skill is casted the status change is reseted adding a counter.
-					count += (short)tsc->data[SC_ROLLINGCUTTER]->val1;
+					count += (short)sc_data(tsc, SC_ROLLINGCUTTER)->val1;
 					if( count > 10 )
 						count = 10; // Max counter
 					status_change_end(bl, SC_ROLLINGCUTTER, INVALID_TIMER);
@@ -10010,7 +10008,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			break;
 
 		case GC_WEAPONBLOCKING:
-			if( tsc && tsc->data[SC_WEAPONBLOCKING] )
+			if( tsc && sc_data(tsc, SC_WEAPONBLOCKING) )
 				status_change_end(bl, SC_WEAPONBLOCKING, INVALID_TIMER);
 			else
 				sc_start(src, bl, SC_WEAPONBLOCKING, 100, skill_lv, skill->get_time(skill_id, skill_lv), skill_id);
@@ -10117,7 +10115,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			break;
 		case AB_CHEAL:
 			if( sd == NULL || sd->status.party_id == 0 || flag&1 ) {
-				if (sd && tstatus && !battle->check_undead(tstatus->race, tstatus->def_ele) && !(tsc && tsc->data[SC_BERSERK])) {
+				if (sd && tstatus && !battle->check_undead(tstatus->race, tstatus->def_ele) && !(tsc && sc_data(tsc, SC_BERSERK))) {
 					int lv = pc->checkskill(sd, AL_HEAL);
 					int heal = skill->calc_heal(src, bl, AL_HEAL, lv, true);
 
@@ -10130,7 +10128,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 						heal = 0;
 
 					clif->skill_nodamage(bl, bl, skill_id, heal, 1);
-					if( tsc && tsc->data[SC_AKAITSUKI] && heal )
+					if( tsc && sc_data(tsc, SC_AKAITSUKI) && heal )
 						heal = ~heal + 1;
 					status->heal(bl, heal, 0, STATUS_HEAL_FORCED);
 				}
@@ -10149,8 +10147,8 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 
 		case AB_LAUDAAGNUS:
 			if( (flag&1 || sd == NULL) || !sd->status.party_id) {
-				if( tsc && (tsc->data[SC_FREEZE] || tsc->data[SC_STONE] || tsc->data[SC_BLIND] ||
-					tsc->data[SC_BURNING] || tsc->data[SC_FROSTMISTY] || tsc->data[SC_COLD])) {
+				if( tsc && (sc_data(tsc, SC_FREEZE) || sc_data(tsc, SC_STONE) || sc_data(tsc, SC_BLIND) ||
+					sc_data(tsc, SC_BURNING) || sc_data(tsc, SC_FROSTMISTY) || sc_data(tsc, SC_COLD))) {
 					// Success Chance: (40 + 10 * Skill Level) %
 					if( rnd()%100 > 40+10*skill_lv ) break;
 					status_change_end(bl, SC_FREEZE, INVALID_TIMER);
@@ -10169,8 +10167,8 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 
 		case AB_LAUDARAMUS:
 			if( (flag&1 || sd == NULL) || !sd->status.party_id ) {
-				if( tsc && (tsc->data[SC_SLEEP] || tsc->data[SC_STUN] || tsc->data[SC_MANDRAGORA] ||
-					tsc->data[SC_SILENCE] || tsc->data[SC_DEEP_SLEEP]) ){
+				if( tsc && (sc_data(tsc, SC_SLEEP) || sc_data(tsc, SC_STUN) || sc_data(tsc, SC_MANDRAGORA) ||
+					sc_data(tsc, SC_SILENCE) || sc_data(tsc, SC_DEEP_SLEEP)) ){
 					// Success Chance: (40 + 10 * Skill Level) %
 					if( rnd()%100 > 40+10*skill_lv )  break;
 					status_change_end(bl, SC_SLEEP, INVALID_TIMER);
@@ -10204,9 +10202,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				}
 				if(status->isimmune(bl) || !tsc || !tsc->count)
 					break;
-				for(i = 0; i < SC_MAX; i++) {
-					if ( !tsc->data[i] )
-						continue;
+				for (i = sc_next(tsc, SC_NONE); i < SC_MAX; i = sc_next(tsc, i)) {
 					if (status->get_sc_type(i)&SC_NO_CLEARANCE)
 						continue;
 					PRAGMA_GCC46(GCC diagnostic push)
@@ -10218,7 +10214,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 							break;
 						case SC_BERSERK:
 						case SC_SATURDAY_NIGHT_FEVER:
-							tsc->data[i]->val2=0;  //Mark a dispelled berserk to avoid setting hp to 100 by setting hp penalty to 0.
+							sc_data(tsc, i)->val2=0;  //Mark a dispelled berserk to avoid setting hp to 100 by setting hp penalty to 0.
 							break;
 					}
 					PRAGMA_GCC46(GCC diagnostic pop)
@@ -10261,7 +10257,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				if( sd )
 					skill->blockpc_start(sd,skill_id,4000);
 
-				if( !(tsc && tsc->data[type]) ){
+				if( !(tsc && sc_data(tsc, type)) ){
 					int failure = sc_start2(src, bl, type, rate, skill_lv, src->id, (src == bl) ? 5000 : (bl->type == BL_PC) ? skill->get_time(skill_id, skill_lv) : skill->get_time2(skill_id, skill_lv), skill_id);
 					clif->skill_nodamage(src,bl,skill_id,skill_lv,failure);
 					if( sd && !failure )
@@ -10295,7 +10291,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			if( flag&1 ) {
 				if( status->isimmune(bl) || !tsc )
 					break;
-				if( tsc && tsc->data[SC_STONE] )
+				if( tsc && sc_data(tsc, SC_STONE) )
 					status_change_end(bl,SC_STONE,INVALID_TIMER);
 				else
 					status->change_start(src, bl, SC_STONE, 10000, skill_lv, 0, 0, 500, skill->get_time(skill_id, skill_lv), SCFLAG_FIXEDTICK, skill_id);
@@ -10316,7 +10312,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 		{
 			int i;
 			for( i = SC_SUMMON1; i <= SC_SUMMON5; i++ ){
-				if( tsc && !tsc->data[i] ){ // officially it doesn't work like a stack
+				if( tsc && !sc_data(tsc, i) ){ // officially it doesn't work like a stack
 					int ele = WLS_FIRE + (skill_id - WL_SUMMONFB) - (skill_id == WL_SUMMONSTONE ? 4 : 0);
 					clif->skill_nodamage(src, bl, skill_id, skill_lv,
 						sc_start(src, bl, (sc_type)i, 100, ele, skill->get_time(skill_id, skill_lv), skill_id));
@@ -10332,7 +10328,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				int i;
 
 				for( i = SC_SPELLBOOK1; i <= SC_SPELLBOOK7; i++)
-					if( sc && !sc->data[i] )
+					if( sc && !sc_data(sc, i) )
 						break;
 				if( i == SC_SPELLBOOK7 ) {
 					clif->skill_fail(sd, WL_READING_SB, USESKILL_FAIL_SPELLBOOK_READING, 0, 0);
@@ -10494,8 +10490,8 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 
 		case SC_BODYPAINT:
 			if( flag&1 ) {
-				if( tsc && (tsc->data[SC_HIDING] || tsc->data[SC_CLOAKING] ||
-							tsc->data[SC_CHASEWALK] || tsc->data[SC_CLOAKINGEXCEED] ) ) {
+				if( tsc && (sc_data(tsc, SC_HIDING) || sc_data(tsc, SC_CLOAKING) ||
+							sc_data(tsc, SC_CHASEWALK) || sc_data(tsc, SC_CLOAKINGEXCEED) ) ) {
 					status_change_end(bl, SC_HIDING, INVALID_TIMER);
 					status_change_end(bl, SC_CLOAKING, INVALID_TIMER);
 					status_change_end(bl, SC_CHASEWALK, INVALID_TIMER);
@@ -10518,7 +10514,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 		case SC_LAZINESS:
 		case SC_UNLUCKY:
 		case SC_WEAKNESS:
-			if( !(tsc && tsc->data[type]) ) {
+			if( !(tsc && sc_data(tsc, type)) ) {
 				int joblvbonus = 0;
 				int rate = 0;
 				if (is_boss(bl)) break;
@@ -10530,14 +10526,14 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				//Finally we set the minimum success chance cap based on the caster's skill level and DEX.
 				rate = cap_value( rate, skill_lv + sstatus->dex / 20, 100);
 				clif->skill_nodamage(src, bl, skill_id, 0, sc_start(src, bl, type, rate, skill_lv, skill->get_time(skill_id, skill_lv), skill_id));
-				if ( tsc && tsc->data[SC__IGNORANCE] && skill_id == SC_IGNORANCE) {
+				if ( tsc && sc_data(tsc, SC__IGNORANCE) && skill_id == SC_IGNORANCE) {
 					//If the target was successfully inflected with the Ignorance status, drain some of the targets SP.
 					int sp = 100 * skill_lv;
 					if( dstmd ) sp = dstmd->level * 2;
 					if( status_zap(bl,0,sp) )
 						status->heal(src, 0, sp / 2, STATUS_HEAL_FORCED | STATUS_HEAL_SHOWEFFECT);
 				}
-				if ( tsc && tsc->data[SC__UNLUCKY] && skill_id == SC_UNLUCKY) {
+				if ( tsc && sc_data(tsc, SC__UNLUCKY) && skill_id == SC_UNLUCKY) {
 					//If the target was successfully inflected with the Unlucky status, give 1 of 3 random status's.
 					switch(rnd()%3) {//Targets in the Unlucky status will be affected by one of the 3 random status's regardless of resistance.
 						case 0:
@@ -10561,7 +10557,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			break;
 
 		case LG_REFLECTDAMAGE:
-			if( tsc && tsc->data[type] )
+			if( tsc && sc_data(tsc, type) )
 				status_change_end(bl,type,INVALID_TIMER);
 			else
 				sc_start(src, bl, type, 100, skill_lv, skill->get_time(skill_id, skill_lv), skill_id);
@@ -10683,10 +10679,8 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			if( flag&1 ){
 				int i;
 				sc_start(src, bl, type, 100, skill_lv, skill->get_time(skill_id, skill_lv), skill_id);
-				for(i=0; i<SC_MAX; i++)
+				for (i = sc_next(tsc, SC_NONE); i < SC_MAX; i = sc_next(tsc, i))
 				{
-					if (!tsc->data[i])
-					continue;
 					switch(i){
 						case SC_POISON:
 						case SC_BLIND:
@@ -10911,7 +10905,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			break;
 
 		case WM_GLOOMYDAY:
-			if ( tsc && tsc->data[type] ) {
+			if ( tsc && sc_data(tsc, type) ) {
 				 clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				break;
 			}
@@ -11239,7 +11233,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				struct status_change *sc = status->get_sc(src);
 
 				if( sc && sc->bs_counter < skill->get_maxcount( skill_id , skill_lv) ) {
-					if( tsc && tsc->data[type] ){
+					if( tsc && sc_data(tsc, type) ){
 						(sc->bs_counter)--;
 						status_change_end(src, type, INVALID_TIMER); // the first one cancels and the last one will take effect resetting the timer
 					}
@@ -11340,7 +11334,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				sc_type type2 = type-1;
 				struct status_change *sc = status->get_sc(&ele->bl);
 
-				if( (sc && sc->data[type2]) || (tsc && tsc->data[type]) ) {
+				if( (sc && sc_data(sc, type2)) || (tsc && sc_data(tsc, type)) ) {
 					elemental->clean_single_effect(ele, skill_id);
 				} else {
 					clif->skill_nodamage(src,src,skill_id,skill_lv,1);
@@ -11371,7 +11365,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 				sc_type type2 = type-1;
 
 				clif->skill_nodamage(src,src,skill_id,skill_lv,1);
-				if( (sc && sc->data[type2]) || (tsc && tsc->data[type]) ) {
+				if( (sc && sc_data(sc, type2)) || (tsc && sc_data(tsc, type)) ) {
 					elemental->clean_single_effect(ele, skill_id);
 				} else {
 					// This not heals at the end.
@@ -11428,7 +11422,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			break;
 
 		case KO_JYUSATSU:
-			if( dstsd && tsc && !tsc->data[type]
+			if( dstsd && tsc && !sc_data(tsc, type)
 			 && rnd()%100 < (10 * (5 * skill_lv - status_get_int(bl) / 2 + 45 + 5 * skill_lv))
 			) {
 				clif->skill_nodamage(src, bl, skill_id, skill_lv,
@@ -11487,8 +11481,8 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 		case KG_KAGEHUMI:
 			if( flag&1 ){
 				if (tsc && (tsc->option & (OPTION_CLOAK | OPTION_HIDE) ||
-				    tsc->data[SC_CAMOUFLAGE] || tsc->data[SC__SHADOWFORM] ||
-				    tsc->data[SC_MARIONETTE_MASTER] || tsc->data[SC_HARMONIZE])) {
+				    sc_data(tsc, SC_CAMOUFLAGE) || sc_data(tsc, SC__SHADOWFORM) ||
+				    sc_data(tsc, SC_MARIONETTE_MASTER) || sc_data(tsc, SC_HARMONIZE))) {
 					sc_start(src, src, type, 100, skill_lv, skill->get_time(skill_id, skill_lv), skill_id);
 					sc_start(src, bl, type, 100, skill_lv, skill->get_time(skill_id, skill_lv), skill_id);
 					status_change_end(bl, SC_HIDING, INVALID_TIMER);
@@ -11536,7 +11530,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 			if(tsc){
 				int i;
 				for (i = 0; i < ARRAYLENGTH(scs); i++) {
-					if (tsc->data[scs[i]]) status_change_end(bl, scs[i], INVALID_TIMER);
+					if (sc_data(tsc, scs[i])) status_change_end(bl, scs[i], INVALID_TIMER);
 				}
 			}
 			heal = 5 * status->get_lv(&hd->bl) + status->base_matk(&hd->bl, &hd->battle_status, status->get_lv(&hd->bl));
@@ -11710,7 +11704,7 @@ static int skill_castend_nodamage_id(struct block_list *src, struct block_list *
 
 	if(skill_id != SR_CURSEDCIRCLE) {
 		struct status_change *sc = status->get_sc(src);
-		if( sc && sc->data[SC_CURSEDCIRCLE_ATKER] )//Should only remove after the skill had been casted.
+		if( sc && sc_data(sc, SC_CURSEDCIRCLE_ATKER) )//Should only remove after the skill had been casted.
 			status_change_end(src,SC_CURSEDCIRCLE_ATKER,INVALID_TIMER);
 	}
 
@@ -11862,7 +11856,9 @@ static int skill_castend_pos(int tid, int64 tick, int id, intptr_t data)
 			break;
 
 		if(md) {
-			md->last_thinktime=tick +MIN_MOBTHINKTIME;
+			struct mob_ai_hot *hot = mob_ai_hot(md);
+			if (hot != NULL)
+				hot->last_thinktime=tick +MIN_MOBTHINKTIME;
 			if(md->skill_idx >= 0 && md->db->skill[md->skill_idx].emotion >= 0)
 				clif->emotion(src, md->db->skill[md->skill_idx].emotion);
 		}
@@ -11976,21 +11972,21 @@ static int skill_castend_map(struct map_session_data *sd, uint16 skill_id, const
 		return 0;
 	}
 	if(sd->sc.count && (
-		sd->sc.data[SC_SILENCE] ||
-		sd->sc.data[SC_ROKISWEIL] ||
-		sd->sc.data[SC_AUTOCOUNTER] ||
-		sd->sc.data[SC_STEELBODY] ||
-		(sd->sc.data[SC_DANCING] && skill_id < RK_ENCHANTBLADE && !pc->checkskill(sd, WM_LESSON)) ||
-		sd->sc.data[SC_BERSERK] ||
-		sd->sc.data[SC_BASILICA] ||
-		sd->sc.data[SC_MARIONETTE_MASTER] ||
-		sd->sc.data[SC_WHITEIMPRISON] ||
-		(sd->sc.data[SC_STASIS] && skill->block_check(&sd->bl, SC_STASIS, skill_id)) ||
-		(sd->sc.data[SC_KG_KAGEHUMI] && skill->block_check(&sd->bl, SC_KG_KAGEHUMI, skill_id)) ||
-		sd->sc.data[SC_OBLIVIONCURSE] ||
-		sd->sc.data[SC__MANHOLE] ||
-		sd->sc.data[SC_GRAVITYCONTROL] ||
-		(sd->sc.data[SC_VOLCANIC_ASH] && rnd()%2) //50% fail chance under ASH
+		sc_data(&sd->sc, SC_SILENCE) ||
+		sc_data(&sd->sc, SC_ROKISWEIL) ||
+		sc_data(&sd->sc, SC_AUTOCOUNTER) ||
+		sc_data(&sd->sc, SC_STEELBODY) ||
+		(sc_data(&sd->sc, SC_DANCING) && skill_id < RK_ENCHANTBLADE && !pc->checkskill(sd, WM_LESSON)) ||
+		sc_data(&sd->sc, SC_BERSERK) ||
+		sc_data(&sd->sc, SC_BASILICA) ||
+		sc_data(&sd->sc, SC_MARIONETTE_MASTER) ||
+		sc_data(&sd->sc, SC_WHITEIMPRISON) ||
+		(sc_data(&sd->sc, SC_STASIS) && skill->block_check(&sd->bl, SC_STASIS, skill_id)) ||
+		(sc_data(&sd->sc, SC_KG_KAGEHUMI) && skill->block_check(&sd->bl, SC_KG_KAGEHUMI, skill_id)) ||
+		sc_data(&sd->sc, SC_OBLIVIONCURSE) ||
+		sc_data(&sd->sc, SC__MANHOLE) ||
+		sc_data(&sd->sc, SC_GRAVITYCONTROL) ||
+		(sc_data(&sd->sc, SC_VOLCANIC_ASH) && rnd()%2) //50% fail chance under ASH
 	 )) {
 		skill_failed(sd);
 		return 0;
@@ -12125,7 +12121,7 @@ static int skill_castend_pos2(struct block_list *src, int x, int y, uint16 skill
 
 	sc = status->get_sc(src);
 	type = skill->get_sc_type(skill_id);
-	sce = (sc != NULL && type != SC_NONE) ? sc->data[type] : NULL;
+	sce = (sc != NULL && type != SC_NONE) ? sc_data(sc, type) : NULL;
 
 	PRAGMA_GCC46(GCC diagnostic push)
 	PRAGMA_GCC46(GCC diagnostic ignored "-Wswitch-enum")
@@ -12350,7 +12346,7 @@ static int skill_castend_pos2(struct block_list *src, int x, int y, uint16 skill
 			flag|=1;
 			break;
 		case HP_BASILICA:
-			if( sc && sc->data[SC_BASILICA] )
+			if( sc && sc_data(sc, SC_BASILICA) )
 				status_change_end(src, SC_BASILICA, INVALID_TIMER); // Cancel Basilica
 			else { // Create Basilica. Start SC on caster. Unit timer start SC on others.
 				if( map->foreachinrange(skill->count_wos, src, 2, BL_MOB|BL_PC, src) ) {
@@ -12429,7 +12425,7 @@ static int skill_castend_pos2(struct block_list *src, int x, int y, uint16 skill
 					(skill_lv >= 4) ? sd->status.memo_point[2].map : 0
 				);
 			}
-			if( sc && sc->data[SC_CURSEDCIRCLE_ATKER] ) //Should only remove after the skill has been casted.
+			if( sc && sc_data(sc, SC_CURSEDCIRCLE_ATKER) ) //Should only remove after the skill has been casted.
 				status_change_end(src,SC_CURSEDCIRCLE_ATKER,INVALID_TIMER);
 			return 0; // not to consume item.
 
@@ -12684,7 +12680,7 @@ static int skill_castend_pos2(struct block_list *src, int x, int y, uint16 skill
 		 * Guilotine Cross
 		 **/
 		case GC_POISONSMOKE:
-			if( !(sc && sc->data[SC_POISONINGWEAPON]) ) {
+			if( !(sc && sc_data(sc, SC_POISONINGWEAPON)) ) {
 				if( sd )
 					clif->skill_fail(sd, skill_id, USESKILL_FAIL_GC_POISONINGWEAPON, 0, 0);
 				return 0;
@@ -12779,7 +12775,7 @@ static int skill_castend_pos2(struct block_list *src, int x, int y, uint16 skill
 			break;
 
 		case LG_BANDING:
-			if( sc && sc->data[SC_BANDING] )
+			if( sc && sc_data(sc, SC_BANDING) )
 				status_change_end(src,SC_BANDING,INVALID_TIMER);
 			else if( (sg = skill->unitsetting(src,skill_id,skill_lv,src->x,src->y,0)) != NULL ) {
 				sc_start4(src, src, SC_BANDING, 100, skill_lv, 0, 0, sg->group_id, skill->get_time(skill_id, skill_lv), skill_id);
@@ -12924,7 +12920,7 @@ static int skill_castend_pos2(struct block_list *src, int x, int y, uint16 skill
 	}
 	PRAGMA_GCC46(GCC diagnostic pop)
 
-	if( sc && sc->data[SC_CURSEDCIRCLE_ATKER] ) //Should only remove after the skill has been casted.
+	if( sc && sc_data(sc, SC_CURSEDCIRCLE_ATKER) ) //Should only remove after the skill has been casted.
 		status_change_end(src,SC_CURSEDCIRCLE_ATKER,INVALID_TIMER);
 
 	if( sd ) {// ensure that the skill last-cast tick is recorded
@@ -13120,7 +13116,7 @@ static struct skill_unit_group *skill_unitsetting(struct block_list *src, uint16
 		#endif
 			break;
 		case MG_FIREWALL:
-			if(sc && sc->data[SC_VIOLENTGALE])
+			if(sc && sc_data(sc, SC_VIOLENTGALE))
 				limit = limit*3/2;
 			val2=4+skill_lv;
 			break;
@@ -13381,10 +13377,10 @@ static struct skill_unit_group *skill_unitsetting(struct block_list *src, uint16
 			break;
 			}
 		case GC_POISONSMOKE:
-			if( !(sc && sc->data[SC_POISONINGWEAPON]) )
+			if( !(sc && sc_data(sc, SC_POISONINGWEAPON)) )
 				return NULL;
-			val2 = sc->data[SC_POISONINGWEAPON]->val2; // Type of Poison
-			val3 = sc->data[SC_POISONINGWEAPON]->val1;
+			val2 = sc_data(sc, SC_POISONINGWEAPON)->val2; // Type of Poison
+			val3 = sc_data(sc, SC_POISONINGWEAPON)->val1;
 			limit = 4000 + 2000 * skill_lv;
 			break;
 		case GD_LEADERSHIP:
@@ -13636,20 +13632,20 @@ static int skill_unit_onplace(struct skill_unit *src, struct block_list *bl, int
 	if (sc && sc->option&OPTION_HIDE && sg->skill_id != WZ_HEAVENDRIVE && sg->skill_id != WL_EARTHSTRAIN )
 		return 0; //Hidden characters are immune to AoE skills except to these. [Skotlex]
 
-	if (sc && sc->data[SC_VACUUM_EXTREME] && map->getcell(bl->m, bl, bl->x, bl->y, CELL_CHKLANDPROTECTOR))
+	if (sc && sc_data(sc, SC_VACUUM_EXTREME) && map->getcell(bl->m, bl, bl->x, bl->y, CELL_CHKLANDPROTECTOR))
 		status_change_end(bl, SC_VACUUM_EXTREME, INVALID_TIMER);
 
-	if ( sc && sc->data[SC_HOVERING] && ( sg->skill_id == SO_VACUUM_EXTREME || sg->skill_id == SO_ELECTRICWALK || sg->skill_id == SO_FIREWALK || sg->skill_id == WZ_QUAGMIRE ) )
+	if ( sc && sc_data(sc, SC_HOVERING) && ( sg->skill_id == SO_VACUUM_EXTREME || sg->skill_id == SO_ELECTRICWALK || sg->skill_id == SO_FIREWALK || sg->skill_id == WZ_QUAGMIRE ) )
 		return 0;
 
 	type = skill->get_sc_type(sg->skill_id);
-	sce = (sc != NULL && type != SC_NONE) ? sc->data[type] : NULL;
+	sce = (sc != NULL && type != SC_NONE) ? sc_data(sc, type) : NULL;
 	skill_id = sg->skill_id; //In case the group is deleted, we need to return the correct skill id, still.
 	switch (sg->unit_id) {
 		case UNT_SPIDERWEB:
-			if( sc && sc->data[SC_SPIDERWEB] && sc->data[SC_SPIDERWEB]->val1 > 0 ) {
+			if( sc && sc_data(sc, SC_SPIDERWEB) && sc_data(sc, SC_SPIDERWEB)->val1 > 0 ) {
 				// If you are fiberlocked and can't move, it will only increase your fireweakness level. [Inkfish]
-				sc->data[SC_SPIDERWEB]->val2++;
+				sc_data(sc, SC_SPIDERWEB)->val2++;
 				break;
 			} else if (sc && battle->check_target(&src->bl,bl,sg->target_flag) > 0) {
 				int sec = skill->get_time2(sg->skill_id,sg->skill_lv);
@@ -13745,7 +13741,7 @@ static int skill_unit_onplace(struct skill_unit *src, struct block_list *bl, int
 		case UNT_INTOABYSS:
 		case UNT_SIEGFRIED:
 			 //Needed to check when a dancer/bard leaves their ensemble area.
-			if (sg->src_id==bl->id && !(sc && sc->data[SC_SOULLINK] && sc->data[SC_SOULLINK]->val2 == SL_BARDDANCER))
+			if (sg->src_id==bl->id && !(sc && sc_data(sc, SC_SOULLINK) && sc_data(sc, SC_SOULLINK)->val2 == SL_BARDDANCER))
 				return skill_id;
 			if (!sce)
 				sc_start4(ss, bl, type, 100, sg->skill_lv, sg->val1, sg->val2, 0, sg->limit, skill_id);
@@ -13764,7 +13760,7 @@ static int skill_unit_onplace(struct skill_unit *src, struct block_list *bl, int
 		case UNT_FORTUNEKISS:
 		case UNT_SERVICEFORYOU:
 			// Don't buff themselves without link!
-			if (sg->src_id==bl->id && !(sc && sc->data[SC_SOULLINK] && sc->data[SC_SOULLINK]->val2 == SL_BARDDANCER))
+			if (sg->src_id==bl->id && !(sc && sc_data(sc, SC_SOULLINK) && sc_data(sc, SC_SOULLINK)->val2 == SL_BARDDANCER))
 				return 0;
 
 			if (!sc) return 0;
@@ -13817,7 +13813,7 @@ static int skill_unit_onplace(struct skill_unit *src, struct block_list *bl, int
 
 		case UNT_MOONLIT:
 			//Knockback out of area if affected char isn't in Moonlit effect
-			if (sc && sc->data[SC_DANCING] && (sc->data[SC_DANCING]->val1&0xFFFF) == CG_MOONLIT)
+			if (sc && sc_data(sc, SC_DANCING) && (sc_data(sc, SC_DANCING)->val1&0xFFFF) == CG_MOONLIT)
 				break;
 			if (ss == bl) //Also needed to prevent infinite loop crash.
 				break;
@@ -13905,7 +13901,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 	ssc = status->get_sc(ss); // Status Effects for Unit caster.
 
 	// Maestro or Wanderer is unaffected by traps of trappers he or she charmed [SuperHulk]
-	if ( ssc && ssc->data[SC_SIREN] && ssc->data[SC_SIREN]->val2 == bl->id && (skill->get_inf2(sg->skill_id)&INF2_TRAP) )
+	if ( ssc && sc_data(ssc, SC_SIREN) && sc_data(ssc, SC_SIREN)->val2 == bl->id && (skill->get_inf2(sg->skill_id)&INF2_TRAP) )
 		return 0;
 
 	tstatus = status->get_status_data(bl);
@@ -13915,7 +13911,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 
 	PRAGMA_GCC46(GCC diagnostic push)
 	PRAGMA_GCC46(GCC diagnostic ignored "-Wswitch-enum")
-	if ( tsc && tsc->data[SC_HOVERING] ) {
+	if ( tsc && sc_data(tsc, SC_HOVERING) ) {
 		switch ( skill_id ) {
 		case HT_SKIDTRAP:
 		case HT_LANDMINE:
@@ -14006,7 +14002,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 				if (status->isimmune(bl))
 					heal = 0;
 				clif->skill_nodamage(&src->bl, bl, AL_HEAL, heal, 1);
-				if (tsc && tsc->data[SC_AKAITSUKI] && heal)
+				if (tsc && sc_data(tsc, SC_AKAITSUKI) && heal)
 					heal = ~heal + 1;
 				status->heal(bl, heal, 0, STATUS_HEAL_DEFAULT);
 				if (diff >= 500)
@@ -14116,7 +14112,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 					) {
 					// Do nothing if target are the specified monsters on manhole
 				} else if (status->change_start(ss, bl, type, 10000, sg->skill_lv, sg->group_id, 0, 0, sec, SCFLAG_FIXEDRATE, skill_id)) {
-					const struct TimerData* td = tsc->data[type] ? timer->get(tsc->data[type]->timer) : NULL;
+					const struct TimerData* td = sc_data(tsc, type) ? timer->get(sc_data(tsc, type)->timer) : NULL;
 					if (td)
 						sec = DIFF_TICK32(td->tick, tick);
 					if (sg->unit_id == UNT_MANHOLE || battle_config.skill_trap_type || map_flag_gvg2(src->bl.m) != 0) {
@@ -14157,7 +14153,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 			break;
 
 		case UNT_VENOMDUST:
-			if (tsc != NULL && tsc->data[type] == NULL)
+			if (tsc != NULL && sc_data(tsc, type) == NULL)
 				status->change_start(ss, bl, type, 10000, sg->skill_lv, battle_config.venom_dust_exp != 0 ? sg->src_id : sg->group_id, 0, 0, skill->get_time2(sg->skill_id, sg->skill_lv), SCFLAG_NONE, skill_id);
 			break;
 
@@ -14229,20 +14225,20 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 				break;
 #endif
 			// Don't buff themselves!
-			if ((sg->src_id == bl->id && !(tsc && tsc->data[SC_SOULLINK] && tsc->data[SC_SOULLINK]->val2 == SL_BARDDANCER)))
+			if ((sg->src_id == bl->id && !(tsc && sc_data(tsc, SC_SOULLINK) && sc_data(tsc, SC_SOULLINK)->val2 == SL_BARDDANCER)))
 				break;
 
 			// Aegis style
 			// Check if the remaining time is enough to survive the next update
 			if (!battle_config.song_timer_reset
-					&& !(tsc && tsc->data[type] && tsc->data[type]->val4 == 1)) {
+					&& !(tsc && sc_data(tsc, type) && sc_data(tsc, type)->val4 == 1)) {
 				// Apple of Idun is not active. Start it now
 				sc_start4(ss, bl, type, 100, sg->skill_lv, sg->val1, sg->val2, 0, sg->limit, skill_id);
 			}
 
 			if (tstatus->hp < tstatus->max_hp) {
 				heal = skill->calc_heal(ss,bl,sg->skill_id, sg->skill_lv, true);
-				if( tsc && tsc->data[SC_AKAITSUKI] && heal )
+				if( tsc && sc_data(tsc, SC_AKAITSUKI) && heal )
 					heal = ~heal + 1;
 				clif->skill_nodamage(&src->bl, bl, AL_HEAL, heal, 1);
 				status->heal(bl, heal, 0, STATUS_HEAL_DEFAULT);
@@ -14260,21 +14256,21 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 			if (battle_config.song_timer_reset)
 				break;
 			// Don't let buff themselves!
-			if (sg->src_id == bl->id && !(tsc && tsc->data[SC_SOULLINK] && tsc->data[SC_SOULLINK]->val2 == SL_BARDDANCER))
+			if (sg->src_id == bl->id && !(tsc && sc_data(tsc, SC_SOULLINK) && sc_data(tsc, SC_SOULLINK)->val2 == SL_BARDDANCER))
 				break;
 
 			// Aegis style
 			// Check if song has enough time to survive the next check
-			if (!(battle_config.song_timer_reset) && tsc && tsc->data[type] && tsc->data[type]->val4 == 1) {
-				const struct TimerData *td = timer->get(tsc->data[type]->timer);
+			if (!(battle_config.song_timer_reset) && tsc && sc_data(tsc, type) && sc_data(tsc, type)->val4 == 1) {
+				const struct TimerData *td = timer->get(sc_data(tsc, type)->timer);
 				if (DIFF_TICK32(td->tick, timer->gettick()) < sg->interval) {
 					// Update with new values as the current one will vanish
-					timer->delete(tsc->data[type]->timer, status->change_timer);
-					tsc->data[type]->timer = timer->add(tick+sg->limit, status->change_timer, bl->id, type);
-					tsc->data[type]->val1 = sg->skill_lv;
-					tsc->data[type]->val2 = sg->val1;
-					tsc->data[type]->val3 = sg->val2;
-					tsc->data[type]->val4 = 0;
+					timer->delete(sc_data(tsc, type)->timer, status->change_timer);
+					sc_data(tsc, type)->timer = timer->add(tick+sg->limit, status->change_timer, bl->id, type);
+					sc_data(tsc, type)->val1 = sg->skill_lv;
+					sc_data(tsc, type)->val2 = sg->val1;
+					sc_data(tsc, type)->val3 = sg->val2;
+					sc_data(tsc, type)->val4 = 0;
 				}
 				break; // Had enough time or not, it now has. Exit
 			}
@@ -14428,7 +14424,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 		 * 3rd stuff
 		 **/
 		case UNT_POISONSMOKE:
-			if (battle->check_target(ss, bl, BCT_ENEMY) > 0 && !(tsc != NULL && tsc->data[sg->val2] != NULL)
+			if (battle->check_target(ss, bl, BCT_ENEMY) > 0 && !(tsc != NULL && sc_data(tsc, sg->val2) != NULL)
 			    && rnd() % 100 < 50) {
 				int duration = skill->get_time2(GC_POISONINGWEAPON, (sg->val2 == SC_VENOMBLEED ? 1 : 2));
 				sc_start(ss, bl, sg->val2, 100, sg->val1, duration, skill_id);
@@ -14502,7 +14498,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 				if( !sg->val2 ) {
 					int sec = skill->get_time2(sg->skill_id, sg->skill_lv);
 					if (sc_start(ss, bl, type, 100, sg->skill_lv, sec, skill_id)) {
-						const struct TimerData* td = tsc->data[type]?timer->get(tsc->data[type]->timer):NULL;
+						const struct TimerData* td = sc_data(tsc, type)?timer->get(sc_data(tsc, type)->timer):NULL;
 						if( td )
 							sec = DIFF_TICK32(td->tick, tick);
 						///map->moveblock(bl, src->bl.x, src->bl.y, tick); // in official server it doesn't behave like this. [malufett]
@@ -14511,7 +14507,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 					} else
 						sec = 3000; // Couldn't trap it?
 					sg->limit = DIFF_TICK32(tick, sg->tick) + sec;
-				} else if( tsc->data[SC_THORNS_TRAP] && bl->id == sg->val2 )
+				} else if( sc_data(tsc, SC_THORNS_TRAP) && bl->id == sg->val2 )
 					skill->attack(skill->get_type(GN_THORNS_TRAP, sg->skill_lv), ss, ss, bl, sg->skill_id, sg->skill_lv, tick, SD_LEVEL|SD_ANIMATION);
 			}
 			break;
@@ -14553,7 +14549,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 			break;
 
 		case UNT_CLOUD_KILL:
-			if(tsc && !tsc->data[type])
+			if(tsc && !sc_data(tsc, type))
 				status->change_start(ss, bl, type, 10000, sg->skill_lv, sg->group_id, 0, 0, skill->get_time2(sg->skill_id, sg->skill_lv), SCFLAG_FIXEDRATE, skill_id);
 			skill->attack(skill->get_type(sg->skill_id, sg->skill_lv), ss, &src->bl, bl, sg->skill_id, sg->skill_lv, tick, 0);
 			break;
@@ -14562,13 +14558,13 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 			{
 				// It has effect on everything, including monsters, undead property and demon
 				int hp = 0;
-				if( ssc && ssc->data[SC_HEATER_OPTION] )
+				if( ssc && sc_data(ssc, SC_HEATER_OPTION) )
 					hp = tstatus->max_hp * 3 * sg->skill_lv / 100;
 				else
 					hp = tstatus->max_hp * sg->skill_lv / 100;
 				if( tstatus->hp != tstatus->max_hp )
 					clif->skill_nodamage(&src->bl, bl, AL_HEAL, hp, 0);
-				if( tsc && tsc->data[SC_AKAITSUKI] && hp )
+				if( tsc && sc_data(tsc, SC_AKAITSUKI) && hp )
 					hp = ~hp + 1;
 				status->heal(bl, hp, 0, STATUS_HEAL_DEFAULT);
 				sc_start(ss, bl, type, 100, sg->skill_lv, sg->interval + 100, skill_id);
@@ -14599,7 +14595,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 			break;
 
 		case UNT_VACUUM_EXTREME:
-			if (tsc && (tsc->data[SC_HALLUCINATIONWALK] || tsc->data[SC_VACUUM_EXTREME])) {
+			if (tsc && (sc_data(tsc, SC_HALLUCINATIONWALK) || sc_data(tsc, SC_VACUUM_EXTREME))) {
 				return 0;
 			} else {
 				struct status_data *bst = status->get_base_status(bl);
@@ -14698,7 +14694,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 					int sec = skill->get_time(sg->skill_id, sg->skill_lv);
 
 					if (sc_start2(ss, bl, type, 100, sg->skill_lv, sg->group_id, sec, skill_id)) {
-						const struct TimerData* td = ((tsc->data[type])? timer->get(tsc->data[type]->timer) : NULL);
+						const struct TimerData* td = ((sc_data(tsc, type))? timer->get(sc_data(tsc, type)->timer) : NULL);
 
 						if (td != NULL)
 							sec = DIFF_TICK32(td->tick, tick);
@@ -14708,7 +14704,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 						sec = 7000;
 					}
 					sg->limit = DIFF_TICK32(tick, sg->tick) + sec;
-				} else if (tsc->data[type] && bl->id == sg->val2) {
+				} else if (sc_data(tsc, type) && bl->id == sg->val2) {
 					skill->attack(skill->get_type(SU_SV_ROOTTWIST_ATK, sg->skill_lv), ss, &src->bl, bl, SU_SV_ROOTTWIST_ATK, sg->skill_lv, tick, SD_LEVEL|SD_ANIMATION);
 				}
 			}
@@ -14719,7 +14715,7 @@ static int skill_unit_onplace_timer(struct skill_unit *src, struct block_list *b
 				1, sg->skill_id, sg->skill_lv, BDT_SKILL);
 			break;
 		case UNT_B_TRAP:
-			if (tsc != NULL && tsc->data[type])
+			if (tsc != NULL && sc_data(tsc, type))
 				break;
 			sc_start(ss, bl, type, 100, sg->skill_lv, skill->get_time2(sg->skill_id, sg->skill_lv), skill_id);
 			src->val2++;
@@ -14754,7 +14750,7 @@ static int skill_unit_onout(struct skill_unit *src, struct block_list *bl, int64
 	nullpo_ret(sg=src->group);
 	sc = status->get_sc(bl);
 	type = skill->get_sc_type(sg->skill_id);
-	sce = (sc != NULL && type != SC_NONE) ? sc->data[type] : NULL;
+	sce = (sc != NULL && type != SC_NONE) ? sc_data(sc, type) : NULL;
 
 	if( bl->prev == NULL
 	 || (status->isdead(bl) && sg->unit_id != UNT_ANKLESNARE && sg->unit_id != UNT_SPIDERWEB && sg->unit_id != UNT_THORNS_TRAP)
@@ -14799,7 +14795,7 @@ static int skill_unit_onout(struct skill_unit *src, struct block_list *bl, int64
 		case UNT_DONTFORGETME:
 		case UNT_FORTUNEKISS:
 		case UNT_SERVICEFORYOU:
-			if (sg->src_id==bl->id && !(sc && sc->data[SC_SOULLINK] && sc->data[SC_SOULLINK]->val2 == SL_BARDDANCER))
+			if (sg->src_id==bl->id && !(sc && sc_data(sc, SC_SOULLINK) && sc_data(sc, SC_SOULLINK)->val2 == SL_BARDDANCER))
 				return -1;
 	}
 	return sg->skill_id;
@@ -14819,7 +14815,7 @@ static int skill_unit_onleft(uint16 skill_id, struct block_list *bl, int64 tick)
 		sc = NULL;
 
 	type = skill->get_sc_type(skill_id);
-	sce = (sc != NULL && type != SC_NONE) ? sc->data[type] : NULL;
+	sce = (sc != NULL && type != SC_NONE) ? sc_data(sc, type) : NULL;
 
 	PRAGMA_GCC46(GCC diagnostic push)
 	PRAGMA_GCC46(GCC diagnostic ignored "-Wswitch-enum")
@@ -14839,7 +14835,7 @@ static int skill_unit_onleft(uint16 skill_id, struct block_list *bl, int64 tick)
 		case BD_ROKISWEIL:
 		case BD_INTOABYSS:
 		case BD_SIEGFRIED:
-			if(sc && sc->data[SC_DANCING] && (sc->data[SC_DANCING]->val1&0xFFFF) == skill_id) {
+			if(sc && sc_data(sc, SC_DANCING) && (sc_data(sc, SC_DANCING)->val1&0xFFFF) == skill_id) {
 				//Check if you just stepped out of your ensemble skill to cancel dancing. [Skotlex]
 				//We don't check for SC_LONGING because someone could always have knocked you back and out of the song/dance.
 				//FIXME: This code is not perfect, it doesn't checks for the real ensemble's owner,
@@ -14898,7 +14894,7 @@ static int skill_unit_onleft(uint16 skill_id, struct block_list *bl, int64 tick)
 			if (sce) {
 				status_change_end(bl, type, INVALID_TIMER);
 				nullpo_retb(sc);
-				if ((sce = sc->data[SC_BLIND])) {
+				if ((sce = sc_data(sc, SC_BLIND))) {
 					if (bl->type == BL_PC) //Players get blind ended immediately, others have it still for 30 secs. [Skotlex]
 						status_change_end(bl, SC_BLIND, INVALID_TIMER);
 					else {
@@ -15037,7 +15033,7 @@ static int skill_check_condition_char_sub(struct block_list *bl, va_list ap)
 	if(pc_isdead(tsd))
 		return 0;
 
-	if (tsd->sc.data[SC_SILENCE] || ( tsd->sc.opt1 && tsd->sc.opt1 != OPT1_BURNING ))
+	if (sc_data(&tsd->sc, SC_SILENCE) || ( tsd->sc.opt1 && tsd->sc.opt1 != OPT1_BURNING ))
 		return 0;
 
 	if( skill->get_inf2(skill_id)&INF2_CHORUS_SKILL ) {
@@ -15068,7 +15064,7 @@ static int skill_check_condition_char_sub(struct block_list *bl, va_list ap)
 					p_sd[(*c)++] = tsd->bl.id;
 				return 1;
 			case LG_RAYOFGENESIS:
-				if (tsd->status.party_id == sd->status.party_id && (tsd->job & MAPID_THIRDMASK) == MAPID_ROYAL_GUARD && tsd->sc.data[SC_BANDING])
+				if (tsd->status.party_id == sd->status.party_id && (tsd->job & MAPID_THIRDMASK) == MAPID_ROYAL_GUARD && sc_data(&tsd->sc, SC_BANDING))
 					p_sd[(*c)++] = tsd->bl.id;
 				return 1;
 			default: //Warning: Assuming Ensemble Dance/Songs for code speed. [Skotlex]
@@ -15082,7 +15078,7 @@ static int skill_check_condition_char_sub(struct block_list *bl, va_list ap)
 							(tsd->weapontype1==W_MUSICAL || tsd->weapontype1==W_WHIP) &&
 							sd->status.party_id && tsd->status.party_id &&
 							sd->status.party_id == tsd->status.party_id &&
-							!tsd->sc.data[SC_DANCING])
+							!sc_data(&tsd->sc, SC_DANCING))
 					{
 						p_sd[(*c)++]=tsd->bl.id;
 						return skill_lv;
@@ -15116,6 +15112,7 @@ static int skill_check_pc_partner(struct map_session_data *sd, uint16 skill_id,
 	if (cast_flag) {
 		//Execute the skill on the partners.
 		struct map_session_data* tsd;
+		struct status_change_entry *sce;
 		switch (skill_id) {
 			case PR_BENEDICTIO:
 				for (i = 0; i < c; i++) {
@@ -15132,9 +15129,9 @@ static int skill_check_pc_partner(struct map_session_data *sd, uint16 skill_id,
 			default: //Warning: Assuming Ensemble skills here (for speed)
 				if( is_chorus )
 					break;//Chorus skills are not to be parsed as ensambles
-				if (c > 0 && sd->sc.data[SC_DANCING] && (tsd = map->id2sd(p_sd[0])) != NULL) {
-					sd->sc.data[SC_DANCING]->val4 = tsd->bl.id;
-					sc_start4(&tsd->bl, &tsd->bl, SC_DANCING, 100, skill_id, sd->sc.data[SC_DANCING]->val2, *skill_lv, sd->bl.id, skill->get_time(skill_id, *skill_lv) + 1000, skill_id);
+				if (c > 0 && (sce = sc_data(&sd->sc, SC_DANCING)) != NULL && (tsd = map->id2sd(p_sd[0])) != NULL) {
+					sce->val4 = tsd->bl.id;
+					sc_start4(&tsd->bl, &tsd->bl, SC_DANCING, 100, skill_id, sce->val2, *skill_lv, sd->bl.id, skill->get_time(skill_id, *skill_lv) + 1000, skill_id);
 					clif->skill_nodamage(&tsd->bl, &sd->bl, skill_id, *skill_lv, 1);
 					tsd->skill_id_dance = skill_id;
 					tsd->skill_lv_dance = *skill_lv;
@@ -15354,7 +15351,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		return 0;
 	}
 
-	if( sc && ( sc->data[SC__SHADOWFORM] || sc->data[SC__IGNORANCE] ) )
+	if( sc && ( sc_data(sc, SC__SHADOWFORM) || sc_data(sc, SC__IGNORANCE) ) )
 		return 0;
 
 	PRAGMA_GCC46(GCC diagnostic push)
@@ -15386,7 +15383,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		case SJ_UNIVERSESTANCE:
 		case SJ_SUNSTANCE:
 		case SP_SOULCOLLECT:
-			if (sc && sc->data[skill->get_sc_type(skill_id)])
+			if (sc && sc_data(sc, skill->get_sc_type(skill_id)))
 				return 1;
 			FALLTHROUGH
 		default:
@@ -15528,8 +15525,8 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			}
 			break;
 		case MO_CALLSPIRITS:
-			if(sc && sc->data[SC_RAISINGDRAGON])
-				skill_lv += sc->data[SC_RAISINGDRAGON]->val1;
+			if(sc && sc_data(sc, SC_RAISINGDRAGON))
+				skill_lv += sc_data(sc, SC_RAISINGDRAGON)->val1;
 			if(sd->spiritball >= skill_lv) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
@@ -15547,10 +15544,10 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		case MO_CHAINCOMBO:
 			if(!sc)
 				return 0;
-			if(sc->data[SC_BLADESTOP])
+			if(sc_data(sc, SC_BLADESTOP))
 				break;
-			if (sc->data[SC_COMBOATTACK]) {
-				if( sc->data[SC_COMBOATTACK]->val1 == MO_TRIPLEATTACK )
+			if (sc_data(sc, SC_COMBOATTACK)) {
+				if( sc_data(sc, SC_COMBOATTACK)->val1 == MO_TRIPLEATTACK )
 					break;
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_COMBOSKILL, MO_TRIPLEATTACK, 0);
 			}
@@ -15558,8 +15555,8 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		case MO_COMBOFINISH:
 			if(!sc)
 				return 0;
-			if( sc && sc->data[SC_COMBOATTACK] ) {
-				if ( sc->data[SC_COMBOATTACK]->val1 == MO_CHAINCOMBO )
+			if( sc && sc_data(sc, SC_COMBOATTACK) ) {
+				if ( sc_data(sc, SC_COMBOATTACK)->val1 == MO_CHAINCOMBO )
 					break;
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_COMBOSKILL, MO_CHAINCOMBO, 0);
 			}
@@ -15567,8 +15564,8 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		case CH_TIGERFIST:
 			if(!sc)
 				return 0;
-			if( sc && sc->data[SC_COMBOATTACK] ) {
-				if ( sc->data[SC_COMBOATTACK]->val1 == MO_COMBOFINISH )
+			if( sc && sc_data(sc, SC_COMBOATTACK) ) {
+				if ( sc_data(sc, SC_COMBOATTACK)->val1 == MO_COMBOFINISH )
 					break;
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_COMBOSKILL, MO_COMBOFINISH, 0);
 			}
@@ -15576,21 +15573,21 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		case CH_CHAINCRUSH:
 			if(!sc)
 				return 0;
-			if( sc && sc->data[SC_COMBOATTACK] ) {
-				if (sc->data[SC_COMBOATTACK]->val1 == CH_TIGERFIST || sc->data[SC_COMBOATTACK]->val1 == MO_COMBOFINISH)
+			if( sc && sc_data(sc, SC_COMBOATTACK) ) {
+				if (sc_data(sc, SC_COMBOATTACK)->val1 == CH_TIGERFIST || sc_data(sc, SC_COMBOATTACK)->val1 == MO_COMBOFINISH)
 					break;
 				//clif->skill_fail(sd, skill_id, USESKILL_FAIL_COMBOSKILL, CH_TIGERFIST, 0);
 			}
 			return 0;
 		case MO_EXTREMITYFIST:
 #if 0 //To disable Asura during the 5 min skill block uncomment this block...
-			if(sc && sc->data[SC_EXTREMITYFIST])
+			if(sc && sc_data(sc, SC_EXTREMITYFIST))
 				return 0;
 #endif // 0
-			if (sc && (sc->data[SC_BLADESTOP] || sc->data[SC_CURSEDCIRCLE_ATKER]))
+			if (sc && (sc_data(sc, SC_BLADESTOP) || sc_data(sc, SC_CURSEDCIRCLE_ATKER)))
 				break;
-			if (sc && sc->data[SC_COMBOATTACK]) {
-				switch(sc->data[SC_COMBOATTACK]->val1) {
+			if (sc && sc_data(sc, SC_COMBOATTACK)) {
+				switch(sc_data(sc, SC_COMBOATTACK)->val1) {
 					case MO_COMBOFINISH:
 					case CH_TIGERFIST:
 					case CH_CHAINCRUSH:
@@ -15631,17 +15628,17 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		case TK_COUNTER:
 			if ((sd->job & MAPID_UPPERMASK) == MAPID_SOUL_LINKER)
 				return 0; //Anti-Soul Linker check in case you job-changed with Stances active.
-			if(!(sc && sc->data[SC_COMBOATTACK]) || sc->data[SC_COMBOATTACK]->val1 == TK_JUMPKICK)
+			if(!(sc && sc_data(sc, SC_COMBOATTACK)) || sc_data(sc, SC_COMBOATTACK)->val1 == TK_JUMPKICK)
 				return 0; //Combo needs to be ready
 
-			if (sc->data[SC_COMBOATTACK]->val3) { //Kick chain
+			if (sc_data(sc, SC_COMBOATTACK)->val3) { //Kick chain
 				//Do not repeat a kick.
-				if (sc->data[SC_COMBOATTACK]->val3 != skill_id)
+				if (sc_data(sc, SC_COMBOATTACK)->val3 != skill_id)
 					break;
 				status_change_end(&sd->bl, SC_COMBOATTACK, INVALID_TIMER);
 				return 0;
 			}
-			if (sc->data[SC_COMBOATTACK]->val1 != skill_id
+			if (sc_data(sc, SC_COMBOATTACK)->val1 != skill_id
 			 && !(sd != NULL && sd->status.base_level >= 90 && pc->fame_rank(sd->status.char_id, RANKTYPE_TAEKWON) > 0)) {
 				//Cancel combo wait.
 				unit->cancel_combo(&sd->bl);
@@ -15651,15 +15648,15 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		case BD_ADAPTATION:
 			{
 				int time;
-				if(!(sc && sc->data[SC_DANCING]))
+				if(!(sc && sc_data(sc, SC_DANCING)))
 				{
 					clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 					return 0;
 				}
-				time = 1000*(sc->data[SC_DANCING]->val3>>16);
+				time = 1000*(sc_data(sc, SC_DANCING)->val3>>16);
 				if (skill->get_time(
-					(sc->data[SC_DANCING]->val1&0xFFFF), //Dance Skill ID
-					(sc->data[SC_DANCING]->val1>>16)) //Dance Skill LV
+					(sc_data(sc, SC_DANCING)->val1&0xFFFF), //Dance Skill ID
+					(sc_data(sc, SC_DANCING)->val1>>16)) //Dance Skill LV
 					- time < skill->get_time2(skill_id,skill_lv))
 				{
 					clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
@@ -15677,12 +15674,12 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			break;
 
 		case SL_SMA:
-			if(!(sc != NULL && (sc->data[SC_SMA_READY] != NULL || sc->data[SC_USE_SKILL_SP_SHA] != NULL)))
+			if(!(sc != NULL && (sc_data(sc, SC_SMA_READY) != NULL || sc_data(sc, SC_USE_SKILL_SP_SHA) != NULL)))
 				return 0;
 			break;
 
 		case HT_POWER:
-			if(!(sc && sc->data[SC_COMBOATTACK] && sc->data[SC_COMBOATTACK]->val1 == skill_id))
+			if(!(sc && sc_data(sc, SC_COMBOATTACK) && sc_data(sc, SC_COMBOATTACK)->val1 == skill_id))
 				return 0;
 			break;
 
@@ -15728,7 +15725,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		case SG_SUN_WARM:
 		case SG_MOON_WARM:
 		case SG_STAR_WARM:
-			if (sc && sc->data[SC_MIRACLE])
+			if (sc && sc_data(sc, SC_MIRACLE))
 				break;
 			if (sd->bl.m == sd->feel_map[skill_id-SG_SUN_WARM].m)
 				break;
@@ -15738,7 +15735,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		case SG_SUN_COMFORT:
 		case SG_MOON_COMFORT:
 		case SG_STAR_COMFORT:
-			if (sc && sc->data[SC_MIRACLE])
+			if (sc && sc_data(sc, SC_MIRACLE))
 				break;
 			if (sd->bl.m == sd->feel_map[skill_id-SG_SUN_COMFORT].m &&
 				(battle_config.allow_skill_without_day || pc->sg_info[skill_id-SG_SUN_COMFORT].day_func()))
@@ -15746,7 +15743,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 			return 0;
 		case SG_FUSION:
-			if (sc && sc->data[SC_SOULLINK] && sc->data[SC_SOULLINK]->val2 == SL_STAR)
+			if (sc && sc_data(sc, SC_SOULLINK) && sc_data(sc, SC_SOULLINK)->val2 == SL_STAR)
 				break;
 			//Auron insists we should implement SP consumption when you are not Soul Linked. [Skotlex]
 			//Only invoke on skill begin cast (instant cast skill). [Kevin]
@@ -15790,7 +15787,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			}
 			FALLTHROUGH
 		case NJ_BUNSINJYUTSU:
-			if (!(sc && sc->data[SC_NJ_NEN])) {
+			if (!(sc && sc_data(sc, SC_NJ_NEN))) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
@@ -15865,7 +15862,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			{
 				int j, i = 0;
 				for(j = SC_SUMMON1; j <= SC_SUMMON5; j++)
-					if( sc && sc->data[j] )
+					if( sc && sc_data(sc, j) )
 						i++;
 
 				switch(skill_id){
@@ -15877,7 +15874,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 						break;
 					case WL_RELEASE:
 						for(j = SC_SPELLBOOK7; j >= SC_SPELLBOOK1; j--)
-							if( sc && sc->data[j] )
+							if( sc && sc_data(sc, j) )
 								i++;
 						if( i == 0 ){
 							clif->skill_fail(sd, skill_id, USESKILL_FAIL_SUMMON_NONE, 0, 0);
@@ -15896,14 +15893,14 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		 * Guilotine Cross
 		 **/
 		case GC_HALLUCINATIONWALK:
-			if( sc && (sc->data[SC_HALLUCINATIONWALK] || sc->data[SC_HALLUCINATIONWALK_POSTDELAY]) ) {
+			if( sc && (sc_data(sc, SC_HALLUCINATIONWALK) || sc_data(sc, SC_HALLUCINATIONWALK_POSTDELAY)) ) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
 			break;
 		case GC_COUNTERSLASH:
 		case GC_WEAPONCRUSH:
-			if( !(sc && sc->data[SC_COMBOATTACK] && sc->data[SC_COMBOATTACK]->val1 == GC_WEAPONBLOCKING) ) {
+			if( !(sc && sc_data(sc, SC_COMBOATTACK) && sc_data(sc, SC_COMBOATTACK)->val1 == GC_WEAPONBLOCKING) ) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_GC_WEAPONBLOCKING, 0, 0);
 				return 0;
 			}
@@ -15912,8 +15909,8 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		 * Ranger
 		 **/
 		case RA_WUGMASTERY:
-			if( pc_isfalcon(sd) || pc_isridingwug(sd) || sd->sc.data[SC__GROOMY] ) {
-				clif->skill_fail(sd, skill_id, sd->sc.data[SC__GROOMY] ? USESKILL_FAIL_MANUAL_NOTIFY : USESKILL_FAIL_CONDITION, 0, 0);
+			if( pc_isfalcon(sd) || pc_isridingwug(sd) || sc_data(&sd->sc, SC__GROOMY) ) {
+				clif->skill_fail(sd, skill_id, sc_data(&sd->sc, SC__GROOMY) ? USESKILL_FAIL_MANUAL_NOTIFY : USESKILL_FAIL_CONDITION, 0, 0);
 				return 0;
 			}
 			break;
@@ -15939,38 +15936,38 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 		 * Royal Guard
 		 **/
 		case LG_BANDING:
-			if( sc && sc->data[SC_INSPIRATION] ) {
+			if( sc && sc_data(sc, SC_INSPIRATION) ) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
 			break;
 		case LG_PRESTIGE:
-			if( sc && (sc->data[SC_BANDING] || sc->data[SC_INSPIRATION]) ) {
+			if( sc && (sc_data(sc, SC_BANDING) || sc_data(sc, SC_INSPIRATION)) ) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
 			break;
 		case LG_RAYOFGENESIS:
 		case LG_HESPERUSLIT:
-			if( sc && sc->data[SC_INSPIRATION]  )
+			if( sc && sc_data(sc, SC_INSPIRATION)  )
 				return 1; // Don't check for partner.
-			if( !(sc && sc->data[SC_BANDING]) ) {
+			if( !(sc && sc_data(sc, SC_BANDING)) ) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL, 0, 0);
 				return 0;
 			}
-			if( sc->data[SC_BANDING] &&
-				sc->data[SC_BANDING]->val2 < (skill_id == LG_RAYOFGENESIS ? 2 : 3) )
+			if( sc_data(sc, SC_BANDING) &&
+				sc_data(sc, SC_BANDING)->val2 < (skill_id == LG_RAYOFGENESIS ? 2 : 3) )
 				return 0; // Just fails, no msg here.
 			break;
 		case SR_FALLENEMPIRE:
-			if( sc && sc->data[SC_COMBOATTACK] ) {
-				if( sc->data[SC_COMBOATTACK]->val1 == SR_DRAGONCOMBO )
+			if( sc && sc_data(sc, SC_COMBOATTACK) ) {
+				if( sc_data(sc, SC_COMBOATTACK)->val1 == SR_DRAGONCOMBO )
 					break;
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_COMBOSKILL, SR_DRAGONCOMBO, 0);
 			}
 			return 0;
 		case SR_CRESCENTELBOW:
-			if( sc && sc->data[SC_CRESCENTELBOW] ) {
+			if( sc && sc_data(sc, SC_CRESCENTELBOW) ) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_DUPLICATE, 0, 0);
 				return 0;
 			}
@@ -15998,7 +15995,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			break;
 		case SC_MANHOLE:
 		case SC_DIMENSIONDOOR:
-			if( sc && sc->data[SC_MAGNETICFIELD] ) {
+			if( sc && sc_data(sc, SC_MAGNETICFIELD) ) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
@@ -16015,8 +16012,8 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			break;
 		case SO_FIREWALK:
 		case SO_ELECTRICWALK: // Can't be casted until you've walked all cells.
-			if( sc && sc->data[SC_PROPERTYWALK] &&
-			   sc->data[SC_PROPERTYWALK]->val3 < skill->get_maxcount(sc->data[SC_PROPERTYWALK]->val1,sc->data[SC_PROPERTYWALK]->val2) ) {
+			if( sc && sc_data(sc, SC_PROPERTYWALK) &&
+			   sc_data(sc, SC_PROPERTYWALK)->val3 < skill->get_maxcount(sc_data(sc, SC_PROPERTYWALK)->val1,sc_data(sc, SC_PROPERTYWALK)->val2) ) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
@@ -16034,7 +16031,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			}
 			break;
 		case CR_REFLECTSHIELD:
-			if( sc && sc->data[SC_KYOMU] && rnd()%100 < 5 * sc->data[SC_KYOMU]->val1 ){
+			if( sc && sc_data(sc, SC_KYOMU) && rnd()%100 < 5 * sc_data(sc, SC_KYOMU)->val1 ){
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
@@ -16064,13 +16061,13 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			}
 			break;
 		case SJ_FULLMOONKICK:
-			if (!(sc != NULL && sc->data[SC_NEWMOON] != NULL)) {
+			if (!(sc != NULL && sc_data(sc, SC_NEWMOON) != NULL)) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
 			break;
 		case SJ_SOLARBURST:
-			if( !(sc != NULL && sc->data[SC_COMBOATTACK] != NULL && sc->data[SC_COMBOATTACK]->val1 == SJ_PROMINENCEKICK) ) {
+			if( !(sc != NULL && sc_data(sc, SC_COMBOATTACK) != NULL && sc_data(sc, SC_COMBOATTACK)->val1 == SJ_PROMINENCEKICK) ) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_COMBOSKILL, SJ_PROMINENCEKICK, 0);
 				return 0;
 			}
@@ -16088,7 +16085,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			}
 			break;
 		case SP_SWHOO:
-			if (!(sc != NULL && sc->data[SC_USE_SKILL_SP_SPA] != NULL))
+			if (!(sc != NULL && sc_data(sc, SC_USE_SKILL_SP_SPA) != NULL))
 				return 0;
 			break;
 		case SP_KAUTE: // Fail if below 30% MaxHP.
@@ -16140,7 +16137,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			}
 			break;
 		case ST_CARTBOOST:
-			if(!(sc && sc->data[SC_CARTBOOST])) {
+			if(!(sc && sc_data(sc, SC_CARTBOOST))) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
@@ -16158,13 +16155,13 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			}
 			break;
 		case ST_SIGHT:
-			if(!(sc && sc->data[SC_SIGHT])) {
+			if(!(sc && sc_data(sc, SC_SIGHT))) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
 			break;
 		case ST_EXPLOSIONSPIRITS:
-			if(!(sc && sc->data[SC_EXPLOSIONSPIRITS])) {
+			if(!(sc && sc_data(sc, SC_EXPLOSIONSPIRITS))) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_EXPLOSIONSPIRITS, 0, 0);
 				return 0;
 			}
@@ -16176,7 +16173,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			}
 			break;
 		case ST_MOVE_ENABLE:
-			if (sc && sc->data[SC_COMBOATTACK] && sc->data[SC_COMBOATTACK]->val1 == skill_id)
+			if (sc && sc_data(sc, SC_COMBOATTACK) && sc_data(sc, SC_COMBOATTACK)->val1 == skill_id)
 				sd->ud.canmove_tick = timer->gettick(); //When using a combo, cancel the can't move delay to enable the skill. [Skotlex]
 
 			if (!unit->can_move(&sd->bl)) {
@@ -16185,7 +16182,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			}
 			break;
 		case ST_WATER:
-			if (sc && (sc->data[SC_DELUGE] || sc->data[SC_NJ_SUITON]))
+			if (sc && (sc_data(sc, SC_DELUGE) || sc_data(sc, SC_NJ_SUITON)))
 				break;
 			if (map->getcell(sd->bl.m, &sd->bl, sd->bl.x, sd->bl.y, CELL_CHKWATER))
 				break;
@@ -16222,25 +16219,25 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			}
 			break;
 		case ST_POISONINGWEAPON:
-			if (!(sc && sc->data[SC_POISONINGWEAPON])) {
+			if (!(sc && sc_data(sc, SC_POISONINGWEAPON))) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_GC_POISONINGWEAPON, 0, 0);
 				return 0;
 			}
 			break;
 		case ST_ROLLINGCUTTER:
-			if (!(sc && sc->data[SC_ROLLINGCUTTER])) {
+			if (!(sc && sc_data(sc, SC_ROLLINGCUTTER))) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_CONDITION, 0, 0);
 				return 0;
 			}
 			break;
 		case ST_MH_FIGHTING:
-			if (!(sc && sc->data[SC_STYLE_CHANGE] && sc->data[SC_STYLE_CHANGE]->val2 == MH_MD_FIGHTING)){
+			if (!(sc && sc_data(sc, SC_STYLE_CHANGE) && sc_data(sc, SC_STYLE_CHANGE)->val2 == MH_MD_FIGHTING)){
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
 			FALLTHROUGH
 		case ST_MH_GRAPPLING:
-			if (!(sc && sc->data[SC_STYLE_CHANGE] && sc->data[SC_STYLE_CHANGE]->val2 == MH_MD_GRAPPLING)){
+			if (!(sc && sc_data(sc, SC_STYLE_CHANGE) && sc_data(sc, SC_STYLE_CHANGE)->val2 == MH_MD_GRAPPLING)){
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
@@ -16252,31 +16249,31 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 			}
 			break;
 		case ST_QD_SHOT_READY:
-			if (!(sc != NULL && sc->data[SC_QD_SHOT_READY])) {
+			if (!(sc != NULL && sc_data(sc, SC_QD_SHOT_READY))) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
 			break;
 		case ST_SUNSTANCE:
-			if (!(sc != NULL && (sc->data[SC_SUNSTANCE] != NULL || sc->data[SC_UNIVERSESTANCE] != NULL))) {
+			if (!(sc != NULL && (sc_data(sc, SC_SUNSTANCE) != NULL || sc_data(sc, SC_UNIVERSESTANCE) != NULL))) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
 			break;
 		case ST_MOONSTANCE:
-			if (!(sc != NULL && (sc->data[SC_LUNARSTANCE] != NULL || sc->data[SC_UNIVERSESTANCE] != NULL))) {
+			if (!(sc != NULL && (sc_data(sc, SC_LUNARSTANCE) != NULL || sc_data(sc, SC_UNIVERSESTANCE) != NULL))) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
 			break;
 		case ST_STARSTANCE:
-			if (!(sc != NULL && (sc->data[SC_STARSTANCE] != NULL || sc->data[SC_UNIVERSESTANCE] != NULL))) {
+			if (!(sc != NULL && (sc_data(sc, SC_STARSTANCE) != NULL || sc_data(sc, SC_UNIVERSESTANCE) != NULL))) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
 			break;
 		case ST_UNIVERSESTANCE:
-			if (!(sc != NULL && sc->data[SC_UNIVERSESTANCE] != NULL)) {
+			if (!(sc != NULL && sc_data(sc, SC_UNIVERSESTANCE) != NULL)) {
 				clif->skill_fail(sd, skill_id, USESKILL_FAIL_LEVEL, 0, 0);
 				return 0;
 			}
@@ -16353,7 +16350,7 @@ static int skill_check_condition_castbegin(struct map_session_data *sd, uint16 s
 	// There's no need to check if the skill is part of a combo if it's
 	// already been checked before, see unit_skilluse_id2 [Panikon]
 	// Note that if this check is read part of issue:8047 will reappear!
-	if( sd->sc.data[SC_COMBOATTACK] && !skill->is_combo(skill_id ) )
+	if( sc_data(&sd->sc, SC_COMBOATTACK) && !skill->is_combo(skill_id ) )
 		return 0;
 #endif // 0
 
@@ -16772,7 +16769,7 @@ static int skill_consume_requirement(struct map_session_data *sd, uint16 skill_i
 				req.sp = 0;
 				break;
 			case WZ_EARTHSPIKE:
-				if (sd->sc.count > 0 && sd->sc.data[SC_EARTHSCROLL] != NULL) // If Earth Spike Scroll is used while SC_EARTHSCROLL is active, 10 SP are consumed. [Kenpachi]
+				if (sd->sc.count > 0 && sc_data(&sd->sc, SC_EARTHSCROLL) != NULL) // If Earth Spike Scroll is used while SC_EARTHSCROLL is active, 10 SP are consumed. [Kenpachi]
 					req.sp = 10;
 
 				break;
@@ -16841,27 +16838,27 @@ static int skill_consume_requirement(struct map_session_data *sd, uint16 skill_i
 			if (any_item_index != INDEX_NOT_FOUND && any_item_index != i)
 				continue;
 
-			if( itemid_isgemstone(req.itemid[i]) && skill_id != HW_GANBANTEIN && sc && sc->data[SC_SOULLINK] && sc->data[SC_SOULLINK]->val2 == SL_WIZARD )
+			if( itemid_isgemstone(req.itemid[i]) && skill_id != HW_GANBANTEIN && sc && sc_data(sc, SC_SOULLINK) && sc_data(sc, SC_SOULLINK)->val2 == SL_WIZARD )
 				continue; //Gemstones are checked, but not subtracted from inventory.
 
 			switch( skill_id ){
 				case SA_SEISMICWEAPON:
-					if( sc && sc->data[SC_UPHEAVAL_OPTION] && rnd()%100 < 50 )
+					if( sc && sc_data(sc, SC_UPHEAVAL_OPTION) && rnd()%100 < 50 )
 						continue;
 					break;
 				case SA_FLAMELAUNCHER:
 				case SA_VOLCANO:
-					if( sc && sc->data[SC_TROPIC_OPTION] && rnd()%100 < 50 )
+					if( sc && sc_data(sc, SC_TROPIC_OPTION) && rnd()%100 < 50 )
 						continue;
 					break;
 				case SA_FROSTWEAPON:
 				case SA_DELUGE:
-					if( sc && sc->data[SC_CHILLY_AIR_OPTION] && rnd()%100 < 50 )
+					if( sc && sc_data(sc, SC_CHILLY_AIR_OPTION) && rnd()%100 < 50 )
 						continue;
 					break;
 				case SA_LIGHTNINGLOADER:
 				case SA_VIOLENTGALE:
-					if( sc && sc->data[SC_WILD_STORM_OPTION] && rnd()%100 < 50 )
+					if( sc && sc_data(sc, SC_WILD_STORM_OPTION) && rnd()%100 < 50 )
 						continue;
 					break;
 			}
@@ -16879,6 +16876,7 @@ static struct skill_condition skill_get_requirement(struct map_session_data *sd,
 	struct skill_condition req;
 	struct status_data *st;
 	struct status_change *sc;
+	const struct status_change_entry *sce;
 	int i,hp_rate,sp_rate, sp_skill_rate_bonus = 100;
 	uint16 idx;
 
@@ -16916,7 +16914,7 @@ static struct skill_condition skill_get_requirement(struct map_session_data *sd,
 		case SJ_STARSTANCE:
 		case SJ_UNIVERSESTANCE:
 		case SJ_SUNSTANCE:
-			if (sc && sc->data[skill->get_sc_type(skill_id)])
+			if (sc && sc_data(sc, skill->get_sc_type(skill_id)))
 				return req;
 			/* Fall through */
 		default:
@@ -16961,24 +16959,24 @@ static struct skill_condition skill_get_requirement(struct map_session_data *sd,
 	req.sp = cap_value(req.sp * sp_skill_rate_bonus / 100, 0, SHRT_MAX);
 
 	if (sc) {
-		if (sc->data[SC__LAZINESS])
-			req.sp += req.sp + sc->data[SC__LAZINESS]->val1 * 10;
-		if (sc->data[SC_UNLIMITED_HUMMING_VOICE])
-			req.sp += req.sp * sc->data[SC_UNLIMITED_HUMMING_VOICE]->val3 / 100;
-		if (sc->data[SC_RECOGNIZEDSPELL])
+		if ((sce = sc_data(sc, SC__LAZINESS)) != NULL)
+			req.sp += req.sp + sce->val1 * 10;
+		if ((sce = sc_data(sc, SC_UNLIMITED_HUMMING_VOICE)) != NULL)
+			req.sp += req.sp * sce->val3 / 100;
+		if (sc_data(sc, SC_RECOGNIZEDSPELL))
 			req.sp += req.sp / 4;
-		if (sc->data[SC_TELEKINESIS_INTENSE] && skill->get_ele(skill_id, skill_lv) == ELE_GHOST)
-			req.sp -= req.sp * sc->data[SC_TELEKINESIS_INTENSE]->val2 / 100;
-		if (sc->data[SC_TARGET_ASPD])
-			req.sp -= req.sp * sc->data[SC_TARGET_ASPD]->val1 / 100;
-		if (sc->data[SC_MVPCARD_MISTRESS])
-			req.sp -= req.sp * sc->data[SC_MVPCARD_MISTRESS]->val1 / 100;
+		if ((sce = sc_data(sc, SC_TELEKINESIS_INTENSE)) != NULL && skill->get_ele(skill_id, skill_lv) == ELE_GHOST)
+			req.sp -= req.sp * sce->val2 / 100;
+		if ((sce = sc_data(sc, SC_TARGET_ASPD)) != NULL)
+			req.sp -= req.sp * sce->val1 / 100;
+		if ((sce = sc_data(sc, SC_MVPCARD_MISTRESS)) != NULL)
+			req.sp -= req.sp * sce->val1 / 100;
 	}
 
 	req.zeny = skill->dbs->db[idx].zeny[skill_lv-1];
 
-	if( sc && sc->data[SC__UNLUCKY] )
-		req.zeny += sc->data[SC__UNLUCKY]->val1 * 500;
+	if( sc && (sce = sc_data(sc, SC__UNLUCKY)) != NULL )
+		req.zeny += sce->val1 * 500;
 
 	req.spiritball = skill->dbs->db[idx].spiritball[skill_lv-1];
 
@@ -17042,13 +17040,13 @@ static struct skill_condition skill_get_requirement(struct map_session_data *sd,
 				else if (--req.amount[i] < 1)
 					req.amount[i] = 1; // Hocus Pocus always use at least 1 gem
 			}
-			if (sc && sc->data[SC_INTOABYSS]) {
+			if (sc && sc_data(sc, SC_INTOABYSS)) {
 				if (skill_id != SA_ABRACADABRA)
 					req.itemid[i] = req.amount[i] = 0;
 				else if (--req.amount[i] < 1)
 					req.amount[i] = 1; // Hocus Pocus always use at least 1 gem
 			}
-			if (sc && sc->data[SC_MVPCARD_MISTRESS]) {
+			if (sc && sc_data(sc, SC_MVPCARD_MISTRESS)) {
 				req.itemid[i] = req.amount[i] = 0;
 			}
 		}
@@ -17071,7 +17069,7 @@ static struct skill_condition skill_get_requirement(struct map_session_data *sd,
 				req.zeny -= req.zeny*10/100;
 			break;
 		case AL_HOLYLIGHT:
-			if(sc && sc->data[SC_SOULLINK] && sc->data[SC_SOULLINK]->val2 == SL_PRIEST)
+			if(sc && (sce = sc_data(sc, SC_SOULLINK)) != NULL && sce->val2 == SL_PRIEST)
 				req.sp *= 5;
 			break;
 		case SL_SMA:
@@ -17095,21 +17093,21 @@ static struct skill_condition skill_get_requirement(struct map_session_data *sd,
 		case MO_COMBOFINISH:
 		case CH_TIGERFIST:
 		case CH_CHAINCRUSH:
-			if(sc && sc->data[SC_SOULLINK] && sc->data[SC_SOULLINK]->val2 == SL_MONK)
+			if(sc && (sce = sc_data(sc, SC_SOULLINK)) != NULL && sce->val2 == SL_MONK)
 				req.sp -= req.sp*25/100; //FIXME: Need real data. this is a custom value.
 			break;
 		case MO_BODYRELOCATION:
-			if( sc && sc->data[SC_EXPLOSIONSPIRITS] )
+			if( sc && sc_data(sc, SC_EXPLOSIONSPIRITS) )
 				req.spiritball = 0;
 			break;
 		case MO_EXTREMITYFIST:
 			if( sc )
 			{
-				if( sc->data[SC_BLADESTOP] )
+				if( sc_data(sc, SC_BLADESTOP) )
 					req.spiritball--;
-				else if( sc->data[SC_COMBOATTACK] )
+				else if( (sce = sc_data(sc, SC_COMBOATTACK)) != NULL )
 				{
-					switch( sc->data[SC_COMBOATTACK]->val1 )
+					switch( sce->val1 )
 					{
 						case MO_COMBOFINISH:
 							req.spiritball = 4;
@@ -17121,7 +17119,7 @@ static struct skill_condition skill_get_requirement(struct map_session_data *sd,
 							req.spiritball = sd->spiritball?sd->spiritball:1;
 							break;
 					}
-				}else if( sc->data[SC_RAISINGDRAGON] && sd->spiritball > 5)
+				}else if( sc_data(sc, SC_RAISINGDRAGON) && sd->spiritball > 5)
 					req.spiritball = sd->spiritball; // must consume all regardless of the amount required
 			}
 			break;
@@ -17129,7 +17127,7 @@ static struct skill_condition skill_get_requirement(struct map_session_data *sd,
 			req.spiritball = sd->spiritball?sd->spiritball:15;
 			break;
 		case SR_GATEOFHELL:
-			if( sc && sc->data[SC_COMBOATTACK] && sc->data[SC_COMBOATTACK]->val1 == SR_FALLENEMPIRE )
+			if( sc && (sce = sc_data(sc, SC_COMBOATTACK)) != NULL && sce->val1 == SR_FALLENEMPIRE )
 				req.sp -= req.sp * 10 / 100;
 			break;
 		case SO_SUMMON_AGNI:
@@ -17143,7 +17141,7 @@ static struct skill_condition skill_get_requirement(struct map_session_data *sd,
 		}
 			break;
 		case SO_PSYCHIC_WAVE:
-			if( sc && (sc->data[SC_HEATER_OPTION] || sc->data[SC_COOLER_OPTION] || sc->data[SC_BLAST_OPTION] ||  sc->data[SC_CURSED_SOIL_OPTION] ))
+			if( sc && (sc_data(sc, SC_HEATER_OPTION) || sc_data(sc, SC_COOLER_OPTION) || sc_data(sc, SC_BLAST_OPTION) ||  sc_data(sc, SC_CURSED_SOIL_OPTION) ))
 				req.sp += req.sp * 150 / 100;
 			break;
 		default:
@@ -17234,24 +17232,24 @@ static int skill_castfix_sc(struct block_list *bl, int time)
 		return time;
 
 	if (sc && sc->count) {
-		if (sc->data[SC_SLOWCAST])
-			time += time * sc->data[SC_SLOWCAST]->val2 / 100;
-		if (sc->data[SC_NEEDLE_OF_PARALYZE])
-			time += sc->data[SC_NEEDLE_OF_PARALYZE]->val3;
-		if (sc->data[SC_SUFFRAGIUM]) {
-			time -= time * sc->data[SC_SUFFRAGIUM]->val2 / 100;
+		if (sc_data(sc, SC_SLOWCAST))
+			time += time * sc_data(sc, SC_SLOWCAST)->val2 / 100;
+		if (sc_data(sc, SC_NEEDLE_OF_PARALYZE))
+			time += sc_data(sc, SC_NEEDLE_OF_PARALYZE)->val3;
+		if (sc_data(sc, SC_SUFFRAGIUM)) {
+			time -= time * sc_data(sc, SC_SUFFRAGIUM)->val2 / 100;
 			status_change_end(bl, SC_SUFFRAGIUM, INVALID_TIMER);
 		}
-		if (sc->data[SC_MEMORIZE]) {
+		if (sc_data(sc, SC_MEMORIZE)) {
 			time>>=1;
-			if ((--sc->data[SC_MEMORIZE]->val2) <= 0)
+			if ((--sc_data(sc, SC_MEMORIZE)->val2) <= 0)
 				status_change_end(bl, SC_MEMORIZE, INVALID_TIMER);
 		}
-		if (sc->data[SC_POEMBRAGI])
-			time -= time * sc->data[SC_POEMBRAGI]->val2 / 100;
-		if (sc->data[SC_SKF_CAST] != NULL)
-			time -= time * sc->data[SC_SKF_CAST]->val1 / 100;
-		if (sc->data[SC_IZAYOI])
+		if (sc_data(sc, SC_POEMBRAGI))
+			time -= time * sc_data(sc, SC_POEMBRAGI)->val2 / 100;
+		if (sc_data(sc, SC_SKF_CAST) != NULL)
+			time -= time * sc_data(sc, SC_SKF_CAST)->val1 / 100;
+		if (sc_data(sc, SC_IZAYOI))
 			time -= time * 50 / 100;
 	}
 	time = max(time, 0);
@@ -17312,31 +17310,31 @@ static int skill_vfcastfix(struct block_list *bl, double time, uint16 skill_id,
 
 	if (sc && sc->count && !(skill->get_castnodex(skill_id, skill_lv)&2) ) {
 		// All variable cast additive bonuses must come first
-		if (sc->data[SC_SLOWCAST])
-			VARCAST_REDUCTION(-sc->data[SC_SLOWCAST]->val2);
-		if (sc->data[SC_FROSTMISTY])
+		if (sc_data(sc, SC_SLOWCAST))
+			VARCAST_REDUCTION(-sc_data(sc, SC_SLOWCAST)->val2);
+		if (sc_data(sc, SC_FROSTMISTY))
 			VARCAST_REDUCTION(-15);
 
 		// Variable cast reduction bonuses
-		if (sc->data[SC_SUFFRAGIUM]) {
-			VARCAST_REDUCTION(sc->data[SC_SUFFRAGIUM]->val2);
+		if (sc_data(sc, SC_SUFFRAGIUM)) {
+			VARCAST_REDUCTION(sc_data(sc, SC_SUFFRAGIUM)->val2);
 			status_change_end(bl, SC_SUFFRAGIUM, INVALID_TIMER);
 		}
-		if (sc->data[SC_MEMORIZE]) {
+		if (sc_data(sc, SC_MEMORIZE)) {
 			VARCAST_REDUCTION(50);
-			if ((--sc->data[SC_MEMORIZE]->val2) <= 0)
+			if ((--sc_data(sc, SC_MEMORIZE)->val2) <= 0)
 				status_change_end(bl, SC_MEMORIZE, INVALID_TIMER);
 		}
-		if (sc->data[SC_POEMBRAGI])
-			VARCAST_REDUCTION(sc->data[SC_POEMBRAGI]->val2);
-		if (sc->data[SC_IZAYOI])
+		if (sc_data(sc, SC_POEMBRAGI))
+			VARCAST_REDUCTION(sc_data(sc, SC_POEMBRAGI)->val2);
+		if (sc_data(sc, SC_IZAYOI))
 			VARCAST_REDUCTION(50);
-		if (sc->data[SC_WATER_INSIGNIA] && sc->data[SC_WATER_INSIGNIA]->val1 == 3 && (skill->get_ele(skill_id, skill_lv) == ELE_WATER))
+		if (sc_data(sc, SC_WATER_INSIGNIA) && sc_data(sc, SC_WATER_INSIGNIA)->val1 == 3 && (skill->get_ele(skill_id, skill_lv) == ELE_WATER))
 			VARCAST_REDUCTION(30); //Reduces 30% Variable Cast Time of Water spells.
-		if (sc->data[SC_TELEKINESIS_INTENSE])
-			VARCAST_REDUCTION(sc->data[SC_TELEKINESIS_INTENSE]->val2);
-		if (sc->data[SC_SOULLINK]){
-			if(sc->data[SC_SOULLINK]->val2 == SL_WIZARD || sc->data[SC_SOULLINK]->val2 == SL_BARDDANCER)
+		if (sc_data(sc, SC_TELEKINESIS_INTENSE))
+			VARCAST_REDUCTION(sc_data(sc, SC_TELEKINESIS_INTENSE)->val2);
+		if (sc_data(sc, SC_SOULLINK)){
+			if(sc_data(sc, SC_SOULLINK)->val2 == SL_WIZARD || sc_data(sc, SC_SOULLINK)->val2 == SL_BARDDANCER)
 				switch(skill_id){
 					case WZ_FIREPILLAR:
 						if(skill_lv < 5)
@@ -17350,38 +17348,38 @@ static int skill_vfcastfix(struct block_list *bl, double time, uint16 skill_id,
 						VARCAST_REDUCTION(50);
 				}
 		}
-		if (sc->data[SC_MYSTICSCROLL])
-			VARCAST_REDUCTION(sc->data[SC_MYSTICSCROLL]->val1);
-		if (sc->data[SC_SKF_CAST] != NULL)
-			VARCAST_REDUCTION(sc->data[SC_SKF_CAST]->val1);
-		if (sc->data[SC_SOULFAIRY] != NULL)
-			VARCAST_REDUCTION(sc->data[SC_SOULFAIRY]->val3);
+		if (sc_data(sc, SC_MYSTICSCROLL))
+			VARCAST_REDUCTION(sc_data(sc, SC_MYSTICSCROLL)->val1);
+		if (sc_data(sc, SC_SKF_CAST) != NULL)
+			VARCAST_REDUCTION(sc_data(sc, SC_SKF_CAST)->val1);
+		if (sc_data(sc, SC_SOULFAIRY) != NULL)
+			VARCAST_REDUCTION(sc_data(sc, SC_SOULFAIRY)->val3);
 
 		// Fixed cast reduction bonuses
-		if( sc->data[SC__LAZINESS] )
-			fixcast_r = max(fixcast_r, sc->data[SC__LAZINESS]->val2);
-		if( sc->data[SC_DANCE_WITH_WUG])
-			fixcast_r = max(fixcast_r, sc->data[SC_DANCE_WITH_WUG]->val4);
-		if( sc->data[SC_SECRAMENT] )
-			fixcast_r = max(fixcast_r, sc->data[SC_SECRAMENT]->val2);
+		if( sc_data(sc, SC__LAZINESS) )
+			fixcast_r = max(fixcast_r, sc_data(sc, SC__LAZINESS)->val2);
+		if( sc_data(sc, SC_DANCE_WITH_WUG))
+			fixcast_r = max(fixcast_r, sc_data(sc, SC_DANCE_WITH_WUG)->val4);
+		if( sc_data(sc, SC_SECRAMENT) )
+			fixcast_r = max(fixcast_r, sc_data(sc, SC_SECRAMENT)->val2);
 		if (sd && skill_id >= WL_WHITEIMPRISON && skill_id < WL_FREEZE_SP) {
 			int radius_lv = pc->checkskill(sd, WL_RADIUS);
 			if (radius_lv)
 				fixcast_r = max(fixcast_r, (status_get_int(bl) + status->get_lv(bl)) / 15 + radius_lv * 5); // [{(Caster?s INT / 15) + (Caster?s Base Level / 15) + (Radius Skill Level x 5)}] %
 		}
-		if (sc->data[SC_FENRIR_CARD])
-			fixcast_r = max(fixcast_r, sc->data[SC_FENRIR_CARD]->val2);
-		if (sc->data[SC_MAGIC_CANDY])
-			fixcast_r = max(fixcast_r, sc->data[SC_MAGIC_CANDY]->val2);
-		if (sc->data[SC_HEAT_BARREL])
-			fixcast_r = max(fixcast_r, sc->data[SC_HEAT_BARREL]->val2);
+		if (sc_data(sc, SC_FENRIR_CARD))
+			fixcast_r = max(fixcast_r, sc_data(sc, SC_FENRIR_CARD)->val2);
+		if (sc_data(sc, SC_MAGIC_CANDY))
+			fixcast_r = max(fixcast_r, sc_data(sc, SC_MAGIC_CANDY)->val2);
+		if (sc_data(sc, SC_HEAT_BARREL))
+			fixcast_r = max(fixcast_r, sc_data(sc, SC_HEAT_BARREL)->val2);
 
 		// Fixed cast non percentage bonuses
-		if( sc->data[SC_MANDRAGORA] )
-			fixed += sc->data[SC_MANDRAGORA]->val1 * 500;
-		if( sc->data[SC_IZAYOI] )
+		if( sc_data(sc, SC_MANDRAGORA) )
+			fixed += sc_data(sc, SC_MANDRAGORA)->val1 * 500;
+		if( sc_data(sc, SC_IZAYOI) )
 			fixed = 0;
-		if( sc->data[SC_GUST_OPTION] || sc->data[SC_BLAST_OPTION] || sc->data[SC_WILD_STORM_OPTION] )
+		if( sc_data(sc, SC_GUST_OPTION) || sc_data(sc, SC_BLAST_OPTION) || sc_data(sc, SC_WILD_STORM_OPTION) )
 			fixed -= 1000;
 	}
 
@@ -17442,7 +17440,7 @@ static int skill_delay_fix(struct block_list *bl, uint16 skill_id, uint16 skill_
 			time -= (4 * status_get_agi(bl) + 2 * status_get_dex(bl));
 			break;
 		case HP_BASILICA:
-			if( sc && !sc->data[SC_BASILICA] )
+			if( sc && !sc_data(sc, SC_BASILICA) )
 				time = 0; // There is no Delay on Basilica creation, only on cancel
 			break;
 		default:
@@ -17464,14 +17462,14 @@ static int skill_delay_fix(struct block_list *bl, uint16 skill_id, uint16 skill_
 			}
 	}
 
-	if ( sc && sc->data[SC_SOULLINK] ) {
+	if ( sc && sc_data(sc, SC_SOULLINK) ) {
 		switch (skill_id) {
 			case CR_SHIELDBOOMERANG:
-				if (sc->data[SC_SOULLINK]->val2 == SL_CRUSADER)
+				if (sc_data(sc, SC_SOULLINK)->val2 == SL_CRUSADER)
 					time /= 2;
 				break;
 			case AS_SONICBLOW:
-				if (!map_flag_gvg2(bl->m) && !map->list[bl->m].flag.battleground && sc->data[SC_SOULLINK]->val2 == SL_ASSASIN)
+				if (!map_flag_gvg2(bl->m) && !map->list[bl->m].flag.battleground && sc_data(sc, SC_SOULLINK)->val2 == SL_ASSASIN)
 					time /= 2;
 				break;
 		}
@@ -17480,16 +17478,16 @@ static int skill_delay_fix(struct block_list *bl, uint16 skill_id, uint16 skill_
 	if (!(delaynodex&2))
 	{
 		if (sc && sc->count) {
-			if (sc->data[SC_POEMBRAGI])
-				time -= time * sc->data[SC_POEMBRAGI]->val3 / 100;
-			if (sc->data[SC_WIND_INSIGNIA] && sc->data[SC_WIND_INSIGNIA]->val1 == 3 && (skill->get_ele(skill_id, skill_lv) == ELE_WIND))
+			if (sc_data(sc, SC_POEMBRAGI))
+				time -= time * sc_data(sc, SC_POEMBRAGI)->val3 / 100;
+			if (sc_data(sc, SC_WIND_INSIGNIA) && sc_data(sc, SC_WIND_INSIGNIA)->val1 == 3 && (skill->get_ele(skill_id, skill_lv) == ELE_WIND))
 				time /= 2; // After Delay of Wind element spells reduced by 50%.
 		}
 
 	}
 
-	if (sc != NULL && sc->data[SC_SOULDIVISION] != NULL)
-		time += time * sc->data[SC_SOULDIVISION]->val2 / 100;
+	if (sc != NULL && sc_data(sc, SC_SOULDIVISION) != NULL)
+		time += time * sc_data(sc, SC_SOULDIVISION)->val2 / 100;
 
 	if( !(delaynodex&4) && sd && sd->delayrate != 100 )
 		time = time * sd->delayrate / 100;
@@ -17945,7 +17943,7 @@ static int skill_autospell_spell_selected(struct map_session_data *sd, uint16 sk
 		return 0; // Don't have enough level to use
 
 	int max_lv = sk->skill_lv[autospell_lv - 1];
-	if (sk->spirit_boost && sd->sc.data[SC_SOULLINK] != NULL && sd->sc.data[SC_SOULLINK]->val2 == SL_SAGE)
+	if (sk->spirit_boost && sc_data(&sd->sc, SC_SOULLINK) != NULL && sc_data(&sd->sc, SC_SOULLINK)->val2 == SL_SAGE)
 		max_lv = skill->dbs->db[skill->get_index(skill_id)].max; // Soul Linker bonus. [Skotlex]
 
 	if (max_lv > skill_lv)
@@ -18608,7 +18606,7 @@ static int skill_enchant_elemental_end(struct block_list *bl, int type)
 	if (!sc->count) return 0;
 
 	for (i = 0; i < ARRAYLENGTH(scs); i++)
-		if (type != scs[i] && sc->data[scs[i]])
+		if (type != scs[i] && sc_data(sc, scs[i]))
 			status_change_end(bl, scs[i], INVALID_TIMER);
 
 	return 0;
@@ -18675,7 +18673,7 @@ static int skill_check_cloaking_end(struct block_list *bl, va_list ap)
 {
 	struct map_session_data *sd = BL_CAST(BL_PC, bl);
 
-	if (sd && sd->sc.data[SC_CLOAKING] && !skill->can_cloak(sd))
+	if (sd && sc_data(&sd->sc, SC_CLOAKING) && !skill->can_cloak(sd))
 		status_change_end(bl, SC_CLOAKING, INVALID_TIMER);
 
 	return 0;
@@ -18717,8 +18715,8 @@ static bool skill_check_shadowform(struct block_list *bl, int64 damage, int hit)
 
 	sc = status->get_sc(bl);
 
-	if (sc && sc->data[SC__SHADOWFORM] && damage) {
-		struct block_list *src = map->id2bl(sc->data[SC__SHADOWFORM]->val2);
+	if (sc && sc_data(sc, SC__SHADOWFORM) && damage) {
+		struct block_list *src = map->id2bl(sc_data(sc, SC__SHADOWFORM)->val2);
 		struct map_session_data *sd = BL_CAST(BL_PC, src);
 
 		if( !src || src->m != bl->m ) {
@@ -18736,7 +18734,7 @@ static bool skill_check_shadowform(struct block_list *bl, int64 damage, int hit)
 		status->damage(bl, src, damage, 0, clif->damage(src, src, 500, 500, damage, hit, (hit > 1 ? BDT_MULTIHIT : BDT_NORMAL), 0), 0);
 
 		/* because damage can cancel it */
-		if( sc->data[SC__SHADOWFORM] && (--sc->data[SC__SHADOWFORM]->val3) <= 0 ) {
+		if( sc_data(sc, SC__SHADOWFORM) && (--sc_data(sc, SC__SHADOWFORM)->val3) <= 0 ) {
 			status_change_end(bl, SC__SHADOWFORM, INVALID_TIMER);
 			if (sd != NULL)
 				sd->shadowform_id = 0;
@@ -18866,8 +18864,8 @@ static int skill_delunit(struct skill_unit *su)
 		case SC_MANHOLE: // Note : Removing the unit don't remove the status (official info)
 			if( group->val2 ) { // Someone Trapped
 				struct status_change *tsc = status->get_sc(map->id2bl(group->val2));
-				if( tsc && tsc->data[SC__MANHOLE] )
-					tsc->data[SC__MANHOLE]->val4 = 0; // Remove the Unit ID
+				if( tsc && sc_data(tsc, SC__MANHOLE) )
+					sc_data(tsc, SC__MANHOLE)->val4 = 0; // Remove the Unit ID
 			}
 			break;
 	}
@@ -19019,9 +19017,9 @@ static int skill_delunitgroup(struct skill_unit_group *group)
 
 	if (skill->get_unit_flag(group->skill_id)&(UF_DANCE|UF_SONG|UF_ENSEMBLE)) {
 		struct status_change* sc = status->get_sc(src);
-		if (sc && sc->data[SC_DANCING])
+		if (sc && sc_data(sc, SC_DANCING))
 		{
-			sc->data[SC_DANCING]->val2 = 0 ; //This prevents status_change_end attempting to re-delete the group. [Skotlex]
+			sc_data(sc, SC_DANCING)->val2 = 0 ; //This prevents status_change_end attempting to re-delete the group. [Skotlex]
 			status_change_end(src, SC_DANCING, INVALID_TIMER);
 		}
 	}
@@ -19030,8 +19028,8 @@ static int skill_delunitgroup(struct skill_unit_group *group)
 	// (needs to be done when the group is deleted by other means than skill deactivation)
 	if (group->unit_id == UNT_GOSPEL) {
 		struct status_change *sc = status->get_sc(src);
-		if(sc && sc->data[SC_GOSPEL]) {
-			sc->data[SC_GOSPEL]->val3 = 0; //Remove reference to this group. [Skotlex]
+		if(sc && sc_data(sc, SC_GOSPEL)) {
+			sc_data(sc, SC_GOSPEL)->val3 = 0; //Remove reference to this group. [Skotlex]
 			status_change_end(src, SC_GOSPEL, INVALID_TIMER);
 		}
 	}
@@ -19042,8 +19040,8 @@ static int skill_delunitgroup(struct skill_unit_group *group)
 		case SG_STAR_WARM:
 		{
 			struct status_change *sc = NULL;
-			if( (sc = status->get_sc(src)) != NULL  && sc->data[SC_WARM] ) {
-				sc->data[SC_WARM]->val4 = 0;
+			if( (sc = status->get_sc(src)) != NULL  && sc_data(sc, SC_WARM) ) {
+				sc_data(sc, SC_WARM)->val4 = 0;
 				status_change_end(src, SC_WARM, INVALID_TIMER);
 			}
 		}
@@ -19051,8 +19049,8 @@ static int skill_delunitgroup(struct skill_unit_group *group)
 		case NC_NEUTRALBARRIER:
 		{
 			struct status_change *sc = NULL;
-			if( (sc = status->get_sc(src)) != NULL && sc->data[SC_NEUTRALBARRIER_MASTER] ) {
-				sc->data[SC_NEUTRALBARRIER_MASTER]->val2 = 0;
+			if( (sc = status->get_sc(src)) != NULL && sc_data(sc, SC_NEUTRALBARRIER_MASTER) ) {
+				sc_data(sc, SC_NEUTRALBARRIER_MASTER)->val2 = 0;
 				status_change_end(src,SC_NEUTRALBARRIER_MASTER,INVALID_TIMER);
 			}
 		}
@@ -19060,8 +19058,8 @@ static int skill_delunitgroup(struct skill_unit_group *group)
 		case NC_STEALTHFIELD:
 		{
 			struct status_change *sc = NULL;
-			if( (sc = status->get_sc(src)) != NULL && sc->data[SC_STEALTHFIELD_MASTER] ) {
-				sc->data[SC_STEALTHFIELD_MASTER]->val2 = 0;
+			if( (sc = status->get_sc(src)) != NULL && sc_data(sc, SC_STEALTHFIELD_MASTER) ) {
+				sc_data(sc, SC_STEALTHFIELD_MASTER)->val2 = 0;
 				status_change_end(src,SC_STEALTHFIELD_MASTER,INVALID_TIMER);
 			}
 		}
@@ -19069,8 +19067,8 @@ static int skill_delunitgroup(struct skill_unit_group *group)
 		case LG_BANDING:
 		{
 			struct status_change *sc = NULL;
-			if( (sc = status->get_sc(src)) && sc->data[SC_BANDING] ) {
-				sc->data[SC_BANDING]->val4 = 0;
+			if( (sc = status->get_sc(src)) && sc_data(sc, SC_BANDING) ) {
+				sc_data(sc, SC_BANDING)->val4 = 0;
 				status_change_end(src,SC_BANDING,INVALID_TIMER);
 			}
 		}
@@ -19336,7 +19334,7 @@ static int skill_unit_timer_sub(union DBKey key, struct DBData *data, va_list ap
 			{
 				struct block_list *src = map->id2bl(group->src_id);
 				struct status_change *sc;
-				if( !src || (sc = status->get_sc(src)) == NULL || !sc->data[SC_BANDING] ) {
+				if( !src || (sc = status->get_sc(src)) == NULL || !sc_data(sc, SC_BANDING) ) {
 					skill->delunit(su);
 					break;
 				}
@@ -20443,11 +20441,11 @@ static void skill_toggle_magicpower(struct block_list *bl, uint16 skill_id, int
 	if ((skill->get_nk(skill_id) & NK_NO_DAMAGE) != 0 || (skill->get_type(skill_id, skill_lv) & BF_MAGIC) == 0)
 		return;
 
-	if (sc && sc->count && sc->data[SC_MAGICPOWER]) {
-		if (sc->data[SC_MAGICPOWER]->val4) {
+	if (sc && sc->count && sc_data(sc, SC_MAGICPOWER)) {
+		if (sc_data(sc, SC_MAGICPOWER)->val4) {
 			status_change_end(bl, SC_MAGICPOWER, INVALID_TIMER);
 		} else {
-			sc->data[SC_MAGICPOWER]->val4 = 1;
+			sc_data(sc, SC_MAGICPOWER)->val4 = 1;
 			status_calc_bl(bl, status->sc2scb_flag(SC_MAGICPOWER));
 #ifndef RENEWAL
 			if (bl->type == BL_PC) {// update current display.
@@ -20522,7 +20520,7 @@ static int skill_spellbook(struct map_session_data *sd, int nameid)
 	sc = status->get_sc(&sd->bl);
 	status_change_end(&sd->bl, SC_STOP, INVALID_TIMER);
 
-	for(i=SC_SPELLBOOK1; i <= SC_SPELLBOOK7; i++) if( sc && !sc->data[i] ) break;
+	for(i=SC_SPELLBOOK1; i <= SC_SPELLBOOK7; i++) if( sc && !sc_data(sc, i) ) break;
 	if( i > SC_SPELLBOOK7 )
 	{
 		clif->skill_fail(sd, WL_READING_SB, USESKILL_FAIL_SPELLBOOK_READING, 0, 0);
@@ -20542,14 +20540,14 @@ static int skill_spellbook(struct map_session_data *sd, int nameid)
 	max_preserve = 4 * pc->checkskill(sd, WL_FREEZE_SP) + (status_get_int(&sd->bl) + sd->status.base_level) / 10;
 	point = skill->dbs->spellbook_db[i].point;
 
-	if( sc && sc->data[SC_READING_SB] ) {
-		if( (sc->data[SC_READING_SB]->val2 + point) > max_preserve ) {
+	if( sc && sc_data(sc, SC_READING_SB) ) {
+		if( (sc_data(sc, SC_READING_SB)->val2 + point) > max_preserve ) {
 			clif->skill_fail(sd, WL_READING_SB, USESKILL_FAIL_SPELLBOOK_PRESERVATION_POINT, 0, 0);
 			return 0;
 		}
 		for(i = SC_SPELLBOOK7; i >= SC_SPELLBOOK1; i--){ // This is how official saves spellbook. [malufett]
-			if( !sc->data[i] ){
-				sc->data[SC_READING_SB]->val2 += point; // increase points
+			if( !sc_data(sc, i) ){
+				sc_data(sc, SC_READING_SB)->val2 += point; // increase points
 				sc_start4(&sd->bl, &sd->bl, (sc_type)i, 100, skill_id, pc->checkskill(sd, skill_id), point, 0, INFINITE_DURATION, skill_id);
 				break;
 			}
@@ -20567,8 +20565,8 @@ static int skill_select_menu(struct map_session_data *sd, uint16 skill_id)
 	int id, lv, prob, aslvl = 0, idx = 0;
 	nullpo_ret(sd);
 
-	if (sd->sc.data[SC_STOP]) {
-		aslvl = sd->sc.data[SC_STOP]->val1;
+	if (sc_data(&sd->sc, SC_STOP)) {
+		aslvl = sc_data(&sd->sc, SC_STOP)->val1;
 		status_change_end(&sd->bl,SC_STOP,INVALID_TIMER);
 	}
 
@@ -21645,7 +21643,7 @@ static void skill_add_bard_dancer_soullink_songs(struct map_session_data *sd)
 {
 	nullpo_retv(sd);
 
-	if (sd->sc.count == 0 || sd->sc.data[SC_SOULLINK] == NULL || sd->sc.data[SC_SOULLINK]->val2 != SL_BARDDANCER)
+	if (sd->sc.count == 0 || sc_data(&sd->sc, SC_SOULLINK) == NULL || sc_data(&sd->sc, SC_SOULLINK)->val2 != SL_BARDDANCER)
 		return;
 
 	const int bard_song_skillid[4] = {BA_WHISTLE, BA_ASSASSINCROSS, BA_POEMBRAGI, BA_APPLEIDUN};
@@ -1233,6 +1233,18 @@ struct status_change_entry {
 	bool infinite_duration;
 };
 
+/// Amount of 32 bit words in the active status change bitset.
+#define SC_ACTIVE_WORDS ((SC_MAX + 31) / 32)
+
+/// Initial size of the active status change hash table.
+#define SC_SLOTS_INITIAL 8
+
+/// A slot of the active status change hash table.
+struct status_change_slot {
+	int type;                          ///< Status change type, or SC_NONE if the slot is free.
+	struct status_change_entry *entry;
+};
+
 struct status_change {
 	unsigned int option;// effect state (bitfield)
 	unsigned int opt3;// skill state (bitfield)
@@ -1251,9 +1263,78 @@ struct status_change {
 #endif
 	unsigned char bs_counter; // Blood Sucker counter
 	unsigned char fv_counter; // Force of vanguard counter
-	struct status_change_entry *data[SC_MAX];
+	uint32 active[SC_ACTIVE_WORDS];   ///< Bitset of the active status changes, by type.
+	struct status_change_slot *slots; ///< Hash table of the active status changes (NULL when there are none).
+	int slot_count;                   ///< Amount of used slots.
+	int slot_capacity;                ///< Size of the hash table (a power of two).
 };
 
+/**
+ * Returns the entry of an active status change.
+ *
+ * The presence bitset answers lookups of inactive status changes, which are
+ * the vast majority, without touching the hash table.
+ *
+ * @param sc   The status change data of the unit.
+ * @param type The status change type.
+ * @return the entry, or NULL if the status change isn't active.
+ */
+static inline struct status_change_entry *sc_data(const struct status_change *sc, int type) __attribute__((unused));
+static inline struct status_change_entry *sc_data(const struct status_change *sc, int type)
+{
+	unsigned int mask, i;
+
+	if ((unsigned int)type >= SC_MAX || (sc->active[type / 32] & (1U << (type % 32))) == 0)
+		return NULL;
+
+	mask = (unsigned int)sc->slot_capacity - 1;
+	for (i = (unsigned int)type & mask; sc->slots[i].type != type; i = (i + 1) & mask)
+		; // An active status change is always in the table.
+	return sc->slots[i].entry;
+}
+
+/**
+ * Returns the next active status change, in type order.
+ *
+ * Status changes may be ended while iterating:
+ * @code
+ *	for (i = sc_next(sc, SC_NONE); i < SC_MAX; i = sc_next(sc, i)) {
+ *		// sc_data(sc, i) is active here
+ *	}
+ * @endcode
+ *
+ * @param sc   The status change data of the unit.
+ * @param type The previous type (SC_NONE to start from the first one).
+ * @return the next active type, or SC_MAX if there are no more.
+ */
+static inline int sc_next(const struct status_change *sc, int type) __attribute__((unused));
+static inline int sc_next(const struct status_change *sc, int type)
+{
+	int word;
+	uint32 bits;
+
+	if (++type >= SC_MAX)
+		return SC_MAX;
+
+	word = type / 32;
+	bits = sc->active[word] & (UINT32_MAX << (type % 32));
+	while (bits == 0) {
+		if (++word >= SC_ACTIVE_WORDS)
+			return SC_MAX;
+		bits = sc->active[word];
+	}
+#if defined(__GNUC__)
+	return word * 32 + __builtin_ctz(bits);
+#else
+	type = word * 32;
+	while ((bits & 1) == 0) {
+		bits >>= 1;
+		type++;
+	}
+	return type;
+#endif
+}
+
 
 //Define for standard HP damage attacks.
 #define status_fix_damage(src, target, hp, walkdelay) (status->damage((src), (target), (hp), 0, (walkdelay), 0))
@@ -1414,6 +1495,9 @@ struct status_interface {
 	struct view_data * (*get_viewdata) (struct block_list *bl);
 	void (*set_viewdata) (struct block_list *bl, int class_);
 	void (*change_init) (struct block_list *bl);
+	void (*change_slot_add) (struct status_change *sc, enum sc_type type, struct status_change_entry *sce);
+	void (*change_slot_remove) (struct status_change *sc, enum sc_type type);
+	void (*change_slot_resize) (struct status_change *sc, int capacity);
 	struct status_change * (*get_sc) (struct block_list *bl);
 	int (*isdead) (struct block_list *bl);
 	int (*isimmune) (struct block_list *bl);
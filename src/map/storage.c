@@ -76,6 +76,84 @@ static void storage_sortitem(struct item *items, unsigned int size)
 	}
 }
 
+/**
+ * Flags a storage slot as modified, so that it is sent on the next save.
+ *
+ * @param changes The storage's modification tracking.
+ * @param slot    The modified slot.
+ */
+static void storage_mark_changed(struct storage_changes *changes, int slot)
+{
+	nullpo_retv(changes);
+	Assert_retv(slot >= 0 && slot < STORAGE_CHANGES_SLOTS);
+
+	changes->slots[slot / 32] |= 1U << (slot % 32);
+}
+
+/**
+ * Checks whether a storage slot was modified since the last save.
+ *
+ * @param changes The storage's modification tracking.
+ * @param slot    The slot to check.
+ * @return true if the slot has to be sent on the next save.
+ */
+static bool storage_is_changed(const struct storage_changes *changes, int slot)
+{
+	nullpo_retr(false, changes);
+
+	if (slot < 0 || slot >= STORAGE_CHANGES_SLOTS)
+		return false;
+
+	return (changes->slots[slot / 32] & (1U << (slot % 32))) != 0;
+}
+
+/**
+ * Resets the modification tracking of a storage after it was sent for saving.
+ *
+ * @param changes The storage's modification tracking.
+ */
+static void storage_clear_changes(struct storage_changes *changes)
+{
+	nullpo_retv(changes);
+
+	memset(changes, 0, sizeof(*changes));
+}
+
+/**
+ * Sorts a storage (see storage_sortitem()) and flags every slot whose content moved.
+ *
+ * Slots are the unit of the char-server's incremental saves, so reordering them has to be saved as well.
+ *
+ * @param items   The storage's items.
+ * @param size    The amount of slots in items.
+ * @param changes The storage's modification tracking.
+ * @return true if any slot changed.
+ */
+static bool storage_sortitem_changes(struct item *items, unsigned int size, struct storage_changes *changes)
+{
+	nullpo_retr(false, items);
+	nullpo_retr(false, changes);
+
+	if (!battle_config.client_sort_storage || size == 0)
+		return false;
+
+	struct item *before = aMalloc(sizeof(*before) * size);
+	bool changed = false;
+
+	memcpy(before, items, sizeof(*before) * size);
+	storage->sortitem(items, size);
+
+	for (unsigned int i = 0; i < size; i++) {
+		if (memcmp(&before[i], &items[i], sizeof(items[i])) != 0) {
+			storage->mark_changed(changes, (int)i);
+			changed = true;
+		}
+	}
+
+	aFree(before);
+	return changed;
+}
+
 /**
  * Parses storage and saves 'dirty' ones upon reconnect. [Skotlex]
  * @see DBApply
@@ -84,6 +162,10 @@ static int storage_reconnect_sub(union DBKey key, struct DBData *data, va_list a
 {
 	struct guild_storage *stor = DB->data2ptr(data);
 	nullpo_ret(stor);
+
+	// The char-server may have lost its slot layout, rewrite the whole storage on its next save.
+	stor->changes.full = true;
+
 	if (stor->dirty && !stor->in_use) //Save closed storages.
 		gstorage->save(0, stor->guild_id,0);
 
@@ -93,6 +175,17 @@ static int storage_reconnect_sub(union DBKey key, struct DBData *data, va_list a
 //Function to be invoked upon server reconnection to char. To save all 'dirty' storages [Skotlex]
 static void do_reconnect_storage(void)
 {
+	struct s_mapiterator *iter = mapit_getallusers();
+	struct map_session_data *sd;
+
+	for (sd = BL_UCAST(BL_PC, mapit->first(iter)); mapit->exists(iter); sd = BL_UCAST(BL_PC, mapit->next(iter))) {
+		if (sd->storage.received)
+			sd->storage.changes.full = true;
+		else
+			sd->storage.requested = false; // Pending requests were lost with the connection.
+	}
+	mapit->free(iter);
+
 	gstorage->db->foreach(gstorage->db, storage->reconnect_sub);
 }
 
@@ -108,22 +201,29 @@ static int storage_storageopen(struct map_session_data *sd)
 	if (sd->state.storage_flag != STORAGE_FLAG_CLOSED)
 		return 1; //Already open?
 
-	if (sd->storage.received == false) {
-		clif->message(sd->fd, msg_sd(sd, MSGTBL_STORAGE_NOT_LOADED)); // Storage has not been loaded yet.
-		return 1;
-	}
-
 	if( !pc_can_give_items(sd) ) {
 		//check is this GM level is allowed to put items to storage
 		clif->message(sd->fd, msg_sd(sd, MSGTBL_CANT_GIVE_ITEMS)); // Your GM level doesn't authorize you to perform this action.
 		return 1;
 	}
 
-	sd->state.storage_flag = STORAGE_FLAG_NORMAL;
+	if (sd->storage.received == false) {
+		// Account storage is loaded on first use and opened once its last page arrives.
+		if (!sd->storage.requested)
+			intif->request_account_storage(sd, STORAGE_PAGE_OPEN);
 
-	if (sd->storage.aggregate > 0) {
-		storage->sortitem(VECTOR_DATA(sd->storage.item), VECTOR_LENGTH(sd->storage.item));
+		if (!sd->storage.requested) {
+			clif->message(sd->fd, msg_sd(sd, MSGTBL_STORAGE_NOT_LOADED)); // Storage has not been loaded yet.
+			return 1;
+		}
+		return 0;
 	}
+
+	sd->state.storage_flag = STORAGE_FLAG_NORMAL;
+
+	if (sd->storage.aggregate > 0
+	 && storage->sortitem_changes(VECTOR_DATA(sd->storage.item), VECTOR_LENGTH(sd->storage.item), &sd->storage.changes))
+		sd->storage.save = true;
 	clif->storageList(sd, VECTOR_DATA(sd->storage.item), VECTOR_LENGTH(sd->storage.item));
 
 	clif->updatestorageamount(sd, sd->storage.aggregate, MAX_STORAGE);
@@ -201,6 +301,7 @@ static int storage_additem(struct map_session_data *sd, struct item *item_data,
 
 				clif->storageitemadded(sd, it, i, amount);
 
+				storage->mark_changed(&sd->storage.changes, i);
 				sd->storage.save = true; // set a save flag.
 
 				return 0;
@@ -231,6 +332,7 @@ static int storage_additem(struct map_session_data *sd, struct item *item_data,
 
 	clif->updatestorageamount(sd, sd->storage.aggregate, MAX_STORAGE);
 
+	storage->mark_changed(&sd->storage.changes, i);
 	sd->storage.save = true; // set a save flag.
 
 	return 0;
@@ -262,6 +364,7 @@ static int storage_delitem(struct map_session_data *sd, int n, int amount)
 		clif->updatestorageamount(sd, --sd->storage.aggregate, MAX_STORAGE);
 	}
 
+	storage->mark_changed(&sd->storage.changes, n);
 	sd->storage.save = true;
 
 	if (sd->state.storage_flag == STORAGE_FLAG_NORMAL)
@@ -427,11 +530,19 @@ static void storage_storageclose(struct map_session_data *sd)
 
 	/* Erase deleted account storage items from memory
 	 * and resize the vector. */
-	while (i < VECTOR_LENGTH(sd->storage.item)) {
-		if (VECTOR_INDEX(sd->storage.item, i).nameid == 0) {
-			VECTOR_ERASE(sd->storage.item, i);
-		} else {
-			i++;
+	ARR_FIND(0, VECTOR_LENGTH(sd->storage.item), i, VECTOR_INDEX(sd->storage.item, i).nameid == 0);
+	if (i < VECTOR_LENGTH(sd->storage.item)) {
+		// Saves address the storage by slot: every slot from the first hole on moves or empties.
+		for (int j = i; j < VECTOR_LENGTH(sd->storage.item); j++)
+			storage->mark_changed(&sd->storage.changes, j);
+		sd->storage.save = true;
+
+		while (i < VECTOR_LENGTH(sd->storage.item)) {
+			if (VECTOR_INDEX(sd->storage.item, i).nameid == 0) {
+				VECTOR_ERASE(sd->storage.item, i);
+			} else {
+				i++;
+			}
 		}
 	}
 
@@ -543,12 +654,13 @@ static int storage_guild_storageopen(struct map_session_data *sd)
 	if (gstor->in_use)
 		return 1;
 
-	if (gstor->locked)
+	if (gstor->locked || gstor->loading)
 		return 1;
 
 	gstor->in_use = true;
 	sd->state.storage_flag = STORAGE_FLAG_GUILD;
-	storage->sortitem(gstor->items.data, gstor->items.capacity);
+	if (storage->sortitem_changes(gstor->items.data, gstor->items.capacity, &gstor->changes))
+		gstor->dirty = true;
 	clif->guildStorageList(sd, gstor->items.data, gstor->items.capacity);
 	clif->updatestorageamount(sd, gstor->items.amount, sd->guild->max_storage);
 	return 0;
@@ -601,6 +713,7 @@ static int guild_storage_additem(struct map_session_data *sd, struct guild_stora
 					return 1;
 				stor->items.data[i].amount += amount;
 				clif->storageitemadded(sd, &stor->items.data[i], i, amount);
+				storage->mark_changed(&stor->changes, i);
 				stor->dirty = true;
 				return 0;
 			}
@@ -620,6 +733,7 @@ static int guild_storage_additem(struct map_session_data *sd, struct guild_stora
 	stor->items.amount++;
 	clif->storageitemadded(sd,&stor->items.data[i], i, amount);
 	clif->updatestorageamount(sd, stor->items.amount, sd->guild->max_storage);
+	storage->mark_changed(&stor->changes, i);
 	stor->dirty = true;
 	return 0;
 }
@@ -645,6 +759,7 @@ static int guild_storage_delitem(struct map_session_data *sd, struct guild_stora
 		clif->updatestorageamount(sd, stor->items.amount, sd->guild->max_storage);
 	}
 	clif->storageitemremoved(sd,n,amount);
+	storage->mark_changed(&stor->changes, n);
 	stor->dirty = true;
 	return 0;
 }
@@ -932,6 +1047,10 @@ void storage_defaults(void)
 	storage->pc_quit = storage_storage_quit;
 	storage->comp_item = storage_comp_item;
 	storage->sortitem = storage_sortitem;
+	storage->sortitem_changes = storage_sortitem_changes;
+	storage->mark_changed = storage_mark_changed;
+	storage->is_changed = storage_is_changed;
+	storage->clear_changes = storage_clear_changes;
 	storage->reconnect_sub = storage_reconnect_sub;
 }
 
@@ -27,6 +27,7 @@
 struct guild_storage;
 struct item;
 struct map_session_data;
+struct storage_changes;
 
 /**
  * Acceptable values for map_session_data.state.storage_flag
@@ -52,6 +53,10 @@ struct storage_interface {
 	void (*pc_quit) (struct map_session_data *sd, int flag);
 	int (*comp_item) (const void *i1_, const void *i2_);
 	void (*sortitem) (struct item* items, unsigned int size);
+	bool (*sortitem_changes) (struct item *items, unsigned int size, struct storage_changes *changes);
+	void (*mark_changed) (struct storage_changes *changes, int slot);
+	bool (*is_changed) (const struct storage_changes *changes, int slot);
+	void (*clear_changes) (struct storage_changes *changes);
 	int (*reconnect_sub) (union DBKey key, struct DBData *data, va_list ap);
 };
 
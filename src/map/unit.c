@@ -51,6 +51,7 @@
 #include "map/vending.h"
 #include "common/HPM.h"
 #include "common/db.h"
+#include "common/ers.h"
 #include "common/memmgr.h"
 #include "common/nullpo.h"
 #include "common/random.h"
@@ -69,6 +70,16 @@ const short diry[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
 static struct unit_interface unit_s;
 struct unit_interface *unit;
 
+/// Walkers whose next step is due at the same tick, advanced together by a single timer.
+struct unit_walk_batch {
+	int64 tick; ///< Due tick, also the key in unit_walk_batches
+	int tid;    ///< Timer running the batch, shared as ud->walktimer by every member
+	VECTOR_DECL(int) ids; ///< Members, by block id (may hold stale entries of units that stopped walking)
+};
+
+/// Pending walk batches, indexed by due tick
+static struct DBMap *unit_walk_batches = NULL;
+
 /**
  * Returns the unit_data for the given block_list. If the object is using
  * shared unit_data (i.e. in case of BL_NPC), it returns the shared data.
@@ -231,7 +242,90 @@ static int unit_walk_toxy_sub(struct block_list *bl)
 		timer_delay = status->get_speed(bl);
 
 	if (timer_delay > 0)
-		ud->walktimer = timer->add(timer->gettick() + timer_delay, unit->walk_toxy_timer, bl->id, timer_delay);
+		unit->walk_schedule(bl, ud, timer->gettick() + timer_delay, timer_delay);
+	return 0;
+}
+
+/**
+ * Schedules the next step of a walking unit.
+ *
+ * Walkers due at the same tick share a batch and a single timer, the batch is
+ * advanced in one pass by unit->walk_batch_timer. ud->walktimer is set to the
+ * batch timer id, so it keeps being a valid "is walking" marker.
+ *
+ * @param bl The walking unit.
+ * @param ud The unit's unit_data.
+ * @param tick Tick at which the step is due.
+ * @param delay Duration of the step.
+ */
+static void unit_walk_schedule(struct block_list *bl, struct unit_data *ud, int64 tick, int delay)
+{
+	nullpo_retv(bl);
+	nullpo_retv(ud);
+
+	struct unit_walk_batch *batch = i64db_get(unit_walk_batches, tick);
+	if (batch == NULL) {
+		CREATE(batch, struct unit_walk_batch, 1);
+		batch->tick = tick;
+		VECTOR_INIT(batch->ids);
+		batch->tid = timer->add(tick, unit->walk_batch_timer, 0, (intptr_t)batch);
+		i64db_put(unit_walk_batches, tick, batch);
+	}
+
+	VECTOR_ENSURE(batch->ids, 1, 32);
+	VECTOR_PUSH(batch->ids, bl->id);
+	ud->walktimer = batch->tid;
+	ud->walk_tick = tick;
+	ud->walk_delay = delay;
+}
+
+/**
+ * Advances every unit whose step is due at the batch tick.
+ *
+ * Members that stopped walking or were rescheduled since joining the batch
+ * are skipped, the rest go through unit->walk_toxy_timer as if they owned
+ * the timer.
+ *
+ * @param tid Timer ID, shared by all the batch members.
+ * @param tick Due tick of the batch.
+ * @param id unused
+ * @param data The batch (struct unit_walk_batch *).
+ * @return 0
+ */
+static int unit_walk_batch_timer(int tid, int64 tick, int id, intptr_t data)
+{
+	struct unit_walk_batch *batch = (struct unit_walk_batch *)data;
+	nullpo_ret(batch);
+
+	i64db_remove(unit_walk_batches, batch->tick);
+
+	for (int i = 0; i < VECTOR_LENGTH(batch->ids); i++) {
+		int bl_id = VECTOR_INDEX(batch->ids, i);
+		struct block_list *bl = map->id2bl(bl_id);
+		if (bl == NULL)
+			continue;
+		struct unit_data *ud = unit->bl2ud(bl);
+		if (ud == NULL || ud->walktimer != tid || ud->walk_tick != batch->tick)
+			continue; // Stopped or rescheduled meanwhile
+		unit->walk_toxy_timer(tid, tick, bl_id, ud->walk_delay);
+	}
+
+	VECTOR_CLEAR(batch->ids);
+	aFree(batch);
+	return 0;
+}
+
+/**
+ * Releases a pending walk batch on shutdown.
+ * @see DBApply
+ */
+static int unit_walk_batch_final_sub(union DBKey key, struct DBData *data, va_list ap)
+{
+	struct unit_walk_batch *batch = DB->data2ptr(data);
+
+	timer->delete(batch->tid, unit->walk_batch_timer);
+	VECTOR_CLEAR(batch->ids);
+	aFree(batch);
 	return 0;
 }
 
@@ -405,8 +499,11 @@ static int unit_walk_toxy_timer(int tid, int64 tick, int id, intptr_t data)
 	}
 
 	struct map_session_data *sd = BL_CAST(BL_PC, bl);
+	// Non-player walkers only need the view refreshed for players, skip the area scans on empty maps
+	bool refresh_view = (sd != NULL || map->list[bl->m].users > 0);
 	//Refresh view for all those we lose sight
-	map->foreachinmovearea(clif->outsight, bl, AREA_SIZE, dx, dy, (sd != NULL ? BL_ALL : BL_PC), bl);
+	if (refresh_view)
+		map->foreachinmovearea(clif->outsight, bl, AREA_SIZE, dx, dy, (sd != NULL ? BL_ALL : BL_PC), bl);
 
 	x += dx;
 	y += dy;
@@ -417,9 +514,11 @@ static int unit_walk_toxy_timer(int tid, int64 tick, int id, intptr_t data)
 	if (bl->x != x || bl->y != y || ud->walktimer != INVALID_TIMER)
 		return 1; // map->moveblock has altered the object beyond what we expected (moved/warped it)
 
-	ud->walktimer = -2; // arbitrary non-INVALID_TIMER value to make the clif code send walking packets
-	map->foreachinmovearea(clif->insight, bl, AREA_SIZE, -dx, -dy, (sd != NULL ? BL_ALL : BL_PC), bl);
-	ud->walktimer = INVALID_TIMER;
+	if (refresh_view) {
+		ud->walktimer = -2; // arbitrary non-INVALID_TIMER value to make the clif code send walking packets
+		map->foreachinmovearea(clif->insight, bl, AREA_SIZE, -dx, -dy, (sd != NULL ? BL_ALL : BL_PC), bl);
+		ud->walktimer = INVALID_TIMER;
+	}
 
 	struct mercenary_data *mrd = BL_CAST(BL_MER, bl);
 	if (sd != NULL) {
@@ -497,7 +596,7 @@ static int unit_walk_toxy_timer(int tid, int64 tick, int id, intptr_t data)
 		timer_delay = status->get_speed(bl);
 
 	if (timer_delay > 0) {
-		ud->walktimer = timer->add(tick + timer_delay, unit->walk_toxy_timer, id, timer_delay);
+		unit->walk_schedule(bl, ud, tick + timer_delay, timer_delay);
 		if (md != NULL && DIFF_TICK(tick, md->dmgtick) < 3000) // not required not damaged recently
 			clif->move(ud);
 	} else if (ud->state.running != 0) {
@@ -633,13 +732,13 @@ static int unit_walk_toxy(struct block_list *bl, short x, short y, int flag)
 
 	sc = status->get_sc(bl);
 	if (sc != NULL) {
-		if (sc->data[SC_CONFUSION] != NULL || sc->data[SC__CHAOS] != NULL) { // Randomize the target position
+		if (sc_data(sc, SC_CONFUSION) != NULL || sc_data(sc, SC__CHAOS) != NULL) { // Randomize the target position
 			// Aegis behavior, yes if it doesn't find a random walkable cell it will not move at all.
 			ud->to_x = bl->x;
 			ud->to_y = bl->y;
 			map->get_random_cell_in_range(bl, bl->m, &ud->to_x, &ud->to_y, AREA_SIZE / 2, AREA_SIZE / 2);
 		}
-		if (sc->data[SC_COMBOATTACK] != NULL)
+		if (sc_data(sc, SC_COMBOATTACK) != NULL)
 			status_change_end(bl, SC_COMBOATTACK, INVALID_TIMER);
 	}
 
@@ -743,7 +842,7 @@ static int unit_walk_tobl(struct block_list *bl, struct block_list *tbl, int ran
 	unit->stop_attack(bl); // Sets target to 0
 
 	struct status_change *sc = status->get_sc(bl);
-	if (sc != NULL && (sc->data[SC_CONFUSION] != NULL || sc->data[SC__CHAOS] != NULL)) { //Randomize the target position
+	if (sc != NULL && (sc_data(sc, SC_CONFUSION) != NULL || sc_data(sc, SC__CHAOS) != NULL)) { //Randomize the target position
 		ud->to_x = bl->x;
 		ud->to_y = bl->y;
 		map->get_random_cell_in_range(bl, bl->m, &ud->to_x, &ud->to_y, AREA_SIZE / 2, AREA_SIZE / 2);
@@ -786,7 +885,8 @@ static void unit_run_hit(struct block_list *bl, struct status_change *sc, struct
 {
 	Assert_retv(type >= 0 && type < SC_MAX);
 	nullpo_retv(sc);
-	nullpo_retv(sc->data[type]);
+	struct status_change_entry *sce = sc_data(sc, type);
+	nullpo_retv(sce);
 
 	//If you can't run forward, you must be next to a wall, so bounce back. [Skotlex]
 	if (type == SC_RUN)
@@ -796,7 +896,7 @@ static void unit_run_hit(struct block_list *bl, struct status_change *sc, struct
 	nullpo_retv(ud);
 	//Set running to 0 beforehand so status_change_end knows not to enable spurt [Kevin]
 	ud->state.running = 0;
-	int lv = sc->data[type]->val1;
+	int lv = sce->val1;
 	status_change_end(bl, type, INVALID_TIMER);
 
 	if (type == SC_RUN) {
@@ -827,7 +927,8 @@ static bool unit_run(struct block_list *bl, struct map_session_data *sd, enum sc
 	Assert_retr(false, type == SC_RUN || type == SC_WUGDASH);
 
 	struct status_change *sc = status->get_sc(bl);
-	if (sc == NULL || sc->data[type] == NULL)
+	struct status_change_entry *sce;
+	if (sc == NULL || (sce = sc_data(sc, type)) == NULL)
 		return false;
 
 	if (unit->can_move(bl) == 0) {
@@ -838,9 +939,9 @@ static bool unit_run(struct block_list *bl, struct map_session_data *sd, enum sc
 	// Determine destination cell
 	int to_x = bl->x;
 	int to_y = bl->y;
-	Assert_retr(false, sc->data[type]->val2 >= UNIT_DIR_FIRST && sc->data[type]->val2 < UNIT_DIR_MAX);
-	int dir_x = dirx[sc->data[type]->val2];
-	int dir_y = diry[sc->data[type]->val2];
+	Assert_retr(false, sce->val2 >= UNIT_DIR_FIRST && sce->val2 < UNIT_DIR_MAX);
+	int dir_x = dirx[sce->val2];
+	int dir_y = diry[sce->val2];
 
 	// Search for available path
 	int step_count;
@@ -1133,6 +1234,9 @@ static int unit_warp(struct block_list *bl, short m, short x, short y, enum clr_
 	bl->y=ud->to_y=y;
 	bl->m=m;
 
+	if (bl->type == BL_NPC)
+		npc_chat->update_listener(BL_UCAST(BL_NPC, bl)); // listeners are indexed by map
+
 	map->addblock(bl);
 	clif->spawn(bl);
 	skill->unit_move(bl,timer->gettick(),1);
@@ -1148,23 +1252,18 @@ static int unit_warp(struct block_list *bl, short m, short x, short y, enum clr_
 static int unit_stop_walking(struct block_list *bl, int flag)
 {
 	struct unit_data *ud;
-	const struct TimerData* td;
 	int64 tick;
 	nullpo_ret(bl);
 
 	ud = unit->bl2ud(bl);
 	if(!ud || ud->walktimer == INVALID_TIMER)
 		return 0;
-	//NOTE: We are using timer data after deleting it because we know the
-	//timer->delete function does not messes with it. If the function's
-	//behavior changes in the future, this code could break!
-	td = timer->get(ud->walktimer);
-	timer->delete(ud->walktimer, unit->walk_toxy_timer);
+	// The walk batch timer is shared with other walkers, it skips units that are no longer attached to it
 	ud->walktimer = INVALID_TIMER;
 	ud->state.change_walk_target = 0;
 	tick = timer->gettick();
 	if( (flag&STOPWALKING_FLAG_ONESTEP && !ud->walkpath.path_pos) //Force moving at least one cell.
-	||  (flag&STOPWALKING_FLAG_NEXTCELL && td && DIFF_TICK(td->tick, tick) <= td->data/2) //Enough time has passed to cover half-cell
+	||  (flag&STOPWALKING_FLAG_NEXTCELL && DIFF_TICK(ud->walk_tick, tick) <= ud->walk_delay/2) //Enough time has passed to cover half-cell
 	) {
 		ud->walkpath.path_len = ud->walkpath.path_pos+1;
 		unit->walk_toxy_timer(INVALID_TIMER, tick, bl->id, ud->walkpath.path_pos);
@@ -1256,45 +1355,45 @@ static int unit_can_move(struct block_list *bl)
 	if (sc) {
 		if( sc->count
 		 && (
-		        sc->data[SC_ANKLESNARE]
-		    ||  sc->data[SC_AUTOCOUNTER]
-		    ||  sc->data[SC_TRICKDEAD]
-		    ||  sc->data[SC_BLADESTOP]
-		    ||  sc->data[SC_BLADESTOP_WAIT]
-		    || (sc->data[SC_GOSPEL] && sc->data[SC_GOSPEL]->val4 == BCT_SELF) // cannot move while gospel is in effect
-		    || (sc->data[SC_BASILICA] && sc->data[SC_BASILICA]->val4 == bl->id) // Basilica caster cannot move
-		    ||  sc->data[SC_STOP]
-			|| sc->data[SC_FALLENEMPIRE]
-		    ||  sc->data[SC_RG_CCONFINE_M]
-		    ||  sc->data[SC_RG_CCONFINE_S]
-		    ||  sc->data[SC_GS_MADNESSCANCEL]
-		    || (sc->data[SC_GRAVITATION] && sc->data[SC_GRAVITATION]->val3 == BCT_SELF)
-		    ||  sc->data[SC_WHITEIMPRISON]
-		    ||  sc->data[SC_ELECTRICSHOCKER]
-		    ||  sc->data[SC_WUGBITE]
-		    ||  sc->data[SC_THORNS_TRAP]
-		    ||  ( sc->data[SC_MAGNETICFIELD] && !sc->data[SC_HOVERING] )
-		    ||  sc->data[SC__MANHOLE]
-		    ||  sc->data[SC_CURSEDCIRCLE_ATKER]
-		    ||  sc->data[SC_CURSEDCIRCLE_TARGET]
-		    || (sc->data[SC_COLD] && bl->type != BL_MOB)
-		    ||  sc->data[SC_DEEP_SLEEP]
-		    || (sc->data[SC_CAMOUFLAGE] && sc->data[SC_CAMOUFLAGE]->val1 < 3 && !(sc->data[SC_CAMOUFLAGE]->val3&1))
-		    ||  sc->data[SC_MEIKYOUSISUI]
-		    ||  sc->data[SC_KG_KAGEHUMI]
-		    ||  sc->data[SC_NEEDLE_OF_PARALYZE]
-		    ||  sc->data[SC_VACUUM_EXTREME]
-		    || (sc->data[SC_FEAR] && sc->data[SC_FEAR]->val2 > 0)
-			|| sc->data[SC_NETHERWORLD]
-			|| sc->data[SC_SUHIDE]
-		    || (sc->data[SC_SPIDERWEB] && sc->data[SC_SPIDERWEB]->val1)
-		    || (sc->data[SC_CLOAKING] && sc->data[SC_CLOAKING]->val1 < 3 && !(sc->data[SC_CLOAKING]->val4&1)) //Need wall at level 1-2
+		        sc_data(sc, SC_ANKLESNARE)
+		    ||  sc_data(sc, SC_AUTOCOUNTER)
+		    ||  sc_data(sc, SC_TRICKDEAD)
+		    ||  sc_data(sc, SC_BLADESTOP)
+		    ||  sc_data(sc, SC_BLADESTOP_WAIT)
+		    || (sc_data(sc, SC_GOSPEL) && sc_data(sc, SC_GOSPEL)->val4 == BCT_SELF) // cannot move while gospel is in effect
+		    || (sc_data(sc, SC_BASILICA) && sc_data(sc, SC_BASILICA)->val4 == bl->id) // Basilica caster cannot move
+		    ||  sc_data(sc, SC_STOP)
+			|| sc_data(sc, SC_FALLENEMPIRE)
+		    ||  sc_data(sc, SC_RG_CCONFINE_M)
+		    ||  sc_data(sc, SC_RG_CCONFINE_S)
+		    ||  sc_data(sc, SC_GS_MADNESSCANCEL)
+		    || (sc_data(sc, SC_GRAVITATION) && sc_data(sc, SC_GRAVITATION)->val3 == BCT_SELF)
+		    ||  sc_data(sc, SC_WHITEIMPRISON)
+		    ||  sc_data(sc, SC_ELECTRICSHOCKER)
+		    ||  sc_data(sc, SC_WUGBITE)
+		    ||  sc_data(sc, SC_THORNS_TRAP)
+		    ||  ( sc_data(sc, SC_MAGNETICFIELD) && !sc_data(sc, SC_HOVERING) )
+		    ||  sc_data(sc, SC__MANHOLE)
+		    ||  sc_data(sc, SC_CURSEDCIRCLE_ATKER)
+		    ||  sc_data(sc, SC_CURSEDCIRCLE_TARGET)
+		    || (sc_data(sc, SC_COLD) && bl->type != BL_MOB)
+		    ||  sc_data(sc, SC_DEEP_SLEEP)
+		    || (sc_data(sc, SC_CAMOUFLAGE) && sc_data(sc, SC_CAMOUFLAGE)->val1 < 3 && !(sc_data(sc, SC_CAMOUFLAGE)->val3&1))
+		    ||  sc_data(sc, SC_MEIKYOUSISUI)
+		    ||  sc_data(sc, SC_KG_KAGEHUMI)
+		    ||  sc_data(sc, SC_NEEDLE_OF_PARALYZE)
+		    ||  sc_data(sc, SC_VACUUM_EXTREME)
+		    || (sc_data(sc, SC_FEAR) && sc_data(sc, SC_FEAR)->val2 > 0)
+			|| sc_data(sc, SC_NETHERWORLD)
+			|| sc_data(sc, SC_SUHIDE)
+		    || (sc_data(sc, SC_SPIDERWEB) && sc_data(sc, SC_SPIDERWEB)->val1)
+		    || (sc_data(sc, SC_CLOAKING) && sc_data(sc, SC_CLOAKING)->val1 < 3 && !(sc_data(sc, SC_CLOAKING)->val4&1)) //Need wall at level 1-2
 		    || (
-		         sc->data[SC_DANCING] && sc->data[SC_DANCING]->val4
+		         sc_data(sc, SC_DANCING) && sc_data(sc, SC_DANCING)->val4
 		         && (
-		               !sc->data[SC_LONGING]
-		            || (sc->data[SC_DANCING]->val1&0xFFFF) == CG_MOONLIT
-		            || (sc->data[SC_DANCING]->val1&0xFFFF) == CG_HERMODE
+		               !sc_data(sc, SC_LONGING)
+		            || (sc_data(sc, SC_DANCING)->val1&0xFFFF) == CG_MOONLIT
+		            || (sc_data(sc, SC_DANCING)->val1&0xFFFF) == CG_HERMODE
 		            )
 		       )
 		    )
@@ -1412,6 +1511,7 @@ static int unit_skilluse_id2(struct block_list *src, int target_id, uint16 skill
 	struct unit_data *ud;
 	struct status_data *tstatus;
 	struct status_change *sc;
+	struct status_change_entry *sce;
 	struct map_session_data *sd = NULL;
 	struct block_list * target = NULL;
 	int64 tick = timer->gettick();
@@ -1433,13 +1533,13 @@ static int unit_skilluse_id2(struct block_list *src, int target_id, uint16 skill
 	//temp: used to signal combo-skills right now.
 	if (sc != NULL
 	&& skill->is_combo(skill_id)
-	&& sc->data[SC_COMBOATTACK] != NULL
-	&& (sc->data[SC_COMBOATTACK]->val1 == skill_id
+	&& (sce = sc_data(sc, SC_COMBOATTACK)) != NULL
+	&& (sce->val1 == skill_id
 		|| (sd != NULL && skill->check_condition_castbegin(sd, skill_id, skill_lv))
 		)
 	) {
-		if (sc->data[SC_COMBOATTACK]->val2)
-			target_id = sc->data[SC_COMBOATTACK]->val2;
+		if (sce->val2)
+			target_id = sce->val2;
 		else if (src->id == target_id || ud->target > 0)
 			target_id = ud->target;
 
@@ -1462,8 +1562,8 @@ static int unit_skilluse_id2(struct block_list *src, int target_id, uint16 skill
 		switch (skill_id) {
 			//Check for skills that auto-select target
 			case MO_CHAINCOMBO:
-				if (sc && sc->data[SC_BLADESTOP]) {
-					if ((target=map->id2bl(sc->data[SC_BLADESTOP]->val4)) == NULL)
+				if (sc && (sce = sc_data(sc, SC_BLADESTOP)) != NULL) {
+					if ((target=map->id2bl(sce->val4)) == NULL)
 						return 0;
 				}
 				break;
@@ -1482,8 +1582,8 @@ static int unit_skilluse_id2(struct block_list *src, int target_id, uint16 skill
 			}
 				break;
 			case GC_WEAPONCRUSH:
-				if( sc && sc->data[SC_COMBOATTACK] && sc->data[SC_COMBOATTACK]->val1 == GC_WEAPONBLOCKING ) {
-					if( (target=map->id2bl(sc->data[SC_COMBOATTACK]->val2)) == NULL ) {
+				if( sc && (sce = sc_data(sc, SC_COMBOATTACK)) != NULL && sce->val1 == GC_WEAPONBLOCKING ) {
+					if( (target=map->id2bl(sce->val2)) == NULL ) {
 						clif->skill_fail(sd, skill_id, USESKILL_FAIL_GC_WEAPONBLOCKING, 0, 0);
 						return 0;
 					}
@@ -1493,8 +1593,8 @@ static int unit_skilluse_id2(struct block_list *src, int target_id, uint16 skill
 				}
 				break;
 			case RL_QD_SHOT:
-				if (sc != NULL && sc->data[SC_QD_SHOT_READY]) {
-					if ((target = map->id2bl(sc->data[SC_QD_SHOT_READY]->val1)) == NULL)
+				if (sc != NULL && (sce = sc_data(sc, SC_QD_SHOT_READY)) != NULL) {
+					if ((target = map->id2bl(sce->val1)) == NULL)
 						return 0;
 					temp = 1;
 				}
@@ -1661,10 +1761,10 @@ static int unit_skilluse_id2(struct block_list *src, int target_id, uint16 skill
 			casttime += casttime * min(skill_lv, sd->spiritball);
 	break;
 	case MO_EXTREMITYFIST:
-		if (sc && sc->data[SC_COMBOATTACK] &&
-		   (sc->data[SC_COMBOATTACK]->val1 == MO_COMBOFINISH ||
-			sc->data[SC_COMBOATTACK]->val1 == CH_TIGERFIST ||
-			sc->data[SC_COMBOATTACK]->val1 == CH_CHAINCRUSH))
+		if (sc && (sce = sc_data(sc, SC_COMBOATTACK)) != NULL &&
+		   (sce->val1 == MO_COMBOFINISH ||
+			sce->val1 == CH_TIGERFIST ||
+			sce->val1 == CH_CHAINCRUSH))
 			casttime = -1;
 		temp = 1;
 	break;
@@ -1689,8 +1789,8 @@ static int unit_skilluse_id2(struct block_list *src, int target_id, uint16 skill
 	break;
 	case SR_GATEOFHELL:
 	case SR_TIGERCANNON:
-		if (sc && sc->data[SC_COMBOATTACK] &&
-		   sc->data[SC_COMBOATTACK]->val1 == SR_FALLENEMPIRE)
+		if (sc && (sce = sc_data(sc, SC_COMBOATTACK)) != NULL &&
+		   sce->val1 == SR_FALLENEMPIRE)
 			casttime = -1;
 		temp = 1;
 	break;
@@ -1698,15 +1798,15 @@ static int unit_skilluse_id2(struct block_list *src, int target_id, uint16 skill
 		temp = 1;
 	break;
 	case ST_CHASEWALK:
-		if (sc && sc->data[SC_CHASEWALK])
+		if (sc && sc_data(sc, SC_CHASEWALK))
 			casttime = -1;
 	break;
 	case TK_RUN:
-		if (sc && sc->data[SC_RUN])
+		if (sc && sc_data(sc, SC_RUN))
 			casttime = -1;
 	break;
 	case HP_BASILICA:
-		if( sc && sc->data[SC_BASILICA] )
+		if( sc && sc_data(sc, SC_BASILICA) )
 			casttime = -1; // No Casting time on basilica cancel
 	break;
 	case KN_CHARGEATK:
@@ -1721,7 +1821,7 @@ static int unit_skilluse_id2(struct block_list *src, int target_id, uint16 skill
 			casttime *= 2;
 		break;
 	case RA_WUGDASH:
-		if (sc && sc->data[SC_WUGDASH])
+		if (sc && sc_data(sc, SC_WUGDASH))
 			casttime = -1;
 		break;
 	case EL_WIND_SLASH:
@@ -1780,13 +1880,13 @@ static int unit_skilluse_id2(struct block_list *src, int target_id, uint16 skill
 		/**
 		 * why the if else chain: these 3 status do not stack, so its efficient that way.
 		 **/
-		if( sc->data[SC_CLOAKING] && !(sc->data[SC_CLOAKING]->val4&4) && skill_id != AS_CLOAKING ) {
+		if( (sce = sc_data(sc, SC_CLOAKING)) != NULL && !(sce->val4&4) && skill_id != AS_CLOAKING ) {
 			status_change_end(src, SC_CLOAKING, INVALID_TIMER);
 			if (!src->prev) return 0; //Warped away!
-		} else if( sc->data[SC_CLOAKINGEXCEED] && !(sc->data[SC_CLOAKINGEXCEED]->val4&4) && skill_id != GC_CLOAKINGEXCEED ) {
+		} else if( (sce = sc_data(sc, SC_CLOAKINGEXCEED)) != NULL && !(sce->val4&4) && skill_id != GC_CLOAKINGEXCEED ) {
 			status_change_end(src,SC_CLOAKINGEXCEED, INVALID_TIMER);
 			if (!src->prev) return 0;
-		} else if (sc->data[SC_NEWMOON] != NULL && skill_id != SJ_NEWMOONKICK) {
+		} else if (sc_data(sc, SC_NEWMOON) != NULL && skill_id != SJ_NEWMOONKICK) {
 			status_change_end(src, SC_NEWMOON, INVALID_TIMER);
 			if (!src->prev) return 0;
 		}
@@ -2002,13 +2102,13 @@ static int unit_skilluse_pos2(struct block_list *src, short skill_x, short skill
 		/**
 		 * why the if else chain: these 3 status do not stack, so its efficient that way.
 		 **/
-		if (sc->data[SC_CLOAKING] && !(sc->data[SC_CLOAKING]->val4&4)) {
+		if (sc_data(sc, SC_CLOAKING) && !(sc_data(sc, SC_CLOAKING)->val4&4)) {
 			status_change_end(src, SC_CLOAKING, INVALID_TIMER);
 			if (!src->prev) return 0; //Warped away!
-		} else if (sc->data[SC_CLOAKINGEXCEED] && !(sc->data[SC_CLOAKINGEXCEED]->val4&4)) {
+		} else if (sc_data(sc, SC_CLOAKINGEXCEED) && !(sc_data(sc, SC_CLOAKINGEXCEED)->val4&4)) {
 			status_change_end(src, SC_CLOAKINGEXCEED, INVALID_TIMER);
 			if (!src->prev) return 0;
-		} else if (sc->data[SC_NEWMOON] != NULL && skill_id != SJ_NEWMOONKICK) {
+		} else if (sc_data(sc, SC_NEWMOON) != NULL && skill_id != SJ_NEWMOONKICK) {
 			status_change_end(src, SC_NEWMOON, INVALID_TIMER);
 			if (!src->prev) return 0;
 		}
@@ -2689,7 +2789,7 @@ static int unit_remove_map(struct block_list *bl, enum clr_type clrtype, const c
 			status_change_end(bl, SC_CLOAKINGEXCEED, INVALID_TIMER);
 		}
 		status_change_end(bl, SC_CHASEWALK, INVALID_TIMER);
-		if (sc->data[SC_GOSPEL] && sc->data[SC_GOSPEL]->val4 == BCT_SELF)
+		if (sc_data(sc, SC_GOSPEL) && sc_data(sc, SC_GOSPEL)->val4 == BCT_SELF)
 			status_change_end(bl, SC_GOSPEL, INVALID_TIMER);
 		status_change_end(bl, SC_HLIF_CHANGE, INVALID_TIMER);
 		status_change_end(bl, SC_STOP, INVALID_TIMER);
@@ -3083,7 +3183,7 @@ static int unit_free(struct block_list *bl, enum clr_type clrtype)
 			}
 			if( md->lootitem )
 			{
-				aFree(md->lootitem);
+				ers_free(mob->loot_ers, md->lootitem);
 				md->lootitem=NULL;
 			}
 			if( md->guardian_data )
@@ -3198,11 +3298,14 @@ static int unit_free(struct block_list *bl, enum clr_type clrtype)
 
 static int do_init_unit(bool minimal)
 {
+	unit_walk_batches = i64db_alloc(DB_OPT_BASE);
+
 	if (minimal)
 		return 0;
 
 	timer->add_func_list(unit->attack_timer,  "unit_attack_timer");
 	timer->add_func_list(unit->walk_toxy_timer, "unit_walk_toxy_timer");
+	timer->add_func_list(unit->walk_batch_timer, "unit_walk_batch_timer");
 	timer->add_func_list(unit->walktobl_timer, "unit_walktobl_timer");
 	timer->add_func_list(unit->delay_walk_toxy_timer, "unit_delay_walk_toxy_timer");
 	timer->add_func_list(unit->steptimer, "unit_steptimer");
@@ -3211,7 +3314,9 @@ static int do_init_unit(bool minimal)
 
 static int do_final_unit(void)
 {
-	// nothing to do
+	if (unit_walk_batches != NULL)
+		unit_walk_batches->destroy(unit_walk_batches, unit->walk_batch_final_sub);
+	unit_walk_batches = NULL;
 	return 0;
 }
 
@@ -3228,6 +3333,9 @@ void unit_defaults(void)
 	unit->init_ud = unit_init_ud;
 	unit->attack_timer = unit_attack_timer;
 	unit->walk_toxy_timer = unit_walk_toxy_timer;
+	unit->walk_schedule = unit_walk_schedule;
+	unit->walk_batch_timer = unit_walk_batch_timer;
+	unit->walk_batch_final_sub = unit_walk_batch_final_sub;
 	unit->walk_toxy_sub = unit_walk_toxy_sub;
 	unit->delay_walk_toxy_timer = unit_delay_walk_toxy_timer;
 	unit->walk_toxy = unit_walk_toxy;
@@ -26,6 +26,7 @@
 #include "map/skill.h" // 'MAX_SKILLTIMERSKILL, struct skill_timerskill, struct skill_unit_group, struct skill_unit_group_tickset
 #include "map/unitdefines.h" // enum unit_dir
 #include "common/hercules.h"
+#include "common/db.h"
 
 struct map_session_data;
 struct block_list;
@@ -60,6 +61,8 @@ struct unit_data {
 	int   target_to;
 	int   attacktimer;
 	int   walktimer;
+	int64 walk_tick;  ///< Tick at which the pending step of the current walk is due
+	int   walk_delay; ///< Duration of the pending step
 	int   chaserange;
 	bool  stepaction; //Action should be executed on step [Playtester]
 	int   steptimer; //Timer that triggers the action [Playtester]
@@ -108,6 +111,9 @@ struct unit_interface {
 	void (*init_ud) (struct unit_data *ud);
 	int (*attack_timer) (int tid, int64 tick, int id, intptr_t data);
 	int (*walk_toxy_timer) (int tid, int64 tick, int id, intptr_t data);
+	void (*walk_schedule) (struct block_list *bl, struct unit_data *ud, int64 tick, int delay);
+	int (*walk_batch_timer) (int tid, int64 tick, int id, intptr_t data);
+	int (*walk_batch_final_sub) (union DBKey key, struct DBData *data, va_list ap);
 	int (*walk_toxy_sub) (struct block_list *bl);
 	int (*delay_walk_toxy_timer) (int tid, int64 tick, int id, intptr_t data);
 	int (*walk_toxy) (struct block_list *bl, short x, short y, int flag);
@@ -34,6 +34,7 @@
 #include "map/path.h"
 #include "map/pc.h"
 #include "map/skill.h"
+#include "common/memmgr.h"
 #include "common/msgtable.h"
 #include "common/nullpo.h"
 #include "common/strlib.h"
@@ -61,6 +62,7 @@ static void vending_closevending(struct map_session_data *sd)
 	if( sd->state.vending ) {
 		sd->state.vending = 0;
 		clif->closevendingboard(&sd->bl, 0);
+		vending->index_remove(sd);
 		idb_remove(vending->db, sd->status.char_id);
 	}
 }
@@ -189,6 +191,9 @@ static void vending_purchasereq(struct map_session_data *sd, int aid, unsigned i
 		z -= apply_percentrate64(z, battle_config.vending_tax, 10000);
 	pc->getzeny(vsd, (int)z, LOG_TYPE_VENDING, sd);
 
+	// the stacks are about to change, reindexed once the list is compacted
+	vending->index_remove(vsd);
+
 	for (i = 0; i < count; i++) {
 		short amount = data[i].count;
 		short idx    = data[i].index - 2;
@@ -221,6 +226,7 @@ static void vending_purchasereq(struct map_session_data *sd, int aid, unsigned i
 		cursor++;
 	}
 	vsd->vend_num = cursor;
+	vending->index_add(vsd);
 
 	//Always save BOTH: buyer and customer
 	if( map->save_settings&2 ) {
@@ -313,6 +319,7 @@ static void vending_openvending(struct map_session_data *sd, const char *message
 	clif->showvendingboard(&sd->bl,message,0);
 
 	idb_put(vending->db, sd->status.char_id, sd);
+	vending->index_add(sd);
 }
 
 
@@ -339,8 +346,8 @@ static bool vending_search(struct map_session_data *sd, int nameid)
 /// @return Whether or not the search should be continued.
 static bool vending_searchall(struct map_session_data *sd, const struct s_search_store_search *s)
 {
-	int i, c, slot;
-	unsigned int idx, cidx;
+	int i;
+	unsigned int idx;
 	struct item* it;
 
 	nullpo_retr(false, sd);
@@ -363,24 +370,8 @@ static bool vending_searchall(struct map_session_data *sd, const struct s_search
 			continue;
 		}
 
-		if( s->card_count ) {// check cards
-			if( itemdb_isspecial(it->card[0]) ) {// something, that is not a carded
-				continue;
-			}
-			slot = itemdb_slot(it->nameid);
-
-			for( c = 0; c < slot && it->card[c]; c ++ ) {
-				ARR_FIND( 0, s->card_count, cidx, s->cardlist[cidx] == it->card[c] );
-				if( cidx != s->card_count )
-				{// found
-					break;
-				}
-			}
-
-			if( c == slot || !it->card[c] ) {// no card match
-				continue;
-			}
-		}
+		if (!vending->search_cards(it, s)) // no card match
+			continue;
 
 		if (!searchstore->result(s->search_sd, sd->vender_id, sd->status.account_id, sd->message, it->nameid, sd->vending[i].amount, sd->vending[i].value, it->card, it->refine, it->grade, it->option))
 		{// result set full
@@ -391,14 +382,165 @@ static bool vending_searchall(struct map_session_data *sd, const struct s_search
 	return true;
 }
 
+/// Checks whether a vended item carries one of the searched cards.
+/// @return true if the search has no card filter or a card matched.
+static bool vending_search_cards(const struct item *it, const struct s_search_store_search *s)
+{
+	int c, slot;
+	unsigned int cidx;
+
+	nullpo_retr(false, it);
+	nullpo_retr(false, s);
+	if( !s->card_count ) // no card filter
+		return true;
+
+	if( itemdb_isspecial(it->card[0]) ) {// something, that is not a carded
+		return false;
+	}
+	slot = itemdb_slot(it->nameid);
+
+	for( c = 0; c < slot && it->card[c]; c ++ ) {
+		ARR_FIND( 0, s->card_count, cidx, s->cardlist[cidx] == it->card[c] );
+		if( cidx != s->card_count )
+		{// found
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/// Searches the item index for stacks matching given ids, price range and possible cards.
+/// Like vending_searchall, only the first stack of each item id in a shop is considered.
+/// Results of each item id are produced in ascending price order.
+/// @return Whether or not the result set still has room.
+static bool vending_searchindex(const struct s_search_store_search *s)
+{
+	nullpo_retr(false, s);
+
+	for (unsigned int idx = 0; idx < s->item_count; idx++) {
+		const struct s_vending_index_bucket *bucket = idb_get(vending->item_index, s->itemlist[idx]);
+		if (bucket == NULL)
+			continue;
+
+		for (int i = vending->index_lowerbound(bucket, s->min_price); i < VECTOR_LENGTH(bucket->entries); i++) {
+			const struct s_vending_index_entry *entry = &VECTOR_INDEX(bucket->entries, i);
+
+			if (s->max_price != 0 && s->max_price < entry->value)
+				break; // too high price, so is everything after it
+
+			struct map_session_data *vsd = idb_get(vending->db, entry->char_id);
+			if (vsd == NULL || vsd == s->search_sd || !vsd->state.vending
+			 || vsd->vender_id != entry->vender_id || entry->slot >= vsd->vend_num)
+				continue; // own or stale shop
+
+			const struct s_vending *vend = &vsd->vending[entry->slot];
+			struct item *it = &vsd->status.cart[vend->index];
+			if (it->nameid != (int)s->itemlist[idx])
+				continue;
+
+			int first;
+			ARR_FIND(0, vsd->vend_num, first, vsd->status.cart[vsd->vending[first].index].nameid == it->nameid);
+			if (first != entry->slot || !vending->search_cards(it, s))
+				continue; // one result per shop and item id
+
+			if (!searchstore->result(s->search_sd, vsd->vender_id, vsd->status.account_id, vsd->message, it->nameid, vend->amount, vend->value, it->card, it->refine, it->grade, it->option))
+				return false; // result set full
+		}
+	}
+
+	return true;
+}
+
+/// Returns the position of the first entry of a bucket priced at least value.
+static int vending_index_lowerbound(const struct s_vending_index_bucket *bucket, unsigned int value)
+{
+	int lo = 0, hi;
+
+	nullpo_ret(bucket);
+	hi = VECTOR_LENGTH(bucket->entries);
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (VECTOR_INDEX(bucket->entries, mid).value < value)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/// Adds every stack of an open shop to the item index.
+static void vending_index_add(struct map_session_data *sd)
+{
+	nullpo_retv(sd);
+
+	for (int i = 0; i < sd->vend_num; i++) {
+		int nameid = sd->status.cart[sd->vending[i].index].nameid;
+		struct s_vending_index_bucket *bucket = idb_get(vending->item_index, nameid);
+		if (bucket == NULL) {
+			CREATE(bucket, struct s_vending_index_bucket, 1);
+			VECTOR_INIT(bucket->entries);
+			idb_put(vending->item_index, nameid, bucket);
+		}
+
+		struct s_vending_index_entry entry = { 0 };
+		entry.value = sd->vending[i].value;
+		entry.char_id = sd->status.char_id;
+		entry.vender_id = sd->vender_id;
+		entry.slot = i;
+
+		VECTOR_ENSURE(bucket->entries, 1, 8);
+		VECTOR_INSERT(bucket->entries, vending->index_lowerbound(bucket, entry.value), entry);
+	}
+}
+
+/// Removes every stack of a shop from the item index.
+/// Must be called before the shop's stacks or cart items change.
+static void vending_index_remove(struct map_session_data *sd)
+{
+	nullpo_retv(sd);
+
+	for (int i = 0; i < sd->vend_num; i++) {
+		int nameid = sd->status.cart[sd->vending[i].index].nameid;
+		struct s_vending_index_bucket *bucket = idb_get(vending->item_index, nameid);
+		if (bucket == NULL)
+			continue; // already removed along with a previous stack of the same item
+
+		for (int j = VECTOR_LENGTH(bucket->entries) - 1; j >= 0; j--) {
+			if (VECTOR_INDEX(bucket->entries, j).char_id == sd->status.char_id)
+				VECTOR_ERASE(bucket->entries, j);
+		}
+
+		if (VECTOR_LENGTH(bucket->entries) == 0) {
+			idb_remove(vending->item_index, nameid);
+			VECTOR_CLEAR(bucket->entries);
+			aFree(bucket);
+		}
+	}
+}
+
+/**
+ * @see DBApply
+ */
+static int vending_index_final_sub(union DBKey key, struct DBData *data, va_list ap)
+{
+	struct s_vending_index_bucket *bucket = DB->data2ptr(data);
+
+	VECTOR_CLEAR(bucket->entries);
+	aFree(bucket);
+	return 0;
+}
+
 static void final(void)
 {
 	db_destroy(vending->db);
+	vending->item_index->destroy(vending->item_index, vending->index_final_sub);
 }
 
 static void init(bool minimal)
 {
 	vending->db = idb_alloc(DB_OPT_BASE);
+	vending->item_index = idb_alloc(DB_OPT_BASE);
 	vending->next_id = 0;
 }
 
@@ -415,4 +557,10 @@ void vending_defaults(void)
 	vending->purchase = vending_purchasereq;
 	vending->search = vending_search;
 	vending->searchall = vending_searchall;
+	vending->searchindex = vending_searchindex;
+	vending->search_cards = vending_search_cards;
+	vending->index_add = vending_index_add;
+	vending->index_remove = vending_index_remove;
+	vending->index_lowerbound = vending_index_lowerbound;
+	vending->index_final_sub = vending_index_final_sub;
 }
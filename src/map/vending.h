@@ -22,9 +22,10 @@
 #define MAP_VENDING_H
 
 #include "common/hercules.h"
+#include "common/db.h"
 
 /* Forward Declarations */
-struct DBMap; // common/db.h
+struct item;
 struct map_session_data;
 struct s_search_store_search;
 struct CZ_PURCHASE_ITEM_FROMMC;
@@ -35,9 +36,23 @@ struct s_vending {
 	unsigned int value; //at which price
 };
 
+/// A vended stack, as stored in vending->item_index.
+struct s_vending_index_entry {
+	unsigned int value;     ///< Price, buckets are sorted by it
+	int char_id;            ///< Vendor, key in vending->db
+	unsigned int vender_id; ///< Shop the entry belongs to, used to detect stale entries
+	short slot;             ///< Index in the vendor's sd->vending
+};
+
+/// All vended stacks of a single item id, sorted by ascending price.
+struct s_vending_index_bucket {
+	VECTOR_DECL(struct s_vending_index_entry) entries;
+};
+
 struct vending_interface {
 	unsigned int next_id;/* next vender id */
 	struct DBMap *db;
+	struct DBMap *item_index; ///< nameid -> struct s_vending_index_bucket
 	/* */
 	void (*init) (bool minimal);
 	void (*final) (void);
@@ -48,6 +63,12 @@ struct vending_interface {
 	void (*purchase) (struct map_session_data* sd, int aid, unsigned int uid, const struct CZ_PURCHASE_ITEM_FROMMC *data, int count);
 	bool (*search) (struct map_session_data* sd, int nameid);
 	bool (*searchall) (struct map_session_data* sd, const struct s_search_store_search* s);
+	bool (*searchindex) (const struct s_search_store_search *s);
+	bool (*search_cards) (const struct item *it, const struct s_search_store_search *s);
+	void (*index_add) (struct map_session_data *sd);
+	void (*index_remove) (struct map_session_data *sd);
+	int (*index_lowerbound) (const struct s_vending_index_bucket *bucket, unsigned int value);
+	int (*index_final_sub) (union DBKey key, struct DBData *data, va_list ap);
 };
 
 #ifdef HERCULES_CORE
@@ -165,6 +165,7 @@ PRAGMA_GCC5(GCC diagnostic pop)
 #include "common/memmgr.h"
 #include "common/mutex.h"
 #include "common/nullpo.h"
+#include "common/profiler.h"
 #include "common/random.h"
 #include "common/showmsg.h"
 #include "common/socket.h"
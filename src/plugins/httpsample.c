@@ -124,7 +124,7 @@ HTTP_URL(my_sample_test_simple)
 	httpsender->send_html(fd, buf);
 
 	// terminating http connection
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 
 	return true;
 }
@@ -171,7 +171,7 @@ HTTP_DATA(my_sample_test_login)
 	httpsender->send_html(fd, buf);
 
 	// terminating http connection here after we got requested data from login server
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 // runs on api server
@@ -216,7 +216,7 @@ HTTP_DATA(my_sample_test_char)
 	httpsender->send_html(fd, buf);
 
 	// terminating http connection here after we got requested data from char server
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 // runs on api server
@@ -261,7 +261,7 @@ HTTP_DATA(my_sample_test_map)
 	httpsender->send_html(fd, buf);
 
 	// terminating http connection here after we got requested data from char server
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 HTTP_URL(my_sample_test_user)
@@ -315,7 +315,7 @@ HTTP_DATA(my_sample_test_user)
 	}
 	httpsender->send_html(fd, buf);
 	// terminating http connection here after we got requested data from char server
-	aclif->terminate_connection(fd);
+	aclif->complete_request(fd);
 }
 
 // runs on login server
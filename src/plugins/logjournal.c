@@ -0,0 +1,532 @@
+/**
+ * This file is part of Hercules.
+ * http://herc.ws - http://github.com/HerculesWS/Hercules
+ *
+ * Copyright (C) 2024 Hercules Dev Team
+ *
+ * Hercules is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Log Journal Plugin
+ * Filters the binary log journal segments (map_log/database/use_journal)
+ * and exports the matching records to CSV or SQL.
+ *
+ * Usage:
+ *   ./map-server --load-plugin logjournal [filters] --journal-export <file or folder>
+ * Filters:
+ *   --journal-type <branch|pick|zeny|mvp|command|npc|chat>
+ *   --journal-char <char_id>
+ *   --journal-item <item_id>
+ *   --journal-unique <unique_id>
+ *   --journal-from <YYYY-MM-DD[ HH:MM:SS]>
+ *   --journal-to <YYYY-MM-DD[ HH:MM:SS]>
+ *   --journal-format <csv|sql>
+ *   --journal-out <file>
+ **/
+
+#include "common/hercules.h" /* Should always be the first Hercules file included! (if you don't make it first, you won't be able to use interfaces) */
+
+#include "common/cbasetypes.h"
+#include "common/db.h"
+#include "common/memmgr.h"
+#include "common/mmo.h"
+#include "common/nullpo.h"
+#include "common/sql.h"
+#include "common/strlib.h"
+#include "map/log.h"
+#include "map/map.h"
+
+#include "common/HPMDataCheck.h" /* should always be the last Hercules file included! (if you don't make it last, it'll intentionally break compile time) */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef WIN32
+#	include "common/winapi.h"
+#else
+#	include <dirent.h>
+#endif
+
+HPExport struct hplugin_info pinfo = {
+	"LogJournal",    ///< Plugin name
+	SERVER_TYPE_MAP, ///< Which server types this plugin works with?
+	"1.0.0",         ///< Plugin version
+	HPM_VERSION,     ///< HPM Version (don't change, macro is automatically updated)
+};
+
+/// Record type names used by --journal-type and the CSV output, indexed by enum log_target
+const char *journal_target_names[LOG_TARGET_MAX] = { "branch", "pick", "zeny", "mvp", "command", "npc", "chat" };
+
+/// Export settings, set from the command line.
+struct {
+	char path[256];       ///< Segment file or folder to read
+	char out[256];        ///< Output file (empty for the default)
+	bool sql;             ///< Export as SQL instead of CSV
+	int target;           ///< Record type filter (-1 for any)
+	int char_id;          ///< Character filter (0 for any)
+	int nameid;           ///< Item filter (0 for any)
+	uint64 unique_id;     ///< Item unique id filter (0 for any)
+	int64 from, to;       ///< Time range filter
+	bool torun;           ///< Whether the export will run
+} journal_export = { .target = -1, .to = INT64_MAX };
+
+/// Segment files found in the export path
+VECTOR_DECL(char *) journal_files;
+
+/**
+ * Parses a 'YYYY-MM-DD[ HH:MM:SS]' date in local time.
+ *
+ * @param str The date to parse.
+ * @param out Where to store the parsed time.
+ * @retval false if the date is invalid.
+ */
+bool journal_parse_time(const char *str, int64 *out)
+{
+	struct tm t = { 0 };
+
+	nullpo_retr(false, str);
+	nullpo_retr(false, out);
+
+	if (sscanf(str, "%d-%d-%d %d:%d:%d", &t.tm_year, &t.tm_mon, &t.tm_mday, &t.tm_hour, &t.tm_min, &t.tm_sec) < 3) {
+		ShowError("journal_parse_time: Invalid date '%s' (expected YYYY-MM-DD or 'YYYY-MM-DD HH:MM:SS').\n", str);
+		return false;
+	}
+	t.tm_year -= 1900;
+	t.tm_mon -= 1;
+	t.tm_isdst = -1;
+	*out = (int64)mktime(&t);
+	return true;
+}
+
+/**
+ * Collects the segment files of a folder, or the path itself when it's a file.
+ * (utils.c findfile isn't available to plugins)
+ *
+ * @param path Segment file or folder.
+ */
+void journal_find_files(const char *path)
+{
+	char filename[512];
+	size_t ext_len = strlen(LOG_JOURNAL_EXT);
+#ifdef WIN32
+	WIN32_FIND_DATAA data;
+	HANDLE find;
+
+	nullpo_retv(path);
+
+	snprintf(filename, sizeof(filename), "%s\\*" LOG_JOURNAL_EXT, path);
+	if ((find = FindFirstFileA(filename, &data)) == INVALID_HANDLE_VALUE) {
+		VECTOR_PUSH(journal_files, aStrdup(path));
+		return;
+	}
+	do {
+		size_t len = strlen(data.cFileName);
+		if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 || len <= ext_len || strcmp(data.cFileName + len - ext_len, LOG_JOURNAL_EXT) != 0)
+			continue;
+		snprintf(filename, sizeof(filename), "%s\\%s", path, data.cFileName);
+		VECTOR_PUSH(journal_files, aStrdup(filename));
+	} while (FindNextFileA(find, &data) != 0);
+	FindClose(find);
+#else
+	DIR *dir;
+	struct dirent *entry;
+
+	nullpo_retv(path);
+
+	if ((dir = opendir(path)) == NULL) {
+		VECTOR_PUSH(journal_files, aStrdup(path));
+		return;
+	}
+	while ((entry = readdir(dir)) != NULL) {
+		size_t len = strlen(entry->d_name);
+		if (len <= ext_len || strcmp(entry->d_name + len - ext_len, LOG_JOURNAL_EXT) != 0)
+			continue;
+		snprintf(filename, sizeof(filename), "%s/%s", path, entry->d_name);
+		VECTOR_PUSH(journal_files, aStrdup(filename));
+	}
+	closedir(dir);
+#endif
+}
+
+/**
+ * Sorts segment files by name, which is their chronological order.
+ */
+int journal_file_cmp(const void *a, const void *b)
+{
+	return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+/**
+ * Checks whether a segment may hold records matching the filters.
+ */
+bool journal_header_match(const struct log_journal_header *header)
+{
+	nullpo_retr(false, header);
+
+	if (header->count == 0)
+		return false;
+	if (header->max_time < journal_export.from || header->min_time > journal_export.to)
+		return false;
+	// zeny records also match their source character, which isn't indexed
+	if (journal_export.char_id != 0 && (journal_export.char_id < header->min_char_id || journal_export.char_id > header->max_char_id)
+	 && (header->targets & (1U << LOG_TARGET_ZENY)) == 0)
+		return false;
+	if (journal_export.target != -1 && (header->targets & (1U << journal_export.target)) == 0)
+		return false;
+	return true;
+}
+
+/**
+ * Checks whether a record matches the filters.
+ */
+bool journal_record_match(const struct log_journal_record *record)
+{
+	nullpo_retr(false, record);
+
+	if (record->target >= LOG_TARGET_MAX)
+		return false;
+	if (journal_export.target != -1 && record->target != journal_export.target)
+		return false;
+	if (record->time < journal_export.from || record->time > journal_export.to)
+		return false;
+	if (journal_export.char_id != 0 && record->char_id != journal_export.char_id
+	 && !(record->target == LOG_TARGET_ZENY && record->id == journal_export.char_id))
+		return false;
+	if (journal_export.nameid != 0 && (record->target != LOG_TARGET_PICK && record->target != LOG_TARGET_MVPDROP))
+		return false;
+	if (journal_export.nameid != 0 && record->nameid != journal_export.nameid)
+		return false;
+	if (journal_export.unique_id != 0 && (record->target != LOG_TARGET_PICK || record->unique_id != journal_export.unique_id))
+		return false;
+	return true;
+}
+
+/**
+ * Writes a string as a quoted CSV field.
+ */
+void journal_csv_string(FILE *fp, const char *str, size_t len)
+{
+	size_t i;
+
+	nullpo_retv(fp);
+	nullpo_retv(str);
+
+	fputc('"', fp);
+	for (i = 0; i < len && str[i] != '\0'; i++) {
+		if (str[i] == '"')
+			fputc('"', fp);
+		fputc(str[i], fp);
+	}
+	fputc('"', fp);
+}
+
+/**
+ * Writes a record as a CSV line.
+ */
+static void journal_write_csv(FILE *fp, const struct log_journal_record *record, const char *text)
+{
+	char timestring[32];
+	time_t t;
+	int i;
+
+	nullpo_retv(fp);
+	nullpo_retv(record);
+	nullpo_retv(text);
+
+	t = (time_t)record->time;
+	strftime(timestring, sizeof(timestring), "%Y-%m-%d %H:%M:%S", localtime(&t));
+	fprintf(fp, "%s,%s,%c,%d,%d,%d,%d,%d,%d,%d", timestring, journal_target_names[record->target], record->type != '\0' ? record->type : ' ',
+	        record->char_id, record->account_id, record->id, record->nameid, record->amount, record->refine, record->grade);
+	for (i = 0; i < MAX_SLOTS; i++)
+		fprintf(fp, ",%d", record->card[i]);
+	for (i = 0; i < MAX_ITEM_OPTIONS; i++)
+		fprintf(fp, ",%d,%d", record->option[i].index, record->option[i].value);
+	fprintf(fp, ",%"PRIu64",", record->unique_id);
+	journal_csv_string(fp, record->map, sizeof(record->map));
+	fprintf(fp, ",%d,%d,", record->x, record->y);
+	journal_csv_string(fp, record->name, sizeof(record->name));
+	fputc(',', fp);
+	journal_csv_string(fp, text, record->text_len);
+	fputc('\n', fp);
+}
+
+/**
+ * Writes a record as an INSERT into its log table, using the same
+ * columns as the SQL log backend.
+ */
+static void journal_write_sql(FILE *fp, const struct log_journal_record *record, const char *text)
+{
+	char timestring[32];
+	char map_name[MAP_NAME_LENGTH_EXT * 2 + 1];
+	char name[NAME_LENGTH * 2 + 1];
+	char esc_text[CHAT_SIZE_MAX * 2 + 1];
+	time_t t;
+
+	nullpo_retv(fp);
+	nullpo_retv(record);
+	nullpo_retv(text);
+
+	t = (time_t)record->time;
+	strftime(timestring, sizeof(timestring), "%Y-%m-%d %H:%M:%S", localtime(&t));
+	SQL->EscapeStringLen(NULL, map_name, record->map, strnlen(record->map, sizeof(record->map)));
+	SQL->EscapeStringLen(NULL, name, record->name, strnlen(record->name, sizeof(record->name)));
+	SQL->EscapeStringLen(NULL, esc_text, text, min(record->text_len, CHAT_SIZE_MAX));
+
+	fprintf(fp, "%s INTO `%s` %s VALUES ", LOG_QUERY, logs->target_name(record->target), logs->get_sql_columns(record->target));
+	switch (record->target) {
+	case LOG_TARGET_BRANCH:
+		fprintf(fp, "('%s', '%d', '%d', '%s', '%s');\n", timestring, record->account_id, record->char_id, name, map_name);
+		break;
+	case LOG_TARGET_PICK:
+		fprintf(fp, "('%s', '%d', '%c', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%d', '%s', '%"PRIu64"');\n",
+		        timestring, record->char_id, record->type, record->nameid, record->amount, record->refine, record->grade,
+		        record->card[0], record->card[1], record->card[2], record->card[3],
+		        record->option[0].index, record->option[0].value, record->option[1].index, record->option[1].value, record->option[2].index, record->option[2].value,
+		        record->option[3].index, record->option[3].value, record->option[4].index, record->option[4].value,
+		        map_name, record->unique_id);
+		break;
+	case LOG_TARGET_ZENY:
+		fprintf(fp, "('%s', '%d', '%d', '%c', '%d', '%s');\n", timestring, record->char_id, record->id, record->type, record->amount, map_name);
+		break;
+	case LOG_TARGET_MVPDROP:
+		fprintf(fp, "('%s', '%d', '%d', '%d', '%d', '%s');\n", timestring, record->char_id, record->id, record->nameid, record->amount, map_name);
+		break;
+	case LOG_TARGET_GM:
+	case LOG_TARGET_NPC:
+		fprintf(fp, "('%s', '%d', '%d', '%s', '%s', '%s');\n", timestring, record->account_id, record->char_id, name, map_name, esc_text);
+		break;
+	case LOG_TARGET_CHAT:
+		fprintf(fp, "('%s', '%c', '%d', '%d', '%d', '%s', '%d', '%d', '%s', '%s');\n",
+		        timestring, record->type, record->id, record->char_id, record->account_id, map_name, record->x, record->y, name, esc_text);
+		break;
+	case LOG_TARGET_MAX:
+		break;
+	}
+}
+
+/**
+ * Exports the matching records of a segment file.
+ *
+ * @param fp       Output file.
+ * @param filename Segment file.
+ * @return Number of records exported.
+ */
+int journal_export_file(FILE *fp, const char *filename)
+{
+	struct log_journal_header header;
+	uint8 *buf;
+	size_t len, pos;
+	int exported = 0;
+	FILE *in;
+
+	nullpo_ret(fp);
+	nullpo_ret(filename);
+
+	if ((in = fopen(filename, "rb")) == NULL) {
+		ShowError("journal_export_file: Failed to open '%s'.\n", filename);
+		return 0;
+	}
+	if (fread(&header, sizeof(header), 1, in) != 1 || memcmp(header.magic, LOG_JOURNAL_MAGIC, sizeof(header.magic)) != 0) {
+		ShowError("journal_export_file: '%s' isn't a log journal segment.\n", filename);
+		fclose(in);
+		return 0;
+	}
+	if (header.version != LOG_JOURNAL_VERSION) {
+		ShowError("journal_export_file: '%s' has version %u, only version %d is supported.\n", filename, header.version, LOG_JOURNAL_VERSION);
+		fclose(in);
+		return 0;
+	}
+	if (!journal_header_match(&header) || header.used <= sizeof(header)) {
+		fclose(in);
+		return 0;
+	}
+
+	len = (size_t)(header.used - sizeof(header));
+	buf = aMalloc(len);
+	len = fread(buf, 1, len, in);
+	fclose(in);
+
+	for (pos = 0; pos + sizeof(struct log_journal_record) <= len; ) {
+		struct log_journal_record record;
+		memcpy(&record, buf + pos, sizeof(record));
+		if (record.size < sizeof(record) || pos + record.size > len
+		 || record.target >= LOG_TARGET_MAX || record.text_len > record.size - sizeof(record)) {
+			ShowWarning("journal_export_file: '%s' is truncated or corrupted at offset %"PRIuS".\n", filename, pos + sizeof(header));
+			break;
+		}
+		if (journal_record_match(&record)) {
+			const char *text = (const char *)buf + pos + sizeof(record);
+			if (journal_export.sql)
+				journal_write_sql(fp, &record, record.text_len > 0 ? text : "");
+			else
+				journal_write_csv(fp, &record, record.text_len > 0 ? text : "");
+			exported++;
+		}
+		pos += record.size;
+	}
+
+	aFree(buf);
+	return exported;
+}
+
+/**
+ * Exports the matching records of all segments in journal_export.path.
+ */
+bool journal_export_run(void)
+{
+	FILE *fp;
+	int i, exported = 0;
+
+	journal_find_files(journal_export.path);
+	if (VECTOR_LENGTH(journal_files) == 0) {
+		ShowError("journal_export_run: No journal segment (*" LOG_JOURNAL_EXT ") found in '%s'.\n", journal_export.path);
+		return false;
+	}
+	qsort(VECTOR_DATA(journal_files), VECTOR_LENGTH(journal_files), sizeof(char *), journal_file_cmp);
+
+	if (journal_export.out[0] == '\0')
+		safestrncpy(journal_export.out, journal_export.sql ? "log/journal_export.sql" : "log/journal_export.csv", sizeof(journal_export.out));
+	if ((fp = fopen(journal_export.out, "w")) == NULL) {
+		ShowError("journal_export_run: Failed to create '%s'.\n", journal_export.out);
+		return false;
+	}
+
+	if (journal_export.sql) {
+		// table names are read from the log configuration
+		logs->config_read(map->LOG_CONF_NAME, false);
+	} else {
+		fprintf(fp, "time,type,subtype,char_id,account_id,id,nameid,amount,refine,grade");
+		for (i = 0; i < MAX_SLOTS; i++)
+			fprintf(fp, ",card%d", i);
+		for (i = 0; i < MAX_ITEM_OPTIONS; i++)
+			fprintf(fp, ",opt_idx%d,opt_val%d", i, i);
+		fprintf(fp, ",unique_id,map,x,y,name,text\n");
+	}
+
+	for (i = 0; i < VECTOR_LENGTH(journal_files); i++)
+		exported += journal_export_file(fp, VECTOR_INDEX(journal_files, i));
+	fclose(fp);
+
+	ShowStatus("Exported %d records from %d journal segments to '%s'.\n", exported, VECTOR_LENGTH(journal_files), journal_export.out);
+	return true;
+}
+
+CMDLINEARG(journalexport)
+{
+	map->minimal = true;
+	journal_export.torun = true;
+	safestrncpy(journal_export.path, params, sizeof(journal_export.path));
+	return true;
+}
+
+CMDLINEARG(journalout)
+{
+	safestrncpy(journal_export.out, params, sizeof(journal_export.out));
+	return true;
+}
+
+CMDLINEARG(journalformat)
+{
+	if (strcmpi(params, "csv") == 0) {
+		journal_export.sql = false;
+	} else if (strcmpi(params, "sql") == 0) {
+		journal_export.sql = true;
+	} else {
+		ShowError("--journal-format: Unknown format '%s' (expected csv or sql).\n", params);
+		return false;
+	}
+	return true;
+}
+
+CMDLINEARG(journaltype)
+{
+	int i;
+
+	ARR_FIND(0, LOG_TARGET_MAX, i, strcmpi(params, journal_target_names[i]) == 0);
+	if (i == LOG_TARGET_MAX) {
+		ShowError("--journal-type: Unknown record type '%s'.\n", params);
+		return false;
+	}
+	journal_export.target = i;
+	return true;
+}
+
+CMDLINEARG(journalchar)
+{
+	journal_export.char_id = atoi(params);
+	return true;
+}
+
+CMDLINEARG(journalitem)
+{
+	journal_export.nameid = atoi(params);
+	return true;
+}
+
+CMDLINEARG(journalunique)
+{
+	journal_export.unique_id = strtoull(params, NULL, 10);
+	return true;
+}
+
+CMDLINEARG(journalfrom)
+{
+	return journal_parse_time(params, &journal_export.from);
+}
+
+CMDLINEARG(journalto)
+{
+	return journal_parse_time(params, &journal_export.to);
+}
+
+HPExport void server_preinit(void)
+{
+	addArg("--journal-export", true, journalexport,
+			"Exports the log journal segments in a file or folder (usage: --journal-export <path>).");
+	addArg("--journal-out", true, journalout,
+			"Output file of --journal-export (default: log/journal_export.csv or .sql).");
+	addArg("--journal-format", true, journalformat,
+			"Output format of --journal-export: csv (default) or sql.");
+	addArg("--journal-type", true, journaltype,
+			"Only exports one record type: branch, pick, zeny, mvp, command, npc or chat.");
+	addArg("--journal-char", true, journalchar,
+			"Only exports records of a character id.");
+	addArg("--journal-item", true, journalitem,
+			"Only exports pick and MVP records of an item id.");
+	addArg("--journal-unique", true, journalunique,
+			"Only exports pick records of an item unique id.");
+	addArg("--journal-from", true, journalfrom,
+			"Only exports records since a date (YYYY-MM-DD or 'YYYY-MM-DD HH:MM:SS').");
+	addArg("--journal-to", true, journalto,
+			"Only exports records until a date (YYYY-MM-DD or 'YYYY-MM-DD HH:MM:SS').");
+
+	VECTOR_INIT(journal_files);
+}
+
+HPExport void server_online(void)
+{
+	if (journal_export.torun)
+		journal_export_run();
+}
+
+HPExport void plugin_final(void)
+{
+	while (VECTOR_LENGTH(journal_files) > 0) {
+		char *name = VECTOR_POP(journal_files);
+		aFree(name);
+	}
+	VECTOR_CLEAR(journal_files);
+}
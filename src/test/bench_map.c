@@ -0,0 +1,1291 @@
+/**
+ * This file is part of Hercules.
+ * http://herc.ws - http://github.com/HerculesWS/Hercules
+ *
+ * Copyright (C) 2024 Hercules Dev Team
+ *
+ * Hercules is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * End-to-end benchmark of the map-server.
+ *
+ * Headless bots log in through the login, char and map servers the same way
+ * the client does, using the packet definitions of the compiled client
+ * version, then play a scripted scenario. The round trip of the tick request
+ * (CZ_REQUEST_TIME), which is answered from the map-server main loop, is
+ * sampled every second by every bot to measure the tick latency.
+ *
+ * Usage:
+ *   1. create the bot accounts and characters (sql-files/tools/bench_accounts.sql)
+ *   2. disable the pincode system in the char-server configuration
+ *   3. start the login, char and map servers
+ *   4. run: ./bench_map --scenario town --bots 500 --map-pid <map-server pid>
+ *
+ * Or from top directory: make bench
+ */
+
+#define HERCULES_CORE
+
+#include "common/cbasetypes.h"
+#include "common/core.h"
+#include "common/db.h"
+#include "common/memmgr.h"
+#include "common/mmo.h"
+#include "common/nullpo.h"
+#include "common/packets.h"
+#include "common/random.h"
+#include "common/showmsg.h"
+#include "common/socket.h"
+#include "common/strlib.h"
+#include "common/timer.h"
+#include "login/packets_ac_struct.h"
+#include "login/packets_ca_struct.h"
+#include "map/mapdefines.h"
+#include "map/packets_struct.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+/// Maximum amount of field offsets of a map-server packet.
+#define BENCH_PACKET_POS 8
+
+/// Delay between the setup steps of a scenario, in milliseconds.
+#define BENCH_SETUP_DELAY 500
+
+/// Time given to the bots to log in before the measurement starts anyway, in milliseconds.
+#define BENCH_LOGIN_TIMEOUT 60000
+
+/// Maximum amount of bots, so that their number fits the 4 digits appended to the account prefix.
+#define BENCH_MAX_BOTS 9999
+
+/// Size of the account name prefix, leaving room for the bot number.
+#define BENCH_PREFIX_LENGTH (NAME_LENGTH - 4)
+
+/// Map-server client packets used by the bots, by handler.
+enum bench_packet_type {
+	BP_WANTTOCONNECTION,
+	BP_LOADENDACK,
+	BP_TICKSEND,
+	BP_WALKTOXY,
+	BP_ACTIONREQUEST,
+	BP_GLOBALMESSAGE,
+	BP_USESKILLTOID,
+	BP_USESKILLTOPOS,
+	BP_PUTITEMTOCART,
+	BP_OPENVENDING,
+	BP_SEARCHSTOREINFO,
+	BP_MAX
+};
+
+/// A map-server client packet, as defined in map/packets.h for the compiled client version.
+struct bench_packet {
+	const char *func;           ///< Name of the map-server handler.
+	int id;                     ///< Packet ID (0 if the client version doesn't have it).
+	int pos[BENCH_PACKET_POS];  ///< Field offsets.
+};
+
+/// Login progress of a bot.
+enum bench_bot_state {
+	BOT_IDLE,
+	BOT_LOGIN,
+	BOT_CHAR,
+	BOT_MAP,
+	BOT_READY,
+	BOT_FAILED,
+};
+
+/// A headless client.
+struct bench_bot {
+	int index;
+	char userid[NAME_LENGTH];
+	enum bench_bot_state state;
+	int fd;
+	bool got_aid;         ///< Whether the raw account ID sent by the char and map servers was received.
+	bool char_selected;
+
+	int account_id;
+	int char_id;
+	uint32 login_id1;
+	uint32 login_id2;
+	uint8 sex;
+	uint32 map_ip;
+	uint16 map_port;
+	uint32 crypt_key;     ///< Packet obfuscation key of the next packet.
+
+	short x, y;
+	int setup_step;       ///< Next scenario setup step (-1 when done).
+	int act_count;
+	int act_tid;
+	int ping_tid;
+
+	uint64 connect_time;  ///< Performance counter value when the login started.
+	uint64 ping_time;     ///< Performance counter value of the pending tick request (0 if none).
+	uint64 move_time;     ///< Performance counter value of the pending move request (0 if none).
+};
+
+/// Session data of a bot connection.
+struct bench_session {
+	struct bench_bot *bot;
+};
+
+/// A scripted scenario.
+struct bench_scenario {
+	const char *name;
+	const char *description;
+	int interval;                                          ///< Default delay between two actions, in milliseconds.
+	bool (*setup) (struct bench_bot *bot, int step);       ///< Runs a setup step, returns false when there are no more.
+	void (*act) (struct bench_bot *bot);                   ///< Runs an action.
+};
+
+/// Latency samples, in microseconds.
+VECTOR_STRUCT_DECL(bench_samples, uint32);
+
+/// Benchmark state.
+static struct {
+	char login_ip_str[64];
+	uint16 login_port;
+	int bot_count;
+	char prefix[BENCH_PREFIX_LENGTH];
+	char password[NAME_LENGTH];
+	const struct bench_scenario *scenario;
+	int interval;
+	int duration;
+	int ramp;
+	int map_pid;
+	bool obfuscation;
+	char csv[256];
+
+	uint32 login_ip;
+	uint32 keys[3];
+	struct bench_packet packets[BP_MAX];
+	struct bench_bot *bots;
+	int started;
+	int ready;
+	int failed;
+
+	bool measuring;
+	uint64 measure_start;
+	int64 ramp_end_tick;
+	uint64 bytes_in;
+	uint64 bytes_out;
+	uint64 cpu_start;
+	struct bench_samples ping;
+	struct bench_samples move;
+	struct bench_samples login;
+} bench;
+
+static void bench_send(struct bench_bot *bot, int len);
+static void bench_fail(struct bench_bot *bot, const char *reason);
+
+/*==========================================
+ * Packets
+ *------------------------------------------*/
+
+/**
+ * Records a map-server packet definition.
+ *
+ * Later definitions override earlier ones, as the packet shuffle of the
+ * client version is included after the base packets.
+ *
+ * @param id   Packet ID.
+ * @param args The stringified handler and field offsets (e.g. "clif->pWalkToXY,2").
+ */
+static void bench_addpacket(int id, const char *args)
+{
+	char buf[256];
+	char *func, *pos, *next;
+	int i, n;
+
+	safestrncpy(buf, args, sizeof(buf));
+	if ((func = strstr(buf, "->")) == NULL)
+		return;
+	func += 2;
+	if ((pos = strchr(func, ',')) != NULL)
+		*pos++ = '\0';
+	normalize_name(func, " \t");
+
+	ARR_FIND(0, BP_MAX, i, strcmp(bench.packets[i].func, func) == 0);
+	if (i == BP_MAX)
+		return;
+
+	bench.packets[i].id = id;
+	memset(bench.packets[i].pos, 0, sizeof(bench.packets[i].pos));
+	for (n = 0; pos != NULL && n < BENCH_PACKET_POS; n++, pos = next) {
+		if ((next = strchr(pos, ',')) != NULL)
+			*next++ = '\0';
+		bench.packets[i].pos[n] = (int)strtol(pos, NULL, 0);
+	}
+}
+
+/**
+ * Loads the map-server packet definitions and obfuscation keys of the compiled client version.
+ */
+static bool bench_loadpackets(void)
+{
+	static const char *funcs[BP_MAX] = {
+		"pWantToConnection", "pLoadEndAck", "pTickSend", "pWalkToXY", "pActionRequest", "pGlobalMessage",
+		"pUseSkillToId", "pUseSkillToPos", "pPutItemToCart", "pOpenVending", "pSearchStoreInfo",
+	};
+	int i;
+
+	for (i = 0; i < BP_MAX; i++)
+		bench.packets[i].func = funcs[i];
+
+#define packet(id, ...) bench_addpacket((id), #__VA_ARGS__)
+#include "map/packets.h"
+#ifdef PACKETVER_ZERO
+#include "map/packets_shuffle_zero.h"
+#elif defined(PACKETVER_RE)
+#include "map/packets_shuffle_re.h"
+#else  // PACKETVER_ZERO
+#include "map/packets_shuffle_main.h"
+#endif  // PACKETVER_ZERO
+#undef packet
+#define packetKeys(a,b,c) do { bench.keys[0] = (a); bench.keys[1] = (b); bench.keys[2] = (c); } while(0)
+#if defined(OBFUSCATIONKEY1) && defined(OBFUSCATIONKEY2) && defined(OBFUSCATIONKEY3)
+	packetKeys(OBFUSCATIONKEY1,OBFUSCATIONKEY2,OBFUSCATIONKEY3);
+#else  // defined(OBFUSCATIONKEY1) && defined(OBFUSCATIONKEY2) && defined(OBFUSCATIONKEY3)
+#ifdef PACKETVER_ZERO
+#include "map/packets_keys_zero.h"
+#else  // PACKETVER_ZERO
+#include "map/packets_keys_main.h"
+#endif  // PACKETVER_ZERO
+#endif  // defined(OBFUSCATIONKEY1) && defined(OBFUSCATIONKEY2) && defined(OBFUSCATIONKEY3)
+#undef packetKeys
+
+	for (i = 0; i < BP_MAX; i++) {
+		if (bench.packets[i].id == 0 && i != BP_SEARCHSTOREINFO) {
+			ShowError("bench_loadpackets: Client version %d has no packet for %s.\n", PACKETVER, bench.packets[i].func);
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Returns the length of the packet at the front of the receive buffer.
+ *
+ * @return the length, 0 if the packet isn't complete yet or -1 if it is unknown.
+ */
+static int bench_packet_length(int fd)
+{
+	int cmd, len;
+
+	if (RFIFOREST(fd) < 2)
+		return 0;
+
+	cmd = RFIFOW(fd, 0);
+	if (cmd < MIN_PACKET_DB || cmd > MAX_PACKET_DB || (len = packets->db[cmd]) == 0)
+		return -1;
+	if (len == -1) {
+		if (RFIFOREST(fd) < 4)
+			return 0;
+		if ((len = RFIFOW(fd, 2)) < 4)
+			return -1;
+	}
+	if ((int)RFIFOREST(fd) < len)
+		return 0;
+	return len;
+}
+
+/**
+ * Starts writing a map-server packet.
+ *
+ * @param bot  The bot.
+ * @param type The packet.
+ * @param len  The packet length, or 0 for the fixed length of the packet.
+ * @return the packet length.
+ */
+static int bench_packet_begin(struct bench_bot *bot, enum bench_packet_type type, int len)
+{
+	const struct bench_packet *p = &bench.packets[type];
+
+	if (len == 0)
+		len = packets->db[p->id];
+	WFIFOHEAD(bot->fd, len);
+	memset(WFIFOP(bot->fd, 0), 0, len);
+	WFIFOW(bot->fd, 0) = p->id;
+	if (packets->db[p->id] == -1)
+		WFIFOW(bot->fd, 2) = len;
+	return len;
+}
+
+/// Returns the offset of a field of a map-server packet.
+static int bench_pos(enum bench_packet_type type, int field)
+{
+	return bench.packets[type].pos[field];
+}
+
+/*==========================================
+ * Statistics
+ *------------------------------------------*/
+
+/// Returns the time elapsed since a performance counter value, in microseconds.
+static uint32 bench_elapsed(uint64 since)
+{
+	return (uint32)((timer->perf_counter() - since) * 1000000 / timer->perf_frequency());
+}
+
+static void bench_sample(struct bench_samples *samples, uint32 value)
+{
+	if (!bench.measuring)
+		return;
+	VECTOR_ENSURE(*samples, 1, 1024);
+	VECTOR_PUSH(*samples, value);
+}
+
+static int bench_sample_cmp(const void *a, const void *b)
+{
+	uint32 va = *(const uint32 *)a, vb = *(const uint32 *)b;
+	return va < vb ? -1 : va > vb;
+}
+
+/// Returns a percentile of sorted samples, in milliseconds.
+static double bench_percentile(const struct bench_samples *samples, int percent)
+{
+	int i;
+
+	if (VECTOR_LENGTH(*samples) == 0)
+		return 0.;
+	i = (int)((int64)VECTOR_LENGTH(*samples) * percent / 100);
+	if (i >= VECTOR_LENGTH(*samples))
+		i = VECTOR_LENGTH(*samples) - 1;
+	return VECTOR_INDEX(*samples, i) / 1000.;
+}
+
+/**
+ * Returns the CPU time used by the map-server so far, in milliseconds.
+ *
+ * @return the CPU time, or 0 if it is unknown.
+ */
+static uint64 bench_cpu_time(void)
+{
+#ifdef __linux__
+	char path[64], buf[1024];
+	unsigned long utime = 0, stime = 0;
+	const char *p;
+	FILE *fp;
+	long hz = sysconf(_SC_CLK_TCK);
+
+	if (bench.map_pid <= 0 || hz <= 0)
+		return 0;
+
+	snprintf(path, sizeof(path), "/proc/%d/stat", bench.map_pid);
+	if ((fp = fopen(path, "r")) == NULL)
+		return 0;
+	if (fgets(buf, sizeof(buf), fp) == NULL) {
+		fclose(fp);
+		return 0;
+	}
+	fclose(fp);
+
+	// Skip the executable name, which may contain spaces
+	if ((p = strrchr(buf, ')')) == NULL
+	 || sscanf(p + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu", &utime, &stime) != 2)
+		return 0;
+	return (uint64)(utime + stime) * 1000 / hz;
+#else
+	return 0;
+#endif
+}
+
+static void bench_report_line(const char *name, struct bench_samples *samples)
+{
+	qsort(VECTOR_DATA(*samples), VECTOR_LENGTH(*samples), sizeof(uint32), bench_sample_cmp);
+	ShowMessage("%-14s count %8d  p50 %8.2f ms  p90 %8.2f ms  p99 %8.2f ms  max %8.2f ms\n", name, VECTOR_LENGTH(*samples),
+	            bench_percentile(samples, 50), bench_percentile(samples, 90), bench_percentile(samples, 99), bench_percentile(samples, 100));
+}
+
+/**
+ * Shows the benchmark results and appends them to the CSV file, if any.
+ */
+static void bench_report(void)
+{
+	double seconds = (double)(timer->perf_counter() - bench.measure_start) / timer->perf_frequency();
+	uint64 cpu = bench_cpu_time();
+	double cpu_ms = (cpu > 0 && bench.cpu_start > 0) ? (double)(cpu - bench.cpu_start) : -1.;
+	int players = max(bench.ready, 1);
+
+	if (seconds <= 0.)
+		seconds = 1.;
+
+	ShowMessage("===============================================================================\n");
+	ShowMessage("Scenario %s: %d bots (%d ready, %d failed), measured for %.1f s\n", bench.scenario->name,
+	            bench.bot_count, bench.ready, bench.failed, seconds);
+	bench_report_line("Tick latency", &bench.ping);
+	bench_report_line("Move latency", &bench.move);
+	bench_report_line("Login time", &bench.login);
+	ShowMessage("Bandwidth      in %.1f kB/s (%.1f B/s per player), out %.1f kB/s (%.1f B/s per player)\n",
+	            bench.bytes_in / 1024. / seconds, bench.bytes_in / seconds / players,
+	            bench.bytes_out / 1024. / seconds, bench.bytes_out / seconds / players);
+	if (cpu_ms >= 0.)
+		ShowMessage("map-server CPU %.1f%% (%.3f ms/s per player)\n", cpu_ms / seconds / 10., cpu_ms / seconds / players);
+	else
+		ShowMessage("map-server CPU unknown (use --map-pid)\n");
+	ShowMessage("===============================================================================\n");
+
+	if (bench.csv[0] != '\0') {
+		FILE *fp = fopen(bench.csv, "a+");
+		if (fp == NULL) {
+			ShowError("bench_report: Can't write '%s'.\n", bench.csv);
+			return;
+		}
+		fseek(fp, 0, SEEK_END);
+		if (ftell(fp) == 0)
+			fprintf(fp, "scenario,bots,ready,seconds,tick_p50,tick_p90,tick_p99,tick_max,move_p50,move_p99,"
+			            "login_p50,bytes_in_per_player,bytes_out_per_player,cpu_ms_per_player\n");
+		fprintf(fp, "%s,%d,%d,%.1f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f,%.4f\n", bench.scenario->name,
+		        bench.bot_count, bench.ready, seconds,
+		        bench_percentile(&bench.ping, 50), bench_percentile(&bench.ping, 90),
+		        bench_percentile(&bench.ping, 99), bench_percentile(&bench.ping, 100),
+		        bench_percentile(&bench.move, 50), bench_percentile(&bench.move, 99), bench_percentile(&bench.login, 50),
+		        bench.bytes_in / seconds / players, bench.bytes_out / seconds / players,
+		        cpu_ms >= 0. ? cpu_ms / seconds / players : -1.);
+		fclose(fp);
+	}
+}
+
+/*==========================================
+ * Map-server actions
+ *------------------------------------------*/
+
+/**
+ * Sends a map-server packet, obfuscating its ID like the client does.
+ */
+static void bench_send(struct bench_bot *bot, int len)
+{
+	if (bench.obfuscation) {
+		WFIFOW(bot->fd, 0) = WFIFOW(bot->fd, 0) ^ ((bot->crypt_key >> 16) & 0x7FFF);
+		bot->crypt_key = bot->crypt_key * bench.keys[1] + bench.keys[2];
+	}
+	bench.bytes_out += len;
+	WFIFOSET(bot->fd, len);
+}
+
+/**
+ * Sends a chat message (or an atcommand) to the map-server.
+ */
+static void bench_say(struct bench_bot *bot, const char *message)
+{
+	char text[CHAT_SIZE_MAX];
+	int text_len, len;
+
+	text_len = snprintf(text, sizeof(text), "%s : %s", bot->userid, message) + 1;
+	text_len = min(text_len, (int)sizeof(text));
+	len = bench_packet_begin(bot, BP_GLOBALMESSAGE, bench_pos(BP_GLOBALMESSAGE, 1) + text_len);
+	memcpy(WFIFOP(bot->fd, bench_pos(BP_GLOBALMESSAGE, 1)), text, text_len);
+	WFIFOB(bot->fd, len - 1) = '\0';
+	bench_send(bot, len);
+}
+
+static void bench_walk(struct bench_bot *bot, short x, short y)
+{
+	int len = bench_packet_begin(bot, BP_WALKTOXY, 0);
+	uint8 *p = WFIFOP(bot->fd, bench_pos(BP_WALKTOXY, 0));
+
+	p[0] = (uint8)(x >> 2);
+	p[1] = (uint8)((x << 6) | ((y >> 4) & 0x3f));
+	p[2] = (uint8)(y << 4);
+	if (bot->move_time == 0)
+		bot->move_time = timer->perf_counter();
+	bench_send(bot, len);
+}
+
+/// Walks to a random cell around the current position.
+static void bench_wander(struct bench_bot *bot, int range)
+{
+	bench_walk(bot, (short)max(bot->x + rnd->value(-range, range), 1), (short)max(bot->y + rnd->value(-range, range), 1));
+}
+
+static void bench_attack(struct bench_bot *bot, int target_id)
+{
+	int len = bench_packet_begin(bot, BP_ACTIONREQUEST, 0);
+
+	WFIFOL(bot->fd, bench_pos(BP_ACTIONREQUEST, 0)) = target_id;
+	WFIFOB(bot->fd, bench_pos(BP_ACTIONREQUEST, 1)) = 7; // continuous attack
+	bench_send(bot, len);
+}
+
+static void bench_skill_id(struct bench_bot *bot, int skill_id, int skill_lv, int target_id)
+{
+	int len = bench_packet_begin(bot, BP_USESKILLTOID, 0);
+
+	WFIFOW(bot->fd, bench_pos(BP_USESKILLTOID, 0)) = skill_lv;
+	WFIFOW(bot->fd, bench_pos(BP_USESKILLTOID, 1)) = skill_id;
+	WFIFOL(bot->fd, bench_pos(BP_USESKILLTOID, 2)) = target_id;
+	bench_send(bot, len);
+}
+
+static void bench_skill_pos(struct bench_bot *bot, int skill_id, int skill_lv, short x, short y)
+{
+	int len = bench_packet_begin(bot, BP_USESKILLTOPOS, 0);
+
+	WFIFOW(bot->fd, bench_pos(BP_USESKILLTOPOS, 0)) = skill_lv;
+	WFIFOW(bot->fd, bench_pos(BP_USESKILLTOPOS, 1)) = skill_id;
+	WFIFOW(bot->fd, bench_pos(BP_USESKILLTOPOS, 2)) = x;
+	WFIFOW(bot->fd, bench_pos(BP_USESKILLTOPOS, 3)) = y;
+	bench_send(bot, len);
+}
+
+/// Returns a random bot on the map-server other than the given one, or NULL.
+static struct bench_bot *bench_random_target(struct bench_bot *bot)
+{
+	int i, tries;
+
+	for (tries = 0; tries < 8; tries++) {
+		i = rnd->value(0, bench.bot_count - 1);
+		if (i != bot->index && bench.bots[i].state == BOT_READY)
+			return &bench.bots[i];
+	}
+	return NULL;
+}
+
+/*==========================================
+ * Scenarios
+ *------------------------------------------*/
+
+/// Warps to a random cell of a square around the given position.
+static void bench_warp_around(struct bench_bot *bot, const char *map_name, int x, int y, int range)
+{
+	char command[CHAT_SIZE_MAX];
+
+	snprintf(command, sizeof(command), "@warp %s %d %d", map_name,
+	         x + rnd->value(-range, range), y + rnd->value(-range, range));
+	bench_say(bot, command);
+}
+
+static bool bench_town_setup(struct bench_bot *bot, int step)
+{
+	if (step > 0)
+		return false;
+	bench_warp_around(bot, "prontera", 156, 191, 20);
+	return true;
+}
+
+static void bench_town_act(struct bench_bot *bot)
+{
+	bench_wander(bot, 8);
+}
+
+static bool bench_siege_setup(struct bench_bot *bot, int step)
+{
+	switch (step) {
+	case 0:
+		bench_warp_around(bot, "prtg_cas01", 60, 200, 12);
+		return true;
+	case 1:
+		// Bot characters have no guild, fight in PvP mode instead of GvG
+		if (bot->index == 0)
+			bench_say(bot, "@pvpon");
+		return true;
+	}
+	return false;
+}
+
+static void bench_siege_act(struct bench_bot *bot)
+{
+	struct bench_bot *target;
+
+	if (bot->act_count % 8 == 0) {
+		bench_say(bot, "@alive");
+		bench_say(bot, "@heal");
+	}
+	if ((target = bench_random_target(bot)) != NULL)
+		bench_attack(bot, target->account_id);
+	else
+		bench_wander(bot, 5);
+}
+
+static bool bench_aoe_setup(struct bench_bot *bot, int step)
+{
+	switch (step) {
+	case 0: bench_say(bot, "@jobchange 9"); return true; // Wizard
+	case 1: bench_say(bot, "@blvl 98"); return true;
+	case 2: bench_say(bot, "@allskill"); return true;
+	case 3: bench_warp_around(bot, "prt_fild08", 170, 370, 15); return true;
+	}
+	return false;
+}
+
+static void bench_aoe_act(struct bench_bot *bot)
+{
+	if (bot->index % 10 == 0)
+		bench_say(bot, "@monster poring 5");
+	bench_say(bot, "@heal");
+	bench_skill_pos(bot, 89, 10, (short)(bot->x + rnd->value(-3, 3)), (short)(bot->y + rnd->value(-3, 3))); // WZ_STORMGUST
+}
+
+static bool bench_vending_setup(struct bench_bot *bot, int step)
+{
+	int len;
+
+	if (step == 0) {
+		bench_warp_around(bot, "prontera", 156, 191, 25);
+		return true;
+	}
+	if (bot->index % 2 != 0) { // Buyers only need the search window
+		if (step > 1)
+			return false;
+		bench_say(bot, "@searchstore");
+		return true;
+	}
+
+	switch (step) {
+	case 1: bench_say(bot, "@jobchange 5"); return true; // Merchant
+	case 2: bench_say(bot, "@allskill"); return true;
+	case 3: bench_say(bot, "@cart 1"); return true;
+	case 4: bench_say(bot, "@item 501 100"); return true; // Red Potion
+	case 5:
+		len = bench_packet_begin(bot, BP_PUTITEMTOCART, 0);
+		WFIFOW(bot->fd, bench_pos(BP_PUTITEMTOCART, 0)) = 2; // First inventory slot
+		WFIFOL(bot->fd, bench_pos(BP_PUTITEMTOCART, 1)) = 100;
+		bench_send(bot, len);
+		return true;
+	case 6:
+		bench_skill_id(bot, 41, 10, bot->account_id); // MC_VENDING
+		return true;
+	case 7:
+		len = bench_packet_begin(bot, BP_OPENVENDING, 85 + 8);
+		snprintf(WFIFOP(bot->fd, 4), 80, "%s shop", bot->userid);
+		WFIFOB(bot->fd, 84) = 1;
+		WFIFOW(bot->fd, 85) = 2; // First cart slot
+		WFIFOW(bot->fd, 87) = 100;
+		WFIFOL(bot->fd, 89) = 50 + rnd->value(0, 100);
+		bench_send(bot, len);
+		return true;
+	}
+	return false;
+}
+
+static void bench_vending_act(struct bench_bot *bot)
+{
+	struct PACKET_CZ_SEARCH_STORE_INFO *p;
+	int len;
+
+	if (bot->index % 2 == 0)
+		return;
+	if (bench.packets[BP_SEARCHSTOREINFO].id == 0) { // Client version without the search window
+		bench_say(bot, "@whosells 501");
+		return;
+	}
+	if (bot->act_count % 50 == 49)
+		bench_say(bot, "@searchstore");
+
+	len = bench_packet_begin(bot, BP_SEARCHSTOREINFO, sizeof(struct PACKET_CZ_SEARCH_STORE_INFO) + sizeof(struct PACKET_CZ_SEARCH_STORE_INFO_item));
+	p = WFIFOP(bot->fd, 0);
+	p->searchType = 0; // Vending
+	p->maxPrice = 0;
+	p->minPrice = 0;
+	p->itemsCount = 1;
+	p->cardsCount = 0;
+	p->items[0].itemId = 501;
+	bench_send(bot, len);
+}
+
+static bool bench_chat_setup(struct bench_bot *bot, int step)
+{
+	if (step > 0)
+		return false;
+	bench_warp_around(bot, "prontera", 156, 191, 20);
+	return true;
+}
+
+static void bench_chat_act(struct bench_bot *bot)
+{
+	char message[64];
+
+	snprintf(message, sizeof(message), "benchmark message %d", bot->act_count);
+	bench_say(bot, message);
+	if (bot->act_count % 10 == 0)
+		bench_wander(bot, 5);
+}
+
+static const struct bench_scenario bench_scenarios[] = {
+	{ "town",    "Crowd walking around in Prontera.", 1000, bench_town_setup, bench_town_act },
+	{ "siege",   "Crowd fighting in a castle.", 1000, bench_siege_setup, bench_siege_act },
+	{ "aoe",     "Wizards casting Storm Gust on spawned monsters.", 3000, bench_aoe_setup, bench_aoe_act },
+	{ "vending", "Half of the bots vending, the other half searching the shops.", 1000, bench_vending_setup, bench_vending_act },
+	{ "chat",    "Crowd flooding the public chat in Prontera.", 500, bench_chat_setup, bench_chat_act },
+};
+
+/*==========================================
+ * Bots
+ *------------------------------------------*/
+
+/**
+ * Connects a bot to a server.
+ */
+static bool bench_connect(struct bench_bot *bot, uint32 ip, uint16 port, int (*func_parse)(int fd))
+{
+	struct bench_session *s;
+	int fd = sockt->make_connection(ip, port, NULL);
+
+	if (fd == -1)
+		return false;
+
+	CREATE(s, struct bench_session, 1);
+	s->bot = bot;
+	sockt->session[fd]->session_data = s;
+	sockt->session[fd]->func_parse = func_parse;
+	bot->fd = fd;
+	bot->got_aid = false;
+	return true;
+}
+
+/**
+ * Disconnects a bot from its current server.
+ */
+static void bench_disconnect(struct bench_bot *bot)
+{
+	if (bot->fd > 0 && sockt->session_is_valid(bot->fd)) {
+		struct bench_session *s = sockt->session[bot->fd]->session_data;
+		s->bot = NULL;
+		sockt->eof(bot->fd);
+	}
+	bot->fd = -1;
+}
+
+static void bench_fail(struct bench_bot *bot, const char *reason)
+{
+	if (bot->state == BOT_FAILED)
+		return;
+
+	ShowWarning("bench_fail: Bot '%s' failed: %s\n", bot->userid, reason);
+	if (bot->state == BOT_READY)
+		bench.ready--;
+	bot->state = BOT_FAILED;
+	bench.failed++;
+	bench_disconnect(bot);
+}
+
+/**
+ * Returns the bot of a session, closing the session if the bot is gone.
+ */
+static struct bench_bot *bench_session_bot(int fd)
+{
+	struct bench_session *s = sockt->session[fd]->session_data;
+
+	if (sockt->session[fd]->flag.eof || s == NULL || s->bot == NULL) {
+		if (s != NULL && s->bot != NULL && s->bot->fd == fd)
+			bench_fail(s->bot, "disconnected");
+		sockt->close(fd);
+		return NULL;
+	}
+	return s->bot;
+}
+
+static int bench_ping_timer(int tid, int64 tick, int id, intptr_t data)
+{
+	struct bench_bot *bot = &bench.bots[id];
+	int len;
+
+	if (bot->state != BOT_READY) {
+		timer->delete(tid, bench_ping_timer);
+		bot->ping_tid = INVALID_TIMER;
+		return 0;
+	}
+
+	len = bench_packet_begin(bot, BP_TICKSEND, 0);
+	WFIFOL(bot->fd, bench_pos(BP_TICKSEND, 0)) = (uint32)timer->gettick();
+	bot->ping_time = timer->perf_counter();
+	bench_send(bot, len);
+	return 0;
+}
+
+static int bench_act_timer(int tid, int64 tick, int id, intptr_t data)
+{
+	struct bench_bot *bot = &bench.bots[id];
+	int delay;
+
+	bot->act_tid = INVALID_TIMER;
+	if (bot->state != BOT_READY)
+		return 0;
+
+	if (bot->setup_step >= 0) {
+		if (bench.scenario->setup(bot, bot->setup_step)) {
+			bot->setup_step++;
+			bot->act_tid = timer->add(tick + BENCH_SETUP_DELAY, bench_act_timer, id, 0);
+			return 0;
+		}
+		bot->setup_step = -1;
+	} else {
+		bench.scenario->act(bot);
+		bot->act_count++;
+	}
+
+	// Jitter the actions so that the bots don't act in lockstep
+	delay = bench.interval + rnd->value(-bench.interval / 10, bench.interval / 10);
+	bot->act_tid = timer->add(tick + max(delay, 1), bench_act_timer, id, 0);
+	return 0;
+}
+
+/**
+ * Handles the packets of the map-server.
+ */
+static void bench_map_packet(struct bench_bot *bot, int fd, int cmd)
+{
+	switch (cmd) {
+	case authokType: // ZC_ACCEPT_ENTER
+	{
+		const struct packet_authok *p = RFIFOP(fd, 0);
+		bot->x = (short)(((p->PosDir[0] & 0xff) << 2) | (p->PosDir[1] >> 6));
+		bot->y = (short)(((p->PosDir[1] & 0x3f) << 4) | (p->PosDir[2] >> 4));
+		bench_send(bot, bench_packet_begin(bot, BP_LOADENDACK, 0));
+
+		bot->state = BOT_READY;
+		bench.ready++;
+		bench_sample(&bench.login, bench_elapsed(bot->connect_time));
+		bot->ping_tid = timer->add_interval(timer->gettick() + rnd->value(0, 999), bench_ping_timer, bot->index, 0, 1000);
+		bot->act_tid = timer->add(timer->gettick() + BENCH_SETUP_DELAY + rnd->value(0, 999), bench_act_timer, bot->index, 0);
+		break;
+	}
+	case 0x7f: // ZC_NOTIFY_TIME
+		if (bot->ping_time != 0) {
+			bench_sample(&bench.ping, bench_elapsed(bot->ping_time));
+			bot->ping_time = 0;
+		}
+		break;
+	case 0x87: // ZC_NOTIFY_PLAYERMOVE
+	{
+		const uint8 *p = RFIFOP(fd, 6);
+		bot->x = (short)(((p[2] & 0x0f) << 6) | (p[3] >> 2));
+		bot->y = (short)(((p[3] & 0x03) << 8) | p[4]);
+		if (bot->move_time != 0) {
+			bench_sample(&bench.move, bench_elapsed(bot->move_time));
+			bot->move_time = 0;
+		}
+		break;
+	}
+	case 0x91: // ZC_NPCACK_MAPMOVE
+		bot->x = (short)RFIFOW(fd, 18);
+		bot->y = (short)RFIFOW(fd, 20);
+		bot->move_time = 0;
+		bench_send(bot, bench_packet_begin(bot, BP_LOADENDACK, 0));
+		break;
+	case 0x74: // ZC_REFUSE_ENTER
+		bench_fail(bot, "map-server refused the connection");
+		break;
+	case 0x81: // SC_NOTIFY_BAN
+		bench_fail(bot, "disconnected by the map-server");
+		break;
+	}
+}
+
+static int bench_parse_map(int fd)
+{
+	struct bench_bot *bot;
+	int len;
+
+	if ((bot = bench_session_bot(fd)) == NULL)
+		return 0;
+
+	if (!bot->got_aid) {
+		if (RFIFOREST(fd) < 4)
+			return 0;
+		bot->got_aid = true;
+		bench.bytes_in += 4;
+		RFIFOSKIP(fd, 4);
+	}
+
+	while ((len = bench_packet_length(fd)) > 0) {
+		bench.bytes_in += len;
+		bench_map_packet(bot, fd, RFIFOW(fd, 0));
+		if (bot->fd != fd)
+			return 0;
+		RFIFOSKIP(fd, len);
+	}
+	if (len < 0) {
+		ShowDebug("bench_parse_map: Unknown packet 0x%04x.\n", (unsigned int)RFIFOW(fd, 0));
+		bench_fail(bot, "unknown map-server packet");
+	}
+	return 0;
+}
+
+/**
+ * Handles the packets of the char-server.
+ */
+static void bench_char_packet(struct bench_bot *bot, int fd, int cmd)
+{
+	switch (cmd) {
+	case 0x6b:  // HC_ACCEPT_ENTER
+	case 0x82d: // HC_ACCEPT_ENTER2
+	case 0x99d: // HC_ACK_CHARINFO_PER_PAGE
+	case 0x9a0: // HC_CHARLIST_NOTIFY
+	case 0x8b9: // HC_SECOND_PASSWD_LOGIN
+		if (cmd == 0x8b9 && RFIFOW(fd, 10) != 0) {
+			bench_fail(bot, "pincode requested, disable the pincode system of the char-server");
+			return;
+		}
+		if (!bot->char_selected) {
+			bot->char_selected = true;
+			WFIFOHEAD(fd, 3);
+			WFIFOW(fd, 0) = 0x66; // CH_SELECT_CHAR
+			WFIFOB(fd, 2) = 0;
+			bench.bytes_out += 3;
+			WFIFOSET(fd, 3);
+		}
+		break;
+	case 0x71:  // HC_NOTIFY_ZONESVR
+	case 0xac5: // HC_NOTIFY_ZONESVR2
+		bot->char_id = RFIFOL(fd, 2);
+		bot->map_ip = ntohl(RFIFOL(fd, 22));
+		bot->map_port = RFIFOW(fd, 26);
+		bench_disconnect(bot);
+
+		bot->state = BOT_MAP;
+		if (!bench_connect(bot, bot->map_ip, bot->map_port, bench_parse_map)) {
+			bench_fail(bot, "can't connect to the map-server");
+			return;
+		}
+		bot->crypt_key = bench.keys[0] * bench.keys[1] + bench.keys[2];
+		{
+			int len = bench_packet_begin(bot, BP_WANTTOCONNECTION, 0);
+			WFIFOL(bot->fd, bench_pos(BP_WANTTOCONNECTION, 0)) = bot->account_id;
+			WFIFOL(bot->fd, bench_pos(BP_WANTTOCONNECTION, 1)) = bot->char_id;
+			WFIFOL(bot->fd, bench_pos(BP_WANTTOCONNECTION, 2)) = bot->login_id1;
+			WFIFOL(bot->fd, bench_pos(BP_WANTTOCONNECTION, 3)) = (uint32)timer->gettick();
+			WFIFOB(bot->fd, bench_pos(BP_WANTTOCONNECTION, 4)) = bot->sex;
+			bench_send(bot, len);
+		}
+		break;
+	case 0x6c:  // HC_REFUSE_ENTER
+	case 0x81:  // SC_NOTIFY_BAN
+	case 0x840: // HC_NOTIFY_ACCESSIBLE_MAPNAME
+		bench_fail(bot, "char-server refused the connection");
+		break;
+	}
+}
+
+static int bench_parse_char(int fd)
+{
+	struct bench_bot *bot;
+	int len;
+
+	if ((bot = bench_session_bot(fd)) == NULL)
+		return 0;
+
+	if (!bot->got_aid) {
+		if (RFIFOREST(fd) < 4)
+			return 0;
+		bot->got_aid = true;
+		bench.bytes_in += 4;
+		RFIFOSKIP(fd, 4);
+	}
+
+	while ((len = bench_packet_length(fd)) > 0) {
+		bench.bytes_in += len;
+		bench_char_packet(bot, fd, RFIFOW(fd, 0));
+		if (bot->fd != fd)
+			return 0;
+		RFIFOSKIP(fd, len);
+	}
+	if (len < 0) {
+		ShowDebug("bench_parse_char: Unknown packet 0x%04x.\n", (unsigned int)RFIFOW(fd, 0));
+		bench_fail(bot, "unknown char-server packet");
+	}
+	return 0;
+}
+
+static int bench_parse_login(int fd)
+{
+	struct bench_bot *bot;
+	int len;
+
+	if ((bot = bench_session_bot(fd)) == NULL)
+		return 0;
+
+	if ((len = bench_packet_length(fd)) <= 0) {
+		if (len < 0)
+			bench_fail(bot, "unknown login-server packet");
+		return 0;
+	}
+	bench.bytes_in += len;
+
+	if (RFIFOW(fd, 0) == HEADER_AC_ACCEPT_LOGIN || RFIFOW(fd, 0) == HEADER_AC_ACCEPT_LOGIN2) {
+		const struct PACKET_AC_ACCEPT_LOGIN *p = RFIFOP(fd, 0);
+		uint32 ip;
+		uint16 port;
+
+		if (len < (int)(sizeof(*p) + sizeof(p->server_list[0]))) {
+			bench_fail(bot, "no char-server available");
+			return 0;
+		}
+		bot->login_id1 = p->auth_code;
+		bot->account_id = p->aid;
+		bot->login_id2 = p->user_level;
+		bot->sex = p->sex;
+		ip = ntohl(p->server_list[0].ip);
+		port = (uint16)p->server_list[0].port;
+		bench_disconnect(bot);
+
+		bot->state = BOT_CHAR;
+		if (!bench_connect(bot, ip, port, bench_parse_char)) {
+			bench_fail(bot, "can't connect to the char-server");
+			return 0;
+		}
+		WFIFOHEAD(bot->fd, 17);
+		WFIFOW(bot->fd, 0) = 0x65; // CH_ENTER
+		WFIFOL(bot->fd, 2) = bot->account_id;
+		WFIFOL(bot->fd, 6) = bot->login_id1;
+		WFIFOL(bot->fd, 10) = bot->login_id2;
+		WFIFOW(bot->fd, 14) = 0;
+		WFIFOB(bot->fd, 16) = bot->sex;
+		bench.bytes_out += 17;
+		WFIFOSET(bot->fd, 17);
+		return 0;
+	}
+
+	bench_fail(bot, "login refused, check the bot accounts and passwords");
+	return 0;
+}
+
+/**
+ * Starts the login of a bot.
+ */
+static void bench_start(struct bench_bot *bot)
+{
+	struct PACKET_CA_LOGIN *p;
+
+	bot->state = BOT_LOGIN;
+	bot->connect_time = timer->perf_counter();
+	if (!bench_connect(bot, bench.login_ip, bench.login_port, bench_parse_login)) {
+		bench_fail(bot, "can't connect to the login-server");
+		return;
+	}
+
+	WFIFOHEAD(bot->fd, sizeof(*p));
+	p = WP2PTR(bot->fd);
+	memset(p, 0, sizeof(*p));
+	p->packet_id = HEADER_CA_LOGIN;
+	p->version = 0;
+	safestrncpy(p->id, bot->userid, sizeof(p->id));
+	safestrncpy(p->password, bench.password, sizeof(p->password));
+	p->clienttype = 0;
+	bench.bytes_out += sizeof(*p);
+	WFIFOSET(bot->fd, sizeof(*p));
+}
+
+/**
+ * Starts the login of the next bots, then the measurement once they are all in.
+ */
+static int bench_ramp_timer(int tid, int64 tick, int id, intptr_t data)
+{
+	int i, count = max(bench.ramp / 10, 1);
+
+	for (i = 0; i < count && bench.started < bench.bot_count; i++)
+		bench_start(&bench.bots[bench.started++]);
+
+	if (bench.started < bench.bot_count)
+		return 0;
+
+	if (bench.ramp_end_tick == 0)
+		bench.ramp_end_tick = tick;
+
+	if (!bench.measuring && (bench.ready + bench.failed >= bench.bot_count || DIFF_TICK(tick, bench.ramp_end_tick) > BENCH_LOGIN_TIMEOUT)) {
+		ShowStatus("%d bots ready, %d failed. Measuring for %d seconds...\n", bench.ready, bench.failed, bench.duration);
+		bench.measuring = true;
+		bench.measure_start = timer->perf_counter();
+		bench.bytes_in = bench.bytes_out = 0;
+		bench.cpu_start = bench_cpu_time();
+	}
+
+	if (bench.measuring && (timer->perf_counter() - bench.measure_start) / timer->perf_frequency() >= (uint64)bench.duration) {
+		timer->delete(tid, bench_ramp_timer);
+		bench_report();
+		core->runflag = CORE_ST_STOP;
+	}
+	return 0;
+}
+
+/*==========================================
+ * Command line
+ *------------------------------------------*/
+
+static CMDLINEARG(loginip)
+{
+	safestrncpy(bench.login_ip_str, params, sizeof(bench.login_ip_str));
+	return true;
+}
+
+static CMDLINEARG(loginport)
+{
+	bench.login_port = (uint16)atoi(params);
+	return true;
+}
+
+static CMDLINEARG(bots)
+{
+	bench.bot_count = atoi(params);
+	if (bench.bot_count <= 0 || bench.bot_count > BENCH_MAX_BOTS) {
+		ShowError("The amount of bots must be between 1 and %d.\n", BENCH_MAX_BOTS);
+		return false;
+	}
+	return true;
+}
+
+static CMDLINEARG(prefix)
+{
+	if (strlen(params) >= sizeof(bench.prefix)) {
+		ShowError("The account name prefix can't be longer than %d characters.\n", (int)sizeof(bench.prefix) - 1);
+		return false;
+	}
+	safestrncpy(bench.prefix, params, sizeof(bench.prefix));
+	return true;
+}
+
+static CMDLINEARG(password)
+{
+	safestrncpy(bench.password, params, sizeof(bench.password));
+	return true;
+}
+
+static CMDLINEARG(scenario)
+{
+	int i;
+
+	ARR_FIND(0, ARRAYLENGTH(bench_scenarios), i, strcmpi(bench_scenarios[i].name, params) == 0);
+	if (i == ARRAYLENGTH(bench_scenarios)) {
+		ShowError("Unknown scenario '%s'. Available scenarios:\n", params);
+		for (i = 0; i < ARRAYLENGTH(bench_scenarios); i++)
+			ShowMessage("  %-8s %s\n", bench_scenarios[i].name, bench_scenarios[i].description);
+		return false;
+	}
+	bench.scenario = &bench_scenarios[i];
+	return true;
+}
+
+static CMDLINEARG(interval)
+{
+	bench.interval = atoi(params);
+	return bench.interval > 0;
+}
+
+static CMDLINEARG(duration)
+{
+	bench.duration = atoi(params);
+	return bench.duration > 0;
+}
+
+static CMDLINEARG(ramp)
+{
+	bench.ramp = atoi(params);
+	return bench.ramp > 0;
+}
+
+static CMDLINEARG(mappid)
+{
+	bench.map_pid = atoi(params);
+	return true;
+}
+
+static CMDLINEARG(noobfuscation)
+{
+	bench.obfuscation = false;
+	return true;
+}
+
+static CMDLINEARG(csv)
+{
+	safestrncpy(bench.csv, params, sizeof(bench.csv));
+	return true;
+}
+
+void cmdline_args_init_local(void)
+{
+	CMDLINEARG_DEF2(login-ip, loginip, "Login server address (default: 127.0.0.1).", CMDLINE_OPT_NORMAL|CMDLINE_OPT_PARAM);
+	CMDLINEARG_DEF2(login-port, loginport, "Login server port (default: 6900).", CMDLINE_OPT_NORMAL|CMDLINE_OPT_PARAM);
+	CMDLINEARG_DEF2(bots, bots, "Amount of bots, at most 9999 (default: 100).", CMDLINE_OPT_NORMAL|CMDLINE_OPT_PARAM);
+	CMDLINEARG_DEF2(prefix, prefix, "Bot account name prefix, at most 19 characters (default: bench).", CMDLINE_OPT_NORMAL|CMDLINE_OPT_PARAM);
+	CMDLINEARG_DEF2(password, password, "Bot account password (default: bench).", CMDLINE_OPT_NORMAL|CMDLINE_OPT_PARAM);
+	CMDLINEARG_DEF2(scenario, scenario, "Scenario: town, siege, aoe, vending or chat (default: town).", CMDLINE_OPT_NORMAL|CMDLINE_OPT_PARAM);
+	CMDLINEARG_DEF2(interval, interval, "Delay between two actions of a bot, in milliseconds (default: per scenario).", CMDLINE_OPT_NORMAL|CMDLINE_OPT_PARAM);
+	CMDLINEARG_DEF2(duration, duration, "Measurement duration, in seconds (default: 60).", CMDLINE_OPT_NORMAL|CMDLINE_OPT_PARAM);
+	CMDLINEARG_DEF2(ramp, ramp, "Bots logging in per second (default: 50).", CMDLINE_OPT_NORMAL|CMDLINE_OPT_PARAM);
+	CMDLINEARG_DEF2(map-pid, mappid, "Process ID of the map-server, to measure its CPU usage.", CMDLINE_OPT_NORMAL|CMDLINE_OPT_PARAM);
+	CMDLINEARG_DEF2(no-obfuscation, noobfuscation, "Don't obfuscate packet IDs (packet_obfuscation: 0).", CMDLINE_OPT_NORMAL);
+	CMDLINEARG_DEF2(csv, csv, "Appends the results to a CSV file.", CMDLINE_OPT_NORMAL|CMDLINE_OPT_PARAM);
+}
+
+/*==========================================
+ * Core
+ *------------------------------------------*/
+
+int do_init(int argc, char **argv)
+{
+	int i;
+
+	safestrncpy(bench.login_ip_str, "127.0.0.1", sizeof(bench.login_ip_str));
+	bench.login_port = 6900;
+	bench.bot_count = 100;
+	safestrncpy(bench.prefix, "bench", sizeof(bench.prefix));
+	safestrncpy(bench.password, "bench", sizeof(bench.password));
+	bench.scenario = &bench_scenarios[0];
+	bench.duration = 60;
+	bench.ramp = 50;
+	bench.obfuscation = true;
+	VECTOR_INIT(bench.ping);
+	VECTOR_INIT(bench.move);
+	VECTOR_INIT(bench.login);
+
+	if (!cmdline->exec(argc, argv, CMDLINE_OPT_NORMAL) || !bench_loadpackets()) {
+		core->runflag = CORE_ST_STOP;
+		return EXIT_FAILURE;
+	}
+	if (bench.interval == 0)
+		bench.interval = bench.scenario->interval;
+	bench.login_ip = sockt->host2ip(bench.login_ip_str);
+
+	CREATE(bench.bots, struct bench_bot, bench.bot_count);
+	for (i = 0; i < bench.bot_count && i < BENCH_MAX_BOTS; i++) {
+		struct bench_bot *bot = &bench.bots[i];
+		bot->index = i;
+		bot->fd = -1;
+		bot->act_tid = INVALID_TIMER;
+		bot->ping_tid = INVALID_TIMER;
+		snprintf(bot->userid, sizeof(bot->userid), "%s%04d", bench.prefix, i);
+	}
+
+	timer->add_func_list(bench_ramp_timer, "bench_ramp_timer");
+	timer->add_func_list(bench_ping_timer, "bench_ping_timer");
+	timer->add_func_list(bench_act_timer, "bench_act_timer");
+
+	ShowStatus("Starting %d bots, scenario '%s' (client version %d).\n", bench.bot_count, bench.scenario->name, PACKETVER);
+	timer->add_interval(timer->gettick() + 100, bench_ramp_timer, 0, 0, 100);
+	return EXIT_SUCCESS;
+}
+
+int do_final(void)
+{
+	int i;
+
+	for (i = 0; i < bench.bot_count; i++)
+		bench_disconnect(&bench.bots[i]);
+	aFree(bench.bots);
+	VECTOR_CLEAR(bench.ping);
+	VECTOR_CLEAR(bench.move);
+	VECTOR_CLEAR(bench.login);
+	return bench.ready > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void do_abort(void) { }
+
+void set_server_type(void)
+{
+	SERVER_TYPE = SERVER_TYPE_UNKNOWN;
+}
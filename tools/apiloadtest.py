@@ -0,0 +1,322 @@
+#! /usr/bin/env python3
+# -*- coding: utf8 -*-
+#
+# This file is part of Hercules.
+# http://herc.ws - http://github.com/HerculesWS/Hercules
+#
+# Copyright (C) 2024 Hercules Dev Team
+#
+# Hercules is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# Load test for api-server.
+#
+# Script plays role of login and char servers for api-server (listens on login port,
+# accepts api-server inter server connection and replies to proxied requests with
+# fixed data) and drives /userconfig/load and /emblem/* urls over keep-alive and
+# pipelined http connections. /userconfig/save is not used, because it sends no
+# reply and closes the connection.
+#
+# Usage:
+#   1. set login_port in conf/api/api-server.conf to --login-port value (default 6900)
+#      and make sure 127.0.0.1 is trusted in conf/network.conf
+#   2. run: tools/apiloadtest.py [options]
+#   3. start ./api-server
+#
+# Or from top directory: make api-loadtest
+
+import argparse
+import socket
+import struct
+import sys
+import threading
+import time
+
+WORLD_NAME = b"Hercules"
+MAX_CHARSERVER_NAME_SIZE = 20
+AUTH_TOKEN = b"0123456789abcdef"
+EMOTE_SIZE = 51
+MAX_EMOTES = 10
+HOTKEY_DESCRIPTION_SIZE = 116
+MAX_USERHOTKEYS = 50
+HOTKEY_TABS = 4
+
+HEADER_API_PROXY_REQUEST = 0x2842
+HEADER_API_PROXY_REPLY = 0x2818
+
+API_MSG_userconfig_load = 1
+API_MSG_emblem_upload = 9
+API_MSG_emblem_upload_guild_id = 10
+API_MSG_emblem_download = 11
+API_MSG_userconfig_load_emotes = 13
+API_MSG_userconfig_load_hotkeys = 14
+
+# struct PACKET_API_PROXY
+PROXY_FORMAT = "<HHhiiiiiH"
+PROXY_SIZE = struct.calcsize(PROXY_FORMAT)
+
+# 24x24 bmp with 256 colors palette (default guild emblem size)
+EMBLEM_WIDTH = 24
+EMBLEM_HEIGHT = 24
+EMBLEM_SIZE = 14 + 40 + 256 * 4 + EMBLEM_WIDTH * EMBLEM_HEIGHT
+
+
+def make_emblem():
+	data = bytearray(EMBLEM_SIZE)
+	struct.pack_into("<2sIHHI", data, 0, b"BM", EMBLEM_SIZE, 0, 0, 14 + 40 + 256 * 4)
+	struct.pack_into("<IiiHHIIiiII", data, 14, 40, EMBLEM_WIDTH, EMBLEM_HEIGHT, 1, 8, 0,
+		EMBLEM_WIDTH * EMBLEM_HEIGHT, 0, 0, 256, 0)
+	return bytes(data)
+
+
+EMBLEM = make_emblem()
+
+
+class InterServer:
+	"""Login and char server stand-in for api-server."""
+
+	def __init__(self, port, accounts):
+		self.port = port
+		self.accounts = accounts
+		self.ready = threading.Event()
+		self.proxied = 0
+
+	def run(self):
+		srv = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+		srv.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+		srv.bind(("127.0.0.1", self.port))
+		srv.listen(1)
+		print("Waiting for api-server on port {0}...".format(self.port))
+		conn, _ = srv.accept()
+		conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+		self.conn = conn
+		buf = b""
+		while True:
+			data = conn.recv(65536)
+			if not data:
+				print("api-server disconnected")
+				return
+			buf += data
+			while len(buf) >= 2:
+				cmd = struct.unpack_from("<H", buf, 0)[0]
+				if cmd == 0x2720:
+					size = 50
+				elif cmd == 0x2841:
+					size = 2
+				elif cmd == HEADER_API_PROXY_REQUEST:
+					if len(buf) < 4:
+						break
+					size = struct.unpack_from("<H", buf, 2)[0]
+				else:
+					print("Unknown packet from api-server: 0x{0:04x}".format(cmd))
+					return
+				if len(buf) < size:
+					break
+				self.parse(buf[:size])
+				buf = buf[size:]
+
+	def send(self, data):
+		self.conn.sendall(data)
+
+	def parse(self, packet):
+		cmd = struct.unpack_from("<H", packet, 0)[0]
+		if cmd == 0x2720:
+			self.send(struct.pack("<HB", 0x2811, 0))
+			name = WORLD_NAME.ljust(MAX_CHARSERVER_NAME_SIZE, b"\0")
+			self.send(struct.pack("<HHH", 0x2815, 4 + 2 + MAX_CHARSERVER_NAME_SIZE, 0) + name)
+			for account_id in self.accounts:
+				self.send(struct.pack("<Hi", 0x2814, account_id) + AUTH_TOKEN)
+				self.send(struct.pack("<Hii", 0x2819, account_id, char_id(account_id)))
+			self.ready.set()
+		elif cmd == 0x2841:
+			self.send(struct.pack("<H", 0x2812))
+		else:
+			self.parse_proxy(packet)
+
+	def reply(self, fields, msg_id, data):
+		packet = struct.pack(PROXY_FORMAT, HEADER_API_PROXY_REPLY, PROXY_SIZE + len(data), msg_id, *fields[3:]) + data
+		self.send(packet)
+
+	def parse_proxy(self, packet):
+		fields = struct.unpack_from(PROXY_FORMAT, packet, 0)
+		msg_id = fields[2]
+		self.proxied += 1
+		if msg_id == API_MSG_userconfig_load_emotes:
+			emotes = b"".join("/emote{0}".format(i).encode().ljust(EMOTE_SIZE, b"\0") for i in range(MAX_EMOTES))
+			self.reply(fields, msg_id, struct.pack("<i", 1) + emotes)
+		elif msg_id == API_MSG_userconfig_load_hotkeys:
+			keys = bytes((HOTKEY_DESCRIPTION_SIZE + 12) * MAX_USERHOTKEYS)
+			for tab in range(HOTKEY_TABS):
+				self.reply(fields, msg_id, struct.pack("<iii", 1, tab, 0) + keys)
+			self.reply(fields, API_MSG_userconfig_load, b"")
+		elif msg_id == API_MSG_emblem_download:
+			# single final chunk
+			self.reply(fields, msg_id, struct.pack("<B", 2) + EMBLEM)
+		elif msg_id == API_MSG_emblem_upload:
+			flag = packet[PROXY_SIZE]
+			if flag == 2:
+				self.reply(fields, msg_id, struct.pack("<i", 1))
+		# other messages (userconfig saves, emblem_upload_guild_id) have no reply
+
+
+def char_id(account_id):
+	return 150000 + account_id - 2000000
+
+
+def multipart(fields):
+	boundary = "----HerculesLoadTestBoundary0123456789"
+	body = b""
+	for name, value in fields:
+		body += "--{0}\r\nContent-Disposition: form-data; name=\"{1}\"\r\n".format(boundary, name).encode()
+		if isinstance(value, bytes) and name == "Img":
+			body += b"Content-Type: application/octet-stream\r\n"
+		body += b"\r\n"
+		body += value if isinstance(value, bytes) else str(value).encode()
+		body += b"\r\n"
+	body += "--{0}--\r\n".format(boundary).encode()
+	return "multipart/form-data; boundary=" + boundary, body
+
+
+def make_request(url, host, fields):
+	content_type, body = multipart(fields)
+	head = "POST {0} HTTP/1.1\r\nHost: {1}\r\nConnection: keep-alive\r\nContent-Type: {2}\r\nContent-Length: {3}\r\n\r\n".format(
+		url, host, content_type, len(body))
+	return head.encode() + body
+
+
+def build_requests(account_id, host):
+	auth = [("AID", account_id), ("WorldName", WORLD_NAME), ("AuthToken", AUTH_TOKEN)]
+	return [
+		("/userconfig/load", make_request("/userconfig/load", host, auth[:2])),
+		("/emblem/download", make_request("/emblem/download", host, auth + [("GDID", 1), ("Version", 1)])),
+		("/emblem/upload", make_request("/emblem/upload", host,
+			auth + [("GDID", 1), ("ImgType", "BMP"), ("Img", EMBLEM)])),
+	]
+
+
+class Stats:
+	def __init__(self):
+		self.lock = threading.Lock()
+		self.latency = {}
+		self.errors = 0
+		self.bytes = 0
+
+	def add(self, url, value, size):
+		with self.lock:
+			self.latency.setdefault(url, []).append(value)
+			self.bytes += size
+
+	def error(self):
+		with self.lock:
+			self.errors += 1
+
+
+def read_response(sock, buf):
+	while b"\r\n\r\n" not in buf:
+		data = sock.recv(65536)
+		if not data:
+			raise IOError("connection closed")
+		buf += data
+	head, buf = buf.split(b"\r\n\r\n", 1)
+	length = 0
+	close = False
+	for line in head.split(b"\r\n")[1:]:
+		name, _, value = line.partition(b":")
+		if name.strip().lower() == b"content-length":
+			length = int(value.strip())
+		elif name.strip().lower() == b"connection":
+			close = value.strip().lower() == b"close"
+	while len(buf) < length:
+		data = sock.recv(65536)
+		if not data:
+			raise IOError("connection closed")
+		buf += data
+	return len(head) + 4 + length, buf[length:], close
+
+
+def client(args, account_id, stats, deadline):
+	requests = build_requests(account_id, "{0}:{1}".format(args.host, args.port))
+	sock = None
+	buf = b""
+	idx = 0
+	while time.time() < deadline:
+		try:
+			if sock is None:
+				sock = socket.create_connection((args.host, args.port))
+				sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+				buf = b""
+			batch = [requests[(idx + i) % len(requests)] for i in range(args.pipeline)]
+			idx += args.pipeline
+			start = time.time()
+			sock.sendall(b"".join(req for _, req in batch))
+			for url, _ in batch:
+				size, buf, close = read_response(sock, buf)
+				stats.add(url, time.time() - start, size)
+				if close:
+					sock.close()
+					sock = None
+					break
+		except (IOError, OSError):
+			stats.error()
+			if sock is not None:
+				sock.close()
+			sock = None
+			time.sleep(0.05)
+	if sock is not None:
+		sock.close()
+
+
+def percentile(values, p):
+	values = sorted(values)
+	return values[min(len(values) - 1, int(len(values) * p / 100))]
+
+
+def main():
+	parser = argparse.ArgumentParser(description="api-server load test")
+	parser.add_argument("--host", default="127.0.0.1", help="api-server address")
+	parser.add_argument("--port", type=int, default=7121, help="api-server port")
+	parser.add_argument("--login-port", type=int, default=6900, help="port for login server stand-in")
+	parser.add_argument("--clients", type=int, default=4, help="parallel http connections")
+	parser.add_argument("--pipeline", type=int, default=4, help="requests sent at once over one connection")
+	parser.add_argument("--duration", type=int, default=10, help="test duration in seconds")
+	args = parser.parse_args()
+
+	accounts = [2000000 + i for i in range(args.clients)]
+	inter = InterServer(args.login_port, accounts)
+	thread = threading.Thread(target=inter.run)
+	thread.daemon = True
+	thread.start()
+	inter.ready.wait()
+	time.sleep(0.5)
+
+	stats = Stats()
+	deadline = time.time() + args.duration
+	clients = [threading.Thread(target=client, args=(args, account_id, stats, deadline)) for account_id in accounts]
+	for thread in clients:
+		thread.start()
+	for thread in clients:
+		thread.join()
+
+	total = sum(len(v) for v in stats.latency.values())
+	print("requests: {0}, errors: {1}, {2:.1f} req/s, {3:.1f} kB/s".format(
+		total, stats.errors, total / args.duration, stats.bytes / 1024.0 / args.duration))
+	for url in sorted(stats.latency):
+		values = stats.latency[url]
+		print("{0:20} count {1:8} p50 {2:7.2f} ms p95 {3:7.2f} ms p99 {4:7.2f} ms".format(
+			url, len(values), percentile(values, 50) * 1000, percentile(values, 95) * 1000, percentile(values, 99) * 1000))
+	print("proxied to inter server: {0}".format(inter.proxied))
+	return 1 if stats.errors != 0 or total == 0 else 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -77,7 +77,7 @@ if ($args[0] -eq "build") {
 	$propsFile = WritePropsFile $args[1..($args.Length - 1)]
 	CatchProcessErrors msbuild "-m Hercules.sln /p:ForceImportBeforeCppTargets=$propsFile"
 
-	foreach ($plugin in @("httpsample", "constdb2doc", "db2sql", "dbghelpplug", "generate-translations", "mapcache", "script_mapquit")) {
+	foreach ($plugin in @("httpsample", "constdb2doc", "db2sql", "dbghelpplug", "generate-translations", "mapcache", "logjournal", "script_mapquit")) {
 		CreatePluginProject $plugin
 		CatchProcessErrors msbuild "-m vcproj\\plugin-$plugin.vcxproj /p:ForceImportBeforeCppTargets=$propsFile"
 	}
@@ -91,7 +91,7 @@ elseif ($args[0] -eq "run") {
 }
 elseif ($args[0] -eq "test") {
 	$serverArgs = "--run-once"
-	foreach ($plugin in @("HPMHooking", "httpsample", "constdb2doc", "db2sql", "dbghelpplug", "generate-translations", "mapcache", "script_mapquit")) {
+	foreach ($plugin in @("HPMHooking", "httpsample", "constdb2doc", "db2sql", "dbghelpplug", "generate-translations", "mapcache", "logjournal", "script_mapquit")) {
 		$serverArgs += " --load-plugin $plugin"
 	}
 	CatchProcessErrors "map-server.exe" "$serverArgs --load-script npc/dev/test.txt --load-script npc/dev/ci_test.txt"